@@ -0,0 +1,494 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_ACC_ACCAVX2_H
+#define _FOG_CORE_ACC_ACCAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/C++/Base.h>
+#include <Fog/Core/C++/IntrinAvx2.h>
+
+#include <Fog/Core/Acc/AccSse.h>
+#include <Fog/Core/Acc/AccSse2.h>
+#include <Fog/Core/Acc/AccSsse3.h>
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Constants]
+// ============================================================================
+
+FOG_YMM_DECLARE_CONST_PI16_SET(0080008000800080_0080008000800080, 0x0080);
+FOG_YMM_DECLARE_CONST_PI16_SET(00FF00FF00FF00FF_00FF00FF00FF00FF, 0x00FF);
+FOG_YMM_DECLARE_CONST_PI16_SET(0100010001000100_0100010001000100, 0x0100);
+FOG_YMM_DECLARE_CONST_PI16_SET(0101010101010101_0101010101010101, 0x0101);
+FOG_YMM_DECLARE_CONST_PI32_SET(FF000000FF000000_FF000000FF000000, 0xFF000000);
+
+namespace Fog {
+namespace Acc {
+
+//! @addtogroup Fog_Core_Acc_Avx2
+//! @{
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Zero / Fill]
+// ============================================================================
+
+static FOG_INLINE void m256iZero(__m256i& dst0)
+{
+  dst0 = _mm256_setzero_si256();
+}
+
+static FOG_INLINE void m256iFill(__m256i& dst0)
+{
+  dst0 = _mm256_set1_epi32(-1);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Load]
+// ============================================================================
+
+//! @brief Load 4 bytes into the lowest DWORD of @a dst0, other DWORDs are zero.
+template<typename SrcT>
+static FOG_INLINE void m256iLoad4(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_castsi128_si256(_mm_cvtsi32_si128(((const int *)(srcp))[0]));
+}
+
+//! @brief Load 8 bytes into the lowest QWORD of @a dst0, other QWORDs are zero.
+template<typename SrcT>
+static FOG_INLINE void m256iLoad8(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_castsi128_si256(_mm_loadl_epi64((const __m128i *)(srcp)));
+}
+
+//! @brief Load 16 bytes into the lower half of @a dst0.
+template<typename SrcT>
+static FOG_INLINE void m256iLoad16u(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(srcp)));
+}
+
+template<typename SrcT>
+static FOG_INLINE void m256iLoad32a(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_load_si256((const __m256i *)(srcp));
+}
+
+template<typename SrcT>
+static FOG_INLINE void m256iLoad32u(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_loadu_si256((const __m256i *)(srcp));
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Store]
+// ============================================================================
+
+template<typename DstT>
+static FOG_INLINE void m256iStore4(DstT* dstp, const __m256i& src0)
+{
+  ((int *)(dstp))[0] = _mm_cvtsi128_si32(_mm256_castsi256_si128(src0));
+}
+
+template<typename DstT>
+static FOG_INLINE void m256iStore8(DstT* dstp, const __m256i& src0)
+{
+  _mm_storel_epi64((__m128i *)(dstp), _mm256_castsi256_si128(src0));
+}
+
+template<typename DstT>
+static FOG_INLINE void m256iStore16u(DstT* dstp, const __m256i& src0)
+{
+  _mm_storeu_si128((__m128i *)(dstp), _mm256_castsi256_si128(src0));
+}
+
+template<typename DstT>
+static FOG_INLINE void m256iStore32a(DstT* dstp, const __m256i& src0)
+{
+  _mm256_store_si256((__m256i *)(dstp), src0);
+}
+
+template<typename DstT>
+static FOG_INLINE void m256iStore32u(DstT* dstp, const __m256i& src0)
+{
+  _mm256_storeu_si256((__m256i *)(dstp), src0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Convert]
+// ============================================================================
+
+//! @brief Load 8 unsigned bytes and zero-extend them to 8 DWORDs.
+template<typename SrcT>
+static FOG_INLINE void m256iCvtPI32FromPU8(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(srcp)));
+}
+
+//! @brief Load 8 unsigned words and zero-extend them to 8 DWORDs.
+template<typename SrcT>
+static FOG_INLINE void m256iCvtPI32FromPU16(__m256i& dst0, const SrcT* srcp)
+{
+  dst0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)(srcp)));
+}
+
+//! @brief Convert 8 floats to 8 DWORDs using truncation.
+static FOG_INLINE void m256iCvtPI32FromPS(__m256i& dst0, const __m256f& x0)
+{
+  dst0 = _mm256_cvttps_epi32(x0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Expand]
+// ============================================================================
+
+static FOG_INLINE void m256iExpandPI32FromSI32(__m256i& dst0, uint32_t x0)
+{
+  dst0 = _mm256_set1_epi32((int)x0);
+}
+
+static FOG_INLINE void m256iExpandPI16FromSI16(__m256i& dst0, uint32_t x0)
+{
+  dst0 = _mm256_set1_epi16((short)x0);
+}
+
+static FOG_INLINE void m256iExpandSI256FromSI128(__m256i& dst0, const __m128i& x0)
+{
+  dst0 = _mm256_broadcastsi128_si256(x0);
+}
+
+//! @brief Combine two 128-bit registers, @a x0 is stored to the low lane and
+//! @a y0 to the high lane.
+static FOG_INLINE void m256iCombineSI256FromSI128(__m256i& dst0, const __m128i& x0, const __m128i& y0)
+{
+  dst0 = _mm256_inserti128_si256(_mm256_castsi128_si256(x0), y0, 1);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Unpack]
+// ============================================================================
+
+// NOTE: All AVX2 unpack and pack instructions work within 128-bit lanes. The
+// pixels are reordered by unpack, but reordered back by pack, so it's safe to
+// use them as long as the unpacked pixels are packed back in the same order.
+
+static FOG_INLINE void m256iUnpackPI16FromPI8Lo(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_unpacklo_epi8(x0, _mm256_setzero_si256());
+}
+
+static FOG_INLINE void m256iUnpackPI16FromPI8Hi(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_unpackhi_epi8(x0, _mm256_setzero_si256());
+}
+
+static FOG_INLINE void m256iUnpackPI32FromPI16Lo(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_unpacklo_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iUnpackPI32FromPI16Hi(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_unpackhi_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iUnpackPI64FromPI32Lo(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_unpacklo_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iUnpackPI64FromPI32Hi(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_unpackhi_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Pack]
+// ============================================================================
+
+static FOG_INLINE void m256iPackPU8FromPU16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_packus_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iPackPI16FromPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_packs_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Shuffle / Permute]
+// ============================================================================
+
+template<int Z, int Y, int X, int W>
+static FOG_INLINE void m256iShufflePI16Lo(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_shufflelo_epi16(x0, _MM_SHUFFLE(Z, Y, X, W));
+}
+
+template<int Z, int Y, int X, int W>
+static FOG_INLINE void m256iShufflePI16Hi(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_shufflehi_epi16(x0, _MM_SHUFFLE(Z, Y, X, W));
+}
+
+template<int Z, int Y, int X, int W>
+static FOG_INLINE void m256iShufflePI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_shufflelo_epi16(x0, _MM_SHUFFLE(Z, Y, X, W));
+  dst0 = _mm256_shufflehi_epi16(dst0, _MM_SHUFFLE(Z, Y, X, W));
+}
+
+template<int Z, int Y, int X, int W>
+static FOG_INLINE void m256iShufflePI32(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_shuffle_epi32(x0, _MM_SHUFFLE(Z, Y, X, W));
+}
+
+static FOG_INLINE void m256iShufflePI8(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_shuffle_epi8(x0, y0);
+}
+
+//! @brief Permute DWORDs across lanes (@a y0 contains the indexes).
+static FOG_INLINE void m256iPermutePI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_permutevar8x32_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Add / Sub]
+// ============================================================================
+
+static FOG_INLINE void m256iAddPI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_add_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iAddPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_add_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iAddusPU8(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_adds_epu8(x0, y0);
+}
+
+static FOG_INLINE void m256iSubPI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_sub_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iSubPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_sub_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Mul]
+// ============================================================================
+
+static FOG_INLINE void m256iMulLoPI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iMulHiPU16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mulhi_epu16(x0, y0);
+}
+
+static FOG_INLINE void m256iMulLoPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Min / Max]
+// ============================================================================
+
+static FOG_INLINE void m256iMinPU16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_min_epu16(x0, y0);
+}
+
+static FOG_INLINE void m256iMinPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_min_epi32(x0, y0);
+}
+
+static FOG_INLINE void m256iMaxPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_max_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - BitOps]
+// ============================================================================
+
+static FOG_INLINE void m256iAnd(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_and_si256(x0, y0);
+}
+
+static FOG_INLINE void m256iOr(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_or_si256(x0, y0);
+}
+
+static FOG_INLINE void m256iXor(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_xor_si256(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - LShift / RShift]
+// ============================================================================
+
+template<int N>
+static FOG_INLINE void m256iLShiftPU16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_slli_epi16(x0, N);
+}
+
+template<int N>
+static FOG_INLINE void m256iRShiftPU16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_srli_epi16(x0, N);
+}
+
+template<int N>
+static FOG_INLINE void m256iLShiftPU32(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_slli_epi32(x0, N);
+}
+
+template<int N>
+static FOG_INLINE void m256iRShiftPU32(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_srli_epi32(x0, N);
+}
+
+template<int N>
+static FOG_INLINE void m256iRShiftPI32(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_srai_epi32(x0, N);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Compare]
+// ============================================================================
+
+static FOG_INLINE void m256iCmpGtPI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_cmpgt_epi16(x0, y0);
+}
+
+static FOG_INLINE void m256iCmpEqPI32(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_cmpeq_epi32(x0, y0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - MoveMask]
+// ============================================================================
+
+static FOG_INLINE uint32_t m256iMoveMaskPI8(const __m256i& x0)
+{
+  return (uint32_t)_mm256_movemask_epi8(x0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Gather]
+// ============================================================================
+
+//! @brief Gather 8 DWORDs from @a srcp using indexes in @a idx0 scaled by
+//! @a Scale (1, 2, 4 or 8).
+template<int Scale, typename SrcT>
+static FOG_INLINE void m256iGatherPI32(__m256i& dst0, const SrcT* srcp, const __m256i& idx0)
+{
+  dst0 = _mm256_i32gather_epi32((const int *)(srcp), idx0, Scale);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Negate255/256]
+// ============================================================================
+
+static FOG_INLINE void m256iNegate255PI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_xor_si256(x0, FOG_YMM_GET_CONST_PI(00FF00FF00FF00FF_00FF00FF00FF00FF));
+}
+
+static FOG_INLINE void m256iNegate256PI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_sub_epi16(FOG_YMM_GET_CONST_PI(0100010001000100_0100010001000100), x0);
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Cvt256From255]
+// ============================================================================
+
+static FOG_INLINE void m256iCvt256From255PI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_add_epi16(x0, _mm256_srli_epi16(x0, 7));
+}
+
+// ============================================================================
+// [Fog::Acc - AVX2 - MulDiv255/256]
+// ============================================================================
+
+//! @brief Divide 16-bit unsigned words (results of 8-bit x 8-bit multiply) by
+//! 255 using rounding.
+static FOG_INLINE void m256iDiv255PI16(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_adds_epu16(x0, FOG_YMM_GET_CONST_PI(0080008000800080_0080008000800080));
+  dst0 = _mm256_mulhi_epu16(dst0, FOG_YMM_GET_CONST_PI(0101010101010101_0101010101010101));
+}
+
+static FOG_INLINE void m256iMulDiv255PI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+  dst0 = _mm256_adds_epu16(dst0, FOG_YMM_GET_CONST_PI(0080008000800080_0080008000800080));
+  dst0 = _mm256_mulhi_epu16(dst0, FOG_YMM_GET_CONST_PI(0101010101010101_0101010101010101));
+}
+
+static FOG_INLINE void m256iMulDiv255PI16_2x(
+  __m256i& dst0, const __m256i& x0, const __m256i& y0,
+  __m256i& dst1, const __m256i& x1, const __m256i& y1)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+  dst1 = _mm256_mullo_epi16(x1, y1);
+  dst0 = _mm256_adds_epu16(dst0, FOG_YMM_GET_CONST_PI(0080008000800080_0080008000800080));
+  dst1 = _mm256_adds_epu16(dst1, FOG_YMM_GET_CONST_PI(0080008000800080_0080008000800080));
+  dst0 = _mm256_mulhi_epu16(dst0, FOG_YMM_GET_CONST_PI(0101010101010101_0101010101010101));
+  dst1 = _mm256_mulhi_epu16(dst1, FOG_YMM_GET_CONST_PI(0101010101010101_0101010101010101));
+}
+
+//! @brief Multiply 8-bit values stored in 16-bit words by [0, 256] and divide
+//! the result by 256.
+static FOG_INLINE void m256iMulDiv256PI16(__m256i& dst0, const __m256i& x0, const __m256i& y0)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+  dst0 = _mm256_srli_epi16(dst0, 8);
+}
+
+static FOG_INLINE void m256iMulDiv256PI16_2x(
+  __m256i& dst0, const __m256i& x0, const __m256i& y0,
+  __m256i& dst1, const __m256i& x1, const __m256i& y1)
+{
+  dst0 = _mm256_mullo_epi16(x0, y0);
+  dst1 = _mm256_mullo_epi16(x1, y1);
+  dst0 = _mm256_srli_epi16(dst0, 8);
+  dst1 = _mm256_srli_epi16(dst1, 8);
+}
+
+//! @}
+
+} // Acc namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_ACC_ACCAVX2_H
@@ -1141,7 +1141,8 @@ static FOG_INLINE void m128iMulHiPU16_2x(
   dst1 = _mm_mulhi_epu16(x1, y1);
 }
 
-// TODO: Verify.
+//! @brief Multiply packed 32-bit integers, keeping the low 32-bits of each
+//! product (the result is the same for signed and unsigned inputs).
 static FOG_INLINE void m128iMulPU32(
   __m128i& dst0, const __m128i& x0, const __m128i& y0)
 {
@@ -1151,7 +1152,10 @@ static FOG_INLINE void m128iMulPU32(
   dst0 = _mm_mul_epu32(x0, y0);
   ta = _mm_mul_epu32(ta, tb);
 
-  dst0 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(dst0), _mm_castsi128_ps(ta), _MM_SHUFFLE(0, 2, 0, 2)));
+  // Products are now in [0, 2] of dst0 and in [0, 2] of ta (representing
+  // [1, 3] of the result), shuffle them back to [0, 1, 2, 3].
+  dst0 = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(dst0), _mm_castsi128_ps(ta), _MM_SHUFFLE(2, 0, 2, 0)));
+  dst0 = _mm_shuffle_epi32(dst0, _MM_SHUFFLE(3, 1, 2, 0));
 }
 
 static FOG_INLINE void m128dMulSD(
@@ -70,9 +70,22 @@
 //! @brief Enable support for x86/x64 SSSE3 instructions.
 #cmakedefine FOG_OPTIMIZE_SSSE3
 
+//! @brief Enable support for x86/x64 AVX2 instructions.
+#cmakedefine FOG_OPTIMIZE_AVX2
+
 //! @brief Enable support for ARM Neon instructions.
 #cmakedefine FOG_OPTIMIZE_NEON
 
+// ============================================================================
+// [FOG_RASTER]
+// ============================================================================
+
+//! @brief Whether to build the raster JIT backend (x86-64 only).
+//!
+//! The JIT generates fused fetch-and-composite functions for the most common
+//! patterns, it's disabled by default.
+#cmakedefine FOG_RASTER_JIT
+
 // ============================================================================
 // [Header Files]
 // ============================================================================
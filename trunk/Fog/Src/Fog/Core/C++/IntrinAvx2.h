@@ -0,0 +1,113 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_CORE_CPP_INTRINAVX2_H
+#define _FOG_CORE_CPP_INTRINAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/C++/Base.h>
+#include <Fog/Core/C++/IntrinSsse3.h>
+
+#include <immintrin.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_Core_Cpp_Intrin
+//! @{
+
+// ============================================================================
+// [__m256f]
+// ============================================================================
+
+//! @brief 256-bit AVX float register.
+//!
+//! This type is used by Fog-Framework instead of the @c __m256, because there
+//! is 'f' suffix. It matches the syntax with @c __m256i and @c __m256d types.
+typedef __m256 __m256f;
+
+// ============================================================================
+// [FOG_YMM_DECLARE_CONST]
+// ============================================================================
+
+// AVX2 code in Fog uses mostly constants where all elements are equal, so only
+// the _SET variants are provided. The compiler is able to generate a broadcast
+// from the memory if it's profitable.
+
+#define FOG_YMM_DECLARE_CONST_PI8_SET(name, val0) \
+  FOG_ALIGNED_VAR(static const uint8_t, _ymm_const_##name[32], 32) = \
+  { \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), \
+    (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0), (uint8_t)(val0)  \
+  }
+
+#define FOG_YMM_DECLARE_CONST_PI16_SET(name, val0) \
+  FOG_ALIGNED_VAR(static const uint16_t, _ymm_const_##name[16], 32) = \
+  { \
+    (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), \
+    (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), \
+    (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), \
+    (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0), (uint16_t)(val0)  \
+  }
+
+#define FOG_YMM_DECLARE_CONST_PI32_SET(name, val0) \
+  FOG_ALIGNED_VAR(static const uint32_t, _ymm_const_##name[8], 32) = \
+  { \
+    (uint32_t)(val0), (uint32_t)(val0), (uint32_t)(val0), (uint32_t)(val0), \
+    (uint32_t)(val0), (uint32_t)(val0), (uint32_t)(val0), (uint32_t)(val0)  \
+  }
+
+#define FOG_YMM_DECLARE_CONST_PI32_VAR(name, val0, val1, val2, val3, val4, val5, val6, val7) \
+  FOG_ALIGNED_VAR(static const uint32_t, _ymm_const_##name[8], 32) = \
+  { \
+    (uint32_t)(val7), \
+    (uint32_t)(val6), \
+    (uint32_t)(val5), \
+    (uint32_t)(val4), \
+    (uint32_t)(val3), \
+    (uint32_t)(val2), \
+    (uint32_t)(val1), \
+    (uint32_t)(val0)  \
+  }
+
+#define FOG_YMM_GET_CONST_PI(name) (*(const __m256i *)_ymm_const_##name)
+
+// ============================================================================
+// [Fog::ymm_t]
+// ============================================================================
+
+//! @brief YMM register.
+union FOG_ALIGNED_TYPE(ymm_t, 32)
+{
+  __m256i  m256i;
+  __m256f  m256f;
+  __m256d  m256d;
+
+  xmm_t    xmm[2];
+
+  uint64_t uq[4];
+  int64_t  sq[4];
+  uint32_t ud[8];
+  int32_t  sd[8];
+  uint16_t uw[16];
+  int16_t  sw[16];
+  uint8_t  ub[32];
+  int8_t   sb[32];
+  float    f[8];
+  double   d[4];
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_CORE_CPP_INTRINAVX2_H
@@ -2055,6 +2055,8 @@ struct FOG_NO_EXPORT Api
   FOG_CAPI_METHOD(err_t, image_readFromStream)(Image* self, Stream* stream, const StringW* ext);
   FOG_CAPI_METHOD(err_t, image_readFromBufferStringA)(Image* self, const StringA* buffer, const StringW* ext);
   FOG_CAPI_METHOD(err_t, image_readFromBufferRaw)(Image* self, const void* buffer, size_t size, const StringW* ext);
+  FOG_CAPI_METHOD(err_t, image_readFromFileResized)(Image* self, const StringW* fileName, const SizeI* dSize, uint32_t resizeFunc, const Hash<StringW, Var>* params);
+  FOG_CAPI_METHOD(err_t, image_readFromStreamResized)(Image* self, Stream* stream, const StringW* ext, const SizeI* dSize, uint32_t resizeFunc, const Hash<StringW, Var>* params);
 
   FOG_CAPI_METHOD(err_t, image_writeToFile)(const Image* self, const StringW* fileName, const Hash<StringW, Var>* options);
   FOG_CAPI_METHOD(err_t, image_writeToStream)(const Image* self, Stream* stream, const StringW* ext, const Hash<StringW, Var>* options);
@@ -2062,6 +2064,7 @@ struct FOG_NO_EXPORT Api
 
   FOG_CAPI_STATIC(err_t, image_resize)(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, uint32_t resizeFunc, const Hash<StringW, Var>* params);
   FOG_CAPI_STATIC(err_t, image_resizeCustom)(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, const MathFunctionF* resizeFunc, float radius);
+  FOG_CAPI_STATIC(err_t, image_resizeDecoder)(Image* dst, const SizeI* dSize, ImageDecoder* decoder, uint32_t resizeFunc, const Hash<StringW, Var>* params);
 
   FOG_CAPI_STATIC(bool, image_eq)(const Image* a, const Image* b);
 
@@ -2384,12 +2387,28 @@ struct FOG_NO_EXPORT Api
   FOG_CAPI_STATIC(HDC, winutil_getThreadLocalDC)(void);
 #endif // FOG_OS_WINDOWS
 
+  // --------------------------------------------------------------------------
+  // [G2d/Painting - DisplayList]
+  // --------------------------------------------------------------------------
+
+  FOG_CAPI_CTOR(displaylist_ctor)(DisplayList* self);
+  FOG_CAPI_CTOR(displaylist_ctorCopy)(DisplayList* self, const DisplayList* other);
+  FOG_CAPI_DTOR(displaylist_dtor)(DisplayList* self);
+
+  FOG_CAPI_METHOD(void, displaylist_reset)(DisplayList* self);
+  FOG_CAPI_METHOD(err_t, displaylist_copy)(DisplayList* self, const DisplayList* other);
+  FOG_CAPI_METHOD(err_t, displaylist_optimize)(DisplayList* self);
+  FOG_CAPI_METHOD(err_t, displaylist_replay)(const DisplayList* self, Painter* painter);
+
+  FOG_CAPI_STATIC(void, displaylist_dFree)(DisplayListData* d);
+
   // --------------------------------------------------------------------------
   // [G2d/Painting - Painter]
   // --------------------------------------------------------------------------
 
   FOG_CAPI_METHOD(err_t, painter_beginImage)(Painter* self, Image* image, const RectI* rect, uint32_t initFlags);
   FOG_CAPI_METHOD(err_t, painter_beginIBits)(Painter* self, const ImageBits* imageBits, const RectI* rect, uint32_t initFlags);
+  FOG_CAPI_METHOD(err_t, painter_beginDisplayList)(Painter* self, DisplayList* displayList, const SizeI* size, uint32_t initFlags);
   FOG_CAPI_METHOD(err_t, painter_switchToImage)(Painter* self, Image* image, const RectI* rect);
   FOG_CAPI_METHOD(err_t, painter_switchToIBits)(Painter* self, const ImageBits* imageBits, const RectI* rect);
   FOG_CAPI_STATIC(PaintEngine*, painter_getNullEngine)();
@@ -2509,6 +2528,7 @@ struct FOG_NO_EXPORT Api
   FOG_CAPI_STATIC(bool, pattern_eq)(const Pattern* a, const Pattern* b);
   FOG_CAPI_STATIC(PatternData*, pattern_dCreate)(size_t size);
   FOG_CAPI_STATIC(void, pattern_dFree)(PatternData* d);
+  FOG_CAPI_STATIC(void, pattern_releaseEngineCache)(void* cache);
 
   Pattern* pattern_oNull;
 
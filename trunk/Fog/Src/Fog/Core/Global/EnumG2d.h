@@ -32,7 +32,11 @@ enum ALPHA_DISTRIBUTION
   ALPHA_DISTRIBUTION_VARIANT = 3,
 
   //! @brief Count of alpha distribution types.
-  ALPHA_DISTRIBUTION_COUNT = 4
+  ALPHA_DISTRIBUTION_COUNT = 4,
+
+  //! @brief Alpha distribution is not known (used to mark the alpha
+  //! distribution cached by @ref ImageData as invalid).
+  ALPHA_DISTRIBUTION_UNKNOWN = 0xFF
 };
 
 // ============================================================================
@@ -2211,9 +2215,11 @@ enum PAINT_DEVICE
   PAINT_DEVICE_NULL = 0,
   //! @brief @ref Image paint-device (raster-based).
   PAINT_DEVICE_IMAGE = 1,
+  //! @brief @ref DisplayList paint-device (recording).
+  PAINT_DEVICE_DISPLAY_LIST = 2,
 
   //! @brief Count of paint-device IDs.
-  PAINT_DEVICE_COUNT = 2
+  PAINT_DEVICE_COUNT = 3
 };
 
 // ============================================================================
@@ -2324,12 +2330,51 @@ enum PAINTER_PARAMETER
   PAINTER_PARAMETER_FILTER_SCALE_F = 34,
   PAINTER_PARAMETER_FILTER_SCALE_D = 35,
 
+  // --------------------------------------------------------------------------
+  // [Caching]
+  // --------------------------------------------------------------------------
+
+  //! @brief Whether to cache stroked outlines of paths passed to
+  //! @c Painter::drawPath().
+  //!
+  //! The cache is shared by all painters and it's bounded by size. It's
+  //! useful when the same (unmodified) paths are drawn repeatedly, like when
+  //! redrawing static outlines in animated user interfaces. The parameter
+  //! isn't part of the painter state (it's not saved / restored).
+  PAINTER_PARAMETER_STROKE_CACHE_I = 36,
+
+  //! @brief Memory limit of the stroke cache (in bytes, shared by all
+  //! painters).
+  PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I = 37,
+
+  //! @brief Stroke cache statistics, see @c PaintCacheStats (read-only,
+  //! reset clears the counters).
+  PAINTER_PARAMETER_STROKE_CACHE_STATS = 38,
+
+  //! @brief Whether to cache the rasterized coverage of paths passed to
+  //! @c Painter::fillPath().
+  //!
+  //! The coverage is cached for the path, fill rule, clip-box and transform,
+  //! so it's only reused when the same (unmodified) path is filled at the
+  //! same place, like icons, markers and widget backgrounds. The cache is
+  //! shared by all painters. The parameter isn't part of the painter state
+  //! (it's not saved / restored).
+  PAINTER_PARAMETER_COVERAGE_CACHE_I = 39,
+
+  //! @brief Memory limit of the coverage cache (in bytes, shared by all
+  //! painters).
+  PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I = 40,
+
+  //! @brief Coverage cache statistics, see @c PaintCacheStats (read-only,
+  //! reset clears the counters).
+  PAINTER_PARAMETER_COVERAGE_CACHE_STATS = 41,
+
   // --------------------------------------------------------------------------
   // [...]
   // --------------------------------------------------------------------------
 
   //! @brief Count of painter parameters.
-  PAINTER_PARAMETER_COUNT = 36
+  PAINTER_PARAMETER_COUNT = 42
 };
 
 // ============================================================================
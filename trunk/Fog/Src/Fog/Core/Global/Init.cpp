@@ -182,7 +182,13 @@ FOG_CAPI_DECLARE void _fog_init(void)
   // [G2d/Painting]
   RasterOps_init();
   Rasterizer_init();
+  RasterGlyphCache_init();
+  RasterGradientCache_init();
+  RasterStrokeCache_init();
+  RasterCoverageCache_init();
+  RasterJit_init();
   PaintDeviceInfo_init();
+  DisplayList_init();
   Painter_init();
 
   // [G2d/Text]
@@ -197,6 +203,13 @@ FOG_CAPI_DECLARE void _fog_fini(void)
   if (--_fog_init_counter != 0)
     return;
 
+  // [G2d/Painting]
+  RasterJit_fini();
+  RasterGlyphCache_fini();
+  RasterGradientCache_fini();
+  RasterStrokeCache_fini();
+  RasterCoverageCache_fini();
+
   // [G2d/Text]
   Font_fini();
 
@@ -207,6 +220,7 @@ FOG_CAPI_DECLARE void _fog_fini(void)
 
   // [G2d/Imaging]
   ImageCodecProvider_fini();
+  ImageResize_fini();
 
   // [Core/Application]
   Application_fini();
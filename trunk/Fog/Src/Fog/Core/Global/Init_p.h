@@ -149,6 +149,7 @@ FOG_NO_EXPORT void Image_init_mac(void);
 #endif // FOG_OS_MAC
 
 FOG_NO_EXPORT void ImageResize_init(void);
+FOG_NO_EXPORT void ImageResize_fini(void);
 FOG_NO_EXPORT void ImagePalette_init(void);
 FOG_NO_EXPORT void ImageConverter_init(void);
 FOG_NO_EXPORT void ImageFilter_init(void);
@@ -176,9 +177,20 @@ FOG_NO_EXPORT void WinUtil_G2d_fini(void);
 #endif // FOG_OS_WINDOWS
 
 // [Fog/G2d/Painting]
+FOG_NO_EXPORT void DisplayList_init(void);
 FOG_NO_EXPORT void Painter_init(void);
 FOG_NO_EXPORT void PaintDeviceInfo_init(void);
+FOG_NO_EXPORT void RasterCoverageCache_init(void);
+FOG_NO_EXPORT void RasterCoverageCache_fini(void);
+FOG_NO_EXPORT void RasterGlyphCache_init(void);
+FOG_NO_EXPORT void RasterGlyphCache_fini(void);
+FOG_NO_EXPORT void RasterGradientCache_init(void);
+FOG_NO_EXPORT void RasterGradientCache_fini(void);
+FOG_NO_EXPORT void RasterJit_init(void);
+FOG_NO_EXPORT void RasterJit_fini(void);
 FOG_NO_EXPORT void RasterOps_init(void);
+FOG_NO_EXPORT void RasterStrokeCache_init(void);
+FOG_NO_EXPORT void RasterStrokeCache_fini(void);
 FOG_NO_EXPORT void Rasterizer_init(void);
 
 // [Fog/G2d/Source]
@@ -259,12 +259,16 @@ struct FeMorphology;
 struct FeTurbulence;
 
 // Fog/G2d/Painting.
+struct DisplayList;
+struct DisplayListData;
 struct Painter;
 struct PaintDevice;
 struct PaintDeviceInfo;
 struct PaintEngine;
 struct PaintParamsF;
 struct PaintParamsD;
+struct SpriteItemI;
+struct SpriteItemF;
 
 // Fog/G2d/Source.
 struct AcmykF;
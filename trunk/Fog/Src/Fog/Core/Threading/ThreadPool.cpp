@@ -14,6 +14,7 @@
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Threading/Thread.h>
 #include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/Core/Tools/InternedString.h>
 #include <Fog/Core/Tools/Logger.h>
 
 namespace Fog {
@@ -185,7 +186,7 @@ static err_t FOG_CDECL ThreadPool_getThreads(ThreadPool* self, Thread** threads,
         goto _Fail;
       }
 
-      if (!thread->start(StringW::fromAscii8("Default")))
+      if (!thread->start(FOG_S(APPLICATION_Core_Default)))
       {
         fog_delete(thread);
         MemMgr::free(pe);
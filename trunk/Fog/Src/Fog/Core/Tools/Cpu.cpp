@@ -74,7 +74,10 @@ union FOG_NO_EXPORT CpuId
 #if defined(FOG_CC_MSC)
 static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
 {
-#if _MSC_VER >= 1400
+#if _MSC_VER >= 1600
+  // Done by intrinsics, subleaf (ECX) is always zero.
+  __cpuidex(reinterpret_cast<int*>(out->i), in, 0);
+#elif _MSC_VER >= 1400
   // Done by intrinsics.
   __cpuid(reinterpret_cast<int*>(out->i), in);
 #else // _MSC_VER < 1400
@@ -84,6 +87,7 @@ static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
   __asm
   {
     mov     eax, cpuid_in
+    xor     ecx, ecx
     mov     edi, cpuid_out
     cpuid
     mov     dword ptr[edi +  0], eax
@@ -104,18 +108,44 @@ static void FOG_CDECL Cpu_cpuid(uint32_t in, CpuId* out)
   asm("mov %%ebx, %%edi\n"    \
       "cpuid\n"               \
       "xchg %%edi, %%ebx\n"   \
-      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp))
+      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp), "c" (0))
 #else
 #define _Cpuid(a, b, c, d, inp) \
   asm("mov %%rbx, %%rdi\n"    \
       "cpuid\n"               \
       "xchg %%rdi, %%rbx\n"   \
-      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp))
+      : "=a" (a), "=D" (b), "=c" (c), "=d" (d) : "a" (inp), "c" (0))
 #endif
   _Cpuid(out->eax, out->ebx, out->ecx, out->edx, in);
 }
 #endif // FOG_CC_GNU
 
+// Get the XCR0 register (OS support of extended processor states), must be
+// called only if CPUID reports OSXSAVE.
+#if defined(FOG_CC_MSC)
+static uint32_t FOG_CDECL Cpu_xgetbv0(void)
+{
+#if _MSC_VER >= 1600
+  return (uint32_t)_xgetbv(0);
+#else
+  // XGETBV is not supported by the compiler, AVX code is never used.
+  return 0;
+#endif // _MSC_VER
+}
+#endif // FOG_CC_MSC
+
+#if defined(FOG_CC_GNU) || defined(FOG_CC_CLANG)
+static uint32_t FOG_CDECL Cpu_xgetbv0(void)
+{
+  uint32_t a, d;
+
+  // XGETBV is emitted as bytes so it's not required to have an assembler
+  // which knows the instruction.
+  asm(".byte 0x0F, 0x01, 0xD0\n" : "=a" (a), "=d" (d) : "c" (0));
+  return a;
+}
+#endif // FOG_CC_GNU
+
 #endif // FOG_ARCH_X86) || FOG_ARCH_X86_64
 
 // ============================================================================
@@ -203,10 +233,12 @@ static void Cpu_detect(Cpu* cpu)
 
 #if defined(FOG_ARCH_X86) || defined(FOG_ARCH_X86_64)
   uint32_t a;
+  uint32_t maxId;
   CpuId out;
 
-  // Get vendor string.
+  // Get vendor string and the highest standard function supported.
   Cpu_cpuid(0, &out);
+  maxId = out.eax;
 
   reinterpret_cast<uint32_t*>(cpu->_vendor)[0] = out.ebx;
   reinterpret_cast<uint32_t*>(cpu->_vendor)[1] = out.edx;
@@ -245,7 +277,11 @@ static void Cpu_detect(Cpu* cpu)
   if (out.ecx & 0x00100000U) features |= CPU_FEATURE_SSE4_2;
   if (out.ecx & 0x00400000U) features |= CPU_FEATURE_MOVBE;
   if (out.ecx & 0x00800000U) features |= CPU_FEATURE_POPCNT;
-  if (out.ecx & 0x10000000U) features |= CPU_FEATURE_AVX;
+
+  // AVX is usable only if the OS saves the YMM registers (OSXSAVE set and
+  // both XMM and YMM states enabled in XCR0).
+  if ((out.ecx & 0x18000000U) == 0x18000000U && (Cpu_xgetbv0() & 0x6U) == 0x6U)
+    features |= CPU_FEATURE_AVX;
 
   if (out.edx & 0x00000010U) features |= CPU_FEATURE_RDTSC;
   if (out.edx & 0x00000100U) features |= CPU_FEATURE_CMPXCHG8B;
@@ -271,6 +307,15 @@ static void Cpu_detect(Cpu* cpu)
     cpu->_bugs |= CPU_BUG_AMD_LOCK_MB;
   }
 
+  // Structured extended feature flags (subleaf 0).
+  if (maxId >= 7)
+  {
+    Cpu_cpuid(7, &out);
+
+    if ((features & CPU_FEATURE_AVX) && (out.ebx & 0x00000020U))
+      features |= CPU_FEATURE_AVX2;
+  }
+
   // Calling cpuid with 0x80000000 as the in argument gets the number of valid
   // extended IDs.
   Cpu_cpuid(0x80000000, &out);
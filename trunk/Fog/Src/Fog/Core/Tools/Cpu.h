@@ -227,6 +227,27 @@ struct FOG_NO_EXPORT Cpu
 #define FOG_CPU_USE_INITIALIZER_SSSE3(_Initializer_)
 #endif // FOG_OPTIMIZE_SSSE3
 
+// ============================================================================
+// [FOG_CPU - AVX2]
+// ============================================================================
+
+#if defined(FOG_OPTIMIZE_AVX2)
+#define FOG_CPU_DECLARE_INITIALIZER_AVX2(_Initializer_) \
+  FOG_NO_EXPORT void _Initializer_;
+
+#if defined(FOG_HARDCODE_AVX2)
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_) \
+  _Initializer_;
+#else
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_) \
+  if (::Fog::Cpu::get()->hasFeature(::Fog::CPU_FEATURE_AVX2)) _Initializer_;
+#endif // FOG_HARDCODE_AVX2
+
+#else
+#define FOG_CPU_DECLARE_INITIALIZER_AVX2(_Initializer_)
+#define FOG_CPU_USE_INITIALIZER_AVX2(_Initializer_)
+#endif // FOG_OPTIMIZE_AVX2
+
 //! @}
 
 } // Fog namespace
@@ -124,12 +124,14 @@
 //!
 //! Painting to a specific backends.
 
+#include <Fog/G2d/Painting/DisplayList.h>
 #include <Fog/G2d/Painting/PaintDevice.h>
 #include <Fog/G2d/Painting/PaintDeviceInfo.h>
 #include <Fog/G2d/Painting/PaintEngine.h>
 #include <Fog/G2d/Painting/PaintParams.h>
 #include <Fog/G2d/Painting/PaintUtil.h>
 #include <Fog/G2d/Painting/Painter.h>
+#include <Fog/G2d/Painting/SpriteItem.h>
 
 // ============================================================================
 // [Fog/G2d/Shader]
@@ -0,0 +1,105 @@
+// [Fog-Core]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_ACC_ACCAVX2_H
+#define _FOG_G2D_ACC_ACCAVX2_H
+
+// [Dependencies]
+#include <Fog/Core/Acc/AccAvx2.h>
+#include <Fog/G2d/Acc/AccSse2.h>
+
+// ============================================================================
+// [Fog::Acc - AVX2 - Raster - Constants]
+// ============================================================================
+
+FOG_YMM_DECLARE_CONST_PI32_SET(0001000100010001_0001000100010001, 0x00010001);
+
+namespace Fog {
+namespace Acc {
+
+//! @addtogroup Fog_G2d_Acc_Avx2
+//! @{
+
+// ============================================================================
+// [Fog::Acc::AVX2 - Raster - Alpha]
+// ============================================================================
+
+//! @brief Expand the alpha of unpacked (16-bit per component) ARGB32 pixels to
+//! all components.
+static FOG_INLINE void m256iExpandAlphaPI16(__m256i& dst0, const __m256i& x0)
+{
+  m256iShufflePI16<3, 3, 3, 3>(dst0, x0);
+}
+
+static FOG_INLINE void m256iExpandAlphaPI16_2x(
+  __m256i& dst0, const __m256i& x0,
+  __m256i& dst1, const __m256i& x1)
+{
+  m256iShufflePI16<3, 3, 3, 3>(dst0, x0);
+  m256iShufflePI16<3, 3, 3, 3>(dst1, x1);
+}
+
+//! @brief Set the alpha of packed ARGB32 pixels to 0xFF.
+static FOG_INLINE void m256iFillAlphaPI8(__m256i& dst0, const __m256i& x0)
+{
+  dst0 = _mm256_or_si256(x0, FOG_YMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+}
+
+// ============================================================================
+// [Fog::Acc::AVX2 - Raster - Premultiply]
+// ============================================================================
+
+//! @brief Premultiply unpacked (16-bit per component) ARGB32 pixels.
+static FOG_INLINE void m256iPRGB32FromARGB32_PBW(__m256i& dst0, const __m256i& x0)
+{
+  __m256i alpha0;
+
+  m256iExpandAlphaPI16(alpha0, x0);
+  // Replace the alpha by 0xFF so the alpha component is preserved.
+  dst0 = _mm256_blend_epi16(x0, FOG_YMM_GET_CONST_PI(00FF00FF00FF00FF_00FF00FF00FF00FF), 0x88);
+  m256iMulDiv255PI16(dst0, dst0, alpha0);
+}
+
+// ============================================================================
+// [Fog::Acc::AVX2 - Raster - UnpackMask]
+// ============================================================================
+
+//! @brief Unpack 8 masks stored as DWORDs in @a x0 to match the pixels unpacked
+//! by @c m256iUnpackPI16FromPI8Lo() (@a dst0) and @c m256iUnpackPI16FromPI8Hi()
+//! (@a dst1).
+static FOG_INLINE void m256iUnpackMaskPI16FromPI32(__m256i& dst0, __m256i& dst1, const __m256i& x0)
+{
+  __m256i t0 = _mm256_mullo_epi32(x0, FOG_YMM_GET_CONST_PI(0001000100010001_0001000100010001));
+
+  dst0 = _mm256_unpacklo_epi32(t0, t0);
+  dst1 = _mm256_unpackhi_epi32(t0, t0);
+}
+
+//! @brief Load and unpack 8 A8 masks, see @c m256iUnpackMaskPI16FromPI32().
+static FOG_INLINE void m256iUnpackMask8PI16FromPU8(__m256i& dst0, __m256i& dst1, const uint8_t* msk)
+{
+  __m256i t0;
+
+  m256iCvtPI32FromPU8(t0, msk);
+  m256iUnpackMaskPI16FromPI32(dst0, dst1, t0);
+}
+
+//! @brief Load and unpack 8 A16 (extra) masks, see @c m256iUnpackMaskPI16FromPI32().
+static FOG_INLINE void m256iUnpackMask8PI16FromPU16(__m256i& dst0, __m256i& dst1, const uint8_t* msk)
+{
+  __m256i t0;
+
+  m256iCvtPI32FromPU16(t0, msk);
+  m256iUnpackMaskPI16FromPI32(dst0, dst1, t0);
+}
+
+//! @}
+
+} // Acc namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_ACC_ACCAVX2_H
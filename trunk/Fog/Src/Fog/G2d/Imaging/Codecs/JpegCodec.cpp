@@ -518,6 +518,170 @@ _End:
   return err;
 }
 
+// ===========================================================================
+// [Fog::JpegDecoder - ReadScanlines]
+// ===========================================================================
+
+err_t JpegDecoder::readScanlines(ImageScanlineHandler* handler, const SizeI& sizeHint)
+{
+  JpegLibrary& jpeg = reinterpret_cast<JpegCodecProvider*>(_provider)->_jpegLibrary;
+  FOG_ASSERT(jpeg.err == ERR_OK);
+
+  err_t err = ERR_OK;
+
+  struct jpeg_decompress_struct cinfo;
+  MyJpegSourceMgr srcmgr;
+  MyJpegErrorMgr jerr;
+  JSAMPROW rowptr[1];
+
+  MemBufferTmp<2048> buffer;
+  ImagePalette palette;
+
+  uint32_t format = IMAGE_FORMAT_RGB24;
+  int bpp = 3;
+
+  // Create a decompression structure and load the header.
+  cinfo.err = jpeg.std_error(&jerr.errmgr);
+  jerr.errmgr.error_exit = MyJpegErrorExit;
+  jerr.errmgr.output_message = MyJpegMessage;
+
+  if (setjmp(jerr.escape))
+  {
+    // Error condition.
+    jpeg.destroy_decompress(&cinfo);
+    return ERR_IMAGE_LIBJPEG_ERROR;
+  }
+
+  jpeg.create_decompress(&cinfo, JPEG_LIB_VERSION, sizeof(struct jpeg_decompress_struct));
+
+  cinfo.src = (struct jpeg_source_mgr *)&srcmgr;
+  srcmgr.pub.init_source = MyJpegInitSource;
+  srcmgr.pub.fill_input_buffer = MyJpegFillInputBuffer;
+  srcmgr.pub.skip_input_data = MyJpegSkipInputData;
+  srcmgr.pub.resync_to_restart = jpeg.resync_to_restart;
+  srcmgr.pub.term_source = MyJpegTermSource;
+  srcmgr.pub.next_input_byte = srcmgr.buffer;
+  srcmgr.pub.bytes_in_buffer = 0;
+  srcmgr.stream = &_stream;
+
+  jpeg.read_header(&cinfo, true);
+
+  // Use the DCT scaling (1/2, 1/4 or 1/8) if the image will be resized at
+  // least 2x down. The IDCT of the reduced block is much cheaper than the full
+  // one and the decoded image is smaller, so the resize is cheaper as well.
+  if (sizeHint.w > 0 && sizeHint.h > 0)
+  {
+    uint denom = 8;
+
+    while (denom > 1 && (cinfo.image_width  / denom < (uint)sizeHint.w ||
+                         cinfo.image_height / denom < (uint)sizeHint.h))
+    {
+      denom >>= 1;
+    }
+
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = denom;
+  }
+
+  jpeg.calc_output_dimensions(&cinfo);
+
+  _size.w = cinfo.output_width;
+  _size.h = cinfo.output_height;
+  _planes = 1;
+  _actualFrame = 0;
+  _framesCount = 1;
+
+  // Check whether the image size is valid.
+  if (!checkImageSize())
+  {
+    err = ERR_IMAGE_INVALID_SIZE;
+    goto _End;
+  }
+
+  jpeg.start_decompress(&cinfo);
+
+  // Set 8 or 24-bit output.
+  if (cinfo.out_color_space == JCS_GRAYSCALE)
+  {
+    if (cinfo.output_components != 1)
+    {
+      err = ERR_IMAGEIO_UNSUPPORTED_FORMAT;
+      goto _End;
+    }
+
+    format = IMAGE_FORMAT_I8;
+    bpp = 1;
+    palette = ImagePalette::fromGreyscale(256);
+  }
+  else if (cinfo.out_color_space == JCS_RGB)
+  {
+    if (cinfo.output_components != 3)
+    {
+      err = ERR_IMAGEIO_UNSUPPORTED_FORMAT;
+      goto _End;
+    }
+  }
+  else
+  {
+    cinfo.out_color_space = JCS_RGB;
+    cinfo.quantize_colors = false;
+  }
+
+  // Only one scanline is decoded at a time, the image is never allocated.
+  rowptr[0] = (JSAMPROW)buffer.alloc((size_t)(uint)_size.w * bpp);
+  if (FOG_IS_NULL(rowptr[0]))
+  {
+    err = ERR_RT_OUT_OF_MEMORY;
+    goto _End;
+  }
+
+  {
+    ImageConverter converter;
+
+    if (format != IMAGE_FORMAT_I8)
+    {
+      err = converter.create(
+        ImageFormatDescription::getByFormat(format),
+        ImageFormatDescription::fromArgb(24, IMAGE_FD_NONE, 0,
+          FOG_JPEG_RGB24_RMASK,
+          FOG_JPEG_RGB24_GMASK,
+          FOG_JPEG_RGB24_BMASK));
+      if (FOG_IS_ERROR(err)) goto _End;
+    }
+
+    ImageConverterClosure closure;
+    if (converter.isValid())
+      converter.setupClosure(&closure, PointI(0, 0));
+
+    err = handler->onBegin(_size, format, palette);
+    if (FOG_IS_ERROR(err)) goto _End;
+
+    while (cinfo.output_scanline < cinfo.output_height)
+    {
+      jpeg.read_scanlines(&cinfo, rowptr, (JDIMENSION)1);
+
+      if (converter.isValid() && !converter.isCopy())
+      {
+        converter.getBlitFn()((uint8_t*)rowptr[0], (uint8_t*)rowptr[0], _size.w, &closure);
+        closure.ditherOrigin.y++;
+      }
+
+      err = handler->onScanline((const uint8_t*)rowptr[0]);
+      if (FOG_IS_ERROR(err)) goto _End;
+
+      if ((cinfo.output_scanline & 15) == 0)
+        updateProgress(cinfo.output_scanline, cinfo.output_height);
+    }
+  }
+
+  jpeg.finish_decompress(&cinfo);
+  err = handler->onEnd();
+
+_End:
+  jpeg.destroy_decompress(&cinfo);
+  return err;
+}
+
 // ===========================================================================
 // [Fog::JpegEncoder - Construction / Destruction]
 // ===========================================================================
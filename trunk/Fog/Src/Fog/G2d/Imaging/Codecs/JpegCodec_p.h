@@ -125,6 +125,7 @@ struct FOG_NO_EXPORT JpegDecoder : public ImageDecoder
   virtual void reset();
   virtual err_t readHeader();
   virtual err_t readImage(Image& image);
+  virtual err_t readScanlines(ImageScanlineHandler* handler, const SizeI& sizeHint);
 };
 
 // ============================================================================
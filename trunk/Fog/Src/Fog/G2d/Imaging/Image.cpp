@@ -97,7 +97,8 @@ static err_t FOG_CDECL Image_Buffer_create(ImageData** pd, const SizeI* size, ui
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = desc.getBytesPerPixel();
-  FOG_PADDING_ZERO_64(d->padding);
+  d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+  d->mipmap = NULL;
 
   d->stride = stride;
   d->data = (uint8_t*)( ((size_t)d + sizeof(ImageData) + 15) & ~(size_t)15 );
@@ -185,6 +186,7 @@ static err_t FOG_CDECL Image_detach(Image* self)
   FOG_RETURN_ON_ERROR(fog_api.image_vTable[type]->create(&newd, &d->size, d->format));
 
   newd->colorKey = d->colorKey;
+  newd->alphaDistribution = d->alphaDistribution;
   newd->palette->setData(d->palette);
 
   _api_raster.getCopyRectFunc(newd->format)(
@@ -260,6 +262,7 @@ static err_t FOG_CDECL Image_create(Image* self, const SizeI* size, uint32_t for
       d->format = format;
       d->colorKey = IMAGE_COLOR_KEY_NONE;
       d->stride = newStride;
+      d->resetCache();
       d->palette->reset();
       return ERR_OK;
     }
@@ -306,6 +309,7 @@ static err_t FOG_CDECL Image_adopt(Image* self, const ImageBits* imageBits, uint
       (d->vType & (VAR_FLAG_STATIC | VAR_FLAG_READ_ONLY)) == 0)
   {
     d->vType &= ~VAR_FLAG_READ_ONLY;
+    d->resetCache();
   }
   else
   {
@@ -328,7 +332,8 @@ static err_t FOG_CDECL Image_adopt(Image* self, const ImageBits* imageBits, uint
     d->adopted = 1;
     d->colorKey = IMAGE_COLOR_KEY_NONE;
     d->bytesPerPixel = desc.getBytesPerPixel();
-    FOG_PADDING_ZERO_64(d->padding);
+    d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+    d->mipmap = NULL;
 
     d->palette.init();
     atomicPtrXchg(&self->_d, d)->release();
@@ -359,6 +364,10 @@ static err_t FOG_CDECL Image_adopt(Image* self, const ImageBits* imageBits, uint
 static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
 {
   ImageData* d = self->_d;
+  uint32_t alphaDistribution = d->alphaDistribution;
+
+  if (alphaDistribution != ALPHA_DISTRIBUTION_UNKNOWN)
+    return alphaDistribution;
 
   ColorAnalyzer::AnalyzerFunc analyzer = NULL;
   int aPos = 0;
@@ -375,7 +384,7 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
       break;
 
     case IMAGE_FORMAT_PRGB64:
-      analyzer = ColorAnalyzer::analyzeAlpha64; aPos = PIXEL_ARGB64_WORD_A; inc = 8;
+      analyzer = ColorAnalyzer::analyzeAlpha64; aPos = PIXEL_ARGB64_BYTE_A; inc = 8;
       break;
 
     case IMAGE_FORMAT_A16:
@@ -384,9 +393,16 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
   }
 
   if (analyzer != NULL)
-    return analyzer(d->first, d->stride, d->size.w, d->size.h, aPos, inc);
+    alphaDistribution = analyzer(d->first, d->stride, d->size.w, d->size.h, aPos, inc);
   else
-    return ALPHA_DISTRIBUTION_FULL;
+    alphaDistribution = ALPHA_DISTRIBUTION_FULL;
+
+  // Don't cache the result if the image is being painted, it would be invalid
+  // immediately.
+  if (d->locked == 0)
+    d->alphaDistribution = alphaDistribution;
+
+  return alphaDistribution;
 }
 
 // ============================================================================
@@ -395,7 +411,7 @@ static uint32_t FOG_CDECL Image_getAlphaDistribution(const Image* self)
 
 static void FOG_CDECL Image_modified(Image* self)
 {
-  // TODO:
+  self->_d->resetCache();
 }
 
 // ============================================================================
@@ -569,6 +585,7 @@ static err_t FOG_CDECL Image_convert(Image* self, uint32_t format)
       blitLine(dstCur, dstCur, w, &closure);
 
     d->format = targetFormat;
+    self->_modified();
     return ERR_OK;
   }
   else
@@ -973,6 +990,8 @@ static err_t Image_fillRectPrivate(Image* self, const RectI* r, uint32_t composi
     d = self->_d;
   }
 
+  self->_modified();
+
   uint32_t format = d->format;
   ssize_t stride = d->stride;
 
@@ -1193,6 +1212,8 @@ static err_t Image_blitImagePrivate(
     src_d = src->_d;
   }
 
+  dst->_modified();
+
   uint8_t* dPixels = dst_d->first;
   ssize_t dStride = dst_d->stride;
 
@@ -1454,6 +1475,8 @@ static err_t FOG_CDECL Image_scroll(Image* self, const PointI* pt, const RectI*
     d = self->_d;
   }
 
+  self->_modified();
+
   if (scrollX < 0) { srcX = absX; dstX = 0; } else { srcX = 0; dstX = absX; }
   if (scrollY < 0) { srcY = absY; dstY = 0; } else { srcY = 0; dstY = absY; }
 
@@ -1524,6 +1547,29 @@ static err_t FOG_CDECL Image_readFromBufferRaw(Image* self, const void* buffer,
   return fog_api.image_readFromStream(self, &stream, ext);
 }
 
+static err_t FOG_CDECL Image_readFromFileResized(Image* self, const StringW* fileName, const SizeI* dSize, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  ImageDecoder* decoder = NULL;
+  FOG_RETURN_ON_ERROR(ImageCodecProvider::createDecoderForFile(*fileName, &decoder));
+
+  err_t err = fog_api.image_resizeDecoder(self, dSize, decoder, resizeFunc, params);
+  fog_delete(decoder);
+  return err;
+}
+
+static err_t FOG_CDECL Image_readFromStreamResized(Image* self, Stream* stream, const StringW* ext, const SizeI* dSize, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  if (ext == NULL)
+    ext = fog_api.stringw_oEmpty;
+
+  ImageDecoder* decoder = NULL;
+  FOG_RETURN_ON_ERROR(ImageCodecProvider::createDecoderForStream(*stream, *ext, &decoder));
+
+  err_t err = fog_api.image_resizeDecoder(self, dSize, decoder, resizeFunc, params);
+  fog_delete(decoder);
+  return err;
+}
+
 // ============================================================================
 // [Fog::Image - Write]
 // ============================================================================
@@ -2648,6 +2694,9 @@ static void FOG_CDECL Image_dRelease(ImageData* d)
       Application::terminate(-1);
     }
 
+    if (d->mipmap != NULL)
+      d->mipmap->release();
+
     d->destroy();
   }
 }
@@ -2703,6 +2752,8 @@ FOG_NO_EXPORT void Image_init(void)
   fog_api.image_readFromStream = Image_readFromStream;
   fog_api.image_readFromBufferStringA = Image_readFromBufferStringA;
   fog_api.image_readFromBufferRaw = Image_readFromBufferRaw;
+  fog_api.image_readFromFileResized = Image_readFromFileResized;
+  fog_api.image_readFromStreamResized = Image_readFromStreamResized;
 
   fog_api.image_writeToFile = Image_writeToFile;
   fog_api.image_writeToStream = Image_writeToStream;
@@ -2740,6 +2791,8 @@ FOG_NO_EXPORT void Image_init(void)
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = 0;
+  d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+  d->mipmap = NULL;
   d->palette.initCustom1(fog_api.imagepalette_oEmpty->_d);
 
   fog_api.image_oEmpty = Image_oEmpty.initCustom1(d);
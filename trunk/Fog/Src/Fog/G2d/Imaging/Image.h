@@ -87,6 +87,20 @@ struct FOG_NO_EXPORT ImageData
     return (reference.get() + ((vType & VAR_FLAG_READ_ONLY) != 0)) == 1;
   }
 
+  //! @brief Reset the data computed from image pixels (alpha distribution and
+  //! mipmap), called when the image pixels are going to be modified.
+  FOG_INLINE void resetCache()
+  {
+    alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+
+    if (mipmap != NULL)
+    {
+      ImageData* oldMipmap = atomicPtrXchg(&mipmap, (ImageData*)NULL);
+      if (oldMipmap != NULL)
+        oldMipmap->release();
+    }
+  }
+
   // --------------------------------------------------------------------------
   // [Members]
   // --------------------------------------------------------------------------
@@ -147,9 +161,18 @@ struct FOG_NO_EXPORT ImageData
     uint32_t packedProperties;
   };
 
-#if FOG_ARCH_BITS >= 64
-  uint32_t padding;
-#endif // FOG_ARCH_BITS >= 64
+  //! @brief Cached alpha distribution of image pixels, see
+  //! @c ALPHA_DISTRIBUTION.
+  //!
+  //! Set to @c ALPHA_DISTRIBUTION_UNKNOWN when the image is created or its
+  //! pixels are modified, computed by @ref Image::getAlphaDistribution() on
+  //! demand. The raster paint engine uses it to blit opaque images using the
+  //! @c COMPOSITE_SRC operator instead of @c COMPOSITE_SRC_OVER.
+  uint32_t alphaDistribution;
+
+  //! @brief Next (half-sized) mipmap level, built on demand by the raster
+  //! paint engine to downscale the image, or @c NULL.
+  ImageData* mipmap;
 
   //! @brief Image stride.
   ssize_t stride;
@@ -305,6 +328,7 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getDataX() - Not detached.");
 
+    _d->resetCache();
     return _d->data;
   }
 
@@ -322,6 +346,7 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getFirstX() - Not detached.");
 
+    _d->resetCache();
     return _d->first;
   }
 
@@ -344,10 +369,16 @@ struct FOG_NO_EXPORT Image
     FOG_ASSERT_X(isDetached(),
       "Fog::Image::getScanlineX() - Not detached.");
 
+    _d->resetCache();
     return _d->first + (ssize_t)y * _d->stride;
   }
 
   //! @brief Get the alpha distribution.
+  //!
+  //! The image is analyzed only once, the result is cached until the image is
+  //! modified. If the pixels were modified through the pointer returned by
+  //! @c getDataX(), @c getFirstX() or @c getScanlineX() then @c _modified()
+  //! must be called before the alpha distribution is queried again.
   FOG_INLINE uint32_t getAlphaDistribution() const
   {
     return fog_api.image_getAlphaDistribution(this);
@@ -649,6 +680,35 @@ struct FOG_NO_EXPORT Image
     return fog_api.image_readFromBufferRaw(this, buffer, size, &extension);
   }
 
+  // --------------------------------------------------------------------------
+  // [Read - Resized]
+  // --------------------------------------------------------------------------
+
+  //! @brief Read the image from @a fileName resized to @a size.
+  //!
+  //! The image is resized while decoded, so the full-size image is never
+  //! allocated (the decoder can also decode the image reduced, JPEG does it
+  //! using the DCT scaling). This is the preferred way of creating thumbnails.
+  FOG_INLINE err_t readFromFile(const StringW& fileName, const SizeI& size, uint32_t resizeFunc)
+  {
+    return fog_api.image_readFromFileResized(this, &fileName, &size, resizeFunc, NULL);
+  }
+
+  FOG_INLINE err_t readFromFile(const StringW& fileName, const SizeI& size, uint32_t resizeFunc, const Hash<StringW, Var>& params)
+  {
+    return fog_api.image_readFromFileResized(this, &fileName, &size, resizeFunc, &params);
+  }
+
+  FOG_INLINE err_t readFromStream(Stream& stream, const StringW& extension, const SizeI& size, uint32_t resizeFunc)
+  {
+    return fog_api.image_readFromStreamResized(this, &stream, &extension, &size, resizeFunc, NULL);
+  }
+
+  FOG_INLINE err_t readFromStream(Stream& stream, const StringW& extension, const SizeI& size, uint32_t resizeFunc, const Hash<StringW, Var>& params)
+  {
+    return fog_api.image_readFromStreamResized(this, &stream, &extension, &size, resizeFunc, &params);
+  }
+
   // --------------------------------------------------------------------------
   // [Write]
   // --------------------------------------------------------------------------
@@ -802,6 +862,17 @@ struct FOG_NO_EXPORT Image
     return fog_api.image_resizeCustom(&dst, &dSize, &src, &sFragment, &resizeFunc, radius);
   }
 
+  //! @brief Resize the image read by @a decoder (see @ref readFromFile()).
+  static FOG_INLINE err_t resize(Image& dst, const SizeI& dSize, ImageDecoder& decoder, uint32_t resizeFunc)
+  {
+    return fog_api.image_resizeDecoder(&dst, &dSize, &decoder, resizeFunc, NULL);
+  }
+
+  static FOG_INLINE err_t resize(Image& dst, const SizeI& dSize, ImageDecoder& decoder, uint32_t resizeFunc, const Hash<StringW, Var>& params)
+  {
+    return fog_api.image_resizeDecoder(&dst, &dSize, &decoder, resizeFunc, &params);
+  }
+
   // --------------------------------------------------------------------------
   // [Statics - Equality]
   // --------------------------------------------------------------------------
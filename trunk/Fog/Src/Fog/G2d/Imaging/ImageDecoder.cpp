@@ -17,6 +17,18 @@ FOG_IMPLEMENT_OBJECT(Fog::ImageDecoder)
 
 namespace Fog {
 
+// ============================================================================
+// [Fog::ImageScanlineHandler - Construction / Destruction]
+// ============================================================================
+
+ImageScanlineHandler::ImageScanlineHandler()
+{
+}
+
+ImageScanlineHandler::~ImageScanlineHandler()
+{
+}
+
 // ============================================================================
 // [Fog::ImageDecoder - Construction / Destruction]
 // ============================================================================
@@ -50,4 +62,27 @@ void ImageDecoder::reset()
   _readerResult = ERR_OK;
 }
 
+// ============================================================================
+// [Fog::ImageDecoder - ReadScanlines]
+// ============================================================================
+
+err_t ImageDecoder::readScanlines(ImageScanlineHandler* handler, const SizeI& sizeHint)
+{
+  FOG_UNUSED(sizeHint);
+
+  Image image;
+  FOG_RETURN_ON_ERROR(readImage(image));
+  FOG_RETURN_ON_ERROR(handler->onBegin(image.getSize(), image.getFormat(), image.getPalette()));
+
+  const uint8_t* pixels = image.getFirst();
+  ssize_t stride = image.getStride();
+
+  for (int y = image.getHeight(); y; y--, pixels += stride)
+  {
+    FOG_RETURN_ON_ERROR(handler->onScanline(pixels));
+  }
+
+  return handler->onEnd();
+}
+
 } // Fog namespace
@@ -16,6 +16,40 @@ namespace Fog {
 //! @addtogroup Fog_G2d_Imaging
 //! @{
 
+// ============================================================================
+// [Fog::ImageScanlineHandler]
+// ============================================================================
+
+//! @brief Receiver of scanlines decoded by @ref ImageDecoder::readScanlines().
+struct FOG_API ImageScanlineHandler
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ImageScanlineHandler();
+  virtual ~ImageScanlineHandler();
+
+  // --------------------------------------------------------------------------
+  // [Interface]
+  // --------------------------------------------------------------------------
+
+  //! @brief Called before the first scanline, @a size, @a format and
+  //! @a palette describe the scanlines passed to @ref onScanline().
+  virtual err_t onBegin(const SizeI& size, uint32_t format, const ImagePalette& palette) = 0;
+
+  //! @brief Called for each scanline, top to bottom.
+  //!
+  //! The scanline data are valid only during the call.
+  virtual err_t onScanline(const uint8_t* data) = 0;
+
+  //! @brief Called after the last scanline.
+  virtual err_t onEnd() = 0;
+
+private:
+  FOG_NO_COPY(ImageScanlineHandler)
+};
+
 // ============================================================================
 // [Fog::ImageDecoder]
 // ============================================================================
@@ -48,6 +82,18 @@ struct FOG_API ImageDecoder : public ImageCodec
   virtual err_t readHeader() = 0;
   virtual err_t readImage(Image& image) = 0;
 
+  //! @brief Read the image and pass it to @a handler scanline by scanline.
+  //!
+  //! The @a sizeHint is the size the image will be resized to by the handler
+  //! (or an empty size if unknown). The decoder is allowed to decode the image
+  //! reduced if it can be done cheaply (for example JPEG's DCT scaling), but
+  //! never below @a sizeHint.
+  //!
+  //! The default implementation decodes the whole image using @ref readImage()
+  //! and passes its scanlines to @a handler, decoders which are able to decode
+  //! the image progressively should override it.
+  virtual err_t readScanlines(ImageScanlineHandler* handler, const SizeI& sizeHint);
+
   // --------------------------------------------------------------------------
   // [Internal]
   // --------------------------------------------------------------------------
@@ -12,16 +12,25 @@
 #include <Fog/Core/Acc/AccC.h>
 #include <Fog/Core/Global/Global.h>
 #include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Kernel/Task.h>
 #include <Fog/Core/Math/Function.h>
 #include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemBuffer.h>
 #include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadCondition.h>
+#include <Fog/Core/Threading/ThreadPool.h>
 #include <Fog/Core/Tools/Cpu.h>
 #include <Fog/Core/Tools/Hash.h>
 #include <Fog/Core/Tools/String.h>
 #include <Fog/Core/Tools/Var.h>
 #include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/ImageDecoder.h>
 #include <Fog/G2d/Imaging/ImageResize_p.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
 
 namespace Fog {
 
@@ -435,6 +444,100 @@ struct FOG_NO_EXPORT ImageResize_BlackmanFunction : public MathFunctionF
   float radius;
 };
 
+// ============================================================================
+// [Fog::ImageResize - Weights - Cache]
+// ============================================================================
+
+struct FOG_NO_EXPORT ImageResize_Cache
+{
+  FOG_INLINE ImageResize_Cache() :
+    count(0)
+  {
+  }
+
+  // Critical section for accessing members.
+  Lock lock;
+
+  // Cached weights (most recently used first).
+  ImageResizeWeights* entries[IMAGE_RESIZE_CACHE_SIZE];
+  uint count;
+};
+
+static Static<ImageResize_Cache> ImageResize_cache;
+
+//! @internal
+//!
+//! @brief Get weights used to resize @a sSize pixels into @a dSize pixels
+//! using @a func.
+//!
+//! The weights are cached, because the same weights are used by both
+//! directions when resizing a square image and usually also by the next
+//! image (thumbnails). The returned weights are referenced.
+static ImageResizeWeights* ImageResize_getWeights(const ImageResizeFunc* func, int sSize, int dSize)
+{
+  ImageResize_Cache* cache = &ImageResize_cache;
+  bool isCacheable = func->id < IMAGE_RESIZE_COUNT;
+
+  if (isCacheable)
+  {
+    AutoLock locked(cache->lock);
+
+    for (uint i = 0; i < cache->count; i++)
+    {
+      ImageResizeWeights* weights = cache->entries[i];
+      if (!weights->eq(func, sSize, dSize))
+        continue;
+
+      // Move to the first position (most recently used).
+      for (; i > 0; i--)
+        cache->entries[i] = cache->entries[i - 1];
+      cache->entries[0] = weights;
+
+      return weights->addRef();
+    }
+  }
+
+  ImageResizeWeights* weights = ImageResizeWeights::create(func, sSize, dSize);
+  if (FOG_IS_NULL(weights))
+    return NULL;
+
+  ImageResize_api.doWeights(weights, func->func);
+
+  if (isCacheable && weights->memorySize <= IMAGE_RESIZE_CACHE_MAX_WEIGHTS)
+  {
+    ImageResizeWeights* evicted = NULL;
+
+    {
+      AutoLock locked(cache->lock);
+      uint i = cache->count;
+
+      if (i == IMAGE_RESIZE_CACHE_SIZE)
+        evicted = cache->entries[--i];
+      else
+        cache->count++;
+
+      for (; i > 0; i--)
+        cache->entries[i] = cache->entries[i - 1];
+      cache->entries[0] = weights->addRef();
+    }
+
+    if (evicted != NULL)
+      evicted->release();
+  }
+
+  return weights;
+}
+
+static void ImageResize_resetCache(void)
+{
+  ImageResize_Cache* cache = &ImageResize_cache;
+  AutoLock locked(cache->lock);
+
+  for (uint i = 0; i < cache->count; i++)
+    cache->entries[i]->release();
+  cache->count = 0;
+}
+
 // ============================================================================
 // [Fog::ImageResize - Context - Init / Destroy]
 // ============================================================================
@@ -443,7 +546,7 @@ static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
   uint8_t* dData, size_t dStride, int dw, int dh,
   uint8_t* sData, size_t sStride, int sw, int sh,
   uint32_t format,
-  const MathFunctionF* func, float radius)
+  const ImageResizeFunc* func)
 {
   uint32_t tmpBpp = ImageFormatDescription::getByFormat(format).getBytesPerPixel();
 
@@ -452,6 +555,7 @@ static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
 
   ctx->dData = dData;
   ctx->sData = sData;
+  ctx->tData = NULL;
 
   ctx->dStride = dStride;
   ctx->sStride = sStride;
@@ -463,80 +567,66 @@ static err_t FOG_CDECL ImageResizeContext_init(ImageResizeContext* ctx,
   ctx->sSize[0] = (uint)sw;
   ctx->sSize[1] = (uint)sh;
 
-  ctx->scale[0] = float(dw) / float(sw);
-  ctx->scale[1] = float(dh) / float(sh);
-
-  ctx->factor[0] = 1.0f;
-  ctx->factor[1] = 1.0f;
-
-  ctx->radius[0] = radius;
-  ctx->radius[1] = radius;
-
-  if (ctx->scale[0] < 1.0f) { ctx->factor[0] = ctx->scale[0]; ctx->radius[0] = radius / ctx->scale[0]; }
-  if (ctx->scale[1] < 1.0f) { ctx->factor[1] = ctx->scale[1]; ctx->radius[1] = radius / ctx->scale[1]; }
+  ctx->weightList = NULL;
+  ctx->recordList = NULL;
 
-  ctx->kernelSize[0] = (int)(1.0f + 2.0f * ctx->radius[0]);
-  ctx->kernelSize[1] = (int)(1.0f + 2.0f * ctx->radius[1]);
-
-  ctx->isBound[0] = false;
-  ctx->isBound[1] = false;
-
-  ctx->func = func;
+  ctx->weights[0] = ImageResize_getWeights(func, sw, dw);
+  ctx->weights[1] = NULL;
 
+  if (ctx->weights[0] != NULL)
   {
-    size_t hWeightSize = dw * ctx->kernelSize[0] * sizeof(int32_t);
-    size_t vWeightSize = dh * ctx->kernelSize[1] * sizeof(int32_t);
+    if (sw == sh && dw == dh)
+      ctx->weights[1] = ctx->weights[0]->addRef();
+    else
+      ctx->weights[1] = ImageResize_getWeights(func, sh, dh);
+  }
 
-    size_t hRecordSize = dw * sizeof(ImageResizeRecord);
-    size_t vRecordSize = dh * sizeof(ImageResizeRecord);
+  if (ctx->weights[0] == NULL || ctx->weights[1] == NULL)
+  {
+    ImageResize_api.destroy(ctx);
+    return ERR_RT_OUT_OF_MEMORY;
+  }
 
-    // Allocate the maximum possible space needed.
-    ctx->weightList = reinterpret_cast<int32_t          *>(MemMgr::alloc(Math::max(hWeightSize, vWeightSize)));
-    ctx->recordList = reinterpret_cast<ImageResizeRecord*>(MemMgr::alloc(Math::max(hRecordSize, vRecordSize)));
-    ctx->tData      = reinterpret_cast<uint8_t          *>(MemMgr::alloc(sh * ctx->tStride));
+  ctx->kernelSize[0] = ctx->weights[0]->kernelSize;
+  ctx->kernelSize[1] = ctx->weights[1]->kernelSize;
 
-    if (ctx->weightList == NULL || ctx->recordList == NULL || ctx->tData == NULL)
-    {
-      ImageResize_api.destroy(ctx);
-      return ERR_RT_OUT_OF_MEMORY;
-    }
-  }
+  ctx->isBound[0] = ctx->weights[0]->isBound;
+  ctx->isBound[1] = ctx->weights[1]->isBound;
 
   return ERR_OK;
 }
 
 static void FOG_CDECL ImageResizeContext_destroy(ImageResizeContext* ctx)
 {
-  if (ctx->tData     ) MemMgr::free(ctx->tData     );
-  if (ctx->recordList) MemMgr::free(ctx->recordList);
-  if (ctx->weightList) MemMgr::free(ctx->weightList);
+  if (ctx->tData     ) MemMgr::free(ctx->tData);
+  if (ctx->weights[1]) ctx->weights[1]->release();
+  if (ctx->weights[0]) ctx->weights[0]->release();
 }
 
 // ============================================================================
-// [Fog::ImageResize - Context - Calc Weights]
+// [Fog::ImageResize - Weights - Calc]
 // ============================================================================
 
-static void FOG_CDECL ImageResizeContext_doWeights(ImageResizeContext* ctx, uint dir)
+static void FOG_CDECL ImageResizeWeights_doWeights(ImageResizeWeights* weights, const MathFunctionF* func)
 {
-  int32_t* weightList = ctx->weightList;
-  ImageResizeRecord* recordList = ctx->recordList;
+  int32_t* weightList = weights->weightList;
+  ImageResizeRecord* recordList = weights->recordList;
 
-  uint dSize = ctx->dSize[dir];
-  uint sSizeM1 = ctx->sSize[dir] - 1;
+  uint dSize = weights->dSize;
+  uint sSizeM1 = weights->sSize - 1;
   uint isSubtracted = 0;
 
-  float radius = ctx->radius[dir];
+  float radius = weights->radius;
   float radius2 = radius * 2;
 
-  float factor = ctx->factor[dir];
-  const MathFunctionF* func = ctx->func;
+  float factor = weights->factor;
 
   for (uint i = 0; i < dSize; i++)
   {
     float* wData = reinterpret_cast<float*>(weightList);
     float wSum = 0.0f;
 
-    float center = ((float)(int)i + 0.5f) / ctx->scale[dir] - 0.5f;
+    float center = ((float)(int)i + 0.5f) / weights->scale - 0.5f;
     int left = (int)(center - radius);
     int right = (int)(left + radius2) + 1;
 
@@ -594,7 +684,12 @@ static void FOG_CDECL ImageResizeContext_doWeights(ImageResizeContext* ctx, uint
 
       if (weight != 0.0f)
       {
-        wData[wCount++] = weight;
+        // If the source has only one pixel it was already consumed by the
+        // left edge, the weight must be merged, not placed after it.
+        if (wCount != 0 && (uint)left + wCount > sSizeM1)
+          wData[wCount - 1] += weight;
+        else
+          wData[wCount++] = weight;
         wSum += weight;
         isSubtracted |= (weight < 0.0f);
       }
@@ -664,10 +759,10 @@ static void FOG_CDECL ImageResizeContext_doWeights(ImageResizeContext* ctx, uint
       recordList[i].count = 0;
     }
 
-    weightList += ctx->kernelSize[dir];
+    weightList += weights->kernelSize;
   }
 
-  ctx->isBound[dir] = !isSubtracted;
+  weights->isBound = !isSubtracted;
 }
 
 // ============================================================================
@@ -1090,75 +1185,82 @@ static void FOG_CDECL ImageResizeContext_doHorizontal_A8(ImageResizeContext* ctx
 }
 
 // ============================================================================
-// [Fog::ImageResize - Context - DoVertical - PRGB32]
+// [Fog::ImageResize - Context - DoHorizontal - PRGB64]
 // ============================================================================
 
-static void FOG_CDECL ImageResizeContext_doVertical_PRGB32(ImageResizeContext* ctx)
+static void FOG_CDECL ImageResizeContext_doHorizontal_PRGB64(ImageResizeContext* ctx)
 {
   uint kernelSize = ctx->kernelSize[0];
 
   uint dw = ctx->dSize[0];
-  uint dh = ctx->dSize[1];
+  uint sh = ctx->sSize[1];
 
-  uint8_t* dData = ctx->dData;
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
 
-  ssize_t dStride = ctx->dStride;
+  ssize_t sStride = ctx->sStride;
   ssize_t tStride = ctx->tStride;
 
-  const ImageResizeRecord* recordList = ctx->recordList;
-  const int32_t* weightList = ctx->weightList;
-
-  if (ctx->isBound[1] == 1)
+  if (ctx->isBound[0] == 1)
   {
-    for (uint y = 0; y < dh; y++)
+    for (uint y = 0; y < sh; y++)
     {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
 
       for (uint x = 0; x < dw; x++)
       {
-        const uint8_t* tp = tData;
+        const uint8_t* sp = sData + recordList->pos * 8;
         const int32_t* wp = weightList;
 
-        uint32_t cr_cb = 0x00800080;
-        uint32_t ca_cg = 0x00800080;
+        uint32_t ca = 0x80;
+        uint32_t cr = 0x80;
+        uint32_t cg = 0x80;
+        uint32_t cb = 0x80;
 
-        for (uint j = count; j; j--)
+        for (uint j = recordList->count; j; j--)
         {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(sp);
           uint32_t w0 = wp[0];
-        
-          ca_cg += ((p0 >> 8) & 0x00FF00FF) * w0;
-          cr_cb += ((p0     ) & 0x00FF00FF) * w0;
 
-          tp += tStride;
+          ca += (uint32_t)p0[PIXEL_ARGB64_WORD_A] * w0;
+          cr += (uint32_t)p0[PIXEL_ARGB64_WORD_R] * w0;
+          cg += (uint32_t)p0[PIXEL_ARGB64_WORD_G] * w0;
+          cb += (uint32_t)p0[PIXEL_ARGB64_WORD_B] * w0;
+
+          sp += 8;
           wp += 1;
         }
 
-        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2(ca_cg & 0xFF00FF00, (cr_cb & 0xFF00FF00) >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_A] = (uint16_t)(ca >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_R] = (uint16_t)(cr >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_G] = (uint16_t)(cg >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_B] = (uint16_t)(cb >> 8);
 
-        dp += 4;
-        tData += 4;
-      }
+        recordList += 1;
+        weightList += kernelSize;
 
-      recordList += 1;
-      weightList += kernelSize;
+        tp += 8;
+      }
 
-      dData += dStride;
+      sData += sStride;
+      tData += tStride;
     }
   }
   else
   {
-    for (uint y = 0; y < dh; y++)
+    for (uint y = 0; y < sh; y++)
     {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
 
       for (uint x = 0; x < dw; x++)
       {
-        const uint8_t* tp = tData;
+        const uint8_t* sp = sData + recordList->pos * 8;
         const int32_t* wp = weightList;
 
         int32_t ca = 0x80;
@@ -1166,401 +1268,1539 @@ static void FOG_CDECL ImageResizeContext_doVertical_PRGB32(ImageResizeContext* c
         int32_t cg = 0x80;
         int32_t cb = 0x80;
 
-        for (uint j = count; j; j--)
+        for (uint j = recordList->count; j; j--)
         {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(sp);
           int32_t w0 = wp[0];
 
-          ca += (int32_t)Argb32::getAlpha(p0) * w0;
-          cr += (int32_t)Argb32::getRed  (p0) * w0;
-          cg += (int32_t)Argb32::getGreen(p0) * w0;
-          cb += (int32_t)Argb32::getBlue (p0) * w0;
+          ca += (int32_t)p0[PIXEL_ARGB64_WORD_A] * w0;
+          cr += (int32_t)p0[PIXEL_ARGB64_WORD_R] * w0;
+          cg += (int32_t)p0[PIXEL_ARGB64_WORD_G] * w0;
+          cb += (int32_t)p0[PIXEL_ARGB64_WORD_B] * w0;
 
-          tp += tStride;
+          sp += 8;
           wp += 1;
         }
 
-        ca = Math::bound<int32_t>(ca >> 8, 0, 255);
+        ca = Math::bound<int32_t>(ca >> 8, 0, 0xFFFF);
         cr = Math::bound<int32_t>(cr >> 8, 0, ca);
         cg = Math::bound<int32_t>(cg >> 8, 0, ca);
         cb = Math::bound<int32_t>(cb >> 8, 0, ca);
-        reinterpret_cast<uint32_t*>(dp)[0] = Argb32(ca, cr, cg, cb);
 
-        dp += 4;
-        tData += 4;
-      }
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_A] = (uint16_t)(uint32_t)ca;
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_R] = (uint16_t)(uint32_t)cr;
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_G] = (uint16_t)(uint32_t)cg;
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_ARGB64_WORD_B] = (uint16_t)(uint32_t)cb;
 
-      recordList += 1;
-      weightList += kernelSize;
+        recordList += 1;
+        weightList += kernelSize;
 
-      dData += dStride;
+        tp += 8;
+      }
+
+      sData += sStride;
+      tData += tStride;
     }
   }
 }
 
 // ============================================================================
-// [Fog::ImageResize - Context - DoVertical - XRGB32]
+// [Fog::ImageResize - Context - DoHorizontal - RGB48]
 // ============================================================================
 
-static void FOG_CDECL ImageResizeContext_doVertical_XRGB32(ImageResizeContext* ctx)
+static void FOG_CDECL ImageResizeContext_doHorizontal_RGB48(ImageResizeContext* ctx)
 {
   uint kernelSize = ctx->kernelSize[0];
 
   uint dw = ctx->dSize[0];
-  uint dh = ctx->dSize[1];
+  uint sh = ctx->sSize[1];
 
-  uint8_t* dData = ctx->dData;
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
 
-  ssize_t dStride = ctx->dStride;
+  ssize_t sStride = ctx->sStride;
   ssize_t tStride = ctx->tStride;
 
-  const ImageResizeRecord* recordList = ctx->recordList;
-  const int32_t* weightList = ctx->weightList;
-
-  if (ctx->isBound[1] == 1)
+  if (ctx->isBound[0] == 1)
   {
-    for (uint y = 0; y < dh; y++)
+    for (uint y = 0; y < sh; y++)
     {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
 
       for (uint x = 0; x < dw; x++)
       {
-        const uint8_t* tp = tData;
+        const uint8_t* sp = sData + recordList->pos * 6;
         const int32_t* wp = weightList;
 
-        uint32_t cx_cg = 0x00008000;
-        uint32_t cr_cb = 0x00800080;
+        uint32_t cr = 0x80;
+        uint32_t cg = 0x80;
+        uint32_t cb = 0x80;
 
-        for (uint j = count; j; j--)
+        for (uint j = recordList->count; j; j--)
         {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(sp);
           uint32_t w0 = wp[0];
-        
-          cx_cg += (p0 & 0x0000FF00) * w0;
-          cr_cb += (p0 & 0x00FF00FF) * w0;
 
-          tp += tStride;
+          cr += (uint32_t)p0[PIXEL_RGB48_WORD_R] * w0;
+          cg += (uint32_t)p0[PIXEL_RGB48_WORD_G] * w0;
+          cb += (uint32_t)p0[PIXEL_RGB48_WORD_B] * w0;
+
+          sp += 6;
           wp += 1;
         }
 
-        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2(0xFF000000, ((cx_cg & 0x00FF0000) | (cr_cb & 0xFF00FF00)) >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_R] = (uint16_t)(cr >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_G] = (uint16_t)(cg >> 8);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_B] = (uint16_t)(cb >> 8);
 
-        dp += 4;
-        tData += 4;
-      }
+        recordList += 1;
+        weightList += kernelSize;
 
-      recordList += 1;
-      weightList += kernelSize;
+        tp += 6;
+      }
 
-      dData += dStride;
+      sData += sStride;
+      tData += tStride;
     }
   }
   else
   {
-    for (uint y = 0; y < dh; y++)
+    for (uint y = 0; y < sh; y++)
     {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
 
       for (uint x = 0; x < dw; x++)
       {
-        const uint8_t* tp = tData;
+        const uint8_t* sp = sData + recordList->pos * 6;
         const int32_t* wp = weightList;
 
         int32_t cr = 0x80;
         int32_t cg = 0x80;
         int32_t cb = 0x80;
 
-        for (uint j = count; j; j--)
+        for (uint j = recordList->count; j; j--)
         {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(sp);
           int32_t w0 = wp[0];
 
-          cr += (int32_t)Argb32::getRed  (p0) * w0;
-          cg += (int32_t)Argb32::getGreen(p0) * w0;
-          cb += (int32_t)Argb32::getBlue (p0) * w0;
+          cr += (int32_t)p0[PIXEL_RGB48_WORD_R] * w0;
+          cg += (int32_t)p0[PIXEL_RGB48_WORD_G] * w0;
+          cb += (int32_t)p0[PIXEL_RGB48_WORD_B] * w0;
 
-          tp += tStride;
+          sp += 6;
           wp += 1;
         }
 
-        cr = Math::bound<int32_t>(cr >> 8, 0, 255);
-        cg = Math::bound<int32_t>(cg >> 8, 0, 255);
-        cb = Math::bound<int32_t>(cb >> 8, 0, 255);
-        reinterpret_cast<uint32_t*>(dp)[0] = Argb32(0xFF, cr, cg, cb);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_R] = (uint16_t)(uint32_t)Math::bound<int32_t>(cr >> 8, 0, 0xFFFF);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_G] = (uint16_t)(uint32_t)Math::bound<int32_t>(cg >> 8, 0, 0xFFFF);
+        reinterpret_cast<uint16_t*>(tp)[PIXEL_RGB48_WORD_B] = (uint16_t)(uint32_t)Math::bound<int32_t>(cb >> 8, 0, 0xFFFF);
 
-        dp += 4;
-        tData += 4;
-      }
+        recordList += 1;
+        weightList += kernelSize;
 
-      recordList += 1;
-      weightList += kernelSize;
+        tp += 6;
+      }
 
-      dData += dStride;
+      sData += sStride;
+      tData += tStride;
     }
   }
 }
 
 // ============================================================================
-// [Fog::ImageResize - Context - DoVertical - RGB24, A8]
+// [Fog::ImageResize - Context - DoHorizontal - A16]
 // ============================================================================
 
-static void FOG_CDECL ImageResizeContext_doVertical_Bytes(ImageResizeContext* ctx, uint wScale)
+static void FOG_CDECL ImageResizeContext_doHorizontal_A16(ImageResizeContext* ctx)
 {
   uint kernelSize = ctx->kernelSize[0];
 
-  uint dw = ctx->dSize[0] * wScale;
-  uint dh = ctx->dSize[1];
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
 
-  uint8_t* dData = ctx->dData;
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
 
-  ssize_t dStride = ctx->dStride;
+  ssize_t sStride = ctx->sStride;
   ssize_t tStride = ctx->tStride;
 
-  const ImageResizeRecord* recordList = ctx->recordList;
-  const int32_t* weightList = ctx->weightList;
-
-  if (ctx->isBound[1] == 1)
+  if (ctx->isBound[0] == 1)
   {
-    for (uint y = 0; y < dh; y++)
+    for (uint y = 0; y < sh; y++)
     {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
-
-      uint x = dw;
-      uint i = 0;
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
 
-      if (((size_t)dp & 0x7) == 0)
-        goto _BoundLarge;
-      i = 8 - ((uint)(size_t)dp & 0x7);
+      uint8_t* tp = tData;
 
-_BoundSmall:
-      x -= i;
-      do {
-        const uint8_t* tp = tData;
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* sp = sData + recordList->pos * 2;
         const int32_t* wp = weightList;
 
-        uint32_t c0 = 0x80;
+        uint32_t ca = 0x80;
 
-        for (uint j = count; j; j--)
+        for (uint j = recordList->count; j; j--)
         {
-          uint32_t p0 = tp[0];
+          uint32_t p0 = reinterpret_cast<const uint16_t*>(sp)[0];
           uint32_t w0 = wp[0];
-        
+
+          ca += p0 * w0;
+
+          sp += 2;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint16_t*>(tp)[0] = (uint16_t)(ca >> 8);
+
+        recordList += 1;
+        weightList += kernelSize;
+
+        tp += 2;
+      }
+
+      sData += sStride;
+      tData += tStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < sh; y++)
+    {
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* sp = sData + recordList->pos * 2;
+        const int32_t* wp = weightList;
+
+        int32_t ca = 0x80;
+
+        for (uint j = recordList->count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint16_t*>(sp)[0];
+          int32_t w0 = wp[0];
+
+          ca += (int32_t)p0 * w0;
+
+          sp += 2;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint16_t*>(tp)[0] = (uint16_t)(uint32_t)Math::bound<int32_t>(ca >> 8, 0, 0xFFFF);
+
+        recordList += 1;
+        weightList += kernelSize;
+
+        tp += 2;
+      }
+
+      sData += sStride;
+      tData += tStride;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - PRGB32]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doVertical_PRGB32(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0];
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  if (ctx->isBound[1] == 1)
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t cr_cb = 0x00800080;
+        uint32_t ca_cg = 0x00800080;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          uint32_t w0 = wp[0];
+        
+          ca_cg += ((p0 >> 8) & 0x00FF00FF) * w0;
+          cr_cb += ((p0     ) & 0x00FF00FF) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2(ca_cg & 0xFF00FF00, (cr_cb & 0xFF00FF00) >> 8);
+
+        dp += 4;
+        tData += 4;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t ca = 0x80;
+        int32_t cr = 0x80;
+        int32_t cg = 0x80;
+        int32_t cb = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          int32_t w0 = wp[0];
+
+          ca += (int32_t)Argb32::getAlpha(p0) * w0;
+          cr += (int32_t)Argb32::getRed  (p0) * w0;
+          cg += (int32_t)Argb32::getGreen(p0) * w0;
+          cb += (int32_t)Argb32::getBlue (p0) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        ca = Math::bound<int32_t>(ca >> 8, 0, 255);
+        cr = Math::bound<int32_t>(cr >> 8, 0, ca);
+        cg = Math::bound<int32_t>(cg >> 8, 0, ca);
+        cb = Math::bound<int32_t>(cb >> 8, 0, ca);
+        reinterpret_cast<uint32_t*>(dp)[0] = Argb32(ca, cr, cg, cb);
+
+        dp += 4;
+        tData += 4;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - XRGB32]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doVertical_XRGB32(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0];
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  if (ctx->isBound[1] == 1)
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t cx_cg = 0x00008000;
+        uint32_t cr_cb = 0x00800080;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          uint32_t w0 = wp[0];
+        
+          cx_cg += (p0 & 0x0000FF00) * w0;
+          cr_cb += (p0 & 0x00FF00FF) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2(0xFF000000, ((cx_cg & 0x00FF0000) | (cr_cb & 0xFF00FF00)) >> 8);
+
+        dp += 4;
+        tData += 4;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t cr = 0x80;
+        int32_t cg = 0x80;
+        int32_t cb = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          int32_t w0 = wp[0];
+
+          cr += (int32_t)Argb32::getRed  (p0) * w0;
+          cg += (int32_t)Argb32::getGreen(p0) * w0;
+          cb += (int32_t)Argb32::getBlue (p0) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        cr = Math::bound<int32_t>(cr >> 8, 0, 255);
+        cg = Math::bound<int32_t>(cg >> 8, 0, 255);
+        cb = Math::bound<int32_t>(cb >> 8, 0, 255);
+        reinterpret_cast<uint32_t*>(dp)[0] = Argb32(0xFF, cr, cg, cb);
+
+        dp += 4;
+        tData += 4;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - RGB24, A8]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doVertical_Bytes(ImageResizeContext* ctx, uint wScale)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0] * wScale;
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  if (ctx->isBound[1] == 1)
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      uint x = dw;
+      uint i = 0;
+
+      if (((size_t)dp & 0x7) == 0)
+        goto _BoundLarge;
+      i = Math::min<uint>(x, 8 - ((uint)(size_t)dp & 0x7));
+
+_BoundSmall:
+      x -= i;
+      do {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t c0 = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = tp[0];
+          uint32_t w0 = wp[0];
+        
+          c0 += p0 * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        dp[0] = (uint8_t)(c0 >> 8);
+
+        dp += 1;
+        tData += 1;
+      } while (--i);
+
+_BoundLarge:
+      while (x >= 8)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t c0 = 0x00800080;
+        uint32_t c1 = 0x00800080;
+        uint32_t c2 = 0x00800080;
+        uint32_t c3 = 0x00800080;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          uint32_t p1 = reinterpret_cast<const uint32_t*>(tp)[1];
+          uint32_t w0 = wp[0];
+
+          c0 += ((p0     ) & 0x00FF00FF) * w0;
+          c1 += ((p0 >> 8) & 0x00FF00FF) * w0;
+          c2 += ((p1     ) & 0x00FF00FF) * w0;
+          c3 += ((p1 >> 8) & 0x00FF00FF) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2((c0 & 0xFF00FF00) >> 8, c1 & 0xFF00FF00);
+        reinterpret_cast<uint32_t*>(dp)[1] = _FOG_ACC_COMBINE_2((c2 & 0xFF00FF00) >> 8, c3 & 0xFF00FF00);
+
+        dp += 8;
+        tData += 8;
+
+        x -= 8;
+      }
+
+      i = x;
+      if (i != 0)
+        goto _BoundSmall;
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      uint x = dw;
+      uint i = 0;
+
+      if (((size_t)dp & 0x3) == 0)
+        goto _UnboundLarge;
+      i = Math::min<uint>(x, 4 - ((uint)(size_t)dp & 0x3));
+
+_UnboundSmall:
+      x -= i;
+      do {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t c0 = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = tp[0];
+          int32_t w0 = wp[0];
+
+          c0 += (int32_t)p0 * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        dp[0] = (uint8_t)(uint32_t)Math::bound<int32_t>(c0 >> 8, 0, 255);
+
+        dp += 1;
+        tData += 1;
+      } while (--i);
+
+_UnboundLarge:
+      while (x >= 4)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t c0 = 0x80;
+        int32_t c1 = 0x80;
+        int32_t c2 = 0x80;
+        int32_t c3 = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
+          uint32_t w0 = wp[0];
+
+          c0 += ((p0      ) & 0xFF) * w0;
+          c1 += ((p0 >>  8) & 0xFF) * w0;
+          c2 += ((p0 >> 16) & 0xFF) * w0;
+          c3 += ((p0 >> 24)       ) * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_4(
+          Math::bound<int32_t>(c0 >> 8, 0, 255)      ,
+          Math::bound<int32_t>(c1 >> 8, 0, 255) <<  8,
+          Math::bound<int32_t>(c2 >> 8, 0, 255) << 16,
+          Math::bound<int32_t>(c3 >> 8, 0, 255) << 24);
+
+        dp += 4;
+        tData += 4;
+        
+        x -= 4;
+      }
+
+      i = x;
+      if (i != 0)
+        goto _UnboundSmall;
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_RGB24(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Bytes(ctx, 3);
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_A8(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Bytes(ctx, 1);
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - PRGB64]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doVertical_PRGB64(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0];
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  if (ctx->isBound[1] == 1)
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t ca = 0x80;
+        uint32_t cr = 0x80;
+        uint32_t cg = 0x80;
+        uint32_t cb = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(tp);
+          uint32_t w0 = wp[0];
+
+          ca += (uint32_t)p0[PIXEL_ARGB64_WORD_A] * w0;
+          cr += (uint32_t)p0[PIXEL_ARGB64_WORD_R] * w0;
+          cg += (uint32_t)p0[PIXEL_ARGB64_WORD_G] * w0;
+          cb += (uint32_t)p0[PIXEL_ARGB64_WORD_B] * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_A] = (uint16_t)(ca >> 8);
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_R] = (uint16_t)(cr >> 8);
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_G] = (uint16_t)(cg >> 8);
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_B] = (uint16_t)(cb >> 8);
+
+        dp += 8;
+        tData += 8;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t ca = 0x80;
+        int32_t cr = 0x80;
+        int32_t cg = 0x80;
+        int32_t cb = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          const uint16_t* p0 = reinterpret_cast<const uint16_t*>(tp);
+          int32_t w0 = wp[0];
+
+          ca += (int32_t)p0[PIXEL_ARGB64_WORD_A] * w0;
+          cr += (int32_t)p0[PIXEL_ARGB64_WORD_R] * w0;
+          cg += (int32_t)p0[PIXEL_ARGB64_WORD_G] * w0;
+          cb += (int32_t)p0[PIXEL_ARGB64_WORD_B] * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        ca = Math::bound<int32_t>(ca >> 8, 0, 0xFFFF);
+        cr = Math::bound<int32_t>(cr >> 8, 0, ca);
+        cg = Math::bound<int32_t>(cg >> 8, 0, ca);
+        cb = Math::bound<int32_t>(cb >> 8, 0, ca);
+
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_A] = (uint16_t)(uint32_t)ca;
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_R] = (uint16_t)(uint32_t)cr;
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_G] = (uint16_t)(uint32_t)cg;
+        reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_B] = (uint16_t)(uint32_t)cb;
+
+        dp += 8;
+        tData += 8;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - RGB48, A16]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doVertical_Words(ImageResizeContext* ctx, uint wScale)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0] * wScale;
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  if (ctx->isBound[1] == 1)
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        uint32_t c0 = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint16_t*>(tp)[0];
+          uint32_t w0 = wp[0];
+
           c0 += p0 * w0;
 
           tp += tStride;
           wp += 1;
         }
 
-        dp[0] = (uint8_t)(c0 >> 8);
+        reinterpret_cast<uint16_t*>(dp)[0] = (uint16_t)(c0 >> 8);
+
+        dp += 2;
+        tData += 2;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+  else
+  {
+    for (uint y = 0; y < dh; y++)
+    {
+      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+      uint8_t* dp = dData;
+      uint count = recordList->count;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* tp = tData;
+        const int32_t* wp = weightList;
+
+        int32_t c0 = 0x80;
+
+        for (uint j = count; j; j--)
+        {
+          uint32_t p0 = reinterpret_cast<const uint16_t*>(tp)[0];
+          int32_t w0 = wp[0];
+
+          c0 += (int32_t)p0 * w0;
+
+          tp += tStride;
+          wp += 1;
+        }
+
+        reinterpret_cast<uint16_t*>(dp)[0] = (uint16_t)(uint32_t)Math::bound<int32_t>(c0 >> 8, 0, 0xFFFF);
+
+        dp += 2;
+        tData += 2;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      dData += dStride;
+    }
+  }
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_RGB48(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Words(ctx, 3);
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_A16(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Words(ctx, 1);
+}
+
+// ============================================================================
+// [Fog::ImageResize - Worker]
+// ============================================================================
+
+struct ImageResize_WorkMgr;
+
+//! @internal
+//!
+//! @brief Resize worker, processes one band of the current pass.
+//!
+//! The worker is destroyed by the event loop of the thread which processed it,
+//! because the event loop accesses the task after @c run() returned.
+struct FOG_NO_EXPORT ImageResize_Worker : public Task
+{
+  FOG_INLINE ImageResize_Worker(ImageResize_WorkMgr* wm, const ImageResizeContext& ctx) :
+    wm(wm),
+    ctx(ctx)
+  {
+  }
+
+  virtual void run();
+
+  //! @brief The work manager.
+  ImageResize_WorkMgr* wm;
+  //! @brief The context of the band.
+  ImageResizeContext ctx;
+};
+
+//! @internal
+//!
+//! @brief Resize work manager.
+//!
+//! Both passes are split into horizontal bands, the horizontal pass into bands
+//! of the source image (writing into the temporary image) and the vertical
+//! pass into bands of the destination image. The master thread processes the
+//! first band.
+struct FOG_NO_EXPORT ImageResize_WorkMgr
+{
+  FOG_INLINE ImageResize_WorkMgr() :
+    finishedCondition(&lock),
+    finished(0),
+    count(1),
+    func(NULL)
+  {
+  }
+
+  //! @brief Lock.
+  Lock lock;
+  //! @brief Condition signaled when the last worker finished.
+  ThreadCondition finishedCondition;
+  //! @brief Count of workers which finished the current pass.
+  uint finished;
+
+  //! @brief Count of workers (including the master thread).
+  uint count;
+  //! @brief Function of the current pass.
+  ImageResizeApi::DoHorizontalFunc func;
+
+  //! @brief Threads acquired from @c ThreadPool (count - 1).
+  Thread* threads[IMAGE_RESIZE_MAX_THREADS];
+};
+
+void ImageResize_Worker::run()
+{
+  wm->func(&ctx);
+
+  AutoLock locked(wm->lock);
+  if (++wm->finished == wm->count - 1)
+    wm->finishedCondition.signal();
+}
+
+//! @internal
+//!
+//! @brief Get count of threads used to resize the image described by @a ctx.
+static uint ImageResize_getThreadCount(const ImageResizeContext* ctx)
+{
+  uint64_t work = (uint64_t)(uint)ctx->dSize[0] * (uint)ctx->sSize[1] * ctx->kernelSize[0] +
+                  (uint64_t)(uint)ctx->dSize[0] * (uint)ctx->dSize[1] * ctx->kernelSize[1];
+
+  uint n = Math::min<uint>(Cpu::get()->getNumberOfProcessors(), IMAGE_RESIZE_MAX_THREADS);
+  if (work / IMAGE_RESIZE_MIN_THREAD_WORK < (uint64_t)n)
+    n = (uint)(work / IMAGE_RESIZE_MIN_THREAD_WORK);
+
+  // Each worker needs at least one row in both passes.
+  n = Math::min<uint>(n, (uint)ctx->sSize[1]);
+  n = Math::min<uint>(n, (uint)ctx->dSize[1]);
+
+  return Math::max<uint>(n, 1);
+}
+
+//! @internal
+//!
+//! @brief Acquire up to @a n - 1 threads, the master thread is the worker #0.
+static void ImageResize_acquireThreads(ImageResize_WorkMgr* wm, uint n)
+{
+  ThreadPool* pool = ThreadPool::get();
+  uint i;
+
+  for (i = 1; i < n; i++)
+  {
+    if (pool->getThread(&wm->threads[i - 1], (int)i) != ERR_OK)
+      break;
+  }
+
+  wm->count = i;
+}
+
+static void ImageResize_releaseThreads(ImageResize_WorkMgr* wm)
+{
+  if (wm->count > 1)
+    ThreadPool::get()->releaseThreads(wm->threads, wm->count - 1);
+  wm->count = 1;
+}
+
+//! @internal
+//!
+//! @brief Initialize the @a band (rows from @a y0 to @a y1) of the pass @a dir
+//! (0 - horizontal, 1 - vertical).
+static void ImageResize_initBand(ImageResizeContext* band, const ImageResizeContext* ctx, uint dir, uint y0, uint y1)
+{
+  const ImageResizeWeights* weights = ctx->weights[dir];
+  *band = *ctx;
+
+  if (dir == 0)
+  {
+    band->sData += (ssize_t)y0 * ctx->sStride;
+    band->tData += (ssize_t)y0 * ctx->tStride;
+    band->sSize[1] = (int)(y1 - y0);
+
+    band->recordList = weights->recordList;
+    band->weightList = weights->weightList;
+  }
+  else
+  {
+    // The records of the vertical pass point to the temporary image, so the
+    // band must use the original tData.
+    band->dData += (ssize_t)y0 * ctx->dStride;
+    band->dSize[1] = (int)(y1 - y0);
+
+    band->recordList = weights->recordList + y0;
+    band->weightList = weights->weightList + (size_t)y0 * weights->kernelSize;
+  }
+}
+
+//! @internal
+//!
+//! @brief Run the pass @a dir (0 - horizontal, 1 - vertical) using @a func.
+static void ImageResize_doPass(ImageResize_WorkMgr* wm, const ImageResizeContext* ctx, uint dir, ImageResizeApi::DoHorizontalFunc func)
+{
+  uint count = wm->count;
+  uint h = (uint)(dir == 0 ? ctx->sSize[1] : ctx->dSize[1]);
+
+  ImageResizeContext band;
+
+  wm->func = func;
+  wm->finished = 0;
+
+  for (uint i = 1; i < count; i++)
+  {
+    uint y0 = (uint)(((uint64_t)h * i) / count);
+    uint y1 = (uint)(((uint64_t)h * (i + 1)) / count);
+
+    ImageResize_initBand(&band, ctx, dir, y0, y1);
+    ImageResize_Worker* worker = fog_new ImageResize_Worker(wm, band);
+
+    if (worker != NULL)
+    {
+      if (wm->threads[i - 1]->getEventLoop().postTask(worker) == ERR_OK)
+        continue;
+
+      // The task is not destroyed by a failed postTask().
+      fog_delete(worker);
+    }
+
+    // Process the band by the master thread if the worker can't be created
+    // or posted.
+    func(&band);
+
+    AutoLock locked(wm->lock);
+    wm->finished++;
+  }
+
+  ImageResize_initBand(&band, ctx, dir, 0, h / count);
+  func(&band);
+
+  if (count > 1)
+  {
+    AutoLock locked(wm->lock);
+    while (wm->finished != count - 1)
+      wm->finishedCondition.wait();
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Scanlines]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Resizes the image passed scanline by scanline (see
+//! @ref ImageDecoder::readScanlines()).
+//!
+//! Each source scanline is resized horizontally when received and stored into
+//! the ring-buffer, which replaces the temporary image. Destination scanlines
+//! are resized vertically as soon as all source scanlines they depend on were
+//! received. The ring-buffer holds only the count of scanlines used by one
+//! destination scanline, so neither the source nor the temporary image is
+//! allocated.
+//!
+//! Each scanline is stored twice, at index (y % ringSize) and at index
+//! (y % ringSize + ringSize), so the scanlines used by a destination scanline
+//! are always contiguous and the vertical kernels can be used as is.
+struct FOG_NO_EXPORT ImageResize_ScanlineHandler : public ImageScanlineHandler
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  ImageResize_ScanlineHandler(Image* dst, const SizeI& dSize, const ImageResizeFunc* func);
+  virtual ~ImageResize_ScanlineHandler();
+
+  // --------------------------------------------------------------------------
+  // [Interface]
+  // --------------------------------------------------------------------------
+
+  virtual err_t onBegin(const SizeI& size, uint32_t format, const ImagePalette& palette);
+  virtual err_t onScanline(const uint8_t* data);
+  virtual err_t onEnd();
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Resize all destination scanlines which can be resized.
+  void doVertical();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Destination image.
+  Image* dst;
+  //! @brief Destination size.
+  SizeI dSize;
+  //! @brief Resize function.
+  const ImageResizeFunc* func;
+
+  //! @brief Whether the context was initialized.
+  bool hasContext;
+  //! @brief Resize context, @c tData is the ring-buffer.
+  ImageResizeContext ctx;
+
+  ImageResizeApi::DoHorizontalFunc doHorizontalFunc;
+  ImageResizeApi::DoVerticalFunc doVerticalFunc;
+
+  //! @brief Blitter used to convert scanlines which can't be resized (or
+  //! @c NULL).
+  RasterVBlitLineFunc blitLine;
+  //! @brief Blitter closure.
+  RasterClosure closure;
+  //! @brief Palette of scanlines (used by the blitter).
+  ImagePalette palette;
+  //! @brief Converted scanline.
+  MemBuffer buffer;
+
+  //! @brief Count of scanlines in the ring-buffer.
+  uint ringSize;
+  //! @brief Count of received source scanlines.
+  uint sy;
+  //! @brief Count of resized destination scanlines.
+  uint dy;
+  //! @brief Count of source scanlines needed by the destination scanlines
+  //! resized so far.
+  uint dyNeeded;
+};
+
+//! @internal
+//!
+//! @brief Get count of scanlines of the ring-buffer needed by @a weights.
+static uint ImageResize_getRingSize(const ImageResizeWeights* weights)
+{
+  const ImageResizeRecord* recordList = weights->recordList;
+
+  uint needed = 0;
+  uint ringSize = 1;
+
+  // Destination scanlines are resized in order, when the scanline is resized
+  // the ring-buffer contains the scanlines needed by all previous ones.
+  for (uint i = 0; i < (uint)weights->dSize; i++)
+  {
+    if (recordList[i].count == 0)
+      continue;
+
+    needed = Math::max<uint>(needed, recordList[i].pos + recordList[i].count);
+    ringSize = Math::max<uint>(ringSize, needed - recordList[i].pos);
+  }
 
-        dp += 1;
-        tData += 1;
-      } while (--i);
+  return ringSize;
+}
 
-_BoundLarge:
-      while (x >= 8)
-      {
-        const uint8_t* tp = tData;
-        const int32_t* wp = weightList;
+ImageResize_ScanlineHandler::ImageResize_ScanlineHandler(Image* dst, const SizeI& dSize, const ImageResizeFunc* func) :
+  dst(dst),
+  dSize(dSize),
+  func(func),
+  hasContext(false),
+  doHorizontalFunc(NULL),
+  doVerticalFunc(NULL),
+  blitLine(NULL),
+  ringSize(0),
+  sy(0),
+  dy(0),
+  dyNeeded(0)
+{
+}
 
-        uint32_t c0 = 0x00800080;
-        uint32_t c1 = 0x00800080;
-        uint32_t c2 = 0x00800080;
-        uint32_t c3 = 0x00800080;
+ImageResize_ScanlineHandler::~ImageResize_ScanlineHandler()
+{
+  if (hasContext)
+    ImageResize_api.destroy(&ctx);
+}
 
-        for (uint j = count; j; j--)
-        {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
-          uint32_t p1 = reinterpret_cast<const uint32_t*>(tp)[1];
-          uint32_t w0 = wp[0];
+err_t ImageResize_ScanlineHandler::onBegin(const SizeI& size, uint32_t format, const ImagePalette& sPalette)
+{
+  if (hasContext)
+    return ERR_RT_INVALID_STATE;
 
-          c0 += ((p0     ) & 0x00FF00FF) * w0;
-          c1 += ((p0 >> 8) & 0x00FF00FF) * w0;
-          c2 += ((p1     ) & 0x00FF00FF) * w0;
-          c3 += ((p1 >> 8) & 0x00FF00FF) * w0;
+  if (!size.isValid())
+  {
+    dst->reset();
+    return ERR_OK;
+  }
 
-          tp += tStride;
-          wp += 1;
-        }
+  if (format >= IMAGE_FORMAT_COUNT)
+    return ERR_IMAGE_INVALID_FORMAT;
 
-        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_2((c0 & 0xFF00FF00) >> 8, c1 & 0xFF00FF00);
-        reinterpret_cast<uint32_t*>(dp)[1] = _FOG_ACC_COMBINE_2((c2 & 0xFF00FF00) >> 8, c3 & 0xFF00FF00);
+  // Convert the scanlines which can't be resized to 32-bit (indexed scanlines
+  // are converted to PRGB32, because the palette can contain alpha).
+  if (ImageResize_api.doHorizontal[format] == NULL ||
+      ImageResize_api.doVertical[format] == NULL)
+  {
+    uint32_t cFormat = (format == IMAGE_FORMAT_I8 || ImageFormatDescription::getByFormat(format).getASize() != 0)
+      ? IMAGE_FORMAT_PRGB32
+      : IMAGE_FORMAT_XRGB32;
 
-        dp += 8;
-        tData += 8;
+    blitLine = _api_raster.getCopyFullFunc(cFormat, format);
+    if (blitLine == NULL)
+      return ERR_IMAGE_INVALID_FORMAT;
 
-        x -= 8;
-      }
+    if (FOG_IS_NULL(buffer.alloc((size_t)(uint)size.w * 4)))
+      return ERR_RT_OUT_OF_MEMORY;
 
-      i = x;
-      if (i != 0)
-        goto _BoundSmall;
+    palette = sPalette;
 
-      recordList += 1;
-      weightList += kernelSize;
+    closure.ditherOrigin.reset();
+    closure.data = NULL;
+    closure.palette = palette._d;
+    closure.colorKey = 0xFFFFFFFF;
 
-      dData += dStride;
-    }
+    format = cFormat;
   }
-  else
-  {
-    for (uint y = 0; y < dh; y++)
-    {
-      uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
-      uint8_t* dp = dData;
-      uint count = recordList->count;
 
-      uint x = dw;
-      uint i = 0;
+  FOG_RETURN_ON_ERROR(dst->create(dSize, format));
+  ImageData* dst_d = dst->_d;
 
-      if (((size_t)dp & 0x3) == 0)
-        goto _UnboundLarge;
-      i = 4 - ((uint)(size_t)dp & 0x3);
+  FOG_RETURN_ON_ERROR(
+    ImageResize_api.init(&ctx,
+      dst_d->first, dst_d->stride, dst_d->size.w, dst_d->size.h,
+      NULL, 0, size.w, size.h,
+      format,
+      func)
+  );
+  hasContext = true;
 
-_UnboundSmall:
-      x -= i;
-      do {
-        const uint8_t* tp = tData;
-        const int32_t* wp = weightList;
+  ringSize = ImageResize_getRingSize(ctx.weights[1]);
+  ctx.tData = reinterpret_cast<uint8_t*>(MemMgr::alloc((size_t)ringSize * 2 * ctx.tStride));
 
-        int32_t c0 = 0x80;
+  if (FOG_IS_NULL(ctx.tData))
+    return ERR_RT_OUT_OF_MEMORY;
 
-        for (uint j = count; j; j--)
-        {
-          uint32_t p0 = tp[0];
-          int32_t w0 = wp[0];
+  doHorizontalFunc = ImageResize_api.doHorizontal[format];
+  doVerticalFunc = ImageResize_api.doVertical[format];
 
-          c0 += (int32_t)p0 * w0;
+  // Destination scanlines which need no source scanline.
+  doVertical();
+  return ERR_OK;
+}
 
-          tp += tStride;
-          wp += 1;
-        }
+err_t ImageResize_ScanlineHandler::onScanline(const uint8_t* data)
+{
+  if (!hasContext || sy >= (uint)ctx.sSize[1])
+    return ERR_OK;
 
-        dp[0] = (uint8_t)(uint32_t)Math::bound<int32_t>(c0 >> 8, 0, 255);
+  if (blitLine != NULL)
+  {
+    uint8_t* cData = reinterpret_cast<uint8_t*>(buffer.getMem());
 
-        dp += 1;
-        tData += 1;
-      } while (--i);
+    blitLine(cData, data, ctx.sSize[0], &closure);
+    data = cData;
+  }
 
-_UnboundLarge:
-      while (x >= 4)
-      {
-        const uint8_t* tp = tData;
-        const int32_t* wp = weightList;
+  ssize_t tStride = ctx.tStride;
+  uint8_t* tData = ctx.tData + (ssize_t)(sy % ringSize) * tStride;
 
-        int32_t c0 = 0x80;
-        int32_t c1 = 0x80;
-        int32_t c2 = 0x80;
-        int32_t c3 = 0x80;
+  ImageResizeContext band = ctx;
+  band.sData = const_cast<uint8_t*>(data);
+  band.tData = tData;
+  band.sSize[1] = 1;
+  band.recordList = ctx.weights[0]->recordList;
+  band.weightList = ctx.weights[0]->weightList;
 
-        for (uint j = count; j; j--)
-        {
-          uint32_t p0 = reinterpret_cast<const uint32_t*>(tp)[0];
-          uint32_t w0 = wp[0];
+  doHorizontalFunc(&band);
+  MemOps::copy(tData + (ssize_t)ringSize * tStride, tData, (size_t)tStride);
 
-          c0 += ((p0      ) & 0xFF) * w0;
-          c1 += ((p0 >>  8) & 0xFF) * w0;
-          c2 += ((p0 >> 16) & 0xFF) * w0;
-          c3 += ((p0 >> 24)       ) * w0;
+  sy++;
+  doVertical();
 
-          tp += tStride;
-          wp += 1;
-        }
+  return ERR_OK;
+}
 
-        reinterpret_cast<uint32_t*>(dp)[0] = _FOG_ACC_COMBINE_4(
-          Math::bound<int32_t>(c0 >> 8, 0, 255)      ,
-          Math::bound<int32_t>(c1 >> 8, 0, 255) <<  8,
-          Math::bound<int32_t>(c2 >> 8, 0, 255) << 16,
-          Math::bound<int32_t>(c3 >> 8, 0, 255) << 24);
+err_t ImageResize_ScanlineHandler::onEnd()
+{
+  if (!hasContext)
+    return ERR_OK;
 
-        dp += 4;
-        tData += 4;
-        
-        x -= 4;
-      }
+  if (dy != (uint)ctx.dSize[1])
+    return ERR_IMAGE_TRUNCATED;
 
-      i = x;
-      if (i != 0)
-        goto _UnboundSmall;
+  return ERR_OK;
+}
 
-      recordList += 1;
-      weightList += kernelSize;
+void ImageResize_ScanlineHandler::doVertical()
+{
+  const ImageResizeWeights* weights = ctx.weights[1];
+  uint dh = (uint)ctx.dSize[1];
 
-      dData += dStride;
+  while (dy < dh)
+  {
+    ImageResizeRecord record = weights->recordList[dy];
+
+    if (record.count != 0)
+    {
+      uint needed = Math::max<uint>(dyNeeded, record.pos + record.count);
+      if (needed > sy)
+        break;
+
+      dyNeeded = needed;
+      record.pos %= ringSize;
     }
+
+    ImageResizeContext band = ctx;
+    band.dData += (ssize_t)dy * ctx.dStride;
+    band.dSize[1] = 1;
+    band.recordList = &record;
+    band.weightList = weights->weightList + (size_t)dy * weights->kernelSize;
+
+    doVerticalFunc(&band);
+    dy++;
   }
 }
 
-static void FOG_CDECL ImageResizeContext_doVertical_RGB24(ImageResizeContext* ctx)
-{
-  ImageResizeContext_doVertical_Bytes(ctx, 3);
-}
+// ============================================================================
+// [Fog::ImageResize - DoResize]
+// ============================================================================
 
-static void FOG_CDECL ImageResizeContext_doVertical_A8(ImageResizeContext* ctx)
+static err_t ImageResize_doResize(Image* dst, const SizeI* dSize, const Image* src, const ImageResizeFunc* func)
 {
-  ImageResizeContext_doVertical_Bytes(ctx, 1);
+  if (!Math::isFinite(func->radius) || func->radius < 1.0f || func->radius > 16.0f)
+    return ERR_RT_INVALID_ARGUMENT;
+
+  if (dSize && !dSize->isValid())
+    return ERR_IMAGE_INVALID_SIZE;
+
+  if (src->isEmpty())
+  {
+    dst->reset();
+    return ERR_OK;
+  }
+  
+  uint32_t format = src->getFormat();
+  if (ImageResize_api.doHorizontal[format] == NULL || ImageResize_api.doVertical[format] == NULL)
+    return ERR_IMAGE_INVALID_FORMAT;
+
+  FOG_RETURN_ON_ERROR(dst->create(*dSize, format));
+
+  ImageData* dst_d = dst->_d;
+  ImageData* src_d = src->_d;
+
+  ImageResizeContext ctx;
+
+  FOG_RETURN_ON_ERROR(
+    ImageResize_api.init(&ctx,
+      dst_d->first, dst_d->stride, dst_d->size.w, dst_d->size.h,
+      src_d->first, src_d->stride, src_d->size.w, src_d->size.h,
+      format,
+      func)
+  );
+
+  ctx.tData = reinterpret_cast<uint8_t*>(MemMgr::alloc((size_t)(uint)src_d->size.h * ctx.tStride));
+  if (FOG_IS_NULL(ctx.tData))
+  {
+    ImageResize_api.destroy(&ctx);
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  ImageResize_WorkMgr wm;
+  uint n = ImageResize_getThreadCount(&ctx);
+
+  if (n > 1)
+    ImageResize_acquireThreads(&wm, n);
+
+  ImageResize_doPass(&wm, &ctx, 0, ImageResize_api.doHorizontal[format]);
+  ImageResize_doPass(&wm, &ctx, 1, ImageResize_api.doVertical[format]);
+
+  ImageResize_releaseThreads(&wm);
+  ImageResize_api.destroy(&ctx);
+  return ERR_OK;
 }
 
 // ============================================================================
-// [Fog::ImageResize - Resize]
+// [Fog::ImageResize - Job]
 // ============================================================================
 
-static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+//! @internal
+//!
+//! @brief Resize job, run by @ref ImageResize_doFunc() using the resize
+//! function selected by the caller.
+struct FOG_NO_EXPORT ImageResize_Job
+{
+  virtual err_t run(const ImageResizeFunc* func) = 0;
+};
+
+//! @internal
+//!
+//! @brief Resize job of an image.
+struct FOG_NO_EXPORT ImageResize_ImageJob : public ImageResize_Job
+{
+  FOG_INLINE ImageResize_ImageJob(Image* dst, const SizeI* dSize, const Image* src) :
+    dst(dst),
+    dSize(dSize),
+    src(src)
+  {
+  }
+
+  virtual err_t run(const ImageResizeFunc* func)
+  {
+    return ImageResize_doResize(dst, dSize, src, func);
+  }
+
+  Image* dst;
+  const SizeI* dSize;
+  const Image* src;
+};
+
+//! @internal
+//!
+//! @brief Resize job of an image read by a decoder.
+struct FOG_NO_EXPORT ImageResize_DecoderJob : public ImageResize_Job
+{
+  FOG_INLINE ImageResize_DecoderJob(Image* dst, const SizeI* dSize, ImageDecoder* decoder) :
+    dst(dst),
+    dSize(dSize),
+    decoder(decoder)
+  {
+  }
+
+  virtual err_t run(const ImageResizeFunc* func)
+  {
+    if (!Math::isFinite(func->radius) || func->radius < 1.0f || func->radius > 16.0f)
+      return ERR_RT_INVALID_ARGUMENT;
+
+    if (!dSize->isValid())
+      return ERR_IMAGE_INVALID_SIZE;
+
+    ImageResize_ScanlineHandler handler(dst, *dSize, func);
+    return decoder->readScanlines(&handler, *dSize);
+  }
+
+  Image* dst;
+  const SizeI* dSize;
+  ImageDecoder* decoder;
+};
+
+static FOG_INLINE err_t ImageResize_doJob(ImageResize_Job* job,
+  uint32_t resizeFunc, const MathFunctionF* f, float radius, float p0 = 0.0f, float p1 = 0.0f)
+{
+  ImageResizeFunc func;
+
+  func.id = resizeFunc;
+  func.params[0] = p0;
+  func.params[1] = p1;
+  func.radius = radius;
+  func.func = f;
+
+  return job->run(&func);
+}
+
+static err_t ImageResize_doFunc(ImageResize_Job* job, uint32_t resizeFunc, const Hash<StringW, Var>* params)
 {
   switch (resizeFunc)
   {
     case IMAGE_RESIZE_NEAREST:
     {
       ImageResize_NearestFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 1.0f);
     }
 
     case IMAGE_RESIZE_BILINEAR:
     {
       ImageResize_BilinearFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 1.0f);
     }
 
     case IMAGE_RESIZE_BICUBIC:
     {
       ImageResize_BicubicFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 2.0f);
     }
 
     case IMAGE_RESIZE_BELL:
     {
       ImageResize_BellFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.5f);
+      return ImageResize_doJob(job, resizeFunc, &f, 1.5f);
     }
 
     case IMAGE_RESIZE_GAUSS:
     {
       ImageResize_GaussFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 2.0f);
     }
 
     case IMAGE_RESIZE_HERMITE:
     {
       ImageResize_HermiteFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 1.0f);
     }
 
     case IMAGE_RESIZE_HANNING:
     {
       ImageResize_HanningFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 1.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 1.0f);
     }
 
     case IMAGE_RESIZE_CATROM:
     {
       ImageResize_CatromFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 2.0f);
     }
 
     case IMAGE_RESIZE_MITCHELL:
@@ -1582,13 +2822,13 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
           f.init();
       }
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 2.0f);
+      return ImageResize_doJob(job, resizeFunc, &f, 2.0f, f.b, f.c);
     }
 
     case IMAGE_RESIZE_BESSEL:
     {
       ImageResize_BesselFunction f;
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, 3.2383f);
+      return ImageResize_doJob(job, resizeFunc, &f, 3.2383f);
     }
 
     case IMAGE_RESIZE_SINC:
@@ -1602,7 +2842,7 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
           FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
       }
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      return ImageResize_doJob(job, resizeFunc, &f, f.radius);
     }
 
     case IMAGE_RESIZE_LANCZOS:
@@ -1616,7 +2856,7 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
           FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
       }
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      return ImageResize_doJob(job, resizeFunc, &f, f.radius);
     }
 
     case IMAGE_RESIZE_BLACKMAN:
@@ -1630,7 +2870,7 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
           FOG_RETURN_ON_ERROR(r->getFloat(f.radius, 1.0f, 16.0f));
       }
 
-      return fog_api.image_resizeCustom(dst, dSize, src, sFragment, &f, f.radius);
+      return ImageResize_doJob(job, resizeFunc, &f, f.radius);
     }
 
     default:
@@ -1640,47 +2880,30 @@ static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const
   }
 }
 
+// ============================================================================
+// [Fog::ImageResize - Resize]
+// ============================================================================
+
+static err_t FOG_CDECL ImageResize_resize(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  ImageResize_ImageJob job(dst, dSize, src);
+  return ImageResize_doFunc(&job, resizeFunc, params);
+}
+
 static err_t FOG_CDECL ImageResize_resizeCustom(Image* dst, const SizeI* dSize, const Image* src, const RectI* sFragment, const MathFunctionF* resizeFunc, float radius)
 {
   if (FOG_IS_NULL(resizeFunc))
     return ERR_RT_INVALID_ARGUMENT;
 
-  if (!Math::isFinite(radius) || radius < 1.0f || radius > 16.0f)
-    return ERR_RT_INVALID_ARGUMENT;
-
-  if (dSize && !dSize->isValid())
-    return ERR_IMAGE_INVALID_SIZE;
-
-  if (src->isEmpty())
-  {
-    dst->reset();
-    return ERR_OK;
-  }
-  
-  uint32_t format = src->getFormat();
-  FOG_RETURN_ON_ERROR(dst->create(*dSize, format));
-
-  ImageData* dst_d = dst->_d;
-  ImageData* src_d = src->_d;
-
-  ImageResizeContext ctx;
-
-  FOG_RETURN_ON_ERROR(
-    ImageResize_api.init(&ctx,
-      dst_d->first, dst_d->stride, dst_d->size.w, dst_d->size.h,
-      src_d->first, src_d->stride, src_d->size.w, src_d->size.h,
-      format,
-      resizeFunc, radius)
-  );
-
-  ImageResize_api.doWeights(&ctx, 0);
-  ImageResize_api.doHorizontal[format](&ctx);
-
-  ImageResize_api.doWeights(&ctx, 1);
-  ImageResize_api.doVertical[format](&ctx);
+  // The custom function can't be identified, so its weights are not cached.
+  ImageResize_ImageJob job(dst, dSize, src);
+  return ImageResize_doJob(&job, IMAGE_RESIZE_COUNT, resizeFunc, radius);
+}
 
-  ImageResize_api.destroy(&ctx);
-  return ERR_OK;
+static err_t FOG_CDECL ImageResize_resizeDecoder(Image* dst, const SizeI* dSize, ImageDecoder* decoder, uint32_t resizeFunc, const Hash<StringW, Var>* params)
+{
+  ImageResize_DecoderJob job(dst, dSize, decoder);
+  return ImageResize_doFunc(&job, resizeFunc, params);
 }
 
 // ============================================================================
@@ -1691,30 +2914,37 @@ FOG_CPU_DECLARE_INITIALIZER_SSE2( ImageResize_init_SSE2(ImageResizeApi* api) )
 
 FOG_NO_EXPORT void ImageResize_init(void)
 {
+  ImageResize_cache.init();
+
   // --------------------------------------------------------------------------
   // [Funcs]
   // --------------------------------------------------------------------------
 
   fog_api.image_resize = ImageResize_resize;
   fog_api.image_resizeCustom = ImageResize_resizeCustom;
+  fog_api.image_resizeDecoder = ImageResize_resizeDecoder;
 
   ImageResize_api.init = ImageResizeContext_init;
   ImageResize_api.destroy = ImageResizeContext_destroy;
-  ImageResize_api.doWeights = ImageResizeContext_doWeights;
+  ImageResize_api.doWeights = ImageResizeWeights_doWeights;
 
   ImageResize_api.doHorizontal[IMAGE_FORMAT_PRGB32] = ImageResizeContext_doHorizontal_PRGB32;
   ImageResize_api.doHorizontal[IMAGE_FORMAT_XRGB32] = ImageResizeContext_doHorizontal_XRGB32;
   ImageResize_api.doHorizontal[IMAGE_FORMAT_RGB24 ] = ImageResizeContext_doHorizontal_RGB24;
   ImageResize_api.doHorizontal[IMAGE_FORMAT_A8    ] = ImageResizeContext_doHorizontal_A8;
 //ImageResize_api.doHorizontal[IMAGE_FORMAT_I8    ] = NONE;
-  // TODO: 16-bit image processing.
+  ImageResize_api.doHorizontal[IMAGE_FORMAT_PRGB64] = ImageResizeContext_doHorizontal_PRGB64;
+  ImageResize_api.doHorizontal[IMAGE_FORMAT_RGB48 ] = ImageResizeContext_doHorizontal_RGB48;
+  ImageResize_api.doHorizontal[IMAGE_FORMAT_A16   ] = ImageResizeContext_doHorizontal_A16;
 
   ImageResize_api.doVertical[IMAGE_FORMAT_PRGB32] = ImageResizeContext_doVertical_PRGB32;
   ImageResize_api.doVertical[IMAGE_FORMAT_XRGB32] = ImageResizeContext_doVertical_XRGB32;
   ImageResize_api.doVertical[IMAGE_FORMAT_RGB24 ] = ImageResizeContext_doVertical_RGB24;
   ImageResize_api.doVertical[IMAGE_FORMAT_A8    ] = ImageResizeContext_doVertical_A8;
 //ImageResize_api.doVertical[IMAGE_FORMAT_I8    ] = NONE;
-  // TODO: 16-bit image processing.
+  ImageResize_api.doVertical[IMAGE_FORMAT_PRGB64] = ImageResizeContext_doVertical_PRGB64;
+  ImageResize_api.doVertical[IMAGE_FORMAT_RGB48 ] = ImageResizeContext_doVertical_RGB48;
+  ImageResize_api.doVertical[IMAGE_FORMAT_A16   ] = ImageResizeContext_doVertical_A16;
 
   // --------------------------------------------------------------------------
   // [CPU Based Optimizations]
@@ -1723,4 +2953,10 @@ FOG_NO_EXPORT void ImageResize_init(void)
   FOG_CPU_USE_INITIALIZER_SSE2( ImageResize_init_SSE2(&ImageResize_api) )
 }
 
+FOG_NO_EXPORT void ImageResize_fini(void)
+{
+  ImageResize_resetCache();
+  ImageResize_cache.destroy();
+}
+
 } // Fog namespace
@@ -34,6 +34,9 @@ FOG_XMM_DECLARE_CONST_PI16_VAR(ImageResizeHalf16HiLo_PRGB32, 0x0080, 0x0080, 0x0
 FOG_XMM_DECLARE_CONST_PI16_VAR(ImageResizeHalf16HiLo_XRGB32, 0xFFFF, 0x0080, 0x0080, 0x0080, 0xFFFF, 0x0080, 0x0080, 0x0080);
 
 FOG_XMM_DECLARE_CONST_PI32_VAR(ImageResizeHalf32, 0x00000080, 0x00000080, 0x00000080, 0x00000080);
+FOG_XMM_DECLARE_CONST_PI32_VAR(ImageResizeNone32, 0xFF800080, 0xFF800080, 0xFF800080, 0xFF800080);
+
+FOG_XMM_DECLARE_CONST_PI16_VAR(ImageResizeBias16, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000);
 
 // ============================================================================
 // [Fog::ImageResize - Context - DoHorizontal - PRGB32 (SSE2)]
@@ -769,13 +772,613 @@ static void FOG_CDECL ImageResizeContext_doHorizontal_XRGB32_SSE2(ImageResizeCon
   }
 }
 
+// ============================================================================
+// [Fog::ImageResize - Context - DoHorizontal - RGB24 (SSE2)]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doHorizontal_RGB24_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[0];
+
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
+
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
+
+  ssize_t sStride = ctx->sStride;
+  ssize_t tStride = ctx->tStride;
+
+  if (ctx->isBound[0] == 1)
+  {
+    __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf16ZZLo_PRGB32);
+
+    for (uint y = 0; y < sh; y++)
+    {
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* sp = sData + recordList->pos * 3;
+        const int32_t* wp = weightList;
+
+        __m128i xmmAcc0 = xmmHalf;
+        int j = (int)recordList->count;
+
+        while ((j -= 2) >= 0)
+        {
+          uint32_t p0;
+          uint32_t p1;
+
+          __m128i xmmPixel0;
+          __m128i xmmPixel1;
+          __m128i xmmWeight0;
+
+          Acc::p32Load3b(p0, sp + 0);
+          Acc::p32Load3b(p1, sp + 3);
+          Acc::m128iLoad8(xmmWeight0, wp);
+
+          Acc::m128iCvtSI128FromSI(xmmPixel0, (int)p0);
+          Acc::m128iCvtSI128FromSI(xmmPixel1, (int)p1);
+          Acc::m128iShufflePI16Lo<2, 2, 0, 0>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI64FromPI32Lo(xmmPixel0, xmmPixel0, xmmPixel1);
+          Acc::m128iShufflePI32<0, 0, 1, 1>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI16FromPI8Lo(xmmPixel0, xmmPixel0);
+          Acc::m128iMulLoPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+          Acc::m128iAddPI16(xmmAcc0, xmmAcc0, xmmPixel0);
+
+          sp += 6;
+          wp += 2;
+        }
+
+        if (j == -1)
+        {
+          uint32_t p0;
+
+          __m128i xmmPixel0;
+          __m128i xmmWeight0;
+
+          Acc::p32Load3b(p0, sp);
+          Acc::m128iLoad4(xmmWeight0, wp);
+
+          Acc::m128iCvtSI128FromSI(xmmPixel0, (int)p0);
+          Acc::m128iShufflePI16Lo<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI16FromPI8Lo(xmmPixel0, xmmPixel0);
+          Acc::m128iMulLoPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+          Acc::m128iAddPI16(xmmAcc0, xmmAcc0, xmmPixel0);
+        }
+
+        {
+          __m128i xmmTmp0;
+          int c0;
+
+          Acc::m128iShufflePI32<1, 0, 3, 2>(xmmTmp0, xmmAcc0);
+          Acc::m128iAddPI16(xmmAcc0, xmmAcc0, xmmTmp0);
+
+          Acc::m128iRShiftPU16<8>(xmmAcc0, xmmAcc0);
+          Acc::m128iPackPU8FromPU16(xmmAcc0, xmmAcc0);
+          Acc::m128iCvtSIFromSI128(c0, xmmAcc0);
+          Acc::p32Store3b(tp, (uint32_t)c0);
+        }
+
+        recordList += 1;
+        weightList += kernelSize;
+
+        tp += 3;
+      }
+
+      sData += sStride;
+      tData += tStride;
+    }
+  }
+  else
+  {
+    __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf32);
+
+    for (uint y = 0; y < sh; y++)
+    {
+      const ImageResizeRecord* recordList = ctx->recordList;
+      const int32_t* weightList = ctx->weightList;
+
+      uint8_t* tp = tData;
+
+      for (uint x = 0; x < dw; x++)
+      {
+        const uint8_t* sp = sData + recordList->pos * 3;
+        const int32_t* wp = weightList;
+
+        __m128i xmmAcc0 = xmmHalf;
+        int j = (int)recordList->count;
+
+        while ((j -= 2) >= 0)
+        {
+          uint32_t p0;
+          uint32_t p1;
+
+          __m128i xmmPixelLo0;
+          __m128i xmmPixelHi0;
+          __m128i xmmPixel1;
+          __m128i xmmWeight0;
+
+          Acc::p32Load3b(p0, sp + 0);
+          Acc::p32Load3b(p1, sp + 3);
+          Acc::m128iLoad8(xmmWeight0, wp);
+
+          Acc::m128iCvtSI128FromSI(xmmPixelLo0, (int)p0);
+          Acc::m128iCvtSI128FromSI(xmmPixel1, (int)p1);
+          Acc::m128iShufflePI16Lo<2, 2, 0, 0>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI64FromPI32Lo(xmmPixelLo0, xmmPixelLo0, xmmPixel1);
+          Acc::m128iShufflePI32<0, 0, 1, 1>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI16FromPI8Lo(xmmPixelLo0, xmmPixelLo0);
+          Acc::m128iCopy(xmmPixelHi0, xmmPixelLo0);
+
+          Acc::m128iMulLoPI16(xmmPixelLo0, xmmPixelLo0, xmmWeight0);
+          Acc::m128iMulHiPI16(xmmPixelHi0, xmmPixelHi0, xmmWeight0);
+
+          Acc::m128iCopy(xmmWeight0, xmmPixelLo0);
+          Acc::m128iUnpackPI32FromPI16Lo(xmmPixelLo0, xmmPixelLo0, xmmPixelHi0);
+          Acc::m128iUnpackPI32FromPI16Hi(xmmWeight0, xmmWeight0, xmmPixelHi0);
+
+          Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixelLo0);
+          Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmWeight0);
+
+          sp += 6;
+          wp += 2;
+        }
+
+        if (j == -1)
+        {
+          uint32_t p0;
+
+          __m128i xmmPixelLo0;
+          __m128i xmmPixelHi0;
+          __m128i xmmWeight0;
+
+          Acc::p32Load3b(p0, sp);
+          Acc::m128iLoad4(xmmWeight0, wp);
+
+          Acc::m128iCvtSI128FromSI(xmmPixelLo0, (int)p0);
+          Acc::m128iShufflePI16Lo<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+          Acc::m128iUnpackPI16FromPI8Lo(xmmPixelLo0, xmmPixelLo0);
+          Acc::m128iCopy(xmmPixelHi0, xmmPixelLo0);
+
+          Acc::m128iMulLoPI16(xmmPixelLo0, xmmPixelLo0, xmmWeight0);
+          Acc::m128iMulHiPI16(xmmPixelHi0, xmmPixelHi0, xmmWeight0);
+
+          Acc::m128iUnpackPI32FromPI16Lo(xmmPixelLo0, xmmPixelLo0, xmmPixelHi0);
+          Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixelLo0);
+        }
+
+        {
+          int c0;
+
+          Acc::m128iRShiftPI32<8>(xmmAcc0, xmmAcc0);
+          Acc::m128iPackPU8FromPI32(xmmAcc0, xmmAcc0);
+          Acc::m128iCvtSIFromSI128(c0, xmmAcc0);
+          Acc::p32Store3b(tp, (uint32_t)c0);
+        }
+
+        recordList += 1;
+        weightList += kernelSize;
+
+        tp += 3;
+      }
+
+      sData += sStride;
+      tData += tStride;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoHorizontal - A8 (SSE2)]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doHorizontal_A8_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[0];
+
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
+
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
+
+  ssize_t sStride = ctx->sStride;
+  ssize_t tStride = ctx->tStride;
+
+  // Four pixels are multiplied by four weights (packed to words) using PMADDWD,
+  // which accumulates to 32-bit, so the same code is used for bound and unbound
+  // weights (the result is saturated in both cases, it's never out of range if
+  // weights are bound).
+  for (uint y = 0; y < sh; y++)
+  {
+    const ImageResizeRecord* recordList = ctx->recordList;
+    const int32_t* weightList = ctx->weightList;
+
+    uint8_t* tp = tData;
+
+    for (uint x = 0; x < dw; x++)
+    {
+      const uint8_t* sp = sData + recordList->pos * 1;
+      const int32_t* wp = weightList;
+
+      __m128i xmmAcc0;
+      Acc::m128iZero(xmmAcc0);
+
+      int32_t c0 = 0x80;
+      int j = (int)recordList->count;
+
+      while ((j -= 4) >= 0)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad4(xmmPixel0, sp);
+        Acc::m128iLoad16u(xmmWeight0, wp);
+
+        Acc::m128iUnpackPI16FromPI8Lo(xmmPixel0, xmmPixel0);
+        Acc::m128iPackPI16FromPI32(xmmWeight0, xmmWeight0);
+
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+
+        sp += 4;
+        wp += 4;
+      }
+
+      for (j += 4; j; j--)
+      {
+        c0 += (int32_t)sp[0] * wp[0];
+
+        sp += 1;
+        wp += 1;
+      }
+
+      {
+        __m128i xmmTmp0;
+        int t0;
+
+        Acc::m128iShufflePI32<3, 2, 0, 1>(xmmTmp0, xmmAcc0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmTmp0);
+        Acc::m128iCvtSIFromSI128(t0, xmmAcc0);
+
+        c0 += t0;
+      }
+
+      tp[0] = (uint8_t)(uint32_t)Math::bound<int32_t>(c0 >> 8, 0, 255);
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      tp += 1;
+    }
+
+    sData += sStride;
+    tData += tStride;
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoHorizontal - PRGB64 (SSE2)]
+// ============================================================================
+
+// 16-bit components are multiplied by weights using PMADDWD, which multiplies
+// signed words, so components are biased to signed (0x8000 is subtracted) and
+// the result is biased back after it was saturated to signed words. The bias
+// multiplied by the sum of weights (0x100) is removed this way, the pixel
+// having no weights starts at ImageResizeNone32 so it's zero after unbiasing.
+//
+// Weights are not bound here, the result is saturated by the pack instruction
+// and premultiplied components are bound to alpha by PMINSW. If weights are
+// bound the result is never out of range.
+
+static void FOG_CDECL ImageResizeContext_doHorizontal_PRGB64_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[0];
+
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
+
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
+
+  ssize_t sStride = ctx->sStride;
+  ssize_t tStride = ctx->tStride;
+
+  __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf32);
+  __m128i xmmNone = FOG_XMM_GET_CONST_PI(ImageResizeNone32);
+  __m128i xmmBias = FOG_XMM_GET_CONST_PI(ImageResizeBias16);
+
+  for (uint y = 0; y < sh; y++)
+  {
+    const ImageResizeRecord* recordList = ctx->recordList;
+    const int32_t* weightList = ctx->weightList;
+
+    uint8_t* tp = tData;
+
+    for (uint x = 0; x < dw; x++)
+    {
+      const uint8_t* sp = sData + recordList->pos * 8;
+      const int32_t* wp = weightList;
+
+      int j = (int)recordList->count;
+      __m128i xmmAcc0 = (j != 0) ? xmmHalf : xmmNone;
+
+      while ((j -= 2) >= 0)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmPixel1;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad8(xmmPixel0, sp + 0);
+        Acc::m128iLoad8(xmmPixel1, sp + 8);
+        Acc::m128iLoad8(xmmWeight0, wp);
+
+        Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0, xmmPixel1);
+        Acc::m128iShufflePI16Lo<0, 2, 0, 2>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+        Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+
+        sp += 16;
+        wp += 2;
+      }
+
+      if (j == -1)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad8(xmmPixel0, sp);
+        Acc::m128iLoad4(xmmWeight0, wp);
+
+        Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+        Acc::m128iShufflePI16Lo<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0);
+        Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+      }
+
+      {
+        __m128i xmmTmp0;
+
+        Acc::m128iRShiftPI32<8>(xmmAcc0, xmmAcc0);
+        Acc::m128iPackPI16FromPI32(xmmAcc0, xmmAcc0);
+        Acc::m128iShufflePI16Lo<3, 3, 3, 3>(xmmTmp0, xmmAcc0);
+        Acc::m128iMinPI16(xmmAcc0, xmmAcc0, xmmTmp0);
+        Acc::m128iXor(xmmAcc0, xmmAcc0, xmmBias);
+        Acc::m128iStore8(tp, xmmAcc0);
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      tp += 8;
+    }
+
+    sData += sStride;
+    tData += tStride;
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoHorizontal - RGB48 (SSE2)]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doHorizontal_RGB48_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[0];
+
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
+
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
+
+  ssize_t sStride = ctx->sStride;
+  ssize_t tStride = ctx->tStride;
+
+  __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf32);
+  __m128i xmmNone = FOG_XMM_GET_CONST_PI(ImageResizeNone32);
+  __m128i xmmBias = FOG_XMM_GET_CONST_PI(ImageResizeBias16);
+
+  for (uint y = 0; y < sh; y++)
+  {
+    const ImageResizeRecord* recordList = ctx->recordList;
+    const int32_t* weightList = ctx->weightList;
+
+    uint8_t* tp = tData;
+
+    for (uint x = 0; x < dw; x++)
+    {
+      const uint8_t* sp = sData + recordList->pos * 6;
+      const int32_t* wp = weightList;
+
+      int j = (int)recordList->count;
+      __m128i xmmAcc0 = (j != 0) ? xmmHalf : xmmNone;
+
+      // The fourth word is not part of the pixel, it's inserted to not read
+      // past the end of the scanline and its result is ignored.
+      while ((j -= 2) >= 0)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmPixel1;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad4(xmmPixel0, sp + 0);
+        Acc::m128iLoad4(xmmPixel1, sp + 6);
+        Acc::m128iLoad8(xmmWeight0, wp);
+
+        Acc::m128iInsertPI16<2>(xmmPixel0, xmmPixel0, (int)reinterpret_cast<const uint16_t*>(sp)[2]);
+        Acc::m128iInsertPI16<2>(xmmPixel1, xmmPixel1, (int)reinterpret_cast<const uint16_t*>(sp)[5]);
+
+        Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0, xmmPixel1);
+        Acc::m128iShufflePI16Lo<0, 2, 0, 2>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+        Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+
+        sp += 12;
+        wp += 2;
+      }
+
+      if (j == -1)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad4(xmmPixel0, sp);
+        Acc::m128iLoad4(xmmWeight0, wp);
+
+        Acc::m128iInsertPI16<2>(xmmPixel0, xmmPixel0, (int)reinterpret_cast<const uint16_t*>(sp)[2]);
+        Acc::m128iShufflePI16Lo<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+        Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight0, xmmWeight0);
+
+        Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0);
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+      }
+
+      {
+        int c2;
+
+        Acc::m128iRShiftPI32<8>(xmmAcc0, xmmAcc0);
+        Acc::m128iPackPI16FromPI32(xmmAcc0, xmmAcc0);
+        Acc::m128iXor(xmmAcc0, xmmAcc0, xmmBias);
+        Acc::m128iExtractPI16<2>(c2, xmmAcc0);
+
+        Acc::m128iStore4(tp, xmmAcc0);
+        reinterpret_cast<uint16_t*>(tp)[2] = (uint16_t)(uint32_t)c2;
+      }
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      tp += 6;
+    }
+
+    sData += sStride;
+    tData += tStride;
+  }
+}
+
+// ============================================================================
+// [Fog::ImageResize - Context - DoHorizontal - A16 (SSE2)]
+// ============================================================================
+
+static void FOG_CDECL ImageResizeContext_doHorizontal_A16_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[0];
+
+  uint dw = ctx->dSize[0];
+  uint sh = ctx->sSize[1];
+
+  uint8_t* sData = ctx->sData;
+  uint8_t* tData = ctx->tData;
+
+  ssize_t sStride = ctx->sStride;
+  ssize_t tStride = ctx->tStride;
+
+  __m128i xmmBias = FOG_XMM_GET_CONST_PI(ImageResizeBias16);
+
+  for (uint y = 0; y < sh; y++)
+  {
+    const ImageResizeRecord* recordList = ctx->recordList;
+    const int32_t* weightList = ctx->weightList;
+
+    uint8_t* tp = tData;
+
+    for (uint x = 0; x < dw; x++)
+    {
+      const uint8_t* sp = sData + recordList->pos * 2;
+      const int32_t* wp = weightList;
+
+      __m128i xmmAcc0;
+      Acc::m128iZero(xmmAcc0);
+
+      int j = (int)recordList->count;
+      int32_t c0 = (j != 0) ? 0x80 : 0x80 - 0x800000;
+
+      // Only the first two dwords of the accumulator are used, the rest
+      // contains the biased zeros (high quadword of the pixels).
+      while ((j -= 4) >= 0)
+      {
+        __m128i xmmPixel0;
+        __m128i xmmWeight0;
+
+        Acc::m128iLoad8(xmmPixel0, sp);
+        Acc::m128iLoad16u(xmmWeight0, wp);
+
+        Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+        Acc::m128iPackPI16FromPI32(xmmWeight0, xmmWeight0);
+
+        Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+
+        sp += 8;
+        wp += 4;
+      }
+
+      for (j += 4; j; j--)
+      {
+        c0 += ((int32_t)reinterpret_cast<const uint16_t*>(sp)[0] - 0x8000) * wp[0];
+
+        sp += 2;
+        wp += 1;
+      }
+
+      {
+        __m128i xmmTmp0;
+        int t0;
+
+        Acc::m128iShufflePI32<3, 2, 0, 1>(xmmTmp0, xmmAcc0);
+        Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmTmp0);
+        Acc::m128iCvtSIFromSI128(t0, xmmAcc0);
+
+        c0 += t0;
+      }
+
+      reinterpret_cast<uint16_t*>(tp)[0] = (uint16_t)(uint32_t)(Math::bound<int32_t>(c0 >> 8, -0x8000, 0x7FFF) + 0x8000);
+
+      recordList += 1;
+      weightList += kernelSize;
+
+      tp += 2;
+    }
+
+    sData += sStride;
+    tData += tStride;
+  }
+}
+
 // ============================================================================
 // [Fog::ImageResize - Context - DoVertical - PRGB32 (SSE2)]
 // ============================================================================
 
 static void FOG_CDECL ImageResizeContext_doVertical_PRGB32_SSE2(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -805,7 +1408,7 @@ static void FOG_CDECL ImageResizeContext_doVertical_PRGB32_SSE2(ImageResizeConte
         goto _BoundSmall;
       if (((size_t)dp & 0xF) == 0)
         goto _BoundLarge;
-      i = 4 - (((uint)(size_t)dp & 0xF) >> 2);
+      i = Math::min<uint>(x, 4 - (((uint)(size_t)dp & 0xF) >> 2));
 
 _BoundSmall:
       x -= i;
@@ -926,7 +1529,7 @@ _BoundLarge:
         goto _UnboundSmall;
       if (((size_t)dp & 0xF) == 0)
         goto _UnboundLarge;
-      i = 4 - (((uint)(size_t)dp & 0xF) >> 2);
+      i = Math::min<uint>(x, 4 - (((uint)(size_t)dp & 0xF) >> 2));
 
 _UnboundSmall:
       x -= i;
@@ -1061,7 +1664,7 @@ _UnboundLarge:
 
 static void FOG_CDECL ImageResizeContext_doVertical_XRGB32_SSE2(ImageResizeContext* ctx)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0];
   uint dh = ctx->dSize[1];
@@ -1091,7 +1694,7 @@ static void FOG_CDECL ImageResizeContext_doVertical_XRGB32_SSE2(ImageResizeConte
         goto _BoundSmall;
       if (((size_t)dp & 0xF) == 0)
         goto _BoundLarge;
-      i = 4 - (((uint)(size_t)dp & 0xF) >> 2);
+      i = Math::min<uint>(x, 4 - (((uint)(size_t)dp & 0xF) >> 2));
 
 _BoundSmall:
       x -= i;
@@ -1212,7 +1815,7 @@ _BoundLarge:
         goto _UnboundSmall;
       if (((size_t)dp & 0xF) == 0)
         goto _UnboundLarge;
-      i = 4 - (((uint)(size_t)dp & 0xF) >> 2);
+      i = Math::min<uint>(x, 4 - (((uint)(size_t)dp & 0xF) >> 2));
 
 _UnboundSmall:
       x -= i;
@@ -1345,7 +1948,7 @@ _UnboundLarge:
 
 static void FOG_CDECL ImageResizeContext_doVertical_Bytes_SSE2(ImageResizeContext* ctx, uint wScale)
 {
-  uint kernelSize = ctx->kernelSize[0];
+  uint kernelSize = ctx->kernelSize[1];
 
   uint dw = ctx->dSize[0] * wScale;
   uint dh = ctx->dSize[1];
@@ -1373,7 +1976,7 @@ static void FOG_CDECL ImageResizeContext_doVertical_Bytes_SSE2(ImageResizeContex
 
       if (((size_t)dp & 0xF) == 0)
         goto _BoundLarge;
-      i = 16 - ((uint)(size_t)dp & 0xF);
+      i = Math::min<uint>(x, 16 - ((uint)(size_t)dp & 0xF));
 
 _BoundSmall:
       x -= i;
@@ -1528,7 +2131,7 @@ _BoundLarge:
 
       if (((size_t)dp & 0xF) == 0)
         goto _UnboundLarge;
-      i = 16 - ((uint)(size_t)dp & 0xF);
+      i = Math::min<uint>(x, 16 - ((uint)(size_t)dp & 0xF));
 
 _UnboundSmall:
       x -= i;
@@ -1703,6 +2306,249 @@ static void FOG_CDECL ImageResizeContext_doVertical_A8_SSE2(ImageResizeContext*
   ImageResizeContext_doVertical_Bytes_SSE2(ctx, 1);
 }
 
+// ============================================================================
+// [Fog::ImageResize - Context - DoVertical - PRGB64, RGB48, A16 (SSE2)]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Resize 8 words vertically.
+//!
+//! Two scanlines are interleaved and multiplied by a pair of weights using
+//! PMADDWD, words are biased the same way as in the horizontal pass. The
+//! result is saturated to signed words and it's still biased.
+static FOG_INLINE void ImageResizeContext_doVertical8W_SSE2(__m128i& dst0,
+  const uint8_t* tp, ssize_t tStride, const int32_t* wp, uint count,
+  const __m128i& xmmHalf, const __m128i& xmmBias)
+{
+  __m128i xmmAcc0 = xmmHalf;
+  __m128i xmmAcc1 = xmmHalf;
+
+  int j = (int)count;
+
+  while ((j -= 2) >= 0)
+  {
+    __m128i xmmPixel0;
+    __m128i xmmPixel1;
+    __m128i xmmPixelHi;
+    __m128i xmmWeight;
+
+    Acc::m128iLoad16u(xmmPixel0, tp);
+    Acc::m128iLoad16u(xmmPixel1, tp + tStride);
+    Acc::m128iLoad8(xmmWeight, wp);
+
+    Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+    Acc::m128iXor(xmmPixel1, xmmPixel1, xmmBias);
+    Acc::m128iShufflePI16Lo<0, 2, 0, 2>(xmmWeight, xmmWeight);
+
+    Acc::m128iUnpackPI32FromPI16Hi(xmmPixelHi, xmmPixel0, xmmPixel1);
+    Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0, xmmPixel1);
+    Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight, xmmWeight);
+
+    Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight);
+    Acc::m128iMAddPI16(xmmPixelHi, xmmPixelHi, xmmWeight);
+
+    Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+    Acc::m128iAddPI32(xmmAcc1, xmmAcc1, xmmPixelHi);
+
+    tp += tStride * 2;
+    wp += 2;
+  }
+
+  if (j == -1)
+  {
+    __m128i xmmPixel0;
+    __m128i xmmPixelHi;
+    __m128i xmmWeight;
+
+    Acc::m128iLoad16u(xmmPixel0, tp);
+    Acc::m128iLoad4(xmmWeight, wp);
+
+    Acc::m128iXor(xmmPixel0, xmmPixel0, xmmBias);
+    Acc::m128iShufflePI16Lo<0, 0, 0, 0>(xmmWeight, xmmWeight);
+
+    Acc::m128iUnpackPI32FromPI16Hi(xmmPixelHi, xmmPixel0);
+    Acc::m128iUnpackPI32FromPI16Lo(xmmPixel0, xmmPixel0);
+    Acc::m128iShufflePI32<0, 0, 0, 0>(xmmWeight, xmmWeight);
+
+    Acc::m128iMAddPI16(xmmPixel0, xmmPixel0, xmmWeight);
+    Acc::m128iMAddPI16(xmmPixelHi, xmmPixelHi, xmmWeight);
+
+    Acc::m128iAddPI32(xmmAcc0, xmmAcc0, xmmPixel0);
+    Acc::m128iAddPI32(xmmAcc1, xmmAcc1, xmmPixelHi);
+  }
+
+  Acc::m128iRShiftPI32<8>(xmmAcc0, xmmAcc0);
+  Acc::m128iRShiftPI32<8>(xmmAcc1, xmmAcc1);
+  Acc::m128iPackPI16FromPI32(dst0, xmmAcc0, xmmAcc1);
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_PRGB64_SSE2(ImageResizeContext* ctx)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0];
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf32);
+  __m128i xmmNone = FOG_XMM_GET_CONST_PI(ImageResizeNone32);
+  __m128i xmmBias = FOG_XMM_GET_CONST_PI(ImageResizeBias16);
+
+  for (uint y = 0; y < dh; y++)
+  {
+    uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+    uint8_t* dp = dData;
+    uint count = recordList->count;
+
+    __m128i xmmInit = (count != 0) ? xmmHalf : xmmNone;
+    uint x = dw;
+
+    while (x >= 2)
+    {
+      __m128i xmmAcc0;
+      __m128i xmmTmp0;
+
+      ImageResizeContext_doVertical8W_SSE2(xmmAcc0, tData, tStride, weightList, count, xmmInit, xmmBias);
+
+      Acc::m128iShufflePI16Lo<3, 3, 3, 3>(xmmTmp0, xmmAcc0);
+      Acc::m128iShufflePI16Hi<3, 3, 3, 3>(xmmTmp0, xmmTmp0);
+      Acc::m128iMinPI16(xmmAcc0, xmmAcc0, xmmTmp0);
+      Acc::m128iXor(xmmAcc0, xmmAcc0, xmmBias);
+      Acc::m128iStore16u(dp, xmmAcc0);
+
+      dp += 16;
+      tData += 16;
+
+      x -= 2;
+    }
+
+    if (x != 0)
+    {
+      const uint8_t* tp = tData;
+
+      int32_t ca = 0x80;
+      int32_t cr = 0x80;
+      int32_t cg = 0x80;
+      int32_t cb = 0x80;
+
+      for (uint j = 0; j < count; j++)
+      {
+        const uint16_t* p0 = reinterpret_cast<const uint16_t*>(tp);
+        int32_t w0 = weightList[j];
+
+        ca += (int32_t)p0[PIXEL_ARGB64_WORD_A] * w0;
+        cr += (int32_t)p0[PIXEL_ARGB64_WORD_R] * w0;
+        cg += (int32_t)p0[PIXEL_ARGB64_WORD_G] * w0;
+        cb += (int32_t)p0[PIXEL_ARGB64_WORD_B] * w0;
+
+        tp += tStride;
+      }
+
+      ca = Math::bound<int32_t>(ca >> 8, 0, 0xFFFF);
+      cr = Math::bound<int32_t>(cr >> 8, 0, ca);
+      cg = Math::bound<int32_t>(cg >> 8, 0, ca);
+      cb = Math::bound<int32_t>(cb >> 8, 0, ca);
+
+      reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_A] = (uint16_t)(uint32_t)ca;
+      reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_R] = (uint16_t)(uint32_t)cr;
+      reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_G] = (uint16_t)(uint32_t)cg;
+      reinterpret_cast<uint16_t*>(dp)[PIXEL_ARGB64_WORD_B] = (uint16_t)(uint32_t)cb;
+    }
+
+    recordList += 1;
+    weightList += kernelSize;
+
+    dData += dStride;
+  }
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_Words_SSE2(ImageResizeContext* ctx, uint wScale)
+{
+  uint kernelSize = ctx->kernelSize[1];
+
+  uint dw = ctx->dSize[0] * wScale;
+  uint dh = ctx->dSize[1];
+
+  uint8_t* dData = ctx->dData;
+
+  ssize_t dStride = ctx->dStride;
+  ssize_t tStride = ctx->tStride;
+
+  const ImageResizeRecord* recordList = ctx->recordList;
+  const int32_t* weightList = ctx->weightList;
+
+  __m128i xmmHalf = FOG_XMM_GET_CONST_PI(ImageResizeHalf32);
+  __m128i xmmNone = FOG_XMM_GET_CONST_PI(ImageResizeNone32);
+  __m128i xmmBias = FOG_XMM_GET_CONST_PI(ImageResizeBias16);
+
+  for (uint y = 0; y < dh; y++)
+  {
+    uint8_t* tData = ctx->tData + (ssize_t)recordList->pos * tStride;
+    uint8_t* dp = dData;
+    uint count = recordList->count;
+
+    __m128i xmmInit = (count != 0) ? xmmHalf : xmmNone;
+    uint x = dw;
+
+    while (x >= 8)
+    {
+      __m128i xmmAcc0;
+
+      ImageResizeContext_doVertical8W_SSE2(xmmAcc0, tData, tStride, weightList, count, xmmInit, xmmBias);
+
+      Acc::m128iXor(xmmAcc0, xmmAcc0, xmmBias);
+      Acc::m128iStore16u(dp, xmmAcc0);
+
+      dp += 16;
+      tData += 16;
+
+      x -= 8;
+    }
+
+    while (x != 0)
+    {
+      const uint8_t* tp = tData;
+      int32_t c0 = 0x80;
+
+      for (uint j = 0; j < count; j++)
+      {
+        c0 += (int32_t)reinterpret_cast<const uint16_t*>(tp)[0] * weightList[j];
+        tp += tStride;
+      }
+
+      reinterpret_cast<uint16_t*>(dp)[0] = (uint16_t)(uint32_t)Math::bound<int32_t>(c0 >> 8, 0, 0xFFFF);
+
+      dp += 2;
+      tData += 2;
+
+      x--;
+    }
+
+    recordList += 1;
+    weightList += kernelSize;
+
+    dData += dStride;
+  }
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_RGB48_SSE2(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Words_SSE2(ctx, 3);
+}
+
+static void FOG_CDECL ImageResizeContext_doVertical_A16_SSE2(ImageResizeContext* ctx)
+{
+  ImageResizeContext_doVertical_Words_SSE2(ctx, 1);
+}
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
@@ -1711,11 +2557,19 @@ FOG_NO_EXPORT void ImageResize_init_SSE2(ImageResizeApi* api)
 {
   api->doHorizontal[IMAGE_FORMAT_PRGB32] = ImageResizeContext_doHorizontal_PRGB32_SSE2;
   api->doHorizontal[IMAGE_FORMAT_XRGB32] = ImageResizeContext_doHorizontal_XRGB32_SSE2;
+  api->doHorizontal[IMAGE_FORMAT_RGB24 ] = ImageResizeContext_doHorizontal_RGB24_SSE2;
+  api->doHorizontal[IMAGE_FORMAT_A8    ] = ImageResizeContext_doHorizontal_A8_SSE2;
+  api->doHorizontal[IMAGE_FORMAT_PRGB64] = ImageResizeContext_doHorizontal_PRGB64_SSE2;
+  api->doHorizontal[IMAGE_FORMAT_RGB48 ] = ImageResizeContext_doHorizontal_RGB48_SSE2;
+  api->doHorizontal[IMAGE_FORMAT_A16   ] = ImageResizeContext_doHorizontal_A16_SSE2;
 
   api->doVertical[IMAGE_FORMAT_PRGB32] = ImageResizeContext_doVertical_PRGB32_SSE2;
   api->doVertical[IMAGE_FORMAT_XRGB32] = ImageResizeContext_doVertical_XRGB32_SSE2;
   api->doVertical[IMAGE_FORMAT_RGB24 ] = ImageResizeContext_doVertical_RGB24_SSE2;
   api->doVertical[IMAGE_FORMAT_A8    ] = ImageResizeContext_doVertical_A8_SSE2;
+  api->doVertical[IMAGE_FORMAT_PRGB64] = ImageResizeContext_doVertical_PRGB64_SSE2;
+  api->doVertical[IMAGE_FORMAT_RGB48 ] = ImageResizeContext_doVertical_RGB48_SSE2;
+  api->doVertical[IMAGE_FORMAT_A16   ] = ImageResizeContext_doVertical_A16_SSE2;
 }
 
 } // Fog namespace
@@ -8,6 +8,8 @@
 #define _FOG_G2D_IMAGING_IMAGERESIZE_P_H
 
 // [Dependencies]
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Atomic.h>
 #include <Fog/G2d/Geometry/Size.h>
 #include <Fog/G2d/Imaging/Image.h>
 
@@ -22,6 +24,26 @@ namespace Fog {
 
 struct ImageResizeApi;
 struct ImageResizeContext;
+struct ImageResizeFunc;
+struct ImageResizeWeights;
+
+// ============================================================================
+// [Fog::IMAGE_RESIZE_LIMITS]
+// ============================================================================
+
+enum IMAGE_RESIZE_LIMITS
+{
+  //! @brief Maximum count of weights cached by the weights-cache.
+  IMAGE_RESIZE_CACHE_SIZE = 16,
+  //! @brief Maximum size of the weights (in bytes) which can be cached.
+  IMAGE_RESIZE_CACHE_MAX_WEIGHTS = 1024 * 1024,
+
+  //! @brief Maximum count of threads used to resize a single image.
+  IMAGE_RESIZE_MAX_THREADS = 16,
+  //! @brief Minimum count of pixels (multiplied by the kernel size) processed
+  //! by one thread.
+  IMAGE_RESIZE_MIN_THREAD_WORK = 256 * 1024
+};
 
 // ============================================================================
 // [Fog::ImageResizeApi]
@@ -33,10 +55,10 @@ struct FOG_NO_EXPORT ImageResizeApi
     uint8_t* dData, size_t dStride, int dw, int dh,
     uint8_t* sData, size_t sStride, int sw, int sh,
     uint32_t format,
-    const MathFunctionF* func, float radius);
+    const ImageResizeFunc* func);
   typedef void (FOG_CDECL* DestroyFunc)(ImageResizeContext* ctx);
 
-  typedef void (FOG_CDECL* DoWeightsFunc)(ImageResizeContext* ctx, uint dir);
+  typedef void (FOG_CDECL* DoWeightsFunc)(ImageResizeWeights* weights, const MathFunctionF* func);
   typedef void (FOG_CDECL* DoHorizontalFunc)(ImageResizeContext* ctx);
   typedef void (FOG_CDECL* DoVerticalFunc)(ImageResizeContext* ctx);
 
@@ -58,6 +80,147 @@ struct FOG_NO_EXPORT ImageResizeRecord
   uint32_t count;
 };
 
+// ============================================================================
+// [Fog::ImageResizeFunc]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Resize function and its parameters.
+struct FOG_NO_EXPORT ImageResizeFunc
+{
+  //! @brief Resize function id, see @ref IMAGE_RESIZE, or @c IMAGE_RESIZE_COUNT
+  //! if the function is custom (weights of custom function are not cached).
+  uint32_t id;
+  //! @brief Parameters of the resize function (B and C of Mitchell function).
+  float params[2];
+  //! @brief Radius of the resize function.
+  float radius;
+
+  //! @brief The resize function.
+  const MathFunctionF* func;
+};
+
+// ============================================================================
+// [Fog::ImageResizeWeights]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Weights used to resize in one direction (horizontal or vertical).
+//!
+//! The weights depend only on the source and destination size in the given
+//! direction and on the resize function, so they are shared by both directions
+//! and by all images resized using the same sizes and function (they are kept
+//! by the weights-cache).
+struct FOG_NO_EXPORT ImageResizeWeights
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE ImageResizeWeights* create(const ImageResizeFunc* func, int sSize, int dSize)
+  {
+    float scale = float(dSize) / float(sSize);
+    float factor = 1.0f;
+    float radius = func->radius;
+
+    if (scale < 1.0f)
+    {
+      factor = scale;
+      radius = radius / scale;
+    }
+
+    uint kernelSize = (uint)(1.0f + 2.0f * radius);
+    size_t memorySize = sizeof(ImageResizeWeights) +
+      (size_t)(uint)dSize * sizeof(ImageResizeRecord) +
+      (size_t)(uint)dSize * kernelSize * sizeof(int32_t);
+
+    ImageResizeWeights* weights = reinterpret_cast<ImageResizeWeights*>(MemMgr::alloc(memorySize));
+    if (FOG_IS_NULL(weights))
+      return NULL;
+
+    weights->reference.init(1);
+    weights->memorySize = memorySize;
+
+    weights->funcId = func->id;
+    weights->funcParams[0] = func->params[0];
+    weights->funcParams[1] = func->params[1];
+    weights->funcRadius = func->radius;
+
+    weights->sSize = sSize;
+    weights->dSize = dSize;
+
+    weights->scale = scale;
+    weights->factor = factor;
+    weights->radius = radius;
+
+    weights->kernelSize = kernelSize;
+    weights->isBound = false;
+
+    weights->recordList = reinterpret_cast<ImageResizeRecord*>(weights + 1);
+    weights->weightList = reinterpret_cast<int32_t*>(weights->recordList + dSize);
+    return weights;
+  }
+
+  FOG_INLINE ImageResizeWeights* addRef()
+  {
+    reference.inc();
+    return this;
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      MemMgr::free(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Equality]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool eq(const ImageResizeFunc* func, int sSize, int dSize) const
+  {
+    return this->sSize == sSize &&
+           this->dSize == dSize &&
+           this->funcId == func->id &&
+           this->funcParams[0] == func->params[0] &&
+           this->funcParams[1] == func->params[1] &&
+           this->funcRadius == func->radius;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count.
+  Atomic<size_t> reference;
+  //! @brief Size of the weights, including this header.
+  size_t memorySize;
+
+  //! @brief Resize function id (key).
+  uint32_t funcId;
+  //! @brief Resize function parameters (key).
+  float funcParams[2];
+  //! @brief Resize function radius (key).
+  float funcRadius;
+
+  //! @brief Source size (key).
+  int sSize;
+  //! @brief Destination size (key).
+  int dSize;
+
+  float scale;
+  float factor;
+  float radius;
+
+  uint kernelSize;
+  uint isBound;
+
+  ImageResizeRecord* recordList;
+  int32_t* weightList;
+};
+
 // ============================================================================
 // [Fog::ImageResizeContext]
 // ============================================================================
@@ -66,6 +229,8 @@ struct FOG_NO_EXPORT ImageResizeContext
 {
   uint8_t* dData;
   uint8_t* sData;
+  //! @brief Temporary image (horizontally resized source), allocated by the
+  //! caller of @c ImageResizeApi::init().
   uint8_t* tData;
 
   ssize_t dStride;
@@ -75,17 +240,16 @@ struct FOG_NO_EXPORT ImageResizeContext
   int dSize[2];
   int sSize[2];
 
-  float scale[2];
-  float factor[2];
-  float radius[2];
-
   uint kernelSize[2];
   uint isBound[2];
 
+  //! @brief Weights of the current pass.
   int32_t* weightList;
+  //! @brief Records of the current pass.
   ImageResizeRecord* recordList;
 
-  const MathFunctionF* func;
+  //! @brief Horizontal and vertical weights.
+  ImageResizeWeights* weights[2];
 };
 
 //! @}
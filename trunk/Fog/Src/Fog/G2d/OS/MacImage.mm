@@ -114,7 +114,8 @@ static err_t FOG_CDECL Image_MacCG_create(ImageData** pd, const SizeI* size, uin
   d->adopted = 0;
   d->colorKey = IMAGE_COLOR_KEY_NONE;
   d->bytesPerPixel = desc.getBytesPerPixel();
-  FOG_PADDING_ZERO_64(d->padding);
+  d->alphaDistribution = ALPHA_DISTRIBUTION_UNKNOWN;
+  d->mipmap = NULL;
 
   d->data = (uint8_t*)( ((size_t)d + sizeof(ImageData) + 15) & ~(size_t)15 );
   d->first = d->data;
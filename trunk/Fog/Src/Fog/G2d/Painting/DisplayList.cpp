@@ -0,0 +1,539 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/DisplayList.h>
+#include <Fog/G2d/Painting/DisplayListCmd_p.h>
+#include <Fog/G2d/Painting/Painter.h>
+
+namespace Fog {
+
+FOG_NO_EXPORT void DisplayListOptimizer_init(void);
+
+// ============================================================================
+// [Fog::DisplayList - Global]
+// ============================================================================
+
+static Static<DisplayListData> DisplayList_dNull;
+
+// ============================================================================
+// [Fog::DisplayList - Command Info]
+// ============================================================================
+
+FOG_NO_EXPORT const DisplayListCmdInfo DisplayList_cmdInfo[DISPLAY_LIST_CMD_COUNT] =
+{
+  /* DISPLAY_LIST_CMD_VOID                 */ { 0, 0, 0, 0 },
+  /* DISPLAY_LIST_CMD_U32                  */ { 1, 0, 0, 0 },
+  /* DISPLAY_LIST_CMD_PTR                  */ { 0, 0, 1, 0 },
+  /* DISPLAY_LIST_CMD_PTR_COUNT            */ { 0, 1, 1, 0 },
+  /* DISPLAY_LIST_CMD_U32_PTR              */ { 1, 0, 1, 0 },
+  /* DISPLAY_LIST_CMD_U32_PTR_COUNT        */ { 1, 1, 1, 0 },
+  /* DISPLAY_LIST_CMD_U32_U32_PTR          */ { 2, 0, 1, 0 },
+  /* DISPLAY_LIST_CMD_PTR_PTR              */ { 0, 0, 2, 0 },
+  /* DISPLAY_LIST_CMD_PTR_U32_PTR          */ { 1, 0, 2, 0 },
+  /* DISPLAY_LIST_CMD_PTR_PTR_PTR          */ { 0, 0, 3, 0 },
+  /* DISPLAY_LIST_CMD_U32_PTR_PTR_PTR      */ { 1, 0, 3, 0 },
+  /* DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR      */ { 0, 0, 4, 0 },
+  /* DISPLAY_LIST_CMD_U32_PTR_PTR_PTR_PTR  */ { 1, 0, 4, 0 },
+  /* DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR_PTR  */ { 0, 0, 5, 0 },
+  /* DISPLAY_LIST_CMD_PTR_PTR_COUNT        */ { 0, 1, 2, 0 },
+  /* DISPLAY_LIST_CMD_TRANSFORM            */ { 0, 0, 1, 0 }
+};
+
+// ============================================================================
+// [Fog::DisplayList - Resources]
+// ============================================================================
+
+FOG_NO_EXPORT void DisplayList_destroyResources(DisplayListResource* resources, size_t count)
+{
+  for (size_t i = 0; i < count; i++)
+  {
+    DisplayListResource& res = resources[i];
+
+    switch (res.type)
+    {
+      case DISPLAY_LIST_RESOURCE_IMAGE          : res.image.destroy()       ; break;
+      case DISPLAY_LIST_RESOURCE_IMAGE_FILTER   : res.filter.destroy()      ; break;
+      case DISPLAY_LIST_RESOURCE_PATH_F         : res.pathF.destroy()       ; break;
+      case DISPLAY_LIST_RESOURCE_PATH_D         : res.pathD.destroy()       ; break;
+      case DISPLAY_LIST_RESOURCE_PATTERN        : res.pattern.destroy()     ; break;
+      case DISPLAY_LIST_RESOURCE_FONT           : res.font.destroy()        ; break;
+      case DISPLAY_LIST_RESOURCE_STRING_W       : res.string.destroy()      ; break;
+      case DISPLAY_LIST_RESOURCE_GLYPH_RUN      : res.glyphRun.destroy()    ; break;
+      case DISPLAY_LIST_RESOURCE_REGION         : res.region.destroy()      ; break;
+      case DISPLAY_LIST_RESOURCE_STROKE_PARAMS_D: res.strokeParams.destroy(); break;
+      case DISPLAY_LIST_RESOURCE_DASH_LIST_D    : res.dashList.destroy()    ; break;
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::DisplayList - Construction / Destruction]
+// ============================================================================
+
+static void FOG_CDECL DisplayList_ctor(DisplayList* self)
+{
+  self->_d = DisplayList_dNull->addRef();
+}
+
+static void FOG_CDECL DisplayList_ctorCopy(DisplayList* self, const DisplayList* other)
+{
+  self->_d = other->_d->addRef();
+}
+
+static void FOG_CDECL DisplayList_dtor(DisplayList* self)
+{
+  DisplayListData* d = self->_d;
+
+  if (d != NULL)
+    d->release();
+}
+
+// ============================================================================
+// [Fog::DisplayList - Reset]
+// ============================================================================
+
+static void FOG_CDECL DisplayList_reset(DisplayList* self)
+{
+  atomicPtrXchg(&self->_d, DisplayList_dNull->addRef())->release();
+}
+
+// ============================================================================
+// [Fog::DisplayList - Copy]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayList_copy(DisplayList* self, const DisplayList* other)
+{
+  atomicPtrXchg(&self->_d, other->_d->addRef())->release();
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DisplayList - Replay]
+// ============================================================================
+
+// Arguments of a recorded command, decoded by DisplayList_replay().
+struct FOG_NO_EXPORT DisplayListReplayArgs
+{
+  const uint32_t* u;
+  const void* p[5];
+  size_t count;
+};
+
+typedef err_t (FOG_CDECL *DisplayListReplayFunc)(Painter* painter, const DisplayListReplayArgs& args);
+
+// Replay functions indexed by DisplayListCmd::func. Each one calls the
+// paint-engine function through its own typed member of PaintEngineVTable.
+static DisplayListReplayFunc DisplayList_replayFunc[sizeof(PaintEngineVTable) / sizeof(void*)];
+
+#define _ARG_U(_Index_) args.u[_Index_]
+#define _ARG_P(_Index_, _Type_) static_cast<const _Type_*>(args.p[_Index_])
+#define _ARG_COUNT args.count
+
+#define DISPLAY_LIST_REPLAY(_Name_, _Args_) \
+  static err_t FOG_CDECL DisplayList_replay_##_Name_(Painter* painter, const DisplayListReplayArgs& args) \
+  { \
+    FOG_UNUSED(args); \
+    return painter->_vtable->_Name_ _Args_; \
+  }
+
+// [Parameters]
+DISPLAY_LIST_REPLAY(setParameter       , (painter, _ARG_U(0), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(resetParameter     , (painter, _ARG_U(0)))
+
+// [Source]
+DISPLAY_LIST_REPLAY(setSourceNone      , (painter))
+DISPLAY_LIST_REPLAY(setSourceArgb32    , (painter, _ARG_U(0)))
+DISPLAY_LIST_REPLAY(setSourceArgb64    , (painter, _ARG_P(0, Argb64)))
+DISPLAY_LIST_REPLAY(setSourceColor     , (painter, _ARG_P(0, Color)))
+DISPLAY_LIST_REPLAY(setSourcePattern   , (painter, _ARG_P(0, Pattern)))
+
+// [State]
+DISPLAY_LIST_REPLAY(save               , (painter))
+DISPLAY_LIST_REPLAY(restore            , (painter))
+
+// [Stroke]
+DISPLAY_LIST_REPLAY(drawRectI          , (painter, _ARG_P(0, RectI)))
+DISPLAY_LIST_REPLAY(drawRectF          , (painter, _ARG_P(0, RectF)))
+DISPLAY_LIST_REPLAY(drawRectD          , (painter, _ARG_P(0, RectD)))
+DISPLAY_LIST_REPLAY(drawPolylineI      , (painter, _ARG_P(0, PointI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(drawPolygonI       , (painter, _ARG_P(0, PointI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(drawShapeF         , (painter, _ARG_U(0), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(drawShapeD         , (painter, _ARG_U(0), _ARG_P(0, void)))
+
+// [Fill]
+DISPLAY_LIST_REPLAY(fillAll            , (painter))
+DISPLAY_LIST_REPLAY(fillRectI          , (painter, _ARG_P(0, RectI)))
+DISPLAY_LIST_REPLAY(fillRectF          , (painter, _ARG_P(0, RectF)))
+DISPLAY_LIST_REPLAY(fillRectD          , (painter, _ARG_P(0, RectD)))
+DISPLAY_LIST_REPLAY(fillRectsI         , (painter, _ARG_P(0, RectI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(fillPolygonI       , (painter, _ARG_P(0, PointI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(fillShapeF         , (painter, _ARG_U(0), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(fillShapeD         , (painter, _ARG_U(0), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(fillGlyphRunI      , (painter, _ARG_P(0, PointI), _ARG_P(1, GlyphRun), _ARG_P(2, Font), _ARG_P(3, RectI)))
+DISPLAY_LIST_REPLAY(fillGlyphRunF      , (painter, _ARG_P(0, PointF), _ARG_P(1, GlyphRun), _ARG_P(2, Font), _ARG_P(3, RectF)))
+DISPLAY_LIST_REPLAY(fillGlyphRunD      , (painter, _ARG_P(0, PointD), _ARG_P(1, GlyphRun), _ARG_P(2, Font), _ARG_P(3, RectD)))
+DISPLAY_LIST_REPLAY(fillTextAtI        , (painter, _ARG_P(0, PointI), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectI)))
+DISPLAY_LIST_REPLAY(fillTextAtF        , (painter, _ARG_P(0, PointF), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectF)))
+DISPLAY_LIST_REPLAY(fillTextAtD        , (painter, _ARG_P(0, PointD), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectD)))
+DISPLAY_LIST_REPLAY(fillTextInI        , (painter, _ARG_P(0, TextRectI), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectI)))
+DISPLAY_LIST_REPLAY(fillTextInF        , (painter, _ARG_P(0, TextRectF), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectF)))
+DISPLAY_LIST_REPLAY(fillTextInD        , (painter, _ARG_P(0, TextRectD), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectD)))
+DISPLAY_LIST_REPLAY(fillMaskAtI        , (painter, _ARG_P(0, PointI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillMaskAtF        , (painter, _ARG_P(0, PointF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillMaskAtD        , (painter, _ARG_P(0, PointD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillMaskInI        , (painter, _ARG_P(0, RectI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillMaskInF        , (painter, _ARG_P(0, RectF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillMaskInD        , (painter, _ARG_P(0, RectD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(fillRegion         , (painter, _ARG_P(0, Region)))
+
+// [Blit]
+DISPLAY_LIST_REPLAY(blitImageAtI       , (painter, _ARG_P(0, PointI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitImageAtF       , (painter, _ARG_P(0, PointF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitImageAtD       , (painter, _ARG_P(0, PointD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitImageInI       , (painter, _ARG_P(0, RectI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitImageInF       , (painter, _ARG_P(0, RectF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitImageInD       , (painter, _ARG_P(0, RectD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageAtI , (painter, _ARG_P(0, PointI), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageAtF , (painter, _ARG_P(0, PointF), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageAtD , (painter, _ARG_P(0, PointD), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageInI , (painter, _ARG_P(0, RectI), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageInF , (painter, _ARG_P(0, RectF), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitMaskedImageInD , (painter, _ARG_P(0, RectD), _ARG_P(1, Image), _ARG_P(2, Image), _ARG_P(3, RectI), _ARG_P(4, RectI)))
+DISPLAY_LIST_REPLAY(blitImagesI        , (painter, _ARG_P(0, Image), _ARG_P(1, SpriteItemI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(blitImagesF        , (painter, _ARG_P(0, Image), _ARG_P(1, SpriteItemF), _ARG_COUNT))
+
+// [Filter]
+DISPLAY_LIST_REPLAY(filterAll          , (painter, _ARG_P(0, FeBase)))
+DISPLAY_LIST_REPLAY(filterRectI        , (painter, _ARG_P(0, FeBase), _ARG_P(1, RectI)))
+DISPLAY_LIST_REPLAY(filterRectF        , (painter, _ARG_P(0, FeBase), _ARG_P(1, RectF)))
+DISPLAY_LIST_REPLAY(filterRectD        , (painter, _ARG_P(0, FeBase), _ARG_P(1, RectD)))
+DISPLAY_LIST_REPLAY(filterShapeF       , (painter, _ARG_P(0, FeBase), _ARG_U(0), _ARG_P(1, void)))
+DISPLAY_LIST_REPLAY(filterShapeD       , (painter, _ARG_P(0, FeBase), _ARG_U(0), _ARG_P(1, void)))
+DISPLAY_LIST_REPLAY(filterStrokedShapeF, (painter, _ARG_P(0, FeBase), _ARG_U(0), _ARG_P(1, void)))
+DISPLAY_LIST_REPLAY(filterStrokedShapeD, (painter, _ARG_P(0, FeBase), _ARG_U(0), _ARG_P(1, void)))
+
+// [Clip]
+DISPLAY_LIST_REPLAY(clipRectI          , (painter, _ARG_U(0), _ARG_P(0, RectI)))
+DISPLAY_LIST_REPLAY(clipRectF          , (painter, _ARG_U(0), _ARG_P(0, RectF)))
+DISPLAY_LIST_REPLAY(clipRectD          , (painter, _ARG_U(0), _ARG_P(0, RectD)))
+DISPLAY_LIST_REPLAY(clipRectsI         , (painter, _ARG_U(0), _ARG_P(0, RectI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(clipPolygonI       , (painter, _ARG_U(0), _ARG_P(0, PointI), _ARG_COUNT))
+DISPLAY_LIST_REPLAY(clipShapeF         , (painter, _ARG_U(0), _ARG_U(1), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(clipShapeD         , (painter, _ARG_U(0), _ARG_U(1), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(clipStrokedShapeF  , (painter, _ARG_U(0), _ARG_U(1), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(clipStrokedShapeD  , (painter, _ARG_U(0), _ARG_U(1), _ARG_P(0, void)))
+DISPLAY_LIST_REPLAY(clipTextAtI        , (painter, _ARG_U(0), _ARG_P(0, PointI), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectI)))
+DISPLAY_LIST_REPLAY(clipTextAtF        , (painter, _ARG_U(0), _ARG_P(0, PointF), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectF)))
+DISPLAY_LIST_REPLAY(clipTextAtD        , (painter, _ARG_U(0), _ARG_P(0, PointD), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectD)))
+DISPLAY_LIST_REPLAY(clipTextInI        , (painter, _ARG_U(0), _ARG_P(0, TextRectI), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectI)))
+DISPLAY_LIST_REPLAY(clipTextInF        , (painter, _ARG_U(0), _ARG_P(0, TextRectF), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectF)))
+DISPLAY_LIST_REPLAY(clipTextInD        , (painter, _ARG_U(0), _ARG_P(0, TextRectD), _ARG_P(1, StringW), _ARG_P(2, Font), _ARG_P(3, RectD)))
+DISPLAY_LIST_REPLAY(clipMaskAtI        , (painter, _ARG_U(0), _ARG_P(0, PointI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipMaskAtF        , (painter, _ARG_U(0), _ARG_P(0, PointF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipMaskAtD        , (painter, _ARG_U(0), _ARG_P(0, PointD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipMaskInI        , (painter, _ARG_U(0), _ARG_P(0, RectI), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipMaskInF        , (painter, _ARG_U(0), _ARG_P(0, RectF), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipMaskInD        , (painter, _ARG_U(0), _ARG_P(0, RectD), _ARG_P(1, Image), _ARG_P(2, RectI)))
+DISPLAY_LIST_REPLAY(clipRegion         , (painter, _ARG_U(0), _ARG_P(0, Region)))
+DISPLAY_LIST_REPLAY(resetClip          , (painter))
+
+// [Group]
+DISPLAY_LIST_REPLAY(beginGroup         , (painter, _ARG_U(0)))
+DISPLAY_LIST_REPLAY(paintGroup         , (painter))
+
+#undef DISPLAY_LIST_REPLAY
+
+#undef _ARG_COUNT
+#undef _ARG_P
+#undef _ARG_U
+
+// Commands marked as occluded by DisplayList::optimize() can be skipped only
+// if the painter paints them in the same way the optimizer expected.
+static bool DisplayList_canSkipOccluded(Painter* painter, const TransformD& baseTransform)
+{
+  uint32_t transformType = baseTransform.getType();
+
+  if (transformType > TRANSFORM_TYPE_TRANSLATION)
+    return false;
+
+  if (transformType == TRANSFORM_TYPE_TRANSLATION &&
+      (baseTransform._20 != Math::floor(baseTransform._20) ||
+       baseTransform._21 != Math::floor(baseTransform._21)))
+    return false;
+
+  uint32_t compositingOperator;
+  float opacity;
+
+  if (painter->_vtable->getParameter(painter, PAINTER_PARAMETER_COMPOSITING_OPERATOR_I, &compositingOperator) != ERR_OK ||
+      (compositingOperator != COMPOSITE_SRC && compositingOperator != COMPOSITE_SRC_OVER))
+    return false;
+
+  if (painter->_vtable->getParameter(painter, PAINTER_PARAMETER_OPACITY_F, &opacity) != ERR_OK || opacity < 1.0f)
+    return false;
+
+  return true;
+}
+
+static err_t FOG_CDECL DisplayList_replay(const DisplayList* self, Painter* painter)
+{
+  DisplayListData* d = self->_d;
+
+  if (d->cmdCount == 0)
+    return ERR_OK;
+
+  // The recorded transformations are relative to the painter transformation.
+  TransformD baseTransform(UNINITIALIZED);
+  TransformD transform(UNINITIALIZED);
+
+  err_t err = painter->_vtable->getTransformD(painter, &baseTransform);
+  if (FOG_IS_ERROR(err))
+    return err;
+
+  bool baseIsIdentity = baseTransform.getType() == TRANSFORM_TYPE_IDENTITY;
+  bool skipOccluded = DisplayList_canSkipOccluded(painter, baseTransform);
+
+  // Don't let the recorded commands modify the painter state.
+  err = painter->_vtable->save(painter);
+  if (FOG_IS_ERROR(err))
+    return err;
+
+  const uint32_t saveFunc = DISPLAY_LIST_FUNC(save);
+  const uint32_t restoreFunc = DISPLAY_LIST_FUNC(restore);
+
+  const DisplayListResource* resources = d->resourceData;
+  const DisplayListCmd* cmd = reinterpret_cast<const DisplayListCmd*>(d->cmdData);
+  const DisplayListCmd* end = reinterpret_cast<const DisplayListCmd*>(d->cmdData + d->cmdLength);
+
+  size_t stateCount = 0;
+
+  for (; cmd != end; cmd = cmd->getNext())
+  {
+    if ((cmd->flags & DISPLAY_LIST_CMD_FLAG_OCCLUDED) != 0 && skipOccluded)
+      continue;
+
+    const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmd->type];
+    const uint32_t* u = cmd->getArgs();
+    const uint32_t* refs = u + info.u32Count + info.hasCount;
+
+    DisplayListReplayArgs args;
+    args.u = u;
+    args.count = info.hasCount ? u[info.u32Count] : 0;
+
+    for (uint32_t i = 0; i < info.ptrCount; i++)
+    {
+      uint32_t ref = refs[i];
+
+      if (ref == 0)
+        args.p[i] = NULL;
+      else if (ref & 1)
+        args.p[i] = resources[ref >> 1].getObject();
+      else
+        args.p[i] = reinterpret_cast<const uint8_t*>(cmd) + ref;
+    }
+
+    err_t cmdErr;
+
+    if (cmd->type == DISPLAY_LIST_CMD_TRANSFORM)
+    {
+      const TransformD* tr = static_cast<const TransformD*>(args.p[0]);
+
+      if (!baseIsIdentity)
+      {
+        TransformD::multiply(transform, *tr, baseTransform);
+        tr = &transform;
+      }
+
+      cmdErr = painter->_vtable->setTransformD(painter, tr);
+    }
+    else
+    {
+      if (cmd->func == restoreFunc)
+      {
+        // Never restore the state saved by the replay itself.
+        if (stateCount == 0)
+          continue;
+        stateCount--;
+      }
+
+      FOG_ASSERT(DisplayList_replayFunc[cmd->func] != NULL);
+      cmdErr = DisplayList_replayFunc[cmd->func](painter, args);
+
+      if (cmd->func == saveFunc && cmdErr == ERR_OK)
+        stateCount++;
+    }
+
+    // Continue replaying, but remember the first error.
+    if (FOG_IS_ERROR(cmdErr) && err == ERR_OK)
+      err = cmdErr;
+  }
+
+  while (stateCount)
+  {
+    painter->_vtable->restore(painter);
+    stateCount--;
+  }
+
+  painter->_vtable->restore(painter);
+  return err;
+}
+
+// ============================================================================
+// [Fog::DisplayList - DisplayListData]
+// ============================================================================
+
+static void FOG_CDECL DisplayList_dFree(DisplayListData* d)
+{
+  DisplayList_destroyResources(d->resourceData, d->resourceCount);
+
+  if (d->resourceData != NULL)
+    MemMgr::free(d->resourceData);
+
+  if (d->cmdData != NULL)
+    MemMgr::free(d->cmdData);
+
+  MemMgr::free(d);
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void DisplayList_init(void)
+{
+  // --------------------------------------------------------------------------
+  // [Funcs]
+  // --------------------------------------------------------------------------
+
+  fog_api.displaylist_ctor = DisplayList_ctor;
+  fog_api.displaylist_ctorCopy = DisplayList_ctorCopy;
+  fog_api.displaylist_dtor = DisplayList_dtor;
+  fog_api.displaylist_reset = DisplayList_reset;
+  fog_api.displaylist_copy = DisplayList_copy;
+  fog_api.displaylist_replay = DisplayList_replay;
+  fog_api.displaylist_dFree = DisplayList_dFree;
+
+  // --------------------------------------------------------------------------
+  // [Replay]
+  // --------------------------------------------------------------------------
+
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setParameter)]        = DisplayList_replay_setParameter;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(resetParameter)]      = DisplayList_replay_resetParameter;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setSourceNone)]       = DisplayList_replay_setSourceNone;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setSourceArgb32)]     = DisplayList_replay_setSourceArgb32;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setSourceArgb64)]     = DisplayList_replay_setSourceArgb64;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setSourceColor)]      = DisplayList_replay_setSourceColor;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(setSourcePattern)]    = DisplayList_replay_setSourcePattern;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(save)]                = DisplayList_replay_save;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(restore)]             = DisplayList_replay_restore;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawRectI)]           = DisplayList_replay_drawRectI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawRectF)]           = DisplayList_replay_drawRectF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawRectD)]           = DisplayList_replay_drawRectD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawPolylineI)]       = DisplayList_replay_drawPolylineI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawPolygonI)]        = DisplayList_replay_drawPolygonI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawShapeF)]          = DisplayList_replay_drawShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(drawShapeD)]          = DisplayList_replay_drawShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillAll)]             = DisplayList_replay_fillAll;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillRectI)]           = DisplayList_replay_fillRectI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillRectF)]           = DisplayList_replay_fillRectF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillRectD)]           = DisplayList_replay_fillRectD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillRectsI)]          = DisplayList_replay_fillRectsI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillPolygonI)]        = DisplayList_replay_fillPolygonI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillShapeF)]          = DisplayList_replay_fillShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillShapeD)]          = DisplayList_replay_fillShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillGlyphRunI)]       = DisplayList_replay_fillGlyphRunI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillGlyphRunF)]       = DisplayList_replay_fillGlyphRunF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillGlyphRunD)]       = DisplayList_replay_fillGlyphRunD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextAtI)]         = DisplayList_replay_fillTextAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextAtF)]         = DisplayList_replay_fillTextAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextAtD)]         = DisplayList_replay_fillTextAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextInI)]         = DisplayList_replay_fillTextInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextInF)]         = DisplayList_replay_fillTextInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillTextInD)]         = DisplayList_replay_fillTextInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskAtI)]         = DisplayList_replay_fillMaskAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskAtF)]         = DisplayList_replay_fillMaskAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskAtD)]         = DisplayList_replay_fillMaskAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskInI)]         = DisplayList_replay_fillMaskInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskInF)]         = DisplayList_replay_fillMaskInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillMaskInD)]         = DisplayList_replay_fillMaskInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(fillRegion)]          = DisplayList_replay_fillRegion;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageAtI)]        = DisplayList_replay_blitImageAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageAtF)]        = DisplayList_replay_blitImageAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageAtD)]        = DisplayList_replay_blitImageAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageInI)]        = DisplayList_replay_blitImageInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageInF)]        = DisplayList_replay_blitImageInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImageInD)]        = DisplayList_replay_blitImageInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageAtI)]  = DisplayList_replay_blitMaskedImageAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageAtF)]  = DisplayList_replay_blitMaskedImageAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageAtD)]  = DisplayList_replay_blitMaskedImageAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageInI)]  = DisplayList_replay_blitMaskedImageInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageInF)]  = DisplayList_replay_blitMaskedImageInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitMaskedImageInD)]  = DisplayList_replay_blitMaskedImageInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImagesI)]         = DisplayList_replay_blitImagesI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(blitImagesF)]         = DisplayList_replay_blitImagesF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterAll)]           = DisplayList_replay_filterAll;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterRectI)]         = DisplayList_replay_filterRectI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterRectF)]         = DisplayList_replay_filterRectF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterRectD)]         = DisplayList_replay_filterRectD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterShapeF)]        = DisplayList_replay_filterShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterShapeD)]        = DisplayList_replay_filterShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterStrokedShapeF)] = DisplayList_replay_filterStrokedShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(filterStrokedShapeD)] = DisplayList_replay_filterStrokedShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipRectI)]           = DisplayList_replay_clipRectI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipRectF)]           = DisplayList_replay_clipRectF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipRectD)]           = DisplayList_replay_clipRectD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipRectsI)]          = DisplayList_replay_clipRectsI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipPolygonI)]        = DisplayList_replay_clipPolygonI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipShapeF)]          = DisplayList_replay_clipShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipShapeD)]          = DisplayList_replay_clipShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipStrokedShapeF)]   = DisplayList_replay_clipStrokedShapeF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipStrokedShapeD)]   = DisplayList_replay_clipStrokedShapeD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextAtI)]         = DisplayList_replay_clipTextAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextAtF)]         = DisplayList_replay_clipTextAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextAtD)]         = DisplayList_replay_clipTextAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextInI)]         = DisplayList_replay_clipTextInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextInF)]         = DisplayList_replay_clipTextInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipTextInD)]         = DisplayList_replay_clipTextInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskAtI)]         = DisplayList_replay_clipMaskAtI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskAtF)]         = DisplayList_replay_clipMaskAtF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskAtD)]         = DisplayList_replay_clipMaskAtD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskInI)]         = DisplayList_replay_clipMaskInI;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskInF)]         = DisplayList_replay_clipMaskInF;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipMaskInD)]         = DisplayList_replay_clipMaskInD;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(clipRegion)]          = DisplayList_replay_clipRegion;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(resetClip)]           = DisplayList_replay_resetClip;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(beginGroup)]          = DisplayList_replay_beginGroup;
+  DisplayList_replayFunc[DISPLAY_LIST_FUNC(paintGroup)]          = DisplayList_replay_paintGroup;
+
+  DisplayListOptimizer_init();
+
+  // --------------------------------------------------------------------------
+  // [Data]
+  // --------------------------------------------------------------------------
+
+  DisplayListData* d = &DisplayList_dNull;
+
+  d->reference.init(1);
+  d->size.reset();
+  d->cmdCount = 0;
+  d->cmdLength = 0;
+  d->cmdData = NULL;
+  d->resourceCount = 0;
+  d->resourceData = NULL;
+}
+
+} // Fog namespace
@@ -0,0 +1,208 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_DISPLAYLIST_H
+#define _FOG_G2D_PAINTING_DISPLAYLIST_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/G2d/Geometry/Size.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Forward Declarations]
+// ============================================================================
+
+struct DisplayListResource;
+
+// ============================================================================
+// [Fog::DisplayListData]
+// ============================================================================
+
+//! @brief Display-list data.
+//!
+//! The data are created by the display-list paint-engine when the painter is
+//! finalized and never modified after that, so they can be shared between
+//! threads without any locking.
+struct FOG_NO_EXPORT DisplayListData
+{
+  // --------------------------------------------------------------------------
+  // [AddRef / Release]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE DisplayListData* addRef() const
+  {
+    reference.inc();
+    return const_cast<DisplayListData*>(this);
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      fog_api.displaylist_dFree(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count.
+  mutable Atomic<size_t> reference;
+
+  //! @brief Size passed to @ref Painter::begin().
+  SizeI size;
+
+  //! @brief Count of recorded commands.
+  size_t cmdCount;
+  //! @brief Length of the command stream (in bytes).
+  size_t cmdLength;
+  //! @brief Command stream.
+  uint8_t* cmdData;
+
+  //! @brief Count of resources (images, paths, fonts, ...) used by commands.
+  size_t resourceCount;
+  //! @brief Resources.
+  DisplayListResource* resourceData;
+};
+
+// ============================================================================
+// [Fog::DisplayList]
+// ============================================================================
+
+//! @brief Display-list (recorded sequence of painter commands).
+//!
+//! The display-list is created by painting into it using @ref Painter, see
+//! @ref Painter::begin(DisplayList&, const SizeI&, uint32_t). Everything the
+//! painter is asked to do (sources, transformations, clipping, paths, glyph
+//! runs, image blits and filters) is recorded into a compact command stream
+//! together with the resources the commands reference. The display-list is
+//! assigned when the painter is finalized and it's immutable after that.
+//!
+//! The display-list can be replayed onto any painter by @ref replay(). The
+//! recorded transformations are relative to the transformation the target
+//! painter has when @ref replay() is called, so the same display-list can be
+//! rendered at several sizes or resolutions. All the painter state changed by
+//! the recorded commands is restored when the replay is finished. Because the
+//! display-list is never modified it can be replayed concurrently from several
+//! threads onto different painters.
+struct FOG_NO_EXPORT DisplayList
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE DisplayList()
+  {
+    fog_api.displaylist_ctor(this);
+  }
+
+  FOG_INLINE DisplayList(const DisplayList& other)
+  {
+    fog_api.displaylist_ctorCopy(this, &other);
+  }
+
+#if defined(FOG_CC_HAS_RVALUE)
+  FOG_INLINE DisplayList(DisplayList&& other) : _d(other._d) { other._d = NULL; }
+#endif // FOG_CC_HAS_RVALUE
+
+  explicit FOG_INLINE DisplayList(DisplayListData* d) :
+    _d(d)
+  {
+  }
+
+  FOG_INLINE ~DisplayList()
+  {
+    fog_api.displaylist_dtor(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Sharing]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE size_t getReference() const { return _d->reference.get(); }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get whether the display-list contains no commands.
+  FOG_INLINE bool isEmpty() const { return _d->cmdCount == 0; }
+
+  //! @brief Get the size the display-list was recorded with.
+  FOG_INLINE const SizeI& getSize() const { return _d->size; }
+
+  //! @brief Get count of recorded commands.
+  FOG_INLINE size_t getCommandCount() const { return _d->cmdCount; }
+
+  //! @brief Get the memory used by the command stream (in bytes).
+  FOG_INLINE size_t getCommandLength() const { return _d->cmdLength; }
+
+  //! @brief Get count of resources referenced by the recorded commands.
+  FOG_INLINE size_t getResourceCount() const { return _d->resourceCount; }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    fog_api.displaylist_reset(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Optimize]
+  // --------------------------------------------------------------------------
+
+  //! @brief Optimize the recorded commands.
+  //!
+  //! Removes state changes which are never used (or which set the value the
+  //! state already has), merges adjacent non-overlapping @c fillRect(RectI)
+  //! calls into a single @c fillRects() call and marks commands completely
+  //! covered by an opaque fill painted later in the same clip region, so the
+  //! replay can skip them.
+  FOG_INLINE err_t optimize()
+  {
+    return fog_api.displaylist_optimize(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Replay]
+  // --------------------------------------------------------------------------
+
+  //! @brief Replay the display-list onto @a painter.
+  FOG_INLINE err_t replay(Painter& painter) const
+  {
+    return fog_api.displaylist_replay(this, &painter);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Operator Overload]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE DisplayList& operator=(const DisplayList& other)
+  {
+    fog_api.displaylist_copy(this, &other);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  _FOG_CLASS_D(DisplayListData)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_DISPLAYLIST_H
@@ -0,0 +1,256 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_DISPLAYLISTCMD_P_H
+#define _FOG_G2D_PAINTING_DISPLAYLISTCMD_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Tools/List.h>
+#include <Fog/Core/Tools/String.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Geometry/PathStroker.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/ImageFilter.h>
+#include <Fog/G2d/Painting/DisplayList.h>
+#include <Fog/G2d/Painting/PaintEngine.h>
+#include <Fog/G2d/Source/Pattern.h>
+#include <Fog/G2d/Text/Font.h>
+#include <Fog/G2d/Text/TextLayout.h>
+#include <Fog/G2d/Tools/Region.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::DISPLAY_LIST_CMD]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list command type.
+//!
+//! The command type describes the signature of the paint-engine function the
+//! command is replayed by. The 'U32' is 32-bit integer argument (clip-op,
+//! shape-type, parameter-id, ...), 'PTR' is pointer argument (the value is
+//! stored inline in the command or in the resource list) and 'COUNT' is the
+//! count of items the preceding pointer points to.
+enum DISPLAY_LIST_CMD
+{
+  //! @brief fn(self).
+  DISPLAY_LIST_CMD_VOID = 0,
+  //! @brief fn(self, u0).
+  DISPLAY_LIST_CMD_U32 = 1,
+  //! @brief fn(self, p0).
+  DISPLAY_LIST_CMD_PTR = 2,
+  //! @brief fn(self, p0, count).
+  DISPLAY_LIST_CMD_PTR_COUNT = 3,
+  //! @brief fn(self, u0, p0).
+  DISPLAY_LIST_CMD_U32_PTR = 4,
+  //! @brief fn(self, u0, p0, count).
+  DISPLAY_LIST_CMD_U32_PTR_COUNT = 5,
+  //! @brief fn(self, u0, u1, p0).
+  DISPLAY_LIST_CMD_U32_U32_PTR = 6,
+  //! @brief fn(self, p0, p1).
+  DISPLAY_LIST_CMD_PTR_PTR = 7,
+  //! @brief fn(self, p0, u0, p1).
+  DISPLAY_LIST_CMD_PTR_U32_PTR = 8,
+  //! @brief fn(self, p0, p1, p2).
+  DISPLAY_LIST_CMD_PTR_PTR_PTR = 9,
+  //! @brief fn(self, u0, p0, p1, p2).
+  DISPLAY_LIST_CMD_U32_PTR_PTR_PTR = 10,
+  //! @brief fn(self, p0, p1, p2, p3).
+  DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR = 11,
+  //! @brief fn(self, u0, p0, p1, p2, p3).
+  DISPLAY_LIST_CMD_U32_PTR_PTR_PTR_PTR = 12,
+  //! @brief fn(self, p0, p1, p2, p3, p4).
+  DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR_PTR = 13,
+  //! @brief fn(self, p0, p1, count).
+  DISPLAY_LIST_CMD_PTR_PTR_COUNT = 14,
+
+  //! @brief Set transform, p0 is @ref TransformD relative to the transform
+  //! of the painter the display-list is replayed onto.
+  DISPLAY_LIST_CMD_TRANSFORM = 15,
+
+  //! @brief Count of display-list command types.
+  DISPLAY_LIST_CMD_COUNT = 16
+};
+
+// ============================================================================
+// [Fog::DISPLAY_LIST_CMD_FLAG]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list command flags.
+enum DISPLAY_LIST_CMD_FLAG
+{
+  //! @brief The command is completely covered by an opaque fill painted later
+  //! (set by @ref DisplayList::optimize()).
+  //!
+  //! The command is skipped by replay if the painter has identity (or integer
+  //! translation) transform, @c COMPOSITE_SRC_OVER or @c COMPOSITE_SRC operator
+  //! and full opacity, otherwise it's replayed as usual.
+  DISPLAY_LIST_CMD_FLAG_OCCLUDED = 0x01
+};
+
+// ============================================================================
+// [Fog::DISPLAY_LIST_RESOURCE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list resource type.
+enum DISPLAY_LIST_RESOURCE
+{
+  DISPLAY_LIST_RESOURCE_IMAGE = 0,
+  DISPLAY_LIST_RESOURCE_IMAGE_FILTER = 1,
+  DISPLAY_LIST_RESOURCE_PATH_F = 2,
+  DISPLAY_LIST_RESOURCE_PATH_D = 3,
+  DISPLAY_LIST_RESOURCE_PATTERN = 4,
+  DISPLAY_LIST_RESOURCE_FONT = 5,
+  DISPLAY_LIST_RESOURCE_STRING_W = 6,
+  DISPLAY_LIST_RESOURCE_GLYPH_RUN = 7,
+  DISPLAY_LIST_RESOURCE_REGION = 8,
+  DISPLAY_LIST_RESOURCE_STROKE_PARAMS_D = 9,
+  DISPLAY_LIST_RESOURCE_DASH_LIST_D = 10,
+
+  DISPLAY_LIST_RESOURCE_COUNT = 11
+};
+
+// ============================================================================
+// [Fog::DisplayListCmdInfo]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Count of arguments of each @ref DISPLAY_LIST_CMD.
+struct FOG_NO_EXPORT DisplayListCmdInfo
+{
+  //! @brief Count of 32-bit integer arguments.
+  uint8_t u32Count;
+  //! @brief Whether the command contains a count of items.
+  uint8_t hasCount;
+  //! @brief Count of pointer arguments.
+  uint8_t ptrCount;
+  //! @brief Reserved.
+  uint8_t reserved;
+};
+
+extern FOG_NO_EXPORT const DisplayListCmdInfo DisplayList_cmdInfo[DISPLAY_LIST_CMD_COUNT];
+
+//! @internal
+//!
+//! @brief Index of the paint-engine function @a _Name_ in @ref PaintEngineVTable.
+#define DISPLAY_LIST_FUNC(_Name_) \
+  ((uint32_t)(FOG_OFFSET_OF(PaintEngineVTable, _Name_) / sizeof(void*)))
+
+// ============================================================================
+// [Fog::DisplayListCmd]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list command header.
+//!
+//! The header is followed by 32-bit words containing the integer arguments,
+//! the count of items (if the command has it) and references to the pointer
+//! arguments (in this order, see @ref DisplayListCmdInfo). The values stored
+//! inline follow the arguments, aligned to 8 bytes.
+//!
+//! The pointer argument reference is zero if the argument is @c NULL, odd
+//! number in case that the argument is a resource ((index << 1) | 1), or
+//! even number which is an offset of the value from the command start.
+struct FOG_NO_EXPORT DisplayListCmd
+{
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE uint32_t* getArgs() { return reinterpret_cast<uint32_t*>(this + 1); }
+  FOG_INLINE const uint32_t* getArgs() const { return reinterpret_cast<const uint32_t*>(this + 1); }
+
+  FOG_INLINE const DisplayListCmd* getNext() const
+  {
+    return reinterpret_cast<const DisplayListCmd*>(reinterpret_cast<const uint8_t*>(this) + size);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Index of the function in @ref PaintEngineVTable.
+  uint16_t func;
+  //! @brief Command type, see @ref DISPLAY_LIST_CMD.
+  uint8_t type;
+  //! @brief Command flags, see @ref DISPLAY_LIST_CMD_FLAG.
+  uint8_t flags;
+  //! @brief Size of the command, including header, arguments and inline data.
+  uint32_t size;
+};
+
+// ============================================================================
+// [Fog::DisplayListResource]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list resource (reference-counted object used by commands).
+//!
+//! All objects stored here are implicitly shared classes containing only the
+//! data pointer (or trivially relocatable members), so the array of resources
+//! can be reallocated when recording.
+struct FOG_NO_EXPORT DisplayListResource
+{
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the pointer passed to the paint-engine function.
+  FOG_INLINE const void* getObject() const
+  {
+    if (type == DISPLAY_LIST_RESOURCE_IMAGE_FILTER)
+      return filter->getFeData();
+    else
+      return reinterpret_cast<const void*>(&image);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Resource type, see @ref DISPLAY_LIST_RESOURCE.
+  size_t type;
+
+  union
+  {
+    Static<Image> image;
+    Static<ImageFilter> filter;
+    Static<PathF> pathF;
+    Static<PathD> pathD;
+    Static<Pattern> pattern;
+    Static<Font> font;
+    Static<StringW> string;
+    Static<GlyphRun> glyphRun;
+    Static<Region> region;
+    Static<PathStrokerParamsD> strokeParams;
+    Static< List<double> > dashList;
+  };
+};
+
+//! @internal
+//!
+//! @brief Destroy @a count resources at @a resources.
+FOG_NO_EXPORT void DisplayList_destroyResources(DisplayListResource* resources, size_t count);
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_DISPLAYLISTCMD_P_H
@@ -0,0 +1,1093 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Geometry/Rect.h>
+#include <Fog/G2d/Geometry/Shape.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/DisplayList.h>
+#include <Fog/G2d/Painting/DisplayListCmd_p.h>
+#include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/Painter.h>
+#include <Fog/G2d/Source/Argb.h>
+#include <Fog/G2d/Source/Color.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Constants]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Category of the recorded paint-engine function, used by optimizer.
+enum DISPLAY_LIST_OPT_FUNC
+{
+  //! @brief Function which must not be moved across (clip, filter, group).
+  DISPLAY_LIST_OPT_FUNC_BARRIER = 0,
+  //! @brief Paint function which bounding box is not computed (cannot be culled).
+  DISPLAY_LIST_OPT_FUNC_PAINT,
+
+  DISPLAY_LIST_OPT_FUNC_SAVE,
+  DISPLAY_LIST_OPT_FUNC_RESTORE,
+
+  DISPLAY_LIST_OPT_FUNC_SET_PARAMETER,
+  DISPLAY_LIST_OPT_FUNC_RESET_PARAMETER,
+
+  DISPLAY_LIST_OPT_FUNC_SOURCE_NONE,
+  DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB32,
+  DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB64,
+  DISPLAY_LIST_OPT_FUNC_SOURCE_COLOR,
+  DISPLAY_LIST_OPT_FUNC_SOURCE_PATTERN,
+
+  DISPLAY_LIST_OPT_FUNC_FILL_ALL,
+  DISPLAY_LIST_OPT_FUNC_FILL_RECT_I,
+  DISPLAY_LIST_OPT_FUNC_FILL_RECT_F,
+  DISPLAY_LIST_OPT_FUNC_FILL_RECT_D,
+  DISPLAY_LIST_OPT_FUNC_FILL_RECTS_I,
+  DISPLAY_LIST_OPT_FUNC_FILL_POLYGON_I,
+  DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_F,
+  DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_D,
+  DISPLAY_LIST_OPT_FUNC_FILL_REGION,
+
+  //! @brief Image or mask placed at point - fn(PointX*, Image*, RectI*).
+  DISPLAY_LIST_OPT_FUNC_IMAGE_AT_I,
+  DISPLAY_LIST_OPT_FUNC_IMAGE_AT_F,
+  DISPLAY_LIST_OPT_FUNC_IMAGE_AT_D,
+
+  //! @brief Image or mask placed in rect - fn(RectX*, Image*, RectI*).
+  DISPLAY_LIST_OPT_FUNC_IMAGE_IN_I,
+  DISPLAY_LIST_OPT_FUNC_IMAGE_IN_F,
+  DISPLAY_LIST_OPT_FUNC_IMAGE_IN_D
+};
+
+//! @internal
+//!
+//! @brief Optimizer entry flags.
+enum DISPLAY_LIST_OPT_FLAG
+{
+  //! @brief The command is removed.
+  DISPLAY_LIST_OPT_FLAG_REMOVED = 0x01,
+  //! @brief The command paints only within its bounding box (can be culled).
+  DISPLAY_LIST_OPT_FLAG_CULLABLE = 0x02,
+  //! @brief The command paints its inner box by an opaque color.
+  DISPLAY_LIST_OPT_FLAG_OCCLUDER = 0x04
+};
+
+//! @internal
+//!
+//! @brief Keys of state commands, used to coalesce them.
+enum DISPLAY_LIST_OPT_KEY
+{
+  // The parameters use PAINTER_PARAMETER, followed by:
+  DISPLAY_LIST_OPT_KEY_SOURCE = PAINTER_PARAMETER_COUNT,
+  DISPLAY_LIST_OPT_KEY_TRANSFORM,
+
+  DISPLAY_LIST_OPT_KEY_COUNT
+};
+
+//! @internal
+//!
+//! @brief Maximum number of occluders tracked at a time.
+enum { DISPLAY_LIST_OPT_MAX_OCCLUDERS = 32 };
+
+//! @internal
+//!
+//! @brief Maximum number of rectangles merged into a single fillRects() call.
+enum { DISPLAY_LIST_OPT_MAX_RECTS = 256 };
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Global]
+// ============================================================================
+
+static uint8_t DisplayListOptimizer_funcTable[sizeof(PaintEngineVTable) / sizeof(void*)];
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Keys]
+// ============================================================================
+
+// Parameters set by float and double variants share the same key.
+static FOG_INLINE uint32_t DisplayListOptimizer_getKey(uint32_t parameterId)
+{
+  switch (parameterId)
+  {
+    case PAINTER_PARAMETER_OPACITY_D      : return PAINTER_PARAMETER_OPACITY_F;
+    case PAINTER_PARAMETER_STROKE_PARAMS_D: return PAINTER_PARAMETER_STROKE_PARAMS_F;
+    case PAINTER_PARAMETER_LINE_WIDTH_D   : return PAINTER_PARAMETER_LINE_WIDTH_F;
+    case PAINTER_PARAMETER_MITER_LIMIT_D  : return PAINTER_PARAMETER_MITER_LIMIT_F;
+    case PAINTER_PARAMETER_DASH_OFFSET_D  : return PAINTER_PARAMETER_DASH_OFFSET_F;
+    case PAINTER_PARAMETER_DASH_LIST_D    : return PAINTER_PARAMETER_DASH_LIST_F;
+    case PAINTER_PARAMETER_FILTER_SCALE_D : return PAINTER_PARAMETER_FILTER_SCALE_F;
+
+    default:
+      return parameterId;
+  }
+}
+
+// Group is the key of the parameter which sets the whole group at once.
+static FOG_INLINE uint32_t DisplayListOptimizer_getGroup(uint32_t key)
+{
+  if (key == PAINTER_PARAMETER_FILL_RULE_I ||
+      (key >= PAINTER_PARAMETER_PAINT_HINTS && key <= PAINTER_PARAMETER_GEOMETRIC_PRECISION_I))
+    return PAINTER_PARAMETER_PAINT_HINTS;
+
+  if (key >= PAINTER_PARAMETER_STROKE_PARAMS_F && key <= PAINTER_PARAMETER_DASH_LIST_F)
+    return PAINTER_PARAMETER_STROKE_PARAMS_F;
+
+  return key;
+}
+
+// Get whether the state command of key @a later makes the state command of
+// key @a earlier dead (if there is no command using the state in between).
+static FOG_INLINE bool DisplayListOptimizer_supersedes(uint32_t later, uint32_t earlier)
+{
+  if (later == earlier)
+    return true;
+
+  if (later == DisplayListOptimizer_getGroup(earlier))
+    return true;
+
+  if (later == PAINTER_PARAMETER_LINE_CAPS_I)
+    return earlier == PAINTER_PARAMETER_START_CAP_I || earlier == PAINTER_PARAMETER_END_CAP_I;
+
+  return false;
+}
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Helpers]
+// ============================================================================
+
+static FOG_INLINE const void* DisplayListOptimizer_getPtr(
+  const DisplayListCmd* cmd, const DisplayListResource* resources, uint32_t ref)
+{
+  if (ref == 0)
+    return NULL;
+  else if (ref & 1)
+    return resources[ref >> 1].getObject();
+  else
+    return reinterpret_cast<const uint8_t*>(cmd) + ref;
+}
+
+static FOG_INLINE uint32_t* DisplayListOptimizer_getRefs(DisplayListCmd* cmd)
+{
+  const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmd->type];
+  return cmd->getArgs() + info.u32Count + info.hasCount;
+}
+
+static FOG_INLINE bool DisplayListOptimizer_isEqual(const DisplayListCmd* a, const DisplayListCmd* b)
+{
+  return a->size == b->size && MemOps::eq(a, b, a->size);
+}
+
+static void DisplayListOptimizer_copyResource(DisplayListResource& dst, const DisplayListResource& src)
+{
+  dst.type = src.type;
+
+  switch (src.type)
+  {
+    case DISPLAY_LIST_RESOURCE_IMAGE          : dst.image.init(src.image())              ; break;
+    case DISPLAY_LIST_RESOURCE_IMAGE_FILTER   : dst.filter.init(src.filter())            ; break;
+    case DISPLAY_LIST_RESOURCE_PATH_F         : dst.pathF.init(src.pathF())              ; break;
+    case DISPLAY_LIST_RESOURCE_PATH_D         : dst.pathD.init(src.pathD())              ; break;
+    case DISPLAY_LIST_RESOURCE_PATTERN        : dst.pattern.init(src.pattern())          ; break;
+    case DISPLAY_LIST_RESOURCE_FONT           : dst.font.init(src.font())                ; break;
+    case DISPLAY_LIST_RESOURCE_STRING_W       : dst.string.init(src.string())            ; break;
+    case DISPLAY_LIST_RESOURCE_GLYPH_RUN      : dst.glyphRun.init(src.glyphRun())        ; break;
+    case DISPLAY_LIST_RESOURCE_REGION         : dst.region.init(src.region())            ; break;
+    case DISPLAY_LIST_RESOURCE_STROKE_PARAMS_D: dst.strokeParams.init(src.strokeParams()); break;
+    case DISPLAY_LIST_RESOURCE_DASH_LIST_D    : dst.dashList.init(src.dashList())        ; break;
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+}
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - State]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief State tracked by the optimizer, needed to compute the bounding boxes
+//! of commands and whether the command paints an opaque color.
+//!
+//! The initial state is the painter state at the time the display-list is
+//! replayed, which is unknown here. The optimizer expects the identity
+//! transform, @c COMPOSITE_SRC_OVER and no opacity; the replay honors culled
+//! commands only if the painter matches these expectations.
+struct FOG_NO_EXPORT DisplayListOptState
+{
+  TransformD transform;
+  uint32_t compositingOperator;
+  bool isSourceOpaque;
+  bool isOpacityFull;
+};
+
+//! @internal
+//!
+//! @brief Optimizer entry, one per recorded command.
+struct FOG_NO_EXPORT DisplayListOptEntry
+{
+  //! @brief The source command.
+  const DisplayListCmd* cmd;
+  //! @brief Flags, see @ref DISPLAY_LIST_OPT_FLAG.
+  uint32_t flags;
+  //! @brief Output command flags, see @ref DISPLAY_LIST_CMD_FLAG.
+  uint32_t cmdFlags;
+  //! @brief State key, see @ref DISPLAY_LIST_OPT_KEY (state commands only).
+  uint32_t key;
+  //! @brief Device box of the command (including antialiased pixels).
+  BoxD box;
+  //! @brief Device box of pixels fully covered by the command (occluders only).
+  BoxD innerBox;
+};
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Analyze]
+// ============================================================================
+
+static bool DisplayListOptimizer_getBox(BoxD& box, uint32_t funcType,
+  const DisplayListCmd* cmd, const DisplayListResource* resources)
+{
+  const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmd->type];
+  const uint32_t* u = cmd->getArgs();
+  const uint32_t* refs = u + info.u32Count + info.hasCount;
+
+  size_t count = info.hasCount ? u[info.u32Count] : 0;
+  const void* p0 = info.ptrCount > 0 ? DisplayListOptimizer_getPtr(cmd, resources, refs[0]) : NULL;
+
+  switch (funcType)
+  {
+    case DISPLAY_LIST_OPT_FUNC_FILL_ALL:
+    {
+      double inf = Math::getPInfD();
+      box.setBox(-inf, -inf, inf, inf);
+      return true;
+    }
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_RECT_I:
+      box.setRect(*static_cast<const RectI*>(p0));
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_RECT_F:
+      box.setRect(*static_cast<const RectF*>(p0));
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_RECT_D:
+      box.setRect(*static_cast<const RectD*>(p0));
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_RECTS_I:
+    case DISPLAY_LIST_OPT_FUNC_FILL_POLYGON_I:
+    {
+      if (count == 0)
+        return false;
+
+      if (funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECTS_I)
+      {
+        const RectI* r = static_cast<const RectI*>(p0);
+        box.setRect(r[0]);
+
+        for (size_t i = 1; i < count; i++)
+        {
+          BoxD b(r[i]);
+          if (b.x0 < box.x0) box.x0 = b.x0;
+          if (b.y0 < box.y0) box.y0 = b.y0;
+          if (b.x1 > box.x1) box.x1 = b.x1;
+          if (b.y1 > box.y1) box.y1 = b.y1;
+        }
+      }
+      else
+      {
+        const PointI* pts = static_cast<const PointI*>(p0);
+        box.setBox(pts[0].x, pts[0].y, pts[0].x, pts[0].y);
+
+        for (size_t i = 1; i < count; i++)
+        {
+          if (pts[i].x < box.x0) box.x0 = pts[i].x;
+          if (pts[i].y < box.y0) box.y0 = pts[i].y;
+          if (pts[i].x > box.x1) box.x1 = pts[i].x;
+          if (pts[i].y > box.y1) box.y1 = pts[i].y;
+        }
+      }
+      return true;
+    }
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_F:
+    {
+      BoxF b(UNINITIALIZED);
+      if (fog_api.shapef_getBoundingBox(u[0], p0, &b, NULL) != ERR_OK)
+        return false;
+
+      box.setBox(b);
+      return true;
+    }
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_D:
+      return fog_api.shaped_getBoundingBox(u[0], p0, &box, NULL) == ERR_OK;
+
+    case DISPLAY_LIST_OPT_FUNC_FILL_REGION:
+      box.setBox(static_cast<const Region*>(p0)->getBoundingBox());
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_AT_I:
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_AT_F:
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_AT_D:
+    {
+      const Image* image = static_cast<const Image*>(DisplayListOptimizer_getPtr(cmd, resources, refs[1]));
+      const RectI* fragment = static_cast<const RectI*>(DisplayListOptimizer_getPtr(cmd, resources, refs[2]));
+
+      PointD pt(UNINITIALIZED);
+      if (funcType == DISPLAY_LIST_OPT_FUNC_IMAGE_AT_I)
+        pt.set(*static_cast<const PointI*>(p0));
+      else if (funcType == DISPLAY_LIST_OPT_FUNC_IMAGE_AT_F)
+        pt.set(*static_cast<const PointF*>(p0));
+      else
+        pt = *static_cast<const PointD*>(p0);
+
+      double w = fragment ? fragment->w : image->getWidth();
+      double h = fragment ? fragment->h : image->getHeight();
+
+      box.setBox(pt.x, pt.y, pt.x + w, pt.y + h);
+      return true;
+    }
+
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_IN_I:
+      box.setRect(*static_cast<const RectI*>(p0));
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_IN_F:
+      box.setRect(*static_cast<const RectF*>(p0));
+      return true;
+
+    case DISPLAY_LIST_OPT_FUNC_IMAGE_IN_D:
+      box.setRect(*static_cast<const RectD*>(p0));
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Emit]
+// ============================================================================
+
+struct FOG_NO_EXPORT DisplayListOptBuffer
+{
+  FOG_INLINE DisplayListOptBuffer() : data(NULL), length(0), capacity(0), count(0) {}
+  FOG_INLINE ~DisplayListOptBuffer() { if (data != NULL) MemMgr::free(data); }
+
+  uint8_t* alloc(size_t size)
+  {
+    if (capacity - length < size)
+    {
+      size_t newCapacity = Math::max<size_t>(capacity * 2, 4096);
+      while (newCapacity - length < size)
+        newCapacity *= 2;
+
+      uint8_t* newData = reinterpret_cast<uint8_t*>(MemMgr::realloc(data, newCapacity));
+      if (FOG_IS_NULL(newData))
+        return NULL;
+
+      data = newData;
+      capacity = newCapacity;
+    }
+
+    uint8_t* p = data + length;
+    length += size;
+    count++;
+    return p;
+  }
+
+  uint8_t* data;
+  size_t length;
+  size_t capacity;
+  size_t count;
+
+private:
+  FOG_NO_COPY(DisplayListOptBuffer)
+};
+
+static err_t DisplayListOptimizer_emitRects(DisplayListOptBuffer& buffer, uint32_t cmdFlags,
+  const RectI* rects, size_t count)
+{
+  size_t argsSize = (sizeof(DisplayListCmd) + 2 * sizeof(uint32_t) + 7) & ~(size_t)7;
+  size_t cmdSize = argsSize + ((count * sizeof(RectI) + 7) & ~(size_t)7);
+
+  DisplayListCmd* cmd = reinterpret_cast<DisplayListCmd*>(buffer.alloc(cmdSize));
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  cmd->func = (uint16_t)DISPLAY_LIST_FUNC(fillRectsI);
+  cmd->type = DISPLAY_LIST_CMD_PTR_COUNT;
+  cmd->flags = (uint8_t)cmdFlags;
+  cmd->size = (uint32_t)cmdSize;
+
+  uint32_t* args = cmd->getArgs();
+  args[0] = (uint32_t)count;
+  args[1] = (uint32_t)argsSize;
+
+  MemOps::copy(reinterpret_cast<uint8_t*>(cmd) + argsSize, rects, count * sizeof(RectI));
+  return ERR_OK;
+}
+
+static err_t DisplayListOptimizer_emitCmd(DisplayListOptBuffer& buffer, const DisplayListCmd* cmd, uint32_t cmdFlags)
+{
+  uint8_t* p = buffer.alloc(cmd->size);
+  if (FOG_IS_NULL(p))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  MemOps::copy(p, cmd, cmd->size);
+  reinterpret_cast<DisplayListCmd*>(p)->flags = (uint8_t)cmdFlags;
+  return ERR_OK;
+}
+
+static err_t DisplayListOptimizer_flushRects(DisplayListOptBuffer& buffer, const DisplayListOptEntry* first,
+  uint32_t cmdFlags, const RectI* rects, size_t count, size_t cmdCount)
+{
+  // Single command is kept as is, fillRectI() is faster than fillRectsI().
+  if (cmdCount == 1)
+    return DisplayListOptimizer_emitCmd(buffer, first->cmd, cmdFlags);
+  else
+    return DisplayListOptimizer_emitRects(buffer, cmdFlags, rects, count);
+}
+
+// ============================================================================
+// [Fog::DisplayListOptimizer - Optimize]
+// ============================================================================
+
+static err_t DisplayListOptimizer_run(DisplayListData* d, DisplayListOptEntry* entries, DisplayListData** dst)
+{
+  const DisplayListResource* resources = d->resourceData;
+  const DisplayListCmd* cmd = reinterpret_cast<const DisplayListCmd*>(d->cmdData);
+
+  size_t cmdCount = d->cmdCount;
+  size_t i, j;
+
+  bool changed = false;
+
+  // --------------------------------------------------------------------------
+  // [Forward Pass - Coalesce State / Find Cullable Commands and Occluders]
+  // --------------------------------------------------------------------------
+
+  {
+    // Last kept state command of each key, used to remove commands which set
+    // the state to the value it already has.
+    DisplayListOptEntry* lastState[DISPLAY_LIST_OPT_KEY_COUNT];
+    // Indexes of state commands which are not used by any command yet.
+    size_t pendingStart = 0;
+
+    DisplayListOptState state;
+    DisplayListOptState* stack = NULL;
+    size_t stackLength = 0;
+    size_t stackCapacity = 0;
+
+    state.transform.reset();
+    state.compositingOperator = COMPOSITE_SRC_OVER;
+    state.isSourceOpaque = false;
+    state.isOpacityFull = true;
+
+    MemOps::zero(lastState, sizeof(lastState));
+
+    for (i = 0; i < cmdCount; i++, cmd = cmd->getNext())
+    {
+      DisplayListOptEntry& entry = entries[i];
+      const uint32_t* u = cmd->getArgs();
+
+      entry.cmd = cmd;
+      entry.flags = 0;
+      entry.cmdFlags = cmd->flags;
+      entry.key = DISPLAY_LIST_OPT_KEY_COUNT;
+
+      uint32_t funcType = DisplayListOptimizer_funcTable[cmd->func];
+      uint32_t key = DISPLAY_LIST_OPT_KEY_COUNT;
+
+      if (cmd->type == DISPLAY_LIST_CMD_TRANSFORM)
+      {
+        const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmd->type];
+        state.transform = *static_cast<const TransformD*>(
+          DisplayListOptimizer_getPtr(cmd, resources, u[info.u32Count + info.hasCount]));
+        key = DISPLAY_LIST_OPT_KEY_TRANSFORM;
+      }
+      else switch (funcType)
+      {
+        case DISPLAY_LIST_OPT_FUNC_SET_PARAMETER:
+        case DISPLAY_LIST_OPT_FUNC_RESET_PARAMETER:
+        {
+          uint32_t parameterId = u[0];
+          const void* value = NULL;
+
+          // Resetting all paint params is a barrier for coalescing.
+          if (parameterId == PAINTER_PARAMETER_PAINT_PARAMS_F ||
+              parameterId == PAINTER_PARAMETER_PAINT_PARAMS_D)
+          {
+            state.compositingOperator = COMPOSITE_SRC_OVER;
+            state.isOpacityFull = true;
+
+            MemOps::zero(lastState, sizeof(lastState));
+            pendingStart = i + 1;
+            continue;
+          }
+
+          if (funcType == DISPLAY_LIST_OPT_FUNC_SET_PARAMETER)
+            value = DisplayListOptimizer_getPtr(cmd, resources, u[1]);
+
+          switch (parameterId)
+          {
+            case PAINTER_PARAMETER_PAINT_HINTS:
+              state.compositingOperator = value
+                ? static_cast<const PaintHints*>(value)->compositingOperator
+                : COMPOSITE_SRC_OVER;
+              break;
+
+            case PAINTER_PARAMETER_COMPOSITING_OPERATOR_I:
+              state.compositingOperator = value
+                ? *static_cast<const uint32_t*>(value)
+                : COMPOSITE_SRC_OVER;
+              break;
+
+            case PAINTER_PARAMETER_OPACITY_F:
+              state.isOpacityFull = value ? *static_cast<const float*>(value) >= 1.0f : true;
+              break;
+
+            case PAINTER_PARAMETER_OPACITY_D:
+              state.isOpacityFull = value ? *static_cast<const double*>(value) >= 1.0 : true;
+              break;
+          }
+
+          key = DisplayListOptimizer_getKey(parameterId);
+          break;
+        }
+
+        case DISPLAY_LIST_OPT_FUNC_SOURCE_NONE:
+          state.isSourceOpaque = false;
+          key = DISPLAY_LIST_OPT_KEY_SOURCE;
+          break;
+
+        case DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB32:
+          state.isSourceOpaque = Argb32::isOpaque(u[0]);
+          key = DISPLAY_LIST_OPT_KEY_SOURCE;
+          break;
+
+        case DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB64:
+          state.isSourceOpaque = static_cast<const Argb64*>(DisplayListOptimizer_getPtr(cmd, resources, u[0]))->isOpaque();
+          key = DISPLAY_LIST_OPT_KEY_SOURCE;
+          break;
+
+        case DISPLAY_LIST_OPT_FUNC_SOURCE_COLOR:
+          state.isSourceOpaque = static_cast<const Color*>(DisplayListOptimizer_getPtr(cmd, resources, u[0]))->isOpaque();
+          key = DISPLAY_LIST_OPT_KEY_SOURCE;
+          break;
+
+        case DISPLAY_LIST_OPT_FUNC_SOURCE_PATTERN:
+          state.isSourceOpaque = false;
+          key = DISPLAY_LIST_OPT_KEY_SOURCE;
+          break;
+
+        case DISPLAY_LIST_OPT_FUNC_SAVE:
+        {
+          if (stackLength == stackCapacity)
+          {
+            size_t newCapacity = Math::max<size_t>(stackCapacity * 2, 16);
+            DisplayListOptState* newStack = reinterpret_cast<DisplayListOptState*>(
+              MemMgr::realloc(stack, newCapacity * sizeof(DisplayListOptState)));
+
+            if (FOG_IS_NULL(newStack))
+            {
+              if (stack != NULL)
+                MemMgr::free(stack);
+              return ERR_RT_OUT_OF_MEMORY;
+            }
+
+            stack = newStack;
+            stackCapacity = newCapacity;
+          }
+
+          MemOps::copy(&stack[stackLength++], &state, sizeof(DisplayListOptState));
+          break;
+        }
+
+        case DISPLAY_LIST_OPT_FUNC_RESTORE:
+        {
+          if (stackLength != 0)
+            MemOps::copy(&state, &stack[--stackLength], sizeof(DisplayListOptState));
+
+          MemOps::zero(lastState, sizeof(lastState));
+          break;
+        }
+
+        case DISPLAY_LIST_OPT_FUNC_BARRIER:
+        case DISPLAY_LIST_OPT_FUNC_PAINT:
+          break;
+
+        default:
+        {
+          bool isBounded = state.compositingOperator == COMPOSITE_SRC ||
+                           state.compositingOperator == COMPOSITE_SRC_OVER;
+
+          if (isBounded && DisplayListOptimizer_getBox(entry.box, funcType, cmd, resources))
+          {
+            bool isOccluder = state.isSourceOpaque &&
+                              state.isOpacityFull &&
+                              state.transform.getType() <= TRANSFORM_TYPE_SWAP;
+
+            entry.flags |= DISPLAY_LIST_OPT_FLAG_CULLABLE;
+
+            if (funcType == DISPLAY_LIST_OPT_FUNC_FILL_ALL)
+            {
+              entry.innerBox = entry.box;
+              if (isOccluder)
+                entry.flags |= DISPLAY_LIST_OPT_FLAG_OCCLUDER;
+            }
+            else
+            {
+              BoxD b(UNINITIALIZED);
+              state.transform.mapBox(b, entry.box);
+
+              // Antialiasing and image filtering can touch one pixel around.
+              entry.box.setBox(b.x0 - 1.0, b.y0 - 1.0, b.x1 + 1.0, b.y1 + 1.0);
+
+              // Only pixels completely inside the rectangle are fully covered.
+              if (isOccluder && (funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECT_I ||
+                                 funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECT_F ||
+                                 funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECT_D))
+              {
+                entry.innerBox.setBox(Math::ceil(b.x0), Math::ceil(b.y0), Math::floor(b.x1), Math::floor(b.y1));
+                if (entry.innerBox.isValid())
+                  entry.flags |= DISPLAY_LIST_OPT_FLAG_OCCLUDER;
+              }
+            }
+          }
+          break;
+        }
+      }
+
+      if (key == DISPLAY_LIST_OPT_KEY_COUNT)
+      {
+        // Not a state command, pending state commands are used by it.
+        pendingStart = i + 1;
+
+        if (funcType == DISPLAY_LIST_OPT_FUNC_BARRIER)
+          MemOps::zero(lastState, sizeof(lastState));
+        continue;
+      }
+
+      // Remove state command which sets the value the state already has.
+      if (lastState[key] != NULL && DisplayListOptimizer_isEqual(lastState[key]->cmd, cmd))
+      {
+        entry.flags |= DISPLAY_LIST_OPT_FLAG_REMOVED;
+        changed = true;
+        continue;
+      }
+
+      // Remove pending state commands overwritten by this one.
+      for (j = pendingStart; j < i; j++)
+      {
+        DisplayListOptEntry& pending = entries[j];
+        if (pending.flags & DISPLAY_LIST_OPT_FLAG_REMOVED)
+          continue;
+
+        if (DisplayListOptimizer_supersedes(key, pending.key))
+        {
+          pending.flags |= DISPLAY_LIST_OPT_FLAG_REMOVED;
+          changed = true;
+        }
+      }
+
+      // Keys of the same group can't be compared anymore.
+      if (key < PAINTER_PARAMETER_COUNT)
+      {
+        uint32_t group = DisplayListOptimizer_getGroup(key);
+
+        for (j = 0; j < PAINTER_PARAMETER_COUNT; j++)
+        {
+          if (j != key && DisplayListOptimizer_getGroup((uint32_t)j) == group)
+            lastState[j] = NULL;
+        }
+      }
+
+      entry.key = key;
+      lastState[key] = &entry;
+    }
+
+    if (stack != NULL)
+      MemMgr::free(stack);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Backward Pass - Occlusion Culling]
+  // --------------------------------------------------------------------------
+
+  {
+    BoxD occluders[DISPLAY_LIST_OPT_MAX_OCCLUDERS];
+    size_t occluderCount = 0;
+
+    i = cmdCount;
+    while (i)
+    {
+      DisplayListOptEntry& entry = entries[--i];
+
+      if (entry.flags & DISPLAY_LIST_OPT_FLAG_REMOVED)
+        continue;
+
+      uint32_t funcType = entry.cmd->type == DISPLAY_LIST_CMD_TRANSFORM
+        ? (uint32_t)DISPLAY_LIST_OPT_FUNC_SET_PARAMETER
+        : (uint32_t)DisplayListOptimizer_funcTable[entry.cmd->func];
+
+      // Commands before clip, filter or group (or restore, which restores the
+      // clip) are not painted with the same clip region.
+      if (funcType == DISPLAY_LIST_OPT_FUNC_BARRIER || funcType == DISPLAY_LIST_OPT_FUNC_RESTORE)
+      {
+        occluderCount = 0;
+        continue;
+      }
+
+      if (entry.flags & DISPLAY_LIST_OPT_FLAG_CULLABLE)
+      {
+        for (j = 0; j < occluderCount; j++)
+        {
+          if (occluders[j].subsumes(entry.box))
+            break;
+        }
+
+        if (j < occluderCount)
+        {
+          entry.cmdFlags |= DISPLAY_LIST_CMD_FLAG_OCCLUDED;
+          changed = true;
+          continue;
+        }
+      }
+
+      if (entry.flags & DISPLAY_LIST_OPT_FLAG_OCCLUDER)
+      {
+        if (occluderCount < DISPLAY_LIST_OPT_MAX_OCCLUDERS)
+        {
+          occluders[occluderCount++] = entry.innerBox;
+        }
+        else
+        {
+          // Replace the smallest occluder.
+          size_t smallest = 0;
+          for (j = 1; j < occluderCount; j++)
+          {
+            if (occluders[j].getWidth() * occluders[j].getHeight() <
+                occluders[smallest].getWidth() * occluders[smallest].getHeight())
+              smallest = j;
+          }
+
+          if (occluders[smallest].getWidth() * occluders[smallest].getHeight() <
+              entry.innerBox.getWidth() * entry.innerBox.getHeight())
+            occluders[smallest] = entry.innerBox;
+        }
+      }
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Emit - Merge Adjacent Rectangles]
+  // --------------------------------------------------------------------------
+
+  DisplayListOptBuffer buffer;
+  RectI rects[DISPLAY_LIST_OPT_MAX_RECTS];
+  size_t rectCount = 0;
+  size_t rectCmdCount = 0;
+  uint32_t rectFlags = 0;
+  DisplayListOptEntry* rectEntry = NULL;
+
+  for (i = 0; i < cmdCount; i++)
+  {
+    DisplayListOptEntry& entry = entries[i];
+    if (entry.flags & DISPLAY_LIST_OPT_FLAG_REMOVED)
+      continue;
+
+    cmd = entry.cmd;
+
+    uint32_t funcType = cmd->type == DISPLAY_LIST_CMD_TRANSFORM
+      ? (uint32_t)DISPLAY_LIST_OPT_FUNC_SET_PARAMETER
+      : (uint32_t)DisplayListOptimizer_funcTable[cmd->func];
+
+    if (funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECT_I ||
+        funcType == DISPLAY_LIST_OPT_FUNC_FILL_RECTS_I)
+    {
+      const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmd->type];
+      const uint32_t* u = cmd->getArgs();
+
+      const RectI* r = static_cast<const RectI*>(
+        DisplayListOptimizer_getPtr(cmd, resources, u[info.u32Count + info.hasCount]));
+      size_t count = info.hasCount ? u[0] : 1;
+
+      // Rectangles can be merged only if they don't overlap, otherwise the
+      // overlapping area would be painted only once.
+      bool canMerge = (rectCount == 0 || entry.cmdFlags == rectFlags) &&
+                      rectCount + count <= DISPLAY_LIST_OPT_MAX_RECTS;
+
+      for (j = 0; canMerge && j < count; j++)
+      {
+        if (!r[j].isValid())
+        {
+          canMerge = false;
+          break;
+        }
+
+        for (size_t k = 0; k < rectCount; k++)
+        {
+          if (rects[k].overlaps(r[j]))
+          {
+            canMerge = false;
+            break;
+          }
+        }
+      }
+
+      if (canMerge)
+      {
+        if (rectCount == 0)
+          rectEntry = &entry;
+
+        MemOps::copy(&rects[rectCount], r, count * sizeof(RectI));
+        rectCount += count;
+        rectCmdCount++;
+        rectFlags = entry.cmdFlags;
+        continue;
+      }
+    }
+
+    // Flush merged rectangles and process the current command again.
+    if (rectCount)
+    {
+      FOG_RETURN_ON_ERROR(DisplayListOptimizer_flushRects(buffer, rectEntry, rectFlags, rects, rectCount, rectCmdCount));
+      changed |= rectCmdCount > 1;
+
+      rectCount = 0;
+      rectCmdCount = 0;
+      i--;
+      continue;
+    }
+
+    FOG_RETURN_ON_ERROR(DisplayListOptimizer_emitCmd(buffer, cmd, entry.cmdFlags));
+  }
+
+  if (rectCount)
+  {
+    FOG_RETURN_ON_ERROR(DisplayListOptimizer_flushRects(buffer, rectEntry, rectFlags, rects, rectCount, rectCmdCount));
+    changed |= rectCmdCount > 1;
+  }
+
+  if (!changed)
+  {
+    *dst = NULL;
+    return ERR_OK;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Resources - Remove Unused]
+  // --------------------------------------------------------------------------
+
+  size_t resourceCount = d->resourceCount;
+  size_t usedCount = 0;
+
+  uint32_t* remap = NULL;
+  DisplayListResource* newResources = NULL;
+
+  if (resourceCount != 0)
+  {
+    remap = reinterpret_cast<uint32_t*>(MemMgr::alloc(resourceCount * sizeof(uint32_t)));
+    if (FOG_IS_NULL(remap))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    MemOps::set(remap, 0xFF, resourceCount * sizeof(uint32_t));
+
+    uint8_t* p = buffer.data;
+    uint8_t* end = buffer.data + buffer.length;
+
+    for (; p != end; p += reinterpret_cast<DisplayListCmd*>(p)->size)
+    {
+      DisplayListCmd* c = reinterpret_cast<DisplayListCmd*>(p);
+      uint32_t* refs = DisplayListOptimizer_getRefs(c);
+
+      for (i = 0; i < DisplayList_cmdInfo[c->type].ptrCount; i++)
+      {
+        uint32_t ref = refs[i];
+        if ((ref & 1) == 0)
+          continue;
+
+        uint32_t index = ref >> 1;
+        if (remap[index] == UINT32_MAX)
+          remap[index] = (uint32_t)usedCount++;
+
+        refs[i] = (remap[index] << 1) | 1;
+      }
+    }
+
+    if (usedCount != 0)
+    {
+      newResources = reinterpret_cast<DisplayListResource*>(
+        MemMgr::alloc(usedCount * sizeof(DisplayListResource)));
+
+      if (FOG_IS_NULL(newResources))
+      {
+        MemMgr::free(remap);
+        return ERR_RT_OUT_OF_MEMORY;
+      }
+
+      for (i = 0; i < resourceCount; i++)
+      {
+        if (remap[i] != UINT32_MAX)
+          DisplayListOptimizer_copyResource(newResources[remap[i]], resources[i]);
+      }
+    }
+
+    MemMgr::free(remap);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Finalize]
+  // --------------------------------------------------------------------------
+
+  DisplayListData* newd = reinterpret_cast<DisplayListData*>(MemMgr::alloc(sizeof(DisplayListData)));
+  if (FOG_IS_NULL(newd))
+  {
+    DisplayList_destroyResources(newResources, usedCount);
+    if (newResources != NULL)
+      MemMgr::free(newResources);
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  uint8_t* cmdData = buffer.data;
+  if (buffer.length != buffer.capacity)
+  {
+    cmdData = reinterpret_cast<uint8_t*>(MemMgr::realloc(buffer.data, buffer.length));
+    if (FOG_IS_NULL(cmdData))
+      cmdData = buffer.data;
+  }
+
+  newd->reference.init(1);
+  newd->size = d->size;
+  newd->cmdCount = buffer.count;
+  newd->cmdLength = buffer.length;
+  newd->cmdData = cmdData;
+  newd->resourceCount = usedCount;
+  newd->resourceData = newResources;
+
+  buffer.data = NULL;
+
+  *dst = newd;
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayList_optimize(DisplayList* self)
+{
+  DisplayListData* d = self->_d;
+
+  if (d->cmdCount == 0)
+    return ERR_OK;
+
+  DisplayListOptEntry* entries = reinterpret_cast<DisplayListOptEntry*>(
+    MemMgr::alloc(d->cmdCount * sizeof(DisplayListOptEntry)));
+
+  if (FOG_IS_NULL(entries))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  DisplayListData* newd;
+  err_t err = DisplayListOptimizer_run(d, entries, &newd);
+
+  MemMgr::free(entries);
+
+  if (err == ERR_OK && newd != NULL)
+    atomicPtrXchg(&self->_d, newd)->release();
+
+  return err;
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+static FOG_INLINE void DisplayListOptimizer_setFunc(uint32_t func, uint32_t funcType)
+{
+  DisplayListOptimizer_funcTable[func] = (uint8_t)funcType;
+}
+
+FOG_NO_EXPORT void DisplayListOptimizer_init(void)
+{
+  fog_api.displaylist_optimize = DisplayList_optimize;
+
+  // Everything not listed here is barrier (the default).
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setParameter)      , DISPLAY_LIST_OPT_FUNC_SET_PARAMETER);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(resetParameter)    , DISPLAY_LIST_OPT_FUNC_RESET_PARAMETER);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setSourceNone)     , DISPLAY_LIST_OPT_FUNC_SOURCE_NONE);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setSourceArgb32)   , DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB32);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setSourceArgb64)   , DISPLAY_LIST_OPT_FUNC_SOURCE_ARGB64);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setSourceColor)    , DISPLAY_LIST_OPT_FUNC_SOURCE_COLOR);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(setSourcePattern)  , DISPLAY_LIST_OPT_FUNC_SOURCE_PATTERN);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(save)              , DISPLAY_LIST_OPT_FUNC_SAVE);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(restore)           , DISPLAY_LIST_OPT_FUNC_RESTORE);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawRectI)         , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawRectF)         , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawRectD)         , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawPolylineI)     , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawPolygonI)      , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawShapeF)        , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(drawShapeD)        , DISPLAY_LIST_OPT_FUNC_PAINT);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillAll)           , DISPLAY_LIST_OPT_FUNC_FILL_ALL);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillRectI)         , DISPLAY_LIST_OPT_FUNC_FILL_RECT_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillRectF)         , DISPLAY_LIST_OPT_FUNC_FILL_RECT_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillRectD)         , DISPLAY_LIST_OPT_FUNC_FILL_RECT_D);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillRectsI)        , DISPLAY_LIST_OPT_FUNC_FILL_RECTS_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillPolygonI)      , DISPLAY_LIST_OPT_FUNC_FILL_POLYGON_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillShapeF)        , DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillShapeD)        , DISPLAY_LIST_OPT_FUNC_FILL_SHAPE_D);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillRegion)        , DISPLAY_LIST_OPT_FUNC_FILL_REGION);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillGlyphRunI)     , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillGlyphRunF)     , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillGlyphRunD)     , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextAtI)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextAtF)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextAtD)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextInI)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextInF)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillTextInD)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskAtI)       , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskAtF)       , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskAtD)       , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_D);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskInI)       , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskInF)       , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(fillMaskInD)       , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_D);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageAtI)      , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageAtF)      , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageAtD)      , DISPLAY_LIST_OPT_FUNC_IMAGE_AT_D);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageInI)      , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_I);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageInF)      , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_F);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImageInD)      , DISPLAY_LIST_OPT_FUNC_IMAGE_IN_D);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageAtI), DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageAtF), DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageAtD), DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageInI), DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageInF), DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitMaskedImageInD), DISPLAY_LIST_OPT_FUNC_PAINT);
+
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImagesI)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+  DisplayListOptimizer_setFunc(DISPLAY_LIST_FUNC(blitImagesF)       , DISPLAY_LIST_OPT_FUNC_PAINT);
+}
+
+} // Fog namespace
@@ -0,0 +1,2591 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Geometry/Arc.h>
+#include <Fog/G2d/Geometry/CBezier.h>
+#include <Fog/G2d/Geometry/Chord.h>
+#include <Fog/G2d/Geometry/Circle.h>
+#include <Fog/G2d/Geometry/Ellipse.h>
+#include <Fog/G2d/Geometry/Line.h>
+#include <Fog/G2d/Geometry/Pie.h>
+#include <Fog/G2d/Geometry/QBezier.h>
+#include <Fog/G2d/Geometry/Rect.h>
+#include <Fog/G2d/Geometry/Round.h>
+#include <Fog/G2d/Geometry/Triangle.h>
+#include <Fog/G2d/Painting/DisplayList.h>
+#include <Fog/G2d/Painting/DisplayListCmd_p.h>
+#include <Fog/G2d/Painting/DisplayListPaintEngine_p.h>
+#include <Fog/G2d/Painting/Painter.h>
+#include <Fog/G2d/Source/Gradient.h>
+#include <Fog/G2d/Source/Texture.h>
+#include <Fog/G2d/Text/TextRect.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Global]
+// ============================================================================
+
+static PaintEngineVTable DisplayListPaintEngine_vtable;
+
+// ${SHAPE_TYPE:BEGIN}
+static const uint8_t DisplayListPaintEngine_shapeSizeF[] =
+{
+  /* 00: SHAPE_TYPE_NONE            */ 0,
+  /* 01: SHAPE_TYPE_LINE            */ sizeof(LineF),
+  /* 02: SHAPE_TYPE_QBEZIER         */ sizeof(QBezierF),
+  /* 03: SHAPE_TYPE_CBEZIER         */ sizeof(CBezierF),
+  /* 04: SHAPE_TYPE_ARC             */ sizeof(ArcF),
+  /* 05: SHAPE_TYPE_RECT            */ sizeof(RectF),
+  /* 06: SHAPE_TYPE_ROUND           */ sizeof(RoundF),
+  /* 07: SHAPE_TYPE_CIRCLE          */ sizeof(CircleF),
+  /* 08: SHAPE_TYPE_ELLIPSE         */ sizeof(EllipseF),
+  /* 09: SHAPE_TYPE_CHORD           */ sizeof(ChordF),
+  /* 10: SHAPE_TYPE_PIE             */ sizeof(PieF),
+  /* 11: SHAPE_TYPE_TRIANGLE        */ sizeof(TriangleF)
+};
+
+static const uint8_t DisplayListPaintEngine_shapeSizeD[] =
+{
+  /* 00: SHAPE_TYPE_NONE            */ 0,
+  /* 01: SHAPE_TYPE_LINE            */ sizeof(LineD),
+  /* 02: SHAPE_TYPE_QBEZIER         */ sizeof(QBezierD),
+  /* 03: SHAPE_TYPE_CBEZIER         */ sizeof(CBezierD),
+  /* 04: SHAPE_TYPE_ARC             */ sizeof(ArcD),
+  /* 05: SHAPE_TYPE_RECT            */ sizeof(RectD),
+  /* 06: SHAPE_TYPE_ROUND           */ sizeof(RoundD),
+  /* 07: SHAPE_TYPE_CIRCLE          */ sizeof(CircleD),
+  /* 08: SHAPE_TYPE_ELLIPSE         */ sizeof(EllipseD),
+  /* 09: SHAPE_TYPE_CHORD           */ sizeof(ChordD),
+  /* 10: SHAPE_TYPE_PIE             */ sizeof(PieD),
+  /* 11: SHAPE_TYPE_TRIANGLE        */ sizeof(TriangleD)
+};
+// ${SHAPE_TYPE:END}
+
+// ============================================================================
+// [Fog::DisplayListPaintState - Construction / Destruction]
+// ============================================================================
+
+DisplayListPaintState::DisplayListPaintState() :
+  prev(NULL)
+{
+  reset();
+}
+
+DisplayListPaintState::DisplayListPaintState(const DisplayListPaintState& other) :
+  prev(NULL),
+  paintHints(other.paintHints),
+  opacity(other.opacity),
+  sourceType(other.sourceType),
+  sourceColor(other.sourceColor),
+  sourcePattern(other.sourcePattern),
+  strokeParams(other.strokeParams),
+  filterScale(other.filterScale),
+  transform(other.transform)
+{
+}
+
+DisplayListPaintState::~DisplayListPaintState()
+{
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintState - Reset]
+// ============================================================================
+
+void DisplayListPaintState::reset()
+{
+  paintHints.packed = 0;
+  paintHints.reset();
+  opacity = 1.0f;
+
+  sourceType = PATTERN_TYPE_COLOR;
+  sourceColor.reset();
+  sourceColor.setArgb32(Argb32(0xFF000000));
+  sourcePattern.reset();
+
+  strokeParams.reset();
+  filterScale.reset();
+  transform.reset();
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Construction / Destruction]
+// ============================================================================
+
+DisplayListPaintEngine::DisplayListPaintEngine() :
+  displayList(NULL),
+  state(NULL),
+  stateCount(0),
+  cmdData(NULL),
+  cmdLength(0),
+  cmdCapacity(0),
+  cmdCount(0),
+  resourceData(NULL),
+  resourceCount(0),
+  resourceCapacity(0)
+{
+  vtable = &DisplayListPaintEngine_vtable;
+
+  size.reset();
+  metaOrigin.reset();
+}
+
+DisplayListPaintEngine::~DisplayListPaintEngine()
+{
+  while (state != NULL)
+  {
+    DisplayListPaintState* prev = state->prev;
+    fog_delete(state);
+    state = prev;
+  }
+
+  DisplayList_destroyResources(resourceData, resourceCount);
+
+  if (resourceData != NULL)
+    MemMgr::free(resourceData);
+
+  if (cmdData != NULL)
+    MemMgr::free(cmdData);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Init / Finish]
+// ============================================================================
+
+err_t DisplayListPaintEngine::init(DisplayList* displayList_, const SizeI& size_, uint32_t initFlags)
+{
+  FOG_UNUSED(initFlags);
+
+  if (!size_.isValid())
+    return ERR_RT_INVALID_ARGUMENT;
+
+  state = fog_new DisplayListPaintState();
+  if (FOG_IS_NULL(state))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  displayList = displayList_;
+  size = size_;
+
+  metaRegion = BoxI(0, 0, size.w, size.h);
+  metaOrigin.reset();
+
+  return ERR_OK;
+}
+
+err_t DisplayListPaintEngine::finish()
+{
+  DisplayListData* d = reinterpret_cast<DisplayListData*>(MemMgr::alloc(sizeof(DisplayListData)));
+  if (FOG_IS_NULL(d))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  // Shrink the buffers, the display-list is never modified after this point.
+  if (cmdLength == 0)
+  {
+    if (cmdData != NULL)
+      MemMgr::free(cmdData);
+    cmdData = NULL;
+  }
+  else if (cmdLength != cmdCapacity)
+  {
+    uint8_t* newData = reinterpret_cast<uint8_t*>(MemMgr::realloc(cmdData, cmdLength));
+    if (FOG_IS_NULL(newData))
+      newData = cmdData;
+    cmdData = newData;
+  }
+
+  if (resourceCount == 0)
+  {
+    if (resourceData != NULL)
+      MemMgr::free(resourceData);
+    resourceData = NULL;
+  }
+  else if (resourceCount != resourceCapacity)
+  {
+    DisplayListResource* newData = reinterpret_cast<DisplayListResource*>(
+      MemMgr::realloc(resourceData, resourceCount * sizeof(DisplayListResource)));
+    if (FOG_IS_NULL(newData))
+      newData = resourceData;
+    resourceData = newData;
+  }
+
+  d->reference.init(1);
+  d->size = size;
+
+  d->cmdCount = cmdCount;
+  d->cmdLength = cmdLength;
+  d->cmdData = cmdData;
+
+  d->resourceCount = resourceCount;
+  d->resourceData = resourceData;
+
+  cmdData = NULL;
+  cmdLength = 0;
+  cmdCapacity = 0;
+  cmdCount = 0;
+
+  resourceData = NULL;
+  resourceCount = 0;
+  resourceCapacity = 0;
+
+  atomicPtrXchg(&displayList->_d, d)->release();
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Recording]
+// ============================================================================
+
+err_t DisplayListPaintEngine::addResource(uint32_t& ref, uint32_t resourceType, const void* object)
+{
+  if (resourceCount == resourceCapacity)
+  {
+    size_t newCapacity = Math::max<size_t>(resourceCapacity * 2, 16);
+    DisplayListResource* newData = reinterpret_cast<DisplayListResource*>(
+      MemMgr::realloc(resourceData, newCapacity * sizeof(DisplayListResource)));
+
+    if (FOG_IS_NULL(newData))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    resourceData = newData;
+    resourceCapacity = newCapacity;
+  }
+
+  DisplayListResource& res = resourceData[resourceCount];
+  res.type = resourceType;
+
+  switch (resourceType)
+  {
+    case DISPLAY_LIST_RESOURCE_IMAGE:
+      res.image.initCustom1(*static_cast<const Image*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_IMAGE_FILTER:
+      res.filter.initCustom1<const FeBase&>(*static_cast<const FeBase*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_PATH_F:
+    {
+      const PathF& path = *static_cast<const PathF*>(object);
+
+      // Update the lazily computed path information now, the path is shared
+      // by all threads the display-list is replayed from.
+      BoxF box(UNINITIALIZED);
+      path.hasBeziers();
+      path.getBoundingBox(box);
+
+      res.pathF.initCustom1(path);
+      break;
+    }
+
+    case DISPLAY_LIST_RESOURCE_PATH_D:
+    {
+      const PathD& path = *static_cast<const PathD*>(object);
+
+      BoxD box(UNINITIALIZED);
+      path.hasBeziers();
+      path.getBoundingBox(box);
+
+      res.pathD.initCustom1(path);
+      break;
+    }
+
+    case DISPLAY_LIST_RESOURCE_PATTERN:
+      res.pattern.initCustom1(*static_cast<const Pattern*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_FONT:
+      res.font.initCustom1(*static_cast<const Font*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_STRING_W:
+      res.string.initCustom1(*static_cast<const StringW*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_GLYPH_RUN:
+      res.glyphRun.initCustom1(*static_cast<const GlyphRun*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_REGION:
+      res.region.initCustom1(*static_cast<const Region*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_STROKE_PARAMS_D:
+      res.strokeParams.initCustom1(*static_cast<const PathStrokerParamsD*>(object));
+      break;
+
+    case DISPLAY_LIST_RESOURCE_DASH_LIST_D:
+      res.dashList.initCustom1(*static_cast<const List<double>*>(object));
+      break;
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  ref = (uint32_t)((resourceCount << 1) | 1);
+  resourceCount++;
+
+  return ERR_OK;
+}
+
+err_t DisplayListPaintEngine::addCmd(uint32_t func, uint32_t cmdType, const uint32_t* u32, size_t count, const DisplayListArg* args)
+{
+  const DisplayListCmdInfo& info = DisplayList_cmdInfo[cmdType];
+  size_t i;
+
+  if (FOG_UNLIKELY(count > UINT32_MAX))
+    return ERR_RT_OVERFLOW;
+
+  size_t argsSize = sizeof(DisplayListCmd) + (info.u32Count + info.hasCount + info.ptrCount) * sizeof(uint32_t);
+  argsSize = (argsSize + 7) & ~(size_t)7;
+
+  size_t cmdSize = argsSize;
+  for (i = 0; i < info.ptrCount; i++)
+    cmdSize += (args[i].size + 7) & ~(size_t)7;
+
+  if (FOG_UNLIKELY(cmdSize > UINT32_MAX))
+    return ERR_RT_OVERFLOW;
+
+  if (cmdCapacity - cmdLength < cmdSize)
+  {
+    size_t newCapacity = Math::max<size_t>(cmdCapacity * 2, 4096);
+    while (newCapacity - cmdLength < cmdSize)
+      newCapacity *= 2;
+
+    uint8_t* newData = reinterpret_cast<uint8_t*>(MemMgr::realloc(cmdData, newCapacity));
+    if (FOG_IS_NULL(newData))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    cmdData = newData;
+    cmdCapacity = newCapacity;
+  }
+
+  DisplayListCmd* cmd = reinterpret_cast<DisplayListCmd*>(cmdData + cmdLength);
+  cmd->func = (uint16_t)func;
+  cmd->type = (uint8_t)cmdType;
+  cmd->flags = 0;
+  cmd->size = (uint32_t)cmdSize;
+
+  uint32_t* p = cmd->getArgs();
+
+  for (i = 0; i < info.u32Count; i++)
+    *p++ = u32[i];
+
+  if (info.hasCount)
+    *p++ = (uint32_t)count;
+
+  size_t offset = argsSize;
+  for (i = 0; i < info.ptrCount; i++)
+  {
+    const DisplayListArg& arg = args[i];
+
+    if (arg.size != 0)
+    {
+      MemOps::copy(reinterpret_cast<uint8_t*>(cmd) + offset, arg.data, arg.size);
+      p[i] = (uint32_t)offset;
+      offset += (arg.size + 7) & ~(size_t)7;
+    }
+    else
+    {
+      p[i] = arg.ref;
+    }
+  }
+
+  cmdLength += cmdSize;
+  cmdCount++;
+
+  return ERR_OK;
+}
+
+err_t DisplayListPaintEngine::addTransform()
+{
+  // Update the transform type now, the recorded transform is shared by all
+  // threads the display-list is replayed from.
+  state->transform.getType();
+
+  DisplayListArg arg;
+  arg.setData(&state->transform, sizeof(TransformD));
+
+  return addCmd(DISPLAY_LIST_FUNC(setTransformD), DISPLAY_LIST_CMD_TRANSFORM, NULL, 0, &arg);
+}
+
+err_t DisplayListPaintEngine::addStrokeParams()
+{
+  uint32_t parameterId = PAINTER_PARAMETER_STROKE_PARAMS_D;
+  uint32_t ref;
+
+  FOG_RETURN_ON_ERROR(addResource(ref, DISPLAY_LIST_RESOURCE_STROKE_PARAMS_D, &state->strokeParams));
+
+  DisplayListArg arg;
+  arg.setRef(ref);
+
+  return addCmd(DISPLAY_LIST_FUNC(setParameter), DISPLAY_LIST_CMD_U32_PTR, &parameterId, 0, &arg);
+}
+
+err_t DisplayListPaintEngine::initShapeArgF(DisplayListArg& arg, uint32_t& shapeType, const void* shapeData)
+{
+  uint32_t ref;
+
+  switch (shapeType)
+  {
+    // Shapes which point to external data are converted into path.
+    case SHAPE_TYPE_POLYLINE:
+    case SHAPE_TYPE_POLYGON:
+    case SHAPE_TYPE_RECT_ARRAY:
+    {
+      PathF path;
+      FOG_RETURN_ON_ERROR(path._shape(shapeType, shapeData, PATH_DIRECTION_CW));
+      FOG_RETURN_ON_ERROR(addResource(ref, DISPLAY_LIST_RESOURCE_PATH_F, &path));
+
+      shapeType = SHAPE_TYPE_PATH;
+      arg.setRef(ref);
+      return ERR_OK;
+    }
+
+    case SHAPE_TYPE_PATH:
+    {
+      FOG_RETURN_ON_ERROR(addResource(ref, DISPLAY_LIST_RESOURCE_PATH_F, shapeData));
+
+      arg.setRef(ref);
+      return ERR_OK;
+    }
+
+    default:
+    {
+      if (shapeType == SHAPE_TYPE_NONE || shapeType >= SHAPE_TYPE_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      arg.setData(shapeData, DisplayListPaintEngine_shapeSizeF[shapeType]);
+      return ERR_OK;
+    }
+  }
+}
+
+err_t DisplayListPaintEngine::initShapeArgD(DisplayListArg& arg, uint32_t& shapeType, const void* shapeData)
+{
+  uint32_t ref;
+
+  switch (shapeType)
+  {
+    // Shapes which point to external data are converted into path.
+    case SHAPE_TYPE_POLYLINE:
+    case SHAPE_TYPE_POLYGON:
+    case SHAPE_TYPE_RECT_ARRAY:
+    {
+      PathD path;
+      FOG_RETURN_ON_ERROR(path._shape(shapeType, shapeData, PATH_DIRECTION_CW));
+      FOG_RETURN_ON_ERROR(addResource(ref, DISPLAY_LIST_RESOURCE_PATH_D, &path));
+
+      shapeType = SHAPE_TYPE_PATH;
+      arg.setRef(ref);
+      return ERR_OK;
+    }
+
+    case SHAPE_TYPE_PATH:
+    {
+      FOG_RETURN_ON_ERROR(addResource(ref, DISPLAY_LIST_RESOURCE_PATH_D, shapeData));
+
+      arg.setRef(ref);
+      return ERR_OK;
+    }
+
+    default:
+    {
+      if (shapeType == SHAPE_TYPE_NONE || shapeType >= SHAPE_TYPE_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      arg.setData(shapeData, DisplayListPaintEngine_shapeSizeD[shapeType]);
+      return ERR_OK;
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Helpers]
+// ============================================================================
+
+static err_t DisplayListPaintEngine_addVoid(Painter* self, uint32_t func)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  return engine->addCmd(func, DISPLAY_LIST_CMD_VOID, NULL, 0, NULL);
+}
+
+static err_t DisplayListPaintEngine_addParameter(Painter* self, uint32_t parameterId, const void* value, size_t size)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  arg.setData(value, size);
+
+  return engine->addCmd(DISPLAY_LIST_FUNC(setParameter), DISPLAY_LIST_CMD_U32_PTR, &parameterId, 0, &arg);
+}
+
+static err_t DisplayListPaintEngine_addPtr(Painter* self, uint32_t func, const void* p, size_t size)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  arg.setData(p, size);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR, NULL, 0, &arg);
+}
+
+static err_t DisplayListPaintEngine_addPtrCount(Painter* self, uint32_t func, const void* p, size_t count, size_t itemSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  arg.setData(p, count * itemSize);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_COUNT, NULL, count, &arg);
+}
+
+static err_t DisplayListPaintEngine_addResourcePtr(Painter* self, uint32_t func, uint32_t resourceType, const void* object)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  uint32_t ref;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(ref, resourceType, object));
+  arg.setRef(ref);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR, NULL, 0, &arg);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - AddRef / Release]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_release(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  err_t err = engine->finish();
+  fog_delete(engine);
+
+  self->_engine = fog_api.painter_getNullEngine();
+  self->_vtable = self->_engine->vtable;
+
+  return err;
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Meta Params]
+// ============================================================================
+
+// Meta params belong to the device the display-list is replayed onto, so they
+// are only stored, but never recorded.
+
+static err_t FOG_CDECL DisplayListPaintEngine_getMetaParams(const Painter* self, Region* region, PointI* origin)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  *region = engine->metaRegion;
+  *origin = engine->metaOrigin;
+
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setMetaParams(Painter* self, const Region* region, const PointI* origin)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  BoxI screen(0, 0, engine->size.w, engine->size.h);
+
+  engine->metaOrigin = *origin;
+
+  if (region->isInfinite())
+    engine->metaRegion = screen;
+  else if (screen.subsumes(region->getBoundingBox()))
+    engine->metaRegion = *region;
+  else
+    Region::intersect(engine->metaRegion, *region, screen);
+
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_resetMetaParams(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  BoxI screen(0, 0, engine->size.w, engine->size.h);
+
+  engine->metaOrigin.reset();
+  engine->metaRegion = screen;
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Parameters]
+// ============================================================================
+
+#define _PARAM_C(_Type_) (*reinterpret_cast<const _Type_*>(value))
+#define _PARAM_M(_Type_) (*reinterpret_cast<_Type_*>(value))
+
+static err_t FOG_CDECL DisplayListPaintEngine_getParameter(const Painter* self, uint32_t parameterId, void* value)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  switch (parameterId)
+  {
+    // ------------------------------------------------------------------------
+    // [Backend]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_SIZE_I:
+    {
+      _PARAM_M(SizeI) = engine->size;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_SIZE_F:
+    {
+      _PARAM_M(SizeF).set(engine->size);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_SIZE_D:
+    {
+      _PARAM_M(SizeD).set(engine->size);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_FORMAT_I:
+    {
+      _PARAM_M(uint32_t) = IMAGE_FORMAT_NULL;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_DEVICE_I:
+    {
+      _PARAM_M(uint32_t) = PAINT_DEVICE_DISPLAY_LIST;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Multithreading]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_MULTITHREADED_I:
+    {
+      _PARAM_M(uint32_t) = 0;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_MAX_THREADS_I:
+    {
+      _PARAM_M(uint32_t) = 1;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint Params]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_PAINT_PARAMS_F:
+    {
+      PaintParamsF& params = _PARAM_M(PaintParamsF);
+
+      params._hints = state->paintHints;
+      params._opacity = state->opacity;
+      params._strokeParams = state->strokeParams;
+
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_PAINT_PARAMS_D:
+    {
+      PaintParamsD& params = _PARAM_M(PaintParamsD);
+
+      params._hints = state->paintHints;
+      params._opacity = state->opacity;
+      params._strokeParams = state->strokeParams;
+
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint Hints]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_PAINT_HINTS:
+    {
+      _PARAM_M(PaintHints) = state->paintHints;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COMPOSITING_OPERATOR_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.compositingOperator;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_RENDER_QUALITY_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.renderQuality;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_IMAGE_QUALITY_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.imageQuality;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_GRADIENT_QUALITY_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.gradientQuality;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_OUTLINED_TEXT_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.outlinedText;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_FAST_LINE_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.fastLine;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_GEOMETRIC_PRECISION_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.geometricPrecision;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint - Opacity]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_OPACITY_F:
+    {
+      _PARAM_M(float) = state->opacity;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_OPACITY_D:
+    {
+      _PARAM_M(double) = state->opacity;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Fill Params - Fill Rule]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_FILL_RULE_I:
+    {
+      _PARAM_M(uint32_t) = state->paintHints.fillRule;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Stroke Params]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_PARAMS_F:
+    {
+      _PARAM_M(PathStrokerParamsF) = state->strokeParams;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_PARAMS_D:
+    {
+      _PARAM_M(PathStrokerParamsD) = state->strokeParams;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_LINE_WIDTH_F:
+    {
+      _PARAM_M(float) = (float)state->strokeParams.getLineWidth();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_LINE_WIDTH_D:
+    {
+      _PARAM_M(double) = state->strokeParams.getLineWidth();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_LINE_JOIN_I:
+    {
+      _PARAM_M(uint32_t) = state->strokeParams.getLineJoin();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_START_CAP_I:
+    {
+      _PARAM_M(uint32_t) = state->strokeParams.getStartCap();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_END_CAP_I:
+    {
+      _PARAM_M(uint32_t) = state->strokeParams.getEndCap();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_LINE_CAPS_I:
+    {
+      uint32_t startCap = state->strokeParams.getStartCap();
+      uint32_t endCap = state->strokeParams.getEndCap();
+
+      if (startCap != endCap)
+        return ERR_RT_INVALID_STATE;
+
+      _PARAM_M(uint32_t) = startCap;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_MITER_LIMIT_F:
+    {
+      _PARAM_M(float) = (float)state->strokeParams.getMiterLimit();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_MITER_LIMIT_D:
+    {
+      _PARAM_M(double) = state->strokeParams.getMiterLimit();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_DASH_OFFSET_F:
+    {
+      _PARAM_M(float) = (float)state->strokeParams.getDashOffset();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_DASH_OFFSET_D:
+    {
+      _PARAM_M(double) = state->strokeParams.getDashOffset();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_DASH_LIST_F:
+    {
+      return _PARAM_M(List<float>).setList(state->strokeParams.getDashList());
+    }
+
+    case PAINTER_PARAMETER_DASH_LIST_D:
+    {
+      return _PARAM_M(List<double>).setList(state->strokeParams.getDashList());
+    }
+
+    // ------------------------------------------------------------------------
+    // [Filter - Scale]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_FILTER_SCALE_F:
+    {
+      _PARAM_M(ImageFilterScaleF).setFilterScale(state->filterScale);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_FILTER_SCALE_D:
+    {
+      _PARAM_M(ImageFilterScaleD).setFilterScale(state->filterScale);
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Caching]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    {
+      _PARAM_M(uint32_t) = 0;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      _PARAM_M(PaintCacheStats).reset();
+      return ERR_OK;
+    }
+
+    default:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+  }
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setParameter(Painter* self, uint32_t parameterId, const void* value)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  switch (parameterId)
+  {
+    // ------------------------------------------------------------------------
+    // [Backend]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_SIZE_I:
+    case PAINTER_PARAMETER_SIZE_F:
+    case PAINTER_PARAMETER_SIZE_D:
+    case PAINTER_PARAMETER_FORMAT_I:
+    case PAINTER_PARAMETER_DEVICE_I:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Multithreading]
+    // ------------------------------------------------------------------------
+
+    // Multithreading is the matter of the painter the display-list is replayed
+    // onto, not recorded.
+    case PAINTER_PARAMETER_MULTITHREADED_I:
+    {
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_MAX_THREADS_I:
+    {
+      if (_PARAM_C(uint32_t) == 0)
+        return ERR_RT_INVALID_ARGUMENT;
+      return ERR_OK;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint Params]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_PAINT_PARAMS_F:
+    case PAINTER_PARAMETER_PAINT_PARAMS_D:
+    {
+      if (parameterId == PAINTER_PARAMETER_PAINT_PARAMS_F)
+      {
+        const PaintParamsF& v = _PARAM_C(PaintParamsF);
+
+        state->paintHints = v._hints;
+        state->opacity = v._opacity;
+        state->strokeParams = v._strokeParams;
+      }
+      else
+      {
+        const PaintParamsD& v = _PARAM_C(PaintParamsD);
+
+        state->paintHints = v._hints;
+        state->opacity = (float)v._opacity;
+        state->strokeParams = v._strokeParams;
+      }
+
+      FOG_RETURN_ON_ERROR(DisplayListPaintEngine_addParameter(self,
+        PAINTER_PARAMETER_PAINT_HINTS, &state->paintHints, sizeof(PaintHints)));
+      FOG_RETURN_ON_ERROR(DisplayListPaintEngine_addParameter(self,
+        PAINTER_PARAMETER_OPACITY_F, &state->opacity, sizeof(float)));
+
+      return engine->addStrokeParams();
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint Hints]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_PAINT_HINTS:
+    {
+      state->paintHints = _PARAM_C(PaintHints);
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(PaintHints));
+    }
+
+    case PAINTER_PARAMETER_COMPOSITING_OPERATOR_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= COMPOSITE_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.compositingOperator = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_RENDER_QUALITY_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= RENDER_QUALITY_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.renderQuality = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_IMAGE_QUALITY_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= IMAGE_QUALITY_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.imageQuality = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_GRADIENT_QUALITY_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= GRADIENT_QUALITY_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.gradientQuality = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_OUTLINED_TEXT_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= 2)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.outlinedText = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_FAST_LINE_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= 2)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.fastLine = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_GEOMETRIC_PRECISION_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= GEOMETRIC_PRECISION_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.geometricPrecision = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    // ------------------------------------------------------------------------
+    // [Paint Opacity]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_OPACITY_F:
+    {
+      float v = _PARAM_C(float);
+      if (v < 0.0f || v > 1.0f)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->opacity = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(float));
+    }
+
+    case PAINTER_PARAMETER_OPACITY_D:
+    {
+      double v = _PARAM_C(double);
+      if (v < 0.0 || v > 1.0)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->opacity = (float)v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(double));
+    }
+
+    // ------------------------------------------------------------------------
+    // [Fill Params - Fill Rule]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_FILL_RULE_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= FILL_RULE_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->paintHints.fillRule = v;
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    // ------------------------------------------------------------------------
+    // [Stroke Params]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_PARAMS_F:
+    {
+      state->strokeParams = _PARAM_C(PathStrokerParamsF);
+      return engine->addStrokeParams();
+    }
+
+    case PAINTER_PARAMETER_STROKE_PARAMS_D:
+    {
+      state->strokeParams = _PARAM_C(PathStrokerParamsD);
+      return engine->addStrokeParams();
+    }
+
+    case PAINTER_PARAMETER_LINE_WIDTH_F:
+    {
+      state->strokeParams.setLineWidth(_PARAM_C(float));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(float));
+    }
+
+    case PAINTER_PARAMETER_LINE_WIDTH_D:
+    {
+      state->strokeParams.setLineWidth(_PARAM_C(double));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(double));
+    }
+
+    case PAINTER_PARAMETER_LINE_JOIN_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= LINE_JOIN_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->strokeParams.setLineJoin(v);
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_START_CAP_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= LINE_CAP_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->strokeParams.setStartCap(v);
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_END_CAP_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= LINE_CAP_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->strokeParams.setEndCap(v);
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_LINE_CAPS_I:
+    {
+      uint32_t v = _PARAM_C(uint32_t);
+      if (v >= LINE_CAP_COUNT)
+        return ERR_RT_INVALID_ARGUMENT;
+
+      state->strokeParams.setLineCaps(v);
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(uint32_t));
+    }
+
+    case PAINTER_PARAMETER_MITER_LIMIT_F:
+    {
+      state->strokeParams.setMiterLimit(_PARAM_C(float));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(float));
+    }
+
+    case PAINTER_PARAMETER_MITER_LIMIT_D:
+    {
+      state->strokeParams.setMiterLimit(_PARAM_C(double));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(double));
+    }
+
+    case PAINTER_PARAMETER_DASH_OFFSET_F:
+    {
+      state->strokeParams.setDashOffset(_PARAM_C(float));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(float));
+    }
+
+    case PAINTER_PARAMETER_DASH_OFFSET_D:
+    {
+      state->strokeParams.setDashOffset(_PARAM_C(double));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(double));
+    }
+
+    case PAINTER_PARAMETER_DASH_LIST_F:
+    case PAINTER_PARAMETER_DASH_LIST_D:
+    {
+      if (parameterId == PAINTER_PARAMETER_DASH_LIST_F)
+        FOG_RETURN_ON_ERROR(state->strokeParams._dashList.setList(_PARAM_C(List<float>)));
+      else
+        state->strokeParams.setDashList(_PARAM_C(List<double>));
+
+      uint32_t dashListId = PAINTER_PARAMETER_DASH_LIST_D;
+      uint32_t ref;
+      FOG_RETURN_ON_ERROR(engine->addResource(ref, DISPLAY_LIST_RESOURCE_DASH_LIST_D, &state->strokeParams._dashList));
+
+      DisplayListArg arg;
+      arg.setRef(ref);
+
+      return engine->addCmd(DISPLAY_LIST_FUNC(setParameter), DISPLAY_LIST_CMD_U32_PTR, &dashListId, 0, &arg);
+    }
+
+    // ------------------------------------------------------------------------
+    // [Filter - Scale]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_FILTER_SCALE_F:
+    {
+      state->filterScale.setFilterScale(_PARAM_C(ImageFilterScaleF));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(ImageFilterScaleF));
+    }
+
+    case PAINTER_PARAMETER_FILTER_SCALE_D:
+    {
+      state->filterScale.setFilterScale(_PARAM_C(ImageFilterScaleD));
+      return DisplayListPaintEngine_addParameter(self, parameterId, value, sizeof(ImageFilterScaleD));
+    }
+
+    // ------------------------------------------------------------------------
+    // [Caching]
+    // ------------------------------------------------------------------------
+
+    // Like multithreading, caching is the matter of the painter the display
+    // list is replayed onto.
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    {
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
+    default:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+  }
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_resetParameter(Painter* self, uint32_t parameterId)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  switch (parameterId)
+  {
+    case PAINTER_PARAMETER_SIZE_I:
+    case PAINTER_PARAMETER_SIZE_F:
+    case PAINTER_PARAMETER_SIZE_D:
+    case PAINTER_PARAMETER_FORMAT_I:
+    case PAINTER_PARAMETER_DEVICE_I:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
+    case PAINTER_PARAMETER_MULTITHREADED_I:
+    case PAINTER_PARAMETER_MAX_THREADS_I:
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_PAINT_PARAMS_F:
+    case PAINTER_PARAMETER_PAINT_PARAMS_D:
+      break;
+
+    case PAINTER_PARAMETER_PAINT_HINTS:
+      state->paintHints.reset();
+      break;
+
+    case PAINTER_PARAMETER_COMPOSITING_OPERATOR_I:
+      state->paintHints.compositingOperator = COMPOSITE_SRC_OVER;
+      break;
+
+    case PAINTER_PARAMETER_RENDER_QUALITY_I:
+      state->paintHints.renderQuality = RENDER_QUALITY_DEFAULT;
+      break;
+
+    case PAINTER_PARAMETER_IMAGE_QUALITY_I:
+      state->paintHints.imageQuality = IMAGE_QUALITY_DEFAULT;
+      break;
+
+    case PAINTER_PARAMETER_GRADIENT_QUALITY_I:
+      state->paintHints.gradientQuality = GRADIENT_QUALITY_NORMAL;
+      break;
+
+    case PAINTER_PARAMETER_OUTLINED_TEXT_I:
+      state->paintHints.outlinedText = false;
+      break;
+
+    case PAINTER_PARAMETER_FAST_LINE_I:
+      state->paintHints.fastLine = true;
+      break;
+
+    case PAINTER_PARAMETER_GEOMETRIC_PRECISION_I:
+      state->paintHints.geometricPrecision = false;
+      break;
+
+    case PAINTER_PARAMETER_OPACITY_F:
+    case PAINTER_PARAMETER_OPACITY_D:
+      state->opacity = 1.0f;
+      break;
+
+    case PAINTER_PARAMETER_FILL_RULE_I:
+      state->paintHints.fillRule = FILL_RULE_DEFAULT;
+      break;
+
+    case PAINTER_PARAMETER_STROKE_PARAMS_F:
+    case PAINTER_PARAMETER_STROKE_PARAMS_D:
+      state->strokeParams.reset();
+      break;
+
+    case PAINTER_PARAMETER_LINE_WIDTH_F:
+    case PAINTER_PARAMETER_LINE_WIDTH_D:
+      state->strokeParams.setLineWidth(1.0);
+      break;
+
+    case PAINTER_PARAMETER_LINE_JOIN_I:
+      state->strokeParams.setLineJoin(LINE_JOIN_DEFAULT);
+      break;
+
+    case PAINTER_PARAMETER_START_CAP_I:
+      state->strokeParams.setStartCap(LINE_CAP_DEFAULT);
+      break;
+
+    case PAINTER_PARAMETER_END_CAP_I:
+      state->strokeParams.setEndCap(LINE_CAP_DEFAULT);
+      break;
+
+    case PAINTER_PARAMETER_LINE_CAPS_I:
+      state->strokeParams.setLineCaps(LINE_CAP_DEFAULT);
+      break;
+
+    case PAINTER_PARAMETER_MITER_LIMIT_F:
+    case PAINTER_PARAMETER_MITER_LIMIT_D:
+      state->strokeParams.setMiterLimit(4.0);
+      break;
+
+    case PAINTER_PARAMETER_DASH_OFFSET_F:
+    case PAINTER_PARAMETER_DASH_OFFSET_D:
+      state->strokeParams.setDashOffset(0.0);
+      break;
+
+    case PAINTER_PARAMETER_DASH_LIST_F:
+    case PAINTER_PARAMETER_DASH_LIST_D:
+      state->strokeParams._dashList.clear();
+      break;
+
+    case PAINTER_PARAMETER_FILTER_SCALE_F:
+    case PAINTER_PARAMETER_FILTER_SCALE_D:
+      state->filterScale.reset();
+      break;
+
+    default:
+      return ERR_RT_INVALID_ARGUMENT;
+  }
+
+  return engine->addCmd(DISPLAY_LIST_FUNC(resetParameter), DISPLAY_LIST_CMD_U32, &parameterId, 0, NULL);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Source]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_getSourceType(const Painter* self, uint32_t* val)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  *val = engine->state->sourceType;
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_getSourceColor(const Painter* self, Color* color)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  if (state->sourceType != PATTERN_TYPE_COLOR)
+  {
+    color->reset();
+    return ERR_RT_INVALID_STATE;
+  }
+
+  color->setColor(state->sourceColor);
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_getSourcePattern(const Painter* self, Pattern* pattern)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  switch (state->sourceType)
+  {
+    case PATTERN_TYPE_NULL:
+      pattern->reset();
+      return ERR_OK;
+
+    case PATTERN_TYPE_COLOR:
+      return pattern->createColor(state->sourceColor);
+
+    default:
+      *pattern = state->sourcePattern;
+      return ERR_OK;
+  }
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourceNone(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  state->sourceType = PATTERN_TYPE_NULL;
+  state->sourcePattern.reset();
+
+  return DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(setSourceNone));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourceArgb32(Painter* self, uint32_t argb32)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  state->sourceType = PATTERN_TYPE_COLOR;
+  state->sourceColor.setArgb32(Argb32(argb32));
+  state->sourcePattern.reset();
+
+  return engine->addCmd(DISPLAY_LIST_FUNC(setSourceArgb32), DISPLAY_LIST_CMD_U32, &argb32, 0, NULL);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourceArgb64(Painter* self, const Argb64* argb64)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  state->sourceType = PATTERN_TYPE_COLOR;
+  state->sourceColor.setArgb64(*argb64);
+  state->sourcePattern.reset();
+
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(setSourceArgb64), argb64, sizeof(Argb64));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourceColor(Painter* self, const Color* color)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  state->sourceType = color->isValid() ? PATTERN_TYPE_COLOR : PATTERN_TYPE_NULL;
+  state->sourceColor.setColor(*color);
+  state->sourcePattern.reset();
+
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(setSourceColor), color, sizeof(Color));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourcePattern(Painter* self, const Pattern* pattern)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  switch (pattern->getPatternType())
+  {
+    case PATTERN_TYPE_NULL:
+      return DisplayListPaintEngine_setSourceNone(self);
+
+    case PATTERN_TYPE_COLOR:
+    {
+      Color color(UNINITIALIZED);
+      FOG_RETURN_ON_ERROR(pattern->getColor(color));
+      return DisplayListPaintEngine_setSourceColor(self, &color);
+    }
+
+    default:
+      state->sourceType = pattern->getPatternType();
+      state->sourcePattern = *pattern;
+      break;
+  }
+
+  return DisplayListPaintEngine_addResourcePtr(self, DISPLAY_LIST_FUNC(setSourcePattern), DISPLAY_LIST_RESOURCE_PATTERN, pattern);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setSourceAbstract(Painter* self, uint32_t sourceId, const void* value, const void* tr)
+{
+  Pattern pattern;
+
+  switch (sourceId)
+  {
+    case PAINTER_SOURCE_TEXTURE_F:
+      if (tr)
+        FOG_RETURN_ON_ERROR(pattern.createTexture(_PARAM_C(Texture), *reinterpret_cast<const TransformF*>(tr)));
+      else
+        FOG_RETURN_ON_ERROR(pattern.createTexture(_PARAM_C(Texture)));
+      break;
+
+    case PAINTER_SOURCE_TEXTURE_D:
+      if (tr)
+        FOG_RETURN_ON_ERROR(pattern.createTexture(_PARAM_C(Texture), *reinterpret_cast<const TransformD*>(tr)));
+      else
+        FOG_RETURN_ON_ERROR(pattern.createTexture(_PARAM_C(Texture)));
+      break;
+
+    case PAINTER_SOURCE_GRADIENT_F:
+      if (tr)
+        FOG_RETURN_ON_ERROR(pattern.createGradient(_PARAM_C(GradientF), *reinterpret_cast<const TransformF*>(tr)));
+      else
+        FOG_RETURN_ON_ERROR(pattern.createGradient(_PARAM_C(GradientF)));
+      break;
+
+    case PAINTER_SOURCE_GRADIENT_D:
+      if (tr)
+        FOG_RETURN_ON_ERROR(pattern.createGradient(_PARAM_C(GradientD), *reinterpret_cast<const TransformD*>(tr)));
+      else
+        FOG_RETURN_ON_ERROR(pattern.createGradient(_PARAM_C(GradientD)));
+      break;
+
+    default:
+      return ERR_RT_INVALID_ARGUMENT;
+  }
+
+  return DisplayListPaintEngine_setSourcePattern(self, &pattern);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Transform]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_getTransformF(const Painter* self, TransformF* tr)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  *tr = engine->state->transform;
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_getTransformD(const Painter* self, TransformD* tr)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  *tr = engine->state->transform;
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setTransformF(Painter* self, const TransformF* tr)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  engine->state->transform = *tr;
+  return engine->addTransform();
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_setTransformD(Painter* self, const TransformD* tr)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  engine->state->transform = *tr;
+  return engine->addTransform();
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_applyTransform(Painter* self, uint32_t transformOp, const void* params)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  err_t err = fog_api.transformd_transform(&engine->state->transform, transformOp, params);
+  if (FOG_IS_ERROR(err))
+    engine->state->transform.reset();
+
+  FOG_RETURN_ON_ERROR(engine->addTransform());
+  return err;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_resetTransform(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  engine->state->transform.reset();
+  return engine->addTransform();
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - State]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_save(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListPaintState* state = fog_new DisplayListPaintState(*engine->state);
+  if (FOG_IS_NULL(state))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  err_t err = DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(save));
+  if (FOG_IS_ERROR(err))
+  {
+    fog_delete(state);
+    return err;
+  }
+
+  state->prev = engine->state;
+  engine->state = state;
+  engine->stateCount++;
+
+  return ERR_OK;
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_restore(Painter* self)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListPaintState* state = engine->state;
+
+  if (engine->stateCount == 0)
+    return ERR_PAINTER_NO_STATE;
+
+  FOG_RETURN_ON_ERROR(DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(restore)));
+
+  engine->state = state->prev;
+  engine->stateCount--;
+
+  fog_delete(state);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Map]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_mapPointF(const Painter* self, uint32_t mapOp, PointF* pt)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  PointD pd(*pt);
+
+  switch (mapOp)
+  {
+    case PAINTER_MAP_USER_TO_DEVICE:
+      engine->state->transform.mapPoint(pd);
+      *pt = pd;
+      return ERR_OK;
+
+    case PAINTER_MAP_DEVICE_TO_USER:
+      engine->state->transform.inverted().mapPoint(pd);
+      *pt = pd;
+      return ERR_OK;
+
+    default:
+      return ERR_RT_INVALID_ARGUMENT;
+  }
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_mapPointD(const Painter* self, uint32_t mapOp, PointD* pt)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  switch (mapOp)
+  {
+    case PAINTER_MAP_USER_TO_DEVICE:
+      engine->state->transform.mapPoint(*pt);
+      return ERR_OK;
+
+    case PAINTER_MAP_DEVICE_TO_USER:
+      engine->state->transform.inverted().mapPoint(*pt);
+      return ERR_OK;
+
+    default:
+      return ERR_RT_INVALID_ARGUMENT;
+  }
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Draw / Fill - Shape]
+// ============================================================================
+
+static err_t DisplayListPaintEngine_doShapeF(Painter* self, uint32_t func, uint32_t shapeType, const void* shapeData)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListArg arg;
+
+  FOG_RETURN_ON_ERROR(engine->initShapeArgF(arg, shapeType, shapeData));
+  return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR, &shapeType, 0, &arg);
+}
+
+static err_t DisplayListPaintEngine_doShapeD(Painter* self, uint32_t func, uint32_t shapeType, const void* shapeData)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListArg arg;
+
+  FOG_RETURN_ON_ERROR(engine->initShapeArgD(arg, shapeType, shapeData));
+  return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR, &shapeType, 0, &arg);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Draw]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawRectI(Painter* self, const RectI* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(drawRectI), r, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawRectF(Painter* self, const RectF* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(drawRectF), r, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawRectD(Painter* self, const RectD* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(drawRectD), r, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawPolylineI(Painter* self, const PointI* p, size_t count)
+{
+  return DisplayListPaintEngine_addPtrCount(self, DISPLAY_LIST_FUNC(drawPolylineI), p, count, sizeof(PointI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawPolygonI(Painter* self, const PointI* p, size_t count)
+{
+  return DisplayListPaintEngine_addPtrCount(self, DISPLAY_LIST_FUNC(drawPolygonI), p, count, sizeof(PointI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawShapeF(Painter* self, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doShapeF(self, DISPLAY_LIST_FUNC(drawShapeF), shapeType, shapeData);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_drawShapeD(Painter* self, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doShapeD(self, DISPLAY_LIST_FUNC(drawShapeD), shapeType, shapeData);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Fill]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillAll(Painter* self)
+{
+  return DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(fillAll));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillRectI(Painter* self, const RectI* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(fillRectI), r, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillRectF(Painter* self, const RectF* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(fillRectF), r, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillRectD(Painter* self, const RectD* r)
+{
+  return DisplayListPaintEngine_addPtr(self, DISPLAY_LIST_FUNC(fillRectD), r, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillRectsI(Painter* self, const RectI* r, size_t count)
+{
+  return DisplayListPaintEngine_addPtrCount(self, DISPLAY_LIST_FUNC(fillRectsI), r, count, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillPolygonI(Painter* self, const PointI* p, size_t count)
+{
+  return DisplayListPaintEngine_addPtrCount(self, DISPLAY_LIST_FUNC(fillPolygonI), p, count, sizeof(PointI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillShapeF(Painter* self, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doShapeF(self, DISPLAY_LIST_FUNC(fillShapeF), shapeType, shapeData);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillShapeD(Painter* self, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doShapeD(self, DISPLAY_LIST_FUNC(fillShapeD), shapeType, shapeData);
+}
+
+static err_t DisplayListPaintEngine_doGlyphRun(Painter* self, uint32_t func,
+  const void* p, size_t pSize, const GlyphRun* glyphRun, const Font* font, const void* clip, size_t clipSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[4];
+  uint32_t glyphRunRef;
+  uint32_t fontRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(glyphRunRef, DISPLAY_LIST_RESOURCE_GLYPH_RUN, glyphRun));
+  FOG_RETURN_ON_ERROR(engine->addResource(fontRef, DISPLAY_LIST_RESOURCE_FONT, font));
+
+  args[0].setData(p, pSize);
+  args[1].setRef(glyphRunRef);
+  args[2].setRef(fontRef);
+  args[3].setData(clip, clipSize);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR, NULL, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillGlyphRunI(Painter* self, const PointI* p, const GlyphRun* glyphRun, const Font* font, const RectI* clip)
+{
+  return DisplayListPaintEngine_doGlyphRun(self, DISPLAY_LIST_FUNC(fillGlyphRunI), p, sizeof(PointI), glyphRun, font, clip, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillGlyphRunF(Painter* self, const PointF* p, const GlyphRun* glyphRun, const Font* font, const RectF* clip)
+{
+  return DisplayListPaintEngine_doGlyphRun(self, DISPLAY_LIST_FUNC(fillGlyphRunF), p, sizeof(PointF), glyphRun, font, clip, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillGlyphRunD(Painter* self, const PointD* p, const GlyphRun* glyphRun, const Font* font, const RectD* clip)
+{
+  return DisplayListPaintEngine_doGlyphRun(self, DISPLAY_LIST_FUNC(fillGlyphRunD), p, sizeof(PointD), glyphRun, font, clip, sizeof(RectD));
+}
+
+static err_t DisplayListPaintEngine_doText(Painter* self, uint32_t func, const uint32_t* clipOp,
+  const void* p, size_t pSize, const StringW* text, const Font* font, const void* clip, size_t clipSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[4];
+  uint32_t textRef;
+  uint32_t fontRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(textRef, DISPLAY_LIST_RESOURCE_STRING_W, text));
+  FOG_RETURN_ON_ERROR(engine->addResource(fontRef, DISPLAY_LIST_RESOURCE_FONT, font));
+
+  args[0].setData(p, pSize);
+  args[1].setRef(textRef);
+  args[2].setRef(fontRef);
+  args[3].setData(clip, clipSize);
+
+  if (clipOp == NULL)
+    return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR, NULL, 0, args);
+  else
+    return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR_PTR_PTR_PTR, clipOp, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextAtI(Painter* self, const PointI* p, const StringW* text, const Font* font, const RectI* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextAtI), NULL, p, sizeof(PointI), text, font, clip, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextAtF(Painter* self, const PointF* p, const StringW* text, const Font* font, const RectF* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextAtF), NULL, p, sizeof(PointF), text, font, clip, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextAtD(Painter* self, const PointD* p, const StringW* text, const Font* font, const RectD* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextAtD), NULL, p, sizeof(PointD), text, font, clip, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextInI(Painter* self, const TextRectI* r, const StringW* text, const Font* font, const RectI* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextInI), NULL, r, sizeof(TextRectI), text, font, clip, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextInF(Painter* self, const TextRectF* r, const StringW* text, const Font* font, const RectF* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextInF), NULL, r, sizeof(TextRectF), text, font, clip, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillTextInD(Painter* self, const TextRectD* r, const StringW* text, const Font* font, const RectD* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(fillTextInD), NULL, r, sizeof(TextRectD), text, font, clip, sizeof(RectD));
+}
+
+static err_t DisplayListPaintEngine_doMask(Painter* self, uint32_t func, const uint32_t* clipOp,
+  const void* p, size_t pSize, const Image* mask, const RectI* mFragment)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[3];
+  uint32_t maskRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(maskRef, DISPLAY_LIST_RESOURCE_IMAGE, mask));
+
+  args[0].setData(p, pSize);
+  args[1].setRef(maskRef);
+  args[2].setData(mFragment, sizeof(RectI));
+
+  if (clipOp == NULL)
+    return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR_PTR, NULL, 0, args);
+  else
+    return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR_PTR_PTR, clipOp, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskAtI(Painter* self, const PointI* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskAtI), NULL, p, sizeof(PointI), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskAtF(Painter* self, const PointF* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskAtF), NULL, p, sizeof(PointF), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskAtD(Painter* self, const PointD* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskAtD), NULL, p, sizeof(PointD), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskInI(Painter* self, const RectI* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskInI), NULL, r, sizeof(RectI), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskInF(Painter* self, const RectF* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskInF), NULL, r, sizeof(RectF), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillMaskInD(Painter* self, const RectD* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(fillMaskInD), NULL, r, sizeof(RectD), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_fillRegion(Painter* self, const Region* r)
+{
+  return DisplayListPaintEngine_addResourcePtr(self, DISPLAY_LIST_FUNC(fillRegion), DISPLAY_LIST_RESOURCE_REGION, r);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Blit]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageAtI(Painter* self, const PointI* p, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageAtI), NULL, p, sizeof(PointI), src, sFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageAtF(Painter* self, const PointF* p, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageAtF), NULL, p, sizeof(PointF), src, sFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageAtD(Painter* self, const PointD* p, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageAtD), NULL, p, sizeof(PointD), src, sFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageInI(Painter* self, const RectI* r, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageInI), NULL, r, sizeof(RectI), src, sFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageInF(Painter* self, const RectF* r, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageInF), NULL, r, sizeof(RectF), src, sFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImageInD(Painter* self, const RectD* r, const Image* src, const RectI* sFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(blitImageInD), NULL, r, sizeof(RectD), src, sFragment);
+}
+
+static err_t DisplayListPaintEngine_doMaskedImage(Painter* self, uint32_t func,
+  const void* p, size_t pSize, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[5];
+  uint32_t srcRef;
+  uint32_t maskRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(srcRef, DISPLAY_LIST_RESOURCE_IMAGE, src));
+  FOG_RETURN_ON_ERROR(engine->addResource(maskRef, DISPLAY_LIST_RESOURCE_IMAGE, mask));
+
+  args[0].setData(p, pSize);
+  args[1].setRef(srcRef);
+  args[2].setRef(maskRef);
+  args[3].setData(sFragment, sizeof(RectI));
+  args[4].setData(mFragment, sizeof(RectI));
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR_PTR_PTR_PTR, NULL, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageAtI(Painter* self, const PointI* p, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageAtI), p, sizeof(PointI), src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageAtF(Painter* self, const PointF* p, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageAtF), p, sizeof(PointF), src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageAtD(Painter* self, const PointD* p, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageAtD), p, sizeof(PointD), src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageInI(Painter* self, const RectI* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageInI), r, sizeof(RectI), src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageInF(Painter* self, const RectF* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageInF), r, sizeof(RectF), src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitMaskedImageInD(Painter* self, const RectD* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMaskedImage(self, DISPLAY_LIST_FUNC(blitMaskedImageInD), r, sizeof(RectD), src, mask, sFragment, mFragment);
+}
+
+static err_t DisplayListPaintEngine_doImages(Painter* self, uint32_t func,
+  const Image* src, const void* items, size_t count, size_t itemSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  if (count == 0)
+    return ERR_OK;
+
+  if (FOG_UNLIKELY(count > UINT32_MAX / itemSize))
+    return ERR_RT_OVERFLOW;
+
+  DisplayListArg args[2];
+  uint32_t srcRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(srcRef, DISPLAY_LIST_RESOURCE_IMAGE, src));
+
+  args[0].setRef(srcRef);
+  args[1].setData(items, count * itemSize);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR_COUNT, NULL, count, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImagesI(Painter* self, const Image* src, const SpriteItemI* items, size_t count)
+{
+  return DisplayListPaintEngine_doImages(self, DISPLAY_LIST_FUNC(blitImagesI), src, items, count, sizeof(SpriteItemI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_blitImagesF(Painter* self, const Image* src, const SpriteItemF* items, size_t count)
+{
+  return DisplayListPaintEngine_doImages(self, DISPLAY_LIST_FUNC(blitImagesF), src, items, count, sizeof(SpriteItemF));
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Filter]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterAll(Painter* self, const FeBase* fe)
+{
+  return DisplayListPaintEngine_addResourcePtr(self, DISPLAY_LIST_FUNC(filterAll), DISPLAY_LIST_RESOURCE_IMAGE_FILTER, fe);
+}
+
+static err_t DisplayListPaintEngine_doFilterRect(Painter* self, uint32_t func, const FeBase* fe, const void* r, size_t rSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[2];
+  uint32_t feRef;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(feRef, DISPLAY_LIST_RESOURCE_IMAGE_FILTER, fe));
+
+  args[0].setRef(feRef);
+  args[1].setData(r, rSize);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_PTR, NULL, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterRectI(Painter* self, const FeBase* fe, const RectI* r)
+{
+  return DisplayListPaintEngine_doFilterRect(self, DISPLAY_LIST_FUNC(filterRectI), fe, r, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterRectF(Painter* self, const FeBase* fe, const RectF* r)
+{
+  return DisplayListPaintEngine_doFilterRect(self, DISPLAY_LIST_FUNC(filterRectF), fe, r, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterRectD(Painter* self, const FeBase* fe, const RectD* r)
+{
+  return DisplayListPaintEngine_doFilterRect(self, DISPLAY_LIST_FUNC(filterRectD), fe, r, sizeof(RectD));
+}
+
+static err_t DisplayListPaintEngine_doFilterShape(Painter* self, uint32_t func, const FeBase* fe,
+  uint32_t shapeType, const void* shapeData, bool isDouble)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg args[2];
+  uint32_t feRef;
+
+  if (isDouble)
+    FOG_RETURN_ON_ERROR(engine->initShapeArgD(args[1], shapeType, shapeData));
+  else
+    FOG_RETURN_ON_ERROR(engine->initShapeArgF(args[1], shapeType, shapeData));
+
+  FOG_RETURN_ON_ERROR(engine->addResource(feRef, DISPLAY_LIST_RESOURCE_IMAGE_FILTER, fe));
+  args[0].setRef(feRef);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_PTR_U32_PTR, &shapeType, 0, args);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterShapeF(Painter* self, const FeBase* fe, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doFilterShape(self, DISPLAY_LIST_FUNC(filterShapeF), fe, shapeType, shapeData, false);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterShapeD(Painter* self, const FeBase* fe, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doFilterShape(self, DISPLAY_LIST_FUNC(filterShapeD), fe, shapeType, shapeData, true);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterStrokedShapeF(Painter* self, const FeBase* fe, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doFilterShape(self, DISPLAY_LIST_FUNC(filterStrokedShapeF), fe, shapeType, shapeData, false);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_filterStrokedShapeD(Painter* self, const FeBase* fe, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doFilterShape(self, DISPLAY_LIST_FUNC(filterStrokedShapeD), fe, shapeType, shapeData, true);
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Clip]
+// ============================================================================
+
+static err_t DisplayListPaintEngine_doClipPtr(Painter* self, uint32_t func, uint32_t clipOp, const void* p, size_t size)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  arg.setData(p, size);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR, &clipOp, 0, &arg);
+}
+
+static err_t DisplayListPaintEngine_doClipPtrCount(Painter* self, uint32_t func, uint32_t clipOp, const void* p, size_t count, size_t itemSize)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  arg.setData(p, count * itemSize);
+
+  return engine->addCmd(func, DISPLAY_LIST_CMD_U32_PTR_COUNT, &clipOp, count, &arg);
+}
+
+static err_t DisplayListPaintEngine_doClipShape(Painter* self, uint32_t func, uint32_t clipOp,
+  uint32_t shapeType, const void* shapeData, bool isDouble)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  DisplayListArg arg;
+
+  if (isDouble)
+    FOG_RETURN_ON_ERROR(engine->initShapeArgD(arg, shapeType, shapeData));
+  else
+    FOG_RETURN_ON_ERROR(engine->initShapeArgF(arg, shapeType, shapeData));
+
+  uint32_t u32[2] = { clipOp, shapeType };
+  return engine->addCmd(func, DISPLAY_LIST_CMD_U32_U32_PTR, u32, 0, &arg);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipRectI(Painter* self, uint32_t clipOp, const RectI* r)
+{
+  return DisplayListPaintEngine_doClipPtr(self, DISPLAY_LIST_FUNC(clipRectI), clipOp, r, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipRectF(Painter* self, uint32_t clipOp, const RectF* r)
+{
+  return DisplayListPaintEngine_doClipPtr(self, DISPLAY_LIST_FUNC(clipRectF), clipOp, r, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipRectD(Painter* self, uint32_t clipOp, const RectD* r)
+{
+  return DisplayListPaintEngine_doClipPtr(self, DISPLAY_LIST_FUNC(clipRectD), clipOp, r, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipRectsI(Painter* self, uint32_t clipOp, const RectI* r, size_t count)
+{
+  return DisplayListPaintEngine_doClipPtrCount(self, DISPLAY_LIST_FUNC(clipRectsI), clipOp, r, count, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipPolygonI(Painter* self, uint32_t clipOp, const PointI* p, size_t count)
+{
+  return DisplayListPaintEngine_doClipPtrCount(self, DISPLAY_LIST_FUNC(clipPolygonI), clipOp, p, count, sizeof(PointI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipShapeF(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doClipShape(self, DISPLAY_LIST_FUNC(clipShapeF), clipOp, shapeType, shapeData, false);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipShapeD(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doClipShape(self, DISPLAY_LIST_FUNC(clipShapeD), clipOp, shapeType, shapeData, true);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipStrokedShapeF(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doClipShape(self, DISPLAY_LIST_FUNC(clipStrokedShapeF), clipOp, shapeType, shapeData, false);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipStrokedShapeD(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
+{
+  return DisplayListPaintEngine_doClipShape(self, DISPLAY_LIST_FUNC(clipStrokedShapeD), clipOp, shapeType, shapeData, true);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextAtI(Painter* self, uint32_t clipOp, const PointI* p, const StringW* text, const Font* font, const RectI* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextAtI), &clipOp, p, sizeof(PointI), text, font, clip, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextAtF(Painter* self, uint32_t clipOp, const PointF* p, const StringW* text, const Font* font, const RectF* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextAtF), &clipOp, p, sizeof(PointF), text, font, clip, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextAtD(Painter* self, uint32_t clipOp, const PointD* p, const StringW* text, const Font* font, const RectD* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextAtD), &clipOp, p, sizeof(PointD), text, font, clip, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextInI(Painter* self, uint32_t clipOp, const TextRectI* r, const StringW* text, const Font* font, const RectI* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextInI), &clipOp, r, sizeof(TextRectI), text, font, clip, sizeof(RectI));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextInF(Painter* self, uint32_t clipOp, const TextRectF* r, const StringW* text, const Font* font, const RectF* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextInF), &clipOp, r, sizeof(TextRectF), text, font, clip, sizeof(RectF));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipTextInD(Painter* self, uint32_t clipOp, const TextRectD* r, const StringW* text, const Font* font, const RectD* clip)
+{
+  return DisplayListPaintEngine_doText(self, DISPLAY_LIST_FUNC(clipTextInD), &clipOp, r, sizeof(TextRectD), text, font, clip, sizeof(RectD));
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskAtI(Painter* self, uint32_t clipOp, const PointI* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskAtI), &clipOp, p, sizeof(PointI), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskAtF(Painter* self, uint32_t clipOp, const PointF* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskAtF), &clipOp, p, sizeof(PointF), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskAtD(Painter* self, uint32_t clipOp, const PointD* p, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskAtD), &clipOp, p, sizeof(PointD), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskInI(Painter* self, uint32_t clipOp, const RectI* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskInI), &clipOp, r, sizeof(RectI), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskInF(Painter* self, uint32_t clipOp, const RectF* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskInF), &clipOp, r, sizeof(RectF), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipMaskInD(Painter* self, uint32_t clipOp, const RectD* r, const Image* mask, const RectI* mFragment)
+{
+  return DisplayListPaintEngine_doMask(self, DISPLAY_LIST_FUNC(clipMaskInD), &clipOp, r, sizeof(RectD), mask, mFragment);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_clipRegion(Painter* self, uint32_t clipOp, const Region* r)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+
+  DisplayListArg arg;
+  uint32_t ref;
+
+  FOG_RETURN_ON_ERROR(engine->addResource(ref, DISPLAY_LIST_RESOURCE_REGION, r));
+  arg.setRef(ref);
+
+  return engine->addCmd(DISPLAY_LIST_FUNC(clipRegion), DISPLAY_LIST_CMD_U32_PTR, &clipOp, 0, &arg);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_resetClip(Painter* self)
+{
+  return DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(resetClip));
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Group]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_beginGroup(Painter* self, uint32_t flags)
+{
+  DisplayListPaintEngine* engine = static_cast<DisplayListPaintEngine*>(self->_engine);
+  return engine->addCmd(DISPLAY_LIST_FUNC(beginGroup), DISPLAY_LIST_CMD_U32, &flags, 0, NULL);
+}
+
+static err_t FOG_CDECL DisplayListPaintEngine_paintGroup(Painter* self)
+{
+  return DisplayListPaintEngine_addVoid(self, DISPLAY_LIST_FUNC(paintGroup));
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Flush]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_flush(Painter* self, uint32_t flags)
+{
+  // Nothing is rendered, so there is nothing to flush.
+  FOG_UNUSED(self);
+  FOG_UNUSED(flags);
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine - Begin]
+// ============================================================================
+
+static err_t FOG_CDECL DisplayListPaintEngine_beginDisplayList(Painter* self, DisplayList* displayList, const SizeI* size, uint32_t initFlags)
+{
+  err_t err;
+  DisplayListPaintEngine* engine;
+
+  // Release the painter engine.
+  if (self->_engine)
+    self->_vtable->release(self);
+
+  // Create the display-list painter engine.
+  engine = fog_new DisplayListPaintEngine();
+  if (FOG_IS_NULL(engine))
+  {
+    err = ERR_RT_OUT_OF_MEMORY;
+    goto _Fail;
+  }
+
+  err = engine->init(displayList, *size, initFlags);
+  if (FOG_IS_ERROR(err))
+  {
+    fog_delete(engine);
+    goto _Fail;
+  }
+
+  self->_engine = engine;
+  self->_vtable = engine->vtable;
+  return ERR_OK;
+
+_Fail:
+  self->_engine = fog_api.painter_getNullEngine();
+  self->_vtable = self->_engine->vtable;
+  return err;
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void DisplayListPaintEngine_init(void)
+{
+  fog_api.painter_beginDisplayList = DisplayListPaintEngine_beginDisplayList;
+
+  PaintEngineVTable* v = &DisplayListPaintEngine_vtable;
+
+  // --------------------------------------------------------------------------
+  // [AddRef / Release]
+  // --------------------------------------------------------------------------
+
+  v->release = DisplayListPaintEngine_release;
+
+  // --------------------------------------------------------------------------
+  // [Meta Params]
+  // --------------------------------------------------------------------------
+
+  v->getMetaParams = DisplayListPaintEngine_getMetaParams;
+  v->setMetaParams = DisplayListPaintEngine_setMetaParams;
+  v->resetMetaParams = DisplayListPaintEngine_resetMetaParams;
+
+  // --------------------------------------------------------------------------
+  // [Parameters]
+  // --------------------------------------------------------------------------
+
+  v->getParameter = DisplayListPaintEngine_getParameter;
+  v->setParameter = DisplayListPaintEngine_setParameter;
+  v->resetParameter = DisplayListPaintEngine_resetParameter;
+
+  // --------------------------------------------------------------------------
+  // [Source]
+  // --------------------------------------------------------------------------
+
+  v->getSourceType = DisplayListPaintEngine_getSourceType;
+  v->getSourceColor = DisplayListPaintEngine_getSourceColor;
+  v->getSourcePattern = DisplayListPaintEngine_getSourcePattern;
+
+  v->setSourceNone = DisplayListPaintEngine_setSourceNone;
+  v->setSourceArgb32 = DisplayListPaintEngine_setSourceArgb32;
+  v->setSourceArgb64 = DisplayListPaintEngine_setSourceArgb64;
+  v->setSourceColor = DisplayListPaintEngine_setSourceColor;
+  v->setSourcePattern = DisplayListPaintEngine_setSourcePattern;
+  v->setSourceAbstract = DisplayListPaintEngine_setSourceAbstract;
+
+  // --------------------------------------------------------------------------
+  // [Transform]
+  // --------------------------------------------------------------------------
+
+  v->getTransformF = DisplayListPaintEngine_getTransformF;
+  v->getTransformD = DisplayListPaintEngine_getTransformD;
+
+  v->setTransformF = DisplayListPaintEngine_setTransformF;
+  v->setTransformD = DisplayListPaintEngine_setTransformD;
+
+  v->applyTransform = DisplayListPaintEngine_applyTransform;
+  v->resetTransform = DisplayListPaintEngine_resetTransform;
+
+  // --------------------------------------------------------------------------
+  // [State]
+  // --------------------------------------------------------------------------
+
+  v->save = DisplayListPaintEngine_save;
+  v->restore = DisplayListPaintEngine_restore;
+
+  // --------------------------------------------------------------------------
+  // [Map]
+  // --------------------------------------------------------------------------
+
+  v->mapPointF = DisplayListPaintEngine_mapPointF;
+  v->mapPointD = DisplayListPaintEngine_mapPointD;
+
+  // --------------------------------------------------------------------------
+  // [Draw]
+  // --------------------------------------------------------------------------
+
+  v->drawRectI = DisplayListPaintEngine_drawRectI;
+  v->drawRectF = DisplayListPaintEngine_drawRectF;
+  v->drawRectD = DisplayListPaintEngine_drawRectD;
+
+  v->drawPolylineI = DisplayListPaintEngine_drawPolylineI;
+  v->drawPolygonI = DisplayListPaintEngine_drawPolygonI;
+
+  v->drawShapeF = DisplayListPaintEngine_drawShapeF;
+  v->drawShapeD = DisplayListPaintEngine_drawShapeD;
+
+  // --------------------------------------------------------------------------
+  // [Fill]
+  // --------------------------------------------------------------------------
+
+  v->fillAll = DisplayListPaintEngine_fillAll;
+
+  v->fillRectI = DisplayListPaintEngine_fillRectI;
+  v->fillRectF = DisplayListPaintEngine_fillRectF;
+  v->fillRectD = DisplayListPaintEngine_fillRectD;
+
+  v->fillRectsI = DisplayListPaintEngine_fillRectsI;
+  v->fillPolygonI = DisplayListPaintEngine_fillPolygonI;
+
+  v->fillShapeF = DisplayListPaintEngine_fillShapeF;
+  v->fillShapeD = DisplayListPaintEngine_fillShapeD;
+
+  v->fillGlyphRunI = DisplayListPaintEngine_fillGlyphRunI;
+  v->fillGlyphRunF = DisplayListPaintEngine_fillGlyphRunF;
+  v->fillGlyphRunD = DisplayListPaintEngine_fillGlyphRunD;
+
+  v->fillTextAtI = DisplayListPaintEngine_fillTextAtI;
+  v->fillTextAtF = DisplayListPaintEngine_fillTextAtF;
+  v->fillTextAtD = DisplayListPaintEngine_fillTextAtD;
+
+  v->fillTextInI = DisplayListPaintEngine_fillTextInI;
+  v->fillTextInF = DisplayListPaintEngine_fillTextInF;
+  v->fillTextInD = DisplayListPaintEngine_fillTextInD;
+
+  v->fillMaskAtI = DisplayListPaintEngine_fillMaskAtI;
+  v->fillMaskAtF = DisplayListPaintEngine_fillMaskAtF;
+  v->fillMaskAtD = DisplayListPaintEngine_fillMaskAtD;
+
+  v->fillMaskInI = DisplayListPaintEngine_fillMaskInI;
+  v->fillMaskInF = DisplayListPaintEngine_fillMaskInF;
+  v->fillMaskInD = DisplayListPaintEngine_fillMaskInD;
+
+  v->fillRegion = DisplayListPaintEngine_fillRegion;
+
+  // --------------------------------------------------------------------------
+  // [Blit]
+  // --------------------------------------------------------------------------
+
+  v->blitImageAtI = DisplayListPaintEngine_blitImageAtI;
+  v->blitImageAtF = DisplayListPaintEngine_blitImageAtF;
+  v->blitImageAtD = DisplayListPaintEngine_blitImageAtD;
+
+  v->blitImageInI = DisplayListPaintEngine_blitImageInI;
+  v->blitImageInF = DisplayListPaintEngine_blitImageInF;
+  v->blitImageInD = DisplayListPaintEngine_blitImageInD;
+
+  v->blitMaskedImageAtI = DisplayListPaintEngine_blitMaskedImageAtI;
+  v->blitMaskedImageAtF = DisplayListPaintEngine_blitMaskedImageAtF;
+  v->blitMaskedImageAtD = DisplayListPaintEngine_blitMaskedImageAtD;
+
+  v->blitMaskedImageInI = DisplayListPaintEngine_blitMaskedImageInI;
+  v->blitMaskedImageInF = DisplayListPaintEngine_blitMaskedImageInF;
+  v->blitMaskedImageInD = DisplayListPaintEngine_blitMaskedImageInD;
+
+  v->blitImagesI = DisplayListPaintEngine_blitImagesI;
+  v->blitImagesF = DisplayListPaintEngine_blitImagesF;
+
+  // --------------------------------------------------------------------------
+  // [Filter]
+  // --------------------------------------------------------------------------
+
+  v->filterAll = DisplayListPaintEngine_filterAll;
+
+  v->filterRectI = DisplayListPaintEngine_filterRectI;
+  v->filterRectF = DisplayListPaintEngine_filterRectF;
+  v->filterRectD = DisplayListPaintEngine_filterRectD;
+
+  v->filterShapeF = DisplayListPaintEngine_filterShapeF;
+  v->filterShapeD = DisplayListPaintEngine_filterShapeD;
+
+  v->filterStrokedShapeF = DisplayListPaintEngine_filterStrokedShapeF;
+  v->filterStrokedShapeD = DisplayListPaintEngine_filterStrokedShapeD;
+
+  // --------------------------------------------------------------------------
+  // [Clip]
+  // --------------------------------------------------------------------------
+
+  v->clipRectI = DisplayListPaintEngine_clipRectI;
+  v->clipRectF = DisplayListPaintEngine_clipRectF;
+  v->clipRectD = DisplayListPaintEngine_clipRectD;
+
+  v->clipRectsI = DisplayListPaintEngine_clipRectsI;
+  v->clipPolygonI = DisplayListPaintEngine_clipPolygonI;
+
+  v->clipShapeF = DisplayListPaintEngine_clipShapeF;
+  v->clipShapeD = DisplayListPaintEngine_clipShapeD;
+
+  v->clipStrokedShapeF = DisplayListPaintEngine_clipStrokedShapeF;
+  v->clipStrokedShapeD = DisplayListPaintEngine_clipStrokedShapeD;
+
+  v->clipTextAtI = DisplayListPaintEngine_clipTextAtI;
+  v->clipTextAtF = DisplayListPaintEngine_clipTextAtF;
+  v->clipTextAtD = DisplayListPaintEngine_clipTextAtD;
+
+  v->clipTextInI = DisplayListPaintEngine_clipTextInI;
+  v->clipTextInF = DisplayListPaintEngine_clipTextInF;
+  v->clipTextInD = DisplayListPaintEngine_clipTextInD;
+
+  v->clipMaskAtI = DisplayListPaintEngine_clipMaskAtI;
+  v->clipMaskAtF = DisplayListPaintEngine_clipMaskAtF;
+  v->clipMaskAtD = DisplayListPaintEngine_clipMaskAtD;
+
+  v->clipMaskInI = DisplayListPaintEngine_clipMaskInI;
+  v->clipMaskInF = DisplayListPaintEngine_clipMaskInF;
+  v->clipMaskInD = DisplayListPaintEngine_clipMaskInD;
+
+  v->clipRegion = DisplayListPaintEngine_clipRegion;
+
+  v->resetClip = DisplayListPaintEngine_resetClip;
+
+  // --------------------------------------------------------------------------
+  // [Group]
+  // --------------------------------------------------------------------------
+
+  v->beginGroup = DisplayListPaintEngine_beginGroup;
+  v->paintGroup = DisplayListPaintEngine_paintGroup;
+
+  // --------------------------------------------------------------------------
+  // [Flush]
+  // --------------------------------------------------------------------------
+
+  v->flush = DisplayListPaintEngine_flush;
+}
+
+} // Fog namespace
@@ -0,0 +1,225 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_DISPLAYLISTPAINTENGINE_P_H
+#define _FOG_G2D_PAINTING_DISPLAYLISTPAINTENGINE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Geometry/PathStroker.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Geometry/Size.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Imaging/ImageFilterScale.h>
+#include <Fog/G2d/Painting/DisplayList.h>
+#include <Fog/G2d/Painting/DisplayListCmd_p.h>
+#include <Fog/G2d/Painting/PaintEngine.h>
+#include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Source/Color.h>
+#include <Fog/G2d/Source/Pattern.h>
+#include <Fog/G2d/Tools/Region.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::DisplayListArg]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Pointer argument passed to @ref DisplayListPaintEngine::addCmd().
+struct FOG_NO_EXPORT DisplayListArg
+{
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Store the value of @a size bytes at @a data inline in the command
+  //! (or the @c NULL pointer if @a data is @c NULL).
+  FOG_INLINE void setData(const void* data_, size_t size_)
+  {
+    data = data_;
+    size = (data_ != NULL) ? size_ : 0;
+    ref = 0;
+  }
+
+  //! @brief Use the resource @a ref_ returned by @ref DisplayListPaintEngine::addResource().
+  FOG_INLINE void setRef(uint32_t ref_)
+  {
+    data = NULL;
+    size = 0;
+    ref = ref_;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  const void* data;
+  size_t size;
+  uint32_t ref;
+};
+
+// ============================================================================
+// [Fog::DisplayListPaintState]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list paint-engine state.
+//!
+//! The recording engine doesn't render anything, but it must be able to
+//! answer all painter queries (parameters, source, transform), so it keeps
+//! the state it was set to. The state is saved / restored by @ref Painter::save()
+//! and @ref Painter::restore().
+struct FOG_NO_EXPORT DisplayListPaintState
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DisplayListPaintState();
+  DisplayListPaintState(const DisplayListPaintState& other);
+  ~DisplayListPaintState();
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Previous (saved) state.
+  DisplayListPaintState* prev;
+
+  //! @brief Paint hints.
+  PaintHints paintHints;
+  //! @brief Opacity.
+  float opacity;
+
+  //! @brief Source type (see @c PATTERN_TYPE).
+  uint32_t sourceType;
+  //! @brief Source color (@c PATTERN_TYPE_COLOR).
+  Color sourceColor;
+  //! @brief Source pattern (@c PATTERN_TYPE_TEXTURE or @c PATTERN_TYPE_GRADIENT).
+  Pattern sourcePattern;
+
+  //! @brief Stroke parameters.
+  PathStrokerParamsD strokeParams;
+  //! @brief Filter scale.
+  ImageFilterScaleD filterScale;
+
+  //! @brief User transform.
+  TransformD transform;
+};
+
+// ============================================================================
+// [Fog::DisplayListPaintEngine]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Display-list paint-engine (records painter commands).
+//!
+//! Each paint-engine call which modifies the state or paints something is
+//! stored as a @ref DisplayListCmd. Values passed by pointer are copied into
+//! the command and reference-counted objects (images, paths, patterns, fonts,
+//! ...) are stored in the resource list. The recorded command stream and
+//! resources are moved into the destination @ref DisplayList when the painter
+//! is finalized.
+struct FOG_NO_EXPORT DisplayListPaintEngine : public PaintEngine
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  DisplayListPaintEngine();
+  ~DisplayListPaintEngine();
+
+  // --------------------------------------------------------------------------
+  // [Init / Finish]
+  // --------------------------------------------------------------------------
+
+  err_t init(DisplayList* displayList, const SizeI& size, uint32_t initFlags);
+
+  //! @brief Move the recorded commands into the destination display-list.
+  err_t finish();
+
+  // --------------------------------------------------------------------------
+  // [Recording]
+  // --------------------------------------------------------------------------
+
+  //! @brief Add resource of @a resourceType (copy of @a object) and store its
+  //! reference to @a ref.
+  err_t addResource(uint32_t& ref, uint32_t resourceType, const void* object);
+
+  //! @brief Add command of @a cmdType calling function @a func.
+  err_t addCmd(uint32_t func, uint32_t cmdType, const uint32_t* u32, size_t count, const DisplayListArg* args);
+
+  //! @brief Add command which sets the current user transform.
+  err_t addTransform();
+
+  //! @brief Add the current stroke parameters.
+  err_t addStrokeParams();
+
+  //! @brief Prepare shape argument (float precision), converting shapes which
+  //! point to external data into a path.
+  err_t initShapeArgF(DisplayListArg& arg, uint32_t& shapeType, const void* shapeData);
+  //! @brief Prepare shape argument (double precision), converting shapes which
+  //! point to external data into a path.
+  err_t initShapeArgD(DisplayListArg& arg, uint32_t& shapeType, const void* shapeData);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief The destination display-list.
+  DisplayList* displayList;
+  //! @brief Size of the recording surface.
+  SizeI size;
+
+  //! @brief Meta region (only stored, not recorded).
+  Region metaRegion;
+  //! @brief Meta origin (only stored, not recorded).
+  PointI metaOrigin;
+
+  //! @brief The current state.
+  DisplayListPaintState* state;
+  //! @brief Count of saved states.
+  size_t stateCount;
+
+  //! @brief Command stream.
+  uint8_t* cmdData;
+  //! @brief Length of the command stream (in bytes).
+  size_t cmdLength;
+  //! @brief Capacity of the command stream (in bytes).
+  size_t cmdCapacity;
+  //! @brief Count of recorded commands.
+  size_t cmdCount;
+
+  //! @brief Resources.
+  DisplayListResource* resourceData;
+  //! @brief Count of resources.
+  size_t resourceCount;
+  //! @brief Capacity of resources.
+  size_t resourceCapacity;
+
+private:
+  FOG_NO_COPY(DisplayListPaintEngine)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_DISPLAYLISTPAINTENGINE_P_H
@@ -479,6 +479,18 @@ static err_t FOG_CDECL MyPaintEngine_blitMaskedImageInD(Painter* self, const Rec
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
+static err_t FOG_CDECL MyPaintEngine_blitImagesI(Painter* self, const Image* src, const SpriteItemI* items, size_t count)
+{
+  MyPaintEngine* engine = static_cast<MyPaintEngine*>(self->_engine);
+  return ERR_RT_NOT_IMPLEMENTED;
+}
+
+static err_t FOG_CDECL MyPaintEngine_blitImagesF(Painter* self, const Image* src, const SpriteItemF* items, size_t count)
+{
+  MyPaintEngine* engine = static_cast<MyPaintEngine*>(self->_engine);
+  return ERR_RT_NOT_IMPLEMENTED;
+}
+
 // ============================================================================
 // [Fog::MyPaintEngine - Filter]
 // ============================================================================
@@ -850,6 +862,9 @@ static void MyPaintEngine_init()
   v->blitMaskedImageInF = MyPaintEngine_blitMaskedImageInF;
   v->blitMaskedImageInD = MyPaintEngine_blitMaskedImageInD;
 
+  v->blitImagesI = MyPaintEngine_blitImagesI;
+  v->blitImagesF = MyPaintEngine_blitImagesF;
+
   // --------------------------------------------------------------------------
   // [Filter]
   // --------------------------------------------------------------------------
@@ -1179,6 +1194,11 @@ static err_t FOG_CDECL NullPaintEngine_blitMaskedImage(Painter* self, const Any*
   return ERR_RT_INVALID_STATE;
 }
 
+static err_t FOG_CDECL NullPaintEngine_blitImages(Painter* self, const Image* src, const Any* items, size_t count)
+{
+  return ERR_RT_INVALID_STATE;
+}
+
 // ============================================================================
 // [Fog::NullPaintEngine - Filter]
 // ============================================================================
@@ -1429,6 +1449,9 @@ FOG_NO_EXPORT void NullPaintEngine_init()
   v->blitMaskedImageInF = (PaintEngineVTable::BlitMaskedImageInF)NullPaintEngine_blitMaskedImage;
   v->blitMaskedImageInD = (PaintEngineVTable::BlitMaskedImageInD)NullPaintEngine_blitMaskedImage;
 
+  v->blitImagesI = (PaintEngineVTable::BlitImagesI)NullPaintEngine_blitImages;
+  v->blitImagesF = (PaintEngineVTable::BlitImagesF)NullPaintEngine_blitImages;
+
   // --------------------------------------------------------------------------
   // [Filter]
   // --------------------------------------------------------------------------
@@ -14,6 +14,7 @@
 #include <Fog/G2d/Geometry/PathStroker.h>
 #include <Fog/G2d/Geometry/Transform.h>
 #include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Painting/SpriteItem.h>
 #include <Fog/G2d/Source/Color.h>
 #include <Fog/G2d/Source/Pattern.h>
 #include <Fog/G2d/Text/Font.h>
@@ -264,6 +265,9 @@ struct FOG_NO_EXPORT PaintEngineVTable
   typedef err_t (FOG_CDECL *BlitMaskedImageInF)(Painter* self, const RectF* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment);
   typedef err_t (FOG_CDECL *BlitMaskedImageInD)(Painter* self, const RectD* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment);
 
+  typedef err_t (FOG_CDECL *BlitImagesI)(Painter* self, const Image* src, const SpriteItemI* items, size_t count);
+  typedef err_t (FOG_CDECL *BlitImagesF)(Painter* self, const Image* src, const SpriteItemF* items, size_t count);
+
   // --------------------------------------------------------------------------
   // [Funcs - Blit]
   // --------------------------------------------------------------------------
@@ -284,6 +288,9 @@ struct FOG_NO_EXPORT PaintEngineVTable
   BlitMaskedImageInF blitMaskedImageInF;
   BlitMaskedImageInD blitMaskedImageInD;
 
+  BlitImagesI blitImagesI;
+  BlitImagesF blitImagesF;
+
   // --------------------------------------------------------------------------
   // [Types - Filter]
   // --------------------------------------------------------------------------
@@ -62,6 +62,47 @@ union FOG_NO_EXPORT PaintHints
 };
 #include <Fog/Core/C++/PackRestore.h>
 
+// ============================================================================
+// [Fog::PaintCacheStats]
+// ============================================================================
+
+//! @brief Statistics of a paint cache shared by all painters.
+struct FOG_NO_EXPORT PaintCacheStats
+{
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    hitCount = 0;
+    missCount = 0;
+    evictionCount = 0;
+
+    entryCount = 0;
+    memoryUsed = 0;
+    memoryLimit = 0;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of items found in the cache.
+  uint64_t hitCount;
+  //! @brief Count of items which had to be created.
+  uint64_t missCount;
+  //! @brief Count of items evicted to satisfy the memory limit.
+  uint64_t evictionCount;
+
+  //! @brief Count of items in the cache.
+  size_t entryCount;
+  //! @brief Memory used by items (in bytes).
+  size_t memoryUsed;
+  //! @brief Memory limit (in bytes).
+  size_t memoryLimit;
+};
+
 // ============================================================================
 // [Fog::PaintParamsF]
 // ============================================================================
@@ -14,6 +14,7 @@
 
 namespace Fog {
 
+FOG_NO_EXPORT void DisplayListPaintEngine_init(void);
 FOG_NO_EXPORT void NullPaintEngine_init(void);
 FOG_NO_EXPORT void RasterPaintEngine_init(void);
 
@@ -25,6 +26,7 @@ FOG_NO_EXPORT void Painter_init(void)
 {
   NullPaintEngine_init();
   RasterPaintEngine_init();
+  DisplayListPaintEngine_init();
 }
 
 } // Fog namespace
@@ -111,6 +111,16 @@ struct FOG_NO_EXPORT Painter
     fog_api.painter_beginIBits(this, &imageBits, &rect, initFlags);
   }
 
+  //! @brief Create a recording painter using the @a displayList as a
+  //! destination.
+  //!
+  //! @sa begin().
+  FOG_INLINE Painter(DisplayList& displayList, const SizeI& size, uint32_t initFlags = NO_FLAGS)
+  {
+    _engine = NULL;
+    fog_api.painter_beginDisplayList(this, &displayList, &size, initFlags);
+  }
+
   //! @brief Destroy the painter (waiting to complete all painter commands).
   //!
   //! @sa end().
@@ -155,6 +165,18 @@ struct FOG_NO_EXPORT Painter
     return fog_api.painter_beginIBits(this, &imageBits, &rect, initFlags);
   }
 
+  //! @brief Begin recording into the @a displayList.
+  //!
+  //! All painter commands are recorded and stored into the @a displayList
+  //! when @c Painter::end() is called or the painter is destroyed. The
+  //! @a size is the size of the recording surface, it's returned by the
+  //! @c PAINTER_PARAMETER_SIZE_I parameter and stored in the display-list,
+  //! but nothing is clipped to it.
+  FOG_INLINE err_t begin(DisplayList& displayList, const SizeI& size, uint32_t initFlags = NO_FLAGS)
+  {
+    return fog_api.painter_beginDisplayList(this, &displayList, &size, initFlags);
+  }
+
   //! @brief Wait for completition of all painter commands, unlock the
   //! destination image and destroy the associated painter engine.
   FOG_INLINE err_t end()
@@ -840,6 +862,106 @@ struct FOG_NO_EXPORT Painter
     return _vtable->resetParameter(this, PAINTER_PARAMETER_FILTER_SCALE_F);
   }
 
+  // --------------------------------------------------------------------------
+  // [Parameters - Caching]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get whether the stroked outlines of paths are cached.
+  FOG_INLINE err_t getStrokeCache(uint32_t& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_STROKE_CACHE_I, &val);
+  }
+
+  //! @brief Set whether the stroked outlines of paths are cached.
+  FOG_INLINE err_t setStrokeCache(uint32_t val)
+  {
+    return _vtable->setParameter(this, PAINTER_PARAMETER_STROKE_CACHE_I, &val);
+  }
+
+  //! @brief Disable caching of the stroked outlines.
+  FOG_INLINE err_t resetStrokeCache()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_STROKE_CACHE_I);
+  }
+
+  //! @brief Get the memory limit of the stroke cache (in bytes).
+  FOG_INLINE err_t getStrokeCacheLimit(uint32_t& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I, &val);
+  }
+
+  //! @brief Set the memory limit of the stroke cache (in bytes).
+  FOG_INLINE err_t setStrokeCacheLimit(uint32_t val)
+  {
+    return _vtable->setParameter(this, PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I, &val);
+  }
+
+  //! @brief Reset the memory limit of the stroke cache to the default.
+  FOG_INLINE err_t resetStrokeCacheLimit()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I);
+  }
+
+  //! @brief Get the stroke cache statistics.
+  FOG_INLINE err_t getStrokeCacheStats(PaintCacheStats& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_STROKE_CACHE_STATS, &val);
+  }
+
+  //! @brief Clear the hit, miss and eviction counters of the stroke cache.
+  FOG_INLINE err_t resetStrokeCacheStats()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_STROKE_CACHE_STATS);
+  }
+
+  //! @brief Get whether the rasterized coverage of filled paths is cached.
+  FOG_INLINE err_t getCoverageCache(uint32_t& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_I, &val);
+  }
+
+  //! @brief Set whether the rasterized coverage of filled paths is cached.
+  FOG_INLINE err_t setCoverageCache(uint32_t val)
+  {
+    return _vtable->setParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_I, &val);
+  }
+
+  //! @brief Disable caching of the rasterized coverage.
+  FOG_INLINE err_t resetCoverageCache()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_I);
+  }
+
+  //! @brief Get the memory limit of the coverage cache (in bytes).
+  FOG_INLINE err_t getCoverageCacheLimit(uint32_t& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I, &val);
+  }
+
+  //! @brief Set the memory limit of the coverage cache (in bytes).
+  FOG_INLINE err_t setCoverageCacheLimit(uint32_t val)
+  {
+    return _vtable->setParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I, &val);
+  }
+
+  //! @brief Reset the memory limit of the coverage cache to the default.
+  FOG_INLINE err_t resetCoverageCacheLimit()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I);
+  }
+
+  //! @brief Get the coverage cache statistics.
+  FOG_INLINE err_t getCoverageCacheStats(PaintCacheStats& val) const
+  {
+    return _vtable->getParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_STATS, &val);
+  }
+
+  //! @brief Clear the hit, miss and eviction counters of the coverage cache.
+  FOG_INLINE err_t resetCoverageCacheStats()
+  {
+    return _vtable->resetParameter(this, PAINTER_PARAMETER_COVERAGE_CACHE_STATS);
+  }
+
   // --------------------------------------------------------------------------
   // [Source - Type]
   // --------------------------------------------------------------------------
@@ -1338,6 +1460,15 @@ struct FOG_NO_EXPORT Painter
   FOG_INLINE err_t blitMaskedImage(const RectF& r, const Image& src, const Image& mask, const RectI& sFragment, const RectI& mFragment) { return _vtable->blitMaskedImageInF(this, &r, &src, &mask, &sFragment, &mFragment); }
   FOG_INLINE err_t blitMaskedImage(const RectD& r, const Image& src, const Image& mask, const RectI& sFragment, const RectI& mFragment) { return _vtable->blitMaskedImageInD(this, &r, &src, &mask, &sFragment, &mFragment); }
 
+  //! @brief Blit @a count fragments of @a src (atlas) described by @a items.
+  //!
+  //! The result is the same as calling @ref blitImage() for each item (with
+  //! the opacity multiplied by the item opacity), but all items are clipped
+  //! and blitted in one pass, avoiding the per-call overhead.
+  FOG_INLINE err_t blitImages(const Image& src, const SpriteItemI* items, size_t count) { return _vtable->blitImagesI(this, &src, items, count); }
+  //! @overload
+  FOG_INLINE err_t blitImages(const Image& src, const SpriteItemF* items, size_t count) { return _vtable->blitImagesF(this, &src, items, count); }
+
   // --------------------------------------------------------------------------
   // [Filter]
   // --------------------------------------------------------------------------
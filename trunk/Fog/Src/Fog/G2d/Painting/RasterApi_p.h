@@ -43,6 +43,15 @@ struct BoxRasterizer16;
 struct PathRasterizer8;
 struct PathRasterizer16;
 
+struct MaskRasterizer8;
+struct HairlineRasterizer8;
+struct CoverageRasterizer8;
+
+struct RasterClipMask;
+struct RasterClipMaskBuilder;
+
+struct RasterCoverage;
+
 struct RasterFiller;
 struct RasterScanline8;
 struct RasterScanline16;
@@ -187,6 +196,16 @@ typedef void (FOG_FASTCALL *RasterPatternFetchFunc)(
 typedef void (FOG_FASTCALL *RasterPatternSkipFunc)(
   RasterPatternFetcher* fetcher, int step);
 
+// ============================================================================
+// [Fog::Raster - TypeDefs - Pattern - Fused]
+// ============================================================================
+
+//! @internal
+typedef void (FOG_FASTCALL *RasterPatternFusedFunc)(
+  RasterPatternFetcher* fetcher, uint8_t* dst,
+  const RasterSpan* span,
+  const RasterClosure* closure);
+
 // ============================================================================
 // [Fog::Raster - TypeDefs - Pattern - Gradient]
 // ============================================================================
@@ -383,6 +402,26 @@ struct FOG_NO_EXPORT RasterGradientFuncs
   } rectangular;
 };
 
+// ============================================================================
+// [Fog::RasterFusedFuncs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch-and-composite functions.
+//!
+//! Each function fetches the pattern and composites it into the destination
+//! in one pass (without the intermediate buffer). The last index is one of
+//! @c RASTER_FUSED values, @c NULL means that the fused function is not
+//! available and the pattern must be fetched and composited separately.
+struct FOG_NO_EXPORT RasterFusedFuncs
+{
+  RasterPatternFusedFunc gradient_linear_simple_nearest[GRADIENT_SPREAD_COUNT][RASTER_FUSED_COUNT];
+
+  RasterPatternFusedFunc texture_simple_align[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT][RASTER_FUSED_COUNT];
+  RasterPatternFusedFunc texture_affine_bilinear[IMAGE_FORMAT_COUNT][TEXTURE_TILE_COUNT][RASTER_FUSED_COUNT];
+};
+
 // ============================================================================
 // [Fog::RasterFilterFuncs]
 // ============================================================================
@@ -556,6 +595,7 @@ struct FOG_NO_EXPORT ApiRaster
   RasterSolidFuncs solid;
   RasterTextureFuncs texture;
   RasterGradientFuncs gradient;
+  RasterFusedFuncs fused;
 
   RasterFilterFuncs filter;
 };
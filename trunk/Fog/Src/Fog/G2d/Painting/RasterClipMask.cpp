@@ -0,0 +1,335 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Painting/RasterClipMask_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterClipMask - Create / Destroy]
+// ============================================================================
+
+RasterClipMask* RasterClipMask::create(const BoxI& sceneBox)
+{
+  FOG_ASSERT(sceneBox.isValid());
+
+  int w = sceneBox.getWidth();
+  int h = sceneBox.getHeight();
+
+  // The largest allocation is a full-width AX_EXTRA mask, the node must be
+  // able to hold it.
+  uint32_t nodeSize = Math::max<uint32_t>(16300, (uint32_t)w * 2 + 256);
+
+  void* p = MemMgr::alloc(sizeof(RasterClipMask));
+  if (FOG_IS_NULL(p))
+    return NULL;
+
+  RasterSpan8** rows = reinterpret_cast<RasterSpan8**>(
+    MemMgr::calloc((size_t)h * sizeof(RasterSpan8*)));
+
+  if (FOG_IS_NULL(rows))
+  {
+    MemMgr::free(p);
+    return NULL;
+  }
+
+  RasterClipMask* mask = fog_new_p(p) RasterClipMask(nodeSize);
+  mask->_reference.init(1);
+  mask->_id = 0;
+  mask->_sceneBox = sceneBox;
+  mask->_boundingBox = sceneBox;
+  mask->_rowsStorage = rows;
+  mask->_rowsAdjusted = rows - sceneBox.y0;
+  return mask;
+}
+
+RasterClipMask* RasterClipMask::copy(const RasterClipMask* other, const BoxI& box)
+{
+  RasterClipMask* mask = create(other->_sceneBox);
+  if (FOG_IS_NULL(mask))
+    return NULL;
+
+  BoxI clip;
+  if (!BoxI::intersect(clip, other->_boundingBox, box))
+  {
+    mask->_boundingBox.reset();
+    return mask;
+  }
+
+  RasterSpan8* const* src = other->_rowsAdjusted;
+  RasterSpan8** dst = mask->_rowsAdjusted;
+
+  for (int y = clip.y0; y < clip.y1; y++)
+  {
+    if (src[y] == NULL)
+      continue;
+
+    RasterSpan8* row = mask->_copySpans(src[y], clip.x0, clip.x1);
+    if (FOG_UNLIKELY(row == (RasterSpan8*)-1))
+    {
+      destroy(mask);
+      return NULL;
+    }
+
+    dst[y] = row;
+  }
+
+  mask->_boundingBox = clip;
+  mask->updateBoundingBox();
+  return mask;
+}
+
+void RasterClipMask::destroy(RasterClipMask* mask)
+{
+  MemMgr::free(mask->_rowsStorage);
+
+  mask->~RasterClipMask();
+  MemMgr::free(mask);
+}
+
+// ============================================================================
+// [Fog::RasterClipMask - Ops]
+// ============================================================================
+
+void RasterClipMask::intersect(const BoxI& box)
+{
+  FOG_ASSERT(isDetached());
+
+  if (!_boundingBox.isValid())
+    return;
+
+  BoxI clip;
+  if (!BoxI::intersect(clip, _boundingBox, box))
+  {
+    for (int y = _boundingBox.y0; y < _boundingBox.y1; y++)
+      _rowsAdjusted[y] = NULL;
+
+    _boundingBox.reset();
+    return;
+  }
+
+  int y;
+  for (y = _boundingBox.y0; y < clip.y0; y++)
+    _rowsAdjusted[y] = NULL;
+
+  for (y = clip.y1; y < _boundingBox.y1; y++)
+    _rowsAdjusted[y] = NULL;
+
+  // Nothing to do if the clip-box contains all spans horizontally.
+  if (clip.x0 > _boundingBox.x0 || clip.x1 < _boundingBox.x1)
+  {
+    for (y = clip.y0; y < clip.y1; y++)
+    {
+      RasterSpan8* span = _rowsAdjusted[y];
+
+      // Skip spans before the clip-box.
+      while (span != NULL && span->getX1() <= clip.x0)
+        span = span->getNext();
+
+      if (span == NULL || span->getX0() >= clip.x1)
+      {
+        _rowsAdjusted[y] = NULL;
+        continue;
+      }
+
+      // Clip the first span.
+      int x0 = span->getX0();
+      if (x0 < clip.x0)
+      {
+        if (span->isVariant())
+          span->setVariantMask(span->getVariantMask() + RasterSpan8::getMaskAdvance(span->getType(), clip.x0 - x0));
+        span->setX0(clip.x0);
+      }
+
+      _rowsAdjusted[y] = span;
+
+      // Clip the last span.
+      RasterSpan8* last = span;
+      while (last->getNext() != NULL && last->getNext()->getX0() < clip.x1)
+        last = last->getNext();
+
+      if (last->getX1() > clip.x1)
+        last->setX1(clip.x1);
+      last->setNext(NULL);
+    }
+  }
+
+  _boundingBox = clip;
+  updateBoundingBox();
+}
+
+void RasterClipMask::updateBoundingBox()
+{
+  if (!_boundingBox.isValid())
+    return;
+
+  int bx0 = INT_MAX;
+  int by0 = INT_MAX;
+  int bx1 = INT_MIN;
+  int by1 = INT_MIN;
+
+  for (int y = _boundingBox.y0; y < _boundingBox.y1; y++)
+  {
+    RasterSpan8* span = _rowsAdjusted[y];
+    if (span == NULL)
+      continue;
+
+    if (by0 == INT_MAX)
+      by0 = y;
+    by1 = y + 1;
+
+    if (span->getX0() < bx0)
+      bx0 = span->getX0();
+
+    while (span->getNext() != NULL)
+      span = span->getNext();
+
+    if (span->getX1() > bx1)
+      bx1 = span->getX1();
+  }
+
+  if (by0 == INT_MAX)
+    _boundingBox.reset();
+  else
+    _boundingBox.setBox(bx0, by0, bx1, by1);
+}
+
+RasterSpan8* RasterClipMask::_copySpans(const RasterSpan8* src, int x0, int x1)
+{
+  RasterSpan8 first;
+  RasterSpan8* dst = &first;
+
+  for (; src != NULL; src = src->getNext())
+  {
+    int sx0 = src->getX0();
+    int sx1 = src->getX1();
+
+    if (sx1 <= x0)
+      continue;
+    if (sx0 >= x1)
+      break;
+
+    int cx0 = Math::max(sx0, x0);
+    int cx1 = Math::min(sx1, x1);
+    int w = cx1 - cx0;
+
+    uint type = src->getType();
+    uint8_t* mask;
+
+    if (type == RASTER_SPAN_C)
+    {
+      uint32_t m = src->getConstMask();
+      if (m == 0)
+        continue;
+
+      mask = RasterSpan8::getPointerFromConstMask(m);
+    }
+    else
+    {
+      const uint8_t* sMask = src->getVariantMask() + RasterSpan8::getMaskAdvance(type, cx0 - sx0);
+
+      mask = reinterpret_cast<uint8_t*>(_allocator.alloc((size_t)w * 2));
+      if (FOG_IS_NULL(mask))
+        return (RasterSpan8*)-1;
+
+      switch (type)
+      {
+        case RASTER_SPAN_A8_GLYPH:
+        case RASTER_SPAN_AX_GLYPH:
+        {
+          // Convert 0..255 to 0..256, which is used by AX_EXTRA spans.
+          uint16_t* dMask = reinterpret_cast<uint16_t*>(mask);
+          for (int i = 0; i < w; i++)
+          {
+            uint32_t m = sMask[i];
+            dMask[i] = (uint16_t)(m + (m >> 7));
+          }
+          break;
+        }
+
+        case RASTER_SPAN_AX_EXTRA:
+          MemOps::copy(mask, sMask, (size_t)w * 2);
+          break;
+
+        default:
+          FOG_ASSERT_NOT_REACHED();
+      }
+
+      type = RASTER_SPAN_AX_EXTRA;
+    }
+
+    RasterSpan8* span = reinterpret_cast<RasterSpan8*>(_allocator.alloc(sizeof(RasterSpan8)));
+    if (FOG_IS_NULL(span))
+      return (RasterSpan8*)-1;
+
+    span->setPositionAndType(cx0, cx1, type);
+    span->setGenericMask(mask);
+    span->setData(NULL);
+
+    dst->setNext(span);
+    dst = span;
+  }
+
+  dst->setNext(NULL);
+  return first.getNext();
+}
+
+// ============================================================================
+// [Fog::RasterClipMaskBuilder]
+// ============================================================================
+
+static void FOG_FASTCALL RasterClipMaskBuilder_prepare(RasterFiller* _self, int y)
+{
+  RasterClipMaskBuilder* self = static_cast<RasterClipMaskBuilder*>(_self);
+  self->y = y;
+}
+
+static void FOG_FASTCALL RasterClipMaskBuilder_process(RasterFiller* _self, RasterSpan* spans)
+{
+  RasterClipMaskBuilder* self = static_cast<RasterClipMaskBuilder*>(_self);
+  RasterClipMask* mask = self->mask;
+
+  int y = self->y++;
+  FOG_ASSERT(y >= mask->_sceneBox.y0 && y < mask->_sceneBox.y1);
+
+  RasterSpan8* row = mask->_copySpans(static_cast<RasterSpan8*>(spans),
+    mask->_sceneBox.x0, mask->_sceneBox.x1);
+
+  if (FOG_UNLIKELY(row == (RasterSpan8*)-1))
+  {
+    self->error = ERR_RT_OUT_OF_MEMORY;
+    row = NULL;
+  }
+
+  mask->_rowsAdjusted[y] = row;
+}
+
+static void FOG_FASTCALL RasterClipMaskBuilder_skip(RasterFiller* _self, int step)
+{
+  RasterClipMaskBuilder* self = static_cast<RasterClipMaskBuilder*>(_self);
+  self->y += step;
+}
+
+void RasterClipMaskBuilder::init(RasterClipMask* mask)
+{
+  _prepare = RasterClipMaskBuilder_prepare;
+  _process = RasterClipMaskBuilder_process;
+  _skip = RasterClipMaskBuilder_skip;
+
+  this->mask = mask;
+  this->y = 0;
+  this->error = ERR_OK;
+}
+
+} // Fog namespace
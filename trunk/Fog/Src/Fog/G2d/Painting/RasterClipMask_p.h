@@ -0,0 +1,180 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERCLIPMASK_P_H
+#define _FOG_G2D_PAINTING_RASTERCLIPMASK_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemZoneAllocator.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/RasterStructs_p.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RasterClipMask]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Clip-mask (8-bit).
+//!
+//! Clip-mask is a compact per-scanline representation of a non-rectangular
+//! clip. Each scanline is a list of @c RasterSpan8 instances, which are
+//! always const-masks (@c RASTER_SPAN_C) or extended variant-masks
+//! (@c RASTER_SPAN_AX_EXTRA). Fully clipped scanlines are @c NULL. The mask
+//! is used by the rasterizers, see @c Rasterizer8::setClipMask(), to intersect
+//! the spans of the rendered shape before they are passed to the filler.
+//!
+//! Clip-mask is reference counted and it can be changed in place only if it's
+//! not shared. The raster paint-engine holds a reference in each saved state
+//! and in each serialized command, and creates a new mask if the shared one
+//! needs to be changed.
+struct FOG_NO_EXPORT RasterClipMask
+{
+  // --------------------------------------------------------------------------
+  // [Create / Destroy]
+  // --------------------------------------------------------------------------
+
+  //! @brief Create a new, empty, clip-mask which can hold scanlines within the
+  //! @a sceneBox.
+  static RasterClipMask* create(const BoxI& sceneBox);
+
+  //! @brief Create a copy of @a other, clipped to @a box.
+  static RasterClipMask* copy(const RasterClipMask* other, const BoxI& box);
+
+  //! @brief Destroy the clip-mask (called when the reference count reaches zero).
+  static void destroy(RasterClipMask* mask);
+
+  // --------------------------------------------------------------------------
+  // [Reference]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE RasterClipMask* addRef()
+  {
+    _reference.inc();
+    return this;
+  }
+
+  FOG_INLINE void release()
+  {
+    if (_reference.deref())
+      destroy(this);
+  }
+
+  //! @brief Get whether the clip-mask is not shared and can be changed in place.
+  FOG_INLINE bool isDetached() const
+  {
+    return _reference.get() == 1;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the clip-mask id (managed by @c RasterPaintEngine).
+  FOG_INLINE uint32_t getId() const { return _id; }
+  //! @brief Set the clip-mask id (managed by @c RasterPaintEngine).
+  FOG_INLINE void setId(uint32_t id) { _id = id; }
+
+  //! @brief Get the bounding box of all spans in the clip-mask.
+  //!
+  //! If the clip-mask is empty the bounding box is invalid.
+  FOG_INLINE const BoxI& getBoundingBox() const { return _boundingBox; }
+
+  //! @brief Get the scanlines, adjusted so the first span of the scanline @c y
+  //! is at index @c y. Only scanlines within the bounding box can be accessed.
+  FOG_INLINE RasterSpan8* const* getRows() const { return _rowsAdjusted; }
+
+  // --------------------------------------------------------------------------
+  // [Ops]
+  // --------------------------------------------------------------------------
+
+  //! @brief Intersect the clip-mask with @a box in place.
+  //!
+  //! The clip-mask must be detached, see @c isDetached().
+  void intersect(const BoxI& box);
+
+  //! @brief Compute the tight bounding box after the scanlines were changed.
+  //!
+  //! Only scanlines within the current bounding box are examined.
+  void updateBoundingBox();
+
+  //! @brief Copy spans starting at @a src into the clip-mask storage, clipping
+  //! them to [x0, x1). Returns the first copied span, @c NULL if all spans were
+  //! clipped or zero, or @c (RasterSpan8*)-1 if out of memory.
+  RasterSpan8* _copySpans(const RasterSpan8* src, int x0, int x1);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count.
+  Atomic<size_t> _reference;
+  //! @brief Clip-mask id.
+  uint32_t _id;
+
+  //! @brief Scene box (the area which can be covered by the clip-mask).
+  BoxI _sceneBox;
+  //! @brief Bounding box.
+  BoxI _boundingBox;
+
+  //! @brief Scanlines storage (from the y0 of the scene-box to y1).
+  RasterSpan8** _rowsStorage;
+  //! @brief Scanlines, adjusted by the y0 of the scene-box.
+  RasterSpan8** _rowsAdjusted;
+
+  //! @brief Zone allocator used to allocate spans and variant-masks.
+  MemZoneAllocator _allocator;
+
+private:
+  FOG_INLINE RasterClipMask(uint32_t nodeSize) : _allocator(nodeSize) {}
+  FOG_INLINE ~RasterClipMask() {}
+
+  FOG_NO_COPY(RasterClipMask)
+};
+
+// ============================================================================
+// [Fog::RasterClipMaskBuilder]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Filler which stores the scanlines produced by the rasterizer into
+//! the clip-mask.
+struct FOG_NO_EXPORT RasterClipMaskBuilder : public RasterFiller
+{
+  // --------------------------------------------------------------------------
+  // [Init]
+  // --------------------------------------------------------------------------
+
+  void init(RasterClipMask* mask);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief The clip-mask (target).
+  RasterClipMask* mask;
+  //! @brief The current scanline.
+  int y;
+  //! @brief Error (out of memory).
+  err_t error;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERCLIPMASK_P_H
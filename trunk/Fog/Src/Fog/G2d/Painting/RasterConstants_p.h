@@ -47,7 +47,19 @@ enum RASTER_CORE
   RASTER_MAX_THREADS_LIMIT = 64,
   // Maximum number of threads which may be suggested for rendering by the
   // raster painter engine.
-  RASTER_MAX_THREADS_SUGGESTED = 16
+  RASTER_MAX_THREADS_SUGGESTED = 16,
+
+  // Maximum number of commands recorded by the multithreaded paint engine
+  // before the batch is flushed automatically.
+  RASTER_MAX_BATCH_COMMANDS = 4096,
+
+  // Minimum number of commands in a batch to render it using tiles instead of
+  // bands (binning is not worth for batches containing only few commands).
+  RASTER_MIN_TILED_COMMANDS = 64,
+
+  // Tile size (in pixels) used by the tile-binned rendering.
+  RASTER_TILE_SHIFT = 6,
+  RASTER_TILE_SIZE = 1 << RASTER_TILE_SHIFT
 };
 
 // ============================================================================
@@ -354,6 +366,44 @@ enum RASTER_FORMAT
   RASTER_FORMAT_INVALID = RASTER_FORMAT_COUNT
 };
 
+// ============================================================================
+// [Fog::RASTER_FUSED]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch-and-composite function ID (destination format and
+//! compositing operator).
+enum RASTER_FUSED
+{
+  RASTER_FUSED_PRGB32_SRC = 0,
+  RASTER_FUSED_PRGB32_SRC_OVER = 1,
+  RASTER_FUSED_XRGB32_SRC = 2,
+  RASTER_FUSED_XRGB32_SRC_OVER = 3,
+
+  RASTER_FUSED_COUNT = 4
+};
+
+// ============================================================================
+// [Fog::RASTER_JIT_SOURCE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Pattern source which can be compiled by @ref RasterJit.
+enum RASTER_JIT_SOURCE
+{
+  //! @brief The pattern is not supported by the JIT.
+  RASTER_JIT_SOURCE_NONE = 0,
+
+  //! @brief Linear gradient (simple, nearest, pad).
+  RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_PAD = 1,
+  //! @brief Linear gradient (simple, nearest, repeat).
+  RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_REPEAT = 2,
+
+  RASTER_JIT_SOURCE_COUNT = 3
+};
+
 // ============================================================================
 // [Fog::RASTER_INTEGRAL_TRANSFORM]
 // ============================================================================
@@ -392,6 +442,8 @@ enum RASTER_PAINT_CMD
   RASTER_PAINT_CMD_SET_OPACITY,
   //! @brief Do 'SetOpacity' and 'SetSource(Prgb32)' commands.
   RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB32,
+  //! @brief Do 'SetOpacity' and 'SetSource(Prgb64)' commands.
+  RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64,
   //! @brief Do 'SetOpacity' and 'SetSource(PatternContext*)' commands.
   RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN,
   
@@ -412,11 +464,23 @@ enum RASTER_PAINT_CMD
   RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F,
   //! @brief Do 'FillNormalizedPathD' command.
   RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D,
+  //! @brief Do 'FillNormalizedMaskA(DstPt, Mask, MaskFragment)' command.
+  RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A,
+
+  //! @brief Do 'StrokeHairlinePathF' command.
+  RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F,
+  //! @brief Do 'StrokeHairlinePathD' command.
+  RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D,
+
+  //! @brief Do 'FillCoverage' command.
+  RASTER_PAINT_CMD_FILL_COVERAGE,
 
   //! @brief Do 'BlitNormalizedImageA(DstPt, SrcImage, NULL)' command.
   RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A,
   //! @brief Do 'BlitNormalizedImageA(DstPt, SrcImage, SrcFragment)' command.
   RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A,
+  //! @brief Do 'BlitNormalizedMaskedImageA(DstPt, SrcImage, SrcFragment, Mask, MaskFragment)' command.
+  RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A,
 
   RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I,
   RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D,
@@ -425,6 +489,8 @@ enum RASTER_PAINT_CMD
   RASTER_PAINT_CMD_SET_CLIP_BOX,
   //! @brief Do 'SetClipRegion' command.
   RASTER_PAINT_CMD_SET_CLIP_REGION,
+  //! @brief Do 'SetClipMask' command.
+  RASTER_PAINT_CMD_SET_CLIP_MASK,
 
   //! @brief Count of raster paint commands (for checking / asserts).
   RASTER_PAINT_CMD_COUNT
@@ -717,6 +783,22 @@ enum RASTER_MODE
   RASTER_MODE_COUNT = 2
 };
 
+// ============================================================================
+// [Fog::RASTER_WORK_MODE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief How the multithreaded paint engine splits the work between workers.
+enum RASTER_WORK_MODE
+{
+  //! @brief Each worker replays the whole batch into its own horizontal band.
+  RASTER_WORK_MODE_BANDS = 0,
+  //! @brief Commands are binned into @c RASTER_TILE_SIZE tiles, workers take
+  //! tiles one by one and replay only the commands which touch them.
+  RASTER_WORK_MODE_TILES = 1
+};
+
 // ============================================================================
 // [Fog::RASTER_PRECISION]
 // ============================================================================
@@ -729,6 +811,26 @@ enum RASTER_PRECISION
   RASTER_PRECISION_BOTH = 0x3
 };
 
+// ============================================================================
+// [Fog::RASTER_CACHE]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Raster paint-engine caches enabled by the user (flags).
+enum RASTER_CACHE
+{
+  RASTER_CACHE_NONE = 0x0,
+
+  //! @brief Stroked outlines of user paths are cached (see
+  //! @c RasterStrokeCache).
+  RASTER_CACHE_STROKE = 0x1,
+
+  //! @brief Rasterized coverage of filled user paths is cached (see
+  //! @c RasterCoverageCache).
+  RASTER_CACHE_COVERAGE = 0x2
+};
+
 // ============================================================================
 // [Fog::RASTER_SOURCE]
 // ============================================================================
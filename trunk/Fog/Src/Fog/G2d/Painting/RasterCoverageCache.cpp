@@ -0,0 +1,793 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Global/Private.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Geometry/PathClipper.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
+#include <Fog/G2d/Painting/RasterScanline_p.h>
+#include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/RasterStructs_p.h>
+#include <Fog/G2d/Painting/Rasterizer_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Structs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Coverage-cache key.
+template<typename NumT>
+struct FOG_NO_EXPORT RasterCoverageCache_KeyT
+{
+  enum { VALUE_COUNT = 9 };
+
+  FOG_INLINE void init(const NumT_(Path)& path, uint32_t fillRule, const BoxI& clipBox, const NumT_(Transform)& tr)
+  {
+    pathData = path._d;
+    this->fillRule = fillRule;
+    this->clipBox = clipBox;
+
+    values[0] = tr._00;
+    values[1] = tr._01;
+    values[2] = tr._02;
+    values[3] = tr._10;
+    values[4] = tr._11;
+    values[5] = tr._12;
+    values[6] = tr._20;
+    values[7] = tr._21;
+    values[8] = tr._22;
+  }
+
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    uint32_t h = HashUtil::hashPtr(pathData);
+
+    h = h * 31 + HashUtil::hashBinary(values, sizeof(values));
+    h = h * 31 + HashUtil::hashBinary(&clipBox, sizeof(BoxI));
+    h = h * 31 + fillRule;
+
+    return h ^ (h >> 16);
+  }
+
+  FOG_INLINE bool eq(const RasterCoverageCache_KeyT<NumT>& other) const
+  {
+    if (pathData != other.pathData || fillRule != other.fillRule || clipBox != other.clipBox)
+      return false;
+
+    for (uint32_t i = 0; i < VALUE_COUNT; i++)
+    {
+      if (values[i] != other.values[i])
+        return false;
+    }
+
+    return true;
+  }
+
+  //! @brief Path data (referenced if the key is stored in the cache).
+  NumT_(PathData)* pathData;
+  //! @brief Transform matrix.
+  NumT values[VALUE_COUNT];
+  //! @brief Clip-box.
+  BoxI clipBox;
+  //! @brief Fill rule.
+  uint32_t fillRule;
+};
+
+//! @internal
+//!
+//! @brief Coverage-cache entry (precision independent part).
+struct FOG_NO_EXPORT RasterCoverageCache_Entry
+{
+  //! @brief Next entry in the hash bucket.
+  RasterCoverageCache_Entry* hashNext;
+  //! @brief Previous entry in LRU list (more recently used).
+  RasterCoverageCache_Entry* prev;
+  //! @brief Next entry in LRU list (less recently used).
+  RasterCoverageCache_Entry* next;
+
+  //! @brief Hash code of the key.
+  uint32_t hashCode;
+  //! @brief Precision, see @c RASTER_PRECISION.
+  uint32_t precision;
+  //! @brief Memory accounted for this entry.
+  size_t memorySize;
+
+  //! @brief The coverage (referenced).
+  RasterCoverage* coverage;
+};
+
+//! @internal
+//!
+//! @brief Coverage-cache entry.
+template<typename NumT>
+struct FOG_NO_EXPORT RasterCoverageCache_EntryT : public RasterCoverageCache_Entry
+{
+  RasterCoverageCache_KeyT<NumT> key;
+};
+
+template<typename NumT>
+struct RasterCoverageCache_PrecisionT {};
+
+template<>
+struct RasterCoverageCache_PrecisionT<float> { enum { VALUE = RASTER_PRECISION_F }; };
+
+template<>
+struct RasterCoverageCache_PrecisionT<double> { enum { VALUE = RASTER_PRECISION_D }; };
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Global]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterCoverageCache_Global
+{
+  FOG_INLINE RasterCoverageCache_Global()
+  {
+    buckets = NULL;
+    bucketCount = 0;
+
+    first = NULL;
+    last = NULL;
+
+    stats.reset();
+    stats.memoryLimit = RASTER_COVERAGE_CACHE_DEFAULT_LIMIT;
+  }
+
+  // Critical section for accessing members.
+  Lock lock;
+
+  // Hash table (bucketCount is power of 2).
+  RasterCoverageCache_Entry** buckets;
+  uint32_t bucketCount;
+
+  // Entries sorted by the last use (most recently used first).
+  RasterCoverageCache_Entry* first;
+  RasterCoverageCache_Entry* last;
+
+  // Statistics.
+  PaintCacheStats stats;
+};
+
+static Static<RasterCoverageCache_Global> RasterCoverageCache_global;
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Recorder]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Filler which encodes the spans produced by the rasterizer into the
+//! RLE format used by @ref RasterCoverage.
+struct FOG_NO_EXPORT RasterCoverageCache_Recorder : public RasterFiller
+{
+  //! @brief Grow the data buffer so at least @a n values can be added.
+  bool grow(size_t n)
+  {
+    size_t capacity = dataCapacity;
+
+    while (capacity - dataLength < n)
+      capacity = capacity != 0 ? capacity * 2 : 1024;
+
+    uint16_t* newData = static_cast<uint16_t*>(MemMgr::realloc(data, capacity * sizeof(uint16_t)));
+    if (FOG_IS_NULL(newData))
+    {
+      error = ERR_RT_OUT_OF_MEMORY;
+      return false;
+    }
+
+    data = newData;
+    dataCapacity = capacity;
+    return true;
+  }
+
+  //! @brief Mark rows up to @a yEnd as finished.
+  FOG_INLINE void closeRows(int yEnd)
+  {
+    while (yRow < yEnd)
+      rows[++yRow - y0] = (uint32_t)dataLength;
+  }
+
+  //! @brief The first row.
+  int y0;
+  //! @brief The current row.
+  int y;
+  //! @brief The last row which offset was stored.
+  int yRow;
+  //! @brief Base of x positions.
+  int xBase;
+  //! @brief Horizontal extent of all runs.
+  int xMin, xMax;
+
+  //! @brief Recording error.
+  err_t error;
+
+  //! @brief Row offsets.
+  uint32_t* rows;
+  //! @brief Run data.
+  uint16_t* data;
+  //! @brief Length of run data.
+  size_t dataLength;
+  //! @brief Capacity of run data.
+  size_t dataCapacity;
+};
+
+static void FOG_FASTCALL RasterCoverageCache_Recorder_prepare(RasterFiller* _self, int y)
+{
+  RasterCoverageCache_Recorder* self = static_cast<RasterCoverageCache_Recorder*>(_self);
+
+  self->y = y;
+  self->closeRows(y);
+}
+
+static void FOG_FASTCALL RasterCoverageCache_Recorder_process(RasterFiller* _self, RasterSpan* _spans)
+{
+  RasterCoverageCache_Recorder* self = static_cast<RasterCoverageCache_Recorder*>(_self);
+  const RasterSpan8* span = reinterpret_cast<const RasterSpan8*>(_spans);
+
+  if (self->error != ERR_OK)
+    return;
+
+  self->closeRows(self->y);
+
+  do {
+    int x0 = span->getX0();
+    int x1 = span->getX1();
+    uint32_t w = (uint32_t)(x1 - x0);
+    uint32_t type = span->getType();
+
+    size_t n = (type == RASTER_SPAN_C) ? 3 : 2 + w;
+    if (self->dataCapacity - self->dataLength < n && !self->grow(n))
+      return;
+
+    uint16_t* p = self->data + self->dataLength;
+    p[0] = (uint16_t)(x0 - self->xBase);
+
+    if (type == RASTER_SPAN_C)
+    {
+      p[1] = (uint16_t)(w | RASTER_COVERAGE_RUN_CONST);
+      p[2] = (uint16_t)span->getConstMask();
+    }
+    else
+    {
+      // The path rasterizer never produces glyph spans.
+      FOG_ASSERT(type == RASTER_SPAN_AX_EXTRA);
+
+      p[1] = (uint16_t)w;
+      MemOps::copy(p + 2, span->getA8Extra(), w * sizeof(uint16_t));
+    }
+
+    self->dataLength += n;
+
+    if (self->xMin > x0) self->xMin = x0;
+    if (self->xMax < x1) self->xMax = x1;
+
+    span = span->getNext();
+  } while (span != NULL);
+
+  self->closeRows(++self->y);
+}
+
+static void FOG_FASTCALL RasterCoverageCache_Recorder_skip(RasterFiller* _self, int step)
+{
+  RasterCoverageCache_Recorder* self = static_cast<RasterCoverageCache_Recorder*>(_self);
+  self->y += step;
+}
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Rasterize]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Rasterize the coverage of @a path and store it to @a dst.
+//!
+//! The path is clipped and transformed the same way as it's done by the
+//! raster paint-engine, so the result is exactly the same.
+template<typename NumT>
+static err_t RasterCoverageCache_rasterizeT(RasterCoverage** dst,
+  const NumT_(Path)& path, uint32_t fillRule, const BoxI& clipBox, const NumT_(Transform)& tr,
+  PathRasterizer8* rasterizer, RasterScanline8* scanline)
+{
+  NumT_(Box) clipBoxT(clipBox);
+  NumT_(PathClipper) clipper(clipBoxT);
+  NumT_(Path) tmp;
+  NumT_(Point) pt(NumT(0.0), NumT(0.0));
+
+  const NumT_(Path)* src = &path;
+
+  switch (tr.getType())
+  {
+    case TRANSFORM_TYPE_TRANSLATION:
+      pt.set(tr._20, tr._21);
+      clipper._clipBox.translate(-tr._20, -tr._21);
+      // ... Fall through ...
+
+    case TRANSFORM_TYPE_IDENTITY:
+      switch (clipper.measurePath(path))
+      {
+        case PATH_CLIPPER_MEASURE_BOUNDED:
+          break;
+        case PATH_CLIPPER_MEASURE_UNBOUNDED:
+          FOG_RETURN_ON_ERROR(clipper.continuePath(tmp, path));
+          src = &tmp;
+          break;
+        default:
+          return ERR_GEOMETRY_INVALID;
+      }
+      break;
+
+    default:
+      FOG_RETURN_ON_ERROR(clipper.clipPath(tmp, path, tr));
+      src = &tmp;
+      break;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Rasterize]
+  // --------------------------------------------------------------------------
+
+  // Only the clip-box is used, the coverage doesn't depend on opacity and
+  // other clipping.
+  rasterizer->setSceneBox(clipBox);
+  rasterizer->setOpacity(0x100);
+  rasterizer->setFillRule(fillRule);
+
+  if (FOG_IS_ERROR(rasterizer->init()))
+    return rasterizer->getError();
+
+  rasterizer->addPath(*src, pt);
+  rasterizer->finalize();
+
+  if (FOG_IS_ERROR(rasterizer->getError()))
+    return rasterizer->getError();
+
+  // --------------------------------------------------------------------------
+  // [Record]
+  // --------------------------------------------------------------------------
+
+  BoxI box(0, 0, 0, 0);
+  if (rasterizer->isValid())
+    box = rasterizer->getBoundingBox();
+
+  int h = box.getHeight();
+
+  RasterCoverageCache_Recorder recorder;
+  recorder._prepare = RasterCoverageCache_Recorder_prepare;
+  recorder._process = RasterCoverageCache_Recorder_process;
+  recorder._skip = RasterCoverageCache_Recorder_skip;
+
+  recorder.y0 = box.y0;
+  recorder.y = box.y0;
+  recorder.yRow = box.y0;
+  recorder.xBase = clipBox.x0;
+  recorder.xMin = INT_MAX;
+  recorder.xMax = INT_MIN;
+  recorder.error = ERR_OK;
+  recorder.rows = NULL;
+  recorder.data = NULL;
+  recorder.dataLength = 0;
+  recorder.dataCapacity = 0;
+
+  recorder.rows = static_cast<uint32_t*>(MemMgr::alloc((size_t)(h + 1) * sizeof(uint32_t)));
+  if (FOG_IS_NULL(recorder.rows))
+    return ERR_RT_OUT_OF_MEMORY;
+  recorder.rows[0] = 0;
+
+  if (h > 0)
+    rasterizer->render(&recorder, scanline);
+
+  recorder.closeRows(box.y1);
+
+  // --------------------------------------------------------------------------
+  // [Create]
+  // --------------------------------------------------------------------------
+
+  err_t err = recorder.error;
+  if (err == ERR_OK)
+  {
+    size_t rowsSize = (size_t)(h + 1) * sizeof(uint32_t);
+    size_t dataSize = recorder.dataLength * sizeof(uint16_t);
+    size_t memorySize = sizeof(RasterCoverage) + rowsSize + dataSize;
+
+    RasterCoverage* coverage = static_cast<RasterCoverage*>(MemMgr::alloc(memorySize));
+    if (FOG_IS_NULL(coverage))
+    {
+      err = ERR_RT_OUT_OF_MEMORY;
+    }
+    else
+    {
+      coverage->reference.init(1);
+
+      // Empty coverage (nothing to render) has also an empty bounding box.
+      if (recorder.dataLength != 0)
+        coverage->boundingBox.setBox(recorder.xMin, box.y0, recorder.xMax, box.y1);
+      else
+        coverage->boundingBox.setBox(0, 0, 0, 0);
+
+      coverage->xBase = clipBox.x0;
+      coverage->memorySize = memorySize;
+      coverage->rows = reinterpret_cast<uint32_t*>(coverage + 1);
+      coverage->data = reinterpret_cast<uint16_t*>(reinterpret_cast<uint8_t*>(coverage->rows) + rowsSize);
+
+      MemOps::copy(coverage->rows, recorder.rows, rowsSize);
+      MemOps::copy(coverage->data, recorder.data, dataSize);
+
+      *dst = coverage;
+    }
+  }
+
+  MemMgr::free(recorder.rows);
+  if (recorder.data != NULL)
+    MemMgr::free(recorder.data);
+
+  return err;
+}
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Helpers]
+// ============================================================================
+
+template<typename NumT>
+static FOG_INLINE size_t RasterCoverageCache_getPathMemory(const NumT_(Path)& path)
+{
+  return sizeof(NumT_(PathData)) + path._d->capacity * (sizeof(NumT_(Point)) + sizeof(uint8_t));
+}
+
+static FOG_INLINE void RasterCoverageCache_touchEntry(RasterCoverageCache_Global* g, RasterCoverageCache_Entry* entry)
+{
+  if (g->first == entry)
+    return;
+
+  // Unlink.
+  entry->prev->next = entry->next;
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  // Link as first.
+  entry->prev = NULL;
+  entry->next = g->first;
+  g->first->prev = entry;
+  g->first = entry;
+}
+
+template<typename NumT>
+static void RasterCoverageCache_deleteEntryT(RasterCoverageCache_Entry* entry)
+{
+  RasterCoverageCache_EntryT<NumT>* e = static_cast<RasterCoverageCache_EntryT<NumT>*>(entry);
+
+  e->key.pathData->release();
+  e->coverage->release();
+  fog_delete(e);
+}
+
+//! @internal
+//!
+//! @brief Remove @a entry from the hash table and LRU list and delete it.
+static void RasterCoverageCache_removeEntry(RasterCoverageCache_Global* g, RasterCoverageCache_Entry* entry)
+{
+  RasterCoverageCache_Entry** pPrev = &g->buckets[entry->hashCode & (g->bucketCount - 1)];
+
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+  *pPrev = entry->hashNext;
+
+  if (entry->prev != NULL)
+    entry->prev->next = entry->next;
+  else
+    g->first = entry->next;
+
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  g->stats.entryCount--;
+  g->stats.memoryUsed -= entry->memorySize;
+
+  if (entry->precision == RASTER_PRECISION_F)
+    RasterCoverageCache_deleteEntryT<float>(entry);
+  else
+    RasterCoverageCache_deleteEntryT<double>(entry);
+}
+
+//! @internal
+//!
+//! @brief Get whether the path data of @a entry is referenced only by the
+//! cache, so the entry can never be hit again.
+static FOG_INLINE bool RasterCoverageCache_isOrphan(const RasterCoverageCache_Entry* entry)
+{
+  if (entry->precision == RASTER_PRECISION_F)
+    return static_cast<const RasterCoverageCache_EntryT<float>*>(entry)->key.pathData->reference.get() == 1;
+  else
+    return static_cast<const RasterCoverageCache_EntryT<double>*>(entry)->key.pathData->reference.get() == 1;
+}
+
+static err_t RasterCoverageCache_rehash(RasterCoverageCache_Global* g, uint32_t bucketCount)
+{
+  RasterCoverageCache_Entry** buckets = static_cast<RasterCoverageCache_Entry**>(
+    MemMgr::calloc(bucketCount * sizeof(RasterCoverageCache_Entry*)));
+
+  if (FOG_IS_NULL(buckets))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  for (uint32_t i = 0; i < g->bucketCount; i++)
+  {
+    RasterCoverageCache_Entry* entry = g->buckets[i];
+
+    while (entry != NULL)
+    {
+      RasterCoverageCache_Entry* next = entry->hashNext;
+      uint32_t index = entry->hashCode & (bucketCount - 1);
+
+      entry->hashNext = buckets[index];
+      buckets[index] = entry;
+
+      entry = next;
+    }
+  }
+
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  g->buckets = buckets;
+  g->bucketCount = bucketCount;
+  return ERR_OK;
+}
+
+//! @internal
+//!
+//! @brief Free entries which exceed the memory limit.
+//!
+//! Orphaned entries (the path was destroyed or modified by the user) are
+//! evicted first, then the least recently used ones.
+static void RasterCoverageCache_trim(RasterCoverageCache_Global* g)
+{
+  if (g->stats.memoryUsed <= g->stats.memoryLimit)
+    return;
+
+  RasterCoverageCache_Entry* entry = g->last;
+  while (entry != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterCoverageCache_Entry* prev = entry->prev;
+
+    if (RasterCoverageCache_isOrphan(entry))
+    {
+      RasterCoverageCache_removeEntry(g, entry);
+      g->stats.evictionCount++;
+    }
+
+    entry = prev;
+  }
+
+  while (g->last != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterCoverageCache_removeEntry(g, g->last);
+    g->stats.evictionCount++;
+  }
+}
+
+template<typename NumT>
+static RasterCoverageCache_EntryT<NumT>* RasterCoverageCache_findT(RasterCoverageCache_Global* g,
+  const RasterCoverageCache_KeyT<NumT>& key, uint32_t hashCode)
+{
+  if (g->bucketCount == 0)
+    return NULL;
+
+  RasterCoverageCache_Entry* entry = g->buckets[hashCode & (g->bucketCount - 1)];
+
+  while (entry != NULL)
+  {
+    if (entry->hashCode == hashCode &&
+        entry->precision == RasterCoverageCache_PrecisionT<NumT>::VALUE &&
+        static_cast<RasterCoverageCache_EntryT<NumT>*>(entry)->key.eq(key))
+    {
+      return static_cast<RasterCoverageCache_EntryT<NumT>*>(entry);
+    }
+
+    entry = entry->hashNext;
+  }
+
+  return NULL;
+}
+
+// ============================================================================
+// [Fog::RasterCoverageCache - GetCoverage]
+// ============================================================================
+
+template<typename NumT>
+static err_t RasterCoverageCache_getCoverageT(RasterCoverage** dst,
+  const NumT_(Path)& path, uint32_t fillRule, const BoxI& clipBox, const NumT_(Transform)& tr,
+  PathRasterizer8* rasterizer, RasterScanline8* scanline)
+{
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  *dst = NULL;
+
+  if (clipBox.getWidth() > RASTER_COVERAGE_CACHE_MAX_WIDTH)
+    return ERR_OK;
+
+  RasterCoverageCache_KeyT<NumT> key;
+  key.init(path, fillRule, clipBox, tr);
+
+  uint32_t hashCode = key.getHashCode();
+
+  // --------------------------------------------------------------------------
+  // [Lookup]
+  // --------------------------------------------------------------------------
+
+  {
+    AutoLock locked(g->lock);
+    RasterCoverageCache_EntryT<NumT>* entry = RasterCoverageCache_findT<NumT>(g, key, hashCode);
+
+    if (entry != NULL)
+    {
+      g->stats.hitCount++;
+      RasterCoverageCache_touchEntry(g, entry);
+
+      *dst = entry->coverage->addRef();
+      return ERR_OK;
+    }
+
+    g->stats.missCount++;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Rasterize]
+  // --------------------------------------------------------------------------
+
+  // Rasterization is done without holding the lock, other threads can use
+  // the cache meanwhile.
+  RasterCoverage* coverage = NULL;
+  FOG_RETURN_ON_ERROR(RasterCoverageCache_rasterizeT<NumT>(&coverage,
+    path, fillRule, clipBox, tr, rasterizer, scanline));
+
+  *dst = coverage;
+
+  size_t memorySize = sizeof(RasterCoverageCache_EntryT<NumT>) +
+    coverage->memorySize +
+    RasterCoverageCache_getPathMemory<NumT>(path);
+
+  // --------------------------------------------------------------------------
+  // [Insert]
+  // --------------------------------------------------------------------------
+
+  AutoLock locked(g->lock);
+
+  if (memorySize > g->stats.memoryLimit / RASTER_COVERAGE_CACHE_ENTRY_RATIO)
+    return ERR_OK;
+
+  // The same coverage could be inserted by another thread meanwhile.
+  if (RasterCoverageCache_findT<NumT>(g, key, hashCode) != NULL)
+    return ERR_OK;
+
+  // Failure to insert the coverage is not an error, it has been rasterized.
+  if (g->stats.entryCount >= g->bucketCount &&
+      RasterCoverageCache_rehash(g, g->bucketCount != 0 ? g->bucketCount * 2 : 256) != ERR_OK)
+  {
+    return ERR_OK;
+  }
+
+  RasterCoverageCache_EntryT<NumT>* entry = fog_new RasterCoverageCache_EntryT<NumT>;
+  if (FOG_IS_NULL(entry))
+    return ERR_OK;
+
+  entry->hashCode = hashCode;
+  entry->precision = RasterCoverageCache_PrecisionT<NumT>::VALUE;
+  entry->memorySize = memorySize;
+  entry->coverage = coverage->addRef();
+
+  entry->key = key;
+  entry->key.pathData->addRef();
+
+  uint32_t index = hashCode & (g->bucketCount - 1);
+  entry->hashNext = g->buckets[index];
+  g->buckets[index] = entry;
+
+  entry->prev = NULL;
+  entry->next = g->first;
+
+  if (g->first != NULL)
+    g->first->prev = entry;
+  else
+    g->last = entry;
+  g->first = entry;
+
+  g->stats.entryCount++;
+  g->stats.memoryUsed += memorySize;
+
+  RasterCoverageCache_trim(g);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterCoverageCache - Interface]
+// ============================================================================
+
+err_t RasterCoverageCache::getCoverage(RasterCoverage** dst,
+  const PathF& path, uint32_t fillRule, const BoxI& clipBox, const TransformF& tr,
+  PathRasterizer8* rasterizer, RasterScanline8* scanline)
+{
+  return RasterCoverageCache_getCoverageT<float>(dst, path, fillRule, clipBox, tr, rasterizer, scanline);
+}
+
+err_t RasterCoverageCache::getCoverage(RasterCoverage** dst,
+  const PathD& path, uint32_t fillRule, const BoxI& clipBox, const TransformD& tr,
+  PathRasterizer8* rasterizer, RasterScanline8* scanline)
+{
+  return RasterCoverageCache_getCoverageT<double>(dst, path, fillRule, clipBox, tr, rasterizer, scanline);
+}
+
+void RasterCoverageCache::getStats(PaintCacheStats& stats)
+{
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  AutoLock locked(g->lock);
+
+  stats = g->stats;
+}
+
+void RasterCoverageCache::resetStats()
+{
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.hitCount = 0;
+  g->stats.missCount = 0;
+  g->stats.evictionCount = 0;
+}
+
+void RasterCoverageCache::setMemoryLimit(size_t memoryLimit)
+{
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.memoryLimit = memoryLimit;
+  RasterCoverageCache_trim(g);
+}
+
+void RasterCoverageCache::reset()
+{
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  AutoLock locked(g->lock);
+
+  while (g->last != NULL)
+    RasterCoverageCache_removeEntry(g, g->last);
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterCoverageCache_init(void)
+{
+  RasterCoverageCache_global.init();
+}
+
+FOG_NO_EXPORT void RasterCoverageCache_fini(void)
+{
+  RasterCoverageCache::reset();
+
+  RasterCoverageCache_Global* g = &RasterCoverageCache_global;
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  RasterCoverageCache_global.destroy();
+}
+
+} // Fog namespace
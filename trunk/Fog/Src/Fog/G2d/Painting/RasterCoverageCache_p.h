@@ -0,0 +1,191 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERCOVERAGECACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERCOVERAGECACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_COVERAGE_CACHE]
+// ============================================================================
+
+enum RASTER_COVERAGE_CACHE
+{
+  //! @brief Default memory limit (in bytes), 4MB.
+  RASTER_COVERAGE_CACHE_DEFAULT_LIMIT = 4 * 1024 * 1024,
+
+  //! @brief The maximum size of a single coverage, relative to the memory
+  //! limit (coverage must be smaller than memoryLimit / N to be cached).
+  RASTER_COVERAGE_CACHE_ENTRY_RATIO = 8,
+
+  //! @brief The maximum width of the clip-box (the run position and width
+  //! must fit into 15 bits).
+  RASTER_COVERAGE_CACHE_MAX_WIDTH = 0x7FFF
+};
+
+// ============================================================================
+// [Fog::RASTER_COVERAGE_RUN]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Flags of the run width stored in @ref RasterCoverage.
+enum RASTER_COVERAGE_RUN
+{
+  //! @brief The run has a const coverage (followed by a single value).
+  RASTER_COVERAGE_RUN_CONST = 0x8000,
+  //! @brief Mask of the run width.
+  RASTER_COVERAGE_RUN_WIDTH = 0x7FFF
+};
+
+// ============================================================================
+// [Fog::RasterCoverage]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Rasterized coverage of a shape stored as RLE of 8-bit spans.
+//!
+//! Each row is a sequence of runs, the run starts with the x position
+//! (relative to @c xBase) followed by the width. The width of the const run
+//! is marked by @c RASTER_COVERAGE_RUN_CONST and followed by one coverage
+//! value, the width of the variant run is followed by coverage of each pixel
+//! (the values are stored in the same format as the @c RASTER_SPAN_AX_EXTRA
+//! mask so they can be used by spans directly). Runs are sorted and never
+//! overlap. The coverage doesn't contain opacity.
+//!
+//! The coverage is immutable and reference counted, it's shared by the cache
+//! and by the commands of multithreaded and group painting.
+struct FOG_NO_EXPORT RasterCoverage
+{
+  // --------------------------------------------------------------------------
+  // [AddRef / Release]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE RasterCoverage* addRef() const
+  {
+    reference.inc();
+    return const_cast<RasterCoverage*>(this);
+  }
+
+  FOG_INLINE void release()
+  {
+    if (reference.deref())
+      MemMgr::free(this);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the first run of the row @a y.
+  FOG_INLINE const uint16_t* getRow(int y) const
+  {
+    FOG_ASSERT(y >= boundingBox.y0 && y < boundingBox.y1);
+    return data + rows[y - boundingBox.y0];
+  }
+
+  //! @brief Get the end of the row @a y.
+  FOG_INLINE const uint16_t* getRowEnd(int y) const
+  {
+    FOG_ASSERT(y >= boundingBox.y0 && y < boundingBox.y1);
+    return data + rows[y - boundingBox.y0 + 1];
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reference count.
+  mutable Atomic<size_t> reference;
+
+  //! @brief Bounding box of all runs (x1/y1 coordinates are outside).
+  BoxI boundingBox;
+  //! @brief Base of x positions stored in runs.
+  int xBase;
+
+  //! @brief Memory used by the coverage (in bytes).
+  size_t memorySize;
+
+  //! @brief Offsets of rows in @c data (height + 1 offsets).
+  uint32_t* rows;
+  //! @brief Run data.
+  uint16_t* data;
+};
+
+// ============================================================================
+// [Fog::RasterCoverageCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Process-wide cache of rasterized coverage.
+//!
+//! The coverage is identified by the path data, fill rule, clip-box and the
+//! transform. The cache keeps a reference to the path data, so the data can't
+//! be modified in-place anymore (any change of the path detaches it and the
+//! new data pointer is never found in the cache), see @ref RasterStrokeCache.
+//!
+//! The coverage is rasterized by @ref PathRasterizer8 clipped to the clip-box
+//! only, region and mask clipping and opacity are applied when the coverage
+//! is rendered by @ref CoverageRasterizer8, so the cached coverage can be
+//! reused by painters with different clip region and opacity.
+//!
+//! The cache is limited by the memory used by the coverage. When the limit is
+//! reached the least recently used coverage is evicted (coverage of paths
+//! which were already destroyed by the user first). All methods are
+//! thread-safe.
+struct FOG_NO_EXPORT RasterCoverageCache
+{
+  //! @brief Get the coverage of @a path filled by @a fillRule, transformed by
+  //! @a tr and clipped to @a clipBox.
+  //!
+  //! If the coverage is not cached, it's rasterized by @a rasterizer, using
+  //! @a scanline as a temporary storage. The returned coverage is referenced
+  //! and must be released by the caller. The @a dst is set to @c NULL if the
+  //! coverage can't be cached (clip-box is too large).
+  static err_t getCoverage(RasterCoverage** dst,
+    const PathF& path, uint32_t fillRule, const BoxI& clipBox, const TransformF& tr,
+    PathRasterizer8* rasterizer, RasterScanline8* scanline);
+
+  //! @overload
+  static err_t getCoverage(RasterCoverage** dst,
+    const PathD& path, uint32_t fillRule, const BoxI& clipBox, const TransformD& tr,
+    PathRasterizer8* rasterizer, RasterScanline8* scanline);
+
+  //! @brief Get coverage-cache statistics.
+  static void getStats(PaintCacheStats& stats);
+
+  //! @brief Clear the hit, miss and eviction counters.
+  static void resetStats();
+
+  //! @brief Set the memory limit (in bytes).
+  static void setMemoryLimit(size_t memoryLimit);
+
+  //! @brief Remove all coverage from the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERCOVERAGECACHE_P_H
@@ -0,0 +1,605 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Painting/RasterGlyphCache_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterGlyphCache - Structs]
+// ============================================================================
+
+struct RasterGlyphCache_Page;
+
+//! @internal
+//!
+//! @brief Glyph-cache key.
+struct FOG_NO_EXPORT RasterGlyphCache_Key
+{
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    FloatBits bits;
+    uint32_t h = HashUtil::hashPtr(face);
+
+    bits.f = scale;
+    h = h * 31 + bits.u32;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+      bits.f = matrix[i];
+      h = h * 31 + bits.u32;
+    }
+
+    h = h * 31 + glyphIndex;
+    h = h * RASTER_GLYPH_CACHE_SUBPIXEL_COUNT + subX;
+
+    return h ^ (h >> 16);
+  }
+
+  FOG_INLINE bool eq(const RasterGlyphCache_Key& other) const
+  {
+    return face == other.face &&
+           scale == other.scale &&
+           matrix[0] == other.matrix[0] &&
+           matrix[1] == other.matrix[1] &&
+           matrix[2] == other.matrix[2] &&
+           matrix[3] == other.matrix[3] &&
+           glyphIndex == other.glyphIndex &&
+           subX == other.subX;
+  }
+
+  Face* face;
+  float scale;
+  float matrix[4];
+  uint32_t glyphIndex;
+  uint32_t subX;
+};
+
+//! @internal
+//!
+//! @brief Glyph-cache entry.
+struct FOG_NO_EXPORT RasterGlyphCache_Entry
+{
+  //! @brief Next entry in the hash bucket.
+  RasterGlyphCache_Entry* hashNext;
+  //! @brief Next entry in the same page.
+  RasterGlyphCache_Entry* pageNext;
+  //! @brief Page, NULL if the glyph is empty.
+  RasterGlyphCache_Page* page;
+
+  RasterGlyphCache_Key key;
+  uint32_t hashCode;
+
+  RectI fragment;
+  PointI offset;
+};
+
+//! @internal
+//!
+//! @brief Glyph-cache atlas page.
+struct FOG_NO_EXPORT RasterGlyphCache_Page
+{
+  //! @brief Previous page in LRU list (more recently used).
+  RasterGlyphCache_Page* prev;
+  //! @brief Next page in LRU list (less recently used).
+  RasterGlyphCache_Page* next;
+
+  //! @brief Entries stored in this page.
+  RasterGlyphCache_Entry* entries;
+
+  //! @brief A8 image.
+  Image image;
+
+  //! @brief Shelf allocator - current x position.
+  int shelfX;
+  //! @brief Shelf allocator - current shelf y position.
+  int shelfY;
+  //! @brief Shelf allocator - current shelf height.
+  int shelfH;
+};
+
+// ============================================================================
+// [Fog::RasterGlyphCache - Global]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterGlyphCache_Global
+{
+  FOG_INLINE RasterGlyphCache_Global()
+  {
+    buckets = NULL;
+    bucketCount = 0;
+
+    first = NULL;
+    last = NULL;
+    fill = NULL;
+
+    MemOps::zero_t<RasterGlyphCacheStats>(&stats);
+    stats.memoryLimit = RASTER_GLYPH_CACHE_DEFAULT_LIMIT;
+  }
+
+  // Critical section for accessing members.
+  Lock lock;
+
+  // Hash table (bucketCount is power of 2).
+  RasterGlyphCache_Entry** buckets;
+  uint32_t bucketCount;
+
+  // Pages sorted by the last use (most recently used first).
+  RasterGlyphCache_Page* first;
+  RasterGlyphCache_Page* last;
+  // Page used to allocate new glyphs.
+  RasterGlyphCache_Page* fill;
+
+  // Statistics.
+  RasterGlyphCacheStats stats;
+};
+
+static Static<RasterGlyphCache_Global> RasterGlyphCache_global;
+
+// ============================================================================
+// [Fog::RasterGlyphCache - Helpers]
+// ============================================================================
+
+static FOG_INLINE void RasterGlyphCache_touchPage(RasterGlyphCache_Global* g, RasterGlyphCache_Page* page)
+{
+  if (g->first == page)
+    return;
+
+  // Unlink.
+  page->prev->next = page->next;
+  if (page->next != NULL)
+    page->next->prev = page->prev;
+  else
+    g->last = page->prev;
+
+  // Link as first.
+  page->prev = NULL;
+  page->next = g->first;
+  g->first->prev = page;
+  g->first = page;
+}
+
+static void RasterGlyphCache_unlinkEntry(RasterGlyphCache_Global* g, RasterGlyphCache_Entry* entry)
+{
+  RasterGlyphCache_Entry** pPrev = &g->buckets[entry->hashCode & (g->bucketCount - 1)];
+
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+
+  *pPrev = entry->hashNext;
+  g->stats.glyphCount--;
+
+  entry->key.face->release();
+  fog_delete(entry);
+}
+
+static err_t RasterGlyphCache_rehash(RasterGlyphCache_Global* g, uint32_t bucketCount)
+{
+  RasterGlyphCache_Entry** buckets = static_cast<RasterGlyphCache_Entry**>(
+    MemMgr::calloc(bucketCount * sizeof(RasterGlyphCache_Entry*)));
+
+  if (FOG_IS_NULL(buckets))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  for (uint32_t i = 0; i < g->bucketCount; i++)
+  {
+    RasterGlyphCache_Entry* entry = g->buckets[i];
+
+    while (entry != NULL)
+    {
+      RasterGlyphCache_Entry* next = entry->hashNext;
+      uint32_t index = entry->hashCode & (bucketCount - 1);
+
+      entry->hashNext = buckets[index];
+      buckets[index] = entry;
+
+      entry = next;
+    }
+  }
+
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  g->buckets = buckets;
+  g->bucketCount = bucketCount;
+  return ERR_OK;
+}
+
+//! @internal
+//!
+//! @brief Remove all glyphs stored in @a page and make it empty.
+static void RasterGlyphCache_clearPage(RasterGlyphCache_Global* g, RasterGlyphCache_Page* page)
+{
+  RasterGlyphCache_Entry* entry = page->entries;
+
+  while (entry != NULL)
+  {
+    RasterGlyphCache_Entry* next = entry->pageNext;
+    RasterGlyphCache_unlinkEntry(g, entry);
+    entry = next;
+  }
+
+  page->entries = NULL;
+  page->shelfX = 0;
+  page->shelfY = 0;
+  page->shelfH = 0;
+}
+
+//! @internal
+//!
+//! @brief Make the page image writable.
+//!
+//! The page might be still used by a paint command (or by a caller of
+//! getGlyph()), in such case the page is copied so the user is not affected.
+static err_t RasterGlyphCache_detachPage(RasterGlyphCache_Page* page)
+{
+  if (page->image.isDetached())
+    return ERR_OK;
+
+  Image image;
+  FOG_RETURN_ON_ERROR(image.create(page->image.getSize(), IMAGE_FORMAT_A8));
+
+  const uint8_t* sPixels = page->image.getFirst();
+  ssize_t sStride = page->image.getStride();
+
+  uint8_t* dPixels = image.getFirstX();
+  ssize_t dStride = image.getStride();
+
+  int w = image.getWidth();
+  int h = image.getHeight();
+
+  for (int y = 0; y < h; y++, dPixels += dStride, sPixels += sStride)
+    MemOps::copy(dPixels, sPixels, (size_t)w);
+
+  page->image = image;
+  return ERR_OK;
+}
+
+//! @internal
+//!
+//! @brief Allocate @a w x @a h area in an atlas page.
+//!
+//! Returns the page (at the top of the LRU list) and the area position in
+//! @a pos, or @c NULL if memory allocation failed.
+static RasterGlyphCache_Page* RasterGlyphCache_allocArea(RasterGlyphCache_Global* g, int w, int h, PointI& pos)
+{
+  const int pageSize = RASTER_GLYPH_CACHE_PAGE_SIZE;
+  const size_t pageBytes = (size_t)pageSize * (size_t)pageSize;
+
+  RasterGlyphCache_Page* page = g->fill;
+
+  if (page != NULL)
+  {
+    // Start a new shelf if the glyph doesn't fit into the current one. The
+    // current shelf is always the last one so it can grow vertically.
+    if (page->shelfX + w > pageSize)
+    {
+      page->shelfY += page->shelfH;
+      page->shelfX = 0;
+      page->shelfH = 0;
+    }
+
+    if (page->shelfY + h <= pageSize)
+      goto _Found;
+  }
+
+  if (g->first != NULL && g->stats.memoryUsed + pageBytes > g->stats.memoryLimit)
+  {
+    // Evict the least recently used page and reuse it.
+    page = g->last;
+    RasterGlyphCache_clearPage(g, page);
+    g->stats.evictionCount++;
+  }
+  else
+  {
+    page = fog_new RasterGlyphCache_Page;
+    if (FOG_IS_NULL(page))
+      return NULL;
+
+    if (FOG_IS_ERROR(page->image.create(SizeI(pageSize, pageSize), IMAGE_FORMAT_A8)))
+    {
+      fog_delete(page);
+      return NULL;
+    }
+
+    page->prev = NULL;
+    page->next = g->first;
+    page->entries = NULL;
+    page->shelfX = 0;
+    page->shelfY = 0;
+    page->shelfH = 0;
+
+    if (g->first != NULL)
+      g->first->prev = page;
+    else
+      g->last = page;
+    g->first = page;
+
+    g->stats.pageCount++;
+    g->stats.memoryUsed += pageBytes;
+  }
+
+  g->fill = page;
+
+_Found:
+  RasterGlyphCache_touchPage(g, page);
+
+  pos.set(page->shelfX, page->shelfY);
+  page->shelfX += w;
+  page->shelfH = Math::max(page->shelfH, h);
+
+  return page;
+}
+
+//! @internal
+//!
+//! @brief Free all pages which exceed the memory limit.
+static void RasterGlyphCache_trim(RasterGlyphCache_Global* g)
+{
+  const size_t pageBytes = (size_t)RASTER_GLYPH_CACHE_PAGE_SIZE * (size_t)RASTER_GLYPH_CACHE_PAGE_SIZE;
+
+  while (g->last != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterGlyphCache_Page* page = g->last;
+    RasterGlyphCache_clearPage(g, page);
+
+    g->last = page->prev;
+    if (g->last != NULL)
+      g->last->next = NULL;
+    else
+      g->first = NULL;
+
+    if (g->fill == page)
+      g->fill = NULL;
+
+    g->stats.pageCount--;
+    g->stats.memoryUsed -= pageBytes;
+    g->stats.evictionCount++;
+
+    fog_delete(page);
+  }
+}
+
+// ============================================================================
+// [Fog::RasterGlyphCache - Rasterize]
+// ============================================================================
+
+static err_t RasterGlyphCache_rasterize(RasterGlyph& dst, const Font& font, uint32_t glyphIndex, uint32_t subX)
+{
+  PathF path;
+  PointF pt(float(int(subX)) / float(RASTER_GLYPH_CACHE_SUBPIXEL_COUNT), 0.0f);
+  PointF position(0.0f, 0.0f);
+
+  FOG_RETURN_ON_ERROR(font.getOutlineFromGlyphRun(path, CONTAINER_OP_REPLACE, pt, &glyphIndex, &position, 1));
+  FOG_RETURN_ON_ERROR(Image::glyphFromPath(dst.image, dst.offset, path, FILL_RULE_NON_ZERO, IMAGE_PRECISION_BYTE));
+
+  dst.fragment.setRect(0, 0, dst.image.getWidth(), dst.image.getHeight());
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterGlyphCache - Interface]
+// ============================================================================
+
+err_t RasterGlyphCache::getGlyph(RasterGlyph& dst, const Font& font, uint32_t glyphIndex, uint32_t subX)
+{
+  FOG_ASSERT(subX < RASTER_GLYPH_CACHE_SUBPIXEL_COUNT);
+
+  RasterGlyphCache_Global* g = &RasterGlyphCache_global;
+  const FontData* d = font._d;
+
+  if (FOG_IS_NULL(d->face))
+    return ERR_FONT_INVALID_FACE;
+
+  RasterGlyphCache_Key key;
+  key.face = d->face;
+  key.scale = d->scale;
+  key.matrix[0] = d->matrix._m[0];
+  key.matrix[1] = d->matrix._m[1];
+  key.matrix[2] = d->matrix._m[2];
+  key.matrix[3] = d->matrix._m[3];
+  key.glyphIndex = glyphIndex;
+  key.subX = subX;
+
+  uint32_t hashCode = key.getHashCode();
+
+  // Release the page possibly held by @a dst, so it's not copied needlessly
+  // when a new glyph is stored into it.
+  dst.image.reset();
+
+  AutoLock locked(g->lock);
+
+  // --------------------------------------------------------------------------
+  // [Lookup]
+  // --------------------------------------------------------------------------
+
+  if (g->bucketCount != 0)
+  {
+    RasterGlyphCache_Entry* entry = g->buckets[hashCode & (g->bucketCount - 1)];
+
+    while (entry != NULL)
+    {
+      if (entry->hashCode == hashCode && entry->key.eq(key))
+      {
+        g->stats.hitCount++;
+
+        if (entry->page != NULL)
+        {
+          RasterGlyphCache_touchPage(g, entry->page);
+          dst.image = entry->page->image;
+        }
+
+        dst.fragment = entry->fragment;
+        dst.offset = entry->offset;
+        return ERR_OK;
+      }
+
+      entry = entry->hashNext;
+    }
+  }
+
+  g->stats.missCount++;
+
+  // --------------------------------------------------------------------------
+  // [Rasterize]
+  // --------------------------------------------------------------------------
+
+  RasterGlyph glyph;
+  FOG_RETURN_ON_ERROR(RasterGlyphCache_rasterize(glyph, font, glyphIndex, subX));
+
+  int w = glyph.fragment.w;
+  int h = glyph.fragment.h;
+
+  // Glyphs which are too large aren't cached, use the temporary image.
+  if (w > RASTER_GLYPH_CACHE_GLYPH_SIZE || h > RASTER_GLYPH_CACHE_GLYPH_SIZE)
+  {
+    dst.image = glyph.image;
+    dst.fragment = glyph.fragment;
+    dst.offset = glyph.offset;
+    return ERR_OK;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Insert]
+  // --------------------------------------------------------------------------
+
+  if (g->stats.glyphCount >= g->bucketCount)
+    FOG_RETURN_ON_ERROR(RasterGlyphCache_rehash(g, g->bucketCount != 0 ? g->bucketCount * 2 : 256));
+
+  RasterGlyphCache_Entry* entry = fog_new RasterGlyphCache_Entry;
+  if (FOG_IS_NULL(entry))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  RasterGlyphCache_Page* page = NULL;
+  PointI pos(0, 0);
+
+  if (w != 0 && h != 0)
+  {
+    page = RasterGlyphCache_allocArea(g, w, h, pos);
+    if (FOG_IS_NULL(page))
+    {
+      fog_delete(entry);
+      return ERR_RT_OUT_OF_MEMORY;
+    }
+
+    err_t err = RasterGlyphCache_detachPage(page);
+    if (FOG_IS_ERROR(err))
+    {
+      fog_delete(entry);
+      return err;
+    }
+
+    const uint8_t* sPixels = glyph.image.getFirst();
+    ssize_t sStride = glyph.image.getStride();
+
+    uint8_t* dPixels = page->image.getFirstX() + (ssize_t)pos.y * page->image.getStride() + pos.x;
+    ssize_t dStride = page->image.getStride();
+
+    for (int y = 0; y < h; y++, dPixels += dStride, sPixels += sStride)
+      MemOps::copy(dPixels, sPixels, (size_t)w);
+
+    dst.image = page->image;
+  }
+  else
+  {
+    w = 0;
+    h = 0;
+  }
+
+  entry->page = page;
+  entry->key = key;
+  entry->key.face->addRef();
+  entry->hashCode = hashCode;
+  entry->fragment.setRect(pos.x, pos.y, w, h);
+  entry->offset = glyph.offset;
+
+  if (page != NULL)
+  {
+    entry->pageNext = page->entries;
+    page->entries = entry;
+  }
+  else
+  {
+    entry->pageNext = NULL;
+  }
+
+  uint32_t index = hashCode & (g->bucketCount - 1);
+  entry->hashNext = g->buckets[index];
+  g->buckets[index] = entry;
+  g->stats.glyphCount++;
+
+  dst.fragment = entry->fragment;
+  dst.offset = entry->offset;
+  return ERR_OK;
+}
+
+void RasterGlyphCache::getStats(RasterGlyphCacheStats& stats)
+{
+  RasterGlyphCache_Global* g = &RasterGlyphCache_global;
+  AutoLock locked(g->lock);
+
+  stats = g->stats;
+}
+
+void RasterGlyphCache::setMemoryLimit(size_t memoryLimit)
+{
+  RasterGlyphCache_Global* g = &RasterGlyphCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.memoryLimit = memoryLimit;
+  RasterGlyphCache_trim(g);
+}
+
+void RasterGlyphCache::reset()
+{
+  RasterGlyphCache_Global* g = &RasterGlyphCache_global;
+  AutoLock locked(g->lock);
+
+  size_t memoryLimit = g->stats.memoryLimit;
+  g->stats.memoryLimit = 0;
+  RasterGlyphCache_trim(g);
+  g->stats.memoryLimit = memoryLimit;
+
+  // Empty glyphs are not stored in pages.
+  for (uint32_t i = 0; i < g->bucketCount; i++)
+  {
+    while (g->buckets[i] != NULL)
+      RasterGlyphCache_unlinkEntry(g, g->buckets[i]);
+  }
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterGlyphCache_init(void)
+{
+  RasterGlyphCache_global.init();
+}
+
+FOG_NO_EXPORT void RasterGlyphCache_fini(void)
+{
+  RasterGlyphCache::reset();
+
+  RasterGlyphCache_Global* g = &RasterGlyphCache_global;
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  RasterGlyphCache_global.destroy();
+}
+
+} // Fog namespace
@@ -0,0 +1,129 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERGLYPHCACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERGLYPHCACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Geometry/Rect.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Text/Font.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_GLYPH_CACHE]
+// ============================================================================
+
+enum RASTER_GLYPH_CACHE
+{
+  //! @brief Width and height of a single atlas page.
+  RASTER_GLYPH_CACHE_PAGE_SIZE = 256,
+  //! @brief Largest glyph (width or height) which is stored in the atlas.
+  RASTER_GLYPH_CACHE_GLYPH_SIZE = 64,
+  //! @brief Count of horizontal subpixel positions (must be power of 2).
+  RASTER_GLYPH_CACHE_SUBPIXEL_COUNT = 4,
+
+  //! @brief Default memory limit (in bytes), 64 atlas pages.
+  RASTER_GLYPH_CACHE_DEFAULT_LIMIT = 64 * RASTER_GLYPH_CACHE_PAGE_SIZE * RASTER_GLYPH_CACHE_PAGE_SIZE
+};
+
+// ============================================================================
+// [Fog::RasterGlyph]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Rasterized glyph returned by @ref RasterGlyphCache::getGlyph().
+//!
+//! The @c image is an A8 atlas page (or a temporary image if the glyph is too
+//! large to be cached) and @c fragment is the area occupied by the glyph. The
+//! @c offset is the position of the top-left corner of the fragment relative
+//! to the glyph origin snapped to the pixel grid. Empty glyphs (i.e. space)
+//! have an empty @c fragment.
+//!
+//! The page is held by reference, so it's safe to use it after the cache has
+//! been unlocked. If the cache needs to write into a page which is still
+//! referenced, the page is detached (copy-on-write).
+struct FOG_NO_EXPORT RasterGlyph
+{
+  FOG_INLINE bool isEmpty() const { return fragment.w == 0; }
+
+  Image image;
+  RectI fragment;
+  PointI offset;
+};
+
+// ============================================================================
+// [Fog::RasterGlyphCacheStats]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Glyph-cache statistics.
+struct FOG_NO_EXPORT RasterGlyphCacheStats
+{
+  //! @brief Count of glyphs found in the cache.
+  uint64_t hitCount;
+  //! @brief Count of glyphs which had to be rasterized.
+  uint64_t missCount;
+  //! @brief Count of atlas pages evicted to satisfy the memory limit.
+  uint64_t evictionCount;
+
+  //! @brief Count of glyphs in the cache.
+  size_t glyphCount;
+  //! @brief Count of atlas pages.
+  size_t pageCount;
+  //! @brief Memory used by atlas pages (in bytes).
+  size_t memoryUsed;
+  //! @brief Memory limit (in bytes).
+  size_t memoryLimit;
+};
+
+// ============================================================================
+// [Fog::RasterGlyphCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Process-wide cache of rasterized glyphs.
+//!
+//! Glyphs are rasterized by @ref Image::glyphFromPath() and packed into A8
+//! atlas pages (using a simple shelf allocator). The glyph is identified by
+//! the font-face, scale, font-matrix, horizontal subpixel position and glyph
+//! index, so the cached glyph can be used only if the painter transform is
+//! translation-only; the y position is always snapped to the pixel grid.
+//!
+//! The cache is limited by the count of atlas pages. When the limit is
+//! reached the least recently used page is evicted together with all glyphs
+//! it contains, and reused. All methods are thread-safe.
+struct FOG_NO_EXPORT RasterGlyphCache
+{
+  //! @brief Get rasterized glyph @a glyphIndex of @a font at horizontal
+  //! subpixel position @a subX (0 to @c RASTER_GLYPH_CACHE_SUBPIXEL_COUNT-1).
+  static err_t getGlyph(RasterGlyph& dst, const Font& font, uint32_t glyphIndex, uint32_t subX);
+
+  //! @brief Get glyph-cache statistics.
+  static void getStats(RasterGlyphCacheStats& stats);
+
+  //! @brief Set the memory limit of atlas pages (in bytes).
+  static void setMemoryLimit(size_t memoryLimit);
+
+  //! @brief Remove all glyphs and pages from the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERGLYPHCACHE_P_H
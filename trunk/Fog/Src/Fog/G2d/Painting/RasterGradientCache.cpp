@@ -0,0 +1,371 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterGradientCache_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterGradientCache - Structs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Gradient-cache entry.
+struct FOG_NO_EXPORT RasterGradientCache_Entry
+{
+  //! @brief Next entry in the hash bucket.
+  RasterGradientCache_Entry* hashNext;
+  //! @brief Previous entry in LRU list (more recently used).
+  RasterGradientCache_Entry* prev;
+  //! @brief Next entry in LRU list (less recently used).
+  RasterGradientCache_Entry* next;
+
+  //! @brief Hash code of the key.
+  uint32_t hashCode;
+  //! @brief Memory accounted for this entry.
+  size_t memorySize;
+
+  //! @brief Color-stops (key).
+  ColorStopList stops;
+  //! @brief Color-table (referenced), format and length are part of the key.
+  ColorStopCache* cache;
+};
+
+// ============================================================================
+// [Fog::RasterGradientCache - Global]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterGradientCache_Global
+{
+  FOG_INLINE RasterGradientCache_Global()
+  {
+    buckets = NULL;
+    bucketCount = 0;
+
+    first = NULL;
+    last = NULL;
+
+    stats.reset();
+    stats.memoryLimit = RASTER_GRADIENT_CACHE_DEFAULT_LIMIT;
+  }
+
+  // Critical section for accessing members.
+  Lock lock;
+
+  // Hash table (bucketCount is power of 2).
+  RasterGradientCache_Entry** buckets;
+  uint32_t bucketCount;
+
+  // Entries sorted by the last use (most recently used first).
+  RasterGradientCache_Entry* first;
+  RasterGradientCache_Entry* last;
+
+  // Statistics.
+  PaintCacheStats stats;
+};
+
+static Static<RasterGradientCache_Global> RasterGradientCache_global;
+
+// ============================================================================
+// [Fog::RasterGradientCache - Helpers]
+// ============================================================================
+
+static FOG_INLINE uint32_t RasterGradientCache_getHashCode(const ColorStopList& stops, uint32_t format, uint32_t length)
+{
+  uint32_t h = HashUtil::hashBinary(stops.getList(), stops.getLength() * sizeof(ColorStop));
+
+  h = h * 31 + format;
+  h = h * 31 + length;
+
+  return h ^ (h >> 16);
+}
+
+static FOG_INLINE void RasterGradientCache_touchEntry(RasterGradientCache_Global* g, RasterGradientCache_Entry* entry)
+{
+  if (g->first == entry)
+    return;
+
+  // Unlink.
+  entry->prev->next = entry->next;
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  // Link as first.
+  entry->prev = NULL;
+  entry->next = g->first;
+  g->first->prev = entry;
+  g->first = entry;
+}
+
+//! @internal
+//!
+//! @brief Remove @a entry from the hash table and LRU list and delete it.
+static void RasterGradientCache_removeEntry(RasterGradientCache_Global* g, RasterGradientCache_Entry* entry)
+{
+  RasterGradientCache_Entry** pPrev = &g->buckets[entry->hashCode & (g->bucketCount - 1)];
+
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+  *pPrev = entry->hashNext;
+
+  if (entry->prev != NULL)
+    entry->prev->next = entry->next;
+  else
+    g->first = entry->next;
+
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  g->stats.entryCount--;
+  g->stats.memoryUsed -= entry->memorySize;
+
+  entry->cache->release();
+  fog_delete(entry);
+}
+
+static err_t RasterGradientCache_rehash(RasterGradientCache_Global* g, uint32_t bucketCount)
+{
+  RasterGradientCache_Entry** buckets = static_cast<RasterGradientCache_Entry**>(
+    MemMgr::calloc(bucketCount * sizeof(RasterGradientCache_Entry*)));
+
+  if (FOG_IS_NULL(buckets))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  for (uint32_t i = 0; i < g->bucketCount; i++)
+  {
+    RasterGradientCache_Entry* entry = g->buckets[i];
+
+    while (entry != NULL)
+    {
+      RasterGradientCache_Entry* next = entry->hashNext;
+      uint32_t index = entry->hashCode & (bucketCount - 1);
+
+      entry->hashNext = buckets[index];
+      buckets[index] = entry;
+
+      entry = next;
+    }
+  }
+
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  g->buckets = buckets;
+  g->bucketCount = bucketCount;
+  return ERR_OK;
+}
+
+//! @internal
+//!
+//! @brief Free the least recently used entries which exceed the memory limit.
+static void RasterGradientCache_trim(RasterGradientCache_Global* g)
+{
+  while (g->last != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterGradientCache_removeEntry(g, g->last);
+    g->stats.evictionCount++;
+  }
+}
+
+static RasterGradientCache_Entry* RasterGradientCache_find(RasterGradientCache_Global* g,
+  const ColorStopList& stops, uint32_t format, uint32_t length, uint32_t hashCode)
+{
+  if (g->bucketCount == 0)
+    return NULL;
+
+  RasterGradientCache_Entry* entry = g->buckets[hashCode & (g->bucketCount - 1)];
+
+  while (entry != NULL)
+  {
+    if (entry->hashCode == hashCode &&
+        entry->cache->getFormat() == format &&
+        entry->cache->getLength() == length &&
+        entry->stops.eq(stops))
+    {
+      return entry;
+    }
+
+    entry = entry->hashNext;
+  }
+
+  return NULL;
+}
+
+// ============================================================================
+// [Fog::RasterGradientCache - Interface]
+// ============================================================================
+
+ColorStopCache* RasterGradientCache::getCache(const ColorStopList& stops, uint32_t format, uint32_t length)
+{
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  uint32_t hashCode = RasterGradientCache_getHashCode(stops, format, length);
+
+  // --------------------------------------------------------------------------
+  // [Lookup]
+  // --------------------------------------------------------------------------
+
+  {
+    AutoLock locked(g->lock);
+    RasterGradientCache_Entry* entry = RasterGradientCache_find(g, stops, format, length, hashCode);
+
+    if (entry != NULL)
+    {
+      g->stats.hitCount++;
+      RasterGradientCache_touchEntry(g, entry);
+
+      return entry->cache->addRef();
+    }
+
+    g->stats.missCount++;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Interpolate]
+  // --------------------------------------------------------------------------
+
+  // Interpolation is done without holding the lock, other threads can use
+  // the cache meanwhile.
+  ColorStopCache* cache = ColorStopCache::create32(format, length);
+  if (FOG_IS_NULL(cache))
+    return NULL;
+
+  _api_raster.gradient.interpolate[format](
+    cache->getData(), length, stops.getList(), stops.getLength());
+
+  // Assign also the end point.
+  uint32_t* table = reinterpret_cast<uint32_t*>(cache->getData());
+  table[length] = table[length - 1];
+
+  size_t memorySize = sizeof(RasterGradientCache_Entry) +
+    sizeof(ColorStopCache) + (length + 1) * 4 +
+    ColorStopListData::getSizeOf(stops.getCapacity());
+
+  // --------------------------------------------------------------------------
+  // [Insert]
+  // --------------------------------------------------------------------------
+
+  AutoLock locked(g->lock);
+
+  // The same table could be inserted by another thread meanwhile, use it so
+  // all gradients share one table.
+  RasterGradientCache_Entry* entry = RasterGradientCache_find(g, stops, format, length, hashCode);
+  if (entry != NULL)
+  {
+    ColorStopCache::destroy(cache);
+    return entry->cache->addRef();
+  }
+
+  if (memorySize > g->stats.memoryLimit)
+    return cache;
+
+  // Failure to insert the table is not an error, it has been interpolated.
+  if (g->stats.entryCount >= g->bucketCount &&
+      RasterGradientCache_rehash(g, g->bucketCount != 0 ? g->bucketCount * 2 : 64) != ERR_OK)
+  {
+    return cache;
+  }
+
+  entry = fog_new RasterGradientCache_Entry;
+  if (FOG_IS_NULL(entry))
+    return cache;
+
+  entry->hashCode = hashCode;
+  entry->memorySize = memorySize;
+  entry->stops = stops;
+  entry->cache = cache->addRef();
+
+  uint32_t index = hashCode & (g->bucketCount - 1);
+  entry->hashNext = g->buckets[index];
+  g->buckets[index] = entry;
+
+  entry->prev = NULL;
+  entry->next = g->first;
+
+  if (g->first != NULL)
+    g->first->prev = entry;
+  else
+    g->last = entry;
+  g->first = entry;
+
+  g->stats.entryCount++;
+  g->stats.memoryUsed += memorySize;
+
+  RasterGradientCache_trim(g);
+  return cache;
+}
+
+void RasterGradientCache::getStats(PaintCacheStats& stats)
+{
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  AutoLock locked(g->lock);
+
+  stats = g->stats;
+}
+
+void RasterGradientCache::resetStats()
+{
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.hitCount = 0;
+  g->stats.missCount = 0;
+  g->stats.evictionCount = 0;
+}
+
+void RasterGradientCache::setMemoryLimit(size_t memoryLimit)
+{
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.memoryLimit = memoryLimit;
+  RasterGradientCache_trim(g);
+}
+
+void RasterGradientCache::reset()
+{
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  AutoLock locked(g->lock);
+
+  while (g->last != NULL)
+    RasterGradientCache_removeEntry(g, g->last);
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterGradientCache_init(void)
+{
+  RasterGradientCache_global.init();
+}
+
+FOG_NO_EXPORT void RasterGradientCache_fini(void)
+{
+  RasterGradientCache::reset();
+
+  RasterGradientCache_Global* g = &RasterGradientCache_global;
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  RasterGradientCache_global.destroy();
+}
+
+} // Fog namespace
@@ -0,0 +1,77 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Source/ColorStopCache.h>
+#include <Fog/G2d/Source/ColorStopList.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_GRADIENT_CACHE]
+// ============================================================================
+
+enum RASTER_GRADIENT_CACHE
+{
+  //! @brief Default memory limit (in bytes), 1MB.
+  RASTER_GRADIENT_CACHE_DEFAULT_LIMIT = 1024 * 1024
+};
+
+// ============================================================================
+// [Fog::RasterGradientCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Process-wide cache of gradient color-tables.
+//!
+//! The color-table (@ref ColorStopCache) is identified by the content of the
+//! color-stop list, the format and length of the table, so gradients created
+//! from different @ref ColorStopList instances share the same table if their
+//! stops are equal. The table depends neither on the gradient type nor on
+//! the spread.
+//!
+//! The tables are immutable and reference counted. The cache keeps reference
+//! to the tables and to the color-stop lists (the list is never modified
+//! in-place, it's detached instead). When the memory limit is reached the
+//! least recently used table is evicted. All methods are thread-safe.
+struct FOG_NO_EXPORT RasterGradientCache
+{
+  //! @brief Get the color-table of @a stops in @a format having @a length
+  //! elements.
+  //!
+  //! If the table is not cached it's interpolated and added to the cache. The
+  //! returned table is referenced and must be released by the caller, @c NULL
+  //! is returned if memory allocation failed.
+  static ColorStopCache* getCache(const ColorStopList& stops, uint32_t format, uint32_t length);
+
+  //! @brief Get gradient-cache statistics.
+  static void getStats(PaintCacheStats& stats);
+
+  //! @brief Clear the hit, miss and eviction counters.
+  static void resetStats();
+
+  //! @brief Set the memory limit (in bytes).
+  static void setMemoryLimit(size_t memoryLimit);
+
+  //! @brief Remove all tables from the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERGRADIENTCACHE_P_H
@@ -0,0 +1,167 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterInit_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeExt_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrc_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeSrcOver_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientLinear_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_AVX2/TextureAffine_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+// The AVX2 initializer is called after the SSE2 one and overrides only the
+// functions implemented here, everything else stays SSE2 (or C).
+FOG_NO_EXPORT void RasterOps_init_AVX2(void)
+{
+  ApiRaster& api = _api_raster;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Src]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC];
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrc::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrc::prgb32_cblit_prgb32_span);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrc::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrc::prgb32_vblit_prgb32_span);
+  }
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_CORE_SRC];
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrc::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrc::prgb32_cblit_prgb32_span);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - SrcOver]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_CORE_SRC_OVER];
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrcOver::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrcOver::prgb32_cblit_prgb32_span);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrcOver::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrcOver::prgb32_vblit_prgb32_span);
+  }
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_XRGB32][RASTER_COMPOSITE_CORE_SRC_OVER];
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrcOver::prgb32_cblit_prgb32_line);
+    FOG_RASTER_SKIP(cblit_line[RASTER_CBLIT_XRGB     ]);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_AVX2::CompositeSrcOver::prgb32_cblit_prgb32_span);
+    FOG_RASTER_SKIP(cblit_span[RASTER_CBLIT_XRGB     ]);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrcOver::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_AVX2::CompositeSrcOver::prgb32_vblit_prgb32_span);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Plus - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeExtFuncs& funcs = api.compositeExt[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_EXT_PLUS];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositePlus::prgb32_cblit_prgb32_line);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositePlus::prgb32_cblit_prgb32_span);
+
+    FOG_RASTER_INIT(vblit_line[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositePlus::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositePlus::prgb32_vblit_prgb32_span);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Multiply - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeExtFuncs& funcs = api.compositeExt[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_EXT_MULTIPLY];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositeMultiply::prgb32_cblit_prgb32_line);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositeMultiply::prgb32_cblit_prgb32_span);
+
+    FOG_RASTER_INIT(vblit_line[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositeMultiply::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositeMultiply::prgb32_vblit_prgb32_span);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Screen - PRGB32]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeExtFuncs& funcs = api.compositeExt[IMAGE_FORMAT_PRGB32][RASTER_COMPOSITE_EXT_SCREEN];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositeScreen::prgb32_cblit_prgb32_line);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB             ], RasterOps_AVX2::CompositeScreen::prgb32_cblit_prgb32_span);
+
+    FOG_RASTER_INIT(vblit_line[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositeScreen::prgb32_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_PRGB32_AND_PRGB32], RasterOps_AVX2::CompositeScreen::prgb32_vblit_prgb32_span);
+  }
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Gradient - API]
+  // --------------------------------------------------------------------------
+
+  RasterGradientFuncs& gradient = api.gradient;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Gradient - Interpolate]
+  // --------------------------------------------------------------------------
+
+  gradient.interpolate[IMAGE_FORMAT_PRGB32] = RasterOps_AVX2::PGradientBase::interpolate_prgb32;
+  gradient.interpolate[IMAGE_FORMAT_XRGB32] = RasterOps_AVX2::PGradientBase::interpolate_prgb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Gradient - Linear]
+  // --------------------------------------------------------------------------
+
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_PRGB32][GRADIENT_SPREAD_PAD    ] = RasterOps_AVX2::PGradientLinear::fetch_simple_nearest_pad_prgb32;
+  gradient.linear.fetch_simple_nearest[IMAGE_FORMAT_XRGB32][GRADIENT_SPREAD_PAD    ] = RasterOps_AVX2::PGradientLinear::fetch_simple_nearest_pad_prgb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Texture - API]
+  // --------------------------------------------------------------------------
+
+  RasterTextureFuncs& texture = api.texture;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Texture - Affine]
+  // --------------------------------------------------------------------------
+
+  texture.prgb32.fetch_affine_nearest [IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD    ] = RasterOps_AVX2::PTextureAffine::fetch_affine_nearest_pad<IMAGE_FORMAT_PRGB32>;
+  texture.prgb32.fetch_affine_nearest [IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD    ] = RasterOps_AVX2::PTextureAffine::fetch_affine_nearest_pad<IMAGE_FORMAT_XRGB32>;
+}
+
+} // Fog namespace
@@ -23,9 +23,11 @@
 #include <Fog/G2d/Painting/RasterOps_C/CompositeBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeClear_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeExt_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeFused_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeNop_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeSrc_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeWide_p.h>
 
 #include <Fog/G2d/Painting/RasterOps_C/GradientBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/GradientConical_p.h>
@@ -57,6 +59,75 @@
 
 namespace Fog {
 
+// ============================================================================
+// [Helpers - Wide]
+// ============================================================================
+
+// The 16-bit per component compositing is template based, the helpers below
+// are used to register all combinations of destination and source formats.
+
+template<typename WideOp, typename DstF>
+static void RasterOps_initWideCore(RasterCompositeCoreFuncs& funcs)
+{
+  using namespace RasterOps_C;
+
+  FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], (CompositeWideCBlit<WideOp, DstF>::line));
+  FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_XRGB     ], (CompositeWideCBlit<WideOp, DstF>::line));
+
+  FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], (CompositeWideCBlit<WideOp, DstF>::span));
+  FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_XRGB     ], (CompositeWideCBlit<WideOp, DstF>::span));
+
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_PRGB32>::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_XRGB32   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_XRGB32>::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB24    ], (CompositeWideVBlit<WideOp, DstF, WideSrc_RGB24 >::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A8       ], (CompositeWideVBlit<WideOp, DstF, WideSrc_A8    >::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_I8       ], (CompositeWideVBlit<WideOp, DstF, WideSrc_I8    >::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_PRGB64>::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_RGB48    ], (CompositeWideVBlit<WideOp, DstF, WideSrc_RGB48 >::line));
+  FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_A16      ], (CompositeWideVBlit<WideOp, DstF, WideSrc_A16   >::line));
+
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_PRGB32>::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_XRGB32   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_XRGB32>::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_RGB24    ], (CompositeWideVBlit<WideOp, DstF, WideSrc_RGB24 >::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_A8       ], (CompositeWideVBlit<WideOp, DstF, WideSrc_A8    >::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_I8       ], (CompositeWideVBlit<WideOp, DstF, WideSrc_I8    >::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB64   ], (CompositeWideVBlit<WideOp, DstF, WideSrc_PRGB64>::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_RGB48    ], (CompositeWideVBlit<WideOp, DstF, WideSrc_RGB48 >::span));
+  FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_A16      ], (CompositeWideVBlit<WideOp, DstF, WideSrc_A16   >::span));
+}
+
+// Source formats of the extended operators are given by _raster_compatibleFormat,
+// there are always three (the same ids are used by PRGB64 and RGB48).
+template<typename WideOp, typename DstF, typename Src0F, typename Src1F, typename Src2F>
+static void RasterOps_initWideExt(RasterCompositeExtFuncs& funcs)
+{
+  using namespace RasterOps_C;
+
+  FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], (CompositeWideCBlit<WideOp, DstF>::line));
+  FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_XRGB     ], (CompositeWideCBlit<WideOp, DstF>::line));
+
+  FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], (CompositeWideCBlit<WideOp, DstF>::span));
+  FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_XRGB     ], (CompositeWideCBlit<WideOp, DstF>::span));
+
+  FOG_RASTER_INIT(vblit_line[0                     ], (CompositeWideVBlit<WideOp, DstF, Src0F>::line));
+  FOG_RASTER_INIT(vblit_line[1                     ], (CompositeWideVBlit<WideOp, DstF, Src1F>::line));
+  FOG_RASTER_INIT(vblit_line[2                     ], (CompositeWideVBlit<WideOp, DstF, Src2F>::line));
+
+  FOG_RASTER_INIT(vblit_span[0                     ], (CompositeWideVBlit<WideOp, DstF, Src0F>::span));
+  FOG_RASTER_INIT(vblit_span[1                     ], (CompositeWideVBlit<WideOp, DstF, Src1F>::span));
+  FOG_RASTER_INIT(vblit_span[2                     ], (CompositeWideVBlit<WideOp, DstF, Src2F>::span));
+}
+
+template<typename WideOp>
+static void RasterOps_initWideExtAll(ApiRaster& api, uint32_t op)
+{
+  using namespace RasterOps_C;
+
+  RasterOps_initWideExt<WideOp, WideDst_PRGB64, WideSrc_PRGB64, WideSrc_RGB48, WideSrc_PRGB32>(api.compositeExt[IMAGE_FORMAT_PRGB64][op]);
+  RasterOps_initWideExt<WideOp, WideDst_RGB48 , WideSrc_PRGB64, WideSrc_RGB48, WideSrc_PRGB32>(api.compositeExt[IMAGE_FORMAT_RGB48 ][op]);
+  RasterOps_initWideExt<WideOp, WideDst_A16   , WideSrc_PRGB64, WideSrc_A16  , WideSrc_A8    >(api.compositeExt[IMAGE_FORMAT_A16   ][op]);
+}
+
 // ============================================================================
 // [Init / Fini]
 // ============================================================================
@@ -1566,6 +1637,31 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
     FOG_RASTER_INIT(vblit_span[RASTER_VBLIT_XRGB32_AND_RGB24 ], RasterOps_C::CompositeExclusion::xrgb32_vblit_rgb24_span);
   }
 
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - Wide (PRGB64, RGB48, A16)]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  RasterOps_initWideCore<RasterOps_C::WideOp_Src    , RasterOps_C::WideDst_PRGB64>(api.compositeCore[IMAGE_FORMAT_PRGB64][RASTER_COMPOSITE_CORE_SRC     ]);
+  RasterOps_initWideCore<RasterOps_C::WideOp_Src    , RasterOps_C::WideDst_RGB48 >(api.compositeCore[IMAGE_FORMAT_RGB48 ][RASTER_COMPOSITE_CORE_SRC     ]);
+  RasterOps_initWideCore<RasterOps_C::WideOp_Src    , RasterOps_C::WideDst_A16   >(api.compositeCore[IMAGE_FORMAT_A16   ][RASTER_COMPOSITE_CORE_SRC     ]);
+
+  RasterOps_initWideCore<RasterOps_C::WideOp_SrcOver, RasterOps_C::WideDst_PRGB64>(api.compositeCore[IMAGE_FORMAT_PRGB64][RASTER_COMPOSITE_CORE_SRC_OVER]);
+  RasterOps_initWideCore<RasterOps_C::WideOp_SrcOver, RasterOps_C::WideDst_RGB48 >(api.compositeCore[IMAGE_FORMAT_RGB48 ][RASTER_COMPOSITE_CORE_SRC_OVER]);
+  RasterOps_initWideCore<RasterOps_C::WideOp_SrcOver, RasterOps_C::WideDst_A16   >(api.compositeCore[IMAGE_FORMAT_A16   ][RASTER_COMPOSITE_CORE_SRC_OVER]);
+
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_SrcIn  >(api, RASTER_COMPOSITE_EXT_SRC_IN  );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_SrcOut >(api, RASTER_COMPOSITE_EXT_SRC_OUT );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_SrcAtop>(api, RASTER_COMPOSITE_EXT_SRC_ATOP);
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_DstOver>(api, RASTER_COMPOSITE_EXT_DST_OVER);
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_DstIn  >(api, RASTER_COMPOSITE_EXT_DST_IN  );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_DstOut >(api, RASTER_COMPOSITE_EXT_DST_OUT );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_DstAtop>(api, RASTER_COMPOSITE_EXT_DST_ATOP);
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_Xor    >(api, RASTER_COMPOSITE_EXT_XOR     );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_Clear  >(api, RASTER_COMPOSITE_EXT_CLEAR   );
+  RasterOps_initWideExtAll<RasterOps_C::WideOp_Plus   >(api, RASTER_COMPOSITE_EXT_PLUS    );
+#endif // FOG_RASTER_INIT_C
+
   // --------------------------------------------------------------------------
   // [RasterOps - Pattern - Solid]
   // --------------------------------------------------------------------------
@@ -1878,6 +1974,68 @@ FOG_NO_EXPORT void RasterOps_init_C(void)
 
   // TODO: Texture-Projection fetcher.
 
+#endif // FOG_RASTER_INIT_C
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Fused - API]
+  // --------------------------------------------------------------------------
+
+  RasterFusedFuncs& fused = api.fused;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Fused - Gradient]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_PAD   ][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_pad   <RasterOps_C::CompositeFusedOp_PRGB32_Src>;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_PAD   ][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_pad   <RasterOps_C::CompositeFusedOp_SrcOver    >;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_PAD   ][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_pad   <RasterOps_C::CompositeFusedOp_XRGB32_Src>;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_PAD   ][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_pad   <RasterOps_C::CompositeFusedOp_SrcOver    >;
+
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_REPEAT][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_repeat<RasterOps_C::CompositeFusedOp_PRGB32_Src>;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_REPEAT][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_repeat<RasterOps_C::CompositeFusedOp_SrcOver    >;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_REPEAT][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_repeat<RasterOps_C::CompositeFusedOp_XRGB32_Src>;
+  fused.gradient_linear_simple_nearest[GRADIENT_SPREAD_REPEAT][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::gradient_linear_simple_nearest_repeat<RasterOps_C::CompositeFusedOp_SrcOver    >;
+#endif // FOG_RASTER_INIT_C
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Fused - Texture - Simple]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_pad   <RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  fused.texture_simple_align[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_simple_align_repeat<RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+#endif // FOG_RASTER_INIT_C
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Pattern - Fused - Texture - Affine]
+  // --------------------------------------------------------------------------
+
+#if defined(FOG_RASTER_INIT_C)
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_PAD   ][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_pad   <RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_PRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC_OVER] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_SrcOver    , RasterOps_C::PTextureAccessor_PRGB32_From_PRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_PRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_PRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
+  fused.texture_affine_bilinear[IMAGE_FORMAT_XRGB32][TEXTURE_TILE_REPEAT][RASTER_FUSED_XRGB32_SRC     ] = RasterOps_C::CompositeFused::texture_affine_bilinear_repeat<RasterOps_C::CompositeFusedOp_XRGB32_Src, RasterOps_C::PTextureAccessor_PRGB32_From_XRGB32>;
 #endif // FOG_RASTER_INIT_C
 
   // --------------------------------------------------------------------------
@@ -25,6 +25,9 @@
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeExt_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrc_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/CompositeSrcOver_p.h>
+#include <Fog/G2d/Painting/RasterOps_SSE2/CompositeWide_p.h>
+
+#include <Fog/G2d/Painting/RasterOps_SSE2/FilterBlur_p.h>
 
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientBase_p.h>
 #include <Fog/G2d/Painting/RasterOps_SSE2/GradientConical_p.h>
@@ -455,6 +458,23 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
   //FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_A16      ], RasterOps_SSE2::CompositeSrcOver::rgb24_vblit_a16_span);
   }
   */
+  // --------------------------------------------------------------------------
+  // [RasterOps - Composite - SrcOver - PRGB64]
+  // --------------------------------------------------------------------------
+
+  {
+    RasterCompositeCoreFuncs& funcs = api.compositeCore[IMAGE_FORMAT_PRGB64][RASTER_COMPOSITE_CORE_SRC_OVER];
+
+    FOG_RASTER_INIT(cblit_line[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_cblit_prgb64_line);
+    FOG_RASTER_INIT(cblit_span[RASTER_CBLIT_PRGB     ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_cblit_prgb64_span);
+
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_vblit_prgb32_line);
+    FOG_RASTER_INIT(vblit_line[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_vblit_prgb64_line);
+
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB32   ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_vblit_prgb32_span);
+    FOG_RASTER_INIT(vblit_span[IMAGE_FORMAT_PRGB64   ], RasterOps_SSE2::CompositeWideSrcOver::prgb64_vblit_prgb64_span);
+  }
+
   // --------------------------------------------------------------------------
   // [RasterOps - Composite - SrcOver - A8]
   // --------------------------------------------------------------------------
@@ -1546,6 +1566,43 @@ FOG_NO_EXPORT void RasterOps_init_SSE2(void)
 
   gradient.interpolate[IMAGE_FORMAT_PRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
   gradient.interpolate[IMAGE_FORMAT_XRGB32] = RasterOps_SSE2::PGradientBase::interpolate_prgb32;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - API]
+  // --------------------------------------------------------------------------
+
+  RasterFilterFuncs& filter = api.filter;
+
+  // --------------------------------------------------------------------------
+  // [RasterOps - Filter - Blur]
+  // --------------------------------------------------------------------------
+
+  filter.blur.box.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxH<RasterOps_SSE2::FBlurBoxAccessor_PRGB32>;
+  filter.blur.box.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxH<RasterOps_SSE2::FBlurBoxAccessor_XRGB32>;
+
+  filter.blur.box.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxV<RasterOps_SSE2::FBlurBoxAccessor_PRGB32>;
+  filter.blur.box.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doBoxV<RasterOps_SSE2::FBlurBoxAccessor_XRGB32>;
+  filter.blur.box.v[IMAGE_FORMAT_A8    ] = (RasterFilterDoBlurFunc)RasterOps_SSE2::FBlur::doA8V<
+    RasterOps_C::FBlur::doBoxV<RasterOps_SSE2::FBlurBoxAccessor_A8x4>,
+    RasterOps_C::FBlur::doBoxV<RasterOps_C::FBlurBoxAccessor_A8> >;
+
+  filter.blur.stack.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackH<RasterOps_SSE2::FBlurStackAccessor_PRGB32>;
+  filter.blur.stack.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackH<RasterOps_SSE2::FBlurStackAccessor_XRGB32>;
+
+  filter.blur.stack.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackV<RasterOps_SSE2::FBlurStackAccessor_PRGB32>;
+  filter.blur.stack.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doStackV<RasterOps_SSE2::FBlurStackAccessor_XRGB32>;
+  filter.blur.stack.v[IMAGE_FORMAT_A8    ] = (RasterFilterDoBlurFunc)RasterOps_SSE2::FBlur::doA8V<
+    RasterOps_C::FBlur::doStackV<RasterOps_SSE2::FBlurStackAccessor_A8x4>,
+    RasterOps_C::FBlur::doStackV<RasterOps_C::FBlurStackAccessor_A8> >;
+
+  filter.blur.exponential.h[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpH<RasterOps_SSE2::FBlurExpAccessor_PRGB32>;
+  filter.blur.exponential.h[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpH<RasterOps_SSE2::FBlurExpAccessor_XRGB32>;
+
+  filter.blur.exponential.v[IMAGE_FORMAT_PRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_SSE2::FBlurExpAccessor_PRGB32>;
+  filter.blur.exponential.v[IMAGE_FORMAT_XRGB32] = (RasterFilterDoBlurFunc)RasterOps_C::FBlur::doExpV<RasterOps_SSE2::FBlurExpAccessor_XRGB32>;
+  filter.blur.exponential.v[IMAGE_FORMAT_A8    ] = (RasterFilterDoBlurFunc)RasterOps_SSE2::FBlur::doA8V<
+    RasterOps_C::FBlur::doExpV<RasterOps_SSE2::FBlurExpAccessor_A8x4>,
+    RasterOps_C::FBlur::doExpV<RasterOps_C::FBlurExpAccessor_A8> >;
 }
 
 } // Fog namespace
@@ -0,0 +1,1322 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/G2d/Painting/RasterJit_p.h>
+#include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/RasterStructs_p.h>
+
+#if defined(FOG_RASTER_JIT) && defined(FOG_ARCH_X86_64)
+# define FOG_RASTER_JIT_X64
+
+# if defined(FOG_OS_WINDOWS)
+#  include <windows.h>
+# endif // FOG_OS_WINDOWS
+
+# if defined(FOG_OS_POSIX)
+#  include <sys/mman.h>
+#  include <sys/types.h>
+#  include <unistd.h>
+# endif // FOG_OS_POSIX
+#endif // FOG_RASTER_JIT && FOG_ARCH_X86_64
+
+namespace Fog {
+
+#if defined(FOG_RASTER_JIT_X64)
+
+// ============================================================================
+// [Fog::RasterJit - Constants]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief General purpose register IDs (x86-64 encoding).
+enum RASTER_JIT_GP
+{
+  RASTER_JIT_RAX = 0,
+  RASTER_JIT_RCX = 1,
+  RASTER_JIT_RDX = 2,
+  RASTER_JIT_RBX = 3,
+  RASTER_JIT_RSP = 4,
+  RASTER_JIT_RBP = 5,
+  RASTER_JIT_RSI = 6,
+  RASTER_JIT_RDI = 7,
+  RASTER_JIT_R8  = 8,
+  RASTER_JIT_R9  = 9,
+  RASTER_JIT_R10 = 10,
+  RASTER_JIT_R11 = 11,
+  RASTER_JIT_R12 = 12,
+  RASTER_JIT_R13 = 13,
+  RASTER_JIT_R14 = 14,
+  RASTER_JIT_R15 = 15,
+
+  RASTER_JIT_NO_REG = 0xFF
+};
+
+//! @internal
+//!
+//! @brief Condition codes (the low nibble of Jcc/CMOVcc opcodes).
+enum RASTER_JIT_CC
+{
+  RASTER_JIT_CC_B  = 0x2,
+  RASTER_JIT_CC_AE = 0x3,
+  RASTER_JIT_CC_E  = 0x4,
+  RASTER_JIT_CC_NE = 0x5,
+  RASTER_JIT_CC_BE = 0x6,
+  RASTER_JIT_CC_L  = 0xC,
+  RASTER_JIT_CC_GE = 0xD,
+  RASTER_JIT_CC_G  = 0xF
+};
+
+//! @internal
+//!
+//! @brief ALU operations (the /digit of 0x81 and 0x83 opcodes).
+enum RASTER_JIT_ALU
+{
+  RASTER_JIT_ADD = 0,
+  RASTER_JIT_OR  = 1,
+  RASTER_JIT_AND = 4,
+  RASTER_JIT_SUB = 5,
+  RASTER_JIT_XOR = 6,
+  RASTER_JIT_CMP = 7
+};
+
+//! @internal
+//!
+//! @brief Shift operations (the /digit of 0xC1 opcode).
+enum RASTER_JIT_SHIFT
+{
+  RASTER_JIT_SHL = 4,
+  RASTER_JIT_SHR = 5,
+  RASTER_JIT_SAR = 7
+};
+
+enum
+{
+  //! @brief Maximum size of a generated function.
+  RASTER_JIT_BUFFER_SIZE = 4096,
+  //! @brief Maximum count of labels in a generated function.
+  RASTER_JIT_LABEL_COUNT = 64,
+  //! @brief Maximum count of jumps in a generated function.
+  RASTER_JIT_JUMP_COUNT = 128
+};
+
+// ============================================================================
+// [Fog::RasterJit - Assembler]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Memory operand [base + index * (1 << shift) + disp].
+struct FOG_NO_EXPORT RasterJitMem
+{
+  FOG_INLINE RasterJitMem(uint32_t base, int32_t disp) :
+    base(base), index(RASTER_JIT_NO_REG), shift(0), disp(disp) {}
+
+  FOG_INLINE RasterJitMem(uint32_t base, uint32_t index, uint32_t shift, int32_t disp) :
+    base(base), index(index), shift(shift), disp(disp) {}
+
+  uint32_t base;
+  uint32_t index;
+  uint32_t shift;
+  int32_t disp;
+};
+
+//! @internal
+//!
+//! @brief Minimal x86-64 assembler, only instructions used by the raster
+//! pipelines are implemented.
+//!
+//! Instructions are emitted into a fixed buffer, if the buffer or the label
+//! table overflows the @c error flag is set and the code is discarded.
+struct FOG_NO_EXPORT RasterJitAssembler
+{
+  FOG_INLINE RasterJitAssembler() :
+    length(0),
+    labelCount(0),
+    jumpCount(0),
+    error(false)
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Emit]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void emitByte(uint32_t b)
+  {
+    if (length >= RASTER_JIT_BUFFER_SIZE) { error = true; return; }
+    buffer[length++] = (uint8_t)b;
+  }
+
+  FOG_INLINE void emitDWord(uint32_t d)
+  {
+    emitByte(d      );
+    emitByte(d >>  8);
+    emitByte(d >> 16);
+    emitByte(d >> 24);
+  }
+
+  FOG_INLINE void emitQWord(uint64_t q)
+  {
+    emitDWord((uint32_t)(q      ));
+    emitDWord((uint32_t)(q >> 32));
+  }
+
+  //! @brief Emit REX prefix (only if needed).
+  FOG_INLINE void emitRex(bool w, uint32_t reg, uint32_t index, uint32_t base)
+  {
+    uint32_t rex = ((uint32_t)w << 3) |
+                   (((reg   & 0x8) != 0) << 2) |
+                   (((index != RASTER_JIT_NO_REG && (index & 0x8) != 0)) << 1) |
+                   (((base  != RASTER_JIT_NO_REG && (base  & 0x8) != 0))     );
+    if (rex != 0)
+      emitByte(0x40 | rex);
+  }
+
+  //! @brief Emit opcode, @a op can be prefixed by 0x0F (two-byte opcode).
+  FOG_INLINE void emitOpCode(uint32_t op)
+  {
+    if (op > 0xFF)
+      emitByte(op >> 8);
+    emitByte(op & 0xFF);
+  }
+
+  FOG_INLINE void emitModReg(uint32_t reg, uint32_t rm)
+  {
+    emitByte(0xC0 | ((reg & 0x7) << 3) | (rm & 0x7));
+  }
+
+  void emitModMem(uint32_t reg, const RasterJitMem& m)
+  {
+    uint32_t base = m.base & 0x7;
+    uint32_t mod;
+
+    if (m.disp == 0 && base != RASTER_JIT_RBP)
+      mod = 0;
+    else if (m.disp >= -128 && m.disp <= 127)
+      mod = 1;
+    else
+      mod = 2;
+
+    if (m.index != RASTER_JIT_NO_REG || base == RASTER_JIT_RSP)
+    {
+      uint32_t index = (m.index != RASTER_JIT_NO_REG) ? (m.index & 0x7) : 0x4;
+
+      emitByte((mod << 6) | ((reg & 0x7) << 3) | 0x4);
+      emitByte((m.shift << 6) | (index << 3) | base);
+    }
+    else
+    {
+      emitByte((mod << 6) | ((reg & 0x7) << 3) | base);
+    }
+
+    if (mod == 1)
+      emitByte((uint32_t)m.disp);
+    else if (mod == 2)
+      emitDWord((uint32_t)m.disp);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Generic Forms]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void opRR(uint32_t op, bool w, uint32_t reg, uint32_t rm)
+  {
+    emitRex(w, reg, RASTER_JIT_NO_REG, rm);
+    emitOpCode(op);
+    emitModReg(reg, rm);
+  }
+
+  FOG_INLINE void opRM(uint32_t op, bool w, uint32_t reg, const RasterJitMem& m)
+  {
+    emitRex(w, reg, m.index, m.base);
+    emitOpCode(op);
+    emitModMem(reg, m);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Instructions - GP]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void mov32(uint32_t dst, uint32_t src) { opRR(0x8B, false, dst, src); }
+  FOG_INLINE void mov64(uint32_t dst, uint32_t src) { opRR(0x8B, true, dst, src); }
+
+  FOG_INLINE void load32(uint32_t dst, const RasterJitMem& m) { opRM(0x8B, false, dst, m); }
+  FOG_INLINE void load64(uint32_t dst, const RasterJitMem& m) { opRM(0x8B, true, dst, m); }
+  FOG_INLINE void store32(const RasterJitMem& m, uint32_t src) { opRM(0x89, false, src, m); }
+  FOG_INLINE void store64(const RasterJitMem& m, uint32_t src) { opRM(0x89, true, src, m); }
+
+  FOG_INLINE void loadU8(uint32_t dst, const RasterJitMem& m) { opRM(0x0FB6, false, dst, m); }
+  FOG_INLINE void loadU16(uint32_t dst, const RasterJitMem& m) { opRM(0x0FB7, false, dst, m); }
+
+  FOG_INLINE void lea64(uint32_t dst, const RasterJitMem& m) { opRM(0x8D, true, dst, m); }
+
+  FOG_INLINE void movImm32(uint32_t dst, uint32_t imm)
+  {
+    emitRex(false, 0, RASTER_JIT_NO_REG, dst);
+    emitByte(0xB8 + (dst & 0x7));
+    emitDWord(imm);
+  }
+
+  FOG_INLINE void movImm64(uint32_t dst, uint64_t imm)
+  {
+    emitRex(true, 0, RASTER_JIT_NO_REG, dst);
+    emitByte(0xB8 + (dst & 0x7));
+    emitQWord(imm);
+  }
+
+  //! @brief ALU operation with register (@a op is @c RASTER_JIT_ALU).
+  FOG_INLINE void alu(uint32_t op, bool w, uint32_t dst, uint32_t src)
+  {
+    opRR((op << 3) + 0x03, w, dst, src);
+  }
+
+  //! @brief ALU operation with memory (@a op is @c RASTER_JIT_ALU).
+  FOG_INLINE void alu(uint32_t op, bool w, uint32_t dst, const RasterJitMem& m)
+  {
+    opRM((op << 3) + 0x03, w, dst, m);
+  }
+
+  //! @brief ALU operation with immediate (@a op is @c RASTER_JIT_ALU).
+  FOG_INLINE void aluImm(uint32_t op, bool w, uint32_t dst, int32_t imm)
+  {
+    bool imm8 = (imm >= -128 && imm <= 127);
+
+    emitRex(w, 0, RASTER_JIT_NO_REG, dst);
+    emitByte(imm8 ? 0x83 : 0x81);
+    emitModReg(op, dst);
+
+    if (imm8)
+      emitByte((uint32_t)imm);
+    else
+      emitDWord((uint32_t)imm);
+  }
+
+  FOG_INLINE void test32(uint32_t a, uint32_t b) { opRR(0x85, false, b, a); }
+  FOG_INLINE void test64(uint32_t a, uint32_t b) { opRR(0x85, true, b, a); }
+
+  FOG_INLINE void imul32(uint32_t dst, uint32_t src) { opRR(0x0FAF, false, dst, src); }
+  FOG_INLINE void imul64(uint32_t dst, uint32_t src) { opRR(0x0FAF, true, dst, src); }
+
+  //! @brief Signed divide edx:eax by @a src (quotient in eax, remainder in edx).
+  FOG_INLINE void cdqIdiv32(uint32_t src)
+  {
+    emitByte(0x99);
+    emitRex(false, 0, RASTER_JIT_NO_REG, src);
+    emitByte(0xF7);
+    emitModReg(7, src);
+  }
+
+  //! @brief Shift by immediate (@a op is @c RASTER_JIT_SHIFT).
+  FOG_INLINE void shift(uint32_t op, bool w, uint32_t dst, uint32_t imm)
+  {
+    emitRex(w, 0, RASTER_JIT_NO_REG, dst);
+    emitByte(0xC1);
+    emitModReg(op, dst);
+    emitByte(imm);
+  }
+
+  FOG_INLINE void cmov32(uint32_t cc, uint32_t dst, uint32_t src) { opRR(0x0F40 + cc, false, dst, src); }
+
+  FOG_INLINE void push(uint32_t reg)
+  {
+    emitRex(false, 0, RASTER_JIT_NO_REG, reg);
+    emitByte(0x50 + (reg & 0x7));
+  }
+
+  FOG_INLINE void pop(uint32_t reg)
+  {
+    emitRex(false, 0, RASTER_JIT_NO_REG, reg);
+    emitByte(0x58 + (reg & 0x7));
+  }
+
+  FOG_INLINE void ret() { emitByte(0xC3); }
+
+  // --------------------------------------------------------------------------
+  // [Instructions - SSE2]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void sseRM(uint32_t prefix, uint32_t op, uint32_t xmm, const RasterJitMem& m)
+  {
+    emitByte(prefix);
+    opRM(op, false, xmm, m);
+  }
+
+  FOG_INLINE void movsdLoad(uint32_t xmm, const RasterJitMem& m) { sseRM(0xF2, 0x0F10, xmm, m); }
+  FOG_INLINE void movsdStore(const RasterJitMem& m, uint32_t xmm) { sseRM(0xF2, 0x0F11, xmm, m); }
+  FOG_INLINE void addsd(uint32_t xmm, const RasterJitMem& m) { sseRM(0xF2, 0x0F58, xmm, m); }
+
+  FOG_INLINE void mulsd(uint32_t dst, uint32_t src)
+  {
+    emitByte(0xF2);
+    opRR(0x0F59, false, dst, src);
+  }
+
+  //! @brief Move 64-bit GP register @a src to the xmm register @a dst.
+  FOG_INLINE void movq(uint32_t dst, uint32_t src)
+  {
+    emitByte(0x66);
+    opRR(0x0F6E, true, dst, src);
+  }
+
+  //! @brief Convert (truncate) the double in @a src to 32-bit integer @a dst.
+  FOG_INLINE void cvttsd2si32(uint32_t dst, uint32_t src)
+  {
+    emitByte(0xF2);
+    opRR(0x0F2C, false, dst, src);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Labels]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE uint32_t newLabel()
+  {
+    if (labelCount >= RASTER_JIT_LABEL_COUNT) { error = true; return 0; }
+
+    labels[labelCount] = -1;
+    return labelCount++;
+  }
+
+  FOG_INLINE void bind(uint32_t label)
+  {
+    labels[label] = (int)length;
+  }
+
+  FOG_INLINE void jcc(uint32_t cc, uint32_t label)
+  {
+    emitByte(0x0F);
+    emitByte(0x80 + cc);
+    addJump(label);
+  }
+
+  FOG_INLINE void jmp(uint32_t label)
+  {
+    emitByte(0xE9);
+    addJump(label);
+  }
+
+  FOG_INLINE void addJump(uint32_t label)
+  {
+    if (jumpCount >= RASTER_JIT_JUMP_COUNT) { error = true; return; }
+
+    jumps[jumpCount].offset = (int)length;
+    jumps[jumpCount].label = label;
+    jumpCount++;
+
+    emitDWord(0);
+  }
+
+  //! @brief Patch all jumps, must be called after the code is complete.
+  void link()
+  {
+    if (error)
+      return;
+
+    for (uint32_t i = 0; i < jumpCount; i++)
+    {
+      int offset = jumps[i].offset;
+      int target = labels[jumps[i].label];
+
+      if (target < 0) { error = true; return; }
+
+      uint32_t rel = (uint32_t)(target - (offset + 4));
+      buffer[offset + 0] = (uint8_t)(rel      );
+      buffer[offset + 1] = (uint8_t)(rel >>  8);
+      buffer[offset + 2] = (uint8_t)(rel >> 16);
+      buffer[offset + 3] = (uint8_t)(rel >> 24);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  struct Jump
+  {
+    int offset;
+    uint32_t label;
+  };
+
+  uint8_t buffer[RASTER_JIT_BUFFER_SIZE];
+  uint32_t length;
+
+  int labels[RASTER_JIT_LABEL_COUNT];
+  uint32_t labelCount;
+
+  Jump jumps[RASTER_JIT_JUMP_COUNT];
+  uint32_t jumpCount;
+
+  bool error;
+};
+
+// ============================================================================
+// [Fog::RasterJit - Pipeline - Registers]
+// ============================================================================
+
+// Register allocation of the generated pipeline:
+//
+// - RAX - Source pixel, temporary.
+// - RCX - Count of pixels remaining in the span.
+// - RDX - Destination pixel, temporary.
+// - RBX - Position in the gradient (16.16 fixed point).
+// - RBP - End of the last span (adjacent spans continue where the last ended).
+// - RSI - Span mask.
+// - RDI - Destination pointer.
+// - R8  - Temporary.
+// - R9  - Temporary.
+// - R10 - Gradient length (16.16 fixed point).
+// - R11 - Gradient position increment (16.16 fixed point).
+// - R12 - Gradient table.
+// - R13 - Current span.
+// - R14 - Mask (and the type of the span at the span beginning).
+// - R15 - Inverted mask or temporary.
+//
+// Stack frame:
+//
+// - [RSP +  0] - Fetcher.
+// - [RSP +  8] - Destination scanline.
+// - [RSP + 16] - Gradient position at x == 0 (16.16 fixed point).
+
+enum
+{
+  RASTER_JIT_REG_SRC = RASTER_JIT_RAX,
+  RASTER_JIT_REG_CNT = RASTER_JIT_RCX,
+  RASTER_JIT_REG_DST = RASTER_JIT_RDX,
+  RASTER_JIT_REG_POS = RASTER_JIT_RBX,
+  RASTER_JIT_REG_END = RASTER_JIT_RBP,
+  RASTER_JIT_REG_MSK_PTR = RASTER_JIT_RSI,
+  RASTER_JIT_REG_DST_PTR = RASTER_JIT_RDI,
+  RASTER_JIT_REG_T0 = RASTER_JIT_R8,
+  RASTER_JIT_REG_T1 = RASTER_JIT_R9,
+  RASTER_JIT_REG_LEN = RASTER_JIT_R10,
+  RASTER_JIT_REG_XX = RASTER_JIT_R11,
+  RASTER_JIT_REG_TABLE = RASTER_JIT_R12,
+  RASTER_JIT_REG_SPAN = RASTER_JIT_R13,
+  RASTER_JIT_REG_MSK = RASTER_JIT_R14,
+  RASTER_JIT_REG_INV = RASTER_JIT_R15,
+
+  RASTER_JIT_STACK_FETCHER = 0,
+  RASTER_JIT_STACK_DST = 8,
+  RASTER_JIT_STACK_PT = 16,
+  RASTER_JIT_STACK_SIZE = 24
+};
+
+// ============================================================================
+// [Fog::RasterJit - Pipeline - Source]
+// ============================================================================
+
+// Mirrors PGradientLinear::fetch_simple_nearest_pad/repeat().
+
+//! @brief Seek to the position stored in EAX (clobbers EAX, EDX).
+static void RasterJit_emitBegin(RasterJitAssembler& a, uint32_t source)
+{
+  // pos = pt + x * xx.
+  a.mov32(RASTER_JIT_REG_POS, RASTER_JIT_RAX);
+  a.imul32(RASTER_JIT_REG_POS, RASTER_JIT_REG_XX);
+  a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_POS, RasterJitMem(RASTER_JIT_RSP, RASTER_JIT_STACK_PT));
+
+  if (source == RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_REPEAT)
+  {
+    // if ((uint)pos >= (uint)len) { pos %= len; if (pos < 0) pos += len; }
+    uint32_t L_Done = a.newLabel();
+
+    a.alu(RASTER_JIT_CMP, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_LEN);
+    a.jcc(RASTER_JIT_CC_B, L_Done);
+
+    a.mov32(RASTER_JIT_RAX, RASTER_JIT_REG_POS);
+    a.cdqIdiv32(RASTER_JIT_REG_LEN);
+    a.mov32(RASTER_JIT_REG_POS, RASTER_JIT_RDX);
+
+    a.test32(RASTER_JIT_REG_POS, RASTER_JIT_REG_POS);
+    a.jcc(RASTER_JIT_CC_GE, L_Done);
+    a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_LEN);
+
+    a.bind(L_Done);
+  }
+}
+
+//! @brief Advance to the next pixel.
+static void RasterJit_emitSkip(RasterJitAssembler& a, uint32_t source)
+{
+  a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_XX);
+
+  if (source == RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_REPEAT)
+  {
+    // if (pos >= len) pos -= len; else if (pos < 0) pos += len;
+    uint32_t L_Less = a.newLabel();
+    uint32_t L_Done = a.newLabel();
+
+    a.alu(RASTER_JIT_CMP, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_LEN);
+    a.jcc(RASTER_JIT_CC_L, L_Less);
+    a.alu(RASTER_JIT_SUB, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_LEN);
+    a.jmp(L_Done);
+
+    a.bind(L_Less);
+    a.test32(RASTER_JIT_REG_POS, RASTER_JIT_REG_POS);
+    a.jcc(RASTER_JIT_CC_GE, L_Done);
+    a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_POS, RASTER_JIT_REG_LEN);
+
+    a.bind(L_Done);
+  }
+}
+
+//! @brief Fetch the pixel into EAX and advance (clobbers R8).
+static void RasterJit_emitFetch(RasterJitAssembler& a, uint32_t source)
+{
+  a.mov32(RASTER_JIT_RAX, RASTER_JIT_REG_POS);
+
+  if (source == RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_PAD)
+  {
+    // if (pos < 0) pos = 0; if (pos > len) pos = len;
+    a.alu(RASTER_JIT_XOR, false, RASTER_JIT_REG_T0, RASTER_JIT_REG_T0);
+    a.test32(RASTER_JIT_RAX, RASTER_JIT_RAX);
+    a.cmov32(RASTER_JIT_CC_L, RASTER_JIT_RAX, RASTER_JIT_REG_T0);
+    a.alu(RASTER_JIT_CMP, false, RASTER_JIT_RAX, RASTER_JIT_REG_LEN);
+    a.cmov32(RASTER_JIT_CC_G, RASTER_JIT_RAX, RASTER_JIT_REG_LEN);
+  }
+
+  // The position is never negative here.
+  a.shift(RASTER_JIT_SHR, false, RASTER_JIT_RAX, 16);
+  a.load32(RASTER_JIT_RAX, RasterJitMem(RASTER_JIT_REG_TABLE, RASTER_JIT_RAX, 2, 0));
+
+  RasterJit_emitSkip(a, source);
+}
+
+// ============================================================================
+// [Fog::RasterJit - Pipeline - Arithmetic]
+// ============================================================================
+
+// Mirrors the Acc::p32 functions used by the C compositors, the results must
+// be bit-exact.
+
+//! @brief Acc::p32MulDiv255PBB_SBW(EDX, EDX, R8D) - 64-bit version (clobbers
+//! R8, R9).
+static void RasterJit_emitMulDiv255(RasterJitAssembler& a)
+{
+  uint32_t x = RASTER_JIT_REG_DST;
+  uint32_t t0 = RASTER_JIT_REG_T0;
+  uint32_t t1 = RASTER_JIT_REG_T1;
+
+  // x = (x | (x << 24)) & 0x00FF00FF00FF00FF.
+  a.mov64(t1, x);
+  a.shift(RASTER_JIT_SHL, true, t1, 24);
+  a.alu(RASTER_JIT_OR, true, x, t1);
+  a.movImm64(t1, FOG_UINT64_C(0x00FF00FF00FF00FF));
+  a.alu(RASTER_JIT_AND, true, x, t1);
+
+  // x *= u.
+  a.imul64(x, t0);
+
+  // x = ((x + ((x >> 8) & 0x00FF00FF00FF00FF) + 0x0080008000800080) >> 8)
+  //   & 0x00FF00FF00FF00FF.
+  a.mov64(t0, x);
+  a.shift(RASTER_JIT_SHR, true, t0, 8);
+  a.alu(RASTER_JIT_AND, true, t0, t1);
+  a.alu(RASTER_JIT_ADD, true, x, t0);
+  a.movImm64(t0, FOG_UINT64_C(0x0080008000800080));
+  a.alu(RASTER_JIT_ADD, true, x, t0);
+  a.shift(RASTER_JIT_SHR, true, x, 8);
+  a.alu(RASTER_JIT_AND, true, x, t1);
+
+  // x = (uint32_t)(x | (x >> 24)).
+  a.mov64(t0, x);
+  a.shift(RASTER_JIT_SHR, true, t0, 24);
+  a.alu(RASTER_JIT_OR, false, x, t0);
+}
+
+//! @brief Acc::p32MulDiv256PBB_SBW(EAX, EAX, @a u) (clobbers R8).
+static void RasterJit_emitMulDiv256(RasterJitAssembler& a, uint32_t u)
+{
+  uint32_t x = RASTER_JIT_REG_SRC;
+  uint32_t t0 = RASTER_JIT_REG_T0;
+
+  a.mov32(t0, x);
+  a.aluImm(RASTER_JIT_AND, false, t0, 0x00FF00FF);
+  a.imul32(t0, u);
+  a.aluImm(RASTER_JIT_AND, false, t0, (int32_t)0xFF00FF00);
+  a.shift(RASTER_JIT_SHR, false, t0, 8);
+
+  a.shift(RASTER_JIT_SHR, false, x, 8);
+  a.aluImm(RASTER_JIT_AND, false, x, 0x00FF00FF);
+  a.imul32(x, u);
+  a.aluImm(RASTER_JIT_AND, false, x, (int32_t)0xFF00FF00);
+  a.alu(RASTER_JIT_OR, false, x, t0);
+}
+
+//! @brief Acc::p32Lerp256PBB_SBW(x, x, y, z, w) (clobbers y, R8, R9).
+//!
+//! If @a xrgb is true then Acc::p32Lerp256PBB_SBW_10F2() is used instead.
+static void RasterJit_emitLerp256(RasterJitAssembler& a,
+  uint32_t x, uint32_t y, uint32_t z, uint32_t w, bool xrgb)
+{
+  uint32_t t0 = RASTER_JIT_REG_T0;
+  uint32_t t1 = RASTER_JIT_REG_T1;
+
+  // t0 = (x & 0x00FF00FF) * z + (y & 0x00FF00FF) * w.
+  a.mov32(t0, x);
+  a.aluImm(RASTER_JIT_AND, false, t0, 0x00FF00FF);
+  a.imul32(t0, z);
+  a.mov32(t1, y);
+  a.aluImm(RASTER_JIT_AND, false, t1, 0x00FF00FF);
+  a.imul32(t1, w);
+  a.alu(RASTER_JIT_ADD, false, t0, t1);
+  a.aluImm(RASTER_JIT_AND, false, t0, (int32_t)0xFF00FF00);
+
+  if (!xrgb)
+  {
+    // t1 = ((x >> 8) & 0x00FF00FF) * z + ((y >> 8) & 0x00FF00FF) * w.
+    a.shift(RASTER_JIT_SHR, false, x, 8);
+    a.aluImm(RASTER_JIT_AND, false, x, 0x00FF00FF);
+    a.imul32(x, z);
+    a.shift(RASTER_JIT_SHR, false, y, 8);
+    a.aluImm(RASTER_JIT_AND, false, y, 0x00FF00FF);
+    a.imul32(y, w);
+    a.alu(RASTER_JIT_ADD, false, x, y);
+
+    // x = (t0 >> 8) | (t1 & 0xFF00FF00).
+    a.aluImm(RASTER_JIT_AND, false, x, (int32_t)0xFF00FF00);
+    a.shift(RASTER_JIT_SHR, false, t0, 8);
+    a.alu(RASTER_JIT_OR, false, x, t0);
+  }
+  else
+  {
+    // t1 = (x & 0x0000FF00) * z + (y & 0x0000FF00) * w.
+    a.aluImm(RASTER_JIT_AND, false, x, 0x0000FF00);
+    a.imul32(x, z);
+    a.aluImm(RASTER_JIT_AND, false, y, 0x0000FF00);
+    a.imul32(y, w);
+    a.alu(RASTER_JIT_ADD, false, x, y);
+
+    // x = ((t0 | (t1 & 0x00FF0000)) >> 8) | 0xFF000000.
+    a.aluImm(RASTER_JIT_AND, false, x, 0x00FF0000);
+    a.alu(RASTER_JIT_OR, false, x, t0);
+    a.shift(RASTER_JIT_SHR, false, x, 8);
+    a.aluImm(RASTER_JIT_OR, false, x, (int32_t)0xFF000000);
+  }
+}
+
+//! @brief Blend the premultiplied source in EAX over the destination in EDX
+//! and store the result (clobbers R8, R9).
+static void RasterJit_emitOverAndStore(RasterJitAssembler& a, uint32_t sra)
+{
+  // sra = 255 - (sra >> 24).
+  a.mov32(RASTER_JIT_REG_T0, sra);
+  a.shift(RASTER_JIT_SHR, false, RASTER_JIT_REG_T0, 24);
+  a.aluImm(RASTER_JIT_XOR, false, RASTER_JIT_REG_T0, 0xFF);
+
+  RasterJit_emitMulDiv255(a);
+  a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_SRC, RASTER_JIT_REG_DST);
+  a.store32(RasterJitMem(RASTER_JIT_REG_DST_PTR, 0), RASTER_JIT_REG_SRC);
+}
+
+// ============================================================================
+// [Fog::RasterJit - Pipeline - Operators]
+// ============================================================================
+
+// Mirrors CompositeSrc / CompositeSrcOver span functions. The source pixel is
+// in EAX, the destination pointer in RDI. The operator jumps to @a L_Skip if
+// the destination is not modified.
+
+//! @brief C-Opaque span.
+static void RasterJit_emitCOpaque(RasterJitAssembler& a, uint32_t fusedId, uint32_t L_Skip)
+{
+  RasterJitMem dst(RASTER_JIT_REG_DST_PTR, 0);
+
+  switch (fusedId)
+  {
+    case RASTER_FUSED_XRGB32_SRC:
+      a.aluImm(RASTER_JIT_OR, false, RASTER_JIT_REG_SRC, (int32_t)0xFF000000);
+      // ... Fall through ...
+
+    case RASTER_FUSED_PRGB32_SRC:
+      a.store32(dst, RASTER_JIT_REG_SRC);
+      break;
+
+    case RASTER_FUSED_PRGB32_SRC_OVER:
+    case RASTER_FUSED_XRGB32_SRC_OVER:
+    {
+      uint32_t L_Fill = a.newLabel();
+
+      a.aluImm(RASTER_JIT_CMP, false, RASTER_JIT_REG_SRC, (int32_t)0xFF000000);
+      a.jcc(RASTER_JIT_CC_AE, L_Fill);
+      a.test32(RASTER_JIT_REG_SRC, RASTER_JIT_REG_SRC);
+      a.jcc(RASTER_JIT_CC_E, L_Skip);
+
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitOverAndStore(a, RASTER_JIT_REG_SRC);
+      a.jmp(L_Skip);
+
+      a.bind(L_Fill);
+      a.store32(dst, RASTER_JIT_REG_SRC);
+      break;
+    }
+  }
+}
+
+//! @brief C-Mask span, the mask is in R14D and the inverted mask in R15D.
+static void RasterJit_emitCMask(RasterJitAssembler& a, uint32_t fusedId, uint32_t L_Skip)
+{
+  RasterJitMem dst(RASTER_JIT_REG_DST_PTR, 0);
+
+  switch (fusedId)
+  {
+    case RASTER_FUSED_PRGB32_SRC:
+    case RASTER_FUSED_XRGB32_SRC:
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitLerp256(a, RASTER_JIT_REG_DST, RASTER_JIT_REG_SRC,
+        RASTER_JIT_REG_INV, RASTER_JIT_REG_MSK, fusedId == RASTER_FUSED_XRGB32_SRC);
+      a.store32(dst, RASTER_JIT_REG_DST);
+      break;
+
+    case RASTER_FUSED_PRGB32_SRC_OVER:
+    case RASTER_FUSED_XRGB32_SRC_OVER:
+      a.test32(RASTER_JIT_REG_SRC, RASTER_JIT_REG_SRC);
+      a.jcc(RASTER_JIT_CC_E, L_Skip);
+
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitMulDiv256(a, RASTER_JIT_REG_MSK);
+      RasterJit_emitOverAndStore(a, RASTER_JIT_REG_SRC);
+      break;
+  }
+}
+
+//! @brief A8-Glyph span, the non-zero mask is in R14D (clobbers R15).
+static void RasterJit_emitA8Glyph(RasterJitAssembler& a, uint32_t fusedId, uint32_t L_Skip)
+{
+  RasterJitMem dst(RASTER_JIT_REG_DST_PTR, 0);
+
+  switch (fusedId)
+  {
+    case RASTER_FUSED_PRGB32_SRC:
+    case RASTER_FUSED_XRGB32_SRC:
+    {
+      bool xrgb = (fusedId == RASTER_FUSED_XRGB32_SRC);
+      uint32_t L_Fill = a.newLabel();
+
+      a.aluImm(RASTER_JIT_CMP, false, RASTER_JIT_REG_MSK, 0xFF);
+      a.jcc(RASTER_JIT_CC_E, L_Fill);
+
+      // msk = msk + (msk > 127), inv = 256 - msk.
+      a.mov32(RASTER_JIT_REG_T0, RASTER_JIT_REG_MSK);
+      a.shift(RASTER_JIT_SHR, false, RASTER_JIT_REG_T0, 7);
+      a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_MSK, RASTER_JIT_REG_T0);
+      a.movImm32(RASTER_JIT_REG_INV, 256);
+      a.alu(RASTER_JIT_SUB, false, RASTER_JIT_REG_INV, RASTER_JIT_REG_MSK);
+
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitLerp256(a, RASTER_JIT_REG_SRC, RASTER_JIT_REG_DST,
+        RASTER_JIT_REG_MSK, RASTER_JIT_REG_INV, xrgb);
+
+      a.bind(L_Fill);
+      if (xrgb)
+        a.aluImm(RASTER_JIT_OR, false, RASTER_JIT_REG_SRC, (int32_t)0xFF000000);
+      a.store32(dst, RASTER_JIT_REG_SRC);
+      break;
+    }
+
+    case RASTER_FUSED_PRGB32_SRC_OVER:
+    case RASTER_FUSED_XRGB32_SRC_OVER:
+    {
+      uint32_t L_Fill = a.newLabel();
+      uint32_t sra = RASTER_JIT_REG_INV;
+
+      // msk = msk + (msk > 127).
+      a.mov32(RASTER_JIT_REG_T0, RASTER_JIT_REG_MSK);
+      a.shift(RASTER_JIT_SHR, false, RASTER_JIT_REG_T0, 7);
+      a.alu(RASTER_JIT_ADD, false, RASTER_JIT_REG_MSK, RASTER_JIT_REG_T0);
+
+      // sra = (((src & 0xFF00FF00) >> 8) * msk) & 0xFF00FF00.
+      a.mov32(sra, RASTER_JIT_REG_SRC);
+      a.aluImm(RASTER_JIT_AND, false, sra, (int32_t)0xFF00FF00);
+      a.shift(RASTER_JIT_SHR, false, sra, 8);
+      a.imul32(sra, RASTER_JIT_REG_MSK);
+      a.aluImm(RASTER_JIT_AND, false, sra, (int32_t)0xFF00FF00);
+
+      a.test32(sra, sra);
+      a.jcc(RASTER_JIT_CC_E, L_Skip);
+      a.aluImm(RASTER_JIT_CMP, false, sra, (int32_t)0xFF000000);
+      a.jcc(RASTER_JIT_CC_AE, L_Fill);
+
+      // src = ((((src & 0x00FF00FF) * msk) >> 8) & 0x00FF00FF) | sra.
+      a.load32(RASTER_JIT_REG_DST, dst);
+      a.aluImm(RASTER_JIT_AND, false, RASTER_JIT_REG_SRC, 0x00FF00FF);
+      a.imul32(RASTER_JIT_REG_SRC, RASTER_JIT_REG_MSK);
+      a.shift(RASTER_JIT_SHR, false, RASTER_JIT_REG_SRC, 8);
+      a.aluImm(RASTER_JIT_AND, false, RASTER_JIT_REG_SRC, 0x00FF00FF);
+      a.alu(RASTER_JIT_OR, false, RASTER_JIT_REG_SRC, sra);
+
+      RasterJit_emitOverAndStore(a, sra);
+      a.jmp(L_Skip);
+
+      a.bind(L_Fill);
+      a.store32(dst, RASTER_JIT_REG_SRC);
+      break;
+    }
+  }
+}
+
+//! @brief A8-Extra span, the non-zero mask is in R14D (clobbers R15).
+static void RasterJit_emitA8Extra(RasterJitAssembler& a, uint32_t fusedId, uint32_t L_Skip)
+{
+  RasterJitMem dst(RASTER_JIT_REG_DST_PTR, 0);
+
+  switch (fusedId)
+  {
+    case RASTER_FUSED_PRGB32_SRC:
+    case RASTER_FUSED_XRGB32_SRC:
+      a.movImm32(RASTER_JIT_REG_INV, 256);
+      a.alu(RASTER_JIT_SUB, false, RASTER_JIT_REG_INV, RASTER_JIT_REG_MSK);
+
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitLerp256(a, RASTER_JIT_REG_SRC, RASTER_JIT_REG_DST,
+        RASTER_JIT_REG_MSK, RASTER_JIT_REG_INV, fusedId == RASTER_FUSED_XRGB32_SRC);
+      a.store32(dst, RASTER_JIT_REG_SRC);
+      break;
+
+    case RASTER_FUSED_PRGB32_SRC_OVER:
+    case RASTER_FUSED_XRGB32_SRC_OVER:
+      a.test32(RASTER_JIT_REG_SRC, RASTER_JIT_REG_SRC);
+      a.jcc(RASTER_JIT_CC_E, L_Skip);
+
+      a.load32(RASTER_JIT_REG_DST, dst);
+      RasterJit_emitMulDiv256(a, RASTER_JIT_REG_MSK);
+      RasterJit_emitOverAndStore(a, RASTER_JIT_REG_SRC);
+      break;
+  }
+}
+
+// ============================================================================
+// [Fog::RasterJit - Pipeline - Function]
+// ============================================================================
+
+static const uint32_t RasterJit_savedRegs[] =
+{
+  RASTER_JIT_RBX, RASTER_JIT_RBP, RASTER_JIT_RSI, RASTER_JIT_RDI,
+  RASTER_JIT_R12, RASTER_JIT_R13, RASTER_JIT_R14, RASTER_JIT_R15
+};
+
+//! @brief Generate the fused function of pipeline @a source / @a fusedId.
+static void RasterJit_emitPipeline(RasterJitAssembler& a, uint32_t source, uint32_t fusedId)
+{
+  uint32_t i;
+
+  RasterJitMem stackFetcher(RASTER_JIT_RSP, RASTER_JIT_STACK_FETCHER);
+  RasterJitMem stackDst(RASTER_JIT_RSP, RASTER_JIT_STACK_DST);
+  RasterJitMem stackPt(RASTER_JIT_RSP, RASTER_JIT_STACK_PT);
+
+  int32_t ptOffset = (int32_t)FOG_OFFSET_OF(RasterPatternFetcher, _d.gradient.linear.simple.pt);
+  int32_t dtOffset = (int32_t)FOG_OFFSET_OF(RasterPatternFetcher, _d.gradient.linear.simple.dt);
+
+  // --------------------------------------------------------------------------
+  // [Prolog]
+  // --------------------------------------------------------------------------
+
+  // The Win64 calling convention treats RSI and RDI as callee-saved, they are
+  // saved in both conventions to keep the code simple. Eight pushes keep the
+  // stack 16-byte aligned after the frame is allocated.
+  for (i = 0; i < FOG_ARRAY_SIZE(RasterJit_savedRegs); i++)
+    a.push(RasterJit_savedRegs[i]);
+  a.aluImm(RASTER_JIT_SUB, true, RASTER_JIT_RSP, RASTER_JIT_STACK_SIZE);
+
+#if defined(FOG_OS_WINDOWS)
+  a.store64(stackFetcher, RASTER_JIT_RCX);
+  a.store64(stackDst, RASTER_JIT_RDX);
+  a.mov64(RASTER_JIT_REG_SPAN, RASTER_JIT_R8);
+#else
+  a.store64(stackFetcher, RASTER_JIT_RDI);
+  a.store64(stackDst, RASTER_JIT_RSI);
+  a.mov64(RASTER_JIT_REG_SPAN, RASTER_JIT_RDX);
+#endif // FOG_OS_WINDOWS
+
+  // --------------------------------------------------------------------------
+  // [Source - Init]
+  // --------------------------------------------------------------------------
+
+  a.load64(RASTER_JIT_RAX, stackFetcher);
+  a.load64(RASTER_JIT_R8, RasterJitMem(RASTER_JIT_RAX, (int32_t)FOG_OFFSET_OF(RasterPatternFetcher, _ctx)));
+
+  a.load64(RASTER_JIT_REG_TABLE, RasterJitMem(RASTER_JIT_R8,
+    (int32_t)FOG_OFFSET_OF(RasterPattern, _d.gradient.base.table)));
+  a.load32(RASTER_JIT_REG_XX, RasterJitMem(RASTER_JIT_R8,
+    (int32_t)FOG_OFFSET_OF(RasterPattern, _d.gradient.linear.simple.xx16x16)));
+  a.load32(RASTER_JIT_REG_LEN, RasterJitMem(RASTER_JIT_R8,
+    (int32_t)FOG_OFFSET_OF(RasterPattern, _d.gradient.base.len16x16)));
+
+  // pt = Math::fixed16x16FromFloat(fetcher->pt).
+  a.movsdLoad(0, RasterJitMem(RASTER_JIT_RAX, ptOffset));
+  a.movImm64(RASTER_JIT_R9, FOG_UINT64_C(0x40F0000000000000));
+  a.movq(1, RASTER_JIT_R9);
+  a.mulsd(0, 1);
+  a.cvttsd2si32(RASTER_JIT_R9, 0);
+  a.store32(stackPt, RASTER_JIT_R9);
+
+  a.movImm32(RASTER_JIT_REG_END, 0xFFFFFFFF);
+
+  // --------------------------------------------------------------------------
+  // [Span]
+  // --------------------------------------------------------------------------
+
+  uint32_t L_Span = a.newLabel();
+  uint32_t L_Continue = a.newLabel();
+  uint32_t L_Next = a.newLabel();
+
+  uint32_t L_COpaque = a.newLabel();
+  uint32_t L_CMask = a.newLabel();
+  uint32_t L_CMaskLoop = a.newLabel();
+  uint32_t L_Glyph = a.newLabel();
+  uint32_t L_GlyphFetch = a.newLabel();
+  uint32_t L_GlyphAdvance = a.newLabel();
+  uint32_t L_Extra = a.newLabel();
+  uint32_t L_ExtraFetch = a.newLabel();
+  uint32_t L_ExtraAdvance = a.newLabel();
+  uint32_t L_Other = a.newLabel();
+  uint32_t L_COpaqueAdvance = a.newLabel();
+  uint32_t L_CMaskAdvance = a.newLabel();
+
+  a.bind(L_Span);
+
+  // x = span->getX0(), type = span->getType(), w = span->getX1() - x.
+  a.load32(RASTER_JIT_RAX, RasterJitMem(RASTER_JIT_REG_SPAN, 0));
+  a.mov32(RASTER_JIT_REG_MSK, RASTER_JIT_RAX);
+  a.shift(RASTER_JIT_SHR, false, RASTER_JIT_REG_MSK, 29);
+  a.aluImm(RASTER_JIT_AND, false, RASTER_JIT_RAX, 0x1FFFFFFF);
+
+  a.load32(RASTER_JIT_REG_CNT, RasterJitMem(RASTER_JIT_REG_SPAN, (int32_t)FOG_OFFSET_OF(RasterSpan, _x1)));
+  a.alu(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, RASTER_JIT_RAX);
+
+  a.load64(RASTER_JIT_REG_DST_PTR, stackDst);
+  a.lea64(RASTER_JIT_REG_DST_PTR, RasterJitMem(RASTER_JIT_REG_DST_PTR, RASTER_JIT_RAX, 2, 0));
+  a.load64(RASTER_JIT_REG_MSK_PTR, RasterJitMem(RASTER_JIT_REG_SPAN, (int32_t)FOG_OFFSET_OF(RasterSpan, _mask)));
+
+  // Adjacent spans continue at the position where the previous span ended.
+  a.alu(RASTER_JIT_CMP, false, RASTER_JIT_RAX, RASTER_JIT_REG_END);
+  a.jcc(RASTER_JIT_CC_E, L_Continue);
+  RasterJit_emitBegin(a, source);
+
+  a.bind(L_Continue);
+  a.load32(RASTER_JIT_REG_END, RasterJitMem(RASTER_JIT_REG_SPAN, (int32_t)FOG_OFFSET_OF(RasterSpan, _x1)));
+
+  a.test32(RASTER_JIT_REG_MSK, RASTER_JIT_REG_MSK);
+  a.jcc(RASTER_JIT_CC_E, L_COpaque);
+  a.aluImm(RASTER_JIT_CMP, false, RASTER_JIT_REG_MSK, RASTER_SPAN_AX_EXTRA);
+  a.jcc(RASTER_JIT_CC_E, L_Extra);
+  a.aluImm(RASTER_JIT_CMP, false, RASTER_JIT_REG_MSK, RASTER_SPAN_AX_GLYPH);
+  a.jcc(RASTER_JIT_CC_BE, L_Glyph);
+  a.jmp(L_Other);
+
+  // --------------------------------------------------------------------------
+  // [C-Opaque / C-Mask]
+  // --------------------------------------------------------------------------
+
+  a.bind(L_COpaque);
+  a.aluImm(RASTER_JIT_CMP, false, RASTER_JIT_REG_MSK_PTR, 0x100);
+  a.jcc(RASTER_JIT_CC_NE, L_CMask);
+
+  {
+    uint32_t L_Loop = a.newLabel();
+
+    a.bind(L_Loop);
+    RasterJit_emitFetch(a, source);
+    RasterJit_emitCOpaque(a, fusedId, L_COpaqueAdvance);
+
+    a.bind(L_COpaqueAdvance);
+    a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_DST_PTR, 4);
+    a.aluImm(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, 1);
+    a.jcc(RASTER_JIT_CC_NE, L_Loop);
+    a.jmp(L_Next);
+  }
+
+  a.bind(L_CMask);
+  a.mov32(RASTER_JIT_REG_MSK, RASTER_JIT_REG_MSK_PTR);
+  a.movImm32(RASTER_JIT_REG_INV, 256);
+  a.alu(RASTER_JIT_SUB, false, RASTER_JIT_REG_INV, RASTER_JIT_REG_MSK);
+
+  a.bind(L_CMaskLoop);
+  RasterJit_emitFetch(a, source);
+  RasterJit_emitCMask(a, fusedId, L_CMaskAdvance);
+
+  a.bind(L_CMaskAdvance);
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_DST_PTR, 4);
+  a.aluImm(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, 1);
+  a.jcc(RASTER_JIT_CC_NE, L_CMaskLoop);
+  a.jmp(L_Next);
+
+  // --------------------------------------------------------------------------
+  // [A8-Glyph]
+  // --------------------------------------------------------------------------
+
+  a.bind(L_Glyph);
+  a.loadU8(RASTER_JIT_REG_MSK, RasterJitMem(RASTER_JIT_REG_MSK_PTR, 0));
+  a.test32(RASTER_JIT_REG_MSK, RASTER_JIT_REG_MSK);
+  a.jcc(RASTER_JIT_CC_NE, L_GlyphFetch);
+  RasterJit_emitSkip(a, source);
+  a.jmp(L_GlyphAdvance);
+
+  a.bind(L_GlyphFetch);
+  RasterJit_emitFetch(a, source);
+  RasterJit_emitA8Glyph(a, fusedId, L_GlyphAdvance);
+
+  a.bind(L_GlyphAdvance);
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_DST_PTR, 4);
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_MSK_PTR, 1);
+  a.aluImm(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, 1);
+  a.jcc(RASTER_JIT_CC_NE, L_Glyph);
+  a.jmp(L_Next);
+
+  // --------------------------------------------------------------------------
+  // [A8-Extra]
+  // --------------------------------------------------------------------------
+
+  a.bind(L_Extra);
+  a.loadU16(RASTER_JIT_REG_MSK, RasterJitMem(RASTER_JIT_REG_MSK_PTR, 0));
+  a.test32(RASTER_JIT_REG_MSK, RASTER_JIT_REG_MSK);
+  a.jcc(RASTER_JIT_CC_NE, L_ExtraFetch);
+  RasterJit_emitSkip(a, source);
+  a.jmp(L_ExtraAdvance);
+
+  a.bind(L_ExtraFetch);
+  RasterJit_emitFetch(a, source);
+  RasterJit_emitA8Extra(a, fusedId, L_ExtraAdvance);
+
+  a.bind(L_ExtraAdvance);
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_DST_PTR, 4);
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_REG_MSK_PTR, 2);
+  a.aluImm(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, 1);
+  a.jcc(RASTER_JIT_CC_NE, L_Extra);
+  a.jmp(L_Next);
+
+  // --------------------------------------------------------------------------
+  // [Other]
+  // --------------------------------------------------------------------------
+
+  // ARGB32 glyphs are never generated by the rasterizers, only the position
+  // is advanced to stay in sync with the next span.
+  a.bind(L_Other);
+  {
+    uint32_t L_Loop = a.newLabel();
+
+    a.bind(L_Loop);
+    RasterJit_emitSkip(a, source);
+    a.aluImm(RASTER_JIT_SUB, false, RASTER_JIT_REG_CNT, 1);
+    a.jcc(RASTER_JIT_CC_NE, L_Loop);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Next]
+  // --------------------------------------------------------------------------
+
+  a.bind(L_Next);
+  a.load64(RASTER_JIT_REG_SPAN, RasterJitMem(RASTER_JIT_REG_SPAN, (int32_t)FOG_OFFSET_OF(RasterSpan, _next)));
+  a.test64(RASTER_JIT_REG_SPAN, RASTER_JIT_REG_SPAN);
+  a.jcc(RASTER_JIT_CC_NE, L_Span);
+
+  // --------------------------------------------------------------------------
+  // [Source - End]
+  // --------------------------------------------------------------------------
+
+  // fetcher->pt += fetcher->dt.
+  a.load64(RASTER_JIT_RAX, stackFetcher);
+  a.movsdLoad(0, RasterJitMem(RASTER_JIT_RAX, ptOffset));
+  a.addsd(0, RasterJitMem(RASTER_JIT_RAX, dtOffset));
+  a.movsdStore(RasterJitMem(RASTER_JIT_RAX, ptOffset), 0);
+
+  // --------------------------------------------------------------------------
+  // [Epilog]
+  // --------------------------------------------------------------------------
+
+  a.aluImm(RASTER_JIT_ADD, true, RASTER_JIT_RSP, RASTER_JIT_STACK_SIZE);
+  for (i = FOG_ARRAY_SIZE(RasterJit_savedRegs); i > 0; i--)
+    a.pop(RasterJit_savedRegs[i - 1]);
+  a.ret();
+
+  a.link();
+}
+
+// ============================================================================
+// [Fog::RasterJit - Executable Memory]
+// ============================================================================
+
+static void* RasterJit_allocExecutable(const uint8_t* code, size_t size)
+{
+#if defined(FOG_OS_WINDOWS)
+  void* p = ::VirtualAlloc(NULL, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+  if (p == NULL)
+    return NULL;
+
+  MemOps::copy(p, code, size);
+
+  DWORD oldProtect;
+  if (!::VirtualProtect(p, size, PAGE_EXECUTE_READ, &oldProtect))
+  {
+    ::VirtualFree(p, 0, MEM_RELEASE);
+    return NULL;
+  }
+
+  ::FlushInstructionCache(::GetCurrentProcess(), p, size);
+  return p;
+#else
+  void* p = ::mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+  if (p == MAP_FAILED)
+    return NULL;
+
+  MemOps::copy(p, code, size);
+
+  if (::mprotect(p, size, PROT_READ | PROT_EXEC) != 0)
+  {
+    ::munmap(p, size);
+    return NULL;
+  }
+
+  return p;
+#endif // FOG_OS_WINDOWS
+}
+
+static void RasterJit_freeExecutable(void* p, size_t size)
+{
+#if defined(FOG_OS_WINDOWS)
+  FOG_UNUSED(size);
+  ::VirtualFree(p, 0, MEM_RELEASE);
+#else
+  ::munmap(p, size);
+#endif // FOG_OS_WINDOWS
+}
+
+// ============================================================================
+// [Fog::RasterJit - Global]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterJit_Global
+{
+  FOG_INLINE RasterJit_Global()
+  {
+    MemOps::zero(funcs, sizeof(funcs));
+    MemOps::zero(sizes, sizeof(sizes));
+  }
+
+  // Critical section for generating functions.
+  Lock lock;
+
+  // Generated functions (read without locking), 1 if generation failed.
+  size_t funcs[RASTER_JIT_SOURCE_COUNT][RASTER_FUSED_COUNT];
+  // Size of the executable memory of each function.
+  size_t sizes[RASTER_JIT_SOURCE_COUNT][RASTER_FUSED_COUNT];
+};
+
+static Static<RasterJit_Global> RasterJit_global;
+
+// ============================================================================
+// [Fog::RasterJit - GetFusedFunc]
+// ============================================================================
+
+RasterPatternFusedFunc RasterJit::getFusedFunc(uint32_t source, uint32_t fusedId)
+{
+  FOG_ASSERT(source < RASTER_JIT_SOURCE_COUNT);
+  FOG_ASSERT(fusedId < RASTER_FUSED_COUNT);
+
+  if (source == RASTER_JIT_SOURCE_NONE)
+    return NULL;
+
+  RasterJit_Global* g = &RasterJit_global;
+  size_t func = AtomicCore<size_t>::get(&g->funcs[source][fusedId]);
+
+  if (func == 0)
+  {
+    AutoLock locked(g->lock);
+
+    func = g->funcs[source][fusedId];
+    if (func == 0)
+    {
+      RasterJitAssembler* a = reinterpret_cast<RasterJitAssembler*>(
+        MemMgr::alloc(sizeof(RasterJitAssembler)));
+
+      // Mark the pipeline as failed until it's generated successfully.
+      func = 1;
+
+      if (a != NULL)
+      {
+        fog_new_p(a) RasterJitAssembler();
+        RasterJit_emitPipeline(*a, source, fusedId);
+
+        if (!a->error)
+        {
+          void* p = RasterJit_allocExecutable(a->buffer, a->length);
+          if (p != NULL)
+          {
+            func = (size_t)p;
+            g->sizes[source][fusedId] = a->length;
+          }
+        }
+
+        MemMgr::free(a);
+      }
+
+      AtomicCore<size_t>::set(&g->funcs[source][fusedId], func);
+    }
+  }
+
+  if (func == 1)
+    return NULL;
+
+  return reinterpret_cast<RasterPatternFusedFunc>((void*)func);
+}
+
+#else
+
+// ============================================================================
+// [Fog::RasterJit - GetFusedFunc]
+// ============================================================================
+
+RasterPatternFusedFunc RasterJit::getFusedFunc(uint32_t source, uint32_t fusedId)
+{
+  FOG_UNUSED(source);
+  FOG_UNUSED(fusedId);
+
+  return NULL;
+}
+
+#endif // FOG_RASTER_JIT_X64
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterJit_init(void)
+{
+#if defined(FOG_RASTER_JIT_X64)
+  RasterJit_global.init();
+#endif // FOG_RASTER_JIT_X64
+}
+
+FOG_NO_EXPORT void RasterJit_fini(void)
+{
+#if defined(FOG_RASTER_JIT_X64)
+  RasterJit_Global* g = &RasterJit_global;
+
+  for (uint32_t source = 0; source < RASTER_JIT_SOURCE_COUNT; source++)
+  {
+    for (uint32_t fusedId = 0; fusedId < RASTER_FUSED_COUNT; fusedId++)
+    {
+      size_t func = g->funcs[source][fusedId];
+      if (func > 1)
+        RasterJit_freeExecutable((void*)func, g->sizes[source][fusedId]);
+    }
+  }
+
+  RasterJit_global.destroy();
+#endif // FOG_RASTER_JIT_X64
+}
+
+} // Fog namespace
@@ -0,0 +1,50 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERJIT_P_H
+#define _FOG_G2D_PAINTING_RASTERJIT_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RasterJit]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Raster JIT backend (x86-64).
+//!
+//! The JIT generates fused fetch-and-composite functions, the pipeline is
+//! identified by the pattern source (@c RASTER_JIT_SOURCE) and the fused
+//! function ID (@c RASTER_FUSED). Each pipeline is generated on the first
+//! use and kept until the library is unloaded. The generated code produces
+//! the same pixels as the C fetchers and compositors it replaces.
+//!
+//! The backend is built only if @c FOG_RASTER_JIT is defined, otherwise (or
+//! if the code can't be generated) @c getFusedFunc() returns @c NULL and the
+//! pattern is fetched and composited separately. All methods are
+//! thread-safe.
+struct FOG_NO_EXPORT RasterJit
+{
+  //! @brief Get the fused function of pipeline @a source / @a fusedId,
+  //! @c NULL if the pipeline is not supported.
+  static RasterPatternFusedFunc getFusedFunc(uint32_t source, uint32_t fusedId);
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERJIT_P_H
@@ -0,0 +1,148 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Painting/RasterMipmap_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterMipmap - Helpers]
+// ============================================================================
+
+static FOG_INLINE bool RasterMipmap_isWholeImage(const ImageData* d, const RectI& fragment)
+{
+  return fragment.x == 0 && fragment.y == 0 &&
+         fragment.w == d->size.w && fragment.h == d->size.h;
+}
+
+static FOG_INLINE SizeI RasterMipmap_getLevelSize(const SizeI& size)
+{
+  return SizeI((size.w + 1) >> 1, (size.h + 1) >> 1);
+}
+
+// ============================================================================
+// [Fog::RasterMipmap - GetLevel]
+// ============================================================================
+
+uint32_t RasterMipmap::getLevel(const SizeI& size, const TransformD& tr)
+{
+  // Projective transform has no single scale, don't use the mipmap in such
+  // case, it's better to alias than to blur the near part of the texture.
+  if (tr.getType() >= TRANSFORM_TYPE_PROJECTION)
+    return 0;
+
+  double sx = Math::hypot(tr._00, tr._01);
+  double sy = Math::hypot(tr._10, tr._11);
+  double s = Math::max(sx, sy);
+
+  uint32_t level = 0;
+  int w = size.w;
+  int h = size.h;
+
+  while (s <= 0.5 && (w > 1 || h > 1) && level < RASTER_MIPMAP_MAX_LEVEL)
+  {
+    s *= 2.0;
+    w = (w + 1) >> 1;
+    h = (h + 1) >> 1;
+    level++;
+  }
+
+  return level;
+}
+
+// ============================================================================
+// [Fog::RasterMipmap - Prepare]
+// ============================================================================
+
+err_t RasterMipmap::prepare(const Image& image, const RectI& fragment, const TransformD& tr)
+{
+  ImageData* d = image._d;
+
+  if (d->locked || !isFormatSupported(d->format) || !RasterMipmap_isWholeImage(d, fragment))
+    return ERR_OK;
+
+  uint32_t level = getLevel(d->size, tr);
+  if (level == 0)
+    return ERR_OK;
+
+  ImageData* prev = d;
+
+  for (uint32_t i = 0; i < level; i++)
+  {
+    ImageData* next = prev->mipmap;
+
+    if (next == NULL)
+    {
+      Image prevImage(prev->addRef());
+      Image nextImage;
+
+      FOG_RETURN_ON_ERROR(
+        Image::resize(nextImage, RasterMipmap_getLevelSize(prev->size), prevImage, IMAGE_RESIZE_BILINEAR)
+      );
+
+      next = nextImage._d;
+      next->addRef();
+
+      // The mipmap can be built by more paint engines at the same time (the
+      // source image is shared), only the first level built is used.
+      if (!AtomicCore<ImageData*>::cmpXchg(&prev->mipmap, (ImageData*)NULL, next))
+      {
+        next->release();
+        next = prev->mipmap;
+      }
+    }
+
+    prev = next;
+  }
+
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterMipmap - Select]
+// ============================================================================
+
+bool RasterMipmap::select(Image& dstImage, RectI& dstFragment, TransformD& dstTr,
+  const Image& image, const RectI& fragment, const TransformD& tr,
+  uint32_t imageQuality)
+{
+  ImageData* d = image._d;
+
+  if (imageQuality == IMAGE_QUALITY_NEAREST || d->mipmap == NULL || !RasterMipmap_isWholeImage(d, fragment))
+    return false;
+
+  uint32_t level = getLevel(d->size, tr);
+  if (level == 0)
+    return false;
+
+  ImageData* levelD = d;
+
+  for (uint32_t i = 0; i < level; i++)
+  {
+    ImageData* next = levelD->mipmap;
+    if (next == NULL)
+      break;
+    levelD = next;
+  }
+
+  atomicPtrXchg(&dstImage._d, levelD->addRef())->release();
+  dstFragment.setRect(0, 0, levelD->size.w, levelD->size.h);
+
+  dstTr = tr;
+  dstTr.scale(PointD(double(d->size.w) / double(levelD->size.w),
+                     double(d->size.h) / double(levelD->size.h)));
+  return true;
+}
+
+} // Fog namespace
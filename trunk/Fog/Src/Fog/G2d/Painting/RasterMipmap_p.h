@@ -0,0 +1,89 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERMIPMAP_P_H
+#define _FOG_G2D_PAINTING_RASTERMIPMAP_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Geometry/Rect.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Imaging/Image.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_MIPMAP]
+// ============================================================================
+
+enum RASTER_MIPMAP
+{
+  //! @brief Maximum count of mipmap levels (excluding the image itself).
+  RASTER_MIPMAP_MAX_LEVEL = 16
+};
+
+// ============================================================================
+// [Fog::RasterMipmap]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Mip pyramid of images downscaled by textures.
+//!
+//! The mipmap is a list of images, each having half size of the previous one,
+//! linked by @c ImageData::mipmap. The levels are built on demand by the paint
+//! engine thread using the bilinear filter of @ref ImageResize, before the
+//! texture is created. The texture then only selects the level which matches
+//! the scale of the texture transform, so the fetcher doesn't read pixels
+//! which would be skipped (and aliased) by the bilinear interpolation.
+//!
+//! The mipmap is released when the image is modified (see
+//! @c ImageData::resetCache()), the levels already used by textures are
+//! referenced by them.
+//!
+//! Only textures which use the whole image (not a fragment) are mipmapped,
+//! because the levels of a fragment would bleed into the neighbouring pixels.
+struct FOG_NO_EXPORT RasterMipmap
+{
+  //! @brief Get whether the mipmap of the image @a format can be built.
+  static FOG_INLINE bool isFormatSupported(uint32_t format)
+  {
+    return format == IMAGE_FORMAT_PRGB32 ||
+           format == IMAGE_FORMAT_XRGB32 ||
+           format == IMAGE_FORMAT_RGB24  ||
+           format == IMAGE_FORMAT_A8;
+  }
+
+  //! @brief Get the mipmap level which should be used to fetch the texture
+  //! @a size transformed by @a tr (0 if the texture is not downscaled).
+  static uint32_t getLevel(const SizeI& size, const TransformD& tr);
+
+  //! @brief Build the mipmap levels of @a image needed by the texture
+  //! @a fragment transformed by @a tr.
+  //!
+  //! Must be called by the paint engine thread, the image can't be locked.
+  static err_t prepare(const Image& image, const RectI& fragment, const TransformD& tr);
+
+  //! @brief Select the mipmap level of @a image for the texture @a fragment
+  //! transformed by @a tr.
+  //!
+  //! Returns @c true if the level was selected, @a dstImage, @a dstFragment
+  //! and @a dstTr are then set to the level image, its fragment and transform.
+  //! Only levels already built by @c prepare() are used.
+  static bool select(Image& dstImage, RectI& dstFragment, TransformD& dstTr,
+    const Image& image, const RectI& fragment, const TransformD& tr,
+    uint32_t imageQuality);
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERMIPMAP_P_H
@@ -0,0 +1,80 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Acc/AccAvx2.h>
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/BaseDefs_p.h>
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - Constants]
+// ============================================================================
+
+// Sequence 0..7, used to compute positions of 8 consecutive pixels.
+FOG_YMM_DECLARE_CONST_PI32_VAR(0000000700000006_0000000500000004_0000000300000002_0000000100000000, 7, 6, 5, 4, 3, 2, 1, 0);
+
+// Permutation used to restore the pixel order after 8 pixels were packed by
+// two in-lane packs (the order after packing is 0 2 4 6 1 3 5 7).
+FOG_YMM_DECLARE_CONST_PI32_VAR(0000000700000003_0000000600000002_0000000500000001_0000000400000000, 7, 3, 6, 2, 5, 1, 4, 0);
+
+// ============================================================================
+// [FOG_BLIT_LOOP - 32x8 - AVX2 - 32-bits per pixel, 8 pixels in a main loop]
+// ============================================================================
+
+// The small loop processes one pixel per iteration until the destination is
+// aligned to 32 bytes, the main loop processes 8 pixels per iteration and the
+// rest is processed by the small loop again.
+
+#define FOG_BLIT_LOOP_32x8_AVX2_INIT() \
+  FOG_ASSUME(w > 0);
+
+#define FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(_Group_) \
+  if (((size_t)dst & 31) == 0) goto _##_Group_##_SmallSkip; \
+  \
+_##_Group_##_SmallBegin: \
+  for (;;) {
+
+#define FOG_BLIT_LOOP_32x8_AVX2_SMALL_CONTINUE(_Group_) \
+    if (--w == 0) goto _##_Group_##_End; \
+    if (((size_t)dst & 31) != 0) continue; \
+    break;
+
+#define FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(_Group_) \
+    if (--w == 0) goto _##_Group_##_End; \
+    if (((size_t)dst & 31) != 0) continue; \
+    break; \
+  } \
+  \
+_##_Group_##_SmallSkip:
+
+#define FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(_Group_) \
+  w -= 8; \
+  if (w < 0) goto _##_Group_##_MainSkip; \
+  \
+  for (;;) {
+
+#define FOG_BLIT_LOOP_32x8_AVX2_MAIN_CONTINUE(_Group_) \
+    if ((w -= 8) >= 0) continue; \
+    break;
+
+#define FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(_Group_) \
+    if ((w -= 8) >= 0) continue; \
+    break; \
+  } \
+  \
+_##_Group_##_MainSkip: \
+  w += 8; \
+  if (w != 0) goto _##_Group_##_SmallBegin; \
+  \
+_##_Group_##_End: \
+  ;
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_BASEDEFS_P_H
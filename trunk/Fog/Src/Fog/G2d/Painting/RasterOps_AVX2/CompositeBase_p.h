@@ -0,0 +1,601 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEBASE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEBASE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeBase]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeBase
+{
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @brief Load a solid color and unpack it to 16-bit components.
+  static FOG_INLINE void unpack_solid(__m256i& dst0, const RasterSolid* src)
+  {
+    Acc::m256iExpandPI32FromSI32(dst0, src->prgb32.u32);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0, dst0);
+  }
+
+  //! @brief Multiply unpacked pixels by unpacked masks in [0, 256] range.
+  static FOG_INLINE void mask_unpacked(
+    __m256i& dst0, const __m256i& x0, const __m256i& m0,
+    __m256i& dst1, const __m256i& x1, const __m256i& m1)
+  {
+    Acc::m256iMulDiv256PI16_2x(dst0, x0, m0, dst1, x1, m1);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeGeneric]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Generic PRGB32 compositing, the operator is implemented by
+//! @c CompositeOp::prgb32_op_prgb32_ymm() which works with 8 pixels unpacked
+//! to 16-bit components (the same function is used also to process a single
+//! pixel, only the lowest DWORD of the register is used in such case).
+//!
+//! The mask is applied to the source pixel(s) by default, which is correct for
+//! all operators which are linear with the source. The @c CompositeOp can
+//! override the @c prgb32_op_prgb32_masked_ymm() to use a different mask
+//! semantics.
+template<typename CompositeOp>
+struct CompositeGeneric : public CompositeBase
+{
+  // ==========================================================================
+  // [Op]
+  // ==========================================================================
+
+  static FOG_INLINE void prgb32_op_prgb32_masked_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0, const __m256i& m0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1, const __m256i& m1)
+  {
+    __m256i c0, c1;
+
+    mask_unpacked(c0, b0, m0, c1, b1, m1);
+    CompositeOp::prgb32_op_prgb32_ymm(dst0, a0, c0, dst1, a1, c1);
+  }
+
+  //! @brief Composite packed pixels in @a dst0 with unpacked solid color in
+  //! @a sru0.
+  static FOG_INLINE void prgb32_op_solid_packed(
+    __m256i& dst0, const __m256i& sru0)
+  {
+    __m256i dst1;
+
+    Acc::m256iUnpackPI16FromPI8Hi(dst1, dst0);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0, dst0);
+    CompositeOp::prgb32_op_prgb32_ymm(dst0, dst0, sru0, dst1, dst1, sru0);
+    Acc::m256iPackPU8FromPU16(dst0, dst0, dst1);
+  }
+
+  //! @brief Composite packed pixels in @a dst0 with packed pixels in @a src0.
+  static FOG_INLINE void prgb32_op_prgb32_packed(
+    __m256i& dst0, const __m256i& src0)
+  {
+    __m256i dst1;
+    __m256i src1, srcT;
+
+    Acc::m256iUnpackPI16FromPI8Hi(dst1, dst0);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0, dst0);
+    Acc::m256iUnpackPI16FromPI8Hi(src1, src0);
+    Acc::m256iUnpackPI16FromPI8Lo(srcT, src0);
+    CompositeOp::prgb32_op_prgb32_ymm(dst0, dst0, srcT, dst1, dst1, src1);
+    Acc::m256iPackPU8FromPU16(dst0, dst0, dst1);
+  }
+
+  //! @brief Composite packed pixels in @a dst0 with unpacked pixels in
+  //! @a sru0 / @a sru1 using unpacked masks @a m0 / @a m1.
+  static FOG_INLINE void prgb32_op_unpacked_masked_packed(
+    __m256i& dst0, const __m256i& sru0, const __m256i& sru1, const __m256i& m0, const __m256i& m1)
+  {
+    __m256i dst1;
+
+    Acc::m256iUnpackPI16FromPI8Hi(dst1, dst0);
+    Acc::m256iUnpackPI16FromPI8Lo(dst0, dst0);
+    CompositeOp::prgb32_op_prgb32_masked_ymm(dst0, dst0, sru0, m0, dst1, dst1, sru1, m1);
+    Acc::m256iPackPU8FromPU16(dst0, dst0, dst1);
+  }
+
+  //! @brief Composite packed pixels in @a dst0 with packed pixels in @a src0
+  //! using unpacked masks @a m0 / @a m1.
+  static FOG_INLINE void prgb32_op_prgb32_masked_packed(
+    __m256i& dst0, const __m256i& src0, const __m256i& m0, const __m256i& m1)
+  {
+    __m256i src1, srcT;
+
+    Acc::m256iUnpackPI16FromPI8Hi(src1, src0);
+    Acc::m256iUnpackPI16FromPI8Lo(srcT, src0);
+    prgb32_op_unpacked_masked_packed(dst0, srcT, src1, m0, m1);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_cblit_prgb32_line(
+    uint8_t* dst, const __m256i& sru0, int w)
+  {
+    Acc::prefetchT0(dst);
+
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Opaque)
+      __m256i dst0;
+
+      Acc::m256iLoad4(dst0, dst);
+      prgb32_op_solid_packed(dst0, sru0);
+      Acc::m256iStore4(dst, dst0);
+
+      dst += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i dst0;
+
+      Acc::m256iLoad32a(dst0, dst);
+      prgb32_op_solid_packed(dst0, sru0);
+      Acc::m256iStore32a(dst, dst0);
+
+      dst += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+  }
+
+  static FOG_INLINE void _prgb32_cblit_prgb32_line_mask(
+    uint8_t* dst, const __m256i& sru0, const __m256i& msk0, int w)
+  {
+    Acc::prefetchT0(dst);
+
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Mask)
+      __m256i dst0;
+
+      Acc::m256iLoad4(dst0, dst);
+      prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk0);
+      Acc::m256iStore4(dst, dst0);
+
+      dst += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Mask)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Mask)
+      __m256i dst0;
+
+      Acc::m256iLoad32a(dst0, dst);
+      prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk0);
+      Acc::m256iStore32a(dst, dst0);
+
+      dst += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Mask)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_cblit_prgb32_line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    __m256i sru0;
+
+    unpack_solid(sru0, src);
+    CompositeOp::_prgb32_cblit_prgb32_line(dst, sru0, w);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_cblit_prgb32_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m256i sru0;
+    unpack_solid(sru0, src);
+
+    FOG_CBLIT_SPAN8_BEGIN(4)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_OPAQUE()
+    {
+      CompositeOp::_prgb32_cblit_prgb32_line(dst, sru0, w);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_MASK()
+    {
+      __m256i msk0ymm;
+
+      Acc::m256iExpandPI16FromSI16(msk0ymm, msk0);
+      CompositeOp::_prgb32_cblit_prgb32_line_mask(dst, sru0, msk0ymm, w);
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(A8_Glyph)
+        __m256i dst0;
+        __m256i msk0;
+        uint32_t msk0p = msk[0];
+
+        if (msk0p == 0x00)
+          goto _A8_Glyph_Small_Skip;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iExpandPI16FromSI16(msk0, msk0p + (msk0p >> 7));
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+_A8_Glyph_Small_Skip:
+        dst += 4;
+        msk += 1;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(A8_Glyph)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(A8_Glyph)
+        __m256i dst0;
+        __m256i msk0, msk1;
+
+        if (reinterpret_cast<const uint32_t*>(msk)[0] == 0 &&
+            reinterpret_cast<const uint32_t*>(msk)[1] == 0)
+          goto _A8_Glyph_Main_Skip;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iUnpackMask8PI16FromPU8(msk0, msk1, msk);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk1, msk1);
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+_A8_Glyph_Main_Skip:
+        dst += 32;
+        msk += 8;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(A8_Extra)
+        __m256i dst0;
+        __m256i msk0;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iExpandPI16FromSI16(msk0, reinterpret_cast<const uint16_t*>(msk)[0]);
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+        dst += 4;
+        msk += 2;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(A8_Extra)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(A8_Extra)
+        __m256i dst0;
+        __m256i msk0, msk1;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iUnpackMask8PI16FromPU16(msk0, msk1, msk);
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+        dst += 32;
+        msk += 16;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(ARGB32_Glyph)
+        __m256i dst0;
+        __m256i msk0;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iLoad4(msk0, msk);
+        Acc::m256iUnpackPI16FromPI8Lo(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+        dst += 4;
+        msk += 4;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(ARGB32_Glyph)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(ARGB32_Glyph)
+        __m256i dst0;
+        __m256i msk0, msk1;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iLoad32u(msk0, msk);
+        Acc::m256iUnpackPI16FromPI8Hi(msk1, msk0);
+        Acc::m256iUnpackPI16FromPI8Lo(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk1, msk1);
+        prgb32_op_unpacked_masked_packed(dst0, sru0, sru0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+        dst += 32;
+        msk += 32;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(ARGB32_Glyph)
+    }
+
+    FOG_CBLIT_SPAN8_END()
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Opaque)
+      __m256i dst0, src0;
+
+      Acc::m256iLoad4(dst0, dst);
+      Acc::m256iLoad4(src0, src);
+      prgb32_op_prgb32_packed(dst0, src0);
+      Acc::m256iStore4(dst, dst0);
+
+      dst += 4;
+      src += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i dst0, src0;
+
+      Acc::m256iLoad32a(dst0, dst);
+      Acc::m256iLoad32u(src0, src);
+      prgb32_op_prgb32_packed(dst0, src0);
+      Acc::m256iStore32a(dst, dst0);
+
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    CompositeOp::_prgb32_vblit_prgb32_line(dst, src, w);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb32_vblit_prgb32_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    FOG_VBLIT_SPAN8_BEGIN(4)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_OPAQUE()
+    {
+      CompositeOp::_prgb32_vblit_prgb32_line(dst, src, w);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_MASK()
+    {
+      __m256i msk0ymm;
+      Acc::m256iExpandPI16FromSI16(msk0ymm, msk0);
+
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Mask)
+        __m256i dst0, src0;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iLoad4(src0, src);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0ymm, msk0ymm);
+        Acc::m256iStore4(dst, dst0);
+
+        dst += 4;
+        src += 4;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Mask)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Mask)
+        __m256i dst0, src0;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iLoad32u(src0, src);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0ymm, msk0ymm);
+        Acc::m256iStore32a(dst, dst0);
+
+        dst += 32;
+        src += 32;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Mask)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(A8_Glyph)
+        __m256i dst0, src0;
+        __m256i msk0;
+        uint32_t msk0p = msk[0];
+
+        if (msk0p == 0x00)
+          goto _A8_Glyph_Small_Skip;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iLoad4(src0, src);
+        Acc::m256iExpandPI16FromSI16(msk0, msk0p + (msk0p >> 7));
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+_A8_Glyph_Small_Skip:
+        dst += 4;
+        src += 4;
+        msk += 1;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(A8_Glyph)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(A8_Glyph)
+        __m256i dst0, src0;
+        __m256i msk0, msk1;
+
+        if (reinterpret_cast<const uint32_t*>(msk)[0] == 0 &&
+            reinterpret_cast<const uint32_t*>(msk)[1] == 0)
+          goto _A8_Glyph_Main_Skip;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iLoad32u(src0, src);
+        Acc::m256iUnpackMask8PI16FromPU8(msk0, msk1, msk);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk1, msk1);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+_A8_Glyph_Main_Skip:
+        dst += 32;
+        src += 32;
+        msk += 8;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(A8_Extra)
+        __m256i dst0, src0;
+        __m256i msk0;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iLoad4(src0, src);
+        Acc::m256iExpandPI16FromSI16(msk0, reinterpret_cast<const uint16_t*>(msk)[0]);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+        dst += 4;
+        src += 4;
+        msk += 2;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(A8_Extra)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(A8_Extra)
+        __m256i dst0, src0;
+        __m256i msk0, msk1;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iLoad32u(src0, src);
+        Acc::m256iUnpackMask8PI16FromPU16(msk0, msk1, msk);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+        dst += 32;
+        src += 32;
+        msk += 16;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(ARGB32_Glyph)
+        __m256i dst0, src0;
+        __m256i msk0;
+
+        Acc::m256iLoad4(dst0, dst);
+        Acc::m256iLoad4(src0, src);
+        Acc::m256iLoad4(msk0, msk);
+        Acc::m256iUnpackPI16FromPI8Lo(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk0);
+        Acc::m256iStore4(dst, dst0);
+
+        dst += 4;
+        src += 4;
+        msk += 4;
+      FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(ARGB32_Glyph)
+
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(ARGB32_Glyph)
+        __m256i dst0, src0;
+        __m256i msk0, msk1;
+
+        Acc::m256iLoad32a(dst0, dst);
+        Acc::m256iLoad32u(src0, src);
+        Acc::m256iLoad32u(msk0, msk);
+        Acc::m256iUnpackPI16FromPI8Hi(msk1, msk0);
+        Acc::m256iUnpackPI16FromPI8Lo(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk0, msk0);
+        Acc::m256iCvt256From255PI16(msk1, msk1);
+        prgb32_op_prgb32_masked_packed(dst0, src0, msk0, msk1);
+        Acc::m256iStore32a(dst, dst0);
+
+        dst += 32;
+        src += 32;
+        msk += 32;
+      FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(ARGB32_Glyph)
+    }
+
+    FOG_VBLIT_SPAN8_END()
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEBASE_P_H
@@ -0,0 +1,108 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEEXT_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEEXT_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeBase_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositePlus]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositePlus : public CompositeGeneric<CompositePlus>
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_PLUS };
+
+  //! @brief Dca' = Clamp(Dca + Sca).
+  static FOG_INLINE void prgb32_op_prgb32_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1)
+  {
+    Acc::m256iAddPI16(dst0, a0, b0);
+    Acc::m256iAddPI16(dst1, a1, b1);
+    Acc::m256iMinPU16(dst0, dst0, FOG_YMM_GET_CONST_PI(00FF00FF00FF00FF_00FF00FF00FF00FF));
+    Acc::m256iMinPU16(dst1, dst1, FOG_YMM_GET_CONST_PI(00FF00FF00FF00FF_00FF00FF00FF00FF));
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeMultiply]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeMultiply : public CompositeGeneric<CompositeMultiply>
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_MULTIPLY };
+
+  //! @brief Dca' = Dca.Sca + Dca.(1 - Sa) + Sca.(1 - Da).
+  static FOG_INLINE void prgb32_op_prgb32_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1)
+  {
+    __m256i ia0, ia1;
+    __m256i ib0, ib1;
+    __m256i t0, t1;
+
+    Acc::m256iExpandAlphaPI16_2x(ia0, a0, ia1, a1);
+    Acc::m256iExpandAlphaPI16_2x(ib0, b0, ib1, b1);
+    Acc::m256iNegate255PI16(ia0, ia0);
+    Acc::m256iNegate255PI16(ia1, ia1);
+    Acc::m256iNegate255PI16(ib0, ib0);
+    Acc::m256iNegate255PI16(ib1, ib1);
+
+    Acc::m256iMulLoPI16(t0, a0, b0);
+    Acc::m256iMulLoPI16(t1, a1, b1);
+    Acc::m256iMulLoPI16(ib0, ib0, a0);
+    Acc::m256iMulLoPI16(ib1, ib1, a1);
+    Acc::m256iMulLoPI16(ia0, ia0, b0);
+    Acc::m256iMulLoPI16(ia1, ia1, b1);
+
+    Acc::m256iAddPI16(t0, t0, ib0);
+    Acc::m256iAddPI16(t1, t1, ib1);
+    Acc::m256iAddPI16(t0, t0, ia0);
+    Acc::m256iAddPI16(t1, t1, ia1);
+
+    Acc::m256iDiv255PI16(dst0, t0);
+    Acc::m256iDiv255PI16(dst1, t1);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeScreen]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeScreen : public CompositeGeneric<CompositeScreen>
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SCREEN };
+
+  //! @brief Dca' = Sca + Dca.(1 - Sca).
+  static FOG_INLINE void prgb32_op_prgb32_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1)
+  {
+    __m256i ib0, ib1;
+
+    Acc::m256iNegate255PI16(ib0, b0);
+    Acc::m256iNegate255PI16(ib1, b1);
+
+    Acc::m256iMulDiv255PI16_2x(dst0, a0, ib0, dst1, a1, ib1);
+    Acc::m256iAddPI16(dst0, dst0, b0);
+    Acc::m256iAddPI16(dst1, dst1, b1);
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITEEXT_P_H
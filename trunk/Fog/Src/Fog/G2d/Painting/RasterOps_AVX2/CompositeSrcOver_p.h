@@ -0,0 +1,115 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeBase_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeSrcOver]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeSrcOver : public CompositeGeneric<CompositeSrcOver>
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SRC_OVER };
+
+  // ==========================================================================
+  // [Op]
+  // ==========================================================================
+
+  //! @brief Dca' = Sca + Dca.(1 - Sa).
+  static FOG_INLINE void prgb32_op_prgb32_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1)
+  {
+    __m256i ia0, ia1;
+
+    Acc::m256iExpandAlphaPI16_2x(ia0, b0, ia1, b1);
+    Acc::m256iNegate255PI16(ia0, ia0);
+    Acc::m256iNegate255PI16(ia1, ia1);
+
+    Acc::m256iMulDiv255PI16_2x(dst0, a0, ia0, dst1, a1, ia1);
+    Acc::m256iAddPI16(dst0, dst0, b0);
+    Acc::m256iAddPI16(dst1, dst1, b1);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  //! @brief SrcOver line, fully transparent and fully opaque groups of 8
+  //! source pixels are detected and handled without unpacking.
+  static FOG_INLINE void _prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Opaque)
+      __m256i dst0, src0;
+      uint32_t src0p = reinterpret_cast<const uint32_t*>(src)[0];
+
+      if (src0p == 0x00000000)
+        goto _C_Opaque_Small_Skip;
+
+      if (src0p >= 0xFF000000)
+      {
+        reinterpret_cast<uint32_t*>(dst)[0] = src0p;
+        goto _C_Opaque_Small_Skip;
+      }
+
+      Acc::m256iLoad4(dst0, dst);
+      Acc::m256iExpandPI32FromSI32(src0, src0p);
+      prgb32_op_prgb32_packed(dst0, src0);
+      Acc::m256iStore4(dst, dst0);
+
+_C_Opaque_Small_Skip:
+      dst += 4;
+      src += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i dst0, src0;
+      __m256i alpha0;
+      uint32_t alphaMsk;
+
+      Acc::m256iLoad32u(src0, src);
+      Acc::m256iAnd(alpha0, src0, FOG_YMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      Acc::m256iCmpEqPI32(alpha0, alpha0, FOG_YMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000));
+      alphaMsk = Acc::m256iMoveMaskPI8(alpha0);
+
+      if (alphaMsk == 0xFFFFFFFF)
+      {
+        Acc::m256iStore32a(dst, src0);
+        goto _C_Opaque_Main_Skip;
+      }
+
+      Acc::m256iZero(alpha0);
+      Acc::m256iCmpEqPI32(alpha0, alpha0, src0);
+      if (Acc::m256iMoveMaskPI8(alpha0) == 0xFFFFFFFF)
+        goto _C_Opaque_Main_Skip;
+
+      Acc::m256iLoad32a(dst0, dst);
+      prgb32_op_prgb32_packed(dst0, src0);
+      Acc::m256iStore32a(dst, dst0);
+
+_C_Opaque_Main_Skip:
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRCOVER_P_H
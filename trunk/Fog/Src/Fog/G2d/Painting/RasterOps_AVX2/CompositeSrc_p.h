@@ -0,0 +1,111 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/CompositeBase_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - CompositeSrc]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT CompositeSrc : public CompositeGeneric<CompositeSrc>
+{
+  enum { COMBINE_FLAGS = RASTER_COMBINE_OP_SRC };
+
+  // ==========================================================================
+  // [Op]
+  // ==========================================================================
+
+  static FOG_INLINE void prgb32_op_prgb32_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1)
+  {
+    dst0 = b0;
+    dst1 = b1;
+  }
+
+  //! @brief The SRC operator is not linear with the source, the mask is used
+  //! to interpolate between the destination and the source.
+  static FOG_INLINE void prgb32_op_prgb32_masked_ymm(
+    __m256i& dst0, const __m256i& a0, const __m256i& b0, const __m256i& m0,
+    __m256i& dst1, const __m256i& a1, const __m256i& b1, const __m256i& m1)
+  {
+    __m256i im0, im1;
+    __m256i t0, t1;
+
+    Acc::m256iNegate256PI16(im0, m0);
+    Acc::m256iNegate256PI16(im1, m1);
+
+    Acc::m256iMulDiv256PI16_2x(t0, b0, m0, t1, b1, m1);
+    Acc::m256iMulDiv256PI16_2x(dst0, a0, im0, dst1, a1, im1);
+
+    Acc::m256iAddPI16(dst0, dst0, t0);
+    Acc::m256iAddPI16(dst1, dst1, t1);
+  }
+
+  // ==========================================================================
+  // [PRGB32 - CBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_cblit_prgb32_line(
+    uint8_t* dst, const __m256i& sru0, int w)
+  {
+    __m256i sro0;
+    Acc::m256iPackPU8FromPU16(sro0, sru0, sru0);
+
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Opaque)
+      Acc::m256iStore4(dst, sro0);
+      dst += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      Acc::m256iStore32a(dst, sro0);
+      dst += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB32 - VBlit - PRGB32 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb32_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w)
+  {
+    FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(C_Opaque)
+      reinterpret_cast<uint32_t*>(dst)[0] = reinterpret_cast<const uint32_t*>(src)[0];
+
+      dst += 4;
+      src += 4;
+    FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(C_Opaque)
+      __m256i src0;
+
+      Acc::m256iLoad32u(src0, src);
+      Acc::m256iStore32a(dst, src0);
+
+      dst += 32;
+      src += 32;
+    FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(C_Opaque)
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_COMPOSITESRC_P_H
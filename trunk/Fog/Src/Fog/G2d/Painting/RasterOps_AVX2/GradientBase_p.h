@@ -0,0 +1,276 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTBASE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTBASE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Geometry/Math2d.h>
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PGradientBase]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT PGradientBase
+{
+  // ==========================================================================
+  // [Interpolate]
+  // ==========================================================================
+
+  static void FOG_FASTCALL interpolate_prgb32(uint8_t* _dst, int _wTotal, const ColorStop* stops, size_t length)
+  {
+    FOG_ASSUME(length >= 1);
+
+    // ------------------------------------------------------------------------
+    // [Solid]
+    // ------------------------------------------------------------------------
+
+    uint32_t c0 = stops[0].getArgb32();
+    uint32_t c1;
+
+    if (length == 1)
+    {
+      __m128i pix0;
+      Acc::m128iCvtSI128FromSI(pix0, c0);
+      Acc::m128iPRGB32FromARGB32Lo_PBB(pix0, pix0);
+
+      do {
+        Acc::m128iStore4(_dst, pix0);
+        _dst += 4;
+      } while (--_wTotal);
+      return;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    _wTotal--;
+
+    uint p0 = 0;
+    uint p1;
+
+    float wf = (float)(_wTotal << 8);
+
+    // ------------------------------------------------------------------------
+    // [Loop]
+    // ------------------------------------------------------------------------
+
+    size_t pos;
+    for (pos = 0; pos < length; pos++)
+    {
+      c1 = stops[pos].getArgb32();
+      p1 = Math::uround(stops[pos].getOffset() * wf);
+
+      uint len = (p1 >> 8) - (p0 >> 8);
+      uint8_t* dst = _dst + (p0 >> 8) * 4;
+
+      if (len > 0)
+      {
+        int w = len + 1;
+
+        if (c0 == c1)
+        {
+          uint32_t pix0p;
+          __m256i pix0;
+
+          Acc::p32PRGB32FromARGB32(pix0p, c0);
+          Acc::m256iExpandPI32FromSI32(pix0, pix0p);
+
+          FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+          FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(G_Solid)
+            Acc::m256iStore4(dst, pix0);
+            dst += 4;
+          FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(G_Solid)
+
+          FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(G_Solid)
+            Acc::m256iStore32a(dst, pix0);
+            dst += 32;
+          FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(G_Solid)
+        }
+        else
+        {
+          // The setup of a single pixel is the same as in the SSE2 version,
+          // the 8.24 fixed point positions are then expanded to two pixels
+          // per YMM register.
+          __m128i pos0xmm;
+          __m128i inc0xmm;
+          __m128i msk0xmm;
+
+          xmm_t t;
+
+          Acc::m128iCvtSI128FromSI(pos0xmm, c0);
+          Acc::m128iCvtSI128FromSI(inc0xmm, c1);
+
+          Acc::m128iUnpackPI16FromPI8Lo(pos0xmm, pos0xmm);
+          Acc::m128iUnpackPI16FromPI8Lo(inc0xmm, inc0xmm);
+
+          Acc::m128iCmpGtPI16(msk0xmm, pos0xmm, inc0xmm);
+          Acc::m128iRShiftPU16<8>(msk0xmm, msk0xmm);
+
+          Acc::m128iXor(pos0xmm, pos0xmm, msk0xmm);
+          Acc::m128iXor(inc0xmm, inc0xmm, msk0xmm);
+
+          Acc::m128iUnpackPI32FromPI16Lo(pos0xmm, pos0xmm, pos0xmm);
+          Acc::m128iUnpackPI32FromPI16Lo(inc0xmm, inc0xmm, inc0xmm);
+
+          Acc::m128iSubPI16(inc0xmm, inc0xmm, pos0xmm);
+          Acc::m128iLShiftPU32<24>(pos0xmm, pos0xmm);
+          Acc::m128iLShiftPU32<24>(inc0xmm, inc0xmm);
+
+          t.m128i = inc0xmm;
+
+          t.ud[0] /= len;
+          t.ud[1] /= len;
+          t.ud[2] /= len;
+          t.ud[3] /= len;
+
+          Acc::m128iAddPI32(pos0xmm, pos0xmm, FOG_XMM_GET_CONST_PI(0080000000800000_0080000000800000));
+          Acc::m128iShufflePI32<1, 0, 1, 0>(msk0xmm, msk0xmm);
+          inc0xmm = t.m128i;
+
+          __m256i pos0;
+          __m256i inc1;
+          __m256i inc2;
+          __m256i msk0;
+
+          Acc::m256iExpandSI256FromSI128(inc1, inc0xmm);
+          Acc::m256iAddPI32(inc2, inc1, inc1);
+          Acc::m256iExpandSI256FromSI128(msk0, msk0xmm);
+
+          Acc::m128iAddPI32(t.m128i, pos0xmm, inc0xmm);
+          Acc::m256iCombineSI256FromSI128(pos0, pos0xmm, t.m128i);
+
+          if (Acc::p32ARGB32IsAlphaFF(c0 & c1))
+          {
+            Acc::m256iPackPU8FromPU16(msk0, msk0, msk0);
+
+            FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+            FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(G_XRGB)
+              __m256i pix0;
+
+              Acc::m256iRShiftPU32<24>(pix0, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc1);
+
+              Acc::m256iPackPI16FromPI32(pix0, pix0, pix0);
+              Acc::m256iPackPU8FromPU16(pix0, pix0, pix0);
+              Acc::m256iXor(pix0, pix0, msk0);
+              Acc::m256iStore4(dst, pix0);
+
+              dst += 4;
+            FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(G_XRGB)
+
+            FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(G_XRGB)
+              __m256i pix0, pix1, pix2, pix3;
+
+              Acc::m256iRShiftPU32<24>(pix0, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix1, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix2, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix3, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+
+              Acc::m256iPackPI16FromPI32(pix0, pix0, pix1);
+              Acc::m256iPackPI16FromPI32(pix2, pix2, pix3);
+              Acc::m256iPackPU8FromPU16(pix0, pix0, pix2);
+
+              Acc::m256iXor(pix0, pix0, msk0);
+              Acc::m256iPermutePI32(pix0, pix0, FOG_YMM_GET_CONST_PI(0000000700000003_0000000600000002_0000000500000001_0000000400000000));
+              Acc::m256iStore32a(dst, pix0);
+
+              dst += 32;
+            FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(G_XRGB)
+          }
+          else
+          {
+            FOG_BLIT_LOOP_32x8_AVX2_INIT()
+
+            FOG_BLIT_LOOP_32x8_AVX2_SMALL_BEGIN(G_ARGB)
+              __m256i pix0;
+
+              Acc::m256iRShiftPU32<24>(pix0, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc1);
+              Acc::m256iPackPI16FromPI32(pix0, pix0, pix0);
+
+              Acc::m256iXor(pix0, pix0, msk0);
+              Acc::m256iPRGB32FromARGB32_PBW(pix0, pix0);
+
+              Acc::m256iPackPU8FromPU16(pix0, pix0, pix0);
+              Acc::m256iStore4(dst, pix0);
+
+              dst += 4;
+            FOG_BLIT_LOOP_32x8_AVX2_SMALL_END(G_ARGB)
+
+            FOG_BLIT_LOOP_32x8_AVX2_MAIN_BEGIN(G_ARGB)
+              __m256i pix0, pix1, pix2, pix3;
+
+              Acc::m256iRShiftPU32<24>(pix0, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix1, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix2, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+              Acc::m256iRShiftPU32<24>(pix3, pos0);
+              Acc::m256iAddPI32(pos0, pos0, inc2);
+
+              Acc::m256iPackPI16FromPI32(pix0, pix0, pix1);
+              Acc::m256iPackPI16FromPI32(pix2, pix2, pix3);
+
+              Acc::m256iXor(pix0, pix0, msk0);
+              Acc::m256iXor(pix2, pix2, msk0);
+              Acc::m256iPRGB32FromARGB32_PBW(pix0, pix0);
+              Acc::m256iPRGB32FromARGB32_PBW(pix2, pix2);
+
+              Acc::m256iPackPU8FromPU16(pix0, pix0, pix2);
+              Acc::m256iPermutePI32(pix0, pix0, FOG_YMM_GET_CONST_PI(0000000700000003_0000000600000002_0000000500000001_0000000400000000));
+              Acc::m256iStore32a(dst, pix0);
+
+              dst += 32;
+            FOG_BLIT_LOOP_32x8_AVX2_MAIN_END(G_ARGB)
+          }
+        }
+      }
+      else
+      {
+        Acc::p32PRGB32FromARGB32(reinterpret_cast<uint32_t*>(dst)[0], c1);
+      }
+
+      c0 = c1;
+      p0 = p1;
+    }
+
+    p1 >>= 8;
+    if (p1 < (uint)_wTotal)
+    {
+      uint32_t pix0;
+      Acc::p32PRGB32FromARGB32(pix0, c1);
+
+      uint8_t* dst = _dst + p1 * 4;
+      int w = (uint)_wTotal - p1 + 1;
+
+      FOG_ASSUME(w > 0);
+      do {
+        reinterpret_cast<uint32_t*>(dst)[0] = pix0;
+        dst += 4;
+      } while (--w);
+    }
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTBASE_P_H
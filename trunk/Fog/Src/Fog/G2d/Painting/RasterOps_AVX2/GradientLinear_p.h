@@ -0,0 +1,113 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/GradientBase_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PGradientLinear]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT PGradientLinear
+{
+  // ==========================================================================
+  // [Fetch - Simple - Pad]
+  // ==========================================================================
+
+  //! @brief Fetch simple linear gradient (PRGB32/XRGB32), pad spread.
+  //!
+  //! Eight positions are computed at a time, clamped to the table range and
+  //! gathered. Clamping the integer part to [0, len] gives exactly the same
+  //! result as the C version which handles the pad areas separately.
+  static void FOG_FASTCALL fetch_simple_nearest_pad_prgb32(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+
+    P_FETCH_SPAN8_INIT()
+
+    int xx = ctx->_d.gradient.linear.simple.xx16x16;
+    int len = ctx->_d.gradient.base.len;
+
+    int pos = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt) + x * xx;
+
+    __m256i xx0;
+    __m256i xx8;
+    __m256i len0;
+    __m256i zero0;
+
+    Acc::m256iExpandPI32FromSI32(xx0, (uint32_t)xx);
+    Acc::m256iExpandPI32FromSI32(xx8, (uint32_t)(xx * 8));
+    Acc::m256iExpandPI32FromSI32(len0, (uint32_t)len);
+    Acc::m256iZero(zero0);
+
+    Acc::m256iMulLoPI32(xx0, xx0,
+      FOG_YMM_GET_CONST_PI(0000000700000006_0000000500000004_0000000300000002_0000000100000000));
+
+    P_FETCH_SPAN8_BEGIN()
+      P_FETCH_SPAN8_SET_CURRENT()
+
+      if (w >= 8)
+      {
+        __m256i pos0;
+
+        Acc::m256iExpandPI32FromSI32(pos0, (uint32_t)pos);
+        Acc::m256iAddPI32(pos0, pos0, xx0);
+
+        do {
+          __m256i idx0;
+          __m256i pix0;
+
+          Acc::m256iRShiftPI32<16>(idx0, pos0);
+          Acc::m256iAddPI32(pos0, pos0, xx8);
+
+          Acc::m256iMaxPI32(idx0, idx0, zero0);
+          Acc::m256iMinPI32(idx0, idx0, len0);
+
+          Acc::m256iGatherPI32<4>(pix0, table, idx0);
+          Acc::m256iStore32u(dst, pix0);
+
+          dst += 32;
+          pos += xx * 8;
+          w -= 8;
+        } while (w >= 8);
+
+        if (w == 0)
+          goto _FetchSkip;
+      }
+
+      do {
+        int idx = Math::bound<int>(pos >> 16, 0, len);
+
+        reinterpret_cast<uint32_t*>(dst)[0] = table[idx];
+        dst += 4;
+        pos += xx;
+      } while (--w);
+
+_FetchSkip:
+      P_FETCH_SPAN8_HOLE(
+      {
+        pos += hole * xx;
+      })
+    P_FETCH_SPAN8_END()
+
+    fetcher->_d.gradient.linear.simple.pt += fetcher->_d.gradient.linear.simple.dt;
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_GRADIENTLINEAR_P_H
@@ -0,0 +1,236 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTUREAFFINE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTUREAFFINE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_AVX2/BaseDefs_p.h>
+
+namespace Fog {
+namespace RasterOps_AVX2 {
+
+// ============================================================================
+// [Fog::RasterOps_AVX2 - PTextureAffine]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT PTextureAffine
+{
+  enum { MAX_FIXED_STEP = 128 };
+
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  template<uint32_t SrcFormat>
+  static FOG_INLINE void store_pixel(uint8_t* dst, uint32_t pix0)
+  {
+    if (SrcFormat == IMAGE_FORMAT_XRGB32)
+      pix0 |= 0xFF000000;
+    reinterpret_cast<uint32_t*>(dst)[0] = pix0;
+  }
+
+  // ==========================================================================
+  // [Fetch - Affine - Nearest - Pad]
+  // ==========================================================================
+
+  //! @brief Fetch affine transformed PRGB32/XRGB32 texture, nearest neighbor,
+  //! pad tile.
+  //!
+  //! The fixed-point path computes and clamps eight coordinates at a time and
+  //! uses gather to fetch the pixels, the float path (used when the fixed
+  //! point would overflow) is scalar.
+  template<uint32_t SrcFormat>
+  static void FOG_FASTCALL fetch_affine_nearest_pad(
+    RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    // ------------------------------------------------------------------------
+    // [Prepare]
+    // ------------------------------------------------------------------------
+
+    int tw = ctx->_d.texture.base.w;
+    int th = ctx->_d.texture.base.h;
+
+    double xx = ctx->_d.texture.affine.xx;
+    double xy = ctx->_d.texture.affine.xy;
+
+    double offx = fetcher->_d.texture.affine.px;
+    double offy = fetcher->_d.texture.affine.py;
+
+    const uint8_t* srcPixels = ctx->_d.texture.base.pixels;
+    ssize_t srcStride = ctx->_d.texture.base.stride;
+
+    P_FETCH_SPAN8_INIT()
+
+    tw--;
+    th--;
+
+    // ------------------------------------------------------------------------
+    // [Loop - FixedPoint]
+    // ------------------------------------------------------------------------
+
+    if (ctx->_d.texture.affine.safeFixedPoint)
+    {
+      int xx16x16 = ctx->_d.texture.affine.xx16x16;
+      int xy16x16 = ctx->_d.texture.affine.xy16x16;
+
+      // If xyZero is set all pixels in a span share the same row, the stride
+      // multiplier is set to zero in such case and the row is selected once.
+      int yStride = (int)srcStride;
+      if (ctx->_d.texture.affine.xyZero)
+      {
+        int py0 = Math::bound<int>(Math::fixed16x16FromFloat(offy) >> 16, 0, th);
+        srcPixels += py0 * srcStride;
+
+        xy16x16 = 0;
+        yStride = 0;
+      }
+
+      __m256i seq0;
+      __m256i xx0, xx8;
+      __m256i xy0, xy8;
+      __m256i tw0, th0;
+      __m256i stride0;
+      __m256i zero0;
+      __m256i fill0;
+
+      seq0 = FOG_YMM_GET_CONST_PI(0000000700000006_0000000500000004_0000000300000002_0000000100000000);
+
+      Acc::m256iExpandPI32FromSI32(xx0, (uint32_t)xx16x16);
+      Acc::m256iExpandPI32FromSI32(xx8, (uint32_t)(xx16x16 * 8));
+      Acc::m256iExpandPI32FromSI32(xy0, (uint32_t)xy16x16);
+      Acc::m256iExpandPI32FromSI32(xy8, (uint32_t)(xy16x16 * 8));
+      Acc::m256iMulLoPI32(xx0, xx0, seq0);
+      Acc::m256iMulLoPI32(xy0, xy0, seq0);
+
+      Acc::m256iExpandPI32FromSI32(tw0, (uint32_t)tw);
+      Acc::m256iExpandPI32FromSI32(th0, (uint32_t)th);
+      Acc::m256iExpandPI32FromSI32(stride0, (uint32_t)yStride);
+      Acc::m256iZero(zero0);
+
+      if (SrcFormat == IMAGE_FORMAT_XRGB32)
+        fill0 = FOG_YMM_GET_CONST_PI(FF000000FF000000_FF000000FF000000);
+      else
+        Acc::m256iZero(fill0);
+
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT_AND_MERGE_NEIGHBORS(4)
+        double _x = (double)x;
+
+        for (;;)
+        {
+          int i = Math::min<int>(w, MAX_FIXED_STEP);
+          int px = Math::fixed16x16FromFloat(offx + _x * xx);
+          int py = Math::fixed16x16FromFloat(offy + _x * xy);
+
+          w -= i;
+
+          if (i >= 8)
+          {
+            __m256i px0, py0;
+
+            Acc::m256iExpandPI32FromSI32(px0, (uint32_t)px);
+            Acc::m256iExpandPI32FromSI32(py0, (uint32_t)py);
+            Acc::m256iAddPI32(px0, px0, xx0);
+            Acc::m256iAddPI32(py0, py0, xy0);
+
+            do {
+              __m256i ix0, iy0;
+              __m256i pix0;
+
+              Acc::m256iRShiftPI32<16>(ix0, px0);
+              Acc::m256iRShiftPI32<16>(iy0, py0);
+              Acc::m256iAddPI32(px0, px0, xx8);
+              Acc::m256iAddPI32(py0, py0, xy8);
+
+              Acc::m256iMaxPI32(ix0, ix0, zero0);
+              Acc::m256iMaxPI32(iy0, iy0, zero0);
+              Acc::m256iMinPI32(ix0, ix0, tw0);
+              Acc::m256iMinPI32(iy0, iy0, th0);
+
+              Acc::m256iMulLoPI32(iy0, iy0, stride0);
+              Acc::m256iLShiftPU32<2>(ix0, ix0);
+              Acc::m256iAddPI32(ix0, ix0, iy0);
+
+              Acc::m256iGatherPI32<1>(pix0, srcPixels, ix0);
+              Acc::m256iOr(pix0, pix0, fill0);
+              Acc::m256iStore32u(dst, pix0);
+
+              dst += 32;
+              px += xx16x16 * 8;
+              py += xy16x16 * 8;
+              i -= 8;
+            } while (i >= 8);
+          }
+
+          while (i)
+          {
+            int px0 = Math::bound<int>(px >> 16, 0, tw);
+            int py0 = Math::bound<int>(py >> 16, 0, th);
+
+            store_pixel<SrcFormat>(dst,
+              reinterpret_cast<const uint32_t*>(srcPixels + (ssize_t)py0 * yStride)[px0]);
+
+            dst += 4;
+            px += xx16x16;
+            py += xy16x16;
+            i--;
+          }
+
+          if (w == 0) break;
+          _x += (double)MAX_FIXED_STEP;
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Loop - Float]
+    // ------------------------------------------------------------------------
+
+    else
+    {
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT()
+        double _x = (double)x;
+
+        double px = offx + _x * xx;
+        double py = offy + _x * xy;
+
+        do {
+          int px0 = Math::bound<int>((int)px, 0, tw);
+          int py0 = Math::bound<int>((int)py, 0, th);
+
+          store_pixel<SrcFormat>(dst,
+            reinterpret_cast<const uint32_t*>(srcPixels + py0 * srcStride)[px0]);
+
+          dst += 4;
+          px += xx;
+          py += xy;
+        } while (--w);
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+
+    // ------------------------------------------------------------------------
+    // [Advance]
+    // ------------------------------------------------------------------------
+
+    fetcher->_d.texture.affine.px += fetcher->_d.texture.affine.dx;
+    fetcher->_d.texture.affine.py += fetcher->_d.texture.affine.dy;
+  }
+};
+
+} // RasterOps_AVX2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_AVX2_TEXTUREAFFINE_P_H
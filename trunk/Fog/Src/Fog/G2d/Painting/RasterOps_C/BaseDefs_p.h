@@ -1214,7 +1214,6 @@ _##_Group_##_SmallBegin: \
   w -= 2; \
   if (w < 0) goto _##_Group_##_MainSkip; \
   \
-_##_Group_##_MainLoop: \
   for (;;) {
 
 #define FOG_BLIT_LOOP_64x2_MAIN_CONTINUE(_Group_) \
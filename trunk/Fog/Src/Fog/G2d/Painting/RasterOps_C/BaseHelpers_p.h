@@ -122,6 +122,52 @@ struct FOG_NO_EXPORT Helpers
     return dst + w;
   }
 
+  static FOG_INLINE uint8_t* p_fill_prgb64(uint8_t* dst, const __p64& c0, int w)
+  {
+    do {
+      Acc::p64Store8a(dst, c0);
+      dst += 8;
+    } while (--w);
+    return dst;
+  }
+
+  static FOG_INLINE uint8_t* p_fill_rgb48(uint8_t* dst, const __p64& c0, int w)
+  {
+    do {
+      Acc::p64Store6a(dst, c0);
+      dst += 6;
+    } while (--w);
+    return dst;
+  }
+
+  static FOG_INLINE uint8_t* p_fill_a16(uint8_t* dst, uint32_t c0, int w)
+  {
+    do {
+      Acc::p32Store2a(dst, c0);
+      dst += 2;
+    } while (--w);
+    return dst;
+  }
+
+  //! @brief Fill @a w pixels of @a dstFormat (PRGB64, RGB48 or A16) using
+  //! the 16-bit per component @a solid color.
+  static FOG_INLINE uint8_t* p_fill_wide(uint8_t* dst, uint32_t dstFormat, const RasterSolid& solid, int w)
+  {
+    switch (dstFormat)
+    {
+      case IMAGE_FORMAT_PRGB64:
+        return p_fill_prgb64(dst, solid.prgb64.p64, w);
+      case IMAGE_FORMAT_RGB48:
+        return p_fill_rgb48(dst, solid.prgb64.p64, w);
+      case IMAGE_FORMAT_A16:
+        return p_fill_a16(dst, solid.prgb64.a, w);
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+        return dst;
+    }
+  }
+
   // ==========================================================================
   // [Helpers - Pattern - Solid - Create / Destroy]
   // ==========================================================================
@@ -301,22 +347,54 @@ struct FOG_NO_EXPORT Helpers
     // TODO: A8 support.
   }
 
+  static void FOG_FASTCALL p_solid_fetch_helper_wide(
+    RasterSpan* span, uint8_t* buffer, uint32_t mode, const RasterSolid& solid, uint32_t format)
+  {
+    if (mode == RASTER_FETCH_REFERENCE)
+    {
+      // See p_solid_fetch_helper_prgb32().
+      int filledWidth = 0;
+
+      P_FETCH_SPAN8_INIT()
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CUSTOM(buffer)
+
+        if (filledWidth < w)
+        {
+          dst = p_fill_wide(dst, format, solid, w - filledWidth);
+          filledWidth = w;
+        }
+
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+    else
+    {
+      P_FETCH_SPAN8_INIT()
+      P_FETCH_SPAN8_BEGIN()
+        P_FETCH_SPAN8_SET_CURRENT()
+        dst = p_fill_wide(dst, format, solid, w);
+        P_FETCH_SPAN8_NEXT()
+      P_FETCH_SPAN8_END()
+    }
+  }
+
   static void FOG_FASTCALL p_solid_fetch_prgb64(
     RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
   {
-    // TODO: PRGB64 support.
+    p_solid_fetch_helper_wide(span, buffer, fetcher->getMode(), fetcher->getContext()->_d.solid, IMAGE_FORMAT_PRGB64);
   }
 
   static void FOG_FASTCALL p_solid_fetch_rgb48(
     RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
   {
-    // TODO: RGB48 support.
+    p_solid_fetch_helper_wide(span, buffer, fetcher->getMode(), fetcher->getContext()->_d.solid, IMAGE_FORMAT_RGB48);
   }
 
   static void FOG_FASTCALL p_solid_fetch_a16(
     RasterPatternFetcher* fetcher, RasterSpan* span, uint8_t* buffer)
   {
-    // TODO: A16 support.
+    p_solid_fetch_helper_wide(span, buffer, fetcher->getMode(), fetcher->getContext()->_d.solid, IMAGE_FORMAT_A16);
   }
 
   // ==========================================================================
@@ -0,0 +1,1049 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/CompositeBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/GradientBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/TextureAffine_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/TextureBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeFused - Ops]
+// ============================================================================
+
+// Fused operators are per-pixel versions of the vblit span functions used by
+// the two-pass (fetch and composite) pipeline, the results must be the same.
+//
+// - c_opaque() - CompositeXXX::prgb32_vblit_prgb32_span [C-Opaque].
+// - c_mask()   - CompositeXXX::prgb32_vblit_prgb32_span [C-Mask].
+// - a8_glyph() - CompositeXXX::prgb32_vblit_prgb32_span [A8-Glyph], the mask
+//                is never zero (such pixel is skipped by the caller).
+// - a8_extra() - CompositeXXX::prgb32_vblit_prgb32_span [A8-Extra], the mask
+//                is never zero (such pixel is skipped by the caller).
+
+//! @internal
+//!
+//! @brief Fused operator - PRGB32 <- PRGB32 (Src).
+struct FOG_NO_EXPORT CompositeFusedOp_PRGB32_Src
+{
+  static FOG_INLINE void c_opaque(uint8_t* dst, uint32_t src0p)
+  {
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void c_mask(uint8_t* dst, uint32_t src0p, uint32_t msk0p, uint32_t inv0p)
+  {
+    uint32_t dst0p;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32Lerp256PBB_SBW(dst0p, dst0p, src0p, inv0p, msk0p);
+    Acc::p32Store4a(dst, dst0p);
+  }
+
+  static FOG_INLINE void a8_glyph(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    if (msk0p != 0xFF)
+    {
+      uint32_t dst0p;
+
+      Acc::p32Load4a(dst0p, dst);
+      Acc::p32Cvt256SBWFrom255SBW(msk0p, msk0p);
+      Acc::p32Lerp256PBB_SBW(src0p, src0p, dst0p, msk0p);
+    }
+
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void a8_extra(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    uint32_t dst0p;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32Lerp256PBB_SBW(src0p, src0p, dst0p, msk0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused operator - XRGB32 <- PRGB32 (Src).
+struct FOG_NO_EXPORT CompositeFusedOp_XRGB32_Src
+{
+  static FOG_INLINE void c_opaque(uint8_t* dst, uint32_t src0p)
+  {
+    Acc::p32FillPBB3(src0p, src0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void c_mask(uint8_t* dst, uint32_t src0p, uint32_t msk0p, uint32_t inv0p)
+  {
+    uint32_t dst0p;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32Lerp256PBB_SBW_10F2(dst0p, dst0p, src0p, inv0p, msk0p);
+    Acc::p32Store4a(dst, dst0p);
+  }
+
+  static FOG_INLINE void a8_glyph(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    if (msk0p != 0xFF)
+    {
+      uint32_t dst0p;
+
+      Acc::p32Load4a(dst0p, dst);
+      Acc::p32Cvt256SBWFrom255SBW(msk0p, msk0p);
+      Acc::p32Lerp256PBB_SBW_10Z2(src0p, src0p, dst0p, msk0p);
+    }
+
+    Acc::p32FillPBB3(src0p, src0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void a8_extra(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    uint32_t dst0p;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32Lerp256PBB_SBW_10F2(src0p, src0p, dst0p, msk0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+};
+
+//! @internal
+//!
+//! @brief Fused operator - PRGB32|XRGB32 <- PRGB32 (SrcOver).
+struct FOG_NO_EXPORT CompositeFusedOp_SrcOver
+{
+  static FOG_INLINE void c_opaque(uint8_t* dst, uint32_t src0p)
+  {
+    uint32_t dst0p;
+    uint32_t sra0p;
+
+    if (Acc::p32PRGB32IsAlphaFF(src0p)) goto _Fill;
+    if (Acc::p32PRGB32IsAlpha00(src0p)) return;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32ExtractPBB3(sra0p, src0p);
+    Acc::p32Negate255SBW(sra0p, sra0p);
+    Acc::p32MulDiv255PBB_SBW(dst0p, dst0p, sra0p);
+    Acc::p32Add(src0p, src0p, dst0p);
+
+_Fill:
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void c_mask(uint8_t* dst, uint32_t src0p, uint32_t msk0p, uint32_t inv0p)
+  {
+    uint32_t dst0p;
+    uint32_t sra0p;
+
+    if (Acc::p32PRGB32IsAlpha00(src0p)) return;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32MulDiv256PBB_SBW(src0p, src0p, msk0p);
+
+    Acc::p32ExtractPBB3(sra0p, src0p);
+    Acc::p32Negate255SBW(sra0p, sra0p);
+    Acc::p32MulDiv255PBB_SBW(dst0p, dst0p, sra0p);
+    Acc::p32Add(src0p, src0p, dst0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void a8_glyph(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    uint32_t dst0p;
+    uint32_t sra0p;
+
+    Acc::p32Cvt256SBWFrom255SBW(msk0p, msk0p);
+    Acc::p32MulDiv256PBB_3Z1Z_(sra0p, src0p, msk0p);
+    if (Acc::p32PRGB32IsAlpha00(sra0p)) return;
+    if (Acc::p32PRGB32IsAlphaFF(sra0p)) goto _Fill;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32MulDiv256PBB_Z2Z0_(src0p, src0p, msk0p);
+    Acc::p32Combine(src0p, src0p, sra0p);
+
+    Acc::p32RShift(sra0p, sra0p, 24);
+    Acc::p32Negate255SBW(sra0p, sra0p);
+    Acc::p32MulDiv255PBB_SBW(dst0p, dst0p, sra0p);
+    Acc::p32Add(src0p, src0p, dst0p);
+
+_Fill:
+    Acc::p32Store4a(dst, src0p);
+  }
+
+  static FOG_INLINE void a8_extra(uint8_t* dst, uint32_t src0p, uint32_t msk0p)
+  {
+    uint32_t dst0p;
+    uint32_t sra0p;
+
+    if (Acc::p32PRGB32IsAlpha00(src0p)) return;
+
+    Acc::p32Load4a(dst0p, dst);
+    Acc::p32MulDiv256PBB_SBW(src0p, src0p, msk0p);
+    Acc::p32ExtractPBB3(sra0p, src0p);
+    Acc::p32Negate255SBW(sra0p, sra0p);
+    Acc::p32MulDiv255PBB_SBW(dst0p, dst0p, sra0p);
+    Acc::p32Add(src0p, src0p, dst0p);
+    Acc::p32Store4a(dst, src0p);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeFused - Sources]
+// ============================================================================
+
+// Fused sources are per-pixel versions of the pattern fetchers, they must
+// generate the same pixels as the fetchers they replace.
+//
+// - begin(x)   - Seek to the position 'x' of the current scanline.
+// - fetch(pix) - Fetch the pixel and advance to the next one.
+// - skip()     - Advance to the next pixel without fetching.
+// - end()      - Advance the fetcher to the next scanline.
+
+//! @internal
+//!
+//! @brief Fused source - PGradientLinear::fetch_simple_nearest_pad().
+struct FOG_NO_EXPORT PFusedGradientLinearSimplePad
+{
+  FOG_INLINE PFusedGradientLinearSimplePad(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+    _pt = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt);
+    _pos = _pt;
+  }
+
+  FOG_INLINE void begin(int x) { _pos = _pt + x * _xx; }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    int pos = _pos;
+
+    if (pos < 0) pos = 0;
+    if (pos > _len) pos = _len;
+
+    pix = _table[pos >> 16];
+    _pos += _xx;
+  }
+
+  FOG_INLINE void skip() { _pos += _xx; }
+
+  FOG_INLINE void end()
+  {
+    _fetcher->_d.gradient.linear.simple.pt += _fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  const uint32_t* _table;
+
+  int _xx;
+  int _len;
+  int _pt;
+  int _pos;
+};
+
+//! @internal
+//!
+//! @brief Fused source - PGradientLinear::fetch_simple_nearest_repeat().
+struct FOG_NO_EXPORT PFusedGradientLinearSimpleRepeat
+{
+  FOG_INLINE PFusedGradientLinearSimpleRepeat(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher)
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _table = reinterpret_cast<const uint32_t*>(ctx->_d.gradient.base.table);
+    _xx = ctx->_d.gradient.linear.simple.xx16x16;
+    _len = ctx->_d.gradient.base.len16x16;
+    _pt = Math::fixed16x16FromFloat(fetcher->_d.gradient.linear.simple.pt);
+    _pos = _pt;
+  }
+
+  FOG_INLINE void begin(int x) { _pos = Helpers::p_repeat_integer(_pt + x * _xx, _len); }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    pix = _table[_pos >> 16];
+    skip();
+  }
+
+  FOG_INLINE void skip()
+  {
+    _pos += _xx;
+
+    if (_pos >= _len)
+      _pos -= _len;
+    else if (_pos < 0)
+      _pos += _len;
+  }
+
+  FOG_INLINE void end()
+  {
+    _fetcher->_d.gradient.linear.simple.pt += _fetcher->_d.gradient.linear.simple.dt;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  const uint32_t* _table;
+
+  int _xx;
+  int _len;
+  int _pt;
+  int _pos;
+};
+
+//! @internal
+//!
+//! @brief Fused source - PTextureSimple::fetch_align_pad().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedTextureSimpleAlignPad
+{
+  FOG_INLINE PFusedTextureSimpleAlignPad(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher),
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    int th = ctx->_d.texture.base.h;
+
+    if (y < 0)
+      y = 0;
+    else if (y >= th)
+      y = th - 1;
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tx = ctx->_d.texture.simple.tx;
+    _tw = ctx->_d.texture.base.w - 1;
+    _x = 0;
+  }
+
+  FOG_INLINE void begin(int x) { _x = x + _tx; }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    int x = _x;
+
+    if (x < 0) x = 0;
+    if (x > _tw) x = _tw;
+
+    _accessor.fetchNorm(pix, _srcLine + (uint)x * Accessor::SRC_BPP);
+    _accessor.normalize(pix, pix);
+    _x++;
+  }
+
+  FOG_INLINE void skip() { _x++; }
+
+  FOG_INLINE void end()
+  {
+    _fetcher->_d.texture.simple.py += _fetcher->_d.texture.simple.dy;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  Accessor _accessor;
+
+  const uint8_t* _srcLine;
+  int _tx;
+  int _tw;
+  int _x;
+};
+
+//! @internal
+//!
+//! @brief Fused source - PTextureSimple::fetch_align_repeat().
+template<typename Accessor>
+struct FOG_NO_EXPORT PFusedTextureSimpleAlignRepeat
+{
+  FOG_INLINE PFusedTextureSimpleAlignRepeat(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher),
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    int y = fetcher->_d.texture.simple.py;
+    FOG_ASSERT(y >= 0 && y < ctx->_d.texture.base.h);
+
+    _srcLine = ctx->_d.texture.base.pixels + y * ctx->_d.texture.base.stride;
+    _tx = ctx->_d.texture.simple.tx;
+    _tw = ctx->_d.texture.base.w;
+    _x = 0;
+    _src = _srcLine;
+  }
+
+  FOG_INLINE void begin(int x)
+  {
+    _x = Helpers::p_repeat_integer(x + _tx, _tw);
+    _src = _srcLine + (uint)_x * Accessor::SRC_BPP;
+  }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    _accessor.fetchNorm(pix, _src);
+    _accessor.normalize(pix, pix);
+    skip();
+  }
+
+  FOG_INLINE void skip()
+  {
+    _src += Accessor::SRC_BPP;
+    if (++_x == _tw) { _x = 0; _src = _srcLine; }
+  }
+
+  FOG_INLINE void end()
+  {
+    const RasterPattern* ctx = _fetcher->getContext();
+
+    int y = _fetcher->_d.texture.simple.py + _fetcher->_d.texture.simple.dy;
+    if (y >= ctx->_d.texture.base.h) y -= ctx->_d.texture.base.h;
+    _fetcher->_d.texture.simple.py = y;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  Accessor _accessor;
+
+  const uint8_t* _srcLine;
+  const uint8_t* _src;
+  int _tx;
+  int _tw;
+  int _x;
+};
+
+//! @internal
+//!
+//! @brief Fused source - PTextureAffine::fetch_affine_bilinear_pad().
+//!
+//! The fixed-point position is recalculated each @c MAX_FIXED_STEP pixels
+//! from the start of each run of adjacent spans, like the fetcher does.
+template<typename Accessor, bool XYZero>
+struct FOG_NO_EXPORT PFusedTextureAffineBilinearPad
+{
+  enum { MAX_FIXED_STEP = PTextureAffine::MAX_FIXED_STEP };
+
+  FOG_INLINE PFusedTextureAffineBilinearPad(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher),
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _srcPixels = ctx->_d.texture.base.pixels;
+    _srcStride = ctx->_d.texture.base.stride;
+
+    _tw = ctx->_d.texture.base.w - 1;
+    _th = ctx->_d.texture.base.h - 1;
+
+    _xx = ctx->_d.texture.affine.xx;
+    _xy = ctx->_d.texture.affine.xy;
+
+    _xx16x16 = ctx->_d.texture.affine.xx16x16;
+    _xy16x16 = ctx->_d.texture.affine.xy16x16;
+
+    _offx = fetcher->_d.texture.affine.px;
+    _offy = fetcher->_d.texture.affine.py;
+
+    // The position is set by begin(), initialize it so the compiler can see
+    // that it's never used uninitialized.
+    _x = 0.0;
+    _i = 0;
+    _px = 0;
+    _py = 0;
+
+    if (XYZero)
+    {
+      int py = Math::fixed16x16FromFloat(_offy);
+      int py0 = py >> 16;
+
+      _wy = (uint)(py >> 8) & 0xFF;
+
+      _srcLine0 = _srcPixels;
+      _srcLine1 = _srcPixels;
+
+      if (py0 >= 0)
+      {
+        _srcLine0 += Math::min<int>(py0    , _th) * _srcStride;
+        _srcLine1 += Math::min<int>(py0 + 1, _th) * _srcStride;
+      }
+    }
+  }
+
+  FOG_INLINE void begin(int x)
+  {
+    _x = (double)x;
+    _i = 0;
+  }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    typename Accessor::Pixel pix_x0y0;
+    typename Accessor::Pixel pix_x1y0;
+    typename Accessor::Pixel pix_x0y1;
+    typename Accessor::Pixel pix_x1y1;
+
+    _sync();
+
+    int px0 = _px >> 16;
+    uint32_t wx = (uint)(_px >> 8) & 0xFF;
+
+    if (XYZero)
+    {
+      uint32_t wy = _wy;
+      uint32_t inv_wy = 0x100 - wy;
+
+      if (FOG_LIKELY((uint)px0 < (uint)_tw))
+      {
+        _accessor.fetchRaw(pix_x0y0, _srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x1y0, _srcLine0 + (uint)px0 * Accessor::SRC_BPP + Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x0y1, _srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x1y1, _srcLine1 + (uint)px0 * Accessor::SRC_BPP + Accessor::SRC_BPP);
+      }
+      else
+      {
+        if (px0 < 0) px0 = 0; else px0 = _tw;
+        _accessor.fetchRaw(pix_x0y0, _srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x0y1, _srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+
+        pix_x1y0 = pix_x0y0;
+        pix_x1y1 = pix_x0y1;
+      }
+
+      _accessor.interpolateRaw_4(pix_x0y0,
+        pix_x0y0, ((0x100 - wx) * (inv_wy)) >> 8,
+        pix_x1y0, ((wx        ) * (inv_wy)) >> 8,
+        pix_x0y1, ((0x100 - wx) * (wy    )) >> 8,
+        pix_x1y1, ((wx        ) * (wy    )) >> 8);
+    }
+    else
+    {
+      int py0 = _py >> 16;
+      uint32_t wy = (uint)(_py >> 8) & 0xFF;
+
+      if (FOG_LIKELY(((uint)px0 < (uint)_tw) & ((uint)py0 < (uint)_th)))
+      {
+        const uint8_t* srcLine = _srcPixels + py0 * _srcStride + (uint)px0 * Accessor::SRC_BPP;
+
+        _accessor.fetchRaw(pix_x0y0, srcLine);
+        _accessor.fetchRaw(pix_x1y0, srcLine + Accessor::SRC_BPP);
+        srcLine += _srcStride;
+        _accessor.fetchRaw(pix_x0y1, srcLine);
+        _accessor.fetchRaw(pix_x1y1, srcLine + Accessor::SRC_BPP);
+      }
+      else
+      {
+        int px1 = px0 + 1;
+        int py1 = py0 + 1;
+
+        if (px0 < 0) { px0 = px1 = 0; } else if (px0 >= _tw) { px0 = px1 = _tw; }
+        if (py0 < 0) { py0 = py1 = 0; } else if (py0 >= _th) { py0 = py1 = _th; }
+
+        const uint8_t* srcLine0 = _srcPixels + (uint)py0 * _srcStride;
+        const uint8_t* srcLine1 = _srcPixels + (uint)py1 * _srcStride;
+
+        _accessor.fetchRaw(pix_x0y0, srcLine0 + px0 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x1y0, srcLine0 + px1 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x0y1, srcLine1 + px0 * Accessor::SRC_BPP);
+        _accessor.fetchRaw(pix_x1y1, srcLine1 + px1 * Accessor::SRC_BPP);
+      }
+
+      _accessor.interpolateRaw_4(pix_x0y0,
+        pix_x0y0, ((0x100 - wx) * (0x100 - wy)) >> 8,
+        pix_x1y0, ((wx        ) * (0x100 - wy)) >> 8,
+        pix_x0y1, ((0x100 - wx) * (wy        )) >> 8,
+        pix_x1y1, ((wx        ) * (wy        )) >> 8);
+    }
+
+    _accessor.normalize(pix_x0y0, pix_x0y0);
+    pix = pix_x0y0;
+    _step();
+  }
+
+  FOG_INLINE void skip()
+  {
+    _sync();
+    _step();
+  }
+
+  FOG_INLINE void end()
+  {
+    _fetcher->_d.texture.affine.px += _fetcher->_d.texture.affine.dx;
+    _fetcher->_d.texture.affine.py += _fetcher->_d.texture.affine.dy;
+  }
+
+  FOG_INLINE void _sync()
+  {
+    if (_i == 0)
+    {
+      _px = Math::fixed16x16FromFloat(_offx + _x * _xx);
+      if (!XYZero) _py = Math::fixed16x16FromFloat(_offy + _x * _xy);
+
+      _x += (double)MAX_FIXED_STEP;
+      _i = MAX_FIXED_STEP;
+    }
+  }
+
+  FOG_INLINE void _step()
+  {
+    _px += _xx16x16;
+    if (!XYZero) _py += _xy16x16;
+    _i--;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  Accessor _accessor;
+
+  const uint8_t* _srcPixels;
+  ssize_t _srcStride;
+
+  const uint8_t* _srcLine0;
+  const uint8_t* _srcLine1;
+  uint32_t _wy;
+
+  int _tw;
+  int _th;
+
+  double _xx;
+  double _xy;
+
+  int _xx16x16;
+  int _xy16x16;
+
+  double _offx;
+  double _offy;
+
+  double _x;
+  int _i;
+  int _px;
+  int _py;
+};
+
+//! @internal
+//!
+//! @brief Fused source - PTextureAffine::fetch_affine_bilinear_repeat().
+template<typename Accessor, bool XYZero>
+struct FOG_NO_EXPORT PFusedTextureAffineBilinearRepeat
+{
+  enum { MAX_FIXED_STEP = PTextureAffine::MAX_FIXED_STEP };
+
+  FOG_INLINE PFusedTextureAffineBilinearRepeat(RasterPatternFetcher* fetcher) :
+    _fetcher(fetcher),
+    _accessor(fetcher->getContext())
+  {
+    const RasterPattern* ctx = fetcher->getContext();
+
+    _srcPixels = ctx->_d.texture.base.pixels;
+    _srcStride = ctx->_d.texture.base.stride;
+
+    _tw = ctx->_d.texture.base.w - 1;
+    _th = ctx->_d.texture.base.h - 1;
+
+    _xx = ctx->_d.texture.affine.xx;
+    _xy = ctx->_d.texture.affine.xy;
+
+    _xx16x16 = ctx->_d.texture.affine.xx16x16;
+    _xy16x16 = ctx->_d.texture.affine.xy16x16;
+
+    _mx16x16 = ctx->_d.texture.affine.mx16x16;
+    _my16x16 = ctx->_d.texture.affine.my16x16;
+
+    _rx16x16 = ctx->_d.texture.affine.rx16x16;
+    _ry16x16 = ctx->_d.texture.affine.ry16x16;
+
+    _offx = fetcher->_d.texture.affine.px;
+    _offy = fetcher->_d.texture.affine.py;
+
+    // The position is set by begin(), initialize it so the compiler can see
+    // that it's never used uninitialized.
+    _x = 0.0;
+    _i = 0;
+    _px = 0;
+    _py = 0;
+
+    if (XYZero)
+    {
+      int py0 = Math::fixed16x16FromFloat(_offy) >> 16;
+      FOG_ASSERT(py0 >= 0 && py0 <= _th);
+
+      _wy = (uint)(Math::fixed24x8FromFloat(_offy) & 0xFF);
+
+      _srcLine0 = _srcPixels + py0 * _srcStride;
+      if (++py0 > _th) py0 = 0;
+      _srcLine1 = _srcPixels + py0 * _srcStride;
+    }
+  }
+
+  FOG_INLINE void begin(int x)
+  {
+    _x = (double)x;
+    _i = 0;
+  }
+
+  FOG_INLINE void fetch(uint32_t& pix)
+  {
+    typename Accessor::Pixel pix_x0y0;
+    typename Accessor::Pixel pix_x1y0;
+    typename Accessor::Pixel pix_x0y1;
+    typename Accessor::Pixel pix_x1y1;
+
+    _sync();
+
+    int px0 = _px >> 16;
+    uint32_t wx = (uint)(_px >> 8) & 0xFF;
+
+    const uint8_t* srcLine0;
+    const uint8_t* srcLine1;
+    uint32_t wy;
+
+    if (XYZero)
+    {
+      srcLine0 = _srcLine0;
+      srcLine1 = _srcLine1;
+      wy = _wy;
+    }
+    else
+    {
+      int py0 = _py >> 16;
+      wy = (uint)(_py >> 8) & 0xFF;
+
+      srcLine0 = _srcPixels + (uint)py0 * _srcStride;
+      if (++py0 > _th) py0 = 0;
+      srcLine1 = _srcPixels + (uint)py0 * _srcStride;
+    }
+
+    _accessor.fetchRaw(pix_x0y0, srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+    _accessor.fetchRaw(pix_x0y1, srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+
+    if (++px0 > _tw) px0 = 0;
+
+    _accessor.fetchRaw(pix_x1y0, srcLine0 + (uint)px0 * Accessor::SRC_BPP);
+    _accessor.fetchRaw(pix_x1y1, srcLine1 + (uint)px0 * Accessor::SRC_BPP);
+
+    _accessor.interpolateRaw_4(pix_x0y0,
+      pix_x0y0, ((0x100 - wx) * (0x100 - wy)) >> 8,
+      pix_x1y0, ((wx        ) * (0x100 - wy)) >> 8,
+      pix_x0y1, ((0x100 - wx) * (wy        )) >> 8,
+      pix_x1y1, ((wx        ) * (wy        )) >> 8);
+    _accessor.normalize(pix_x0y0, pix_x0y0);
+    pix = pix_x0y0;
+
+    _step();
+  }
+
+  FOG_INLINE void skip()
+  {
+    _sync();
+    _step();
+  }
+
+  FOG_INLINE void end()
+  {
+    const RasterPattern* ctx = _fetcher->getContext();
+
+    _fetcher->_d.texture.affine.px += _fetcher->_d.texture.affine.dx;
+    _fetcher->_d.texture.affine.py += _fetcher->_d.texture.affine.dy;
+
+    if (_fetcher->_d.texture.affine.py < 0.0)
+      _fetcher->_d.texture.affine.py += ctx->_d.texture.affine.my;
+    if (_fetcher->_d.texture.affine.py >= ctx->_d.texture.affine.my)
+      _fetcher->_d.texture.affine.py -= ctx->_d.texture.affine.my;
+  }
+
+  FOG_INLINE void _sync()
+  {
+    if (_i == 0)
+    {
+      _px = Helpers::p_repeat_integer(Math::fixed16x16FromFloat(_offx + _x * _xx), _mx16x16);
+      if (!XYZero) _py = Helpers::p_repeat_integer(Math::fixed16x16FromFloat(_offy + _x * _xy), _my16x16);
+
+      _x += (double)MAX_FIXED_STEP;
+      _i = MAX_FIXED_STEP;
+    }
+  }
+
+  FOG_INLINE void _step()
+  {
+    _px += _xx16x16;
+    if ((uint)_px >= (uint)_mx16x16) _px += _rx16x16;
+
+    if (!XYZero)
+    {
+      _py += _xy16x16;
+      if ((uint)_py >= (uint)_my16x16) _py += _ry16x16;
+    }
+
+    _i--;
+  }
+
+  RasterPatternFetcher* _fetcher;
+  Accessor _accessor;
+
+  const uint8_t* _srcPixels;
+  ssize_t _srcStride;
+
+  const uint8_t* _srcLine0;
+  const uint8_t* _srcLine1;
+  uint32_t _wy;
+
+  int _tw;
+  int _th;
+
+  double _xx;
+  double _xy;
+
+  int _xx16x16;
+  int _xy16x16;
+
+  int _mx16x16;
+  int _my16x16;
+
+  int _rx16x16;
+  int _ry16x16;
+
+  double _offx;
+  double _offy;
+
+  double _x;
+  int _i;
+  int _px;
+  int _py;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeFused]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fused fetch-and-composite functions.
+//!
+//! The two-pass pipeline fetches the whole scanline of the pattern into the
+//! temporary buffer and then composites the buffer into the destination. The
+//! fused functions generate each pixel and composite it immediately, so the
+//! pixel doesn't make a round-trip through the memory and pixels which are
+//! not covered by the mask are not fetched at all.
+struct FOG_NO_EXPORT CompositeFused
+{
+  // ==========================================================================
+  // [Blit]
+  // ==========================================================================
+
+  template<typename Op, typename Source>
+  static FOG_INLINE void blit(
+    Source& source, uint8_t* dst, const RasterSpan* span)
+  {
+    uint8_t* dstBase = dst;
+    int xEnd = -1;
+
+    do {
+      int x = (int)span->getX0();
+      int w = (int)span->getX1() - x;
+      FOG_ASSUME(w > 0);
+
+      // Adjacent spans continue at the position where the previous span ended.
+      if (x != xEnd) source.begin(x);
+      xEnd = x + w;
+
+      dst = dstBase + (uint)x * 4;
+      const uint8_t* msk = (const uint8_t*)reinterpret_cast<const RasterSpan8*>(span)->getGenericMask();
+
+      switch (span->getType())
+      {
+        // --------------------------------------------------------------------
+        // [C-Opaque / C-Mask]
+        // --------------------------------------------------------------------
+
+        case RASTER_SPAN_C:
+        {
+          uint32_t msk0 = RasterSpan8::getConstMaskFromPointer(msk);
+          FOG_ASSERT(msk0 <= 0x100);
+
+          if (msk0 == 0x100)
+          {
+            do {
+              uint32_t src0p;
+
+              source.fetch(src0p);
+              Op::c_opaque(dst, src0p);
+
+              dst += 4;
+            } while (--w);
+          }
+          else
+          {
+            uint32_t msk0p;
+            uint32_t inv0p;
+
+            Acc::p32Copy(msk0p, msk0);
+            Acc::p32Negate256SBW(inv0p, msk0p);
+
+            do {
+              uint32_t src0p;
+
+              source.fetch(src0p);
+              Op::c_mask(dst, src0p, msk0p, inv0p);
+
+              dst += 4;
+            } while (--w);
+          }
+          break;
+        }
+
+        // --------------------------------------------------------------------
+        // [A8-Glyph]
+        // --------------------------------------------------------------------
+
+        case RASTER_SPAN_A8_GLYPH:
+        case RASTER_SPAN_AX_GLYPH:
+        {
+          do {
+            uint32_t src0p;
+            uint32_t msk0p;
+
+            Acc::p32Load1b(msk0p, msk);
+
+            if (msk0p == 0x00)
+            {
+              source.skip();
+            }
+            else
+            {
+              source.fetch(src0p);
+              Op::a8_glyph(dst, src0p, msk0p);
+            }
+
+            dst += 4;
+            msk += 1;
+          } while (--w);
+          break;
+        }
+
+        // --------------------------------------------------------------------
+        // [A8-Extra]
+        // --------------------------------------------------------------------
+
+        case RASTER_SPAN_AX_EXTRA:
+        {
+          do {
+            uint32_t src0p;
+            uint32_t msk0p;
+
+            Acc::p32Load2a(msk0p, msk);
+
+            if (msk0p == 0x00)
+            {
+              source.skip();
+            }
+            else
+            {
+              source.fetch(src0p);
+              Op::a8_extra(dst, src0p, msk0p);
+            }
+
+            dst += 4;
+            msk += 2;
+          } while (--w);
+          break;
+        }
+
+        // ARGB32 glyphs are never generated by the rasterizers, the fused
+        // functions are used only to fill shapes.
+        default:
+          FOG_ASSERT_NOT_REACHED();
+      }
+    } while ((span = span->getNext()) != NULL);
+
+    source.end();
+  }
+
+  // ==========================================================================
+  // [Gradient - Linear - Simple]
+  // ==========================================================================
+
+  template<typename Op>
+  static void FOG_FASTCALL gradient_linear_simple_nearest_pad(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    PFusedGradientLinearSimplePad source(fetcher);
+    blit<Op>(source, dst, span);
+  }
+
+  template<typename Op>
+  static void FOG_FASTCALL gradient_linear_simple_nearest_repeat(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    PFusedGradientLinearSimpleRepeat source(fetcher);
+    blit<Op>(source, dst, span);
+  }
+
+  // ==========================================================================
+  // [Texture - Simple]
+  // ==========================================================================
+
+  template<typename Op, typename Accessor>
+  static void FOG_FASTCALL texture_simple_align_pad(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    PFusedTextureSimpleAlignPad<Accessor> source(fetcher);
+    blit<Op>(source, dst, span);
+  }
+
+  template<typename Op, typename Accessor>
+  static void FOG_FASTCALL texture_simple_align_repeat(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    PFusedTextureSimpleAlignRepeat<Accessor> source(fetcher);
+    blit<Op>(source, dst, span);
+  }
+
+  // ==========================================================================
+  // [Texture - Affine]
+  // ==========================================================================
+
+  template<typename Op, typename Accessor>
+  static void FOG_FASTCALL texture_affine_bilinear_pad(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    if (fetcher->getContext()->_d.texture.affine.xyZero)
+    {
+      PFusedTextureAffineBilinearPad<Accessor, true> source(fetcher);
+      blit<Op>(source, dst, span);
+    }
+    else
+    {
+      PFusedTextureAffineBilinearPad<Accessor, false> source(fetcher);
+      blit<Op>(source, dst, span);
+    }
+  }
+
+  template<typename Op, typename Accessor>
+  static void FOG_FASTCALL texture_affine_bilinear_repeat(
+    RasterPatternFetcher* fetcher, uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    if (fetcher->getContext()->_d.texture.affine.xyZero)
+    {
+      PFusedTextureAffineBilinearRepeat<Accessor, true> source(fetcher);
+      blit<Op>(source, dst, span);
+    }
+    else
+    {
+      PFusedTextureAffineBilinearRepeat<Accessor, false> source(fetcher);
+      blit<Op>(source, dst, span);
+    }
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEFUSED_P_H
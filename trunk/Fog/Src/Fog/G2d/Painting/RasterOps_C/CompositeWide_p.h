@@ -0,0 +1,760 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEWIDE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEWIDE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_C/CompositeBase_p.h>
+
+namespace Fog {
+namespace RasterOps_C {
+
+// ============================================================================
+// [Fog::RasterOps_C - WidePixel]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Unpacked pixel used by 16-bit per component compositing.
+//!
+//! Each component is in 0...65535 range and is premultiplied. The components
+//! are stored in 32-bit integers so multiplication never overflows.
+struct FOG_NO_EXPORT WidePixel
+{
+  uint32_t a;
+  uint32_t r;
+  uint32_t g;
+  uint32_t b;
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - WideHelpers]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT WideHelpers
+{
+  //! @brief Get @a x / 65535 (rounded), @a x must be in 0...65535*65535 range.
+  static FOG_INLINE uint32_t div65535(uint32_t x)
+  {
+    x += 0x8000;
+    return (x + (x >> 16)) >> 16;
+  }
+
+  //! @brief Get @a x * @a y / 65535 (rounded).
+  static FOG_INLINE uint32_t mul(uint32_t x, uint32_t y)
+  {
+    return div65535(x * y);
+  }
+
+  //! @brief Extend 8-bit component to 16-bit one.
+  static FOG_INLINE uint32_t extend(uint32_t x)
+  {
+    return x * 0x0101;
+  }
+
+  //! @brief Linear interpolation between @a d and @a s, @a m is in 0...256.
+  static FOG_INLINE uint32_t lerp(uint32_t d, uint32_t s, uint32_t m)
+  {
+    return uint32_t(int32_t(d) + (((int32_t(s) - int32_t(d)) * int32_t(m)) >> 8));
+  }
+
+  static FOG_INLINE void lerpPixel(WidePixel& d, const WidePixel& s, uint32_t m)
+  {
+    d.a = lerp(d.a, s.a, m);
+    d.r = lerp(d.r, s.r, m);
+    d.g = lerp(d.g, s.g, m);
+    d.b = lerp(d.b, s.b, m);
+  }
+
+  static FOG_INLINE void loadSolid(WidePixel& dst, const RasterSolid* src)
+  {
+    dst.a = src->prgb64.a;
+    dst.r = src->prgb64.r;
+    dst.g = src->prgb64.g;
+    dst.b = src->prgb64.b;
+  }
+
+  static FOG_INLINE void fromPrgb32(WidePixel& dst, uint32_t src0p)
+  {
+    dst.a = extend((src0p >> 24)       );
+    dst.r = extend((src0p >> 16) & 0xFF);
+    dst.g = extend((src0p >>  8) & 0xFF);
+    dst.b = extend((src0p      ) & 0xFF);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - WideSrc]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Wide source accessor - PRGB32.
+struct FOG_NO_EXPORT WideSrc_PRGB32
+{
+  enum { SIZE = 4 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    uint32_t src0p;
+
+    Acc::p32Load4a(src0p, src);
+    WideHelpers::fromPrgb32(dst, src0p);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - XRGB32.
+struct FOG_NO_EXPORT WideSrc_XRGB32
+{
+  enum { SIZE = 4 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    uint32_t src0p;
+
+    Acc::p32Load4a(src0p, src);
+    WideHelpers::fromPrgb32(dst, src0p | 0xFF000000);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - RGB24.
+struct FOG_NO_EXPORT WideSrc_RGB24
+{
+  enum { SIZE = 3 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    dst.a = 0xFFFF;
+    dst.r = WideHelpers::extend(src[PIXEL_RGB24_BYTE_R]);
+    dst.g = WideHelpers::extend(src[PIXEL_RGB24_BYTE_G]);
+    dst.b = WideHelpers::extend(src[PIXEL_RGB24_BYTE_B]);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - A8.
+struct FOG_NO_EXPORT WideSrc_A8
+{
+  enum { SIZE = 1 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    uint32_t a = WideHelpers::extend(src[0]);
+
+    dst.a = a;
+    dst.r = a;
+    dst.g = a;
+    dst.b = a;
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - I8.
+struct FOG_NO_EXPORT WideSrc_I8
+{
+  enum { SIZE = 1 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    uint32_t index = src[0];
+
+    if (index == closure->colorKey)
+      WideHelpers::fromPrgb32(dst, 0x00000000);
+    else
+      WideHelpers::fromPrgb32(dst, closure->palette->data[index].u32);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - PRGB64.
+struct FOG_NO_EXPORT WideSrc_PRGB64
+{
+  enum { SIZE = 8 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    const uint16_t* s = reinterpret_cast<const uint16_t*>(src);
+
+    dst.a = s[PIXEL_ARGB64_WORD_A];
+    dst.r = s[PIXEL_ARGB64_WORD_R];
+    dst.g = s[PIXEL_ARGB64_WORD_G];
+    dst.b = s[PIXEL_ARGB64_WORD_B];
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - RGB48.
+struct FOG_NO_EXPORT WideSrc_RGB48
+{
+  enum { SIZE = 6 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    const uint16_t* s = reinterpret_cast<const uint16_t*>(src);
+
+    dst.a = 0xFFFF;
+    dst.r = s[PIXEL_RGB48_WORD_R];
+    dst.g = s[PIXEL_RGB48_WORD_G];
+    dst.b = s[PIXEL_RGB48_WORD_B];
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide source accessor - A16.
+struct FOG_NO_EXPORT WideSrc_A16
+{
+  enum { SIZE = 2 };
+
+  static FOG_INLINE void load(WidePixel& dst, const uint8_t* src, const RasterClosure* closure)
+  {
+    uint32_t a = reinterpret_cast<const uint16_t*>(src)[0];
+
+    dst.a = a;
+    dst.r = a;
+    dst.g = a;
+    dst.b = a;
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - WideDst]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Wide destination accessor - PRGB64.
+struct FOG_NO_EXPORT WideDst_PRGB64 : public WideSrc_PRGB64
+{
+  static FOG_INLINE void store(uint8_t* dst, const WidePixel& src)
+  {
+    uint16_t* d = reinterpret_cast<uint16_t*>(dst);
+
+    d[PIXEL_ARGB64_WORD_A] = uint16_t(src.a);
+    d[PIXEL_ARGB64_WORD_R] = uint16_t(src.r);
+    d[PIXEL_ARGB64_WORD_G] = uint16_t(src.g);
+    d[PIXEL_ARGB64_WORD_B] = uint16_t(src.b);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide destination accessor - RGB48.
+struct FOG_NO_EXPORT WideDst_RGB48 : public WideSrc_RGB48
+{
+  static FOG_INLINE void store(uint8_t* dst, const WidePixel& src)
+  {
+    uint16_t* d = reinterpret_cast<uint16_t*>(dst);
+
+    d[PIXEL_RGB48_WORD_R] = uint16_t(src.r);
+    d[PIXEL_RGB48_WORD_G] = uint16_t(src.g);
+    d[PIXEL_RGB48_WORD_B] = uint16_t(src.b);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide destination accessor - A16.
+struct FOG_NO_EXPORT WideDst_A16 : public WideSrc_A16
+{
+  static FOG_INLINE void store(uint8_t* dst, const WidePixel& src)
+  {
+    reinterpret_cast<uint16_t*>(dst)[0] = uint16_t(src.a);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - WideOp]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Wide operator - Src.
+struct FOG_NO_EXPORT WideOp_Src
+{
+  static FOG_INLINE void op(WidePixel& d, const WidePixel& s)
+  {
+    d = s;
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide operator - SrcOver.
+struct FOG_NO_EXPORT WideOp_SrcOver
+{
+  static FOG_INLINE void op(WidePixel& d, const WidePixel& s)
+  {
+    uint32_t sia = 0xFFFF - s.a;
+
+    d.a = s.a + WideHelpers::mul(d.a, sia);
+    d.r = s.r + WideHelpers::mul(d.r, sia);
+    d.g = s.g + WideHelpers::mul(d.g, sia);
+    d.b = s.b + WideHelpers::mul(d.b, sia);
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide operator - Clear.
+struct FOG_NO_EXPORT WideOp_Clear
+{
+  static FOG_INLINE void op(WidePixel& d, const WidePixel& s)
+  {
+    d.a = 0;
+    d.r = 0;
+    d.g = 0;
+    d.b = 0;
+  }
+};
+
+//! @internal
+//!
+//! @brief Wide operator - Plus.
+struct FOG_NO_EXPORT WideOp_Plus
+{
+  static FOG_INLINE void op(WidePixel& d, const WidePixel& s)
+  {
+    d.a = Math::min<uint32_t>(d.a + s.a, 0xFFFF);
+    d.r = Math::min<uint32_t>(d.r + s.r, 0xFFFF);
+    d.g = Math::min<uint32_t>(d.g + s.g, 0xFFFF);
+    d.b = Math::min<uint32_t>(d.b + s.b, 0xFFFF);
+  }
+};
+
+//! @internal
+//!
+//! @brief Porter & Duff factor used by @ref WideOp_PorterDuff.
+enum WIDE_FACTOR
+{
+  WIDE_FACTOR_ZERO = 0,
+  WIDE_FACTOR_ONE = 1,
+  WIDE_FACTOR_SA = 2,
+  WIDE_FACTOR_DA = 3,
+  WIDE_FACTOR_INV_SA = 4,
+  WIDE_FACTOR_INV_DA = 5
+};
+
+//! @internal
+//!
+//! @brief Wide operator - Generic Porter & Duff operator.
+//!
+//! Computes Dca' = Sca.Fa + Dca.Fb, Da' = Sa.Fa + Da.Fb.
+template<int FA, int FB>
+struct FOG_NO_EXPORT WideOp_PorterDuff
+{
+  static FOG_INLINE uint32_t getFactor(int f, const WidePixel& d, const WidePixel& s)
+  {
+    switch (f)
+    {
+      case WIDE_FACTOR_ZERO  : return 0;
+      case WIDE_FACTOR_ONE   : return 0xFFFF;
+      case WIDE_FACTOR_SA    : return s.a;
+      case WIDE_FACTOR_DA    : return d.a;
+      case WIDE_FACTOR_INV_SA: return 0xFFFF - s.a;
+      case WIDE_FACTOR_INV_DA: return 0xFFFF - d.a;
+
+      default:
+        FOG_ASSERT_NOT_REACHED();
+        return 0;
+    }
+  }
+
+  static FOG_INLINE uint32_t combine(uint32_t dc, uint32_t sc, uint32_t fa, uint32_t fb)
+  {
+    if (FA == WIDE_FACTOR_ZERO)
+      return WideHelpers::mul(dc, fb);
+    if (FB == WIDE_FACTOR_ZERO)
+      return WideHelpers::mul(sc, fa);
+
+    // Both terms are rounded, the result can't be larger than 0xFFFF.
+    return Math::min<uint32_t>(WideHelpers::mul(sc, fa) + WideHelpers::mul(dc, fb), 0xFFFF);
+  }
+
+  static FOG_INLINE void op(WidePixel& d, const WidePixel& s)
+  {
+    uint32_t fa = getFactor(FA, d, s);
+    uint32_t fb = getFactor(FB, d, s);
+
+    d.a = combine(d.a, s.a, fa, fb);
+    d.r = combine(d.r, s.r, fa, fb);
+    d.g = combine(d.g, s.g, fa, fb);
+    d.b = combine(d.b, s.b, fa, fb);
+  }
+};
+
+typedef WideOp_PorterDuff<WIDE_FACTOR_DA    , WIDE_FACTOR_ZERO  > WideOp_SrcIn;
+typedef WideOp_PorterDuff<WIDE_FACTOR_INV_DA, WIDE_FACTOR_ZERO  > WideOp_SrcOut;
+typedef WideOp_PorterDuff<WIDE_FACTOR_DA    , WIDE_FACTOR_INV_SA> WideOp_SrcAtop;
+typedef WideOp_PorterDuff<WIDE_FACTOR_INV_DA, WIDE_FACTOR_ONE   > WideOp_DstOver;
+typedef WideOp_PorterDuff<WIDE_FACTOR_ZERO  , WIDE_FACTOR_SA    > WideOp_DstIn;
+typedef WideOp_PorterDuff<WIDE_FACTOR_ZERO  , WIDE_FACTOR_INV_SA> WideOp_DstOut;
+typedef WideOp_PorterDuff<WIDE_FACTOR_INV_DA, WIDE_FACTOR_SA    > WideOp_DstAtop;
+typedef WideOp_PorterDuff<WIDE_FACTOR_INV_DA, WIDE_FACTOR_INV_SA> WideOp_Xor;
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeWide - Helpers]
+// ============================================================================
+
+//! @internal
+template<typename WideOp>
+struct FOG_NO_EXPORT CompositeWideBase
+{
+  //! @brief Composite @a s to @a d using a constant mask @a m (0...256).
+  static FOG_INLINE void blendMask(WidePixel& d, const WidePixel& s, uint32_t m)
+  {
+    WidePixel t = d;
+
+    WideOp::op(t, s);
+    WideHelpers::lerpPixel(d, t, m);
+  }
+
+  //! @brief Composite @a s to @a d using a per-component ARGB32 mask.
+  static FOG_INLINE void blendArgb32(WidePixel& d, const WidePixel& s, const uint8_t* msk)
+  {
+    WidePixel t = d;
+    uint32_t m;
+
+    WideOp::op(t, s);
+
+    m = msk[PIXEL_ARGB32_POS_A]; d.a = WideHelpers::lerp(d.a, t.a, m + (m >> 7));
+    m = msk[PIXEL_ARGB32_POS_R]; d.r = WideHelpers::lerp(d.r, t.r, m + (m >> 7));
+    m = msk[PIXEL_ARGB32_POS_G]; d.g = WideHelpers::lerp(d.g, t.g, m + (m >> 7));
+    m = msk[PIXEL_ARGB32_POS_B]; d.b = WideHelpers::lerp(d.b, t.b, m + (m >> 7));
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeWideCBlit]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Solid color compositing into 16-bit per component destination.
+//!
+//! The source color is always taken from @c RasterSolid::prgb64.
+template<typename WideOp, typename DstF>
+struct FOG_NO_EXPORT CompositeWideCBlit : public CompositeWideBase<WideOp>
+{
+  typedef CompositeWideBase<WideOp> Base;
+
+  // ==========================================================================
+  // [CBlit - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    WidePixel s;
+    WideHelpers::loadSolid(s, src);
+
+    FOG_BLIT_LOOP_DstFx1_INIT()
+
+    FOG_BLIT_LOOP_DstFx1_BEGIN(C_Opaque)
+      WidePixel d;
+
+      DstF::load(d, dst, closure);
+      WideOp::op(d, s);
+      DstF::store(dst, d);
+
+      dst += DstF::SIZE;
+    FOG_BLIT_LOOP_DstFx1_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [CBlit - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    WidePixel s;
+    WideHelpers::loadSolid(s, src);
+
+    FOG_CBLIT_SPAN8_BEGIN(DstF::SIZE)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_OPAQUE()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(C_Opaque)
+        WidePixel d;
+
+        DstF::load(d, dst, closure);
+        WideOp::op(d, s);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+      FOG_BLIT_LOOP_DstFx1_END(C_Opaque)
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_MASK()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(C_Mask)
+        WidePixel d;
+
+        DstF::load(d, dst, closure);
+        Base::blendMask(d, s, msk0);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+      FOG_BLIT_LOOP_DstFx1_END(C_Mask)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(A8_Glyph)
+        uint32_t m = msk[0];
+
+        if (m != 0x00)
+        {
+          WidePixel d;
+
+          DstF::load(d, dst, closure);
+          Base::blendMask(d, s, m + (m >> 7));
+          DstF::store(dst, d);
+        }
+
+        dst += DstF::SIZE;
+        msk += 1;
+      FOG_BLIT_LOOP_DstFx1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(A8_Extra)
+        WidePixel d;
+        uint32_t m;
+
+        Acc::p32Load2a(m, msk);
+        DstF::load(d, dst, closure);
+        Base::blendMask(d, s, m);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+        msk += 2;
+      FOG_BLIT_LOOP_DstFx1_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(ARGB32_Glyph)
+        WidePixel d;
+
+        DstF::load(d, dst, closure);
+        Base::blendArgb32(d, s, msk);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+        msk += 4;
+      FOG_BLIT_LOOP_DstFx1_END(ARGB32_Glyph)
+    }
+
+    FOG_CBLIT_SPAN8_END()
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_C - CompositeWideVBlit]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Variable source compositing into 16-bit per component destination.
+//!
+//! The source pixels are extended to 16-bit per component before they are
+//! composited so 8-bit sources can be mixed with 16-bit ones.
+template<typename WideOp, typename DstF, typename SrcF>
+struct FOG_NO_EXPORT CompositeWideVBlit : public CompositeWideBase<WideOp>
+{
+  typedef CompositeWideBase<WideOp> Base;
+
+  // ==========================================================================
+  // [VBlit - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_DstFx1_INIT()
+
+    FOG_BLIT_LOOP_DstFx1_BEGIN(C_Opaque)
+      WidePixel d;
+      WidePixel s;
+
+      DstF::load(d, dst, closure);
+      SrcF::load(s, src, closure);
+      WideOp::op(d, s);
+      DstF::store(dst, d);
+
+      dst += DstF::SIZE;
+      src += SrcF::SIZE;
+    FOG_BLIT_LOOP_DstFx1_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [VBlit - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    FOG_VBLIT_SPAN8_BEGIN(DstF::SIZE)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_OPAQUE()
+    {
+      line(dst, src, w, closure);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_MASK()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(C_Mask)
+        WidePixel d;
+        WidePixel s;
+
+        DstF::load(d, dst, closure);
+        SrcF::load(s, src, closure);
+        Base::blendMask(d, s, msk0);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+        src += SrcF::SIZE;
+      FOG_BLIT_LOOP_DstFx1_END(C_Mask)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(A8_Glyph)
+        uint32_t m = msk[0];
+
+        if (m != 0x00)
+        {
+          WidePixel d;
+          WidePixel s;
+
+          DstF::load(d, dst, closure);
+          SrcF::load(s, src, closure);
+          Base::blendMask(d, s, m + (m >> 7));
+          DstF::store(dst, d);
+        }
+
+        dst += DstF::SIZE;
+        src += SrcF::SIZE;
+        msk += 1;
+      FOG_BLIT_LOOP_DstFx1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(A8_Extra)
+        WidePixel d;
+        WidePixel s;
+        uint32_t m;
+
+        Acc::p32Load2a(m, msk);
+        DstF::load(d, dst, closure);
+        SrcF::load(s, src, closure);
+        Base::blendMask(d, s, m);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+        src += SrcF::SIZE;
+        msk += 2;
+      FOG_BLIT_LOOP_DstFx1_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_DstFx1_INIT()
+
+      FOG_BLIT_LOOP_DstFx1_BEGIN(ARGB32_Glyph)
+        WidePixel d;
+        WidePixel s;
+
+        DstF::load(d, dst, closure);
+        SrcF::load(s, src, closure);
+        Base::blendArgb32(d, s, msk);
+        DstF::store(dst, d);
+
+        dst += DstF::SIZE;
+        src += SrcF::SIZE;
+        msk += 4;
+      FOG_BLIT_LOOP_DstFx1_END(ARGB32_Glyph)
+    }
+
+    FOG_VBLIT_SPAN8_END()
+  }
+};
+
+} // RasterOps_C namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_C_COMPOSITEWIDE_P_H
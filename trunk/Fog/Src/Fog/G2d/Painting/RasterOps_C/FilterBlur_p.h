@@ -561,7 +561,7 @@ struct FOG_NO_EXPORT FBlurBaseAccessor_A8 : public FBaseAccessor_A8
 
   static FOG_INLINE void fetchRunT(Run& run, uint8_t* src)
   {
-    fethRunM(run, src);
+    fetchRunM(run, src);
   }
 
   static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run, IntT scale, uint32_t shift)
@@ -705,9 +705,9 @@ struct FOG_NO_EXPORT FBlurExpAccessor_RGB24 : public FBlurBaseAccessor_RGB24<int
 
   static FOG_INLINE void blurRunM(Run& run, const uint8_t* src, int32_t aValue)
   {
-    run.r += (aValue * (static_cast<int32_t>(src[PIXEL_RGB24_BYTE_R]) - run.r)) >> BLUR_APREC;
-    run.g += (aValue * (static_cast<int32_t>(src[PIXEL_RGB24_BYTE_G]) - run.g)) >> BLUR_APREC;
-    run.b += (aValue * (static_cast<int32_t>(src[PIXEL_RGB24_BYTE_B]) - run.b)) >> BLUR_APREC;
+    run.r += (aValue * ((static_cast<int32_t>(src[PIXEL_RGB24_BYTE_R]) << BLUR_ZPREC) - run.r)) >> BLUR_APREC;
+    run.g += (aValue * ((static_cast<int32_t>(src[PIXEL_RGB24_BYTE_G]) << BLUR_ZPREC) - run.g)) >> BLUR_APREC;
+    run.b += (aValue * ((static_cast<int32_t>(src[PIXEL_RGB24_BYTE_B]) << BLUR_ZPREC) - run.b)) >> BLUR_APREC;
   }
 
   static FOG_INLINE void blurRunT(Run& run, const uint8_t* src, int32_t aValue)
@@ -748,7 +748,7 @@ struct FOG_NO_EXPORT FBlurExpAccessor_A8 : public FBlurBaseAccessor_A8<int32_t>
 
   static FOG_INLINE void blurRunM(Run& run, const uint8_t* src, int32_t aValue)
   {
-    run.a += (aValue * (static_cast<int32_t>(src[0]) - run.a)) >> BLUR_APREC;
+    run.a += (aValue * ((static_cast<int32_t>(src[0]) << BLUR_ZPREC) - run.a)) >> BLUR_APREC;
   }
 
   static FOG_INLINE void blurRunT(Run& run, const uint8_t* src, int32_t aValue)
@@ -909,9 +909,11 @@ struct FOG_NO_EXPORT FBlur
     ssize_t intermediateStride = 0;
     uint8_t* intermediateData = NULL;
 
-    // Always use 4 bytes of stack storage per pixel when working with 24-bpp.
+    // Always use at least 4 bytes of stack storage per pixel. The 24-bpp
+    // formats are stored as 32-bit pixels and the optimized A8 vertical blur
+    // processes four adjacent pixels at once.
     int stackBpp = srcDesc.getBytesPerPixel();
-    if (stackBpp == 3)
+    if (stackBpp < 4)
       stackBpp = 4;
 
     RasterFilterBlur blurCtx;
@@ -2301,6 +2303,7 @@ _First:
             stackA += Accessor::STACK_BPP;
           }
 
+          pos += i;
           while (--i)
           {
             for (x = 0; x < xLength; x++)
@@ -2489,7 +2492,6 @@ _First:
           runA[x].sub(cmp0);
 
           Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
-          srcPtr += Accessor::PIXEL_BPP;
           stackA += Accessor::STACK_BPP;
           stackB += Accessor::STACK_BPP;
         }
@@ -2537,7 +2539,6 @@ _First:
               runA[x].sub(cmp0);
 
               Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
-              srcPtr += Accessor::PIXEL_BPP;
               stackA += Accessor::STACK_BPP;
               stackB += Accessor::STACK_BPP;
             }
@@ -2576,7 +2577,6 @@ _First:
 
               Accessor::storeRunM(dstPtr + x * Accessor::PIXEL_BPP, run[x], sumMul, sumShr);
 
-              srcPtr += Accessor::PIXEL_BPP;
               stackA += Accessor::STACK_BPP;
               stackB += Accessor::STACK_BPP;
             }
@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/G2d/Geometry/Math2d.h>
+#include <Fog/G2d/Painting/RasterGradientCache_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseDefs_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseHelpers_p.h>
 
@@ -193,13 +194,22 @@ struct FOG_NO_EXPORT PGradientBase
       case IMAGE_FORMAT_PRGB32:
       case IMAGE_FORMAT_XRGB32:
       case IMAGE_FORMAT_RGB24:
+      // The 16-bit per component targets use the 8-bit color-table, the PRGB32
+      // format is accepted by all of their compositors (including the extended
+      // ones), thus XRGB32 is never used as the source format here.
+      case IMAGE_FORMAT_PRGB64:
+      case IMAGE_FORMAT_RGB48:
       {
         // Get whether the gradient is opaque or not.
         bool isOpaque = stops->isOpaqueARGB32();
         // Decide which pixel format to use.
-        uint32_t srcFormat = isOpaque ? IMAGE_FORMAT_XRGB32 : IMAGE_FORMAT_PRGB32;
+        uint32_t srcFormat = (isOpaque && !ImageFormatDescription::getByFormat(dstFormat).is16Bpc())
+          ? IMAGE_FORMAT_XRGB32
+          : IMAGE_FORMAT_PRGB32;
 
-        // Get or create the color-table (ColorStopCache instance).
+        // Get the color-table (ColorStopCache instance) of the color-stop list
+        // or the shared one from the gradient-cache (it's shared by all lists
+        // having the same stops).
         ColorStopCache* cache = AtomicCore<ColorStopCache*>::get(&stops->_d->stopCachePrgb32);
         if (cache != NULL)
         {
@@ -207,22 +217,13 @@ struct FOG_NO_EXPORT PGradientBase
         }
         else
         {
-          // Try to create the color-stop cache.
-          cache = ColorStopCache::create32(srcFormat, get_optimal_cache_length(stops));
+          cache = RasterGradientCache::getCache(*stops, srcFormat, get_optimal_cache_length(stops));
           if (FOG_IS_NULL(cache)) return ERR_RT_OUT_OF_MEMORY;
 
-          cache->reference.init(2);
-
-          _api_raster.gradient.interpolate[srcFormat](
-            reinterpret_cast<uint8_t*>(cache->getData()), cache->getLength(), stops->getList(), stops->getLength());
-
-          // Assign also the end point.
-          uint32_t* table = reinterpret_cast<uint32_t*>(cache->getData());
-          table[cache->getLength()] = table[cache->getLength() - 1];
-
-          // Try to add it back to the ColorStopList instance. If we failed then
+          // Try to add it also to the ColorStopList instance. If we failed then
           // some other thread was faster than us, in this case it's needed to
-          // decrease the reference count of the instance we created.
+          // decrease the reference count we added.
+          cache->reference.inc();
           if (!AtomicCore<ColorStopCache*>::cmpXchg(&stops->_d->stopCachePrgb32, (ColorStopCache*)NULL, cache))
             cache->reference.dec();
         }
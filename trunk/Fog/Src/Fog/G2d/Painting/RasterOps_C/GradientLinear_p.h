@@ -110,6 +110,16 @@ struct FOG_NO_EXPORT PGradientLinear
       ctx->_destroy = PGradientBase::destroy;
       ctx->_fetch = _api_raster.gradient.linear.fetch_simple_nearest[srcFormat][spread];
       ctx->_skip = skip_simple;
+
+      if (dstFormat == IMAGE_FORMAT_PRGB32 || dstFormat == IMAGE_FORMAT_XRGB32)
+      {
+        ctx->_fused = _api_raster.fused.gradient_linear_simple_nearest[spread];
+
+        if (spread == GRADIENT_SPREAD_PAD)
+          ctx->_jitSource = RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_PAD;
+        else if (spread == GRADIENT_SPREAD_REPEAT)
+          ctx->_jitSource = RASTER_JIT_SOURCE_GRADIENT_LINEAR_SIMPLE_NEAREST_REPEAT;
+      }
     }
 
     // ------------------------------------------------------------------------
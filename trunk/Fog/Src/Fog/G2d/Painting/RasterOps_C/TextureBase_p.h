@@ -8,6 +8,7 @@
 #define _FOG_G2D_PAINTING_RASTEROPS_C_TEXTUREBASE_P_H
 
 #include <Fog/G2d/Geometry/Math2d.h>
+#include <Fog/G2d/Painting/RasterMipmap_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseDefs_p.h>
 #include <Fog/G2d/Painting/RasterOps_C/BaseHelpers_p.h>
 
@@ -42,6 +43,19 @@ struct FOG_NO_EXPORT PTextureBase
     // [Prepare]
     // ------------------------------------------------------------------------
 
+    // Use the mipmap level if the texture is downscaled (the levels are built
+    // by the paint engine, see RasterMipmap::prepare()).
+    Image mipImage;
+    RectI mipFragment(UNINITIALIZED);
+    TransformD mipTr(UNINITIALIZED);
+
+    if (RasterMipmap::select(mipImage, mipFragment, mipTr, *srcImage, *srcFragment, *tr, imageQuality))
+    {
+      srcImage = &mipImage;
+      srcFragment = &mipFragment;
+      tr = &mipTr;
+    }
+
     uint32_t transformType = tr->getType();
     TransformD inv(UNINITIALIZED);
 
@@ -52,7 +66,8 @@ struct FOG_NO_EXPORT PTextureBase
 
     uint32_t srcFormat = srcImage->getFormat();
     uint32_t srcBPP = srcImage->getBytesPerPixel();
-    uint32_t srcHasAlpha = (srcImage->getFormatDescription().getComponentMask() & IMAGE_COMPONENT_ALPHA) != 0;
+    uint32_t srcHasAlpha = (srcImage->getFormatDescription().getComponentMask() & IMAGE_COMPONENT_ALPHA) != 0 &&
+                           !RasterUtil::isOpaqueImage(srcImage->_d);
     ssize_t srcStride = srcImage->getStride();
 
     if (tileMode == TEXTURE_TILE_CLAMP)
@@ -120,30 +135,18 @@ _Has8BPC:
       // [16 Bits Per Component]
       // ----------------------------------------------------------------------
 
+      // Textures are fetched using 8-bit per component pipeline, the 16-bit
+      // compositors are able to use PRGB32 and A8 sources directly.
       case IMAGE_FORMAT_PRGB64:
       case IMAGE_FORMAT_RGB48:
-        if (srcHasAlpha)
-        {
-          fetchFormat = IMAGE_FORMAT_PRGB64;
-          fetchFuncs = &_api_raster.texture.prgb64;
-        }
-        else
-        {
-          fetchFormat = IMAGE_FORMAT_RGB48;
-          fetchFuncs = &_api_raster.texture.rgb48;
-        }
-        goto _Has16BPC;
+        fetchFormat = IMAGE_FORMAT_PRGB32;
+        fetchFuncs = &_api_raster.texture.prgb32;
+        goto _Has8BPC;
 
       case IMAGE_FORMAT_A16:
-        fetchFormat = IMAGE_FORMAT_A16;
-        fetchFuncs = &_api_raster.texture.a16;
-
-_Has16BPC:
-        if (tileMode == TEXTURE_TILE_CLAMP)
-        {
-          Acc::p64PRGB64FromARGB64(ctx->_d.texture.base.clamp.prgb64.p64, clampColor->getArgb64().p64);
-        }
-        break;
+        fetchFormat = IMAGE_FORMAT_A8;
+        fetchFuncs = &_api_raster.texture.a8;
+        goto _Has8BPC;
 
       case IMAGE_FORMAT_I8:
       default:
@@ -243,6 +246,9 @@ _Has16BPC:
       ctx->_d.texture.simple.ty = ty;
 
       ctx->_fetch = fetchFuncs->fetch_simple_align[srcFormat][tileMode];
+
+      if (dstFormat == IMAGE_FORMAT_PRGB32 || dstFormat == IMAGE_FORMAT_XRGB32)
+        ctx->_fused = _api_raster.fused.texture_simple_align[srcFormat][tileMode];
       return ERR_OK;
     }
 
@@ -332,9 +338,17 @@ _Has16BPC:
       }
 
       if (imageQuality == IMAGE_QUALITY_NEAREST)
+      {
         ctx->_fetch = fetchFuncs->fetch_affine_nearest[srcFormat][tileMode];
+      }
       else
+      {
         ctx->_fetch = fetchFuncs->fetch_affine_bilinear[srcFormat][tileMode];
+
+        // Fused functions implement only the fixed-point loop.
+        if ((dstFormat == IMAGE_FORMAT_PRGB32 || dstFormat == IMAGE_FORMAT_XRGB32) && ctx->_d.texture.affine.safeFixedPoint)
+          ctx->_fused = _api_raster.fused.texture_affine_bilinear[srcFormat][tileMode];
+      }
       return ERR_OK;
     }
 
@@ -0,0 +1,605 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEWIDE_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEWIDE_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/CompositeBase_p.h>
+#include <Fog/G2d/Painting/RasterOps_C/CompositeWide_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - CompositeWide - Constants]
+// ============================================================================
+
+FOG_XMM_DECLARE_CONST_PI32_SET(CompositeWide_0x8000, 0x00008000);
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - CompositeWideSrcOver]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief SSE2 version of 16-bit per component SRC_OVER (PRGB64 destination).
+//!
+//! Two PRGB64 pixels fit into one XMM register. Only the most common paths
+//! are implemented here, the ARGB32 glyph spans are handled by the C version
+//! (see @ref RasterOps_C::CompositeWideCBlit and RasterOps_C::CompositeWideVBlit).
+struct FOG_NO_EXPORT CompositeWideSrcOver
+{
+  typedef RasterOps_C::CompositeWideBase<RasterOps_C::WideOp_SrcOver> CBase;
+
+  // ==========================================================================
+  // [Helpers]
+  // ==========================================================================
+
+  //! @brief Get @a x * @a y / 65535 (rounded), for all eight 16-bit lanes.
+  static FOG_INLINE void _mulDiv65535(__m128i& dst0, const __m128i& x0, const __m128i& y0)
+  {
+    __m128i lo0, hi0;
+    __m128i p0, p1;
+    __m128i t0, t1;
+
+    Acc::m128iMulLoPI16(lo0, x0, y0);
+    Acc::m128iMulHiPU16(hi0, x0, y0);
+
+    Acc::m128iUnpackPI32FromPI16Lo(p0, lo0, hi0);
+    Acc::m128iUnpackPI32FromPI16Hi(p1, lo0, hi0);
+
+    Acc::m128iAddPI32(p0, p0, FOG_XMM_GET_CONST_PI(CompositeWide_0x8000));
+    Acc::m128iAddPI32(p1, p1, FOG_XMM_GET_CONST_PI(CompositeWide_0x8000));
+
+    Acc::m128iRShiftPU32<16>(t0, p0);
+    Acc::m128iRShiftPU32<16>(t1, p1);
+    Acc::m128iAddPI32(p0, p0, t0);
+    Acc::m128iAddPI32(p1, p1, t1);
+    Acc::m128iRShiftPU32<16>(p0, p0);
+    Acc::m128iRShiftPU32<16>(p1, p1);
+
+    Acc::m128iPackPU16FromPI32(dst0, p0, p1);
+  }
+
+  //! @brief Scale premultiplied @a src0 by the mask @a m (0...256).
+  static FOG_INLINE void _mulMask(__m128i& dst0, const __m128i& src0, uint32_t m)
+  {
+    __m128i m0;
+
+    // (src * m) >> 8 is the same as mulhi(src, m << 8), m must be below 256.
+    Acc::m128iCvtSI128FromSI(m0, (int)(m << 8));
+    Acc::m128iShufflePI16Lo<0, 0, 0, 0>(m0, m0);
+    Acc::m128iShufflePI32<0, 0, 0, 0>(m0, m0);
+    Acc::m128iMulHiPU16(dst0, src0, m0);
+  }
+
+  //! @brief Get inverted alpha of both pixels in @a src0, broadcasted.
+  static FOG_INLINE void _invAlpha(__m128i& dst0, const __m128i& src0)
+  {
+    Acc::m128iShufflePI16Lo<PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A>(dst0, src0);
+    Acc::m128iShufflePI16Hi<PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A, PIXEL_ARGB64_WORD_A>(dst0, dst0);
+    Acc::m128iNegate65535PI16(dst0, dst0);
+  }
+
+  //! @brief Dst = Src + Dst * (1 - Src.a).
+  static FOG_INLINE void _srcOver(__m128i& dst0, const __m128i& src0, const __m128i& sia0)
+  {
+    _mulDiv65535(dst0, dst0, sia0);
+    Acc::m128iAddusPU16(dst0, dst0, src0);
+  }
+
+  static FOG_INLINE void _srcOver(__m128i& dst0, const __m128i& src0)
+  {
+    __m128i sia0;
+
+    _invAlpha(sia0, src0);
+    _srcOver(dst0, src0, sia0);
+  }
+
+  //! @brief Load two PRGB32 pixels and extend them to PRGB64.
+  static FOG_INLINE void _loadPrgb32_2x(__m128i& dst0, const uint8_t* src)
+  {
+    Acc::m128iLoad8(dst0, src);
+    Acc::m128iUnpackPI16FromPI8Lo(dst0, dst0, dst0);
+  }
+
+  //! @brief Load one PRGB32 pixel and extend it to PRGB64.
+  static FOG_INLINE void _loadPrgb32_1x(__m128i& dst0, const uint8_t* src)
+  {
+    Acc::m128iLoad4(dst0, src);
+    Acc::m128iUnpackPI16FromPI8Lo(dst0, dst0, dst0);
+  }
+
+  // ==========================================================================
+  // [PRGB64 - CBlit - PRGB64 - Helpers]
+  // ==========================================================================
+
+  static FOG_INLINE void _prgb64_cblit_prgb64_line(
+    uint8_t* dst, int w, const __m128i& src0xmm, const __m128i& sia0xmm)
+  {
+    FOG_BLIT_LOOP_64x2_INIT()
+
+    FOG_BLIT_LOOP_64x2_SMALL_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+
+      Acc::m128iLoad8(dst0xmm, dst);
+      _srcOver(dst0xmm, src0xmm, sia0xmm);
+      Acc::m128iStore8(dst, dst0xmm);
+
+      dst += 8;
+    FOG_BLIT_LOOP_64x2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_64x2_MAIN_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+
+      Acc::m128iLoad16a(dst0xmm, dst);
+      _srcOver(dst0xmm, src0xmm, sia0xmm);
+      Acc::m128iStore16a(dst, dst0xmm);
+
+      dst += 16;
+    FOG_BLIT_LOOP_64x2_MAIN_END(C_Opaque)
+  }
+
+  static FOG_INLINE void _loadSolid(__m128i& src0xmm, const RasterSolid* src)
+  {
+    Acc::m128iLoad8(src0xmm, &src->prgb64);
+    Acc::m128iShufflePI32<1, 0, 1, 0>(src0xmm, src0xmm);
+  }
+
+  // ==========================================================================
+  // [PRGB64 - CBlit - PRGB64 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_cblit_prgb64_line(
+    uint8_t* dst, const RasterSolid* src, int w, const RasterClosure* closure)
+  {
+    __m128i src0xmm;
+    __m128i sia0xmm;
+
+    _loadSolid(src0xmm, src);
+    _invAlpha(sia0xmm, src0xmm);
+
+    _prgb64_cblit_prgb64_line(dst, w, src0xmm, sia0xmm);
+  }
+
+  // ==========================================================================
+  // [PRGB64 - CBlit - PRGB64 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_cblit_prgb64_span(
+    uint8_t* dst, const RasterSolid* src, const RasterSpan* span, const RasterClosure* closure)
+  {
+    __m128i src0xmm;
+    __m128i sia0xmm;
+
+    _loadSolid(src0xmm, src);
+    _invAlpha(sia0xmm, src0xmm);
+
+    RasterOps_C::WidePixel srcWide;
+    RasterOps_C::WideHelpers::loadSolid(srcWide, src);
+
+    FOG_CBLIT_SPAN8_BEGIN(8)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_OPAQUE()
+    {
+      _prgb64_cblit_prgb64_line(dst, w, src0xmm, sia0xmm);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_C_MASK()
+    {
+      __m128i srcm0xmm;
+      __m128i siam0xmm;
+
+      _mulMask(srcm0xmm, src0xmm, msk0);
+      _invAlpha(siam0xmm, srcm0xmm);
+
+      _prgb64_cblit_prgb64_line(dst, w, srcm0xmm, siam0xmm);
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Glyph)
+        uint32_t m = msk[0];
+
+        if (m == 0xFF)
+        {
+          __m128i dst0xmm;
+
+          Acc::m128iLoad8(dst0xmm, dst);
+          _srcOver(dst0xmm, src0xmm, sia0xmm);
+          Acc::m128iStore8(dst, dst0xmm);
+        }
+        else if (m != 0x00)
+        {
+          __m128i dst0xmm;
+          __m128i srcm0xmm;
+
+          Acc::m128iLoad8(dst0xmm, dst);
+          _mulMask(srcm0xmm, src0xmm, m + (m >> 7));
+          _srcOver(dst0xmm, srcm0xmm);
+          Acc::m128iStore8(dst, dst0xmm);
+        }
+
+        dst += 8;
+        msk += 1;
+      FOG_BLIT_LOOP_64x1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Extra)
+        __m128i dst0xmm;
+        __m128i srcm0xmm;
+        uint32_t m;
+
+        Acc::p32Load2a(m, msk);
+        Acc::m128iLoad8(dst0xmm, dst);
+
+        if (m >= 0x100)
+        {
+          _srcOver(dst0xmm, src0xmm, sia0xmm);
+        }
+        else
+        {
+          _mulMask(srcm0xmm, src0xmm, m);
+          _srcOver(dst0xmm, srcm0xmm);
+        }
+
+        Acc::m128iStore8(dst, dst0xmm);
+
+        dst += 8;
+        msk += 2;
+      FOG_BLIT_LOOP_64x1_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_CBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(ARGB32_Glyph)
+        RasterOps_C::WidePixel d;
+
+        RasterOps_C::WideDst_PRGB64::load(d, dst, closure);
+        CBase::blendArgb32(d, srcWide, msk);
+        RasterOps_C::WideDst_PRGB64::store(dst, d);
+
+        dst += 8;
+        msk += 4;
+      FOG_BLIT_LOOP_64x1_END(ARGB32_Glyph)
+    }
+
+    FOG_CBLIT_SPAN8_END()
+  }
+
+  // ==========================================================================
+  // [PRGB64 - VBlit - PRGB64 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_vblit_prgb64_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_64x2_INIT()
+
+    FOG_BLIT_LOOP_64x2_SMALL_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+      __m128i src0xmm;
+
+      Acc::m128iLoad8(dst0xmm, dst);
+      Acc::m128iLoad8(src0xmm, src);
+      _srcOver(dst0xmm, src0xmm);
+      Acc::m128iStore8(dst, dst0xmm);
+
+      dst += 8;
+      src += 8;
+    FOG_BLIT_LOOP_64x2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_64x2_MAIN_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+      __m128i src0xmm;
+
+      Acc::m128iLoad16a(dst0xmm, dst);
+      Acc::m128iLoad16u(src0xmm, src);
+      _srcOver(dst0xmm, src0xmm);
+      Acc::m128iStore16a(dst, dst0xmm);
+
+      dst += 16;
+      src += 16;
+    FOG_BLIT_LOOP_64x2_MAIN_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB64 - VBlit - PRGB64 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_vblit_prgb64_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    FOG_VBLIT_SPAN8_BEGIN(8)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_OPAQUE()
+    {
+      prgb64_vblit_prgb64_line(dst, src, w, closure);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_MASK()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(C_Mask)
+        __m128i dst0xmm;
+        __m128i src0xmm;
+
+        Acc::m128iLoad8(dst0xmm, dst);
+        Acc::m128iLoad8(src0xmm, src);
+        _mulMask(src0xmm, src0xmm, msk0);
+        _srcOver(dst0xmm, src0xmm);
+        Acc::m128iStore8(dst, dst0xmm);
+
+        dst += 8;
+        src += 8;
+      FOG_BLIT_LOOP_64x1_END(C_Mask)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Glyph)
+        uint32_t m = msk[0];
+
+        if (m != 0x00)
+        {
+          __m128i dst0xmm;
+          __m128i src0xmm;
+
+          Acc::m128iLoad8(dst0xmm, dst);
+          Acc::m128iLoad8(src0xmm, src);
+          if (m != 0xFF)
+            _mulMask(src0xmm, src0xmm, m + (m >> 7));
+          _srcOver(dst0xmm, src0xmm);
+          Acc::m128iStore8(dst, dst0xmm);
+        }
+
+        dst += 8;
+        src += 8;
+        msk += 1;
+      FOG_BLIT_LOOP_64x1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Extra)
+        __m128i dst0xmm;
+        __m128i src0xmm;
+        uint32_t m;
+
+        Acc::p32Load2a(m, msk);
+        Acc::m128iLoad8(dst0xmm, dst);
+        Acc::m128iLoad8(src0xmm, src);
+        if (m < 0x100)
+          _mulMask(src0xmm, src0xmm, m);
+        _srcOver(dst0xmm, src0xmm);
+        Acc::m128iStore8(dst, dst0xmm);
+
+        dst += 8;
+        src += 8;
+        msk += 2;
+      FOG_BLIT_LOOP_64x1_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(ARGB32_Glyph)
+        RasterOps_C::WidePixel d;
+        RasterOps_C::WidePixel s;
+
+        RasterOps_C::WideDst_PRGB64::load(d, dst, closure);
+        RasterOps_C::WideSrc_PRGB64::load(s, src, closure);
+        CBase::blendArgb32(d, s, msk);
+        RasterOps_C::WideDst_PRGB64::store(dst, d);
+
+        dst += 8;
+        src += 8;
+        msk += 4;
+      FOG_BLIT_LOOP_64x1_END(ARGB32_Glyph)
+    }
+
+    FOG_VBLIT_SPAN8_END()
+  }
+
+  // ==========================================================================
+  // [PRGB64 - VBlit - PRGB32 - Line]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_vblit_prgb32_line(
+    uint8_t* dst, const uint8_t* src, int w, const RasterClosure* closure)
+  {
+    FOG_BLIT_LOOP_64x2_INIT()
+
+    FOG_BLIT_LOOP_64x2_SMALL_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+      __m128i src0xmm;
+
+      Acc::m128iLoad8(dst0xmm, dst);
+      _loadPrgb32_1x(src0xmm, src);
+      _srcOver(dst0xmm, src0xmm);
+      Acc::m128iStore8(dst, dst0xmm);
+
+      dst += 8;
+      src += 4;
+    FOG_BLIT_LOOP_64x2_SMALL_END(C_Opaque)
+
+    FOG_BLIT_LOOP_64x2_MAIN_BEGIN(C_Opaque)
+      __m128i dst0xmm;
+      __m128i src0xmm;
+
+      Acc::m128iLoad16a(dst0xmm, dst);
+      _loadPrgb32_2x(src0xmm, src);
+      _srcOver(dst0xmm, src0xmm);
+      Acc::m128iStore16a(dst, dst0xmm);
+
+      dst += 16;
+      src += 8;
+    FOG_BLIT_LOOP_64x2_MAIN_END(C_Opaque)
+  }
+
+  // ==========================================================================
+  // [PRGB64 - VBlit - PRGB32 - Span]
+  // ==========================================================================
+
+  static void FOG_FASTCALL prgb64_vblit_prgb32_span(
+    uint8_t* dst, const RasterSpan* span, const RasterClosure* closure)
+  {
+    FOG_VBLIT_SPAN8_BEGIN(8)
+
+    // ------------------------------------------------------------------------
+    // [C-Opaque]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_OPAQUE()
+    {
+      prgb64_vblit_prgb32_line(dst, src, w, closure);
+    }
+
+    // ------------------------------------------------------------------------
+    // [C-Mask]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_C_MASK()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(C_Mask)
+        __m128i dst0xmm;
+        __m128i src0xmm;
+
+        Acc::m128iLoad8(dst0xmm, dst);
+        _loadPrgb32_1x(src0xmm, src);
+        _mulMask(src0xmm, src0xmm, msk0);
+        _srcOver(dst0xmm, src0xmm);
+        Acc::m128iStore8(dst, dst0xmm);
+
+        dst += 8;
+        src += 4;
+      FOG_BLIT_LOOP_64x1_END(C_Mask)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Glyph)
+        uint32_t m = msk[0];
+
+        if (m != 0x00)
+        {
+          __m128i dst0xmm;
+          __m128i src0xmm;
+
+          Acc::m128iLoad8(dst0xmm, dst);
+          _loadPrgb32_1x(src0xmm, src);
+          if (m != 0xFF)
+            _mulMask(src0xmm, src0xmm, m + (m >> 7));
+          _srcOver(dst0xmm, src0xmm);
+          Acc::m128iStore8(dst, dst0xmm);
+        }
+
+        dst += 8;
+        src += 4;
+        msk += 1;
+      FOG_BLIT_LOOP_64x1_END(A8_Glyph)
+    }
+
+    // ------------------------------------------------------------------------
+    // [A8-Extra]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_A8_EXTRA()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(A8_Extra)
+        __m128i dst0xmm;
+        __m128i src0xmm;
+        uint32_t m;
+
+        Acc::p32Load2a(m, msk);
+        Acc::m128iLoad8(dst0xmm, dst);
+        _loadPrgb32_1x(src0xmm, src);
+        if (m < 0x100)
+          _mulMask(src0xmm, src0xmm, m);
+        _srcOver(dst0xmm, src0xmm);
+        Acc::m128iStore8(dst, dst0xmm);
+
+        dst += 8;
+        src += 4;
+        msk += 2;
+      FOG_BLIT_LOOP_64x1_END(A8_Extra)
+    }
+
+    // ------------------------------------------------------------------------
+    // [ARGB32-Glyph]
+    // ------------------------------------------------------------------------
+
+    FOG_VBLIT_SPAN8_ARGB32_GLYPH()
+    {
+      FOG_BLIT_LOOP_64x1_BEGIN(ARGB32_Glyph)
+        RasterOps_C::WidePixel d;
+        RasterOps_C::WidePixel s;
+
+        RasterOps_C::WideDst_PRGB64::load(d, dst, closure);
+        RasterOps_C::WideSrc_PRGB32::load(s, src, closure);
+        CBase::blendArgb32(d, s, msk);
+        RasterOps_C::WideDst_PRGB64::store(dst, d);
+
+        dst += 8;
+        src += 4;
+        msk += 4;
+      FOG_BLIT_LOOP_64x1_END(ARGB32_Glyph)
+    }
+
+    FOG_VBLIT_SPAN8_END()
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_COMPOSITEWIDE_P_H
@@ -0,0 +1,452 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
+#define _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
+
+// [Dependencies]
+#include <Fog/G2d/Painting/RasterOps_SSE2/BaseDefs_p.h>
+
+// [Dependencies - RasterOps_C]
+#include <Fog/G2d/Painting/RasterOps_C/FilterBlur_p.h>
+
+namespace Fog {
+namespace RasterOps_SSE2 {
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Base]
+// ============================================================================
+
+// The SSE2 blur reuses the loops implemented by RasterOps_C::FBlur, only the
+// run and accessors are different. The run holds all four components in one
+// XMM register (each component in a 32-bit lane), so the additions and
+// subtractions done per pixel (the hot-path of all blur types) are processed
+// by a single instruction instead of four.
+//
+// The pixel type is the same as in the C version (packed 32-bit integer), so
+// the blur stack has the same layout and only the run is unpacked.
+//
+// The A8 format is handled by the vertical blur only - four adjacent columns
+// are loaded as one 32-bit pixel and processed as four independent components
+// using the PRGB32 run. The remaining columns and the horizontal blur are
+// handled by the C version.
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Run - PRGB32]
+// ============================================================================
+
+struct FOG_NO_EXPORT FBlurRun_PRGB32
+{
+  typedef FBlurRun_PRGB32 Run;
+  typedef RasterOps_C::FBaseAccessor_PRGB32::Pixel Pixel;
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void unpack(__m128i& dst, const Pixel& pix)
+  {
+    Acc::m128iCvtSI128FromSI(dst, static_cast<int>(pix));
+    Acc::m128iUnpackPI32FromPI8Lo(dst, dst);
+  }
+
+  static FOG_INLINE void mul(__m128i& dst, const __m128i& x, uint32_t scale)
+  {
+    __m128i s;
+
+    Acc::m128iCvtSI128FromSI(s, static_cast<int>(scale));
+    s = _mm_shuffle_epi32(s, _MM_SHUFFLE(0, 0, 0, 0));
+    Acc::m128iMulPU32(dst, x, s);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    Acc::m128iZero(v);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Set]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void set(const Run& run)
+  {
+    v = run.v;
+  }
+
+  FOG_INLINE void set(const Run& run, uint32_t scale)
+  {
+    mul(v, run.v, scale);
+  }
+
+  FOG_INLINE void set(const Pixel& pix)
+  {
+    unpack(v, pix);
+  }
+
+  FOG_INLINE void set(const Pixel& pix, uint32_t scale)
+  {
+    unpack(v, pix);
+    mul(v, v, scale);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Ops]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void add(const Pixel& pix)
+  {
+    __m128i t;
+
+    unpack(t, pix);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void add(const Pixel& pix, uint32_t scale)
+  {
+    __m128i t;
+
+    unpack(t, pix);
+    mul(t, t, scale);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void add(const Run& run)
+  {
+    Acc::m128iAddPI32(v, v, run.v);
+  }
+
+  FOG_INLINE void add(const Run& run, uint32_t scale)
+  {
+    __m128i t;
+
+    mul(t, run.v, scale);
+    Acc::m128iAddPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Pixel& pix)
+  {
+    __m128i t;
+
+    unpack(t, pix);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Pixel& pix, uint32_t scale)
+  {
+    __m128i t;
+
+    unpack(t, pix);
+    mul(t, t, scale);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void sub(const Run& run)
+  {
+    Acc::m128iSubPI32(v, v, run.v);
+  }
+
+  FOG_INLINE void sub(const Run& run, uint32_t scale)
+  {
+    __m128i t;
+
+    mul(t, run.v, scale);
+    Acc::m128iSubPI32(v, v, t);
+  }
+
+  FOG_INLINE void shl(int by)
+  {
+    v = _mm_sll_epi32(v, _mm_cvtsi32_si128(by));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  __m128i v;
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Simple - Accessor - PRGB32]
+// ============================================================================
+
+struct FOG_NO_EXPORT FBlurBaseAccessor_PRGB32 : public RasterOps_C::FBaseAccessor_PRGB32
+{
+  typedef FBlurRun_PRGB32 Run;
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Scale all components of @a run, shift them right and pack them to
+  //! a 32-bit pixel.
+  //!
+  //! The multiplication is done using 64-bit products, because @c _mm_mul_epu32
+  //! is the only 32-bit multiplication available in SSE2. This is also used by
+  //! the stack blur, where the sum multiplied by the scale can exceed 32 bits.
+  static FOG_INLINE uint32_t packRun(const Run& run, uint32_t scale, uint32_t shift)
+  {
+    __m128i s, t, x0, x1;
+
+    Acc::m128iCvtSI128FromSI(s, static_cast<int>(scale));
+    Acc::m128iCvtSI128FromSI(t, static_cast<int>(shift));
+
+    s = _mm_shuffle_epi32(s, _MM_SHUFFLE(0, 0, 0, 0));
+    Acc::m128iRShiftPU64<32>(x1, run.v);
+
+    x0 = _mm_mul_epu32(run.v, s);
+    x1 = _mm_mul_epu32(x1, s);
+
+    x0 = _mm_srl_epi64(x0, t);
+    x1 = _mm_srl_epi64(x1, t);
+
+    Acc::m128iLShiftPU64<32>(x1, x1);
+    Acc::m128iOr(x0, x0, x1);
+    Acc::m128iPackPU8FromPI32(x0, x0);
+
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(x0));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void fetchRunM(Run& run, const uint8_t* src)
+  {
+    uint32_t pix;
+    Acc::p32Load4a(pix, src);
+    run.set(pix);
+  }
+
+  static FOG_INLINE void fetchRunT(Run& run, const uint8_t* src)
+  {
+    fetchRunM(run, src);
+  }
+
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    Acc::p32Store4a(dst, packRun(run, scale, shift));
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    storeRunM(dst, run, scale, shift);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Simple - Accessor - XRGB32]
+// ============================================================================
+
+struct FOG_NO_EXPORT FBlurBaseAccessor_XRGB32 : public FBlurBaseAccessor_PRGB32
+{
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    Acc::p32Store4a(dst, packRun(run, scale, shift) | 0xFF000000);
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run, uint32_t scale, uint32_t shift)
+  {
+    storeRunM(dst, run, scale, shift);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Simple - Accessor - A8x4]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Accessor which handles four adjacent A8 pixels as one pixel.
+//!
+//! Can be used only by the vertical blur, where the adjacent pixels don't
+//! affect each other.
+struct FOG_NO_EXPORT FBlurBaseAccessor_A8x4 : public FBlurBaseAccessor_PRGB32
+{
+  static FOG_INLINE void fetchPixelS(Pixel& dst, const RasterSolid& src)
+  {
+    dst = static_cast<uint32_t>(src.prgb32.a) * 0x01010101;
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Box - Accessors]
+// ============================================================================
+
+typedef FBlurBaseAccessor_PRGB32 FBlurBoxAccessor_PRGB32;
+typedef FBlurBaseAccessor_XRGB32 FBlurBoxAccessor_XRGB32;
+typedef FBlurBaseAccessor_A8x4   FBlurBoxAccessor_A8x4;
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Stack - Accessors]
+// ============================================================================
+
+typedef FBlurBaseAccessor_PRGB32 FBlurStackAccessor_PRGB32;
+typedef FBlurBaseAccessor_XRGB32 FBlurStackAccessor_XRGB32;
+typedef FBlurBaseAccessor_A8x4   FBlurStackAccessor_A8x4;
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur - Exponential - Accessors]
+// ============================================================================
+
+template<typename BaseAccessor>
+struct FOG_NO_EXPORT FBlurExpAccessor_Base : public BaseAccessor
+{
+  typedef typename BaseAccessor::Run Run;
+  typedef typename BaseAccessor::Pixel Pixel;
+
+  // --------------------------------------------------------------------------
+  // [Helpers]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void blurValue(Run& run, const __m128i& val, int32_t aValue)
+  {
+    __m128i a, t;
+
+    Acc::m128iCvtSI128FromSI(a, aValue);
+    a = _mm_shuffle_epi32(a, _MM_SHUFFLE(0, 0, 0, 0));
+
+    Acc::m128iSubPI32(t, val, run.v);
+    Acc::m128iMulPU32(t, t, a);
+    Acc::m128iRShiftPI32<RasterOps_C::BLUR_APREC>(t, t);
+    Acc::m128iAddPI32(run.v, run.v, t);
+  }
+
+  static FOG_INLINE uint32_t packRun(const Run& run)
+  {
+    __m128i x0;
+
+    Acc::m128iRShiftPI32<RasterOps_C::BLUR_ZPREC>(x0, run.v);
+    Acc::m128iPackPU8FromPI32(x0, x0);
+
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(x0));
+  }
+
+  // --------------------------------------------------------------------------
+  // [Methods]
+  // --------------------------------------------------------------------------
+
+  static FOG_INLINE void blurPixel(Run& run, const Pixel& pix, int32_t aValue)
+  {
+    __m128i t;
+
+    Run::unpack(t, pix);
+    Acc::m128iLShiftPU32<RasterOps_C::BLUR_ZPREC>(t, t);
+    blurValue(run, t, aValue);
+  }
+
+  static FOG_INLINE void blurPixel(Run& run, const Run& src, int32_t aValue)
+  {
+    __m128i t;
+
+    Acc::m128iLShiftPU32<RasterOps_C::BLUR_ZPREC>(t, src.v);
+    blurValue(run, t, aValue);
+  }
+
+  static FOG_INLINE void blurRunM(Run& run, const uint8_t* src, int32_t aValue)
+  {
+    uint32_t pix;
+    Acc::p32Load4a(pix, src);
+    blurPixel(run, pix, aValue);
+  }
+
+  static FOG_INLINE void blurRunT(Run& run, const uint8_t* src, int32_t aValue)
+  {
+    blurRunM(run, src, aValue);
+  }
+};
+
+struct FOG_NO_EXPORT FBlurExpAccessor_PRGB32 : public FBlurExpAccessor_Base<FBlurBaseAccessor_PRGB32>
+{
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run)
+  {
+    Acc::p32Store4a(dst, packRun(run));
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run)
+  {
+    storeRunM(dst, run);
+  }
+};
+
+struct FOG_NO_EXPORT FBlurExpAccessor_XRGB32 : public FBlurExpAccessor_Base<FBlurBaseAccessor_XRGB32>
+{
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run)
+  {
+    Acc::p32Store4a(dst, packRun(run) | 0xFF000000);
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run)
+  {
+    storeRunM(dst, run);
+  }
+};
+
+struct FOG_NO_EXPORT FBlurExpAccessor_A8x4 : public FBlurExpAccessor_Base<FBlurBaseAccessor_A8x4>
+{
+  static FOG_INLINE void storeRunM(uint8_t* dst, const Run& run)
+  {
+    Acc::p32Store4a(dst, packRun(run));
+  }
+
+  static FOG_INLINE void storeRunT(uint8_t* dst, const Run& run)
+  {
+    storeRunM(dst, run);
+  }
+};
+
+// ============================================================================
+// [Fog::RasterOps_SSE2 - Filter - Blur]
+// ============================================================================
+
+//! @internal
+struct FOG_NO_EXPORT FBlur
+{
+  // ==========================================================================
+  // [Blur - A8 - Vertical]
+  // ==========================================================================
+
+  //! @brief Vertical blur of A8 image, four columns are processed at once by
+  //! @a PackedFunc, the remaining columns are processed by @a TailFunc.
+  template<RasterFilterDoBlurFunc PackedFunc, RasterFilterDoBlurFunc TailFunc>
+  static void FOG_FASTCALL doA8V(
+    RasterFilterBlur* blurCtx)
+  {
+    uint8_t* dst = blurCtx->dstData;
+    uint8_t* src = blurCtx->srcData;
+
+    uint rowSize = blurCtx->rowSize;
+    uint packedSize = rowSize >> 2;
+    uint tailSize = rowSize & 3;
+
+    if (packedSize != 0)
+    {
+      blurCtx->rowSize = packedSize;
+      PackedFunc(blurCtx);
+    }
+
+    if (tailSize != 0)
+    {
+      blurCtx->dstData = dst + packedSize * 4;
+      blurCtx->srcData = src + packedSize * 4;
+      blurCtx->rowSize = tailSize;
+      TailFunc(blurCtx);
+    }
+
+    blurCtx->dstData = dst;
+    blurCtx->srcData = src;
+    blurCtx->rowSize = rowSize;
+  }
+};
+
+} // RasterOps_SSE2 namespace
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTEROPS_SSE2_FILTERBLUR_P_H
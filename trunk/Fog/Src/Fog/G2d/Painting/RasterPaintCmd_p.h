@@ -16,6 +16,8 @@
 #include <Fog/G2d/Imaging/ImageFilter.h>
 #include <Fog/G2d/Imaging/ImageFilterScale.h>
 #include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/RasterClipMask_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
 #include <Fog/G2d/Painting/RasterPaintStructs_p.h>
 #include <Fog/G2d/Painting/RasterStructs_p.h>
 #include <Fog/G2d/Tools/Region.h>
@@ -199,6 +201,44 @@ struct FOG_NO_EXPORT RasterPaintCmd_SetOpacityAndPrgb32 :
   uint32_t _prgb32;
 };
 
+// ============================================================================
+// [Fog::RasterPaintCmd_SetOpacityAndPrgb64]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_SetOpacityAndPrgb64 :
+  public RasterPaintCmd_SetOpacity
+{
+  typedef RasterPaintCmd_SetOpacity Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, uint32_t opacity, const ArgbBase64& prgb64)
+  {
+    Base::init(engine, cmd, opacity);
+    _setPrgb64(prgb64);
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const ArgbBase64& getPrgb64() const { return _prgb64; }
+  FOG_INLINE void _setPrgb64(const ArgbBase64& prgb64) { _prgb64 = prgb64; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  ArgbBase64 _prgb64;
+};
+
 // ============================================================================
 // [Fog::RasterPaintCmd_SetOpacityAndPattern]
 // ============================================================================
@@ -479,6 +519,166 @@ struct FOG_NO_EXPORT RasterPaintCmd_FillNormalizedPathD : public RasterPaintCmd_
   Static<PointD> _pt;
 };
 
+// ============================================================================
+// [Fog::RasterPaintCmd_FillNormalizedMaskA]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_FillNormalizedMaskA : public RasterPaintCmd
+{
+  typedef RasterPaintCmd Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, const PointI& pt, const Image& mask, const RectI& maskFragment)
+  {
+    Base::init(engine, cmd);
+    _pt.init(pt);
+    _mask.initCustom1(mask);
+    _maskFragment.init(maskFragment);
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _mask.destroy();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const PointI& getPt() const { return _pt; }
+  FOG_INLINE const Image& getMask() const { return _mask; }
+  FOG_INLINE const RectI& getMaskFragment() const { return _maskFragment; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  Static<PointI> _pt;
+  Static<Image> _mask;
+  Static<RectI> _maskFragment;
+};
+
+// ============================================================================
+// [Fog::RasterPaintCmd_StrokeHairlinePathF]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_StrokeHairlinePathF : public RasterPaintCmd_Fill
+{
+  typedef RasterPaintCmd_Fill Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, const PathF& path, const RasterHairline& hairline)
+  {
+    Base::init(engine, cmd, FILL_RULE_NON_ZERO);
+    _path.init(path);
+    _hairline = hairline;
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _path.destroy();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const PathF& getPath() const { return _path(); }
+  FOG_INLINE const RasterHairline& getHairline() const { return _hairline; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  Static<PathF> _path;
+  RasterHairline _hairline;
+};
+
+// ============================================================================
+// [Fog::RasterPaintCmd_StrokeHairlinePathD]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_StrokeHairlinePathD : public RasterPaintCmd_Fill
+{
+  typedef RasterPaintCmd_Fill Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, const PathD& path, const RasterHairline& hairline)
+  {
+    Base::init(engine, cmd, FILL_RULE_NON_ZERO);
+    _path.init(path);
+    _hairline = hairline;
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _path.destroy();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const PathD& getPath() const { return _path(); }
+  FOG_INLINE const RasterHairline& getHairline() const { return _hairline; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  Static<PathD> _path;
+  RasterHairline _hairline;
+};
+
+// ============================================================================
+// [Fog::RasterPaintCmd_FillCoverage]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_FillCoverage : public RasterPaintCmd_Fill
+{
+  typedef RasterPaintCmd_Fill Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, const RasterCoverage* coverage)
+  {
+    Base::init(engine, cmd, FILL_RULE_NON_ZERO);
+    _coverage = coverage->addRef();
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _coverage->release();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const RasterCoverage* getCoverage() const { return _coverage; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  RasterCoverage* _coverage;
+};
+
 // ============================================================================
 // [Fog::RasterPaintCmd_BlitNormalizedImageA]
 // ============================================================================
@@ -555,6 +755,58 @@ struct FOG_NO_EXPORT RasterPaintCmd_BlitNormalizedImageFragmentA : public Raster
   Static<RectI> _srcFragment;
 };
 
+// ============================================================================
+// [Fog::RasterPaintCmd_BlitNormalizedMaskedImageA]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_BlitNormalizedMaskedImageA : public RasterPaintCmd
+{
+  typedef RasterPaintCmd Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, const PointI& pt,
+    const Image& srcImage, const RectI& srcFragment,
+    const Image& mask, const RectI& maskFragment)
+  {
+    Base::init(engine, cmd);
+    _pt.init(pt);
+    _srcImage.initCustom1(srcImage);
+    _srcFragment.init(srcFragment);
+    _mask.initCustom1(mask);
+    _maskFragment.init(maskFragment);
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _srcImage.destroy();
+    _mask.destroy();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const PointI& getPt() const { return _pt; }
+  FOG_INLINE const Image& getSrcImage() const { return _srcImage; }
+  FOG_INLINE const RectI& getSrcFragment() const { return _srcFragment; }
+  FOG_INLINE const Image& getMask() const { return _mask; }
+  FOG_INLINE const RectI& getMaskFragment() const { return _maskFragment; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  Static<PointI> _pt;
+  Static<Image> _srcImage;
+  Static<RectI> _srcFragment;
+  Static<Image> _mask;
+  Static<RectI> _maskFragment;
+};
+
 // ============================================================================
 // [Fog::RasterPaintCmd_BlitNormalizedImageI]
 // ============================================================================
@@ -728,6 +980,43 @@ struct FOG_NO_EXPORT RasterPaintCmd_SetClipRegion : public RasterPaintCmd
   Static<Region> _clipRegion;
 };
 
+// ============================================================================
+// [Fog::RasterPaintCmd_SetClipMask]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterPaintCmd_SetClipMask : public RasterPaintCmd
+{
+  typedef RasterPaintCmd Base;
+
+  // --------------------------------------------------------------------------
+  // [Init / Destroy]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void init(RasterPaintEngine* engine, uint8_t cmd, RasterClipMask* clipMask)
+  {
+    Base::init(engine, cmd);
+    _clipMask = clipMask->addRef();
+  }
+
+  FOG_INLINE void destroy(RasterPaintEngine* engine)
+  {
+    Base::destroy(engine);
+    _clipMask->release();
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE RasterClipMask* getClipMask() const { return _clipMask; }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  RasterClipMask* _clipMask;
+};
+
 //! @}
 
 } // Fog namespace
@@ -21,7 +21,8 @@ RasterPaintContext::RasterPaintContext() :
   engine(NULL),
   precision(0xFFFFFFFF),
   clipType(RASTER_CLIP_BOX),
-  clipBoxI(0, 0, 0, 0)
+  clipBoxI(0, 0, 0, 0),
+  clipMask(NULL)
 {
   scope.reset();
   target.reset();
@@ -41,6 +42,7 @@ RasterPaintContext::RasterPaintContext() :
 
 RasterPaintContext::~RasterPaintContext()
 {
+  resetClipMask();
   _initPrecision(0xFFFFFFFF);
 }
 
@@ -50,16 +52,14 @@ RasterPaintContext::~RasterPaintContext()
 
 err_t RasterPaintContext::_initByMaster(const RasterPaintContext& master)
 {
-  // If mask was created we can't copy the data from master context into thread's
-  // own. The RasterEngine must check for this condition before and must return
-  // @c ERR_PAINTER_NOT_ALLOWED error.
-  //FOG_ASSERT(mask == NULL && master.mask == NULL);
-
   target = master.target;
 
+  // The clip-mask is never changed in place when it's shared so the thread's
+  // context can safely reference it.
   clipType = master.clipType;
   clipRegion = master.clipRegion;
   clipBoxI = master.clipBoxI;
+  setClipMask(master.clipMask != NULL ? master.clipMask->addRef() : NULL);
 
   paintHints = master.paintHints;
   rasterHints = master.rasterHints;
@@ -79,17 +79,15 @@ err_t RasterPaintContext::_initPrecision(uint32_t precision)
     // Destroy resources using an old precision.
     switch (this->precision)
     {
+      // The coverage is always 8-bit, 16-bit targets differ only in the
+      // compositing, so the same rasterizers and scanlines are used.
       case IMAGE_PRECISION_BYTE:
+      case IMAGE_PRECISION_WORD:
         boxRasterizer8.destroy();
         pathRasterizer8.destroy();
+        hairlineRasterizer8.destroy();
         scanline8.destroy();
-        break;
-
-      case IMAGE_PRECISION_WORD:
-        // TODO: 16-bit image processing.
-        // boxRasterizer16.destroy();
-        // pathRasterizer16.destroy();
-        // scanline16.destroy();
+        maskScanline8.destroy();
         break;
 
       default:
@@ -102,20 +100,14 @@ err_t RasterPaintContext::_initPrecision(uint32_t precision)
     switch (this->precision)
     {
       case IMAGE_PRECISION_BYTE:
+      case IMAGE_PRECISION_WORD:
         fullOpacity.u = 0x100;
         fullOpacity.f = float(0x100);
         boxRasterizer8.init();
         pathRasterizer8.init();
+        hairlineRasterizer8.init();
         scanline8.init();
-        break;
-
-      case IMAGE_PRECISION_WORD:
-        fullOpacity.u = 0x10000;
-        fullOpacity.f = float(0x10000);
-        // TODO: 16-bit image processing.
-        // boxRasterizer16.init();
-        // pathRasterizer16.init();
-        // scanline16.init();
+        maskScanline8.init();
         break;
 
       default:
@@ -132,7 +124,6 @@ err_t RasterPaintContext::_initPrecision(uint32_t precision)
 
     case IMAGE_PRECISION_WORD:
       pcBpl *= 8;
-      // TODO: 16-bit image processing.
       break;
 
     default:
@@ -146,7 +137,7 @@ err_t RasterPaintContext::_initPrecision(uint32_t precision)
 
 void RasterPaintContext::_reset()
 {
-  // TODO: Not used.
+  resetClipMask();
 }
 
 } // Fog namespace
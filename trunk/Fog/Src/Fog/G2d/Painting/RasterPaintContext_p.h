@@ -18,6 +18,7 @@
 #include <Fog/G2d/Imaging/ImageFilter.h>
 #include <Fog/G2d/Imaging/ImageFilterScale.h>
 #include <Fog/G2d/Painting/PaintParams.h>
+#include <Fog/G2d/Painting/RasterClipMask_p.h>
 #include <Fog/G2d/Painting/RasterPaintStructs_p.h>
 #include <Fog/G2d/Painting/RasterScanline_p.h>
 #include <Fog/G2d/Painting/RasterStructs_p.h>
@@ -64,6 +65,25 @@ struct FOG_NO_EXPORT RasterPaintContext
   // [Mask]
   // --------------------------------------------------------------------------
 
+  //! @brief Set the clip-mask, taking the ownership of the @a mask reference.
+  //!
+  //! The previous clip-mask is released. Only the clip-mask is changed, the
+  //! @c clipType and @c clipBoxI must be updated by the caller.
+  FOG_INLINE void setClipMask(RasterClipMask* mask)
+  {
+    RasterClipMask* old = clipMask;
+    clipMask = mask;
+
+    if (old != NULL)
+      old->release();
+  }
+
+  //! @brief Release the clip-mask (if any).
+  FOG_INLINE void resetClipMask()
+  {
+    setClipMask(NULL);
+  }
+
   // --------------------------------------------------------------------------
   // [Members - Engine]
   // --------------------------------------------------------------------------
@@ -140,6 +160,12 @@ struct FOG_NO_EXPORT RasterPaintContext
     // Static<PathRasterizer16> pathRasterizer16;
   };
 
+  union
+  {
+    //! @brief The hairline rasterizer (8-bit).
+    Static<HairlineRasterizer8> hairlineRasterizer8;
+  };
+
   union
   {
     //! @brief The scanline container (8-bit).
@@ -150,6 +176,18 @@ struct FOG_NO_EXPORT RasterPaintContext
     // Static<RasterScanline16> scanline16;
   };
 
+  union
+  {
+    //! @brief The scanline container used to intersect spans with the clip-mask
+    //! (8-bit).
+    Static<RasterScanline8> maskScanline8;
+
+    // TODO: 16-bit image processing.
+    // //! @brief The scanline container used to intersect spans with the
+    // //! clip-mask (16-bit).
+    // Static<RasterScanline16> maskScanline16;
+  };
+
   // --------------------------------------------------------------------------
   // [Members - Clip]
   // --------------------------------------------------------------------------
@@ -159,7 +197,14 @@ struct FOG_NO_EXPORT RasterPaintContext
   //! @brief Clip region.
   Region clipRegion;
   //! @brief Clip box (integer).
+  //!
+  //! If the clip type is @c RASTER_CLIP_MASK then it's the bounding box of
+  //! the clip-mask.
   BoxI clipBoxI;
+  //! @brief Clip mask, only valid if clip type is @c RASTER_CLIP_MASK.
+  //!
+  //! The context holds one reference to the clip-mask.
+  RasterClipMask* clipMask;
 
   // --------------------------------------------------------------------------
   // [Members - Temp]
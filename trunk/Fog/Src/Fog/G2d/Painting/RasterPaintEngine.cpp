@@ -11,6 +11,7 @@
 // [Dependencies]
 #include <Fog/Core/Acc/AccC.h>
 #include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemBufferTmp_p.h>
 #include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Threading/Atomic.h>
@@ -30,13 +31,19 @@
 #include <Fog/G2d/Imaging/Filters/FeBase.h>
 #include <Fog/G2d/Painting/Painter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterClipMask_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
+#include <Fog/G2d/Painting/RasterGlyphCache_p.h>
+#include <Fog/G2d/Painting/RasterMipmap_p.h>
 #include <Fog/G2d/Painting/RasterPaintCmd_p.h>
 #include <Fog/G2d/Painting/RasterPaintContext_p.h>
 #include <Fog/G2d/Painting/RasterPaintEngine_p.h>
 #include <Fog/G2d/Painting/RasterPaintStructs_p.h>
+#include <Fog/G2d/Painting/RasterPaintWorker_p.h>
 #include <Fog/G2d/Painting/RasterScanline_p.h>
 #include <Fog/G2d/Painting/RasterSpan_p.h>
+#include <Fog/G2d/Painting/RasterStrokeCache_p.h>
 #include <Fog/G2d/Painting/RasterUtil_p.h>
 #include <Fog/G2d/Painting/Rasterizer_p.h>
 #include <Fog/G2d/Source/Color.h>
@@ -259,7 +266,7 @@ static err_t FOG_CDECL RasterPaintEngine_getParameter(const Painter* self, uint3
 
     case PAINTER_PARAMETER_MULTITHREADED_I:
     {
-      _PARAM_M(uint32_t) = false;
+      _PARAM_M(uint32_t) = (engine->wm != NULL);
       return ERR_OK;
     }
 
@@ -627,6 +634,52 @@ static err_t FOG_CDECL RasterPaintEngine_getParameter(const Painter* self, uint3
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Caching]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    {
+      _PARAM_M(uint32_t) = (engine->cacheFlags & RASTER_CACHE_STROKE) != 0;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    {
+      PaintCacheStats stats;
+      RasterStrokeCache::getStats(stats);
+
+      _PARAM_M(uint32_t) = (uint32_t)Math::min<size_t>(stats.memoryLimit, UINT32_MAX);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    {
+      RasterStrokeCache::getStats(_PARAM_M(PaintCacheStats));
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    {
+      _PARAM_M(uint32_t) = (engine->cacheFlags & RASTER_CACHE_COVERAGE) != 0;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    {
+      PaintCacheStats stats;
+      RasterCoverageCache::getStats(stats);
+
+      _PARAM_M(uint32_t) = (uint32_t)Math::min<size_t>(stats.memoryLimit, UINT32_MAX);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      RasterCoverageCache::getStats(_PARAM_M(PaintCacheStats));
+      return ERR_OK;
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -666,9 +719,7 @@ static err_t FOG_CDECL RasterPaintEngine_setParameter(Painter* self, uint32_t pa
     case PAINTER_PARAMETER_MULTITHREADED_I:
     {
       uint32_t v = _PARAM_C(uint32_t);
-
-      // TODO:
-      return ERR_OK;
+      return engine->setMultithreaded(v != 0);
     }
 
     case PAINTER_PARAMETER_MAX_THREADS_I:
@@ -825,6 +876,10 @@ static err_t FOG_CDECL RasterPaintEngine_setParameter(Painter* self, uint32_t pa
       if (v >= COMPOSITE_COUNT)
         return ERR_RT_INVALID_ARGUMENT;
 
+      // 16-bit compositors implement only Porter & Duff operators and PLUS.
+      if (engine->ctx.precision == IMAGE_PRECISION_WORD && v > COMPOSITE_PLUS)
+        return ERR_RT_NOT_IMPLEMENTED;
+
       engine->masterFlags &= ~RASTER_NO_PAINT_COMPOSITING_OPERATOR;
       engine->ctx.paintHints.compositingOperator = v;
 
@@ -1475,6 +1530,50 @@ _GlobalOpacityF:
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Caching]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    {
+      if (_PARAM_C(uint32_t))
+        engine->cacheFlags |= RASTER_CACHE_STROKE;
+      else
+        engine->cacheFlags &= ~RASTER_CACHE_STROKE;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    {
+      RasterStrokeCache::setMemoryLimit(_PARAM_C(uint32_t));
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    {
+      if (_PARAM_C(uint32_t))
+        engine->cacheFlags |= RASTER_CACHE_COVERAGE;
+      else
+        engine->cacheFlags &= ~RASTER_CACHE_COVERAGE;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    {
+      RasterCoverageCache::setMemoryLimit(_PARAM_C(uint32_t));
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      return ERR_RT_INVALID_ARGUMENT;
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -1510,8 +1609,7 @@ static err_t FOG_CDECL RasterPaintEngine_resetParameter(Painter* self, uint32_t
 
     case PAINTER_PARAMETER_MULTITHREADED_I:
     {
-      // TODO: ...
-      return ERR_RT_NOT_IMPLEMENTED;
+      return engine->setMultithreaded(false);
     }
 
     case PAINTER_PARAMETER_MAX_THREADS_I:
@@ -1812,6 +1910,46 @@ static err_t FOG_CDECL RasterPaintEngine_resetParameter(Painter* self, uint32_t
       return ERR_OK;
     }
 
+    // ------------------------------------------------------------------------
+    // [Caching]
+    // ------------------------------------------------------------------------
+
+    case PAINTER_PARAMETER_STROKE_CACHE_I:
+    {
+      engine->cacheFlags &= ~RASTER_CACHE_STROKE;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_LIMIT_I:
+    {
+      RasterStrokeCache::setMemoryLimit(RASTER_STROKE_CACHE_DEFAULT_LIMIT);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_STROKE_CACHE_STATS:
+    {
+      RasterStrokeCache::resetStats();
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_I:
+    {
+      engine->cacheFlags &= ~RASTER_CACHE_COVERAGE;
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_LIMIT_I:
+    {
+      RasterCoverageCache::setMemoryLimit(RASTER_COVERAGE_CACHE_DEFAULT_LIMIT);
+      return ERR_OK;
+    }
+
+    case PAINTER_PARAMETER_COVERAGE_CACHE_STATS:
+    {
+      RasterCoverageCache::resetStats();
+      return ERR_OK;
+    }
+
     default:
     {
       return ERR_RT_INVALID_ARGUMENT;
@@ -2042,7 +2180,9 @@ _Invalid:
 
 static err_t FOG_CDECL RasterPaintEngine_setSourcePattern(Painter* self, const Pattern* pattern)
 {
+  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   PatternData* d = pattern->_d;
+  err_t err;
 
   switch (d->vType & VAR_TYPE_MASK)
   {
@@ -2056,33 +2196,42 @@ static err_t FOG_CDECL RasterPaintEngine_setSourcePattern(Painter* self, const P
       switch (d->pType)
       {
         case PATTERN_TYPE_TEXTURE | PATTERN_PRECISION_F:
-          return self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_TEXTURE_F,
+          err = self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_TEXTURE_F,
             &reinterpret_cast<PatternTextureDataF*>(d)->texture,
             &reinterpret_cast<PatternTextureDataF*>(d)->transform);
-          break;
+          goto _Shared;
 
         case PATTERN_TYPE_TEXTURE | PATTERN_PRECISION_D:
-          return self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_TEXTURE_D,
+          err = self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_TEXTURE_D,
             &reinterpret_cast<PatternTextureDataD*>(d)->texture,
             &reinterpret_cast<PatternTextureDataD*>(d)->transform);
-          break;
+          goto _Shared;
 
         case PATTERN_TYPE_GRADIENT | PATTERN_PRECISION_F:
-          return self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_GRADIENT_F,
+          err = self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_GRADIENT_F,
             &reinterpret_cast<PatternGradientDataF*>(d)->gradient,
             &reinterpret_cast<PatternGradientDataF*>(d)->transform);
-          break;
+          goto _Shared;
 
         case PATTERN_TYPE_GRADIENT | PATTERN_PRECISION_D:
-          return self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_GRADIENT_D,
+          err = self->_vtable->setSourceAbstract(self, PAINTER_SOURCE_GRADIENT_D,
             &reinterpret_cast<PatternGradientDataD*>(d)->gradient,
             &reinterpret_cast<PatternGradientDataD*>(d)->transform);
-          break;
+          goto _Shared;
       }
       break;
   }
 
   return ERR_RT_INVALID_STATE;
+
+_Shared:
+  // Use the pattern context attached to the pattern data (or create and attach
+  // a new one), so setting the same pattern again, possibly by a different
+  // painter, doesn't need to initialize the pattern context again. Failure is
+  // not an error, the context is created later from the context-pool.
+  if (err == ERR_OK && engine->sourceType != RASTER_SOURCE_NONE && engine->ctx.pc == NULL)
+    engine->createSharedPatternContext(d);
+  return err;
 }
 
 static err_t FOG_CDECL RasterPaintEngine_setSourceAbstract(Painter* self, uint32_t sourceId, const void* value, const void* tr)
@@ -2476,14 +2625,12 @@ _RestoreSourceContinue:
     {
       case RASTER_CLIP_BOX:
         if (engine->ctx.clipType == RASTER_CLIP_MASK)
-        {
-          // TODO: RasterPaintEngine - clip-mask.
-        }
+          engine->ctx.resetClipMask();
 
         engine->ctx.clipType = state->clipType;
         engine->ctx.clipBoxI = state->clipBoxI;
-        engine->stroker.f().setClipBox(state->clipBoxF);
-        engine->stroker.d().setClipBox(state->clipBoxD);
+        engine->stroker.f->_clipBox.setBox(engine->ctx.clipBoxI);
+        engine->stroker.d->_clipBox.setBox(engine->ctx.clipBoxI);
 
         // TODO:
         engine->ctx.clipRegion.clear();
@@ -2491,14 +2638,12 @@ _RestoreSourceContinue:
 
       case RASTER_CLIP_REGION:
         if (engine->ctx.clipType == RASTER_CLIP_MASK)
-        {
-          // TODO: RasterPaintEngine - clip-mask.
-        }
+          engine->ctx.resetClipMask();
 
         engine->ctx.clipType = state->clipType;
         engine->ctx.clipBoxI = state->clipBoxI;
-        engine->stroker.f().setClipBox(state->clipBoxF);
-        engine->stroker.d().setClipBox(state->clipBoxD);
+        engine->stroker.f->_clipBox.setBox(engine->ctx.clipBoxI);
+        engine->stroker.d->_clipBox.setBox(engine->ctx.clipBoxI);
 
         // TODO:
         engine->ctx.clipRegion = state->clipRegion();
@@ -2506,12 +2651,23 @@ _RestoreSourceContinue:
         break;
 
       case RASTER_CLIP_MASK:
-        // TODO: RasterPaintEngine - clip-mask.
+        // The reference held by the state is moved to the context.
+        engine->ctx.clipType = state->clipType;
+        engine->ctx.clipBoxI = state->clipBoxI;
+        engine->ctx.setClipMask(state->clipMask);
+        engine->stroker.f->_clipBox.setBox(engine->ctx.clipBoxI);
+        engine->stroker.d->_clipBox.setBox(engine->ctx.clipBoxI);
+        engine->ctx.clipRegion.clear();
+
+        engine->masterMaskId = state->clipMask->getId();
+        engine->masterMaskSaved = state->clipMaskSaved;
         break;
 
       default:
         FOG_ASSERT_NOT_REACHED();
     }
+
+    engine->masterFlags |= RASTER_PENDING_CLIP;
   }
 
   // ------------------------------------------------------------------------
@@ -2577,8 +2733,122 @@ static err_t FOG_CDECL RasterPaintEngine_mapPointD(const Painter* self, uint32_t
 // [Fog::RasterPaintEngine - Draw - Raw]
 // ============================================================================
 
+// ============================================================================
+// [Fog::RasterPaintEngine - Draw - Hairline]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Maximum device-space width of a stroke rendered by the hairline
+//! rasterizer.
+//!
+//! Wider strokes are converted to outlines by the stroker, because the
+//! hairline rasterizer approximates joins and caps, which starts to be
+//! visible once the stroke is wider than a pixel or so.
+static const double RasterPaintEngine_hairlineMaxWidth = 1.5;
+
+//! @internal
+//!
+//! @brief Get whether the stroke can be rendered by the hairline rasterizer
+//! and fill @a hairline if so.
+//!
+//! The stroke must not be dashed and the final transform must be affine and
+//! nearly conformal (the stroke width can't vary with the direction by more
+//! than 1/8 of pixel), because the hairline rasterizer works with a constant
+//! device-space width.
+static bool RasterPaintEngine_getHairline(RasterPaintEngine* engine,
+  double lineWidth, bool isDashed, uint32_t startCap, uint32_t endCap, RasterHairline& hairline)
+{
+  if (isDashed || !(lineWidth > 0.0))
+    return false;
+
+  const TransformD& tr = engine->getFinalTransformD();
+  uint32_t transformType = tr.getType();
+
+  if (transformType >= TRANSFORM_TYPE_PROJECTION)
+    return false;
+
+  double sMax = 1.0;
+  double sMin = 1.0;
+
+  if (transformType >= TRANSFORM_TYPE_SCALING)
+  {
+    // Singular values of the 2x2 part of the matrix.
+    double e = (tr._00 + tr._11) * 0.5;
+    double f = (tr._00 - tr._11) * 0.5;
+    double g = (tr._10 + tr._01) * 0.5;
+    double h = (tr._10 - tr._01) * 0.5;
+
+    double q = Math::sqrt(e * e + h * h);
+    double r = Math::sqrt(f * f + g * g);
+
+    sMax = q + r;
+    sMin = Math::abs(q - r);
+  }
+
+  if (lineWidth * sMax > RasterPaintEngine_hairlineMaxWidth || (sMax - sMin) * lineWidth > 0.125)
+    return false;
+
+  hairline.lineWidth = lineWidth * Math::sqrt(sMax * sMin);
+  hairline.startCap = startCap;
+  hairline.endCap = endCap;
+  return true;
+}
+
+//! @internal
+//!
+//! @brief Fill the outline returned by @ref RasterStrokeCache, clipped to the
+//! clip-box.
+static err_t FOG_FASTCALL RasterPaintEngine_fillCachedOutlineF(
+  RasterPaintEngine* engine, const PathF* path, const PointF* pt)
+{
+  BoxF clipBox(engine->ctx.clipBoxI);
+  clipBox.translate(-pt->x, -pt->y);
+
+  PathClipperF clipper(clipBox);
+  PathF* tmp = &engine->ctx.tmpPathF[1];
+
+  switch (clipper.measurePath(*path))
+  {
+    case PATH_CLIPPER_MEASURE_BOUNDED:
+      return engine->doCmd->fillNormalizedPathF(&engine->ctx, path, pt, FILL_RULE_NON_ZERO);
+    case PATH_CLIPPER_MEASURE_UNBOUNDED:
+      tmp->clear();
+      FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
+      return engine->doCmd->fillNormalizedPathF(&engine->ctx, tmp, pt, FILL_RULE_NON_ZERO);
+    default:
+      return ERR_OK;
+  }
+}
+
+//! @internal
+//!
+//! @brief Fill the outline returned by @ref RasterStrokeCache, clipped to the
+//! clip-box.
+static err_t FOG_FASTCALL RasterPaintEngine_fillCachedOutlineD(
+  RasterPaintEngine* engine, const PathD* path, const PointD* pt)
+{
+  BoxD clipBox(engine->ctx.clipBoxI);
+  clipBox.translate(-pt->x, -pt->y);
+
+  PathClipperD clipper(clipBox);
+  PathD* tmp = &engine->ctx.tmpPathD[1];
+
+  switch (clipper.measurePath(*path))
+  {
+    case PATH_CLIPPER_MEASURE_BOUNDED:
+      return engine->doCmd->fillNormalizedPathD(&engine->ctx, path, pt, FILL_RULE_NON_ZERO);
+    case PATH_CLIPPER_MEASURE_UNBOUNDED:
+      tmp->clear();
+      FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
+      return engine->doCmd->fillNormalizedPathD(&engine->ctx, tmp, pt, FILL_RULE_NON_ZERO);
+    default:
+      return ERR_OK;
+  }
+}
+
 static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathF(
-  RasterPaintEngine* engine, const PathF* path)
+  RasterPaintEngine* engine, const PathF* path, bool isUserPath)
 {
   if (!engine->ctx.rasterHints.finalTransformF)
   {
@@ -2603,14 +2873,42 @@ static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathF(
   PathStrokerF& stroker = engine->stroker.f;
   PathF& tmp = engine->ctx.tmpPathF[0];
 
+  const PathStrokerParamsF& params = stroker.getParams();
+  RasterHairline hairline;
+
+  if (RasterPaintEngine_getHairline(engine, params.getLineWidth(), !params.getDashList().isEmpty(),
+    params.getStartCap(), params.getEndCap(), hairline))
+  {
+    const TransformF& tr = stroker.getTransform();
+
+    if (tr.getType() == TRANSFORM_TYPE_IDENTITY && !path->hasBeziers())
+      return engine->doCmd->strokeHairlinePathF(&engine->ctx, path, &hairline);
+
+    tmp.clear();
+    FOG_RETURN_ON_ERROR(PathF::flatten(tmp, *path, PathFlattenParamsF(stroker.getFlatness(), &tr)));
+
+    return engine->doCmd->strokeHairlinePathF(&engine->ctx, &tmp, &hairline);
+  }
+
+  // Only paths passed by the user are cached, temporary paths (shapes) are
+  // reused and would be only detached by the cache.
+  if (isUserPath && (engine->cacheFlags & RASTER_CACHE_STROKE) != 0 &&
+      stroker.getTransform().getType() < TRANSFORM_TYPE_PROJECTION)
+  {
+    PointF offset(UNINITIALIZED);
+    FOG_RETURN_ON_ERROR(RasterStrokeCache::getOutline(tmp, offset, *path, stroker));
+
+    return RasterPaintEngine_fillCachedOutlineF(engine, &tmp, &offset);
+  }
+
   tmp.clear();
   FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
 
-  return engine->doCmd->fillNormalizedPathF(engine, &tmp, &engine->dummyPointF, FILL_RULE_NON_ZERO);
+  return engine->doCmd->fillNormalizedPathF(&engine->ctx, &tmp, &engine->dummyPointF, FILL_RULE_NON_ZERO);
 }
 
 static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathD(
-  RasterPaintEngine* engine, const PathD* path)
+  RasterPaintEngine* engine, const PathD* path, bool isUserPath)
 {
   if (engine->strokerPrecision == RASTER_PRECISION_F)
   {
@@ -2622,10 +2920,38 @@ static err_t FOG_FASTCALL RasterPaintEngine_drawRawPathD(
   PathStrokerD& stroker = engine->stroker.d;
   PathD& tmp = engine->ctx.tmpPathD[0];
 
+  const PathStrokerParamsD& params = stroker.getParams();
+  RasterHairline hairline;
+
+  if (RasterPaintEngine_getHairline(engine, params.getLineWidth(), !params.getDashList().isEmpty(),
+    params.getStartCap(), params.getEndCap(), hairline))
+  {
+    const TransformD& tr = stroker.getTransform();
+
+    if (tr.getType() == TRANSFORM_TYPE_IDENTITY && !path->hasBeziers())
+      return engine->doCmd->strokeHairlinePathD(&engine->ctx, path, &hairline);
+
+    tmp.clear();
+    FOG_RETURN_ON_ERROR(PathD::flatten(tmp, *path, PathFlattenParamsD(stroker.getFlatness(), &tr)));
+
+    return engine->doCmd->strokeHairlinePathD(&engine->ctx, &tmp, &hairline);
+  }
+
+  // Only paths passed by the user are cached, temporary paths (shapes) are
+  // reused and would be only detached by the cache.
+  if (isUserPath && (engine->cacheFlags & RASTER_CACHE_STROKE) != 0 &&
+      stroker.getTransform().getType() < TRANSFORM_TYPE_PROJECTION)
+  {
+    PointD offset(UNINITIALIZED);
+    FOG_RETURN_ON_ERROR(RasterStrokeCache::getOutline(tmp, offset, *path, stroker));
+
+    return RasterPaintEngine_fillCachedOutlineD(engine, &tmp, &offset);
+  }
+
   tmp.clear();
   FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
 
-  return engine->doCmd->fillNormalizedPathD(engine, &tmp, &engine->dummyPointD, FILL_RULE_NON_ZERO);
+  return engine->doCmd->fillNormalizedPathD(&engine->ctx, &tmp, &engine->dummyPointD, FILL_RULE_NON_ZERO);
 }
 
 // ============================================================================
@@ -2657,7 +2983,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawRectF(Painter* self, const RectF* r
   PathF* path = &engine->ctx.tmpPathF[2];
   path->clear();
   path->rect(*r);
-  return RasterPaintEngine_drawRawPathF(engine, path);
+  return RasterPaintEngine_drawRawPathF(engine, path, false);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_drawRectD(Painter* self, const RectD* r)
@@ -2668,7 +2994,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawRectD(Painter* self, const RectD* r
   PathD* path = &engine->ctx.tmpPathD[2];
   path->clear();
   path->rect(*r);
-  return RasterPaintEngine_drawRawPathD(engine, path);
+  return RasterPaintEngine_drawRawPathD(engine, path, false);
 }
 
 // ============================================================================
@@ -2685,14 +3011,14 @@ static err_t FOG_CDECL RasterPaintEngine_drawPolylineI(Painter* self, const Poin
     PathF* path = &engine->ctx.tmpPathF[2];
     path->clear();
     path->polyline(p, count);
-    return RasterPaintEngine_drawRawPathF(engine, path);
+    return RasterPaintEngine_drawRawPathF(engine, path, false);
   }
   else
   {
     PathD* path = &engine->ctx.tmpPathD[2];
     path->clear();
     path->polyline(p, count);
-    return RasterPaintEngine_drawRawPathD(engine, path);
+    return RasterPaintEngine_drawRawPathD(engine, path, false);
   }
 }
 
@@ -2710,14 +3036,14 @@ static err_t FOG_CDECL RasterPaintEngine_drawPolygonI(Painter* self, const Point
     PathF* path = &engine->ctx.tmpPathF[2];
     path->clear();
     path->polygon(p, count);
-    return RasterPaintEngine_drawRawPathF(engine, path);
+    return RasterPaintEngine_drawRawPathF(engine, path, false);
   }
   else
   {
     PathD* path = &engine->ctx.tmpPathD[2];
     path->clear();
     path->polygon(p, count);
-    return RasterPaintEngine_drawRawPathD(engine, path);
+    return RasterPaintEngine_drawRawPathD(engine, path, false);
   }
 }
 
@@ -2740,7 +3066,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawShapeF(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathF* path = reinterpret_cast<const PathF*>(shapeData);
-      return RasterPaintEngine_drawRawPathF(engine, path);
+      return RasterPaintEngine_drawRawPathF(engine, path, true);
     }
 
     default:
@@ -2748,7 +3074,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawShapeF(Painter* self, uint32_t shap
       PathF* path = &engine->ctx.tmpPathF[2];
       path->clear();
       path->_shape(shapeType, shapeData, PATH_DIRECTION_CW, NULL);
-      return RasterPaintEngine_drawRawPathF(engine, path);
+      return RasterPaintEngine_drawRawPathF(engine, path, false);
     }
   }
 }
@@ -2768,7 +3094,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawShapeD(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathD* path = reinterpret_cast<const PathD*>(shapeData);
-      return RasterPaintEngine_drawRawPathD(engine, path);
+      return RasterPaintEngine_drawRawPathD(engine, path, true);
     }
 
     default:
@@ -2776,7 +3102,7 @@ static err_t FOG_CDECL RasterPaintEngine_drawShapeD(Painter* self, uint32_t shap
       PathD* path = &engine->ctx.tmpPathD[2];
       path->clear();
       path->_shape(shapeType, shapeData, PATH_DIRECTION_CW, NULL);
-      return RasterPaintEngine_drawRawPathD(engine, path);
+      return RasterPaintEngine_drawRawPathD(engine, path, false);
     }
   }
 }
@@ -2790,7 +3116,7 @@ static err_t FOG_CDECL RasterPaintEngine_fillAll(Painter* self)
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   _FOG_RASTER_ENTER_FILL_FUNC();
 
-  return engine->doCmd->fillAll(engine);
+  return engine->doCmd->fillAll(&engine->ctx);
 }
 
 // ============================================================================
@@ -2820,11 +3146,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_fillRawPathF(
       switch (clipper.measurePath(*path))
       {
         case PATH_CLIPPER_MEASURE_BOUNDED:
-          return engine->doCmd->fillNormalizedPathF(engine, path, &pt, fillRule);
+          return engine->doCmd->fillNormalizedPathF(&engine->ctx, path, &pt, fillRule);
         case PATH_CLIPPER_MEASURE_UNBOUNDED:
           tmp->clear();
           FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-          return engine->doCmd->fillNormalizedPathF(engine, tmp, &pt, fillRule);
+          return engine->doCmd->fillNormalizedPathF(&engine->ctx, tmp, &pt, fillRule);
         default:
           return ERR_GEOMETRY_INVALID;
       }
@@ -2832,7 +3158,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_fillRawPathF(
     default:
       tmp->clear();
       FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
-      return engine->doCmd->fillNormalizedPathF(engine, tmp, &pt, fillRule);
+      return engine->doCmd->fillNormalizedPathF(&engine->ctx, tmp, &pt, fillRule);
   }
 }
 
@@ -2857,11 +3183,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_fillRawPathD(
       switch (clipper.measurePath(*path))
       {
         case PATH_CLIPPER_MEASURE_BOUNDED:
-          return engine->doCmd->fillNormalizedPathD(engine, path, &pt, fillRule);
+          return engine->doCmd->fillNormalizedPathD(&engine->ctx, path, &pt, fillRule);
         case PATH_CLIPPER_MEASURE_UNBOUNDED:
           tmp->clear();
           FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-          return engine->doCmd->fillNormalizedPathD(engine, tmp, &pt, fillRule);
+          return engine->doCmd->fillNormalizedPathD(&engine->ctx, tmp, &pt, fillRule);
         default:
           return ERR_GEOMETRY_INVALID;
       }
@@ -2869,10 +3195,53 @@ static err_t FOG_FASTCALL RasterPaintEngine_fillRawPathD(
     default:
       tmp->clear();
       FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
-      return engine->doCmd->fillNormalizedPathD(engine, tmp, &pt, fillRule);
+      return engine->doCmd->fillNormalizedPathD(&engine->ctx, tmp, &pt, fillRule);
   }
 }
 
+//! @internal
+//!
+//! @brief Fill the user path by the coverage cached by @ref RasterCoverageCache.
+static err_t FOG_FASTCALL RasterPaintEngine_fillCachedPathF(
+  RasterPaintEngine* engine, const PathF* path, uint32_t fillRule)
+{
+  TransformF identity;
+  const TransformF& transform = engine->ensureFinalTransformF()
+    ? engine->getFinalTransformF()
+    : identity;
+
+  RasterCoverage* coverage;
+  FOG_RETURN_ON_ERROR(RasterCoverageCache::getCoverage(&coverage, *path, fillRule,
+    engine->ctx.clipBoxI, transform, &engine->ctx.pathRasterizer8, &engine->ctx.scanline8));
+
+  // The clip-box is too large to be cached.
+  if (coverage == NULL)
+    return RasterPaintEngine_fillRawPathF(engine, path, fillRule);
+
+  err_t err = engine->doCmd->fillCoverage(&engine->ctx, coverage);
+  coverage->release();
+  return err;
+}
+
+//! @internal
+//!
+//! @brief Fill the user path by the coverage cached by @ref RasterCoverageCache.
+static err_t FOG_FASTCALL RasterPaintEngine_fillCachedPathD(
+  RasterPaintEngine* engine, const PathD* path, uint32_t fillRule)
+{
+  RasterCoverage* coverage;
+  FOG_RETURN_ON_ERROR(RasterCoverageCache::getCoverage(&coverage, *path, fillRule,
+    engine->ctx.clipBoxI, engine->getFinalTransformD(), &engine->ctx.pathRasterizer8, &engine->ctx.scanline8));
+
+  // The clip-box is too large to be cached.
+  if (coverage == NULL)
+    return RasterPaintEngine_fillRawPathD(engine, path, fillRule);
+
+  err_t err = engine->doCmd->fillCoverage(&engine->ctx, coverage);
+  coverage->release();
+  return err;
+}
+
 // ============================================================================
 // [Fog::RasterPaintEngine - Fill - Rect]
 // ============================================================================
@@ -2886,7 +3255,7 @@ static err_t FOG_CDECL RasterPaintEngine_fillRectI(Painter* self, const RectI* r
   {
     BoxI box(UNINITIALIZED);
     if (engine->doIntegralTransformAndClip(box, *r, engine->ctx.clipBoxI))
-      return engine->doCmd->fillNormalizedBoxI(engine, &box);
+      return engine->doCmd->fillNormalizedBoxI(&engine->ctx, &box);
     else
       return ERR_OK;
   }
@@ -2923,7 +3292,7 @@ static err_t FOG_CDECL RasterPaintEngine_fillRectF(Painter* self, const RectF* r
   if (!BoxF::intersect(box, box, engine->getClipBoxF()))
     return ERR_OK;
 
-  return engine->doCmd->fillNormalizedBoxF(engine, &box);
+  return engine->doCmd->fillNormalizedBoxF(&engine->ctx, &box);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_fillRectD(Painter* self, const RectD* r)
@@ -2947,7 +3316,7 @@ static err_t FOG_CDECL RasterPaintEngine_fillRectD(Painter* self, const RectD* r
   if (!BoxD::intersect(box, box, engine->getClipBoxD()))
     return ERR_OK;
 
-  return engine->doCmd->fillNormalizedBoxD(engine, &box);
+  return engine->doCmd->fillNormalizedBoxD(&engine->ctx, &box);
 }
 
 // ============================================================================
@@ -2959,7 +3328,32 @@ static err_t FOG_CDECL RasterPaintEngine_fillRectsI(Painter* self, const RectI*
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   _FOG_RASTER_ENTER_FILL_FUNC();
 
-  if (!engine->ctx.paintHints.geometricPrecision)
+  if (engine->isIntegralTransform())
+  {
+    // The rectangles are merged into a region (so overlapping areas are
+    // painted only once) and filled box by box, bypassing the rasterizer.
+    Region* region = engine->getTemporaryRegion();
+    FOG_RETURN_ON_ERROR(region->setRectList(r, count));
+
+    const BoxI* data = region->getData();
+    size_t length = region->getLength();
+
+    err_t err = ERR_OK;
+    for (size_t i = 0; i < length; i++)
+    {
+      BoxI box(UNINITIALIZED);
+      if (engine->doIntegralTransformAndClip(box, RectI(data[i]), engine->ctx.clipBoxI))
+      {
+        err = engine->doCmd->fillNormalizedBoxI(&engine->ctx, &box);
+        if (FOG_IS_ERROR(err))
+          break;
+      }
+    }
+
+    region->clear();
+    return err;
+  }
+  else if (!engine->ctx.paintHints.geometricPrecision)
   {
     PathF* path = &engine->ctx.tmpPathF[0];
     path->clear();
@@ -3028,6 +3422,12 @@ static err_t FOG_CDECL RasterPaintEngine_fillShapeF(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathF* path = reinterpret_cast<const PathF*>(shapeData);
+
+      // Only paths passed by the user are cached, temporary paths (shapes) are
+      // reused and would be only detached by the cache.
+      if ((engine->cacheFlags & RASTER_CACHE_COVERAGE) != 0)
+        return RasterPaintEngine_fillCachedPathF(engine, path, engine->ctx.paintHints.fillRule);
+
       return RasterPaintEngine_fillRawPathF(engine, path, engine->ctx.paintHints.fillRule);
     }
 
@@ -3066,6 +3466,12 @@ static err_t FOG_CDECL RasterPaintEngine_fillShapeD(Painter* self, uint32_t shap
     case SHAPE_TYPE_PATH:
     {
       const PathD* path = reinterpret_cast<const PathD*>(shapeData);
+
+      // Only paths passed by the user are cached, temporary paths (shapes) are
+      // reused and would be only detached by the cache.
+      if ((engine->cacheFlags & RASTER_CACHE_COVERAGE) != 0)
+        return RasterPaintEngine_fillCachedPathD(engine, path, engine->ctx.paintHints.fillRule);
+
       return RasterPaintEngine_fillRawPathD(engine, path, engine->ctx.paintHints.fillRule);
     }
 
@@ -3084,11 +3490,76 @@ _Default:
 // [Fog::RasterPaintEngine - Fill - GlyphRun]
 // ============================================================================
 
+// Defined in [Fog::RasterPaintEngine - Fill - Mask].
+static err_t FOG_FASTCALL RasterPaintEngine_fillMaskAligned(
+  RasterPaintEngine* engine, int dX, int dY, const Image* mask, int sX, int sY, int sW, int sH);
+
+//! @internal
+//!
+//! @brief Get whether the glyph-run can be filled using @ref RasterGlyphCache.
+//!
+//! Cached glyphs are only translated, so the final transform can't contain
+//! scaling, rotation, or projection. Large fonts are always filled as paths,
+//! their glyphs wouldn't fit into the atlas pages anyway.
+static FOG_INLINE bool RasterPaintEngine_canUseGlyphCache(RasterPaintEngine* engine, const Font* font)
+{
+  return engine->getFinalTransformD()._getType() <= TRANSFORM_TYPE_TRANSLATION &&
+         font->getAscent() + font->getDescent() <= float(RASTER_GLYPH_CACHE_GLYPH_SIZE);
+}
+
+//! @internal
+//!
+//! @brief Fill the glyph-run at @a x, @a y (in device space) using the
+//! glyph-cache.
+//!
+//! The x position of each glyph is rounded to the subpixel grid and the y
+//! position to the pixel grid, the cached A8 glyph is then passed to the
+//! fillNormalizedMaskA() command, which converts it to A8_GLYPH spans.
+static err_t FOG_FASTCALL RasterPaintEngine_fillGlyphRunCached(
+  RasterPaintEngine* engine, double x, double y, const GlyphRun* glyphRun, const Font* font)
+{
+  FOG_ASSERT(glyphRun->_itemList.getLength() == glyphRun->_positionList.getLength());
+
+  const GlyphItem* glyphs = glyphRun->_itemList.getData();
+  const GlyphPosition* positions = glyphRun->_positionList.getData();
+  size_t length = glyphRun->getLength();
+
+  RasterGlyph glyph;
+
+  for (size_t i = 0; i < length; i++)
+  {
+    int gx = Math::iround((x + double(positions[i]._position.x)) * double(RASTER_GLYPH_CACHE_SUBPIXEL_COUNT));
+    int gy = Math::iround(y + double(positions[i]._position.y));
+    uint32_t subX = (uint32_t)gx & (RASTER_GLYPH_CACHE_SUBPIXEL_COUNT - 1);
+
+    FOG_RETURN_ON_ERROR(RasterGlyphCache::getGlyph(glyph, *font, glyphs[i]._glyphIndex, subX));
+    if (glyph.isEmpty())
+      continue;
+
+    gx = (gx - (int)subX) / RASTER_GLYPH_CACHE_SUBPIXEL_COUNT;
+
+    FOG_RETURN_ON_ERROR(
+      RasterPaintEngine_fillMaskAligned(engine,
+        gx + glyph.offset.x, gy + glyph.offset.y, &glyph.image,
+        glyph.fragment.x, glyph.fragment.y, glyph.fragment.w, glyph.fragment.h)
+    );
+  }
+
+  return ERR_OK;
+}
+
 static err_t FOG_CDECL RasterPaintEngine_fillGlyphRunI(Painter* self, const PointI* p, const GlyphRun* glyphRun, const Font* font, const RectI* clip)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   _FOG_RASTER_ENTER_FILL_FUNC();
 
+  if (RasterPaintEngine_canUseGlyphCache(engine, font))
+  {
+    return RasterPaintEngine_fillGlyphRunCached(engine,
+      double(p->x) + engine->getFinalTransformD()._20,
+      double(p->y) + engine->getFinalTransformD()._21, glyphRun, font);
+  }
+
   PointF pf(*p);
 
   PathF* path = &engine->ctx.tmpPathF[0];
@@ -3103,6 +3574,13 @@ static err_t FOG_CDECL RasterPaintEngine_fillGlyphRunF(Painter* self, const Poin
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   _FOG_RASTER_ENTER_FILL_FUNC();
 
+  if (RasterPaintEngine_canUseGlyphCache(engine, font))
+  {
+    return RasterPaintEngine_fillGlyphRunCached(engine,
+      double(p->x) + engine->getFinalTransformD()._20,
+      double(p->y) + engine->getFinalTransformD()._21, glyphRun, font);
+  }
+
   PathF* path = &engine->ctx.tmpPathF[0];
   font->getOutlineFromGlyphRun(*path, CONTAINER_OP_REPLACE, *p, *glyphRun);
 
@@ -3115,6 +3593,13 @@ static err_t FOG_CDECL RasterPaintEngine_fillGlyphRunD(Painter* self, const Poin
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
   _FOG_RASTER_ENTER_FILL_FUNC();
 
+  if (RasterPaintEngine_canUseGlyphCache(engine, font))
+  {
+    return RasterPaintEngine_fillGlyphRunCached(engine,
+      p->x + engine->getFinalTransformD()._20,
+      p->y + engine->getFinalTransformD()._21, glyphRun, font);
+  }
+
   PathD* path = &engine->ctx.tmpPathD[0];
   font->getOutlineFromGlyphRun(*path, CONTAINER_OP_REPLACE, *p, *glyphRun);
 
@@ -3187,61 +3672,326 @@ static err_t FOG_CDECL RasterPaintEngine_fillTextInD(Painter* self, const TextRe
 }
 
 // ============================================================================
-// [Fog::RasterPaintEngine - Fill - Mask]
+// [Fog::RasterPaintEngine - Image - Defs]
 // ============================================================================
 
-static err_t FOG_CDECL RasterPaintEngine_fillMaskAtI(Painter* self, const PointI* p, const Image* mask, const RectI* mFragment)
-{
-  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
-  _FOG_RASTER_ENTER_FILL_FUNC();
-
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
-}
+#define _FOG_RASTER_IMAGE_PARAMS(_Image_, _ImageFragment_) \
+  int sX = 0; \
+  int sY = 0; \
+  int sW = _Image_->getWidth(); \
+  int sH = _Image_->getHeight(); \
+  \
+  if (_ImageFragment_ != NULL) \
+  { \
+    if (!_ImageFragment_->isValid()) \
+      return ERR_RT_INVALID_ARGUMENT; \
+    \
+    sX = _ImageFragment_->x; \
+    sY = _ImageFragment_->y; \
+    \
+    if ((uint)(sX) >= (uint)sW || \
+        (uint)(sY) >= (uint)sH || \
+        (uint)(_ImageFragment_->w) > (uint)(sW - sX) || \
+        (uint)(_ImageFragment_->h) > (uint)(sH - sY)) \
+    { \
+      return ERR_RT_INVALID_ARGUMENT; \
+    } \
+    \
+    sW = _ImageFragment_->w; \
+    sH = _ImageFragment_->h; \
+    if (sW == 0 || sH == 0) return ERR_OK; \
+  }
 
-static err_t FOG_CDECL RasterPaintEngine_fillMaskAtF(Painter* self, const PointF* p, const Image* mask, const RectI* mFragment)
+#define _FOG_RASTER_MASK_PARAMS(_Mask_, _MaskFragment_) \
+  int mX = 0; \
+  int mY = 0; \
+  int mW = _Mask_->getWidth(); \
+  int mH = _Mask_->getHeight(); \
+  \
+  if (_MaskFragment_ != NULL) \
+  { \
+    if (!_MaskFragment_->isValid()) \
+      return ERR_RT_INVALID_ARGUMENT; \
+    \
+    mX = _MaskFragment_->x; \
+    mY = _MaskFragment_->y; \
+    \
+    if ((uint)(mX) >= (uint)mW || \
+        (uint)(mY) >= (uint)mH || \
+        (uint)(_MaskFragment_->w - mX) > (uint)mW || \
+        (uint)(_MaskFragment_->h - mY) > (uint)mH) \
+    { \
+      return ERR_RT_INVALID_ARGUMENT; \
+    } \
+    \
+    mW = _MaskFragment_->w; \
+    mH = _MaskFragment_->h; \
+    if (mW == 0 || mH == 0) return ERR_OK; \
+  }
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Image - Analyze]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Make sure that the alpha distribution of @a src is cached.
+//!
+//! Blitters use the cached alpha distribution to replace @c COMPOSITE_SRC_OVER
+//! by @c COMPOSITE_SRC if the image is opaque. The image is analyzed here, by
+//! the engine thread, so the workers never analyze the same image in parallel.
+static FOG_INLINE void RasterPaintEngine_analyzeImage(RasterPaintEngine* engine, const Image* src)
+{
+  const ImageData* d = src->_d;
+
+  if (d->alphaDistribution == ALPHA_DISTRIBUTION_UNKNOWN &&
+      d->locked == 0 &&
+      engine->ctx.paintHints.compositingOperator == COMPOSITE_SRC_OVER &&
+      (d->format == IMAGE_FORMAT_PRGB32 || d->format == IMAGE_FORMAT_PRGB64))
+  {
+    src->getAlphaDistribution();
+  }
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Image - Mipmap]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Make sure that the mipmap levels of @a src needed to blit it using
+//! the transform @a tr are built (see @ref RasterMipmap).
+static FOG_INLINE void RasterPaintEngine_prepareMipmap(RasterPaintEngine* engine, const Image* src, const RectI& sRect, const TransformD& tr)
+{
+  if (engine->ctx.paintHints.imageQuality != IMAGE_QUALITY_NEAREST)
+    RasterMipmap::prepare(*src, sRect, tr);
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Fill - Mask]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Fill the mask at the integral position (in device space).
+static err_t FOG_FASTCALL RasterPaintEngine_fillMaskAligned(
+  RasterPaintEngine* engine, int dX, int dY, const Image* mask, int sX, int sY, int sW, int sH)
+{
+  int t;
+
+  if ((uint)(t = dX - engine->ctx.clipBoxI.x0) >= (uint)engine->ctx.clipBoxI.getWidth())
+  {
+    dX = engine->ctx.clipBoxI.x0; sX -= t;
+    if (t >= 0 || (sW += t) <= 0) return ERR_OK;
+  }
+
+  if ((uint)(t = dY - engine->ctx.clipBoxI.y0) >= (uint)engine->ctx.clipBoxI.getHeight())
+  {
+    dY = engine->ctx.clipBoxI.y0; sY -= t;
+    if (t >= 0 || (sH += t) <= 0) return ERR_OK;
+  }
+
+  if ((t = engine->ctx.clipBoxI.x1 - dX) < sW) sW = t;
+  if ((t = engine->ctx.clipBoxI.y1 - dY) < sH) sH = t;
+
+  PointI dPos(dX, dY);
+  RectI mRect(sX, sY, sW, sH);
+  return engine->doCmd->fillNormalizedMaskA(&engine->ctx, &dPos, mask, &mRect);
+}
+
+//! @internal
+//!
+//! @brief Fill the mask scaled into the rectangle @a r (in user space).
+//!
+//! The mask is fetched by the texture fetcher into a temporary image aligned
+//! to the pixel grid, which is then passed to the fillNormalizedMaskA()
+//! command, so all clip types and paint modes are handled by the same code.
+static err_t FOG_FASTCALL RasterPaintEngine_fillMaskTransformed(
+  RasterPaintEngine* engine, const RectD* r, const Image* mask, const RectI* mFragment)
+{
+  const TransformD& finalTransform = engine->getFinalTransformD();
+
+  BoxD box(r->x, r->y, r->x + r->w, r->y + r->h);
+  finalTransform.mapBox(box, box);
+
+  if (!BoxD::intersect(box, box, engine->getClipBoxD()))
+    return ERR_OK;
+
+  BoxI boxI(Math::ifloor(box.x0), Math::ifloor(box.y0), Math::iceil(box.x1), Math::iceil(box.y1));
+  if (!BoxI::intersect(boxI, boxI, engine->ctx.clipBoxI))
+    return ERR_OK;
+
+  // The texture fetcher works only in 8-bit, convert 16-bit masks.
+  Image mask8;
+  RectI mRect(*mFragment);
+
+  if (mask->getFormatDescription().getPrecision() != IMAGE_PRECISION_BYTE)
+  {
+    FOG_RETURN_ON_ERROR(mask8.setImage(*mask, *mFragment));
+    FOG_RETURN_ON_ERROR(mask8.convert(IMAGE_FORMAT_PRGB32));
+
+    mask = &mask8;
+    mRect.setRect(0, 0, mRect.w, mRect.h);
+  }
+
+  TransformD tr(
+    r->w / double(mRect.w), 0.0,
+    0.0, r->h / double(mRect.h),
+    r->x, r->y);
+  tr.transform(finalTransform, MATRIX_ORDER_APPEND);
+
+  int w = boxI.getWidth();
+  int h = boxI.getHeight();
+
+  Image tmp;
+  FOG_RETURN_ON_ERROR(tmp.create(SizeI(w, h), IMAGE_FORMAT_PRGB32));
+
+  RasterPattern pc;
+  FOG_RETURN_ON_ERROR(
+    _api_raster.texture.create(&pc,
+      IMAGE_FORMAT_PRGB32,
+      &engine->metaClipBoxI,
+      mask, &mRect,
+      &tr, &engine->dummyColor, TEXTURE_TILE_CLAMP, engine->ctx.paintHints.imageQuality)
+  );
+
+  RasterPatternFetcher pf;
+  pc.prepare(&pf, boxI.y0, 1, RASTER_FETCH_COPY);
+
+  RasterSpan8 span[1];
+  span[0].setPositionAndType(boxI.x0, boxI.x1, RASTER_SPAN_C);
+  span[0].setConstMask(0x100);
+  span[0].setNext(NULL);
+
+  uint8_t* dstPixels = tmp.getFirstX();
+  ssize_t dstStride = tmp.getStride();
+
+  for (int i = 0; i < h; i++, dstPixels += dstStride)
+  {
+    pf.fetch(span, dstPixels);
+    if (span[0].getData() != dstPixels)
+      MemOps::copy(dstPixels, span[0].getData(), (size_t)w * 4);
+  }
+
+  pc.destroy();
+
+  PointI dPos(boxI.x0, boxI.y0);
+  RectI tmpRect(0, 0, w, h);
+  return engine->doCmd->fillNormalizedMaskA(&engine->ctx, &dPos, &tmp, &tmpRect);
+}
+
+static err_t FOG_CDECL RasterPaintEngine_fillMaskAtI(Painter* self, const PointI* p, const Image* mask, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+
+  if (mask->isEmpty())
+    return ERR_OK;
+
   _FOG_RASTER_ENTER_FILL_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(mask, mFragment)
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (engine->integralTransformType == RASTER_INTEGRAL_TRANSFORM_SIMPLE)
+  {
+    return RasterPaintEngine_fillMaskAligned(engine,
+      p->x + engine->integralTransform._tx,
+      p->y + engine->integralTransform._ty,
+      mask, sX, sY, sW, sH);
+  }
+
+  RectD r(double(p->x), double(p->y), double(sW), double(sH));
+  RectI mRect(sX, sY, sW, sH);
+  return RasterPaintEngine_fillMaskTransformed(engine, &r, mask, &mRect);
+}
+
+static err_t FOG_CDECL RasterPaintEngine_fillMaskAtF(Painter* self, const PointF* p, const Image* mask, const RectI* mFragment)
+{
+  PointD pd(*p);
+  return self->_vtable->fillMaskAtD(self, &pd, mask, mFragment);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_fillMaskAtD(Painter* self, const PointD* p, const Image* mask, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+
+  if (mask->isEmpty())
+    return ERR_OK;
+
   _FOG_RASTER_ENTER_FILL_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(mask, mFragment)
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (engine->getFinalTransformD()._getType() <= TRANSFORM_TYPE_TRANSLATION)
+  {
+    Fixed48x16 x48x16 = Math::fixed48x16FromFloat(p->x + engine->getFinalTransformD()._20);
+    Fixed48x16 y48x16 = Math::fixed48x16FromFloat(p->y + engine->getFinalTransformD()._21);
+
+    // Aligned.
+    if ((((int)x48x16 | (int)y48x16) & 0xFF00) == 0)
+    {
+      return RasterPaintEngine_fillMaskAligned(engine,
+        (int)(x48x16 >> 16),
+        (int)(y48x16 >> 16),
+        mask, sX, sY, sW, sH);
+    }
+  }
+
+  RectD r(p->x, p->y, double(sW), double(sH));
+  RectI mRect(sX, sY, sW, sH);
+  return RasterPaintEngine_fillMaskTransformed(engine, &r, mask, &mRect);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_fillMaskInI(Painter* self, const RectI* r, const Image* mask, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+
+  if (mask->isEmpty())
+    return ERR_OK;
+
   _FOG_RASTER_ENTER_FILL_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(mask, mFragment)
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  // Try to use unscaled fill if possible.
+  if (r->w == sW && r->h == sH)
+  {
+    PointI dPos(r->x, r->y);
+    return self->_vtable->fillMaskAtI(self, &dPos, mask, mFragment);
+  }
+
+  if (!r->isValid())
+    return ERR_OK;
+
+  RectD rd(*r);
+  RectI mRect(sX, sY, sW, sH);
+  return RasterPaintEngine_fillMaskTransformed(engine, &rd, mask, &mRect);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_fillMaskInF(Painter* self, const RectF* r, const Image* mask, const RectI* mFragment)
 {
-  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
-  _FOG_RASTER_ENTER_FILL_FUNC();
-
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  RectD rd(*r);
+  return self->_vtable->fillMaskInD(self, &rd, mask, mFragment);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_fillMaskInD(Painter* self, const RectD* r, const Image* mask, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+
+  if (mask->isEmpty())
+    return ERR_OK;
+
   _FOG_RASTER_ENTER_FILL_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(mask, mFragment)
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  // Try to use unscaled fill if possible.
+  if (r->w == double(sW) && r->h == double(sH))
+  {
+    PointD dPos(r->x, r->y);
+    return self->_vtable->fillMaskAtD(self, &dPos, mask, mFragment);
+  }
+
+  if (!r->isValid())
+    return ERR_OK;
+
+  RectI mRect(sX, sY, sW, sH);
+  return RasterPaintEngine_fillMaskTransformed(engine, r, mask, &mRect);
 }
 
 // ============================================================================
@@ -3271,37 +4021,6 @@ static err_t FOG_CDECL RasterPaintEngine_fillRegion(Painter* self, const Region*
   }
 }
 
-// ============================================================================
-// [Fog::RasterPaintEngine - Blit - Defs]
-// ============================================================================
-
-#define _FOG_RASTER_IMAGE_PARAMS(_Image_, _ImageFragment_) \
-  int sX = 0; \
-  int sY = 0; \
-  int sW = _Image_->getWidth(); \
-  int sH = _Image_->getHeight(); \
-  \
-  if (_ImageFragment_ != NULL) \
-  { \
-    if (!_ImageFragment_->isValid()) \
-      return ERR_RT_INVALID_ARGUMENT; \
-    \
-    sX = _ImageFragment_->x; \
-    sY = _ImageFragment_->y; \
-    \
-    if ((uint)(sX) >= (uint)sW || \
-        (uint)(sY) >= (uint)sH || \
-        (uint)(_ImageFragment_->w - sX) > (uint)sW || \
-        (uint)(_ImageFragment_->h - sY) > (uint)sH) \
-    { \
-      return ERR_RT_INVALID_ARGUMENT; \
-    } \
-    \
-    sW = _ImageFragment_->w; \
-    sH = _ImageFragment_->h; \
-    if (sW == 0 || sH == 0) return ERR_OK; \
-  }
-
 // ============================================================================
 // [Fog::RasterPaintEngine - Blit - ImageAt]
 // ============================================================================
@@ -3315,6 +4034,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtI(Painter* self, const Point
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   int dX = p->x, dW;
   int dY = p->y, dH;
@@ -3358,7 +4078,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtI(Painter* self, const Point
 
       PointI dPos(dX, dY);
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitNormalizedImageA(engine, &dPos, src, &sRect);
+      return engine->doCmd->blitNormalizedImageA(&engine->ctx, &dPos, src, &sRect);
     }
 
     case RASTER_INTEGRAL_TRANSFORM_SCALING:
@@ -3393,7 +4113,7 @@ _Scaling:
       
       BoxI dBox(dX, dY, dW, dH);
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitNormalizedImageI(engine, &dBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+      return engine->doCmd->blitNormalizedImageI(&engine->ctx, &dBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
     }
 
     case RASTER_INTEGRAL_TRANSFORM_SWAP:
@@ -3423,6 +4143,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtF(Painter* self, const Point
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   uint32_t transformType = engine->getFinalTransformD()._getType();
   BoxD box(double(p->x), double(p->y), double(p->x) + double(sW), double(p->y) + double(sH));
@@ -3463,7 +4184,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtF(Painter* self, const Point
 
         PointI dPos(dX, dY);
         RectI sRect(sX, sY, sW, sH);
-        return engine->doCmd->blitNormalizedImageA(engine, &dPos, src, &sRect);
+        return engine->doCmd->blitNormalizedImageA(&engine->ctx, &dPos, src, &sRect);
       }
       else
       {
@@ -3477,7 +4198,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtF(Painter* self, const Point
         tr.translate(PointD(p->x, p->y));
 
         RectI sRect(sX, sY, sW, sH);
-        return engine->doCmd->blitNormalizedImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+        return engine->doCmd->blitNormalizedImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
       }
     }
 
@@ -3492,7 +4213,9 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtF(Painter* self, const Point
       tr.translate(PointD(p->x, p->y));
 
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitNormalizedImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+      RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
+      return engine->doCmd->blitNormalizedImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
     }
 
     default:
@@ -3507,7 +4230,9 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtF(Painter* self, const Point
       tr.translate(PointD(p->x, p->y));
 
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+      RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
+      return engine->doCmd->blitImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
     }
   }
 }
@@ -3521,6 +4246,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtD(Painter* self, const Point
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   uint32_t transformType = engine->getFinalTransformD()._getType();
   BoxD box(double(p->x), double(p->y), double(p->x) + double(sW), double(p->y) + double(sH));
@@ -3561,7 +4287,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtD(Painter* self, const Point
 
         PointI dPos(dX, dY);
         RectI sRect(sX, sY, sW, sH);
-        return engine->doCmd->blitNormalizedImageA(engine, &dPos, src, &sRect);
+        return engine->doCmd->blitNormalizedImageA(&engine->ctx, &dPos, src, &sRect);
       }
       else
       {
@@ -3575,7 +4301,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtD(Painter* self, const Point
         tr.translate(PointD(p->x, p->y));
 
         RectI sRect(sX, sY, sW, sH);
-        return engine->doCmd->blitNormalizedImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+        return engine->doCmd->blitNormalizedImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
       }
     }
 
@@ -3590,7 +4316,9 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtD(Painter* self, const Point
       tr.translate(PointD(p->x, p->y));
 
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitNormalizedImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+      RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
+      return engine->doCmd->blitNormalizedImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
     }
 
     default:
@@ -3605,7 +4333,9 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageAtD(Painter* self, const Point
       tr.translate(PointD(p->x, p->y));
 
       RectI sRect(sX, sY, sW, sH);
-      return engine->doCmd->blitImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+      RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
+      return engine->doCmd->blitImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
     }
   }
 }
@@ -3623,6 +4353,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInI(Painter* self, const RectI
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   // Try to use unscaled blit if possible.
   if (r->w == sW && r->h == sH)
@@ -3648,10 +4379,12 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInI(Painter* self, const RectI
     return ERR_OK;
 
   RectI sRect(sX, sY, sW, sH);
+  RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
   if (transformType <= TRANSFORM_TYPE_SWAP)
-    return engine->doCmd->blitNormalizedImageD(engine, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitNormalizedImageD(&engine->ctx, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
   else
-    return engine->doCmd->blitImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_blitImageInF(Painter* self, const RectF* r, const Image* src, const RectI* sFragment)
@@ -3663,6 +4396,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInF(Painter* self, const RectF
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   uint32_t transformType = engine->getFinalTransformD()._getType();
   BoxD box(double(r->x), double(r->y), double(r->x) + double(r->w), double(r->y) + double(r->h));
@@ -3680,10 +4414,12 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInF(Painter* self, const RectF
     return ERR_OK;
 
   RectI sRect(sX, sY, sW, sH);
+  RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
   if (transformType <= TRANSFORM_TYPE_SWAP)
-    return engine->doCmd->blitNormalizedImageD(engine, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitNormalizedImageD(&engine->ctx, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
   else
-    return engine->doCmd->blitImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_blitImageInD(Painter* self, const RectD* r, const Image* src, const RectI* sFragment)
@@ -3695,6 +4431,7 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInD(Painter* self, const RectD
 
   _FOG_RASTER_ENTER_BLIT_FUNC();
   _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  RasterPaintEngine_analyzeImage(engine, src);
 
   uint32_t transformType = engine->getFinalTransformD()._getType();
   BoxD box(double(r->x), double(r->y), double(r->x) + double(r->w), double(r->y) + double(r->h));
@@ -3712,10 +4449,178 @@ static err_t FOG_CDECL RasterPaintEngine_blitImageInD(Painter* self, const RectD
     return ERR_OK;
 
   RectI sRect(sX, sY, sW, sH);
+  RasterPaintEngine_prepareMipmap(engine, src, sRect, tr);
+
   if (transformType <= TRANSFORM_TYPE_SWAP)
-    return engine->doCmd->blitNormalizedImageD(engine, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitNormalizedImageD(&engine->ctx, &transformedBox, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
   else
-    return engine->doCmd->blitImageD(engine, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+    return engine->doCmd->blitImageD(&engine->ctx, &box, src, &sRect, &tr, engine->ctx.paintHints.imageQuality);
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Blit - MaskedImage]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Blit the masked image at the integral position (in device space).
+static err_t FOG_FASTCALL RasterPaintEngine_blitMaskedImageAligned(
+  RasterPaintEngine* engine, int dX, int dY,
+  const Image* src, int sX, int sY,
+  const Image* mask, int mX, int mY,
+  int w, int h)
+{
+  int t;
+
+  if ((uint)(t = dX - engine->ctx.clipBoxI.x0) >= (uint)engine->ctx.clipBoxI.getWidth())
+  {
+    dX = engine->ctx.clipBoxI.x0; sX -= t; mX -= t;
+    if (t >= 0 || (w += t) <= 0) return ERR_OK;
+  }
+
+  if ((uint)(t = dY - engine->ctx.clipBoxI.y0) >= (uint)engine->ctx.clipBoxI.getHeight())
+  {
+    dY = engine->ctx.clipBoxI.y0; sY -= t; mY -= t;
+    if (t >= 0 || (h += t) <= 0) return ERR_OK;
+  }
+
+  if ((t = engine->ctx.clipBoxI.x1 - dX) < w) w = t;
+  if ((t = engine->ctx.clipBoxI.y1 - dY) < h) h = t;
+
+  PointI dPos(dX, dY);
+  RectI sRect(sX, sY, w, h);
+  RectI mRect(mX, mY, w, h);
+  return engine->doCmd->blitNormalizedMaskedImageA(&engine->ctx, &dPos, src, &sRect, mask, &mRect);
+}
+
+//! @internal
+//!
+//! @brief Blit the masked image scaled into the rectangle @a r (in user space).
+//!
+//! The source and the mask are fetched row by row by the texture fetcher and
+//! multiplied together into a temporary image aligned to the pixel grid. The
+//! result is then blitted using the blitNormalizedImageA() command.
+static err_t FOG_FASTCALL RasterPaintEngine_blitMaskedImageTransformed(
+  RasterPaintEngine* engine, const RectD* r,
+  const Image* src, const RectI* sFragment,
+  const Image* mask, const RectI* mFragment)
+{
+  const TransformD& finalTransform = engine->getFinalTransformD();
+
+  BoxD box(r->x, r->y, r->x + r->w, r->y + r->h);
+  finalTransform.mapBox(box, box);
+
+  if (!BoxD::intersect(box, box, engine->getClipBoxD()))
+    return ERR_OK;
+
+  BoxI boxI(Math::ifloor(box.x0), Math::ifloor(box.y0), Math::iceil(box.x1), Math::iceil(box.y1));
+  if (!BoxI::intersect(boxI, boxI, engine->ctx.clipBoxI))
+    return ERR_OK;
+
+  // The texture fetcher works only in 8-bit, convert 16-bit images.
+  Image src8;
+  Image mask8;
+
+  RectI sRect(*sFragment);
+  RectI mRect(*mFragment);
+
+  if (src->getFormatDescription().getPrecision() != IMAGE_PRECISION_BYTE)
+  {
+    FOG_RETURN_ON_ERROR(src8.setImage(*src, *sFragment));
+    FOG_RETURN_ON_ERROR(src8.convert(IMAGE_FORMAT_PRGB32));
+
+    src = &src8;
+    sRect.setRect(0, 0, sRect.w, sRect.h);
+  }
+
+  if (mask->getFormatDescription().getPrecision() != IMAGE_PRECISION_BYTE)
+  {
+    FOG_RETURN_ON_ERROR(mask8.setImage(*mask, *mFragment));
+    FOG_RETURN_ON_ERROR(mask8.convert(IMAGE_FORMAT_PRGB32));
+
+    mask = &mask8;
+    mRect.setRect(0, 0, mRect.w, mRect.h);
+  }
+
+  TransformD sTr(r->w / double(sRect.w), 0.0, 0.0, r->h / double(sRect.h), r->x, r->y);
+  TransformD mTr(r->w / double(mRect.w), 0.0, 0.0, r->h / double(mRect.h), r->x, r->y);
+
+  sTr.transform(finalTransform, MATRIX_ORDER_APPEND);
+  mTr.transform(finalTransform, MATRIX_ORDER_APPEND);
+
+  int w = boxI.getWidth();
+  int h = boxI.getHeight();
+
+  Image tmp;
+  FOG_RETURN_ON_ERROR(tmp.create(SizeI(w, h), IMAGE_FORMAT_PRGB32));
+
+  MemBufferTmp<1024> maskBuffer;
+  uint8_t* maskRow = reinterpret_cast<uint8_t*>(maskBuffer.alloc((size_t)w * 4));
+
+  if (FOG_IS_NULL(maskRow))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  RasterPattern sPc;
+  RasterPattern mPc;
+
+  FOG_RETURN_ON_ERROR(
+    _api_raster.texture.create(&sPc,
+      IMAGE_FORMAT_PRGB32,
+      &engine->metaClipBoxI,
+      src, &sRect,
+      &sTr, &engine->dummyColor, TEXTURE_TILE_CLAMP, engine->ctx.paintHints.imageQuality)
+  );
+
+  err_t err = _api_raster.texture.create(&mPc,
+    IMAGE_FORMAT_PRGB32,
+    &engine->metaClipBoxI,
+    mask, &mRect,
+    &mTr, &engine->dummyColor, TEXTURE_TILE_CLAMP, engine->ctx.paintHints.imageQuality);
+
+  if (FOG_IS_ERROR(err))
+  {
+    sPc.destroy();
+    return err;
+  }
+
+  RasterPatternFetcher sPf;
+  RasterPatternFetcher mPf;
+
+  sPc.prepare(&sPf, boxI.y0, 1, RASTER_FETCH_COPY);
+  mPc.prepare(&mPf, boxI.y0, 1, RASTER_FETCH_REFERENCE);
+
+  RasterClosure closure;
+  closure.ditherOrigin.reset();
+  closure.data = NULL;
+  closure.palette = NULL;
+  closure.colorKey = 0xFFFFFFFF;
+
+  RasterVBlitLineFunc dstIn = _api_raster.getVBlitLine(IMAGE_FORMAT_PRGB32, COMPOSITE_DST_IN, IMAGE_FORMAT_PRGB32);
+
+  RasterSpan8 span[1];
+  span[0].setPositionAndType(boxI.x0, boxI.x1, RASTER_SPAN_C);
+  span[0].setConstMask(0x100);
+  span[0].setNext(NULL);
+
+  uint8_t* dstPixels = tmp.getFirstX();
+  ssize_t dstStride = tmp.getStride();
+
+  for (int i = 0; i < h; i++, dstPixels += dstStride)
+  {
+    sPf.fetch(span, dstPixels);
+    if (span[0].getData() != dstPixels)
+      MemOps::copy(dstPixels, span[0].getData(), (size_t)w * 4);
+
+    mPf.fetch(span, maskRow);
+    dstIn(dstPixels, span[0].getData(), w, &closure);
+  }
+
+  sPc.destroy();
+  mPc.destroy();
+
+  PointI dPos(boxI.x0, boxI.y0);
+  RectI tmpRect(0, 0, w, h);
+  return engine->doCmd->blitNormalizedImageA(&engine->ctx, &dPos, &tmp, &tmpRect);
 }
 
 // ============================================================================
@@ -3726,24 +4631,69 @@ static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageAtI(Painter* self, const
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (src->isEmpty() || mask->isEmpty())
+    return ERR_OK;
+
+  _FOG_RASTER_ENTER_BLIT_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  _FOG_RASTER_MASK_PARAMS(mask, mFragment)
+
+  int w = Math::min(sW, mW);
+  int h = Math::min(sH, mH);
+
+  if (engine->integralTransformType == RASTER_INTEGRAL_TRANSFORM_SIMPLE)
+  {
+    return RasterPaintEngine_blitMaskedImageAligned(engine,
+      p->x + engine->integralTransform._tx,
+      p->y + engine->integralTransform._ty,
+      src, sX, sY, mask, mX, mY, w, h);
+  }
+
+  RectD r(double(p->x), double(p->y), double(w), double(h));
+  RectI sRect(sX, sY, w, h);
+  RectI mRect(mX, mY, w, h);
+  return RasterPaintEngine_blitMaskedImageTransformed(engine, &r, src, &sRect, mask, &mRect);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageAtF(Painter* self, const PointF* p, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
 {
-  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
-
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  PointD pd(*p);
+  return self->_vtable->blitMaskedImageAtD(self, &pd, src, mask, sFragment, mFragment);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageAtD(Painter* self, const PointD* p, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (src->isEmpty() || mask->isEmpty())
+    return ERR_OK;
+
+  _FOG_RASTER_ENTER_BLIT_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  _FOG_RASTER_MASK_PARAMS(mask, mFragment)
+
+  int w = Math::min(sW, mW);
+  int h = Math::min(sH, mH);
+
+  if (engine->getFinalTransformD()._getType() <= TRANSFORM_TYPE_TRANSLATION)
+  {
+    Fixed48x16 x48x16 = Math::fixed48x16FromFloat(p->x + engine->getFinalTransformD()._20);
+    Fixed48x16 y48x16 = Math::fixed48x16FromFloat(p->y + engine->getFinalTransformD()._21);
+
+    // Aligned.
+    if ((((int)x48x16 | (int)y48x16) & 0xFF00) == 0)
+    {
+      return RasterPaintEngine_blitMaskedImageAligned(engine,
+        (int)(x48x16 >> 16),
+        (int)(y48x16 >> 16),
+        src, sX, sY, mask, mX, mY, w, h);
+    }
+  }
+
+  RectD r(p->x, p->y, double(w), double(h));
+  RectI sRect(sX, sY, w, h);
+  RectI mRect(mX, mY, w, h);
+  return RasterPaintEngine_blitMaskedImageTransformed(engine, &r, src, &sRect, mask, &mRect);
 }
 
 // ============================================================================
@@ -3754,24 +4704,246 @@ static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageInI(Painter* self, const
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (src->isEmpty() || mask->isEmpty())
+    return ERR_OK;
+
+  _FOG_RASTER_ENTER_BLIT_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  _FOG_RASTER_MASK_PARAMS(mask, mFragment)
+
+  // Try to use unscaled blit if possible.
+  if (r->w == sW && r->h == sH && r->w == mW && r->h == mH)
+  {
+    PointI dPos(r->x, r->y);
+    return self->_vtable->blitMaskedImageAtI(self, &dPos, src, mask, sFragment, mFragment);
+  }
+
+  if (!r->isValid())
+    return ERR_OK;
+
+  RectD rd(*r);
+  RectI sRect(sX, sY, sW, sH);
+  RectI mRect(mX, mY, mW, mH);
+  return RasterPaintEngine_blitMaskedImageTransformed(engine, &rd, src, &sRect, mask, &mRect);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageInF(Painter* self, const RectF* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+{
+  RectD rd(*r);
+  return self->_vtable->blitMaskedImageInD(self, &rd, src, mask, sFragment, mFragment);
+}
+
+static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageInD(Painter* self, const RectD* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (src->isEmpty() || mask->isEmpty())
+    return ERR_OK;
+
+  _FOG_RASTER_ENTER_BLIT_FUNC();
+  _FOG_RASTER_IMAGE_PARAMS(src, sFragment)
+  _FOG_RASTER_MASK_PARAMS(mask, mFragment)
+
+  // Try to use unscaled blit if possible.
+  if (r->w == double(sW) && r->h == double(sH) && r->w == double(mW) && r->h == double(mH))
+  {
+    PointD dPos(r->x, r->y);
+    return self->_vtable->blitMaskedImageAtD(self, &dPos, src, mask, sFragment, mFragment);
+  }
+
+  if (!r->isValid())
+    return ERR_OK;
+
+  RectI sRect(sX, sY, sW, sH);
+  RectI mRect(mX, mY, mW, mH);
+  return RasterPaintEngine_blitMaskedImageTransformed(engine, r, src, &sRect, mask, &mRect);
 }
 
-static err_t FOG_CDECL RasterPaintEngine_blitMaskedImageInD(Painter* self, const RectD* r, const Image* src, const Image* mask, const RectI* sFragment, const RectI* mFragment)
+// ============================================================================
+// [Fog::RasterPaintEngine - Blit - Images]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Maximum count of normalized sprites passed to the blitter at once.
+enum { RASTER_SPRITE_BATCH_SIZE = 256 };
+
+static FOG_INLINE bool RasterPaintEngine_getSpritePoint(const SpriteItemI& item, PointI& pt)
+{
+  if (!item.isUnscaled())
+    return false;
+
+  pt.set(item._rect.x, item._rect.y);
+  return true;
+}
+
+static FOG_INLINE bool RasterPaintEngine_getSpritePoint(const SpriteItemF& item, PointI& pt)
+{
+  if (!item.isUnscaled())
+    return false;
+
+  // Only sprites aligned to the pixel grid can be blitted directly.
+  int x = Math::iround(item._rect.x);
+  int y = Math::iround(item._rect.y);
+
+  if (float(x) != item._rect.x || float(y) != item._rect.y)
+    return false;
+
+  pt.set(x, y);
+  return true;
+}
+
+static FOG_INLINE err_t RasterPaintEngine_blitSpriteIn(Painter* self, const Image* src, const SpriteItemI& item)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+  return engine->vtable->blitImageInI(self, &item._rect, src, &item._fragment);
+}
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+static FOG_INLINE err_t RasterPaintEngine_blitSpriteIn(Painter* self, const Image* src, const SpriteItemF& item)
+{
+  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+  return engine->vtable->blitImageInF(self, &item._rect, src, &item._fragment);
+}
+
+static FOG_INLINE void RasterPaintEngine_setSpriteOpacity(RasterPaintEngine* engine, uint32_t opacity)
+{
+  if (engine->ctx.rasterHints.opacity != opacity)
+  {
+    engine->ctx.rasterHints.opacity = opacity;
+    engine->masterFlags |= RASTER_PENDING_OPACITY;
+  }
+}
+
+//! @internal
+//!
+//! @brief Blit sprites.
+//!
+//! All sprites which can be blitted unscaled (integral translation and sprite
+//! aligned to the pixel grid) are clipped here and passed to the blitter in
+//! batches. The other sprites are blitted one by one by @c blitImageIn. The
+//! order of sprites is always preserved.
+template<typename ItemT>
+static err_t RasterPaintEngine_blitSprites(Painter* self, const Image* src, const ItemT* items, size_t count)
+{
+  RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+
+  if (src->isEmpty() || count == 0)
+    return ERR_OK;
+
+  _FOG_RASTER_ENTER_BLIT_FUNC();
+  RasterPaintEngine_analyzeImage(engine, src);
+
+  int srcW = src->getWidth();
+  int srcH = src->getHeight();
+
+  bool isAligned = engine->integralTransformType == RASTER_INTEGRAL_TRANSFORM_SIMPLE;
+  int tx = engine->integralTransform._tx;
+  int ty = engine->integralTransform._ty;
+
+  const BoxI& clipBox = engine->ctx.clipBoxI;
+  uint32_t clipW = (uint)clipBox.getWidth();
+  uint32_t clipH = (uint)clipBox.getHeight();
+
+  uint32_t opacity = engine->ctx.rasterHints.opacity;
+  float opacityScale = engine->opacityF * engine->ctx.fullOpacity.f;
+
+  RasterSprite sprites[RASTER_SPRITE_BATCH_SIZE];
+  size_t spriteCount = 0;
+
+  err_t err = ERR_OK;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    const ItemT& item = items[i];
+    const RectI& fragment = item._fragment;
+
+    if (fragment.x < 0 || fragment.w <= 0 || fragment.w > srcW - fragment.x ||
+        fragment.y < 0 || fragment.h <= 0 || fragment.h > srcH - fragment.y ||
+        !(item._opacity >= 0.0f && item._opacity <= 1.0f))
+    {
+      err = ERR_RT_INVALID_ARGUMENT;
+      break;
+    }
+
+    uint32_t spriteOpacity = (uint32_t)Math::iround(item._opacity * opacityScale);
+    if (spriteOpacity == 0)
+      continue;
+
+    PointI pt(UNINITIALIZED);
+    if (isAligned && RasterPaintEngine_getSpritePoint(item, pt))
+    {
+      int dX = pt.x + tx;
+      int dY = pt.y + ty;
+
+      int sX = fragment.x;
+      int sY = fragment.y;
+      int sW = fragment.w;
+      int sH = fragment.h;
+      int t;
+
+      if ((uint)(t = dX - clipBox.x0) >= clipW)
+      {
+        dX = clipBox.x0; sX -= t;
+        if (t >= 0 || (sW += t) <= 0) continue;
+      }
+
+      if ((uint)(t = dY - clipBox.y0) >= clipH)
+      {
+        dY = clipBox.y0; sY -= t;
+        if (t >= 0 || (sH += t) <= 0) continue;
+      }
+
+      if ((t = clipBox.x1 - dX) < sW) sW = t;
+      if ((t = clipBox.y1 - dY) < sH) sH = t;
+
+      RasterSprite& sprite = sprites[spriteCount];
+      sprite.pt.set(dX, dY);
+      sprite.srcFragment.setRect(sX, sY, sW, sH);
+      sprite.opacity = spriteOpacity;
+
+      if (++spriteCount == RASTER_SPRITE_BATCH_SIZE)
+      {
+        err = engine->doCmd->blitNormalizedSpritesA(&engine->ctx, src, sprites, spriteCount);
+        spriteCount = 0;
+
+        if (FOG_IS_ERROR(err))
+          break;
+      }
+    }
+    else
+    {
+      if (spriteCount != 0)
+      {
+        err = engine->doCmd->blitNormalizedSpritesA(&engine->ctx, src, sprites, spriteCount);
+        spriteCount = 0;
+
+        if (FOG_IS_ERROR(err))
+          break;
+      }
+
+      RasterPaintEngine_setSpriteOpacity(engine, spriteOpacity);
+      err = RasterPaintEngine_blitSpriteIn(self, src, item);
+
+      if (FOG_IS_ERROR(err))
+        break;
+    }
+  }
+
+  if (spriteCount != 0 && err == ERR_OK)
+    err = engine->doCmd->blitNormalizedSpritesA(&engine->ctx, src, sprites, spriteCount);
+
+  RasterPaintEngine_setSpriteOpacity(engine, opacity);
+  return err;
+}
+
+static err_t FOG_CDECL RasterPaintEngine_blitImagesI(Painter* self, const Image* src, const SpriteItemI* items, size_t count)
+{
+  return RasterPaintEngine_blitSprites<SpriteItemI>(self, src, items, count);
+}
+
+static err_t FOG_CDECL RasterPaintEngine_blitImagesF(Painter* self, const Image* src, const SpriteItemF* items, size_t count)
+{
+  return RasterPaintEngine_blitSprites<SpriteItemF>(self, src, items, count);
 }
 
 // ============================================================================
@@ -3801,11 +4973,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterRawPathF(
       switch (clipper.measurePath(*path))
       {
         case PATH_CLIPPER_MEASURE_BOUNDED:
-          return engine->doCmd->filterNormalizedPathF(engine, feBase, path, &pt, fillRule);
+          return engine->doCmd->filterNormalizedPathF(&engine->ctx, feBase, path, &pt, fillRule);
         case PATH_CLIPPER_MEASURE_UNBOUNDED:
           tmp->clear();
           FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-          return engine->doCmd->filterNormalizedPathF(engine, feBase, tmp, &pt, fillRule);
+          return engine->doCmd->filterNormalizedPathF(&engine->ctx, feBase, tmp, &pt, fillRule);
         default:
           return ERR_GEOMETRY_INVALID;
       }
@@ -3813,7 +4985,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterRawPathF(
     default:
       tmp->clear();
       FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
-      return engine->doCmd->filterNormalizedPathF(engine, feBase, tmp, &pt, fillRule);
+      return engine->doCmd->filterNormalizedPathF(&engine->ctx, feBase, tmp, &pt, fillRule);
   }
 }
 
@@ -3838,11 +5010,11 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterRawPathD(
       switch (clipper.measurePath(*path))
       {
         case PATH_CLIPPER_MEASURE_BOUNDED:
-          return engine->doCmd->filterNormalizedPathD(engine, feBase, path, &pt, fillRule);
+          return engine->doCmd->filterNormalizedPathD(&engine->ctx, feBase, path, &pt, fillRule);
         case PATH_CLIPPER_MEASURE_UNBOUNDED:
           tmp->clear();
           FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-          return engine->doCmd->filterNormalizedPathD(engine, feBase, tmp, &pt, fillRule);
+          return engine->doCmd->filterNormalizedPathD(&engine->ctx, feBase, tmp, &pt, fillRule);
         default:
           return ERR_GEOMETRY_INVALID;
       }
@@ -3850,7 +5022,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterRawPathD(
     default:
       tmp->clear();
       FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
-      return engine->doCmd->filterNormalizedPathD(engine, feBase, tmp, &pt, fillRule);
+      return engine->doCmd->filterNormalizedPathD(&engine->ctx, feBase, tmp, &pt, fillRule);
   }
 }
 
@@ -3866,7 +5038,7 @@ static err_t FOG_CDECL RasterPaintEngine_filterAll(Painter* self, const FeBase*
   if (feBase->getFeType() == FE_TYPE_NONE)
     return ERR_OK;
 
-  return engine->doCmd->filterNormalizedBoxI(engine, feBase, &engine->ctx.clipBoxI);
+  return engine->doCmd->filterNormalizedBoxI(&engine->ctx, feBase, &engine->ctx.clipBoxI);
 }
 
 // ============================================================================
@@ -3885,7 +5057,7 @@ static err_t FOG_CDECL RasterPaintEngine_filterRectI(Painter* self, const FeBase
   {
     BoxI box(UNINITIALIZED);
     if (engine->doIntegralTransformAndClip(box, *r, engine->ctx.clipBoxI))
-      return engine->doCmd->filterNormalizedBoxI(engine, feBase, &box);
+      return engine->doCmd->filterNormalizedBoxI(&engine->ctx, feBase, &box);
     else
       return ERR_OK;
   }
@@ -3928,7 +5100,7 @@ static err_t FOG_CDECL RasterPaintEngine_filterRectF(Painter* self, const FeBase
   if (!BoxF::intersect(box, box, engine->getClipBoxF()))
     return ERR_OK;
 
-  return engine->doCmd->filterNormalizedBoxF(engine, feBase, &box);
+  return engine->doCmd->filterNormalizedBoxF(&engine->ctx, feBase, &box);
 }
 
 static err_t FOG_CDECL RasterPaintEngine_filterRectD(Painter* self, const FeBase* feBase, const RectD* r)
@@ -3955,7 +5127,7 @@ static err_t FOG_CDECL RasterPaintEngine_filterRectD(Painter* self, const FeBase
   if (!BoxD::intersect(box, box, engine->getClipBoxD()))
     return ERR_OK;
 
-  return engine->doCmd->filterNormalizedBoxD(engine, feBase, &box);
+  return engine->doCmd->filterNormalizedBoxD(&engine->ctx, feBase, &box);
 }
 
 // ============================================================================
@@ -4087,7 +5259,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterStrokedRawPathF(
   tmp.clear();
   FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
 
-  return engine->doCmd->filterNormalizedPathF(engine, feBase, &tmp, &engine->dummyPointF, FILL_RULE_NON_ZERO);
+  return engine->doCmd->filterNormalizedPathF(&engine->ctx, feBase, &tmp, &engine->dummyPointF, FILL_RULE_NON_ZERO);
 }
 
 static err_t FOG_FASTCALL RasterPaintEngine_filterStrokedRawPathD(
@@ -4106,7 +5278,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_filterStrokedRawPathD(
   tmp.clear();
   FOG_RETURN_ON_ERROR(stroker.strokePath(tmp, *path));
 
-  return engine->doCmd->filterNormalizedPathD(engine, feBase, &tmp, &engine->dummyPointD, FILL_RULE_NON_ZERO);
+  return engine->doCmd->filterNormalizedPathD(&engine->ctx, feBase, &tmp, &engine->dummyPointD, FILL_RULE_NON_ZERO);
 }
 
 // ============================================================================
@@ -4168,6 +5340,12 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipAll(
   if ((engine->savedStateFlags & RASTER_STATE_CLIPPING) == 0)
     engine->saveClipping();
 
+  if (engine->ctx.clipType == RASTER_CLIP_MASK)
+  {
+    engine->ctx.clipType = RASTER_CLIP_BOX;
+    engine->ctx.resetClipMask();
+  }
+
   engine->ctx.clipBoxI.reset();
   engine->ctx.clipRegion.clear();
   engine->stroker.f->_clipBox.reset();
@@ -4177,6 +5355,36 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipAll(
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::RasterPaintEngine - ClipMask]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Update the engine after the clip-mask was created or changed by
+//! @c RasterPaintDoCmd::maskNormalized...() functions.
+static err_t FOG_FASTCALL RasterPaintEngine_updateClipMask(
+  RasterPaintEngine* engine, RasterClipMask* prevMask)
+{
+  // Everything was clipped.
+  if (engine->ctx.clipType != RASTER_CLIP_MASK)
+    return RasterPaintEngine_clipAll(engine);
+
+  RasterClipMask* mask = engine->ctx.clipMask;
+  if (mask != prevMask)
+  {
+    mask->setId(++engine->masterMaskId);
+    engine->masterMaskSaved = 0;
+  }
+
+  engine->stroker.f->_clipBox.setBox(engine->ctx.clipBoxI);
+  engine->stroker.d->_clipBox.setBox(engine->ctx.clipBoxI);
+
+  engine->masterFlags &= ~RASTER_NO_PAINT_USER_CLIP;
+  engine->masterFlags |= RASTER_PENDING_CLIP;
+  return ERR_OK;
+}
+
 // ============================================================================
 // [Fog::RasterPaintEngine - ClipNormalizedBox]
 // ============================================================================
@@ -4232,7 +5440,9 @@ _ReplaceClipBox:
           goto _ReplaceTryMeta;
 
         case RASTER_CLIP_MASK:
-          // TODO: RasterPaintEngine - clip-mask.
+          // Not used anymore, the clip-mask is still referenced by the saved
+          // state (if any).
+          engine->ctx.resetClipMask();
           goto _ReplaceTryMeta;
 
         default:
@@ -4286,8 +5496,14 @@ _ReplaceClipRegion:
           return ERR_OK;
 
         case RASTER_CLIP_MASK:
-          // TODO: RasterPaintEngine - clip-mask.
-          break;
+        {
+          // The clip-mask is changed in place if it's not shared, otherwise
+          // a new clip-mask is created.
+          RasterClipMask* prevMask = engine->ctx.clipMask;
+
+          FOG_RETURN_ON_ERROR(engine->doCmd->maskNormalizedBoxI(&engine->ctx, clipOp, box));
+          return RasterPaintEngine_updateClipMask(engine, prevMask);
+        }
 
         default:
           FOG_ASSERT_NOT_REACHED();
@@ -4304,15 +5520,57 @@ _ReplaceClipRegion:
 static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxF(
   RasterPaintEngine* engine, uint32_t clipOp, const BoxF* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  BoxI box24x8(UNINITIALIZED);
+  box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
+  box24x8.y0 = Math::fixed24x8FromFloat(box->y0);
+  box24x8.x1 = Math::fixed24x8FromFloat(box->x1);
+  box24x8.y1 = Math::fixed24x8FromFloat(box->y1);
+
+  // Use the clip-box or clip-region if the box is aligned to the pixel grid.
+  if (RasterUtil::isBox24x8Aligned(box24x8))
+  {
+    BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
+    if (!boxI.isValid())
+      return RasterPaintEngine_clipAll(engine);
+
+    return RasterPaintEngine_clipNormalizedBoxI(engine, clipOp, &boxI);
+  }
+
+  if ((engine->savedStateFlags & RASTER_STATE_CLIPPING) == 0)
+    engine->saveClipping();
+
+  RasterClipMask* prevMask = engine->ctx.clipMask;
+
+  FOG_RETURN_ON_ERROR(engine->doCmd->maskNormalizedBoxF(&engine->ctx, clipOp, box));
+  return RasterPaintEngine_updateClipMask(engine, prevMask);
 }
 
 static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxD(
   RasterPaintEngine* engine, uint32_t clipOp, const BoxD* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  BoxI box24x8(UNINITIALIZED);
+  box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
+  box24x8.y0 = Math::fixed24x8FromFloat(box->y0);
+  box24x8.x1 = Math::fixed24x8FromFloat(box->x1);
+  box24x8.y1 = Math::fixed24x8FromFloat(box->y1);
+
+  // Use the clip-box or clip-region if the box is aligned to the pixel grid.
+  if (RasterUtil::isBox24x8Aligned(box24x8))
+  {
+    BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
+    if (!boxI.isValid())
+      return RasterPaintEngine_clipAll(engine);
+
+    return RasterPaintEngine_clipNormalizedBoxI(engine, clipOp, &boxI);
+  }
+
+  if ((engine->savedStateFlags & RASTER_STATE_CLIPPING) == 0)
+    engine->saveClipping();
+
+  RasterClipMask* prevMask = engine->ctx.clipMask;
+
+  FOG_RETURN_ON_ERROR(engine->doCmd->maskNormalizedBoxD(&engine->ctx, clipOp, box));
+  return RasterPaintEngine_updateClipMask(engine, prevMask);
 }
 
 // ============================================================================
@@ -4322,15 +5580,85 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxD(
 static err_t FOG_FASTCALL RasterPaintEngine_clipRawPathF(
   RasterPaintEngine* engine, uint32_t clipOp, const PathF* path, uint32_t fillRule)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  if ((engine->savedStateFlags & RASTER_STATE_CLIPPING) == 0)
+    engine->saveClipping();
+
+  const TransformF& transform = engine->getFinalTransformF();
+  uint32_t transformType = engine->ensureFinalTransformF()
+    ? transform._getType()
+    : TRANSFORM_TYPE_IDENTITY;
+
+  PathClipperF clipper(clipOp == CLIP_OP_REPLACE ? engine->getMetaClipBoxF() : engine->getClipBoxF());
+  PathF* tmp = &engine->ctx.tmpPathF[1];
+  RasterClipMask* prevMask = engine->ctx.clipMask;
+
+  // The mask rasterizer has no offset, a translation is handled by the path
+  // clipper like any other transform.
+  if (transformType == TRANSFORM_TYPE_IDENTITY)
+  {
+    switch (clipper.measurePath(*path))
+    {
+      case PATH_CLIPPER_MEASURE_BOUNDED:
+        break;
+      case PATH_CLIPPER_MEASURE_UNBOUNDED:
+        tmp->clear();
+        FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
+        path = tmp;
+        break;
+      default:
+        return ERR_GEOMETRY_INVALID;
+    }
+  }
+  else
+  {
+    tmp->clear();
+    FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
+    path = tmp;
+  }
+
+  FOG_RETURN_ON_ERROR(engine->doCmd->maskNormalizedPathF(&engine->ctx, clipOp, path, fillRule));
+  return RasterPaintEngine_updateClipMask(engine, prevMask);
 }
 
-static err_t FOG_FASTCALL RasterPaintEngine_clipRawPathD(
-  RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule)
-{
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+static err_t FOG_FASTCALL RasterPaintEngine_clipRawPathD(
+  RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule)
+{
+  if ((engine->savedStateFlags & RASTER_STATE_CLIPPING) == 0)
+    engine->saveClipping();
+
+  const TransformD& transform = engine->getFinalTransformD();
+  uint32_t transformType = transform._getType();
+
+  PathClipperD clipper(clipOp == CLIP_OP_REPLACE ? engine->getMetaClipBoxD() : engine->getClipBoxD());
+  PathD* tmp = &engine->ctx.tmpPathD[1];
+  RasterClipMask* prevMask = engine->ctx.clipMask;
+
+  // The mask rasterizer has no offset, a translation is handled by the path
+  // clipper like any other transform.
+  if (transformType == TRANSFORM_TYPE_IDENTITY)
+  {
+    switch (clipper.measurePath(*path))
+    {
+      case PATH_CLIPPER_MEASURE_BOUNDED:
+        break;
+      case PATH_CLIPPER_MEASURE_UNBOUNDED:
+        tmp->clear();
+        FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
+        path = tmp;
+        break;
+      default:
+        return ERR_GEOMETRY_INVALID;
+    }
+  }
+  else
+  {
+    tmp->clear();
+    FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, transform));
+    path = tmp;
+  }
+
+  FOG_RETURN_ON_ERROR(engine->doCmd->maskNormalizedPathD(&engine->ctx, clipOp, path, fillRule));
+  return RasterPaintEngine_updateClipMask(engine, prevMask);
 }
 
 
@@ -4382,13 +5710,13 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipPathF(
     switch (clipper.measurePath(*path))
     {
       case PATH_CLIPPER_MEASURE_BOUNDED:
-        engine->doCmd->clipNormalizedPathF(engine, clipOp, path, fillRule);
+        engine->doCmd->clipNormalizedPathF(&engine->ctx, clipOp, path, fillRule);
         return ERR_OK;
 
       case PATH_CLIPPER_MEASURE_UNBOUNDED:
         tmp->clear();
         FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-        engine->doCmd->clipNormalizedPathF(engine, clipOp, tmp, fillRule);
+        engine->doCmd->clipNormalizedPathF(&engine->ctx, clipOp, tmp, fillRule);
         return ERR_OK;
 
       default:
@@ -4399,7 +5727,7 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipPathF(
   {
     tmp->clear();
     FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, engine->getFinalTransformF()));
-    engine->doCmd->clipNormalizedPathF(engine, clipOp, tmp, fillRule);
+    engine->doCmd->clipNormalizedPathF(&engine->ctx, clipOp, tmp, fillRule);
     return ERR_OK;
   }
 }
@@ -4417,13 +5745,13 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipPathD(
     switch (clipper.measurePath(*path))
     {
       case PATH_CLIPPER_MEASURE_BOUNDED:
-        engine->doCmd->clipNormalizedPathD(engine, clipOp, path, fillRule);
+        engine->doCmd->clipNormalizedPathD(&engine->ctx, clipOp, path, fillRule);
         return ERR_OK;
 
       case PATH_CLIPPER_MEASURE_UNBOUNDED:
         tmp->clear();
         FOG_RETURN_ON_ERROR(clipper.continuePath(*tmp, *path));
-        engine->doCmd->clipNormalizedPathD(engine, clipOp, tmp, fillRule);
+        engine->doCmd->clipNormalizedPathD(&engine->ctx, clipOp, tmp, fillRule);
         return ERR_OK;
 
       default:
@@ -4434,7 +5762,7 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipPathD(
   {
     tmp->clear();
     FOG_RETURN_ON_ERROR(clipper.clipPath(*tmp, *path, engine->getFinalTransformD()));
-    engine->doCmd->clipNormalizedPathD(engine, clipOp, tmp, fillRule);
+    engine->doCmd->clipNormalizedPathD(&engine->ctx, clipOp, tmp, fillRule);
     return ERR_OK;
   }
 }
@@ -4454,7 +5782,7 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipStrokedPathF(
 
   tmp->clear();
   stroker->strokePath(*tmp, *path);
-  return engine->doCmd->clipNormalizedPathF(engine, clipOp, tmp, FILL_RULE_NON_ZERO);
+  return engine->doCmd->clipNormalizedPathF(&engine->ctx, clipOp, tmp, FILL_RULE_NON_ZERO);
 }
 
 static err_t FOG_FASTCALL RasterPaintSerializer_clipStrokedPathD(
@@ -4472,7 +5800,7 @@ static err_t FOG_FASTCALL RasterPaintSerializer_clipStrokedPathD(
 
   tmp->clear();
   stroker->strokePath(*tmp, *path);
-  return engine->doCmd->clipNormalizedPathD(engine, clipOp, tmp, FILL_RULE_NON_ZERO);
+  return engine->doCmd->clipNormalizedPathD(&engine->ctx, clipOp, tmp, FILL_RULE_NON_ZERO);
 }
 
 static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxF(
@@ -4481,6 +5809,8 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxF(
   switch (engine->ctx.precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    case IMAGE_PRECISION_WORD:
     {
       BoxI box24x8(UNINITIALIZED);
       box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
@@ -4491,7 +5821,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxF(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->clipNormalizedBoxI(engine, clipOp, &boxI);
+        return engine->doCmd->clipNormalizedBoxI(&engine->ctx, clipOp, &boxI);
       }
 
       BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
@@ -4503,12 +5833,6 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxF(
       // return RasterPaintSerializer_filterRasterizedShape8_render_st(engine, rasterizer, &rasterizer->_boxBounds);
     }
 
-    case IMAGE_PRECISION_WORD:
-    {
-      // TODO: 16-bit image processing.
-      break;
-    }
-
     default:
       FOG_ASSERT_NOT_REACHED();
   }
@@ -4533,7 +5857,7 @@ static err_t FOG_FASTCALL RasterPaintEngine_clipNormalizedBoxD(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->clipNormalizedBoxI(engine, clipOp, &boxI);
+        return engine->doCmd->clipNormalizedBoxI(&engine->ctx, clipOp, &boxI);
       }
 
       BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
@@ -4724,17 +6048,77 @@ static err_t FOG_CDECL RasterPaintEngine_clipPolygonI(Painter* self, uint32_t cl
 static err_t FOG_CDECL RasterPaintEngine_clipShapeF(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+  _FOG_RASTER_ENTER_CLIP_FUNC();
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  switch (shapeType)
+  {
+    case SHAPE_TYPE_RECT:
+    {
+      return self->_vtable->clipRectF(self, clipOp, static_cast<const RectF*>(shapeData));
+    }
+
+    case SHAPE_TYPE_RECT_ARRAY:
+    {
+      const RectArrayF* rects = reinterpret_cast<const RectArrayF*>(shapeData);
+      if (rects->getLength() == 1)
+        return self->_vtable->clipRectF(self, clipOp, rects->getData());
+      else
+        goto _Default;
+    }
+
+    case SHAPE_TYPE_PATH:
+    {
+      const PathF* path = reinterpret_cast<const PathF*>(shapeData);
+      return RasterPaintEngine_clipRawPathF(engine, clipOp, path, engine->ctx.paintHints.fillRule);
+    }
+
+    default:
+    {
+_Default:
+      PathF* path = &engine->ctx.tmpPathF[0];
+      path->clear();
+      path->_shape(shapeType, shapeData, PATH_DIRECTION_CW, NULL);
+      return RasterPaintEngine_clipRawPathF(engine, clipOp, path, engine->ctx.paintHints.fillRule);
+    }
+  }
 }
 
 static err_t FOG_CDECL RasterPaintEngine_clipShapeD(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
+  _FOG_RASTER_ENTER_CLIP_FUNC();
 
-  // TODO:
-  return ERR_RT_NOT_IMPLEMENTED;
+  switch (shapeType)
+  {
+    case SHAPE_TYPE_RECT:
+    {
+      return self->_vtable->clipRectD(self, clipOp, static_cast<const RectD*>(shapeData));
+    }
+
+    case SHAPE_TYPE_RECT_ARRAY:
+    {
+      const RectArrayD* rects = reinterpret_cast<const RectArrayD*>(shapeData);
+      if (rects->getLength() == 1)
+        return self->_vtable->clipRectD(self, clipOp, rects->getData());
+      else
+        goto _Default;
+    }
+
+    case SHAPE_TYPE_PATH:
+    {
+      const PathD* path = reinterpret_cast<const PathD*>(shapeData);
+      return RasterPaintEngine_clipRawPathD(engine, clipOp, path, engine->ctx.paintHints.fillRule);
+    }
+
+    default:
+    {
+_Default:
+      PathD* path = &engine->ctx.tmpPathD[0];
+      path->clear();
+      path->_shape(shapeType, shapeData, PATH_DIRECTION_CW, NULL);
+      return RasterPaintEngine_clipRawPathD(engine, clipOp, path, engine->ctx.paintHints.fillRule);
+    }
+  }
 }
 
 static err_t FOG_CDECL RasterPaintEngine_clipStrokedShapeF(Painter* self, uint32_t clipOp, uint32_t shapeType, const void* shapeData)
@@ -4877,6 +6261,7 @@ static err_t FOG_CDECL RasterPaintEngine_resetClip(Painter* self)
     engine->ctx.clipRegion.clear();
   }
 
+  engine->ctx.resetClipMask();
   engine->stroker.f->_clipBox.setBox(engine->ctx.clipBoxI);
   engine->stroker.d->_clipBox.setBox(engine->ctx.clipBoxI);
 
@@ -4947,6 +6332,27 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
           cmd->destroy(engine);
         break;
       }
+
+      case RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64:
+      {
+        RasterPaintCmd_SetOpacityAndPrgb64* cmd =
+          reinterpret_cast<RasterPaintCmd_SetOpacityAndPrgb64*>(p);
+        p += sizeof(RasterPaintCmd_SetOpacityAndPrgb64);
+
+        if (Evaluate)
+        {
+          if (RasterUtil::isPatternContext(engine->ctx.pc) && engine->ctx.pc->_reference.deref())
+            engine->destroyPatternContext(engine->ctx.pc);
+
+          engine->ctx.pc = (RasterPattern*)(size_t)0x1;
+          engine->ctx.solid.prgb64 = cmd->getPrgb64();
+          engine->ctx.rasterHints.opacity = cmd->getOpacity();
+        }
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
       
       case RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN:
       {
@@ -4991,7 +6397,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillAll);
 
         if (Evaluate)
-          doCmd->fillAll(engine);
+          doCmd->fillAll(&engine->ctx);
         
         if (Destroy)
           cmd->destroy(engine);
@@ -5005,7 +6411,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillNormalizedBoxI);
 
         if (Evaluate)
-          doCmd->fillNormalizedBoxI(engine, &cmd->_box);
+          doCmd->fillNormalizedBoxI(&engine->ctx, &cmd->_box);
         
         if (Destroy)
           cmd->destroy(engine);
@@ -5019,7 +6425,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillNormalizedBoxF);
 
         if (Evaluate)
-          doCmd->fillNormalizedBoxF(engine, &cmd->_box);
+          doCmd->fillNormalizedBoxF(&engine->ctx, &cmd->_box);
 
         if (Destroy)
           cmd->destroy(engine);
@@ -5033,7 +6439,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillNormalizedBoxD);
 
         if (Evaluate)
-          doCmd->fillNormalizedBoxD(engine, &cmd->_box);
+          doCmd->fillNormalizedBoxD(&engine->ctx, &cmd->_box);
 
         if (Destroy)
           cmd->destroy(engine);
@@ -5047,7 +6453,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillNormalizedPathF);
 
         if (Evaluate)
-          doCmd->fillNormalizedPathF(engine, &cmd->_path, &cmd->_pt, cmd->getFillRule());
+          doCmd->fillNormalizedPathF(&engine->ctx, &cmd->_path, &cmd->_pt, cmd->getFillRule());
 
         if (Destroy)
           cmd->destroy(engine);
@@ -5061,13 +6467,69 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_FillNormalizedPathD);
 
         if (Evaluate)
-          doCmd->fillNormalizedPathD(engine, &cmd->_path, &cmd->_pt, cmd->getFillRule());
+          doCmd->fillNormalizedPathD(&engine->ctx, &cmd->_path, &cmd->_pt, cmd->getFillRule());
 
         if (Destroy)
           cmd->destroy(engine);
         break;
       }
       
+      case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F:
+      {
+        RasterPaintCmd_StrokeHairlinePathF* cmd =
+          reinterpret_cast<RasterPaintCmd_StrokeHairlinePathF*>(p);
+        p += sizeof(RasterPaintCmd_StrokeHairlinePathF);
+
+        if (Evaluate)
+          doCmd->strokeHairlinePathF(&engine->ctx, &cmd->_path, &cmd->_hairline);
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
+
+      case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D:
+      {
+        RasterPaintCmd_StrokeHairlinePathD* cmd =
+          reinterpret_cast<RasterPaintCmd_StrokeHairlinePathD*>(p);
+        p += sizeof(RasterPaintCmd_StrokeHairlinePathD);
+
+        if (Evaluate)
+          doCmd->strokeHairlinePathD(&engine->ctx, &cmd->_path, &cmd->_hairline);
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_COVERAGE:
+      {
+        RasterPaintCmd_FillCoverage* cmd =
+          reinterpret_cast<RasterPaintCmd_FillCoverage*>(p);
+        p += sizeof(RasterPaintCmd_FillCoverage);
+
+        if (Evaluate)
+          doCmd->fillCoverage(&engine->ctx, cmd->_coverage);
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A:
+      {
+        RasterPaintCmd_FillNormalizedMaskA* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedMaskA*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedMaskA);
+
+        if (Evaluate)
+          doCmd->fillNormalizedMaskA(&engine->ctx, &cmd->_pt, &cmd->_mask, &cmd->_maskFragment);
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
+
       case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A:
       {
         RasterPaintCmd_BlitNormalizedImageA* cmd =
@@ -5078,7 +6540,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         {
           const Image& srcImage = cmd->getSrcImage();
           RectI srcFragment(0, 0, srcImage.getWidth(), srcImage.getHeight());
-          doCmd->blitNormalizedImageA(engine, &cmd->_pt, &srcImage, &srcFragment);
+          doCmd->blitNormalizedImageA(&engine->ctx, &cmd->_pt, &srcImage, &srcFragment);
         }
 
         if (Destroy)
@@ -5093,7 +6555,22 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         p += sizeof(RasterPaintCmd_BlitNormalizedImageFragmentA);
 
         if (Evaluate)
-          doCmd->blitNormalizedImageA(engine, &cmd->_pt, &cmd->_srcImage, &cmd->_srcFragment);
+          doCmd->blitNormalizedImageA(&engine->ctx, &cmd->_pt, &cmd->_srcImage, &cmd->_srcFragment);
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A:
+      {
+        RasterPaintCmd_BlitNormalizedMaskedImageA* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedMaskedImageA*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedMaskedImageA);
+
+        if (Evaluate)
+          doCmd->blitNormalizedMaskedImageA(&engine->ctx, &cmd->_pt,
+            &cmd->_srcImage, &cmd->_srcFragment, &cmd->_mask, &cmd->_maskFragment);
 
         if (Destroy)
           cmd->destroy(engine);
@@ -5110,6 +6587,7 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
         {
           engine->ctx.clipType = RASTER_CLIP_BOX;
           engine->ctx.clipBoxI = cmd->getClipBox();
+          engine->ctx.resetClipMask();
         }
 
         if (Destroy)
@@ -5128,12 +6606,33 @@ static void RasterPaintEngine_doCommands(Painter* self, uint8_t* p, uint8_t* pEn
           engine->ctx.clipType = RASTER_CLIP_REGION;
           engine->ctx.clipRegion = cmd->getClipRegion();
           engine->ctx.clipBoxI = engine->ctx.clipRegion.getBoundingBox();
+          engine->ctx.resetClipMask();
         }
         
         if (Destroy)
           cmd->destroy(engine);
         break;
       }
+
+      case RASTER_PAINT_CMD_SET_CLIP_MASK:
+      {
+        RasterPaintCmd_SetClipMask* cmd =
+          reinterpret_cast<RasterPaintCmd_SetClipMask*>(p);
+        p += sizeof(RasterPaintCmd_SetClipMask);
+
+        if (Evaluate)
+        {
+          RasterClipMask* mask = cmd->getClipMask();
+
+          engine->ctx.clipType = RASTER_CLIP_MASK;
+          engine->ctx.clipBoxI = mask->getBoundingBox();
+          engine->ctx.setClipMask(mask->addRef());
+        }
+
+        if (Destroy)
+          cmd->destroy(engine);
+        break;
+      }
     }
   }
 }
@@ -5150,6 +6649,7 @@ static err_t FOG_CDECL RasterPaintEngine_beginGroup(Painter* self, uint32_t flag
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
+  uint8_t* cPrev = engine->cmdAllocator._pos;
   MemZoneRecord* cRecord = engine->cmdAllocator.record();
   MemZoneRecord* gRecord = engine->groupAllocator.record();
 
@@ -5171,6 +6671,7 @@ static err_t FOG_CDECL RasterPaintEngine_beginGroup(Painter* self, uint32_t flag
 
   g->groupRecord = gRecord;
   g->cmdRecord = cRecord;
+  g->cmdPrev = cPrev;
   g->cmdStart = engine->cmdAllocator._pos;
 
   // Save all states, because states are always preserved across the groups.
@@ -5222,14 +6723,19 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
     RasterPaintTarget savedTarget = engine->ctx.target;
     SizeI targetSize(targetBBox.getWidth(), targetBBox.getHeight());
 
+    // The group is rendered using the precision of the target.
+    uint32_t groupFormat = (engine->ctx.precision == IMAGE_PRECISION_WORD)
+      ? IMAGE_FORMAT_PRGB64
+      : IMAGE_FORMAT_PRGB32;
+
     image.init();
-    if (image->create(targetSize, IMAGE_FORMAT_PRGB32) != ERR_OK)
+    if (image->create(targetSize, groupFormat) != ERR_OK)
       goto _DiscardCommands;
 
     // We don't change target size.
     engine->ctx.target.stride = image->getStride();
     engine->ctx.target.pixels = image->getFirstX();
-    engine->ctx.target.format = IMAGE_FORMAT_PRGB32;
+    engine->ctx.target.format = groupFormat;
     engine->ctx.target.setup();
 
     // Offset target buffer.
@@ -5240,16 +6746,16 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
 
     // Clear the temporary image.
     uint32_t oldPaintHints = engine->ctx.paintHints.packed;
-    uint32_t oldPrgb32 = engine->ctx.solid.prgb32.u32;
+    RasterSolid oldSolid = engine->ctx.solid;
 
     engine->ctx.paintHints.compositingOperator = COMPOSITE_SRC;
-    engine->ctx.solid.prgb32.u32 = 0x00000000;
+    engine->ctx.solid.reset();
     engine->ctx.pc = (RasterPattern*)(size_t)0x1;
 
-    engine->doCmd->fillNormalizedBoxI(engine, &targetBBox);
+    engine->doCmd->fillNormalizedBoxI(&engine->ctx, &targetBBox);
 
     engine->ctx.paintHints.packed = oldPaintHints;
-    engine->ctx.solid.prgb32.u32 = oldPrgb32;
+    engine->ctx.solid = oldSolid;
     engine->ctx.pc = NULL;
 
     // Reset core states which are always set to default values when new group
@@ -5259,10 +6765,12 @@ static err_t FOG_CDECL RasterPaintEngine_paintGroup(Painter* self)
     // Run commands.
     RasterPaintEngine_doCommands<true, true>(self, g->cmdStart, engine->cmdAllocator._pos);
 
-    // Switch 'doCmd' interface to the previous group or keep direct rendering
-    // in case that there is no previous group.
+    // Switch 'doCmd' interface to the previous group or to the direct
+    // rendering in case that there is no previous group.
     if (engine->curGroup != &engine->topGroup)
       engine->doCmd = &RasterPaintDoGroup_vtable[RASTER_MODE_ST];
+    else
+      engine->doCmd = &RasterPaintDoRender_vtable[engine->wm != NULL ? RASTER_MODE_MT : RASTER_MODE_ST];
 
     // Revert target, and everything else.
     engine->ctx.target = savedTarget;
@@ -5276,7 +6784,7 @@ _DiscardCommands:
     if (engine->curGroup != &engine->topGroup)
       engine->doCmd = &RasterPaintDoGroup_vtable[RASTER_MODE_ST];
     else
-      engine->doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
+      engine->doCmd = &RasterPaintDoRender_vtable[engine->wm != NULL ? RASTER_MODE_MT : RASTER_MODE_ST];
   }
 
   // We must zero pattern context pointer, because it has been invalidated.
@@ -5295,7 +6803,7 @@ _DiscardCommands:
   {
     PointI dPos(targetBBox.x0, targetBBox.y0);
     RectI sRect(0, 0, image->getWidth(), image->getHeight());
-    engine->doCmd->blitNormalizedImageA(engine, &dPos, &image, &sRect);
+    engine->doCmd->blitNormalizedImageA(&engine->ctx, &dPos, &image, &sRect);
     image.destroy();
   }
 
@@ -5310,8 +6818,10 @@ static err_t FOG_CDECL RasterPaintEngine_flush(Painter* self, uint32_t flags)
 {
   RasterPaintEngine* engine = static_cast<RasterPaintEngine*>(self->_engine);
 
-  // TODO: MT version.
-  return ERR_OK;
+  if (engine->wm == NULL)
+    return ERR_OK;
+
+  return engine->wm->flush();
 }
 
 // ============================================================================
@@ -5340,8 +6850,10 @@ RasterPaintEngine::RasterPaintEngine() :
   groupAllocator(500),
   curGroup(&topGroup),
   cmdAllocator(16300),
+  wm(NULL),
   maxThreads(0),
-  finalizing(0)
+  finalizing(0),
+  cacheFlags(RASTER_CACHE_NONE)
 {
   // Setup the essentials.
   vtable = NULL;
@@ -5371,8 +6883,14 @@ RasterPaintEngine::RasterPaintEngine() :
 
 RasterPaintEngine::~RasterPaintEngine()
 {
+  // Render all pending commands and release all workers.
+  setMultithreaded(false);
+
   if (ctx.target.imageData)
+  {
     ctx.target.imageData->locked--;
+    ctx.target.imageData->resetCache();
+  }
 
   discardStates(NULL);
   // TODO: Discard also groups.
@@ -5391,7 +6909,13 @@ err_t RasterPaintEngine::init(const ImageBits& imageBits, ImageData* imaged, uin
   ctx.target.format = imageBits.getFormat();
 
   ctx.target.imageData = imaged;
-  if (imaged) imaged->locked++;
+  if (imaged)
+  {
+    // The alpha distribution and mipmap are not cached while the image is
+    // being painted.
+    imaged->locked++;
+    imaged->resetCache();
+  }
 
   vtable = &RasterPaintEngine_vtable[ctx.target.precision];
   doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
@@ -5402,6 +6926,15 @@ err_t RasterPaintEngine::init(const ImageBits& imageBits, ImageData* imaged, uin
   setupOps();
   setupDefaultClip();
 
+  // Multithreading is only used when the target is large enough, otherwise the
+  // overhead of the synchronization is higher than the rendering itself.
+  if ((initFlags & PAINTER_INIT_MT) != 0 &&
+      (uint64_t)(uint)ctx.target.size.w * (uint)ctx.target.size.h >= RASTER_MIN_SIZE_THRESHOLD)
+  {
+    // Failing to create the workers is not fatal, the engine is still usable.
+    setMultithreaded(true);
+  }
+
   return ERR_OK;
 }
 
@@ -5417,7 +6950,58 @@ err_t RasterPaintEngine::switchTo(const ImageBits& imageBits, ImageData* imaged)
 
 uint RasterPaintEngine::detectMaxThreads()
 {
-  return Math::max<uint>(Cpu::get()->getNumberOfProcessors(), RASTER_MAX_THREADS_SUGGESTED);
+  return Math::min<uint>(Cpu::get()->getNumberOfProcessors(), RASTER_MAX_THREADS_SUGGESTED);
+}
+
+// ============================================================================
+// [Fog::RasterPaintEngine - Multithreading]
+// ============================================================================
+
+err_t RasterPaintEngine::setMultithreaded(bool enabled)
+{
+  if (enabled == (wm != NULL))
+    return ERR_OK;
+
+  if (enabled)
+  {
+    if (maxThreads < 2)
+      return ERR_OK;
+
+    // The painter must not be inside a group (the group commands are always
+    // rendered by the master thread).
+    if (curGroup != &topGroup)
+      return ERR_PAINTER_NOT_ALLOWED;
+
+    RasterPaintWorkMgr* newWm = fog_new RasterPaintWorkMgr(this);
+    if (FOG_IS_NULL(newWm))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    err_t err = newWm->init(maxThreads);
+    if (FOG_IS_ERROR(err))
+    {
+      fog_delete(newWm);
+      return err;
+    }
+
+    wm = newWm;
+    doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_MT];
+  }
+  else
+  {
+    // Can't fail when finalizing, the pending commands are rendered.
+    err_t err = wm->flush();
+
+    fog_delete(wm);
+    wm = NULL;
+
+    if (curGroup == &topGroup)
+      doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
+
+    if (FOG_IS_ERROR(err) && !finalizing)
+      return err;
+  }
+
+  return ERR_OK;
 }
 
 // ============================================================================
@@ -5594,7 +7178,8 @@ void RasterPaintEngine::saveClipping()
       break;
 
     case RASTER_CLIP_MASK:
-      // TODO: RasterPaintEngine - clip-mask.
+      state->clipMask = ctx.clipMask->addRef();
+      state->clipMaskSaved = masterMaskSaved++;
       break;
 
     default:
@@ -5710,7 +7295,8 @@ _SaveSourceContinue:
       break;
 
     case RASTER_CLIP_MASK:
-      // TODO: RasterPaintEngine - clip-mask.
+      state->clipMask = ctx.clipMask->addRef();
+      state->clipMaskSaved = masterMaskSaved++;
       break;
 
     default:
@@ -5789,7 +7375,7 @@ _DiscardSourceContinue:
           break;
 
         case RASTER_CLIP_MASK:
-          // TODO: RasterPaintEngine - clip-mask.
+          cur->clipMask->release();
           break;
           
         default:
@@ -5852,6 +7438,7 @@ void RasterPaintEngine::setupDefaultClip()
   ctx.clipType = RASTER_CLIP_BOX;
   ctx.clipRegion.clear();
   ctx.clipBoxI = bounds;
+  ctx.resetClipMask();
   stroker.f->_clipBox.setBox(bounds);
   stroker.d->_clipBox.setBox(bounds);
 
@@ -5867,14 +7454,77 @@ void RasterPaintEngine::setupDefaultClip()
 // [Fog::RasterPaintEngine - Helpers - Source]
 // ============================================================================
 
+//! @internal
+//!
+//! @brief Initialize the pattern context @a pc using the current source.
+static err_t RasterPaintEngine_initPatternContext(RasterPaintEngine* engine, RasterPattern* pc, uint32_t quality)
+{
+  // Initialize the context state to UNINITIALIZED. It's important to mark
+  // context as uninitialized, because there are asserts inside pattern-context
+  // initializers and leaving the pattern-context state as is might cause crash
+  // in debug-mode.
+  pc->reset();
+
+  switch (engine->sourceType)
+  {
+    case RASTER_SOURCE_TEXTURE:
+    {
+      RasterPaintEngine_prepareMipmap(engine, &engine->source.texture->_image, engine->source.texture->_fragment, engine->source.adjusted);
+
+      return _api_raster.texture.create(pc,
+        engine->ctx.target.format,
+        &engine->metaClipBoxI,
+        &engine->source.texture->_image,
+        &engine->source.texture->_fragment,
+        &engine->source.adjusted,
+        &engine->source.texture->_clampColor,
+        engine->source.texture->getTileType(),
+        quality);
+    }
+
+    case RASTER_SOURCE_GRADIENT:
+    {
+      uint32_t gradientType = engine->source.gradient->getGradientType();
+      return _api_raster.gradient.create[gradientType](pc,
+        engine->ctx.target.format,
+        &engine->metaClipBoxI,
+        &engine->source.gradient,
+        &engine->source.adjusted,
+        quality);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+      return ERR_RT_NOT_IMPLEMENTED;
+  }
+}
+
+//! @internal
+//!
+//! @brief Get the image or gradient quality used by the current source.
+static FOG_INLINE uint32_t RasterPaintEngine_getPatternQuality(RasterPaintEngine* engine)
+{
+  if (engine->sourceType == RASTER_SOURCE_TEXTURE)
+    return engine->ctx.paintHints.imageQuality;
+  else
+    return engine->ctx.paintHints.gradientQuality;
+}
+
+//! @internal
+//!
+//! @brief Release the @ref RasterSharedPattern attached to @ref PatternData,
+//! registered as @c fog_api.pattern_releaseEngineCache.
+static void FOG_CDECL RasterPaintEngine_releasePatternCache(void* cache)
+{
+  static_cast<RasterSharedPattern*>(cache)->release();
+}
+
 err_t RasterPaintEngine::createPatternContext()
 {
   FOG_ASSERT(sourceType != RASTER_SOURCE_NONE);
   FOG_ASSERT(sourceType != RASTER_SOURCE_ARGB32);
   FOG_ASSERT(sourceType != RASTER_SOURCE_COLOR);
 
-  err_t err = ERR_RT_NOT_IMPLEMENTED;
-
   // First try to reuse context from context-pool.
   RasterPattern* pc = reinterpret_cast<RasterPattern*>(pcPool);
 
@@ -5890,53 +7540,64 @@ err_t RasterPaintEngine::createPatternContext()
 
   ctx.pc = pc;
 
-  // Set reference count to 1 and initialize the context state to UNINITIALIZED.
-  // It's important to mark context as uninitialized, because there are asserts
-  // inside pattern-context initializers and leaving the pattern-context state
-  // as is might cause crash in debug-mode.
   pc->_reference.set(1);
-  pc->reset();
+  pc->_isShared = 0;
 
-  switch (sourceType)
+  err_t err = RasterPaintEngine_initPatternContext(this, pc, RasterPaintEngine_getPatternQuality(this));
+  if (FOG_IS_ERROR(err))
   {
-    case RASTER_SOURCE_TEXTURE:
-    {
-      err = _api_raster.texture.create(pc,
-        ctx.target.format,
-        &metaClipBoxI,
-        &source.texture->_image,
-        &source.texture->_fragment,
-        &source.adjusted,
-        &source.texture->_clampColor,
-        source.texture->getTileType(),
-        ctx.paintHints.imageQuality);
-      break;
-    }
+    reinterpret_cast<RasterAbstractLinkedList*>(pc)->next = pcPool;
+    pcPool = reinterpret_cast<RasterAbstractLinkedList*>(pc);
+    ctx.pc = NULL;
+  }
 
-    case RASTER_SOURCE_GRADIENT:
-    {
-      uint32_t gradientType = source.gradient->getGradientType();
-      err = _api_raster.gradient.create[gradientType](pc,
-        ctx.target.format,
-        &metaClipBoxI,
-        &source.gradient,
-        &source.adjusted,
-        ctx.paintHints.gradientQuality);
-      break;
-    }
+  return err;
+}
 
-    default:
-      FOG_ASSERT_NOT_REACHED();
+err_t RasterPaintEngine::createSharedPatternContext(PatternData* d)
+{
+  FOG_ASSERT(sourceType == RASTER_SOURCE_TEXTURE ||
+             sourceType == RASTER_SOURCE_GRADIENT);
+  FOG_ASSERT(ctx.pc == NULL);
+
+  uint32_t quality = RasterPaintEngine_getPatternQuality(this);
+
+  // The attached context is released only when the pattern data is modified
+  // or destroyed, the engine never releases or replaces it, so it's safe to
+  // use it here.
+  RasterSharedPattern* pc = static_cast<RasterSharedPattern*>(d->engineCache);
+  if (pc != NULL && pc->eqKey(ctx.target.format, quality, source.adjusted))
+  {
+    pc->_reference.inc();
+    ctx.pc = pc;
+    return ERR_OK;
   }
 
+  pc = reinterpret_cast<RasterSharedPattern*>(MemMgr::alloc(sizeof(RasterSharedPattern)));
+  if (FOG_IS_NULL(pc))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  pc->_isShared = 1;
+  pc->initKey(ctx.target.format, quality, source.adjusted);
+
+  err_t err = RasterPaintEngine_initPatternContext(this, pc, quality);
   if (FOG_IS_ERROR(err))
   {
-    reinterpret_cast<RasterAbstractLinkedList*>(pc)->next = pcPool;
-    pcPool = reinterpret_cast<RasterAbstractLinkedList*>(pc);
-    ctx.pc = NULL;
+    MemMgr::free(pc);
+    return err;
   }
 
-  return err;
+  // One reference is held by the paint engine and one by the pattern data.
+  // The context can be attached only to an empty slot, if there is already
+  // another context (different key or a race with other engine) then the new
+  // one stays private to this engine.
+  pc->_reference.init(2);
+  ctx.pc = pc;
+
+  if (!AtomicCore<void*>::cmpXchg(&d->engineCache, (void*)NULL, (void*)pc))
+    pc->_reference.dec();
+
+  return ERR_OK;
 }
 
 // ============================================================================
@@ -5961,6 +7622,7 @@ void RasterPaintEngine::changedMetaParams()
     ctx.clipType = RASTER_CLIP_BOX;
     ctx.clipBoxI.reset();
     ctx.clipRegion.clear();
+    ctx.resetClipMask();
   }
   else
   {
@@ -5983,6 +7645,8 @@ void RasterPaintEngine::changedMetaParams()
       ctx.clipBoxI = metaClipBoxI;
       ctx.clipRegion.clear();
     }
+
+    ctx.resetClipMask();
   }
 
   metaTransformD._type = (metaOrigin.x | metaOrigin.y) == 0 
@@ -6280,6 +7944,7 @@ FOG_CPU_DECLARE_INITIALIZER_SSE2( RasterPaintEngine_init_SSE2(void) )
 
 void FOG_NO_EXPORT RasterPaintDoRender_init(void);
 void FOG_NO_EXPORT RasterPaintDoGroup_init(void);
+void FOG_NO_EXPORT RasterPaintDoRenderMT_init(void);
 
 template<int _PRECISION>
 static void RasterPaintEngine_init_vtable_t()
@@ -6422,6 +8087,9 @@ static void RasterPaintEngine_init_vtable_t()
   v->blitMaskedImageInF = RasterPaintEngine_blitMaskedImageInF;
   v->blitMaskedImageInD = RasterPaintEngine_blitMaskedImageInD;
 
+  v->blitImagesI = RasterPaintEngine_blitImagesI;
+  v->blitImagesF = RasterPaintEngine_blitImagesF;
+
   // --------------------------------------------------------------------------
   // [Filter]
   // --------------------------------------------------------------------------
@@ -6507,6 +8175,12 @@ FOG_NO_EXPORT void RasterPaintEngine_init(void)
   fog_api.painter_switchToImage = RasterPaintEngine_switchToImage;
   fog_api.painter_switchToIBits = RasterPaintEngine_switchToIBits;
 
+  // --------------------------------------------------------------------------
+  // [Pattern - API]
+  // --------------------------------------------------------------------------
+
+  fog_api.pattern_releaseEngineCache = RasterPaintEngine_releasePatternCache;
+
   // --------------------------------------------------------------------------
   // [RasterPaintEngine - Init]
   // --------------------------------------------------------------------------
@@ -6514,6 +8188,7 @@ FOG_NO_EXPORT void RasterPaintEngine_init(void)
   RasterPaintEngine_init_vtable();
   RasterPaintDoRender_init();
   RasterPaintDoGroup_init();
+  RasterPaintDoRenderMT_init();
 
   // --------------------------------------------------------------------------
   // [RasterPaintEngine - CPU Based Optimizations]
@@ -24,6 +24,7 @@
 #include <Fog/G2d/Painting/Painter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
 #include <Fog/G2d/Painting/RasterPaintCmd_p.h>
 #include <Fog/G2d/Painting/RasterPaintContext_p.h>
 #include <Fog/G2d/Painting/RasterPaintEngine_p.h>
@@ -54,7 +55,14 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_processPendingFlags(RasterPaintEngi
 
   if (pending & RASTER_PENDING_SOURCE)
   {
-    if (RasterUtil::isSolidContext(engine->ctx.pc))
+    if (RasterUtil::isSolidContext(engine->ctx.pc) && engine->ctx.precision == IMAGE_PRECISION_WORD)
+    {
+      RasterPaintCmd_SetOpacityAndPrgb64* cmd = engine->newCmd<RasterPaintCmd_SetOpacityAndPrgb64>();
+      if (FOG_IS_NULL(cmd))
+        return ERR_RT_OUT_OF_MEMORY;
+      cmd->init(engine, RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64, engine->ctx.rasterHints.opacity, engine->ctx.solid.prgb64);
+    }
+    else if (RasterUtil::isSolidContext(engine->ctx.pc))
     {
       RasterPaintCmd_SetOpacityAndPrgb32* cmd = engine->newCmd<RasterPaintCmd_SetOpacityAndPrgb32>();
       if (FOG_IS_NULL(cmd))
@@ -63,7 +71,7 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_processPendingFlags(RasterPaintEngi
     }
     else
     {
-      _FOG_RASTER_ENSURE_PATTERN(engine);
+      _FOG_RASTER_ENSURE_PATTERN((&engine->ctx));
 
       RasterPaintCmd_SetOpacityAndPattern* cmd = engine->newCmd<RasterPaintCmd_SetOpacityAndPattern>();
       if (FOG_IS_NULL(cmd))
@@ -102,6 +110,13 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_processPendingFlags(RasterPaintEngi
         return ERR_RT_OUT_OF_MEMORY;
       cmd->init(engine, RASTER_PAINT_CMD_SET_CLIP_BOX, engine->ctx.clipBoxI);
     }
+    else if (clipType == RASTER_CLIP_MASK)
+    {
+      RasterPaintCmd_SetClipMask* cmd = engine->newCmd<RasterPaintCmd_SetClipMask>();
+      if (FOG_IS_NULL(cmd))
+        return ERR_RT_OUT_OF_MEMORY;
+      cmd->init(engine, RASTER_PAINT_CMD_SET_CLIP_MASK, engine->ctx.clipMask);
+    }
     else
     {
       RasterPaintCmd_SetClipRegion* cmd = engine->newCmd<RasterPaintCmd_SetClipRegion>();
@@ -175,8 +190,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_processPendingFlags(RasterPaintEngi
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillAll(
-  RasterPaintEngine* engine)
+  RasterPaintContext* ctx)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_FILL_NORMALIZED_BOX();
 
   RasterPaintCmd_FillAll* cmd = engine->newCmd<RasterPaintCmd_FillAll>();
@@ -194,8 +211,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillAll(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxI(
-  RasterPaintEngine* engine, const BoxI* box)
+  RasterPaintContext* ctx, const BoxI* box)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_FILL_NORMALIZED_BOX();
 
   RasterPaintCmd_FillNormalizedBoxI* cmd = engine->newCmd<RasterPaintCmd_FillNormalizedBoxI>();
@@ -208,8 +227,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxI(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxF(
-  RasterPaintEngine* engine, const BoxF* box)
+  RasterPaintContext* ctx, const BoxF* box)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_FILL_NORMALIZED_BOX();
 
   RasterPaintCmd_FillNormalizedBoxF* cmd = engine->newCmd<RasterPaintCmd_FillNormalizedBoxF>();
@@ -226,8 +247,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxD(
-  RasterPaintEngine* engine, const BoxD* box)
+  RasterPaintContext* ctx, const BoxD* box)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_FILL_NORMALIZED_BOX();
 
   RasterPaintCmd_FillNormalizedBoxD* cmd = engine->newCmd<RasterPaintCmd_FillNormalizedBoxD>();
@@ -248,8 +271,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedBoxD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathF(
-  RasterPaintEngine* engine, const PathF* path, const PointF* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   BoxF boundingBox;
   FOG_RETURN_ON_ERROR(path->getBoundingBox(boundingBox));
 
@@ -270,8 +295,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathD(
-  RasterPaintEngine* engine, const PathD* path, const PointD* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   BoxD boundingBox;
   FOG_RETURN_ON_ERROR(path->getBoundingBox(boundingBox));
 
@@ -291,13 +318,117 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedPathD(
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Fill - NormalizedMaskA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_fillNormalizedMaskA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* mask, const RectI* maskFragment)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  _SERIALIZE_PENDING_FLAGS_FILL_NORMALIZED_BOX();
+
+  RasterPaintCmd_FillNormalizedMaskA* cmd = engine->newCmd<RasterPaintCmd_FillNormalizedMaskA>();
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A,
+    *pt, *mask, *maskFragment);
+
+  engine->curGroup->mergeBoundingBox(
+    pt->x,
+    pt->y,
+    pt->x + maskFragment->w,
+    pt->y + maskFragment->h);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Stroke - HairlinePath]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_strokeHairlinePathF(
+  RasterPaintContext* ctx, const PathF* path, const RasterHairline* hairline)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  BoxF boundingBox;
+  FOG_RETURN_ON_ERROR(path->getBoundingBox(boundingBox));
+  boundingBox.expand(float(hairline->lineWidth * 0.5 + 1.0));
+
+  _SERIALIZE_PENDING_FLAGS_FILL();
+
+  RasterPaintCmd_StrokeHairlinePathF* cmd = engine->newCmd<RasterPaintCmd_StrokeHairlinePathF>();
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+  cmd->init(engine, RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F,
+    *path, *hairline);
+
+  engine->curGroup->mergeBoundingBox(
+    Math::ifloor(boundingBox.x0),
+    Math::ifloor(boundingBox.y0),
+    Math::iceil(boundingBox.x1),
+    Math::iceil(boundingBox.y1));
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_strokeHairlinePathD(
+  RasterPaintContext* ctx, const PathD* path, const RasterHairline* hairline)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  BoxD boundingBox;
+  FOG_RETURN_ON_ERROR(path->getBoundingBox(boundingBox));
+  boundingBox.expand(double(hairline->lineWidth * 0.5 + 1.0));
+
+  _SERIALIZE_PENDING_FLAGS_FILL();
+
+  RasterPaintCmd_StrokeHairlinePathD* cmd = engine->newCmd<RasterPaintCmd_StrokeHairlinePathD>();
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+  cmd->init(engine, RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D,
+    *path, *hairline);
+
+  engine->curGroup->mergeBoundingBox(
+    Math::ifloor(boundingBox.x0),
+    Math::ifloor(boundingBox.y0),
+    Math::iceil(boundingBox.x1),
+    Math::iceil(boundingBox.y1));
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Fill - Coverage]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_fillCoverage(
+  RasterPaintContext* ctx, const RasterCoverage* coverage)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  if (!coverage->boundingBox.isValid())
+    return ERR_OK;
+
+  _SERIALIZE_PENDING_FLAGS_FILL();
+
+  RasterPaintCmd_FillCoverage* cmd = engine->newCmd<RasterPaintCmd_FillCoverage>();
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_COVERAGE, coverage);
+
+  engine->curGroup->mergeBoundingBox(coverage->boundingBox);
+  return ERR_OK;
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoGroup - Blit - Image]
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_blitImageD(
-  RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_BLIT();
 
   // TODO: Raster paint-engine.
@@ -309,8 +440,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitImageD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageA(
-  RasterPaintEngine* engine, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_BLIT();
 
   ImageData* srcD = srcImage->_d;
@@ -354,8 +487,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageA(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageI(
-  RasterPaintEngine* engine, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_BLIT();
 
   RasterPaintCmd_BlitNormalizedImageI* cmd =
@@ -372,8 +507,10 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageI(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageD(
-  RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
+  RasterPaintEngine* engine = ctx->engine;
+
   _SERIALIZE_PENDING_FLAGS_BLIT();
 
   RasterPaintCmd_BlitNormalizedImageD* cmd =
@@ -393,26 +530,88 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedImageD(
   return ERR_OK;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Blit - NormalizedMaskedImageA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedMaskedImageA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment, const Image* mask, const RectI* maskFragment)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  _SERIALIZE_PENDING_FLAGS_BLIT();
+
+  RasterPaintCmd_BlitNormalizedMaskedImageA* cmd =
+    engine->newCmd<RasterPaintCmd_BlitNormalizedMaskedImageA>();
+
+  if (FOG_IS_NULL(cmd))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A,
+    *pt, *srcImage, *srcFragment, *mask, *maskFragment);
+
+  engine->curGroup->mergeBoundingBox(
+    pt->x,
+    pt->y,
+    pt->x + srcFragment->w,
+    pt->y + srcFragment->h);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoGroup - Blit - NormalizedSpritesA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_blitNormalizedSpritesA(
+  RasterPaintContext* ctx, const Image* srcImage, const RasterSprite* sprites, size_t count)
+{
+  RasterPaintEngine* engine = ctx->engine;
+
+  uint32_t opacity = ctx->rasterHints.opacity;
+  err_t err = ERR_OK;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (ctx->rasterHints.opacity != sprites[i].opacity)
+    {
+      ctx->rasterHints.opacity = sprites[i].opacity;
+      engine->masterFlags |= RASTER_PENDING_OPACITY;
+    }
+
+    err = RasterPaintDoGroup_blitNormalizedImageA(ctx, &sprites[i].pt, srcImage, &sprites[i].srcFragment);
+    if (FOG_IS_ERROR(err))
+      break;
+  }
+
+  if (ctx->rasterHints.opacity != opacity)
+  {
+    ctx->rasterHints.opacity = opacity;
+    engine->masterFlags |= RASTER_PENDING_OPACITY;
+  }
+
+  return err;
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoGroup - Filter - NormalizedBox]
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedBoxI(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxI* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxI* box)
 {
   // TODO: Raster paint-engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedBoxF(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxF* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxF* box)
 {
   // TODO: Raster paint-engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedBoxD(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxD* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxD* box)
 {
   // TODO: Raster paint-engine.
   return ERR_RT_NOT_IMPLEMENTED;
@@ -423,14 +622,14 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedBoxD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedPathF(
-  RasterPaintEngine* engine, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
   // TODO: Raster paint-engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedPathD(
-  RasterPaintEngine* engine, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
   // TODO: Raster paint-engine.
   return ERR_RT_NOT_IMPLEMENTED;
@@ -440,13 +639,13 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_filterNormalizedPathD(
 // [Fog::RasterPaintDoGroup - SwitchToMask / DiscardMask]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_switchToMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoGroup_switchToMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_discardMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoGroup_discardMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
@@ -456,13 +655,13 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_discardMask(RasterPaintEngine* engi
 // [Fog::RasterPaintDoGroup - SaveMask / RestoreMask]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_saveMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoGroup_saveMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_restoreMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoGroup_restoreMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
@@ -472,38 +671,36 @@ static err_t FOG_FASTCALL RasterPaintDoGroup_restoreMask(RasterPaintEngine* engi
 // [Fog::RasterPaintDoGroup - MaskNormalizedBox]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxI(RasterPaintEngine* engine, uint32_t clipOp, const BoxI* box)
+// The clip-mask is built in the master context and serialized by the pending
+// clip, it's the same as in the single-threaded rendering.
+
+static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxI(RasterPaintContext* ctx, uint32_t clipOp, const BoxI* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].maskNormalizedBoxI(ctx, clipOp, box);
 }
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxF(RasterPaintEngine* engine, uint32_t clipOp, const BoxF* box)
+static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxF(RasterPaintContext* ctx, uint32_t clipOp, const BoxF* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].maskNormalizedBoxF(ctx, clipOp, box);
 }
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxD(RasterPaintEngine* engine, uint32_t clipOp, const BoxD* box)
+static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedBoxD(RasterPaintContext* ctx, uint32_t clipOp, const BoxD* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].maskNormalizedBoxD(ctx, clipOp, box);
 }
 
 // ============================================================================
 // [Fog::RasterPaintDoGroup - MaskNormalizedPath]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedPathF(RasterPaintEngine* engine, uint32_t clipOp, const PathF* path, uint32_t fillRule)
+static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedPathF(RasterPaintContext* ctx, uint32_t clipOp, const PathF* path, uint32_t fillRule)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].maskNormalizedPathF(ctx, clipOp, path, fillRule);
 }
 
-static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedPathD(RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule)
+static err_t FOG_FASTCALL RasterPaintDoGroup_maskNormalizedPathD(RasterPaintContext* ctx, uint32_t clipOp, const PathD* path, uint32_t fillRule)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].maskNormalizedPathD(ctx, clipOp, path, fillRule);
 }
 
 // ============================================================================
@@ -524,6 +721,10 @@ void FOG_NO_EXPORT RasterPaintDoGroup_init(void)
   v->fillNormalizedBoxD = RasterPaintDoGroup_fillNormalizedBoxD;
   v->fillNormalizedPathF = RasterPaintDoGroup_fillNormalizedPathF;
   v->fillNormalizedPathD = RasterPaintDoGroup_fillNormalizedPathD;
+  v->fillNormalizedMaskA = RasterPaintDoGroup_fillNormalizedMaskA;
+  v->strokeHairlinePathF = RasterPaintDoGroup_strokeHairlinePathF;
+  v->strokeHairlinePathD = RasterPaintDoGroup_strokeHairlinePathD;
+  v->fillCoverage = RasterPaintDoGroup_fillCoverage;
 
   // --------------------------------------------------------------------------
   // [Blit]
@@ -533,6 +734,8 @@ void FOG_NO_EXPORT RasterPaintDoGroup_init(void)
   v->blitNormalizedImageA = RasterPaintDoGroup_blitNormalizedImageA;
   v->blitNormalizedImageI = RasterPaintDoGroup_blitNormalizedImageI;
   v->blitNormalizedImageD = RasterPaintDoGroup_blitNormalizedImageD;
+  v->blitNormalizedMaskedImageA = RasterPaintDoGroup_blitNormalizedMaskedImageA;
+  v->blitNormalizedSpritesA = RasterPaintDoGroup_blitNormalizedSpritesA;
 
   // --------------------------------------------------------------------------
   // [Filter]
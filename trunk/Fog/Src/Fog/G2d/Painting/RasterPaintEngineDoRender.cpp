@@ -24,6 +24,7 @@
 #include <Fog/G2d/Imaging/Filters/FeBase.h>
 #include <Fog/G2d/Painting/Painter.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterClipMask_p.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
 #include <Fog/G2d/Painting/RasterPaintContext_p.h>
 #include <Fog/G2d/Painting/RasterPaintEngine_p.h>
@@ -64,6 +65,7 @@ struct FOG_NO_EXPORT RasterPaintFiller : public RasterFiller
   struct _VBlit
   {
     RasterVBlitSpanFunc blit;
+    RasterPatternFusedFunc fused;
     RasterClosure* closure;
     RasterPattern* pc;
     MemBuffer* pb;
@@ -152,6 +154,16 @@ static void FOG_FASTCALL RasterPaintFiller_process_pattern(RasterPaintFiller* se
   self->dstPixels += self->dstStride;
 }
 
+static void FOG_FASTCALL RasterPaintFiller_process_pattern_fused(RasterPaintFiller* self, RasterSpan8* spans)
+{
+#if defined(FOG_DEBUG)
+  RasterUtil::validateSpans<RasterSpan8>(spans, self->ctx->clipBoxI.x0, self->ctx->clipBoxI.x1);
+#endif // FOG_DEBUG
+
+  self->v.fused(&self->v.pf, self->dstPixels, spans, self->v.closure);
+  self->dstPixels += self->dstStride;
+}
+
 static void FOG_FASTCALL RasterPaintFiller_skip_pattern(RasterPaintFiller* self, int step)
 {
   self->dstPixels += self->dstStride * step;
@@ -210,26 +222,40 @@ static void FOG_FASTCALL RasterPaintFiller_skip_filter(RasterPaintFiller* self,
   self->f.srcPixels += self->f.srcStride * step;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoRender - IsSolidOpaque]
+// ============================================================================
+
+static bool FOG_INLINE RasterPaintDoRender_isSolidOpaque(const RasterPaintContext* ctx)
+{
+  // The 'prgb32' member is not initialized when painting to 16-bit target.
+  if (ctx->precision == IMAGE_PRECISION_WORD)
+    return Acc::p64PRGB64IsAlphaFFFF(ctx->solid.prgb64.p64);
+  else
+    return Acc::p32PRGB32IsAlphaFF(ctx->solid.prgb32.u32);
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoRender - PrepareRasterizer]
 // ============================================================================
 
-static void FOG_INLINE RasterPaintDoRender_prepareRasterizer(RasterPaintEngine* engine, Rasterizer8* rasterizer)
+static void FOG_INLINE RasterPaintDoRender_prepareRasterizer(RasterPaintContext* ctx, Rasterizer8* rasterizer)
 {
-  rasterizer->setSceneBox(engine->ctx.clipBoxI);
-  rasterizer->setOpacity(engine->ctx.rasterHints.opacity);
+  rasterizer->setSceneBox(ctx->clipBoxI);
+  rasterizer->setOpacity(ctx->rasterHints.opacity);
 
-  switch (engine->ctx.clipType)
+  switch (ctx->clipType)
   {
     case RASTER_CLIP_BOX:
       break;
 
     case RASTER_CLIP_REGION:
-      rasterizer->setClipRegion(engine->ctx.clipRegion.getData(), engine->ctx.clipRegion.getLength());
+      rasterizer->setClipRegion(ctx->clipRegion.getData(), ctx->clipRegion.getLength());
       break;
 
     case RASTER_CLIP_MASK:
-      // TODO: RasterPaintEngine - clip-mask.
+      rasterizer->setClipMask(ctx->clipBoxI.y0, ctx->clipBoxI.y1,
+        ctx->clipMask->getRows(), &ctx->maskScanline8);
       break;
 
     default:
@@ -237,44 +263,67 @@ static void FOG_INLINE RasterPaintDoRender_prepareRasterizer(RasterPaintEngine*
   }
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoRender - PrepareMaskRasterizer]
+// ============================================================================
+
+static void FOG_INLINE RasterPaintDoRender_prepareMaskRasterizer(RasterPaintContext* ctx, Rasterizer8* rasterizer, uint32_t clipOp)
+{
+  if (clipOp == CLIP_OP_INTERSECT)
+  {
+    RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
+  }
+  else
+  {
+    RasterPaintEngine* engine = ctx->engine;
+
+    rasterizer->setSceneBox(engine->metaClipBoxI);
+    if (engine->metaRegion.getLength() > 1)
+      rasterizer->setClipRegion(engine->metaRegion.getData(), engine->metaRegion.getLength());
+  }
+
+  // The clip-mask is never affected by opacity.
+  rasterizer->setOpacity(0x100);
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoRender - FillRasterizedShape]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_fillRasterizedShape8(RasterPaintEngine* engine, Rasterizer8* rasterizer)
+static err_t FOG_FASTCALL RasterPaintDoRender_fillRasterizedShape8(RasterPaintContext* ctx, Rasterizer8* rasterizer)
 {
   RasterPaintFiller filler;
 
-  uint8_t* dstPixels = engine->ctx.target.pixels;
-  ssize_t dstStride = engine->ctx.target.stride;
-  uint32_t dstFormat = engine->ctx.target.format;
-  uint32_t compositingOperator = engine->ctx.paintHints.compositingOperator;
+  uint8_t* dstPixels = ctx->target.pixels;
+  ssize_t dstStride = ctx->target.stride;
+  uint32_t dstFormat = ctx->target.format;
+  uint32_t compositingOperator = ctx->paintHints.compositingOperator;
 
-  filler.ctx = &engine->ctx;
+  filler.ctx = ctx;
   filler.dstPixels = dstPixels;
   filler.dstStride = dstStride;
 
-  if (RasterUtil::isSolidContext(engine->ctx.pc) || compositingOperator == COMPOSITE_CLEAR)
+  if (RasterUtil::isSolidContext(ctx->pc) || compositingOperator == COMPOSITE_CLEAR)
   {
 _Solid:
-    bool isSrcOpaque = Acc::p32PRGB32IsAlphaFF(engine->ctx.solid.prgb32.u32);
+    bool isSrcOpaque = RasterPaintDoRender_isSolidOpaque(ctx);
 
     filler._prepare = (RasterFiller::PrepareFunc)RasterPaintFiller_prepare_solid_st;
     filler._process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_solid;
     filler._skip = (RasterFiller::SkipFunc)RasterPaintFiller_skip_solid;
 
     filler.c.blit = _api_raster.getCBlitSpan(dstFormat, compositingOperator, isSrcOpaque);
-    filler.c.closure = &engine->ctx.closure;
-    filler.c.solid = &engine->ctx.solid;
+    filler.c.closure = &ctx->closure;
+    filler.c.solid = &ctx->solid;
 
-    rasterizer->render(&filler, &engine->ctx.scanline8);
+    rasterizer->render(&filler, &ctx->scanline8);
   }
   else
   {
-    _FOG_RASTER_ENSURE_PATTERN(engine);
+    _FOG_RASTER_ENSURE_PATTERN(ctx);
 
-    uint32_t srcFormat = engine->ctx.pc->getSrcFormat();
-    compositingOperator = RasterUtil::getCompositeModifiedOperator(dstFormat, compositingOperator, engine->ctx.pc->isOpaque());
+    uint32_t srcFormat = ctx->pc->getSrcFormat();
+    compositingOperator = RasterUtil::getCompositeModifiedOperator(dstFormat, compositingOperator, ctx->pc->isOpaque());
 
     if (compositingOperator == COMPOSITE_CLEAR)
       goto _Solid;
@@ -283,47 +332,44 @@ _Solid:
     filler._process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_pattern;
     filler._skip = (RasterFiller::SkipFunc)RasterPaintFiller_skip_pattern;
 
+    // Use the fused fetch-and-composite function if available, the pattern
+    // is then composited without the intermediate buffer.
+    filler.v.fused = ctx->pc->getFusedFunc(compositingOperator);
+    if (filler.v.fused != NULL)
+      filler._process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_pattern_fused;
+
     filler.v.blit = _api_raster.getVBlitSpan(dstFormat, compositingOperator, srcFormat);
-    filler.v.closure = &engine->ctx.closure;
-    filler.v.pc = engine->ctx.pc;
-    filler.v.pb = &engine->ctx.buffer;
+    filler.v.closure = &ctx->closure;
+    filler.v.pc = ctx->pc;
+    filler.v.pb = &ctx->buffer;
 
-    rasterizer->render(&filler, &engine->ctx.scanline8);
+    rasterizer->render(&filler, &ctx->scanline8);
   }
 
   return ERR_OK;
 }
 
-// ============================================================================
-// [Fog::RasterPaintDoRender - FillAll]
-// ============================================================================
-
-static err_t FOG_FASTCALL RasterPaintDoRender_fillAll(
-  RasterPaintEngine* engine)
-{
-  return engine->doCmd->fillNormalizedBoxI(engine, &engine->ctx.clipBoxI);
-}
-
 // ============================================================================
 // [Fog::RasterPaintDoRender - FillNormalizedBox]
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxI(
-  RasterPaintEngine* engine, const BoxI* box)
+  RasterPaintContext* ctx, const BoxI* box)
 {
   FOG_ASSERT(box->isValid());
 
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
       // Fast-path (clip-box and full-opacity).
-      if (engine->ctx.rasterHints.opacity == 0x100 && engine->ctx.clipType == RASTER_CLIP_BOX)
+      if (ctx->rasterHints.opacity == 0x100 && ctx->clipType == RASTER_CLIP_BOX)
       {
-        uint8_t* dstPixels = engine->ctx.target.pixels;
-        ssize_t dstStride = engine->ctx.target.stride;
-        uint32_t dstFormat = engine->ctx.target.format;
-        uint32_t compositingOperator = engine->ctx.paintHints.compositingOperator;
+        uint8_t* dstPixels = ctx->target.pixels;
+        ssize_t dstStride = ctx->target.stride;
+        uint32_t dstFormat = ctx->target.format;
+        uint32_t compositingOperator = ctx->paintHints.compositingOperator;
 
         int y0 = box->y0;
 
@@ -332,23 +378,23 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxI(
 
         dstPixels += y0 * dstStride;
 
-        if (RasterUtil::isSolidContext(engine->ctx.pc) || compositingOperator == COMPOSITE_CLEAR)
+        if (RasterUtil::isSolidContext(ctx->pc) || compositingOperator == COMPOSITE_CLEAR)
         {
 _Solid:
-          bool isSrcOpaque = Acc::p32PRGB32IsAlphaFF(engine->ctx.solid.prgb32.u32);
+          bool isSrcOpaque = RasterPaintDoRender_isSolidOpaque(ctx);
           RasterCBlitLineFunc blitLine = _api_raster.getCBlitLine(dstFormat, compositingOperator, isSrcOpaque);
 
-          dstPixels += box->x0 * engine->ctx.target.bpp;
+          dstPixels += box->x0 * ctx->target.bpp;
           do {
-            blitLine(dstPixels, &engine->ctx.solid, w, &engine->ctx.closure);
+            blitLine(dstPixels, &ctx->solid, w, &ctx->closure);
             dstPixels += dstStride;
           } while (--i);
         }
         else
         {
-          _FOG_RASTER_ENSURE_PATTERN(engine);
+          _FOG_RASTER_ENSURE_PATTERN(ctx);
 
-          RasterPattern* pc = engine->ctx.pc;
+          RasterPattern* pc = ctx->pc;
           RasterPatternFetcher pf;
 
           uint32_t srcFormat = pc->getSrcFormat();
@@ -362,28 +408,39 @@ _Solid:
           span[0].setConstMask(0x100);
           span[0].setNext(NULL);
 
+          RasterPatternFusedFunc fused = pc->getFusedFunc(compositingOperator);
+
           if (RasterUtil::isCompositeCopyOp(dstFormat, srcFormat, compositingOperator))
           {
             pc->prepare(&pf, y0, 1, RASTER_FETCH_COPY);
 
-            dstPixels += box->x0 * engine->ctx.target.bpp;
+            dstPixels += box->x0 * ctx->target.bpp;
             do {
               pf.fetch(span, dstPixels);
               dstPixels += dstStride;
             } while (--i);
           }
+          else if (fused != NULL)
+          {
+            pc->prepare(&pf, y0, 1, RASTER_FETCH_REFERENCE);
+
+            do {
+              fused(&pf, dstPixels, span, &ctx->closure);
+              dstPixels += dstStride;
+            } while (--i);
+          }
           else
           {
             pc->prepare(&pf, y0, 1, RASTER_FETCH_REFERENCE);
 
             RasterVBlitLineFunc blitLine = _api_raster.getVBlitLine(dstFormat, compositingOperator, srcFormat);
-            uint8_t* srcPixels = reinterpret_cast<uint8_t*>(engine->ctx.buffer.getMem());
+            uint8_t* srcPixels = reinterpret_cast<uint8_t*>(ctx->buffer.getMem());
 
-            dstPixels += box->x0 * engine->ctx.target.bpp;
+            dstPixels += box->x0 * ctx->target.bpp;
 
             do {
               pf.fetch(span, srcPixels);
-              blitLine(dstPixels, span->getData(), w, &engine->ctx.closure);
+              blitLine(dstPixels, span->getData(), w, &ctx->closure);
               dstPixels += dstStride;
             } while (--i);
           }
@@ -392,20 +449,14 @@ _Solid:
       }
       else
       {
-        BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-        RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+        BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+        RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
         rasterizer->init32x0(*box);
-        return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
+        return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
       }
     }
 
-    case IMAGE_PRECISION_WORD:
-    {
-      // TODO: 16-bit image processing.
-      break;
-    }
-
     default:
       FOG_ASSERT_NOT_REACHED();
   }
@@ -415,11 +466,12 @@ _Solid:
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxF(
-  RasterPaintEngine* engine, const BoxF* box)
+  RasterPaintContext* ctx, const BoxF* box)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
       BoxI box24x8(UNINITIALIZED);
       box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
@@ -430,20 +482,14 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxF(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->fillNormalizedBoxI(engine, &boxI);
+        return RasterPaintDoRender_fillNormalizedBoxI(ctx, &boxI);
       }
 
-      BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->init24x8(box24x8);
-      return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
-    }
-
-    case IMAGE_PRECISION_WORD:
-    {
-      // TODO: 16-bit image processing.
-      break;
+      return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
     }
 
     default:
@@ -455,11 +501,12 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxD(
-  RasterPaintEngine* engine, const BoxD* box)
+  RasterPaintContext* ctx, const BoxD* box)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
       BoxI box24x8(UNINITIALIZED);
       box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
@@ -470,20 +517,14 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxD(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->fillNormalizedBoxI(engine, &boxI);
+        return RasterPaintDoRender_fillNormalizedBoxI(ctx, &boxI);
       }
 
-      BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->init24x8(box24x8);
-      return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
-    }
-
-    case IMAGE_PRECISION_WORD:
-    {
-      // TODO: 16-bit image processing.
-      break;
+      return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
     }
 
     default:
@@ -494,19 +535,30 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedBoxD(
   return ERR_RT_INVALID_STATE;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoRender - FillAll]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillAll(
+  RasterPaintContext* ctx)
+{
+  return RasterPaintDoRender_fillNormalizedBoxI(ctx, &ctx->clipBoxI);
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoRender - FillNormalizedPath]
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
-  RasterPaintEngine* engine, const PathF* path, const PointF* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
-      PathRasterizer8* rasterizer = &engine->ctx.pathRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->setFillRule(fillRule);
       if (FOG_IS_ERROR(rasterizer->init()))
@@ -516,17 +568,11 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
       rasterizer->finalize();
 
       if (rasterizer->isValid())
-        return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
+        return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
       else
         return ERR_OK;
     }
 
-    case IMAGE_PRECISION_WORD:
-    {
-      // TODO: 16-bit image processing.
-      break;
-    }
-
     default:
       FOG_ASSERT_NOT_REACHED();
   }
@@ -536,14 +582,15 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
-  RasterPaintEngine* engine, const PathD* path, const PointD* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
-      PathRasterizer8* rasterizer = &engine->ctx.pathRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->setFillRule(fillRule);
       if (FOG_IS_ERROR(rasterizer->init()))
@@ -553,15 +600,146 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
       rasterizer->finalize();
 
       if (rasterizer->isValid())
-        return RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
+        return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
       else
         return ERR_OK;
     }
 
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRender - FillNormalizedMaskA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedMaskA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* mask, const RectI* maskFragment)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
     case IMAGE_PRECISION_WORD:
     {
-      // TODO: 16-bit image processing.
-      break;
+      const ImageData* maskD = mask->_d;
+
+      BoxI box(pt->x, pt->y, pt->x + maskFragment->w, pt->y + maskFragment->h);
+      const uint8_t* maskPixels = maskD->first +
+        (ssize_t)maskFragment->y * maskD->stride +
+        (ssize_t)maskFragment->x * maskD->bytesPerPixel;
+
+      // Mask rows are converted directly into spans, there is no need to use
+      // the path rasterizer or the texture fetcher.
+      MaskRasterizer8 rasterizer;
+      RasterPaintDoRender_prepareRasterizer(ctx, &rasterizer);
+
+      rasterizer.init(box, maskPixels, maskD->stride, maskD->format);
+      return RasterPaintDoRender_fillRasterizedShape8(ctx, &rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRender - StrokeHairlinePath]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_strokeHairlinePathF(
+  RasterPaintContext* ctx, const PathF* path, const RasterHairline* hairline)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      HairlineRasterizer8* rasterizer = &ctx->hairlineRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
+
+      rasterizer->setLineWidth(hairline->lineWidth);
+      rasterizer->setLineCaps(hairline->startCap, hairline->endCap);
+      if (FOG_IS_ERROR(rasterizer->init()))
+        return rasterizer->getError();
+
+      rasterizer->addPath(*path, PointF(0.0f, 0.0f));
+      rasterizer->finalize();
+
+      if (rasterizer->isValid())
+        return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
+      else
+        return rasterizer->getError();
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_strokeHairlinePathD(
+  RasterPaintContext* ctx, const PathD* path, const RasterHairline* hairline)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      HairlineRasterizer8* rasterizer = &ctx->hairlineRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
+
+      rasterizer->setLineWidth(hairline->lineWidth);
+      rasterizer->setLineCaps(hairline->startCap, hairline->endCap);
+      if (FOG_IS_ERROR(rasterizer->init()))
+        return rasterizer->getError();
+
+      rasterizer->addPath(*path, PointD(0.0, 0.0));
+      rasterizer->finalize();
+
+      if (rasterizer->isValid())
+        return RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
+      else
+        return rasterizer->getError();
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRender - FillCoverage]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_fillCoverage(
+  RasterPaintContext* ctx, const RasterCoverage* coverage)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      // The cached coverage is converted directly into spans, the path is not
+      // rasterized again.
+      CoverageRasterizer8 rasterizer;
+      RasterPaintDoRender_prepareRasterizer(ctx, &rasterizer);
+
+      if (!rasterizer.init(coverage))
+        return ERR_OK;
+
+      return RasterPaintDoRender_fillRasterizedShape8(ctx, &rasterizer);
     }
 
     default:
@@ -577,39 +755,39 @@ static err_t FOG_FASTCALL RasterPaintDoRender_fillNormalizedPathD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_blitImageD(
-  RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
   BoxD boxClipped(*box);
-  engine->getFinalTransformD().mapBox(boxClipped, boxClipped);
+  ctx->engine->getFinalTransformD().mapBox(boxClipped, boxClipped);
 
-  if (!BoxD::intersect(boxClipped, boxClipped, engine->getClipBoxD()))
+  if (!BoxD::intersect(boxClipped, boxClipped, ctx->engine->getClipBoxD()))
     return ERR_OK;
 
-  RasterPattern* old = engine->ctx.pc;
+  RasterPattern* old = ctx->pc;
   RasterPattern pc;
 
   FOG_RETURN_ON_ERROR(
     _api_raster.texture.create(&pc,
-      engine->ctx.target.format,
-      &engine->metaClipBoxI,
+      ctx->target.format,
+      &ctx->engine->metaClipBoxI,
       srcImage, srcFragment,
-      srcTransform, &engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
+      srcTransform, &ctx->engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
   );
 
-  PathD* path = &engine->ctx.tmpPathD[0];
+  PathD* path = &ctx->tmpPathD[0];
   path->clear();
   path->box(*box);
 
-  PathClipperD clipper(engine->getClipBoxD());
+  PathClipperD clipper(ctx->engine->getClipBoxD());
   PathTmpD<32> tmp;
 
-  err_t err = clipper.clipBox(tmp, *box, engine->getFinalTransformD());
+  err_t err = clipper.clipBox(tmp, *box, ctx->engine->getFinalTransformD());
   if (err == ERR_OK)
   {
     PointD pt(0.0, 0.0);
-    engine->ctx.pc = &pc;
-    err = engine->doCmd->fillNormalizedPathD(engine, &tmp, &pt, FILL_RULE_NON_ZERO);
-    engine->ctx.pc = old;
+    ctx->pc = &pc;
+    err = RasterPaintDoRender_fillNormalizedPathD(ctx, &tmp, &pt, FILL_RULE_NON_ZERO);
+    ctx->pc = old;
   }
 
   pc.destroy();
@@ -621,26 +799,32 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitImageD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
-  RasterPaintEngine* engine, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
     {
       // Fast-path (clip-box and full-opacity).
-      if (engine->ctx.clipType == RASTER_CLIP_BOX)
+      if (ctx->clipType == RASTER_CLIP_BOX)
       {
-        uint8_t* pixels = engine->ctx.target.pixels;
-        ssize_t stride = engine->ctx.target.stride;
-        uint32_t format = engine->ctx.target.format;
+        uint8_t* pixels = ctx->target.pixels;
+        ssize_t stride = ctx->target.stride;
+        uint32_t format = ctx->target.format;
 
         const ImageData* srcD = srcImage->_d;
         const uint8_t* srcPixels = srcD->first;
         ssize_t srcStride = srcD->stride;
         uint32_t srcFormat = srcD->format;
 
-        uint32_t compositingOperator = engine->ctx.paintHints.compositingOperator;
-        uint32_t opacity = engine->ctx.rasterHints.opacity;
+        uint32_t compositingOperator = ctx->paintHints.compositingOperator;
+        uint32_t opacity = ctx->rasterHints.opacity;
+
+        // The opaque image is blitted using COMPOSITE_SRC instead of
+        // COMPOSITE_SRC_OVER, which is a simple copy in most cases.
+        compositingOperator = RasterUtil::getCompositeModifiedOperator(
+          format, compositingOperator, RasterUtil::isOpaqueImage(srcD));
 
         // --------------------------------------------------------------------------
         // [Clip == Box]
@@ -653,7 +837,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
         int y0 = pt->y;
 
         int i = srcHeight;
-        FOG_ASSERT(y0 + srcHeight <= engine->ctx.target.size.h);
+        FOG_ASSERT(y0 + srcHeight <= ctx->target.size.h);
 
         pixels += y0 * stride;
         srcPixels += srcFragment->y * srcStride;
@@ -662,11 +846,11 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
         {
           RasterVBlitLineFunc blitLine;
 
-          pixels += x0 * engine->ctx.target.bpp;
+          pixels += x0 * ctx->target.bpp;
           srcPixels += srcFragment->x * srcD->bytesPerPixel;
 
-          engine->ctx.closure.palette = srcD->palette->_d;
-          engine->ctx.closure.colorKey = srcD->colorKey;
+          ctx->closure.palette = srcD->palette->_d;
+          ctx->closure.colorKey = srcD->colorKey;
 
           // If compositing operator is SRC or SRC_OVER then any image format
           // combination is supported. However, if compositing operator is one
@@ -677,7 +861,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageA(
 
 _BlitImageA8_Opaque:
             do {
-              blitLine(pixels, srcPixels, srcWidth, &engine->ctx.closure);
+              blitLine(pixels, srcPixels, srcWidth, &ctx->closure);
 
               pixels += stride;
               srcPixels += srcStride;
@@ -692,20 +876,20 @@ _BlitImageA8_Opaque:
             if (srcFormat == vBlitSrc)
               goto _BlitImageA8_Opaque;
 
-            uint8_t* tmpPixels = reinterpret_cast<uint8_t*>(engine->ctx.buffer.getMem());
+            uint8_t* tmpPixels = reinterpret_cast<uint8_t*>(ctx->buffer.getMem());
             RasterVBlitLineFunc cvtLine = _api_raster.getCompositeCore(vBlitSrc, COMPOSITE_SRC)->vblit_line[srcFormat];
 
             do {
-              cvtLine(tmpPixels, srcPixels, srcWidth, &engine->ctx.closure);
-              blitLine(pixels, tmpPixels, srcWidth, &engine->ctx.closure);
+              cvtLine(tmpPixels, srcPixels, srcWidth, &ctx->closure);
+              blitLine(pixels, tmpPixels, srcWidth, &ctx->closure);
 
               pixels += stride;
               srcPixels += srcStride;
             } while (--i);
           }
 
-          engine->ctx.closure.palette = NULL;
-          engine->ctx.closure.colorKey = 0xFFFFFFFF;
+          ctx->closure.palette = NULL;
+          ctx->closure.colorKey = 0xFFFFFFFF;
         }
         else
         {
@@ -717,8 +901,8 @@ _BlitImageA8_Opaque:
           span[0].setNext(NULL);
           srcPixels += srcFragment->x * srcD->bytesPerPixel;
 
-          engine->ctx.closure.palette = srcD->palette->_d;
-          engine->ctx.closure.colorKey = srcD->colorKey;
+          ctx->closure.palette = srcD->palette->_d;
+          ctx->closure.colorKey = srcD->colorKey;
 
           // If compositing operator is SRC or SRC_OVER then any image format
           // combination is supported. However, if compositing operator is one
@@ -731,7 +915,7 @@ _BlitImageA8_Alpha:
             do {
               // SrcPixels won't be changed, it's just needed to remove the const modifier.
               span[0].setData(const_cast<uint8_t*>(srcPixels));
-              blitSpan(pixels, span, &engine->ctx.closure);
+              blitSpan(pixels, span, &ctx->closure);
 
               pixels += stride;
               srcPixels += srcStride;
@@ -746,57 +930,151 @@ _BlitImageA8_Alpha:
             if (srcFormat == vBlitSrc)
               goto _BlitImageA8_Alpha;
 
-            uint8_t* tmpPixels = reinterpret_cast<uint8_t*>(engine->ctx.buffer.getMem());
+            uint8_t* tmpPixels = reinterpret_cast<uint8_t*>(ctx->buffer.getMem());
             RasterVBlitLineFunc cvtLine = _api_raster.getCompositeCore(vBlitSrc, COMPOSITE_SRC)->vblit_line[srcFormat];
 
             span[0].setData(tmpPixels);
 
             do {
-              cvtLine(tmpPixels, srcPixels, srcWidth, &engine->ctx.closure);
-              blitSpan(pixels, span, &engine->ctx.closure);
+              cvtLine(tmpPixels, srcPixels, srcWidth, &ctx->closure);
+              blitSpan(pixels, span, &ctx->closure);
 
               pixels += stride;
               srcPixels += srcStride;
             } while (--i);
           }
 
-          engine->ctx.closure.palette = NULL;
-          engine->ctx.closure.colorKey = 0xFFFFFFFF;
+          ctx->closure.palette = NULL;
+          ctx->closure.colorKey = 0xFFFFFFFF;
         }
         return ERR_OK;
       }
       else
       {
-        BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-        RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+        BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+        RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
         BoxI box(pt->x, pt->y, pt->x + srcFragment->w, pt->y + srcFragment->h);
         rasterizer->init32x0(box);
 
-        RasterPattern* old = engine->ctx.pc;
+        RasterPattern* old = ctx->pc;
         RasterPattern pc;
 
         TransformD tr(TransformD::fromTranslation(PointD(*pt)));
         FOG_RETURN_ON_ERROR(
           _api_raster.texture.create(&pc,
-            engine->ctx.target.format,
-            &engine->metaClipBoxI,
+            ctx->target.format,
+            &ctx->engine->metaClipBoxI,
             srcImage, srcFragment,
-            &tr, &engine->dummyColor, TEXTURE_TILE_PAD, IMAGE_QUALITY_NEAREST)
+            &tr, &ctx->engine->dummyColor, TEXTURE_TILE_PAD, IMAGE_QUALITY_NEAREST)
         );
 
-        engine->ctx.pc = &pc;
-        err_t err = RasterPaintDoRender_fillRasterizedShape8(engine, rasterizer);
-        engine->ctx.pc = old;
+        ctx->pc = &pc;
+        err_t err = RasterPaintDoRender_fillRasterizedShape8(ctx, rasterizer);
+        ctx->pc = old;
 
         pc.destroy();
         return err;
       }
     }
 
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRender - BlitNormalizedSpritesA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedSpritesA(
+  RasterPaintContext* ctx, const Image* srcImage, const RasterSprite* sprites, size_t count)
+{
+  uint32_t compositingOperator = ctx->paintHints.compositingOperator;
+
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
     case IMAGE_PRECISION_WORD:
     {
-      // TODO: 16-bit image processing.
+      // Fast-path (clip-box and SRC or SRC_OVER operator). All sprites share
+      // the source image, so the blitters are fetched only once.
+      if (ctx->clipType == RASTER_CLIP_BOX && RasterUtil::isCompositeCoreOp(compositingOperator))
+      {
+        uint8_t* pixels = ctx->target.pixels;
+        ssize_t stride = ctx->target.stride;
+        uint32_t format = ctx->target.format;
+        uint32_t bpp = ctx->target.bpp;
+
+        const ImageData* srcD = srcImage->_d;
+        const uint8_t* srcPixels = srcD->first;
+        ssize_t srcStride = srcD->stride;
+        uint32_t srcFormat = srcD->format;
+        uint32_t srcBpp = srcD->bytesPerPixel;
+
+        // The opaque image is blitted using COMPOSITE_SRC.
+        compositingOperator = RasterUtil::getCompositeModifiedOperator(
+          format, compositingOperator, RasterUtil::isOpaqueImage(srcD));
+
+        const RasterCompositeCoreFuncs* funcs = _api_raster.getCompositeCore(format, compositingOperator);
+        RasterVBlitLineFunc blitLine = funcs->vblit_line[srcFormat];
+        RasterVBlitSpanFunc blitSpan = funcs->vblit_span[srcFormat];
+
+        RasterSpan8 span[1];
+        span[0].setNext(NULL);
+
+        ctx->closure.palette = srcD->palette->_d;
+        ctx->closure.colorKey = srcD->colorKey;
+
+        for (size_t i = 0; i < count; i++)
+        {
+          const RasterSprite& sprite = sprites[i];
+
+          int x0 = sprite.pt.x;
+          int y0 = sprite.pt.y;
+          int w = sprite.srcFragment.w;
+          int h = sprite.srcFragment.h;
+
+          FOG_ASSERT(y0 + h <= ctx->target.size.h);
+
+          uint8_t* dPixels = pixels + (ssize_t)y0 * stride + (ssize_t)x0 * bpp;
+          const uint8_t* sPixels = srcPixels + (ssize_t)sprite.srcFragment.y * srcStride +
+                                               (ssize_t)sprite.srcFragment.x * srcBpp;
+
+          if (sprite.opacity == ctx->fullOpacity.u)
+          {
+            do {
+              blitLine(dPixels, sPixels, w, &ctx->closure);
+
+              dPixels += stride;
+              sPixels += srcStride;
+            } while (--h);
+          }
+          else
+          {
+            dPixels -= (ssize_t)x0 * bpp;
+
+            span[0].setPositionAndType(x0, x0 + w, RASTER_SPAN_C);
+            span[0].setConstMask(sprite.opacity);
+
+            do {
+              // SrcPixels won't be changed, it's just needed to remove the const modifier.
+              span[0].setData(const_cast<uint8_t*>(sPixels));
+              blitSpan(dPixels, span, &ctx->closure);
+
+              dPixels += stride;
+              sPixels += srcStride;
+            } while (--h);
+          }
+        }
+
+        ctx->closure.palette = NULL;
+        ctx->closure.colorKey = 0xFFFFFFFF;
+        return ERR_OK;
+      }
       break;
     }
 
@@ -804,8 +1082,22 @@ _BlitImageA8_Alpha:
       FOG_ASSERT_NOT_REACHED();
   }
 
-  // Dead code to avoid warning.
-  return ERR_RT_INVALID_STATE;
+  // Clip-region or clip-mask, or other compositing operator than SRC and
+  // SRC_OVER, blit each sprite separately.
+  uint32_t opacity = ctx->rasterHints.opacity;
+  err_t err = ERR_OK;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    ctx->rasterHints.opacity = sprites[i].opacity;
+
+    err = RasterPaintDoRender_blitNormalizedImageA(ctx, &sprites[i].pt, srcImage, &sprites[i].srcFragment);
+    if (FOG_IS_ERROR(err))
+      break;
+  }
+
+  ctx->rasterHints.opacity = opacity;
+  return err;
 }
 
 // ============================================================================
@@ -813,68 +1105,171 @@ _BlitImageA8_Alpha:
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageI(
-  RasterPaintEngine* engine, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
   // Must be already clipped.
-  FOG_ASSERT(engine->ctx.clipBoxI.subsumes(*box));
+  FOG_ASSERT(ctx->clipBoxI.subsumes(*box));
 
-  RasterPattern* old = engine->ctx.pc;
+  RasterPattern* old = ctx->pc;
   RasterPattern pc;
 
   FOG_RETURN_ON_ERROR(
     _api_raster.texture.create(&pc,
-      engine->ctx.target.format,
-      &engine->metaClipBoxI,
+      ctx->target.format,
+      &ctx->engine->metaClipBoxI,
       srcImage, srcFragment,
-      srcTransform, &engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
+      srcTransform, &ctx->engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
   );
 
-  engine->ctx.pc = &pc;
-  err_t err = engine->doCmd->fillNormalizedBoxI(engine, box);
-  engine->ctx.pc = old;
+  ctx->pc = &pc;
+  err_t err = RasterPaintDoRender_fillNormalizedBoxI(ctx, box);
+  ctx->pc = old;
 
   pc.destroy();
   return err;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedImageD(
-  RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
 {
   // Must be already clipped.
-  FOG_ASSERT(engine->getClipBoxD().subsumes(*box));
+  FOG_ASSERT(ctx->engine->getClipBoxD().subsumes(*box));
 
-  RasterPattern* old = engine->ctx.pc;
+  RasterPattern* old = ctx->pc;
   RasterPattern pc;
 
   FOG_RETURN_ON_ERROR(
     _api_raster.texture.create(&pc,
-      engine->ctx.target.format,
-      &engine->metaClipBoxI,
+      ctx->target.format,
+      &ctx->engine->metaClipBoxI,
       srcImage, srcFragment,
-      srcTransform, &engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
+      srcTransform, &ctx->engine->dummyColor, TEXTURE_TILE_PAD, imageQuality)
   );
 
-  engine->ctx.pc = &pc;
-  err_t err = engine->doCmd->fillNormalizedBoxD(engine, box);
-  engine->ctx.pc = old;
+  ctx->pc = &pc;
+  err_t err = RasterPaintDoRender_fillNormalizedBoxD(ctx, box);
+  ctx->pc = old;
 
   pc.destroy();
   return err;
 }
 
+// ============================================================================
+// [Fog::RasterPaintDoRender - BlitNormalizedMaskedImageA]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_blitNormalizedMaskedImageA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment, const Image* mask, const RectI* maskFragment)
+{
+  // Must be already clipped, fragments have to be the same size.
+  FOG_ASSERT(srcFragment->w == maskFragment->w);
+  FOG_ASSERT(srcFragment->h == maskFragment->h);
+
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      const ImageData* srcD = srcImage->_d;
+      const ImageData* maskD = mask->_d;
+
+      uint32_t dstFormat = ctx->target.format;
+      uint32_t srcFormat = srcD->format;
+      uint32_t compositingOperator = ctx->paintHints.compositingOperator;
+
+      BoxI box(pt->x, pt->y, pt->x + srcFragment->w, pt->y + srcFragment->h);
+      const uint8_t* maskPixels = maskD->first +
+        (ssize_t)maskFragment->y * maskD->stride +
+        (ssize_t)maskFragment->x * maskD->bytesPerPixel;
+
+      // The mask is converted to spans by the rasterizer, the source pixels
+      // are attached to these spans by the filler, so the source and the mask
+      // are composited in a single pass.
+      MaskRasterizer8 rasterizer;
+      RasterPaintDoRender_prepareRasterizer(ctx, &rasterizer);
+      rasterizer.init(box, maskPixels, maskD->stride, maskD->format);
+
+      // If compositing operator is not SRC or SRC_OVER and the source format
+      // is not compatible with the destination, the source must be converted.
+      // The texture fetcher is used in such case, it converts only pixels
+      // which are really composited.
+      if (compositingOperator == COMPOSITE_CLEAR ||
+          (!RasterUtil::isCompositeCoreOp(compositingOperator) &&
+           RasterUtil::getCompositeCompatFormat(dstFormat, srcFormat) != srcFormat))
+      {
+        RasterPattern* old = ctx->pc;
+        RasterPattern pc;
+
+        TransformD tr(TransformD::fromTranslation(PointD(*pt)));
+        FOG_RETURN_ON_ERROR(
+          _api_raster.texture.create(&pc,
+            dstFormat,
+            &ctx->engine->metaClipBoxI,
+            srcImage, srcFragment,
+            &tr, &ctx->engine->dummyColor, TEXTURE_TILE_PAD, IMAGE_QUALITY_NEAREST)
+        );
+
+        ctx->pc = &pc;
+        err_t err = RasterPaintDoRender_fillRasterizedShape8(ctx, &rasterizer);
+        ctx->pc = old;
+
+        pc.destroy();
+        return err;
+      }
+
+      RasterPaintFiller filler;
+      uint srcBpp = srcD->bytesPerPixel;
+
+      filler.ctx = ctx;
+      filler.dstPixels = ctx->target.pixels;
+      filler.dstStride = ctx->target.stride;
+
+      filler._prepare = (RasterFiller::PrepareFunc)RasterPaintFiller_prepare_filter_st;
+      filler._process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_filter;
+      filler._skip = (RasterFiller::SkipFunc)RasterPaintFiller_skip_filter;
+
+      // The filler addresses the source pixels using the destination x/y, so
+      // the source pointer is adjusted by the destination position.
+      filler.f.blit = _api_raster.getVBlitSpan(dstFormat, compositingOperator, srcFormat);
+      filler.f.closure = &ctx->closure;
+      filler.f.srcPixels = const_cast<uint8_t*>(srcD->first) +
+        (ssize_t)srcFragment->y * srcD->stride +
+        ((ssize_t)srcFragment->x - pt->x) * (ssize_t)srcBpp;
+      filler.f.srcStride = srcD->stride;
+      filler.f.srcBpp = srcBpp;
+      filler.f.srcBaseY = (uint)pt->y;
+
+      ctx->closure.palette = srcD->palette->_d;
+      ctx->closure.colorKey = srcD->colorKey;
+
+      rasterizer.render(&filler, &ctx->scanline8);
+
+      ctx->closure.palette = NULL;
+      ctx->closure.colorKey = 0xFFFFFFFF;
+      return ERR_OK;
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
 // ============================================================================
 // [Fog::RasterPaintDoRender - FilterRasterizerShape]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaintEngine* engine, const FeBase* feBase, Rasterizer8* rasterizer, const BoxI* bBox)
+static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaintContext* ctx, const FeBase* feBase, Rasterizer8* rasterizer, const BoxI* bBox)
 {
   // Destination and source formats are the same.
-  RasterFilter ctx;
-  FOG_RETURN_ON_ERROR(_api_raster.filter.create[feBase->getFeType()](&ctx,
-    feBase, &engine->ctx.filterScale,
-    &engine->ctx.buffer,
-    engine->ctx.target.format,
-    engine->ctx.target.format));
+  RasterFilter filter;
+  FOG_RETURN_ON_ERROR(_api_raster.filter.create[feBase->getFeType()](&filter,
+    feBase, &ctx->filterScale,
+    &ctx->buffer,
+    ctx->target.format,
+    ctx->target.format));
 
   err_t err;
 
@@ -888,34 +1283,34 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaint
   dImage.stride = 0;
   dImage.data = NULL;
 
-  sImage.size = engine->ctx.target.size;
-  sImage.stride = engine->ctx.target.stride;
-  sImage.data = engine->ctx.target.pixels;
+  sImage.size = ctx->target.size;
+  sImage.stride = ctx->target.stride;
+  sImage.data = ctx->target.pixels;
 
-  uint32_t bpp = engine->ctx.target.bpp;
+  uint32_t bpp = ctx->target.bpp;
 
   MemBuffer intermediateBuffer;
-  err = ctx.doRect(&ctx, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
+  err = filter.doRect(&filter, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
 
   if (FOG_IS_ERROR(err))
   {
-    ctx.destroy(&ctx);
+    filter.destroy(&filter);
     return err;
   }
 
   RasterPaintFiller filler;
 
-  filler.ctx = &engine->ctx;
-  filler.dstPixels = engine->ctx.target.pixels;
-  filler.dstStride = engine->ctx.target.stride;
+  filler.ctx = ctx;
+  filler.dstPixels = ctx->target.pixels;
+  filler.dstStride = ctx->target.stride;
 
   filler._prepare = (RasterFiller::PrepareFunc)RasterPaintFiller_prepare_filter_st;
   filler._process = (RasterFiller::ProcessFunc)RasterPaintFiller_process_filter;
   filler._skip = (RasterFiller::SkipFunc)RasterPaintFiller_skip_filter;
 
-  uint32_t format = engine->ctx.target.format;
+  uint32_t format = ctx->target.format;
   filler.f.blit = _api_raster.getVBlitSpan(format, COMPOSITE_SRC, format);
-  filler.f.closure = &engine->ctx.closure;
+  filler.f.closure = &ctx->closure;
 
   filler.f.srcPixels = dImage.data - bBox->x0 * bpp;
   filler.f.srcStride = dImage.stride;
@@ -923,9 +1318,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaint
   filler.f.srcBpp = bpp;
   filler.f.srcBaseY = bBox->y0;
 
-  rasterizer->render(&filler, &engine->ctx.scanline8);
+  rasterizer->render(&filler, &ctx->scanline8);
 
-  ctx.destroy(&ctx);
+  filter.destroy(&filter);
   return ERR_OK;
 }
 
@@ -934,43 +1329,43 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterRasterizedShape8(RasterPaint
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxI* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxI* box)
 {
   FOG_ASSERT(box->isValid());
 
   // Destination and source formats are the same.
-  RasterFilter ctx;
-  FOG_RETURN_ON_ERROR(_api_raster.filter.create[feBase->getFeType()](&ctx,
-    feBase, &engine->ctx.filterScale,
-    &engine->ctx.buffer,
-    engine->ctx.target.format,
-    engine->ctx.target.format));
+  RasterFilter filter;
+  FOG_RETURN_ON_ERROR(_api_raster.filter.create[feBase->getFeType()](&filter,
+    feBase, &ctx->filterScale,
+    &ctx->buffer,
+    ctx->target.format,
+    ctx->target.format));
 
   err_t err;
 
   RasterFilterImage dImage;
   RasterFilterImage sImage;
 
-  sImage.size = engine->ctx.target.size;
-  sImage.stride = engine->ctx.target.stride;
-  sImage.data = engine->ctx.target.pixels;
+  sImage.size = ctx->target.size;
+  sImage.stride = ctx->target.stride;
+  sImage.data = ctx->target.pixels;
 
   PointI dPos;
   RectI sRect(box->x0, box->y0, box->x1 - box->x0, box->y1 - box->y0);
 
-  uint32_t opacity = engine->ctx.rasterHints.opacity;
+  uint32_t opacity = ctx->rasterHints.opacity;
   MemBuffer intermediateBuffer;
 
-  if (opacity == engine->ctx.fullOpacity.u)
+  if (opacity == ctx->fullOpacity.u)
   {
     // In case that we are painting with full opacity we can render the effect
     // directly to the destination buffer.
-    dImage.size = engine->ctx.target.size;
-    dImage.stride = engine->ctx.target.stride;
-    dImage.data = engine->ctx.target.pixels;
+    dImage.size = ctx->target.size;
+    dImage.stride = ctx->target.stride;
+    dImage.data = ctx->target.pixels;
     dPos.set(box->x0, box->y0);
 
-    err = ctx.doRect(&ctx, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
+    err = filter.doRect(&filter, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
   }
   else
   {
@@ -981,24 +1376,24 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
     dImage.data = NULL;
 
     dPos.set(0, 0);
-    err = ctx.doRect(&ctx, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
+    err = filter.doRect(&filter, &dImage, &dPos, &sImage, &sRect, &intermediateBuffer);
     
     if (err == ERR_OK)
     {
       int i = sRect.h;
 
       RasterVBlitSpanFunc blitSpan;
-      blitSpan = _api_raster.getCompositeCore(engine->ctx.target.format, COMPOSITE_SRC)->vblit_span[engine->ctx.target.format];
+      blitSpan = _api_raster.getCompositeCore(ctx->target.format, COMPOSITE_SRC)->vblit_span[ctx->target.format];
 
-      ssize_t dstStride = engine->ctx.target.stride;
+      ssize_t dstStride = ctx->target.stride;
       ssize_t srcStride = dImage.stride;
 
-      uint8_t* dstPixels = engine->ctx.target.pixels + box->y0 * srcStride;
+      uint8_t* dstPixels = ctx->target.pixels + box->y0 * srcStride;
       uint8_t* srcPixels = dImage.data;
 
       FOG_ASSERT(srcPixels != NULL);
 
-      switch (engine->ctx.precision)
+      switch (ctx->precision)
       {
         case IMAGE_PRECISION_BYTE:
         {
@@ -1009,7 +1404,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
 
           do {
             span[0].setData(srcPixels);
-            blitSpan(dstPixels, span, &engine->ctx.closure);
+            blitSpan(dstPixels, span, &ctx->closure);
 
             dstPixels += dstStride;
             srcPixels += srcStride;
@@ -1029,14 +1424,14 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxI(
     }
   }
 
-  ctx.destroy(&ctx);
+  filter.destroy(&filter);
   return err;
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxF(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxF* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxF* box)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
     {
@@ -1049,15 +1444,15 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxF(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->filterNormalizedBoxI(engine, feBase, &boxI);
+        return RasterPaintDoRender_filterNormalizedBoxI(ctx, feBase, &boxI);
       }
       else
       {
-        BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-        RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+        BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+        RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
         rasterizer->init24x8(box24x8);
-        return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boxBounds);
+        return RasterPaintDoRender_filterRasterizedShape8(ctx, feBase, rasterizer, &rasterizer->_boxBounds);
       }
     }
     
@@ -1076,9 +1471,9 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxD(
-  RasterPaintEngine* engine, const FeBase* feBase, const BoxD* box)
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxD* box)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
     {
@@ -1091,15 +1486,15 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxD(
       if (RasterUtil::isBox24x8Aligned(box24x8))
       {
         BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
-        return engine->doCmd->filterNormalizedBoxI(engine, feBase, &boxI);
+        return RasterPaintDoRender_filterNormalizedBoxI(ctx, feBase, &boxI);
       }
       else
       {
-        BoxRasterizer8* rasterizer = &engine->ctx.boxRasterizer8;
-        RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+        BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+        RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
         rasterizer->init24x8(box24x8);
-        return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boxBounds);
+        return RasterPaintDoRender_filterRasterizedShape8(ctx, feBase, rasterizer, &rasterizer->_boxBounds);
       }
     }
     
@@ -1122,14 +1517,14 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedBoxD(
 // ============================================================================
 
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
-  RasterPaintEngine* engine, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
     {
-      PathRasterizer8* rasterizer = &engine->ctx.pathRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->setFillRule(fillRule);
       if (FOG_IS_ERROR(rasterizer->init()))
@@ -1139,7 +1534,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
       rasterizer->finalize();
 
       if (rasterizer->isValid())
-        return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boundingBox);
+        return RasterPaintDoRender_filterRasterizedShape8(ctx, feBase, rasterizer, &rasterizer->_boundingBox);
       else
         return ERR_OK;
     }
@@ -1159,14 +1554,14 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathF(
 }
 
 static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
-  RasterPaintEngine* engine, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
+  RasterPaintContext* ctx, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
 {
-  switch (engine->ctx.precision)
+  switch (ctx->precision)
   {
     case IMAGE_PRECISION_BYTE:
     {
-      PathRasterizer8* rasterizer = &engine->ctx.pathRasterizer8;
-      RasterPaintDoRender_prepareRasterizer(engine, rasterizer);
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareRasterizer(ctx, rasterizer);
 
       rasterizer->setFillRule(fillRule);
       if (FOG_IS_ERROR(rasterizer->init()))
@@ -1176,7 +1571,7 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
       rasterizer->finalize();
 
       if (rasterizer->isValid())
-        return RasterPaintDoRender_filterRasterizedShape8(engine, feBase, rasterizer, &rasterizer->_boundingBox);
+        return RasterPaintDoRender_filterRasterizedShape8(ctx, feBase, rasterizer, &rasterizer->_boundingBox);
       else
         return ERR_OK;
     }
@@ -1199,13 +1594,13 @@ static err_t FOG_FASTCALL RasterPaintDoRender_filterNormalizedPathD(
 // [Fog::RasterPaintDoRender - SwitchToMask / DiscardMask]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_switchToMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoRender_switchToMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoRender_discardMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoRender_discardMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
@@ -1215,54 +1610,264 @@ static err_t FOG_FASTCALL RasterPaintDoRender_discardMask(RasterPaintEngine* eng
 // [Fog::RasterPaintDoRender - SaveMask / RestoreMask]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_saveMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoRender_saveMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoRender_restoreMask(RasterPaintEngine* engine)
+static err_t FOG_FASTCALL RasterPaintDoRender_restoreMask(RasterPaintContext* ctx)
 {
   // TODO: Raster paint engine.
   return ERR_RT_NOT_IMPLEMENTED;
 }
 
 // ============================================================================
-// [Fog::RasterPaintDoGroup - MaskNormalizedBox]
+// [Fog::RasterPaintDoRender - MaskRasterizedShape]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxI(RasterPaintEngine* engine, uint32_t clipOp, const BoxI* box)
+static void FOG_INLINE RasterPaintDoRender_setClipMask(RasterPaintContext* ctx, RasterClipMask* mask)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  if (mask->getBoundingBox().isValid())
+  {
+    ctx->clipType = RASTER_CLIP_MASK;
+    ctx->clipBoxI = mask->getBoundingBox();
+    ctx->setClipMask(mask);
+  }
+  else
+  {
+    // Everything was clipped, the engine checks for an invalid clip-box.
+    mask->release();
+
+    ctx->clipType = RASTER_CLIP_BOX;
+    ctx->clipBoxI.reset();
+    ctx->resetClipMask();
+  }
+
+  ctx->clipRegion.clear();
 }
 
-static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxF(RasterPaintEngine* engine, uint32_t clipOp, const BoxF* box)
+static err_t FOG_FASTCALL RasterPaintDoRender_maskRasterizedShape8(RasterPaintContext* ctx, Rasterizer8* rasterizer)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  RasterClipMask* mask = RasterClipMask::create(rasterizer->getSceneBox());
+  if (FOG_IS_NULL(mask))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  RasterClipMaskBuilder builder;
+  builder.init(mask);
+
+  rasterizer->render(&builder, &ctx->scanline8);
+
+  if (FOG_IS_ERROR(builder.error))
+  {
+    mask->release();
+    return builder.error;
+  }
+
+  mask->updateBoundingBox();
+  RasterPaintDoRender_setClipMask(ctx, mask);
+  return ERR_OK;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxD(RasterPaintEngine* engine, uint32_t clipOp, const BoxD* box)
+static err_t FOG_FASTCALL RasterPaintDoRender_maskEmpty(RasterPaintContext* ctx)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  ctx->clipType = RASTER_CLIP_BOX;
+  ctx->clipBoxI.reset();
+  ctx->clipRegion.clear();
+  ctx->resetClipMask();
+  return ERR_OK;
 }
 
 // ============================================================================
-// [Fog::RasterPaintDoGroup - MaskNormalizedPath]
+// [Fog::RasterPaintDoRender - MaskNormalizedBox]
 // ============================================================================
 
-static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathF(RasterPaintEngine* engine, uint32_t clipOp, const PathF* path, uint32_t fillRule)
+static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxI(RasterPaintContext* ctx, uint32_t clipOp, const BoxI* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      // Intersecting the clip-mask with box doesn't need a rasterizer, only
+      // the spans outside of the box are removed.
+      if (clipOp == CLIP_OP_INTERSECT && ctx->clipType == RASTER_CLIP_MASK)
+      {
+        RasterClipMask* mask = ctx->clipMask;
+
+        if (mask->isDetached())
+        {
+          mask->intersect(*box);
+          mask = mask->addRef();
+        }
+        else
+        {
+          mask = RasterClipMask::copy(mask, *box);
+          if (FOG_IS_NULL(mask))
+            return ERR_RT_OUT_OF_MEMORY;
+        }
+
+        RasterPaintDoRender_setClipMask(ctx, mask);
+        return ERR_OK;
+      }
+
+      BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+      RasterPaintDoRender_prepareMaskRasterizer(ctx, rasterizer, clipOp);
+
+      BoxI clipped(UNINITIALIZED);
+      if (!BoxI::intersect(clipped, *box, rasterizer->getSceneBox()))
+        return RasterPaintDoRender_maskEmpty(ctx);
+
+      rasterizer->init32x0(clipped);
+      return RasterPaintDoRender_maskRasterizedShape8(ctx, rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
 }
 
-static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathD(RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule)
+static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxF(RasterPaintContext* ctx, uint32_t clipOp, const BoxF* box)
 {
-  // TODO: Raster paint engine.
-  return ERR_RT_NOT_IMPLEMENTED;
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      BoxI box24x8(UNINITIALIZED);
+      box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
+      box24x8.y0 = Math::fixed24x8FromFloat(box->y0);
+      box24x8.x1 = Math::fixed24x8FromFloat(box->x1);
+      box24x8.y1 = Math::fixed24x8FromFloat(box->y1);
+
+      if (RasterUtil::isBox24x8Aligned(box24x8))
+      {
+        BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
+        return RasterPaintDoRender_maskNormalizedBoxI(ctx, clipOp, &boxI);
+      }
+
+      BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+      RasterPaintDoRender_prepareMaskRasterizer(ctx, rasterizer, clipOp);
+
+      if (!BoxI::intersect(box24x8, box24x8, rasterizer->_sceneBox24x8))
+        return RasterPaintDoRender_maskEmpty(ctx);
+
+      rasterizer->init24x8(box24x8);
+      return RasterPaintDoRender_maskRasterizedShape8(ctx, rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedBoxD(RasterPaintContext* ctx, uint32_t clipOp, const BoxD* box)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      BoxI box24x8(UNINITIALIZED);
+      box24x8.x0 = Math::fixed24x8FromFloat(box->x0);
+      box24x8.y0 = Math::fixed24x8FromFloat(box->y0);
+      box24x8.x1 = Math::fixed24x8FromFloat(box->x1);
+      box24x8.y1 = Math::fixed24x8FromFloat(box->y1);
+
+      if (RasterUtil::isBox24x8Aligned(box24x8))
+      {
+        BoxI boxI(box24x8.x0 >> 8, box24x8.y0 >> 8, box24x8.x1 >> 8, box24x8.y1 >> 8);
+        return RasterPaintDoRender_maskNormalizedBoxI(ctx, clipOp, &boxI);
+      }
+
+      BoxRasterizer8* rasterizer = &ctx->boxRasterizer8;
+      RasterPaintDoRender_prepareMaskRasterizer(ctx, rasterizer, clipOp);
+
+      if (!BoxI::intersect(box24x8, box24x8, rasterizer->_sceneBox24x8))
+        return RasterPaintDoRender_maskEmpty(ctx);
+
+      rasterizer->init24x8(box24x8);
+      return RasterPaintDoRender_maskRasterizedShape8(ctx, rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRender - MaskNormalizedPath]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathF(RasterPaintContext* ctx, uint32_t clipOp, const PathF* path, uint32_t fillRule)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareMaskRasterizer(ctx, rasterizer, clipOp);
+
+      rasterizer->setFillRule(fillRule);
+      if (FOG_IS_ERROR(rasterizer->init()))
+        return rasterizer->getError();
+
+      rasterizer->addPath(*path);
+      rasterizer->finalize();
+
+      if (!rasterizer->isValid())
+        return RasterPaintDoRender_maskEmpty(ctx);
+
+      return RasterPaintDoRender_maskRasterizedShape8(ctx, rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRender_maskNormalizedPathD(RasterPaintContext* ctx, uint32_t clipOp, const PathD* path, uint32_t fillRule)
+{
+  switch (ctx->precision)
+  {
+    case IMAGE_PRECISION_BYTE:
+    case IMAGE_PRECISION_WORD:
+    {
+      PathRasterizer8* rasterizer = &ctx->pathRasterizer8;
+      RasterPaintDoRender_prepareMaskRasterizer(ctx, rasterizer, clipOp);
+
+      rasterizer->setFillRule(fillRule);
+      if (FOG_IS_ERROR(rasterizer->init()))
+        return rasterizer->getError();
+
+      rasterizer->addPath(*path);
+      rasterizer->finalize();
+
+      if (!rasterizer->isValid())
+        return RasterPaintDoRender_maskEmpty(ctx);
+
+      return RasterPaintDoRender_maskRasterizedShape8(ctx, rasterizer);
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  // Dead code to avoid warning.
+  return ERR_RT_INVALID_STATE;
 }
 
 // ============================================================================
@@ -1283,6 +1888,10 @@ void FOG_NO_EXPORT RasterPaintDoRender_init(void)
   v->fillNormalizedBoxD = RasterPaintDoRender_fillNormalizedBoxD;
   v->fillNormalizedPathF = RasterPaintDoRender_fillNormalizedPathF;
   v->fillNormalizedPathD = RasterPaintDoRender_fillNormalizedPathD;
+  v->fillNormalizedMaskA = RasterPaintDoRender_fillNormalizedMaskA;
+  v->strokeHairlinePathF = RasterPaintDoRender_strokeHairlinePathF;
+  v->strokeHairlinePathD = RasterPaintDoRender_strokeHairlinePathD;
+  v->fillCoverage = RasterPaintDoRender_fillCoverage;
 
   // --------------------------------------------------------------------------
   // [Blit]
@@ -1292,6 +1901,8 @@ void FOG_NO_EXPORT RasterPaintDoRender_init(void)
   v->blitNormalizedImageA = RasterPaintDoRender_blitNormalizedImageA;
   v->blitNormalizedImageI = RasterPaintDoRender_blitNormalizedImageI;
   v->blitNormalizedImageD = RasterPaintDoRender_blitNormalizedImageD;
+  v->blitNormalizedMaskedImageA = RasterPaintDoRender_blitNormalizedMaskedImageA;
+  v->blitNormalizedSpritesA = RasterPaintDoRender_blitNormalizedSpritesA;
 
   // --------------------------------------------------------------------------
   // [Filter]
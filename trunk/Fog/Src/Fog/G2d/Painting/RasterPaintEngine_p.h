@@ -64,6 +64,13 @@ struct FOG_NO_EXPORT RasterPaintEngine : public PaintEngine
 
   static uint detectMaxThreads();
 
+  // --------------------------------------------------------------------------
+  // [Multithreading]
+  // --------------------------------------------------------------------------
+
+  //! @brief Switch the paint-engine to multithreaded or singlethreaded mode.
+  err_t setMultithreaded(bool enabled);
+
   // --------------------------------------------------------------------------
   // [Clipping]
   // --------------------------------------------------------------------------
@@ -177,6 +184,7 @@ struct FOG_NO_EXPORT RasterPaintEngine : public PaintEngine
   // --------------------------------------------------------------------------
 
   err_t createPatternContext();
+  err_t createSharedPatternContext(PatternData* d);
 
   FOG_INLINE void discardSource()
   {
@@ -209,6 +217,14 @@ _DiscardContinue:
   {
     pc->destroy();
 
+    // The shared context is not owned by the context-pool, it can be also
+    // released by another paint engine or by the pattern data.
+    if (pc->_isShared)
+    {
+      MemMgr::free(pc);
+      return;
+    }
+
     reinterpret_cast<RasterAbstractLinkedList*>(pc)->next = pcPool;
     pcPool = reinterpret_cast<RasterAbstractLinkedList*>(pc);
   }
@@ -444,8 +460,8 @@ _DiscardContinue:
   // [Members - Multithreading]
   // --------------------------------------------------------------------------
 
-  // @brief The worker manager.
-  // RasterPaintWorkMgr* wm;
+  //! @brief The worker manager (only used by multithreaded mode).
+  RasterPaintWorkMgr* wm;
 
   //! @brief The maximum number of threads that can be used for rendering after
   //! the multithreading is initialized.
@@ -460,6 +476,13 @@ _DiscardContinue:
   //! related to changing multithreaded mode into singlethreaded can't fail.
   uint finalizing;
 
+  // --------------------------------------------------------------------------
+  // [Members - Caching]
+  // --------------------------------------------------------------------------
+
+  //! @brief Caches enabled by the user, see @c RASTER_CACHE.
+  uint32_t cacheFlags;
+
   // --------------------------------------------------------------------------
   // [Members - Temporary]
   // --------------------------------------------------------------------------
@@ -491,11 +514,13 @@ extern FOG_NO_EXPORT RasterPaintDoCmd RasterPaintDoGroup_vtable[RASTER_MODE_COUN
 // [Fog::RasterPaintEngine - Defs]
 // ============================================================================
 
-#define _FOG_RASTER_ENSURE_PATTERN(_Engine_) \
+// The pattern context can be NULL only in the master context (the workers
+// always get the pattern context from the command stream).
+#define _FOG_RASTER_ENSURE_PATTERN(_Ctx_) \
   FOG_MACRO_BEGIN \
-    if (_Engine_->ctx.pc == NULL) \
+    if (_Ctx_->pc == NULL) \
     { \
-      FOG_RETURN_ON_ERROR(_Engine_->createPatternContext()); \
+      FOG_RETURN_ON_ERROR(_Ctx_->engine->createPatternContext()); \
     } \
   FOG_MACRO_END
 
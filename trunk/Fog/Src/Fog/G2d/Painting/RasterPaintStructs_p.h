@@ -41,6 +41,7 @@ struct RasterPaintGroup;
 struct RasterPaintContext;
 struct RasterPaintEngine;
 struct RasterPaintState;
+struct RasterPaintWorkMgr;
 struct RasterScope;
 
 // ============================================================================
@@ -214,6 +215,7 @@ struct FOG_NO_EXPORT RasterPaintGroup
 
     groupRecord = NULL;
     cmdRecord = NULL;
+    cmdPrev = NULL;
     cmdStart = NULL;
   }
 
@@ -279,6 +281,9 @@ struct FOG_NO_EXPORT RasterPaintGroup
   MemZoneRecord* groupRecord;
   //! @brief Commands record (recorded position in cmdAllocator).
   MemZoneRecord* cmdRecord;
+  //! @brief Commands end pointer of the outer stream (the position before
+  //! @c cmdRecord was allocated).
+  uint8_t* cmdPrev;
   //! @brief Commands start pointer.
   uint8_t* cmdStart;
 };
@@ -405,6 +410,12 @@ struct FOG_NO_EXPORT RasterPaintState
   //! @brief The clip-region.
   Static<Region> clipRegion;
 
+  //! @brief The clip-mask (the state holds one reference).
+  RasterClipMask* clipMask;
+  //! @brief The @c RasterPaintEngine::masterMaskSaved value at the time the
+  //! clip-mask was saved.
+  uint32_t clipMaskSaved;
+
   // ------------------------------------------------------------------------
   // [RASTER_STATE_FILTER]
   // ------------------------------------------------------------------------
@@ -412,6 +423,40 @@ struct FOG_NO_EXPORT RasterPaintState
   Static<ImageFilterScaleD> filterScale;
 };
 
+// ============================================================================
+// [Fog::RasterSprite]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Normalized (clipped) sprite, see @ref Painter::blitImages().
+struct FOG_NO_EXPORT RasterSprite
+{
+  //! @brief Destination point (in device space, clipped).
+  PointI pt;
+  //! @brief Source fragment (clipped).
+  RectI srcFragment;
+  //! @brief Opacity (in the range 1 to @c RasterPaintContext::fullOpacity).
+  uint32_t opacity;
+};
+
+// ============================================================================
+// [Fog::RasterHairline]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Hairline stroke parameters, see @ref HairlineRasterizer8.
+struct FOG_NO_EXPORT RasterHairline
+{
+  //! @brief Line width (in device space).
+  double lineWidth;
+  //! @brief Start cap.
+  uint32_t startCap;
+  //! @brief End cap.
+  uint32_t endCap;
+};
+
 // ============================================================================
 // [Fog::RasterPaintDoCmd]
 // ============================================================================
@@ -429,47 +474,55 @@ struct FOG_NO_EXPORT RasterPaintDoCmd
   // [Funcs - Paint]
   // --------------------------------------------------------------------------
 
-  err_t (FOG_FASTCALL *fillAll)(RasterPaintEngine* engine);
-  err_t (FOG_FASTCALL *fillNormalizedBoxI)(RasterPaintEngine* engine, const BoxI* box);
-  err_t (FOG_FASTCALL *fillNormalizedBoxF)(RasterPaintEngine* engine, const BoxF* box);
-  err_t (FOG_FASTCALL *fillNormalizedBoxD)(RasterPaintEngine* engine, const BoxD* box);
-  err_t (FOG_FASTCALL *fillNormalizedPathF)(RasterPaintEngine* engine, const PathF* path, const PointF* pt, uint32_t fillRule);
-  err_t (FOG_FASTCALL *fillNormalizedPathD)(RasterPaintEngine* engine, const PathD* path, const PointD* pt, uint32_t fillRule);
+  err_t (FOG_FASTCALL *fillAll)(RasterPaintContext* ctx);
+  err_t (FOG_FASTCALL *fillNormalizedBoxI)(RasterPaintContext* ctx, const BoxI* box);
+  err_t (FOG_FASTCALL *fillNormalizedBoxF)(RasterPaintContext* ctx, const BoxF* box);
+  err_t (FOG_FASTCALL *fillNormalizedBoxD)(RasterPaintContext* ctx, const BoxD* box);
+  err_t (FOG_FASTCALL *fillNormalizedPathF)(RasterPaintContext* ctx, const PathF* path, const PointF* pt, uint32_t fillRule);
+  err_t (FOG_FASTCALL *fillNormalizedPathD)(RasterPaintContext* ctx, const PathD* path, const PointD* pt, uint32_t fillRule);
+  err_t (FOG_FASTCALL *fillNormalizedMaskA)(RasterPaintContext* ctx, const PointI* pt, const Image* mask, const RectI* maskFragment);
+
+  err_t (FOG_FASTCALL *strokeHairlinePathF)(RasterPaintContext* ctx, const PathF* path, const RasterHairline* hairline);
+  err_t (FOG_FASTCALL *strokeHairlinePathD)(RasterPaintContext* ctx, const PathD* path, const RasterHairline* hairline);
+
+  err_t (FOG_FASTCALL *fillCoverage)(RasterPaintContext* ctx, const RasterCoverage* coverage);
 
   // --------------------------------------------------------------------------
   // [Funcs - Blit]
   // --------------------------------------------------------------------------
 
-  err_t (FOG_FASTCALL *blitImageD)(RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
-  err_t (FOG_FASTCALL *blitNormalizedImageA)(RasterPaintEngine* engine, const PointI* pt, const Image* srcImage, const RectI* srcFragment);
-  err_t (FOG_FASTCALL *blitNormalizedImageI)(RasterPaintEngine* engine, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
-  err_t (FOG_FASTCALL *blitNormalizedImageD)(RasterPaintEngine* engine, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
+  err_t (FOG_FASTCALL *blitImageD)(RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
+  err_t (FOG_FASTCALL *blitNormalizedImageA)(RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment);
+  err_t (FOG_FASTCALL *blitNormalizedImageI)(RasterPaintContext* ctx, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
+  err_t (FOG_FASTCALL *blitNormalizedImageD)(RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality);
+  err_t (FOG_FASTCALL *blitNormalizedMaskedImageA)(RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment, const Image* mask, const RectI* maskFragment);
+  err_t (FOG_FASTCALL *blitNormalizedSpritesA)(RasterPaintContext* ctx, const Image* srcImage, const RasterSprite* sprites, size_t count);
 
   // --------------------------------------------------------------------------
   // [Funcs - Filter]
   // --------------------------------------------------------------------------
 
-  err_t (FOG_FASTCALL *filterNormalizedBoxI)(RasterPaintEngine* engine, const FeBase* feBase, const BoxI* box);
-  err_t (FOG_FASTCALL *filterNormalizedBoxF)(RasterPaintEngine* engine, const FeBase* feBase, const BoxF* box);
-  err_t (FOG_FASTCALL *filterNormalizedBoxD)(RasterPaintEngine* engine, const FeBase* feBase, const BoxD* box);
-  err_t (FOG_FASTCALL *filterNormalizedPathF)(RasterPaintEngine* engine, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule);
-  err_t (FOG_FASTCALL *filterNormalizedPathD)(RasterPaintEngine* engine, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule);
+  err_t (FOG_FASTCALL *filterNormalizedBoxI)(RasterPaintContext* ctx, const FeBase* feBase, const BoxI* box);
+  err_t (FOG_FASTCALL *filterNormalizedBoxF)(RasterPaintContext* ctx, const FeBase* feBase, const BoxF* box);
+  err_t (FOG_FASTCALL *filterNormalizedBoxD)(RasterPaintContext* ctx, const FeBase* feBase, const BoxD* box);
+  err_t (FOG_FASTCALL *filterNormalizedPathF)(RasterPaintContext* ctx, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule);
+  err_t (FOG_FASTCALL *filterNormalizedPathD)(RasterPaintContext* ctx, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule);
 
   // --------------------------------------------------------------------------
   // [Funcs - Mask]
   // --------------------------------------------------------------------------
 
-  err_t (FOG_FASTCALL *switchToMask)(RasterPaintEngine* engine);
-  err_t (FOG_FASTCALL *discardMask)(RasterPaintEngine* engine);
+  err_t (FOG_FASTCALL *switchToMask)(RasterPaintContext* ctx);
+  err_t (FOG_FASTCALL *discardMask)(RasterPaintContext* ctx);
 
-  err_t (FOG_FASTCALL *saveMask)(RasterPaintEngine* engine);
-  err_t (FOG_FASTCALL *restoreMask)(RasterPaintEngine* engine);
+  err_t (FOG_FASTCALL *saveMask)(RasterPaintContext* ctx);
+  err_t (FOG_FASTCALL *restoreMask)(RasterPaintContext* ctx);
 
-  err_t (FOG_FASTCALL *maskNormalizedBoxI)(RasterPaintEngine* engine, uint32_t clipOp, const BoxI* box);
-  err_t (FOG_FASTCALL *maskNormalizedBoxF)(RasterPaintEngine* engine, uint32_t clipOp, const BoxF* box);
-  err_t (FOG_FASTCALL *maskNormalizedBoxD)(RasterPaintEngine* engine, uint32_t clipOp, const BoxD* box);
-  err_t (FOG_FASTCALL *maskNormalizedPathF)(RasterPaintEngine* engine, uint32_t clipOp, const PathF* path, uint32_t fillRule);
-  err_t (FOG_FASTCALL *maskNormalizedPathD)(RasterPaintEngine* engine, uint32_t clipOp, const PathD* path, uint32_t fillRule);
+  err_t (FOG_FASTCALL *maskNormalizedBoxI)(RasterPaintContext* ctx, uint32_t clipOp, const BoxI* box);
+  err_t (FOG_FASTCALL *maskNormalizedBoxF)(RasterPaintContext* ctx, uint32_t clipOp, const BoxF* box);
+  err_t (FOG_FASTCALL *maskNormalizedBoxD)(RasterPaintContext* ctx, uint32_t clipOp, const BoxD* box);
+  err_t (FOG_FASTCALL *maskNormalizedPathF)(RasterPaintContext* ctx, uint32_t clipOp, const PathF* path, uint32_t fillRule);
+  err_t (FOG_FASTCALL *maskNormalizedPathD)(RasterPaintContext* ctx, uint32_t clipOp, const PathD* path, uint32_t fillRule);
 };
 
 //! @}
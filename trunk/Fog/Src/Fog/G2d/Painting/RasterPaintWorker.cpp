@@ -0,0 +1,1787 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Kernel/EventLoop.h>
+#include <Fog/Core/Math/Math.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadCondition.h>
+#include <Fog/Core/Threading/ThreadPool.h>
+#include <Fog/G2d/Geometry/PathClipper.h>
+#include <Fog/G2d/Imaging/Image.h>
+#include <Fog/G2d/Imaging/Filters/FeBase.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
+#include <Fog/G2d/Painting/RasterPaintCmd_p.h>
+#include <Fog/G2d/Painting/RasterPaintContext_p.h>
+#include <Fog/G2d/Painting/RasterPaintEngine_p.h>
+#include <Fog/G2d/Painting/RasterPaintStructs_p.h>
+#include <Fog/G2d/Painting/RasterPaintWorker_p.h>
+#include <Fog/G2d/Painting/RasterUtil_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterPaintWorker - Construction / Destruction]
+// ============================================================================
+
+RasterPaintWorker::RasterPaintWorker(RasterPaintWorkMgr* wm, uint workerId) :
+  wm(wm),
+  workerId(workerId),
+  band(0, 0, 0, 0)
+{
+  ctx.engine = wm->engine;
+}
+
+RasterPaintWorker::~RasterPaintWorker()
+{
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorker - Run]
+// ============================================================================
+
+void RasterPaintWorker::run()
+{
+  if (wm->mode == RASTER_WORK_MODE_TILES)
+    processTiles();
+  else
+    process();
+
+  AutoLock locked(wm->lock);
+  if (++wm->finished == wm->count - 1)
+    wm->finishedCondition.signal();
+}
+
+// ============================================================================
+// [Fog::RasterPaintTask - Run]
+// ============================================================================
+
+void RasterPaintTask::run()
+{
+  worker->run();
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorker - Process]
+// ============================================================================
+
+static FOG_INLINE bool RasterPaintWorker_setClipRegion(RasterPaintWorker* worker, const Region& region)
+{
+  RasterPaintContext& ctx = worker->ctx;
+
+  if (worker->band.subsumes(region.getBoundingBox()))
+    ctx.clipRegion = region;
+  else
+    Region::intersect(ctx.clipRegion, region, worker->band);
+
+  size_t length = ctx.clipRegion.getLength();
+  if (length == 0)
+    return false;
+
+  if (length == 1)
+  {
+    ctx.clipType = RASTER_CLIP_BOX;
+    ctx.clipBoxI = ctx.clipRegion.getData()[0];
+  }
+  else
+  {
+    ctx.clipType = RASTER_CLIP_REGION;
+    ctx.clipBoxI = ctx.clipRegion.getBoundingBox();
+  }
+
+  return true;
+}
+
+void RasterPaintWorker::process()
+{
+  uint8_t* p = wm->cmdStart;
+  uint8_t* pEnd = wm->cmdEnd;
+
+  // The first command in the batch always sets the clip, but be safe.
+  ctx.clipType = RASTER_CLIP_BOX;
+  isClipValid = BoxI::intersect(ctx.clipBoxI, ctx.clipBoxI, band);
+
+  while (p != pEnd)
+    p = processCmd(p);
+
+  // Release the clip region and clip mask, they can hold the data owned by
+  // the command.
+  ctx.clipRegion.reset();
+  ctx.resetClipMask();
+}
+
+void RasterPaintWorker::processTiles()
+{
+  int w = ctx.target.size.w;
+  int h = ctx.target.size.h;
+
+  for (;;)
+  {
+    size_t tileIndex = wm->tileNext.addXchg(1);
+    if (tileIndex >= wm->tileCount)
+      break;
+
+    const RasterPaintTile& tile = wm->tiles[tileIndex];
+    if (tile.length == 0)
+      continue;
+
+    int x0 = (int)(tileIndex % wm->tilesX) << RASTER_TILE_SHIFT;
+    int y0 = (int)(tileIndex / wm->tilesX) << RASTER_TILE_SHIFT;
+
+    band.setBox(x0, y0, Math::min<int>(x0 + RASTER_TILE_SIZE, w),
+                        Math::min<int>(y0 + RASTER_TILE_SIZE, h));
+
+    // The first command in each tile is always the clip command.
+    ctx.clipType = RASTER_CLIP_BOX;
+    ctx.clipBoxI = band;
+    isClipValid = true;
+
+    uint8_t** cmds = wm->tileCmds + tile.offset;
+    for (uint32_t i = 0; i < tile.length; i++)
+      processCmd(cmds[i]);
+  }
+
+  ctx.clipRegion.reset();
+  ctx.resetClipMask();
+}
+
+uint8_t* RasterPaintWorker::processCmd(uint8_t* p)
+{
+  // The worker calls the single-threaded render functions directly, the
+  // commands were already serialized and all pattern contexts are owned (and
+  // referenced) by the commands themselves, so no reference counting is done
+  // here.
+  const RasterPaintDoCmd* doCmd = &RasterPaintDoRender_vtable[RASTER_MODE_ST];
+
+  switch (reinterpret_cast<RasterPaintCmd*>(p)->getCommand())
+  {
+    case RASTER_PAINT_CMD_NULL:
+    default:
+    {
+      FOG_ASSERT_NOT_REACHED();
+      return wm->cmdEnd;
+    }
+
+    case RASTER_PAINT_CMD_NEXT:
+    {
+      RasterPaintCmd_Next* cmd =
+        reinterpret_cast<RasterPaintCmd_Next*>(p);
+      return cmd->getPtr();
+    }
+
+    case RASTER_PAINT_CMD_SET_OPACITY:
+    {
+      RasterPaintCmd_SetOpacity* cmd =
+        reinterpret_cast<RasterPaintCmd_SetOpacity*>(p);
+      p += sizeof(RasterPaintCmd_SetOpacity);
+
+      ctx.rasterHints.opacity = cmd->getOpacity();
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB32:
+    {
+      RasterPaintCmd_SetOpacityAndPrgb32* cmd =
+        reinterpret_cast<RasterPaintCmd_SetOpacityAndPrgb32*>(p);
+      p += sizeof(RasterPaintCmd_SetOpacityAndPrgb32);
+
+      ctx.pc = (RasterPattern*)(size_t)0x1;
+      ctx.solid.prgb32.u32 = cmd->getPrgb32();
+      ctx.rasterHints.opacity = cmd->getOpacity();
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64:
+    {
+      RasterPaintCmd_SetOpacityAndPrgb64* cmd =
+        reinterpret_cast<RasterPaintCmd_SetOpacityAndPrgb64*>(p);
+      p += sizeof(RasterPaintCmd_SetOpacityAndPrgb64);
+
+      ctx.pc = (RasterPattern*)(size_t)0x1;
+      ctx.solid.prgb64 = cmd->getPrgb64();
+      ctx.rasterHints.opacity = cmd->getOpacity();
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN:
+    {
+      RasterPaintCmd_SetOpacityAndPattern* cmd =
+        reinterpret_cast<RasterPaintCmd_SetOpacityAndPattern*>(p);
+      p += sizeof(RasterPaintCmd_SetOpacityAndPattern);
+
+      ctx.pc = cmd->getPatternContext();
+      ctx.rasterHints.opacity = cmd->getOpacity();
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_PAINT_HINTS:
+    {
+      RasterPaintCmd_SetPaintHints* cmd =
+        reinterpret_cast<RasterPaintCmd_SetPaintHints*>(p);
+      p += sizeof(RasterPaintCmd_SetPaintHints);
+
+      ctx.paintHints.packed = cmd->getPaintHints().packed;
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_ALL:
+    {
+      p += sizeof(RasterPaintCmd_FillAll);
+
+      if (isClipValid)
+        doCmd->fillAll(&ctx);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_I:
+    {
+      RasterPaintCmd_FillNormalizedBoxI* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedBoxI*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedBoxI);
+
+      BoxI box(UNINITIALIZED);
+      if (isClipValid && BoxI::intersect(box, cmd->getPath(), ctx.clipBoxI))
+        doCmd->fillNormalizedBoxI(&ctx, &box);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_F:
+    {
+      RasterPaintCmd_FillNormalizedBoxF* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedBoxF*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedBoxF);
+
+      BoxF box(UNINITIALIZED);
+      if (isClipValid && BoxF::intersect(box, cmd->getPath(), BoxF(ctx.clipBoxI)))
+        doCmd->fillNormalizedBoxF(&ctx, &box);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_D:
+    {
+      RasterPaintCmd_FillNormalizedBoxD* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedBoxD*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedBoxD);
+
+      BoxD box(UNINITIALIZED);
+      if (isClipValid && BoxD::intersect(box, cmd->getPath(), BoxD(ctx.clipBoxI)))
+        doCmd->fillNormalizedBoxD(&ctx, &box);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F:
+    {
+      RasterPaintCmd_FillNormalizedPathF* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedPathF*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedPathF);
+
+      if (!isClipValid)
+        break;
+
+      // The path is clipped by the master to the clip-box, but not to the
+      // band. The rasterizer only clamps the vertices to the scene-box, so
+      // the path must be clipped here to get the correct coverage.
+      const PathF& path = cmd->getPath();
+      const PointF& pt = cmd->getPoint();
+
+      BoxF clipBox(ctx.clipBoxI);
+      clipBox.translate(-pt.x, -pt.y);
+
+      PathClipperF clipper(clipBox);
+      switch (clipper.measurePath(path))
+      {
+        case PATH_CLIPPER_MEASURE_BOUNDED:
+          doCmd->fillNormalizedPathF(&ctx, &path, &pt, cmd->getFillRule());
+          break;
+
+        case PATH_CLIPPER_MEASURE_UNBOUNDED:
+        {
+          PathF* tmp = &ctx.tmpPathF[0];
+          tmp->clear();
+
+          if (clipper.continuePath(*tmp, path) == ERR_OK && !tmp->isEmpty())
+            doCmd->fillNormalizedPathF(&ctx, tmp, &pt, cmd->getFillRule());
+          break;
+        }
+
+        default:
+          break;
+      }
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D:
+    {
+      RasterPaintCmd_FillNormalizedPathD* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedPathD*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedPathD);
+
+      if (!isClipValid)
+        break;
+
+      const PathD& path = cmd->getPath();
+      const PointD& pt = cmd->getPoint();
+
+      BoxD clipBox(ctx.clipBoxI);
+      clipBox.translate(-pt.x, -pt.y);
+
+      PathClipperD clipper(clipBox);
+      switch (clipper.measurePath(path))
+      {
+        case PATH_CLIPPER_MEASURE_BOUNDED:
+          doCmd->fillNormalizedPathD(&ctx, &path, &pt, cmd->getFillRule());
+          break;
+
+        case PATH_CLIPPER_MEASURE_UNBOUNDED:
+        {
+          PathD* tmp = &ctx.tmpPathD[0];
+          tmp->clear();
+
+          if (clipper.continuePath(*tmp, path) == ERR_OK && !tmp->isEmpty())
+            doCmd->fillNormalizedPathD(&ctx, tmp, &pt, cmd->getFillRule());
+          break;
+        }
+
+        default:
+          break;
+      }
+      break;
+    }
+
+    case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F:
+    {
+      RasterPaintCmd_StrokeHairlinePathF* cmd =
+        reinterpret_cast<RasterPaintCmd_StrokeHairlinePathF*>(p);
+      p += sizeof(RasterPaintCmd_StrokeHairlinePathF);
+
+      // The hairline rasterizer clamps the coverage to the scene-box, which
+      // is the band, so the path doesn't need to be clipped here.
+      if (isClipValid)
+        doCmd->strokeHairlinePathF(&ctx, &cmd->getPath(), &cmd->getHairline());
+      break;
+    }
+
+    case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D:
+    {
+      RasterPaintCmd_StrokeHairlinePathD* cmd =
+        reinterpret_cast<RasterPaintCmd_StrokeHairlinePathD*>(p);
+      p += sizeof(RasterPaintCmd_StrokeHairlinePathD);
+
+      if (isClipValid)
+        doCmd->strokeHairlinePathD(&ctx, &cmd->getPath(), &cmd->getHairline());
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_COVERAGE:
+    {
+      RasterPaintCmd_FillCoverage* cmd =
+        reinterpret_cast<RasterPaintCmd_FillCoverage*>(p);
+      p += sizeof(RasterPaintCmd_FillCoverage);
+
+      // The coverage rasterizer clips the rows to the scene-box (band).
+      if (isClipValid)
+        doCmd->fillCoverage(&ctx, cmd->getCoverage());
+      break;
+    }
+
+    case RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A:
+    {
+      RasterPaintCmd_FillNormalizedMaskA* cmd =
+        reinterpret_cast<RasterPaintCmd_FillNormalizedMaskA*>(p);
+      p += sizeof(RasterPaintCmd_FillNormalizedMaskA);
+
+      if (!isClipValid)
+        break;
+
+      const PointI& pt = cmd->getPt();
+      RectI maskFragment = cmd->getMaskFragment();
+      BoxI box(pt.x, pt.y, pt.x + maskFragment.w, pt.y + maskFragment.h);
+
+      if (!BoxI::intersect(box, box, ctx.clipBoxI))
+        break;
+
+      PointI dstPt(box.x0, box.y0);
+      maskFragment.x += box.x0 - pt.x;
+      maskFragment.y += box.y0 - pt.y;
+      maskFragment.w = box.getWidth();
+      maskFragment.h = box.getHeight();
+
+      doCmd->fillNormalizedMaskA(&ctx, &dstPt, &cmd->getMask(), &maskFragment);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A:
+    case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A:
+    {
+      RasterPaintCmd_BlitNormalizedImageA* cmd =
+        reinterpret_cast<RasterPaintCmd_BlitNormalizedImageA*>(p);
+
+      const Image& srcImage = cmd->getSrcImage();
+      RectI srcFragment(0, 0, srcImage.getWidth(), srcImage.getHeight());
+
+      if (cmd->getCommand() == RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A)
+      {
+        srcFragment = static_cast<RasterPaintCmd_BlitNormalizedImageFragmentA*>(cmd)->getSrcFragment();
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageFragmentA);
+      }
+      else
+      {
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageA);
+      }
+
+      if (!isClipValid)
+        break;
+
+      const PointI& pt = cmd->getPt();
+      BoxI box(pt.x, pt.y, pt.x + srcFragment.w, pt.y + srcFragment.h);
+
+      if (!BoxI::intersect(box, box, ctx.clipBoxI))
+        break;
+
+      PointI dstPt(box.x0, box.y0);
+      srcFragment.x += box.x0 - pt.x;
+      srcFragment.y += box.y0 - pt.y;
+      srcFragment.w = box.getWidth();
+      srcFragment.h = box.getHeight();
+
+      doCmd->blitNormalizedImageA(&ctx, &dstPt, &srcImage, &srcFragment);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I:
+    {
+      RasterPaintCmd_BlitNormalizedImageI* cmd =
+        reinterpret_cast<RasterPaintCmd_BlitNormalizedImageI*>(p);
+      p += sizeof(RasterPaintCmd_BlitNormalizedImageI);
+
+      BoxI box(UNINITIALIZED);
+      if (isClipValid && BoxI::intersect(box, cmd->getBox(), ctx.clipBoxI))
+      {
+        doCmd->blitNormalizedImageI(&ctx, &box,
+          &cmd->getSrcImage(), &cmd->getSrcFragment(), &cmd->getSrcTransform(), cmd->getImageQuality());
+      }
+      break;
+    }
+
+    case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D:
+    {
+      RasterPaintCmd_BlitNormalizedImageD* cmd =
+        reinterpret_cast<RasterPaintCmd_BlitNormalizedImageD*>(p);
+      p += sizeof(RasterPaintCmd_BlitNormalizedImageD);
+
+      BoxD box(UNINITIALIZED);
+      if (isClipValid && BoxD::intersect(box, cmd->getBox(), BoxD(ctx.clipBoxI)))
+      {
+        doCmd->blitNormalizedImageD(&ctx, &box,
+          &cmd->getSrcImage(), &cmd->getSrcFragment(), &cmd->getSrcTransform(), cmd->getImageQuality());
+      }
+      break;
+    }
+
+    case RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A:
+    {
+      RasterPaintCmd_BlitNormalizedMaskedImageA* cmd =
+        reinterpret_cast<RasterPaintCmd_BlitNormalizedMaskedImageA*>(p);
+      p += sizeof(RasterPaintCmd_BlitNormalizedMaskedImageA);
+
+      if (!isClipValid)
+        break;
+
+      const PointI& pt = cmd->getPt();
+      RectI srcFragment = cmd->getSrcFragment();
+      RectI maskFragment = cmd->getMaskFragment();
+      BoxI box(pt.x, pt.y, pt.x + srcFragment.w, pt.y + srcFragment.h);
+
+      if (!BoxI::intersect(box, box, ctx.clipBoxI))
+        break;
+
+      PointI dstPt(box.x0, box.y0);
+      srcFragment.x += box.x0 - pt.x;
+      srcFragment.y += box.y0 - pt.y;
+      srcFragment.w = box.getWidth();
+      srcFragment.h = box.getHeight();
+
+      maskFragment.x += box.x0 - pt.x;
+      maskFragment.y += box.y0 - pt.y;
+      maskFragment.w = box.getWidth();
+      maskFragment.h = box.getHeight();
+
+      doCmd->blitNormalizedMaskedImageA(&ctx, &dstPt,
+        &cmd->getSrcImage(), &srcFragment, &cmd->getMask(), &maskFragment);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_CLIP_BOX:
+    {
+      RasterPaintCmd_SetClipBox* cmd =
+        reinterpret_cast<RasterPaintCmd_SetClipBox*>(p);
+      p += sizeof(RasterPaintCmd_SetClipBox);
+
+      ctx.clipType = RASTER_CLIP_BOX;
+      ctx.resetClipMask();
+      isClipValid = BoxI::intersect(ctx.clipBoxI, cmd->getClipBox(), band);
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_CLIP_REGION:
+    {
+      RasterPaintCmd_SetClipRegion* cmd =
+        reinterpret_cast<RasterPaintCmd_SetClipRegion*>(p);
+      p += sizeof(RasterPaintCmd_SetClipRegion);
+
+      ctx.resetClipMask();
+      isClipValid = RasterPaintWorker_setClipRegion(this, cmd->getClipRegion());
+      break;
+    }
+
+    case RASTER_PAINT_CMD_SET_CLIP_MASK:
+    {
+      RasterPaintCmd_SetClipMask* cmd =
+        reinterpret_cast<RasterPaintCmd_SetClipMask*>(p);
+      p += sizeof(RasterPaintCmd_SetClipMask);
+
+      // The clip-mask is shared (read-only) by all workers, only the clip-box
+      // is clipped to the band.
+      RasterClipMask* mask = cmd->getClipMask();
+
+      ctx.clipType = RASTER_CLIP_MASK;
+      ctx.setClipMask(mask->addRef());
+      isClipValid = BoxI::intersect(ctx.clipBoxI, mask->getBoundingBox(), band);
+      break;
+    }
+  }
+
+  return p;
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr - Helpers]
+// ============================================================================
+
+static void RasterPaintWorkMgr_destroyCommands(RasterPaintEngine* engine, uint8_t* p, uint8_t* pEnd)
+{
+  while (p != pEnd)
+  {
+    switch (reinterpret_cast<RasterPaintCmd*>(p)->getCommand())
+    {
+      case RASTER_PAINT_CMD_NULL:
+      default:
+      {
+        FOG_ASSERT_NOT_REACHED();
+        return;
+      }
+
+#define _FOG_RASTER_DESTROY_CMD(_Id_, _Type_) \
+      case _Id_: \
+      { \
+        reinterpret_cast<_Type_*>(p)->destroy(engine); \
+        p += sizeof(_Type_); \
+        break; \
+      }
+
+      case RASTER_PAINT_CMD_NEXT:
+      {
+        p = reinterpret_cast<RasterPaintCmd_Next*>(p)->getPtr();
+        break;
+      }
+
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_OPACITY                     , RasterPaintCmd_SetOpacity)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB32          , RasterPaintCmd_SetOpacityAndPrgb32)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64          , RasterPaintCmd_SetOpacityAndPrgb64)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN         , RasterPaintCmd_SetOpacityAndPattern)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_PAINT_HINTS                 , RasterPaintCmd_SetPaintHints)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_ALL                        , RasterPaintCmd_FillAll)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_I           , RasterPaintCmd_FillNormalizedBoxI)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_F           , RasterPaintCmd_FillNormalizedBoxF)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_D           , RasterPaintCmd_FillNormalizedBoxD)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F          , RasterPaintCmd_FillNormalizedPathF)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D          , RasterPaintCmd_FillNormalizedPathD)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F          , RasterPaintCmd_StrokeHairlinePathF)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D          , RasterPaintCmd_StrokeHairlinePathD)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_COVERAGE                   , RasterPaintCmd_FillCoverage)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A          , RasterPaintCmd_FillNormalizedMaskA)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A         , RasterPaintCmd_BlitNormalizedImageA)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A, RasterPaintCmd_BlitNormalizedImageFragmentA)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I         , RasterPaintCmd_BlitNormalizedImageI)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D         , RasterPaintCmd_BlitNormalizedImageD)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A  , RasterPaintCmd_BlitNormalizedMaskedImageA)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_CLIP_BOX                    , RasterPaintCmd_SetClipBox)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_CLIP_REGION                 , RasterPaintCmd_SetClipRegion)
+      _FOG_RASTER_DESTROY_CMD(RASTER_PAINT_CMD_SET_CLIP_MASK                   , RasterPaintCmd_SetClipMask)
+
+#undef _FOG_RASTER_DESTROY_CMD
+    }
+  }
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr - Construction / Destruction]
+// ============================================================================
+
+RasterPaintWorkMgr::RasterPaintWorkMgr(RasterPaintEngine* engine) :
+  engine(engine),
+  finishedCondition(&lock),
+  finished(0),
+  count(0),
+  cmdRecord(NULL),
+  cmdStart(NULL),
+  cmdEnd(NULL),
+  cmdCount(0),
+  mode(RASTER_WORK_MODE_BANDS),
+  tilesX(0),
+  tilesY(0),
+  tileCount(0),
+  tiles(NULL),
+  tilesCapacity(0),
+  tileCmds(NULL),
+  tileCmdsCapacity(0),
+  serializedValid(false),
+  serializedOpacity(0),
+  serializedPaintHints(0),
+  serializedPrgb32(0),
+  serializedPrgb64(FOG_UINT64_C(0)),
+  serializedPc(NULL),
+  serializedClipType(RASTER_CLIP_BOX),
+  serializedClipBox(0, 0, 0, 0),
+  serializedClipMask(NULL)
+{
+  tileNext.init(0);
+}
+
+RasterPaintWorkMgr::~RasterPaintWorkMgr()
+{
+  reset();
+
+  if (tiles != NULL)
+    MemMgr::free(tiles);
+
+  if (tileCmds != NULL)
+    MemMgr::free(tileCmds);
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr - Init / Reset]
+// ============================================================================
+
+err_t RasterPaintWorkMgr::init(uint n)
+{
+  FOG_ASSERT(count == 0);
+  FOG_ASSERT(n >= 2 && n <= RASTER_MAX_THREADS_LIMIT);
+
+  ThreadPool* pool = ThreadPool::get();
+  uint i;
+
+  // Acquire as many threads as possible (up to n - 1), the master thread is
+  // the worker #0.
+  for (i = 1; i < n; i++)
+  {
+    if (pool->getThread(&threads[i - 1], (int)i) != ERR_OK)
+      break;
+  }
+
+  if (i < 2)
+    return ERR_RT_OUT_OF_THREADS;
+  n = i;
+
+  for (i = 0; i < n; i++)
+  {
+    workers[i] = fog_new RasterPaintWorker(this, i);
+    if (FOG_IS_NULL(workers[i]))
+      break;
+  }
+
+  if (i != n)
+  {
+    while (i > 0)
+      fog_delete(workers[--i]);
+    pool->releaseThreads(threads, n - 1);
+    return ERR_RT_OUT_OF_MEMORY;
+  }
+
+  count = n;
+  return ERR_OK;
+}
+
+void RasterPaintWorkMgr::reset()
+{
+  if (count == 0)
+    return;
+
+  discard();
+
+  ThreadPool::get()->releaseThreads(threads, count - 1);
+  for (uint i = 0; i < count; i++)
+    fog_delete(workers[i]);
+
+  count = 0;
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr - Flush / Discard]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Get the outermost group or @c NULL if there is no group.
+//!
+//! The batch can be flushed (or discarded) while a group is being recorded.
+//! The group commands are stored in the same allocator after the batch, and
+//! they belong to the group, not to the batch. The batch ends at
+//! @c RasterPaintGroup::cmdPrev of the outermost group.
+static RasterPaintGroup* RasterPaintWorkMgr_getOuterGroup(RasterPaintEngine* engine)
+{
+  RasterPaintGroup* g = engine->curGroup;
+  if (g == &engine->topGroup)
+    return NULL;
+
+  while (g->top != &engine->topGroup)
+    g = g->top;
+  return g;
+}
+
+err_t RasterPaintWorkMgr::flush()
+{
+  if (cmdCount == 0)
+    return ERR_OK;
+
+  FOG_ASSERT(count >= 2);
+
+  RasterPaintGroup* group = RasterPaintWorkMgr_getOuterGroup(engine);
+  cmdEnd = (group != NULL) ? group->cmdPrev : engine->cmdAllocator._pos;
+
+  // Small batches are rendered into bands, bigger batches are binned into
+  // tiles so the destination pixels stay in cache while all commands which
+  // touch them are applied. If binning failed, use bands.
+  mode = RASTER_WORK_MODE_BANDS;
+  if (cmdCount >= RASTER_MIN_TILED_COMMANDS && bin() == ERR_OK)
+    mode = RASTER_WORK_MODE_TILES;
+
+  int w = engine->ctx.target.size.w;
+  int h = engine->ctx.target.size.h;
+
+  err_t err = ERR_OK;
+  uint i;
+
+  // Workers which failed to initialize are not started at all.
+  bool started[RASTER_MAX_THREADS_LIMIT];
+
+  for (i = 0; i < count; i++)
+  {
+    RasterPaintWorker* worker = workers[i];
+
+    // Split the target into horizontal bands, one per worker (the band is
+    // changed per tile in tile mode).
+    int y0 = (int)(((uint64_t)(uint)h * i) / count);
+    int y1 = (int)(((uint64_t)(uint)h * (i + 1)) / count);
+    worker->band.setBox(0, y0, w, y1);
+
+    err_t workerErr = worker->ctx._initByMaster(engine->ctx);
+    started[i] = (workerErr == ERR_OK);
+
+    if (FOG_IS_ERROR(workerErr))
+      err = workerErr;
+  }
+
+  finished = 0;
+  tileNext.set(0);
+
+  for (i = 1; i < count; i++)
+  {
+    if (!started[i])
+      finished++;
+  }
+
+  for (i = 1; i < count; i++)
+  {
+    if (!started[i])
+      continue;
+
+    RasterPaintTask* task = fog_new RasterPaintTask(workers[i]);
+    if (FOG_IS_NULL(task))
+    {
+      // Render the band by the master thread if the task can't be created.
+      workers[i]->run();
+      continue;
+    }
+
+    if (threads[i - 1]->getEventLoop().postTask(task) != ERR_OK)
+    {
+      // The task is not destroyed by a failed postTask().
+      fog_delete(task);
+      workers[i]->run();
+    }
+  }
+
+  if (started[0])
+  {
+    if (mode == RASTER_WORK_MODE_TILES)
+      workers[0]->processTiles();
+    else
+      workers[0]->process();
+  }
+
+  {
+    AutoLock locked(lock);
+    while (finished != count - 1)
+      finishedCondition.wait();
+  }
+
+  discard();
+  return err;
+}
+
+void RasterPaintWorkMgr::discard()
+{
+  if (cmdCount == 0)
+    return;
+
+  RasterPaintGroup* group = RasterPaintWorkMgr_getOuterGroup(engine);
+
+  if (group == NULL)
+  {
+    RasterPaintWorkMgr_destroyCommands(engine, cmdStart, engine->cmdAllocator._pos);
+    engine->cmdAllocator.revert(cmdRecord);
+  }
+  else
+  {
+    // The allocator can't be reverted, because the group commands follow the
+    // batch. The memory is released when the outermost group is painted (or
+    // discarded) and the group reverts the allocator to the batch record.
+    RasterPaintWorkMgr_destroyCommands(engine, cmdStart, group->cmdPrev);
+    group->cmdRecord = cmdRecord;
+  }
+
+  cmdRecord = NULL;
+  cmdStart = NULL;
+  cmdEnd = NULL;
+  cmdCount = 0;
+
+  // Pattern contexts referenced by the serialized-state could be destroyed.
+  serializedValid = false;
+  serializedPc = NULL;
+  serializedClipRegion.reset();
+  serializedClipMask = NULL;
+}
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr - Bin]
+// ============================================================================
+
+template<bool Store>
+static void RasterPaintWorkMgr_binCommands(RasterPaintWorkMgr* wm)
+{
+  RasterPaintTile* tiles = wm->tiles;
+  uint8_t** tileCmds = wm->tileCmds;
+
+  size_t tileIndex;
+  for (tileIndex = 0; tileIndex < wm->tileCount; tileIndex++)
+  {
+    RasterPaintTile& tile = tiles[tileIndex];
+
+    tile.length = 0;
+    tile.lastSource = NULL;
+    tile.lastOpacity = NULL;
+    tile.lastHints = NULL;
+    tile.lastClip = NULL;
+  }
+
+  // The last state commands, these are binned lazily into each tile before
+  // the first command which touches the tile and requires them.
+  uint8_t* curSource = NULL;
+  uint8_t* curOpacity = NULL;
+  uint8_t* curHints = NULL;
+  uint8_t* curClip = NULL;
+
+  BoxI clipBox(0, 0, wm->engine->ctx.target.size.w, wm->engine->ctx.target.size.h);
+  BoxI box(UNINITIALIZED);
+
+  uint8_t* p = wm->cmdStart;
+  uint8_t* pEnd = wm->cmdEnd;
+
+  while (p != pEnd)
+  {
+    uint8_t* cmdPtr = p;
+
+    switch (reinterpret_cast<RasterPaintCmd*>(p)->getCommand())
+    {
+      case RASTER_PAINT_CMD_NULL:
+      default:
+      {
+        FOG_ASSERT_NOT_REACHED();
+        return;
+      }
+
+      case RASTER_PAINT_CMD_NEXT:
+      {
+        p = reinterpret_cast<RasterPaintCmd_Next*>(p)->getPtr();
+        continue;
+      }
+
+      // ----------------------------------------------------------------------
+      // [State]
+      // ----------------------------------------------------------------------
+
+      case RASTER_PAINT_CMD_SET_OPACITY:
+      {
+        p += sizeof(RasterPaintCmd_SetOpacity);
+        curOpacity = cmdPtr;
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB32:
+      {
+        p += sizeof(RasterPaintCmd_SetOpacityAndPrgb32);
+        curSource = cmdPtr;
+        curOpacity = cmdPtr;
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64:
+      {
+        p += sizeof(RasterPaintCmd_SetOpacityAndPrgb64);
+        curSource = cmdPtr;
+        curOpacity = cmdPtr;
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN:
+      {
+        p += sizeof(RasterPaintCmd_SetOpacityAndPattern);
+        curSource = cmdPtr;
+        curOpacity = cmdPtr;
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_PAINT_HINTS:
+      {
+        p += sizeof(RasterPaintCmd_SetPaintHints);
+        curHints = cmdPtr;
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_CLIP_BOX:
+      {
+        RasterPaintCmd_SetClipBox* cmd =
+          reinterpret_cast<RasterPaintCmd_SetClipBox*>(p);
+        p += sizeof(RasterPaintCmd_SetClipBox);
+
+        curClip = cmdPtr;
+        clipBox = cmd->getClipBox();
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_CLIP_REGION:
+      {
+        RasterPaintCmd_SetClipRegion* cmd =
+          reinterpret_cast<RasterPaintCmd_SetClipRegion*>(p);
+        p += sizeof(RasterPaintCmd_SetClipRegion);
+
+        curClip = cmdPtr;
+        clipBox = cmd->getClipRegion().getBoundingBox();
+        continue;
+      }
+
+      case RASTER_PAINT_CMD_SET_CLIP_MASK:
+      {
+        RasterPaintCmd_SetClipMask* cmd =
+          reinterpret_cast<RasterPaintCmd_SetClipMask*>(p);
+        p += sizeof(RasterPaintCmd_SetClipMask);
+
+        curClip = cmdPtr;
+        clipBox = cmd->getClipMask()->getBoundingBox();
+        continue;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Fill]
+      // ----------------------------------------------------------------------
+
+      case RASTER_PAINT_CMD_FILL_ALL:
+      {
+        p += sizeof(RasterPaintCmd_FillAll);
+        box = clipBox;
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_I:
+      {
+        RasterPaintCmd_FillNormalizedBoxI* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedBoxI*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedBoxI);
+
+        box = cmd->getPath();
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_F:
+      {
+        RasterPaintCmd_FillNormalizedBoxF* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedBoxF*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedBoxF);
+
+        const BoxF& b = cmd->getPath();
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_D:
+      {
+        RasterPaintCmd_FillNormalizedBoxD* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedBoxD*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedBoxD);
+
+        const BoxD& b = cmd->getPath();
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F:
+      {
+        RasterPaintCmd_FillNormalizedPathF* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedPathF*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedPathF);
+
+        BoxF b(UNINITIALIZED);
+        if (cmd->getPath().getBoundingBox(b) != ERR_OK)
+          continue;
+
+        b.translate(cmd->getPoint().x, cmd->getPoint().y);
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D:
+      {
+        RasterPaintCmd_FillNormalizedPathD* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedPathD*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedPathD);
+
+        BoxD b(UNINITIALIZED);
+        if (cmd->getPath().getBoundingBox(b) != ERR_OK)
+          continue;
+
+        b.translate(cmd->getPoint().x, cmd->getPoint().y);
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F:
+      {
+        RasterPaintCmd_StrokeHairlinePathF* cmd =
+          reinterpret_cast<RasterPaintCmd_StrokeHairlinePathF*>(p);
+        p += sizeof(RasterPaintCmd_StrokeHairlinePathF);
+
+        BoxF b(UNINITIALIZED);
+        if (cmd->getPath().getBoundingBox(b) != ERR_OK)
+          continue;
+
+        float e = float(cmd->getHairline().lineWidth * 0.5 + 1.0);
+        b.expand(e);
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D:
+      {
+        RasterPaintCmd_StrokeHairlinePathD* cmd =
+          reinterpret_cast<RasterPaintCmd_StrokeHairlinePathD*>(p);
+        p += sizeof(RasterPaintCmd_StrokeHairlinePathD);
+
+        BoxD b(UNINITIALIZED);
+        if (cmd->getPath().getBoundingBox(b) != ERR_OK)
+          continue;
+
+        double e = double(cmd->getHairline().lineWidth * 0.5 + 1.0);
+        b.expand(e);
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_COVERAGE:
+      {
+        RasterPaintCmd_FillCoverage* cmd =
+          reinterpret_cast<RasterPaintCmd_FillCoverage*>(p);
+        p += sizeof(RasterPaintCmd_FillCoverage);
+
+        box = cmd->getCoverage()->boundingBox;
+        break;
+      }
+
+      case RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A:
+      {
+        RasterPaintCmd_FillNormalizedMaskA* cmd =
+          reinterpret_cast<RasterPaintCmd_FillNormalizedMaskA*>(p);
+        p += sizeof(RasterPaintCmd_FillNormalizedMaskA);
+
+        const PointI& pt = cmd->getPt();
+        const RectI& maskFragment = cmd->getMaskFragment();
+        box.setBox(pt.x, pt.y, pt.x + maskFragment.w, pt.y + maskFragment.h);
+        break;
+      }
+
+      // ----------------------------------------------------------------------
+      // [Blit]
+      // ----------------------------------------------------------------------
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A:
+      {
+        RasterPaintCmd_BlitNormalizedImageA* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedImageA*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageA);
+
+        const PointI& pt = cmd->getPt();
+        const Image& srcImage = cmd->getSrcImage();
+        box.setBox(pt.x, pt.y, pt.x + srcImage.getWidth(), pt.y + srcImage.getHeight());
+        break;
+      }
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A:
+      {
+        RasterPaintCmd_BlitNormalizedImageFragmentA* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedImageFragmentA*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageFragmentA);
+
+        const PointI& pt = cmd->getPt();
+        const RectI& srcFragment = cmd->getSrcFragment();
+        box.setBox(pt.x, pt.y, pt.x + srcFragment.w, pt.y + srcFragment.h);
+        break;
+      }
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I:
+      {
+        RasterPaintCmd_BlitNormalizedImageI* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedImageI*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageI);
+
+        box = cmd->getBox();
+        break;
+      }
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D:
+      {
+        RasterPaintCmd_BlitNormalizedImageD* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedImageD*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedImageD);
+
+        const BoxD& b = cmd->getBox();
+        box.setBox(Math::ifloor(b.x0), Math::ifloor(b.y0), Math::iceil(b.x1), Math::iceil(b.y1));
+        break;
+      }
+
+      case RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A:
+      {
+        RasterPaintCmd_BlitNormalizedMaskedImageA* cmd =
+          reinterpret_cast<RasterPaintCmd_BlitNormalizedMaskedImageA*>(p);
+        p += sizeof(RasterPaintCmd_BlitNormalizedMaskedImageA);
+
+        const PointI& pt = cmd->getPt();
+        const RectI& srcFragment = cmd->getSrcFragment();
+        box.setBox(pt.x, pt.y, pt.x + srcFragment.w, pt.y + srcFragment.h);
+        break;
+      }
+    }
+
+    // ------------------------------------------------------------------------
+    // [Bin]
+    // ------------------------------------------------------------------------
+
+    if (!BoxI::intersect(box, box, clipBox))
+      continue;
+
+    uint tx0 = (uint)box.x0 >> RASTER_TILE_SHIFT;
+    uint ty0 = (uint)box.y0 >> RASTER_TILE_SHIFT;
+    uint tx1 = (uint)(box.x1 - 1) >> RASTER_TILE_SHIFT;
+    uint ty1 = (uint)(box.y1 - 1) >> RASTER_TILE_SHIFT;
+
+    for (uint ty = ty0; ty <= ty1; ty++)
+    {
+      RasterPaintTile* tile = &tiles[ty * wm->tilesX + tx0];
+
+      for (uint tx = tx0; tx <= tx1; tx++, tile++)
+      {
+#define _FOG_RASTER_BIN_CMD(_Ptr_) \
+        FOG_MACRO_BEGIN \
+          if (Store) \
+            tileCmds[tile->offset + tile->length] = _Ptr_; \
+          tile->length++; \
+        FOG_MACRO_END
+
+        // The source command also sets the opacity, but it can't be newer
+        // than the current opacity command.
+        if (tile->lastSource != curSource)
+        {
+          _FOG_RASTER_BIN_CMD(curSource);
+          tile->lastSource = curSource;
+
+          if (curSource == curOpacity)
+            tile->lastOpacity = curOpacity;
+        }
+
+        if (tile->lastOpacity != curOpacity)
+        {
+          _FOG_RASTER_BIN_CMD(curOpacity);
+          tile->lastOpacity = curOpacity;
+        }
+
+        if (tile->lastHints != curHints)
+        {
+          _FOG_RASTER_BIN_CMD(curHints);
+          tile->lastHints = curHints;
+        }
+
+        if (tile->lastClip != curClip)
+        {
+          _FOG_RASTER_BIN_CMD(curClip);
+          tile->lastClip = curClip;
+        }
+
+        _FOG_RASTER_BIN_CMD(cmdPtr);
+#undef _FOG_RASTER_BIN_CMD
+      }
+    }
+  }
+}
+
+err_t RasterPaintWorkMgr::bin()
+{
+  int w = engine->ctx.target.size.w;
+  int h = engine->ctx.target.size.h;
+
+  tilesX = (uint)(w + RASTER_TILE_SIZE - 1) >> RASTER_TILE_SHIFT;
+  tilesY = (uint)(h + RASTER_TILE_SIZE - 1) >> RASTER_TILE_SHIFT;
+  tileCount = (size_t)tilesX * tilesY;
+
+  if (tileCount > tilesCapacity)
+  {
+    RasterPaintTile* newTiles = static_cast<RasterPaintTile*>(
+      MemMgr::realloc(tiles, tileCount * sizeof(RasterPaintTile)));
+
+    if (FOG_IS_NULL(newTiles))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    tiles = newTiles;
+    tilesCapacity = tileCount;
+  }
+
+  // The first pass only counts the commands binned into each tile.
+  RasterPaintWorkMgr_binCommands<false>(this);
+
+  size_t i;
+  size_t total = 0;
+
+  for (i = 0; i < tileCount; i++)
+  {
+    tiles[i].offset = (uint32_t)total;
+    total += tiles[i].length;
+  }
+
+  if (total > tileCmdsCapacity)
+  {
+    uint8_t** newTileCmds = static_cast<uint8_t**>(
+      MemMgr::realloc(tileCmds, total * sizeof(uint8_t*)));
+
+    if (FOG_IS_NULL(newTileCmds))
+      return ERR_RT_OUT_OF_MEMORY;
+
+    tileCmds = newTileCmds;
+    tileCmdsCapacity = total;
+  }
+
+  // The second pass stores the commands.
+  RasterPaintWorkMgr_binCommands<true>(this);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRenderMT - Serialize]
+// ============================================================================
+
+#define _FOG_RASTER_MT_NEW_CMD(_Type_, _Cmd_) \
+  _Type_* _Cmd_ = engine->newCmd<_Type_>(); \
+  \
+  if (FOG_IS_NULL(_Cmd_)) \
+    return ERR_RT_OUT_OF_MEMORY; \
+  wm->cmdCount++;
+
+//! @internal
+//!
+//! @brief Serialize the master state (opacity, source, paint hints and clip)
+//! needed by the next command. Only states which differ from the last
+//! serialized states are serialized.
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_serializeState(RasterPaintEngine* engine, bool needSource)
+{
+  RasterPaintWorkMgr* wm = engine->wm;
+  RasterPaintContext* ctx = &engine->ctx;
+
+  if (wm->cmdCount >= RASTER_MAX_BATCH_COMMANDS)
+    FOG_RETURN_ON_ERROR(wm->flush());
+
+  wm->ensureBatch(engine->cmdAllocator);
+  bool valid = wm->serializedValid;
+
+  // --------------------------------------------------------------------------
+  // [Opacity & Source]
+  // --------------------------------------------------------------------------
+
+  uint32_t opacity = ctx->rasterHints.opacity;
+
+  if (needSource && RasterUtil::isSolidContext(ctx->pc) && ctx->precision == IMAGE_PRECISION_WORD)
+  {
+    uint64_t prgb64 = ctx->solid.prgb64.u64;
+
+    if (!valid || !RasterUtil::isSolidContext(wm->serializedPc) || wm->serializedPrgb64 != prgb64)
+    {
+      _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetOpacityAndPrgb64, cmd)
+      cmd->init(engine, RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB64, opacity, ctx->solid.prgb64);
+
+      wm->serializedPc = ctx->pc;
+      wm->serializedPrgb64 = prgb64;
+      wm->serializedOpacity = opacity;
+    }
+  }
+  else if (needSource && RasterUtil::isSolidContext(ctx->pc))
+  {
+    uint32_t prgb32 = ctx->solid.prgb32.u32;
+
+    if (!valid || !RasterUtil::isSolidContext(wm->serializedPc) || wm->serializedPrgb32 != prgb32)
+    {
+      _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetOpacityAndPrgb32, cmd)
+      cmd->init(engine, RASTER_PAINT_CMD_SET_OPACITY_AND_PRGB32, opacity, prgb32);
+
+      wm->serializedPc = ctx->pc;
+      wm->serializedPrgb32 = prgb32;
+      wm->serializedOpacity = opacity;
+    }
+  }
+  else if (needSource)
+  {
+    _FOG_RASTER_ENSURE_PATTERN(ctx);
+
+    if (!valid || wm->serializedPc != ctx->pc)
+    {
+      _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetOpacityAndPattern, cmd)
+      cmd->init(engine, RASTER_PAINT_CMD_SET_OPACITY_AND_PATTERN, opacity, ctx->pc);
+
+      wm->serializedPc = ctx->pc;
+      wm->serializedOpacity = opacity;
+    }
+  }
+
+  if (!valid || wm->serializedOpacity != opacity)
+  {
+    _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetOpacity, cmd)
+    cmd->init(engine, RASTER_PAINT_CMD_SET_OPACITY, opacity);
+
+    wm->serializedOpacity = opacity;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Paint Hints]
+  // --------------------------------------------------------------------------
+
+  if (!valid || wm->serializedPaintHints != ctx->paintHints.packed)
+  {
+    _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetPaintHints, cmd)
+    cmd->init(engine, RASTER_PAINT_CMD_SET_PAINT_HINTS, ctx->paintHints);
+
+    wm->serializedPaintHints = ctx->paintHints.packed;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Clip]
+  // --------------------------------------------------------------------------
+
+  switch (ctx->clipType)
+  {
+    case RASTER_CLIP_BOX:
+    {
+      if (!valid || wm->serializedClipType != RASTER_CLIP_BOX || wm->serializedClipBox != ctx->clipBoxI)
+      {
+        _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetClipBox, cmd)
+        cmd->init(engine, RASTER_PAINT_CMD_SET_CLIP_BOX, ctx->clipBoxI);
+
+        wm->serializedClipType = RASTER_CLIP_BOX;
+        wm->serializedClipBox = ctx->clipBoxI;
+      }
+      break;
+    }
+
+    case RASTER_CLIP_REGION:
+    {
+      if (!valid || wm->serializedClipType != RASTER_CLIP_REGION || !wm->serializedClipRegion.eq(ctx->clipRegion))
+      {
+        _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetClipRegion, cmd)
+        cmd->init(engine, RASTER_PAINT_CMD_SET_CLIP_REGION, ctx->clipRegion);
+
+        wm->serializedClipType = RASTER_CLIP_REGION;
+        wm->serializedClipRegion = ctx->clipRegion;
+      }
+      break;
+    }
+
+    case RASTER_CLIP_MASK:
+    {
+      // The serialized command holds a reference to the clip-mask so it can't
+      // be changed in place until the commands are destroyed, comparing the
+      // pointer is enough.
+      if (!valid || wm->serializedClipType != RASTER_CLIP_MASK || wm->serializedClipMask != ctx->clipMask)
+      {
+        _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_SetClipMask, cmd)
+        cmd->init(engine, RASTER_PAINT_CMD_SET_CLIP_MASK, ctx->clipMask);
+
+        wm->serializedClipType = RASTER_CLIP_MASK;
+        wm->serializedClipMask = ctx->clipMask;
+      }
+      break;
+    }
+
+    default:
+      FOG_ASSERT_NOT_REACHED();
+  }
+
+  wm->serializedValid = true;
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRenderMT - Fill]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillAll(
+  RasterPaintContext* ctx)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillAll, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_ALL);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedBoxI(
+  RasterPaintContext* ctx, const BoxI* box)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedBoxI, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_I, *box);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedBoxF(
+  RasterPaintContext* ctx, const BoxF* box)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedBoxF, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_F, *box);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedBoxD(
+  RasterPaintContext* ctx, const BoxD* box)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedBoxD, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_BOX_D, *box);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedPathF(
+  RasterPaintContext* ctx, const PathF* path, const PointF* pt, uint32_t fillRule)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedPathF, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_F, *path, *pt, fillRule);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedPathD(
+  RasterPaintContext* ctx, const PathD* path, const PointD* pt, uint32_t fillRule)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedPathD, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_PATH_D, *path, *pt, fillRule);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillNormalizedMaskA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* mask, const RectI* maskFragment)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillNormalizedMaskA, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_NORMALIZED_MASK_A, *pt, *mask, *maskFragment);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_strokeHairlinePathF(
+  RasterPaintContext* ctx, const PathF* path, const RasterHairline* hairline)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_StrokeHairlinePathF, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_F, *path, *hairline);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_strokeHairlinePathD(
+  RasterPaintContext* ctx, const PathD* path, const RasterHairline* hairline)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_StrokeHairlinePathD, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_STROKE_HAIRLINE_PATH_D, *path, *hairline);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_fillCoverage(
+  RasterPaintContext* ctx, const RasterCoverage* coverage)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  if (!coverage->boundingBox.isValid())
+    return ERR_OK;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, true));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_FillCoverage, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_FILL_COVERAGE, coverage);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRenderMT - Blit]
+// ============================================================================
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitImageD(
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+{
+  // The blit depends on the master's final transform and clip-box, which are
+  // not serialized, so flush and render synchronously.
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].blitImageD(ctx, box, srcImage, srcFragment, srcTransform, imageQuality);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitNormalizedImageA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, false));
+
+  const ImageData* srcD = srcImage->_d;
+
+  if (srcFragment->x == 0 &&
+      srcFragment->y == 0 &&
+      srcFragment->w == srcD->size.w &&
+      srcFragment->h == srcD->size.h)
+  {
+    _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_BlitNormalizedImageA, cmd)
+    cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_A, *pt, *srcImage);
+  }
+  else
+  {
+    _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_BlitNormalizedImageFragmentA, cmd)
+    cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_FRAGMENT_A, *pt, *srcImage, *srcFragment);
+  }
+
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitNormalizedImageI(
+  RasterPaintContext* ctx, const BoxI* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, false));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_BlitNormalizedImageI, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_I,
+    *box, *srcImage, *srcFragment, *srcTransform, imageQuality);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitNormalizedImageD(
+  RasterPaintContext* ctx, const BoxD* box, const Image* srcImage, const RectI* srcFragment, const TransformD* srcTransform, uint32_t imageQuality)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, false));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_BlitNormalizedImageD, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_IMAGE_D,
+    *box, *srcImage, *srcFragment, *srcTransform, imageQuality);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitNormalizedMaskedImageA(
+  RasterPaintContext* ctx, const PointI* pt, const Image* srcImage, const RectI* srcFragment, const Image* mask, const RectI* maskFragment)
+{
+  RasterPaintEngine* engine = ctx->engine;
+  RasterPaintWorkMgr* wm = engine->wm;
+
+  FOG_RETURN_ON_ERROR(RasterPaintDoRenderMT_serializeState(engine, false));
+
+  _FOG_RASTER_MT_NEW_CMD(RasterPaintCmd_BlitNormalizedMaskedImageA, cmd)
+  cmd->init(engine, RASTER_PAINT_CMD_BLIT_NORMALIZED_MASKED_IMAGE_A,
+    *pt, *srcImage, *srcFragment, *mask, *maskFragment);
+  return ERR_OK;
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_blitNormalizedSpritesA(
+  RasterPaintContext* ctx, const Image* srcImage, const RasterSprite* sprites, size_t count)
+{
+  // Each sprite is serialized as a normalized image blit, the opacity is
+  // serialized only when it differs from the previous sprite.
+  uint32_t opacity = ctx->rasterHints.opacity;
+  err_t err = ERR_OK;
+
+  for (size_t i = 0; i < count; i++)
+  {
+    ctx->rasterHints.opacity = sprites[i].opacity;
+
+    err = RasterPaintDoRenderMT_blitNormalizedImageA(ctx, &sprites[i].pt, srcImage, &sprites[i].srcFragment);
+    if (FOG_IS_ERROR(err))
+      break;
+  }
+
+  ctx->rasterHints.opacity = opacity;
+  return err;
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRenderMT - Filter]
+// ============================================================================
+
+// Filters read pixels outside of the area they modify (which can be in the
+// band of other worker), so they are always rendered synchronously.
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_filterNormalizedBoxI(
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxI* box)
+{
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].filterNormalizedBoxI(ctx, feBase, box);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_filterNormalizedBoxF(
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxF* box)
+{
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].filterNormalizedBoxF(ctx, feBase, box);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_filterNormalizedBoxD(
+  RasterPaintContext* ctx, const FeBase* feBase, const BoxD* box)
+{
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].filterNormalizedBoxD(ctx, feBase, box);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_filterNormalizedPathF(
+  RasterPaintContext* ctx, const FeBase* feBase, const PathF* path, const PointF* pt, uint32_t fillRule)
+{
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].filterNormalizedPathF(ctx, feBase, path, pt, fillRule);
+}
+
+static err_t FOG_FASTCALL RasterPaintDoRenderMT_filterNormalizedPathD(
+  RasterPaintContext* ctx, const FeBase* feBase, const PathD* path, const PointD* pt, uint32_t fillRule)
+{
+  FOG_RETURN_ON_ERROR(ctx->engine->wm->flush());
+  return RasterPaintDoRender_vtable[RASTER_MODE_ST].filterNormalizedPathD(ctx, feBase, path, pt, fillRule);
+}
+
+// ============================================================================
+// [Fog::RasterPaintDoRenderMT - Init]
+// ============================================================================
+
+void FOG_NO_EXPORT RasterPaintDoRenderMT_init(void)
+{
+  RasterPaintDoCmd* v = &RasterPaintDoRender_vtable[RASTER_MODE_MT];
+
+  // The mask functions don't touch the target pixels and aren't serialized,
+  // use the single-threaded versions.
+  *v = RasterPaintDoRender_vtable[RASTER_MODE_ST];
+
+  // --------------------------------------------------------------------------
+  // [Fill/Stroke]
+  // --------------------------------------------------------------------------
+
+  v->fillAll = RasterPaintDoRenderMT_fillAll;
+  v->fillNormalizedBoxI = RasterPaintDoRenderMT_fillNormalizedBoxI;
+  v->fillNormalizedBoxF = RasterPaintDoRenderMT_fillNormalizedBoxF;
+  v->fillNormalizedBoxD = RasterPaintDoRenderMT_fillNormalizedBoxD;
+  v->fillNormalizedPathF = RasterPaintDoRenderMT_fillNormalizedPathF;
+  v->fillNormalizedPathD = RasterPaintDoRenderMT_fillNormalizedPathD;
+  v->fillNormalizedMaskA = RasterPaintDoRenderMT_fillNormalizedMaskA;
+  v->strokeHairlinePathF = RasterPaintDoRenderMT_strokeHairlinePathF;
+  v->strokeHairlinePathD = RasterPaintDoRenderMT_strokeHairlinePathD;
+  v->fillCoverage = RasterPaintDoRenderMT_fillCoverage;
+
+  // --------------------------------------------------------------------------
+  // [Blit]
+  // --------------------------------------------------------------------------
+
+  v->blitImageD = RasterPaintDoRenderMT_blitImageD;
+  v->blitNormalizedImageA = RasterPaintDoRenderMT_blitNormalizedImageA;
+  v->blitNormalizedImageI = RasterPaintDoRenderMT_blitNormalizedImageI;
+  v->blitNormalizedImageD = RasterPaintDoRenderMT_blitNormalizedImageD;
+  v->blitNormalizedMaskedImageA = RasterPaintDoRenderMT_blitNormalizedMaskedImageA;
+  v->blitNormalizedSpritesA = RasterPaintDoRenderMT_blitNormalizedSpritesA;
+
+  // --------------------------------------------------------------------------
+  // [Filter]
+  // --------------------------------------------------------------------------
+
+  v->filterNormalizedBoxI = RasterPaintDoRenderMT_filterNormalizedBoxI;
+  v->filterNormalizedBoxF = RasterPaintDoRenderMT_filterNormalizedBoxF;
+  v->filterNormalizedBoxD = RasterPaintDoRenderMT_filterNormalizedBoxD;
+  v->filterNormalizedPathF = RasterPaintDoRenderMT_filterNormalizedPathF;
+  v->filterNormalizedPathD = RasterPaintDoRenderMT_filterNormalizedPathD;
+}
+
+} // Fog namespace
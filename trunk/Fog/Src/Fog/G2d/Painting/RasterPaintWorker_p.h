@@ -0,0 +1,314 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERPAINTWORKER_P_H
+#define _FOG_G2D_PAINTING_RASTERPAINTWORKER_P_H
+
+// [Dependencies]
+#include <Fog/Core/Kernel/Task.h>
+#include <Fog/Core/Memory/MemZoneAllocator.h>
+#include <Fog/Core/Threading/Atomic.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Threading/Thread.h>
+#include <Fog/Core/Threading/ThreadCondition.h>
+#include <Fog/G2d/Geometry/Box.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterPaintContext_p.h>
+#include <Fog/G2d/Painting/RasterPaintStructs_p.h>
+#include <Fog/G2d/Painting/RasterStructs_p.h>
+#include <Fog/G2d/Tools/Region.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Forward Declarations]
+// ============================================================================
+
+struct RasterPaintWorkMgr;
+
+// ============================================================================
+// [Fog::RasterPaintWorker]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Raster paint-engine worker.
+//!
+//! The worker owns its own @c RasterPaintContext and replays the command
+//! stream recorded by the master into its horizontal band of the target (or
+//! into tiles, see @c RASTER_WORK_MODE_TILES). The band is applied by
+//! intersecting the clip-box / clip-region of each recorded clip command with
+//! the band box, so the rendering functions used by the single-threaded
+//! paint-engine can be used without any modification.
+//!
+//! The worker is owned by the work manager. It's not a @c Task, each flush
+//! posts a new @c RasterPaintTask which runs the worker.
+struct FOG_NO_EXPORT RasterPaintWorker
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  RasterPaintWorker(RasterPaintWorkMgr* wm, uint workerId);
+  ~RasterPaintWorker();
+
+  // --------------------------------------------------------------------------
+  // [Run]
+  // --------------------------------------------------------------------------
+
+  //! @brief Calls @c process() or @c processTiles() (depending on the work
+  //! mode) and notifies the work manager.
+  void run();
+
+  //! @brief Replay all commands of the current batch into the worker's band.
+  void process();
+  //! @brief Take tiles from the work manager and replay their commands until
+  //! there is no tile left.
+  void processTiles();
+  //! @brief Replay a single command, returns pointer to the next command.
+  uint8_t* processCmd(uint8_t* p);
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief The work manager.
+  RasterPaintWorkMgr* wm;
+  //! @brief The worker id (zero is the master thread).
+  uint workerId;
+
+  //! @brief The band (part of the target) this worker renders to.
+  BoxI band;
+  //! @brief Whether the current clip (intersected with the band) is not empty.
+  bool isClipValid;
+
+  //! @brief The worker context.
+  RasterPaintContext ctx;
+
+private:
+  FOG_NO_COPY(RasterPaintWorker)
+};
+
+// ============================================================================
+// [Fog::RasterPaintTask]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Task posted to the worker thread, runs a @c RasterPaintWorker.
+//!
+//! The task is destroyed by the event loop of the worker thread, because the
+//! event loop accesses the task after @c run() returned. At that time the
+//! master thread may already be done with the batch and the worker may be
+//! released.
+struct FOG_NO_EXPORT RasterPaintTask : public Task
+{
+  FOG_INLINE RasterPaintTask(RasterPaintWorker* worker) :
+    worker(worker)
+  {
+  }
+
+  virtual void run();
+
+  //! @brief The worker to run.
+  RasterPaintWorker* worker;
+};
+
+// ============================================================================
+// [Fog::RasterPaintTile]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Tile used by the tile-binned rendering.
+struct FOG_NO_EXPORT RasterPaintTile
+{
+  //! @brief Index of the first command in @c RasterPaintWorkMgr::tileCmds.
+  uint32_t offset;
+  //! @brief Count of commands binned into the tile.
+  uint32_t length;
+
+  //! @brief The last source command binned into the tile.
+  uint8_t* lastSource;
+  //! @brief The last opacity command binned into the tile.
+  uint8_t* lastOpacity;
+  //! @brief The last paint-hints command binned into the tile.
+  uint8_t* lastHints;
+  //! @brief The last clip command binned into the tile.
+  uint8_t* lastClip;
+};
+
+// ============================================================================
+// [Fog::RasterPaintWorkMgr]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Raster paint-engine work manager.
+//!
+//! The work manager is created when the multithreading is enabled. Painter
+//! commands are recorded into the @c RasterPaintEngine::cmdAllocator stream
+//! by @c RasterPaintDoRender_vtable[RASTER_MODE_MT]. The recorded commands
+//! are called a batch. The batch is rendered when it's flushed; each worker
+//! renders its own band and the master (calling thread) waits until all
+//! workers are done, then the commands are destroyed and the command allocator
+//! is reverted.
+struct FOG_NO_EXPORT RasterPaintWorkMgr
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  RasterPaintWorkMgr(RasterPaintEngine* engine);
+  ~RasterPaintWorkMgr();
+
+  // --------------------------------------------------------------------------
+  // [Init / Reset]
+  // --------------------------------------------------------------------------
+
+  //! @brief Initialize the work manager to use @a count workers (the master
+  //! thread is also a worker).
+  err_t init(uint count);
+  //! @brief Release all threads and workers.
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Batch]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE bool hasCommands() const { return cmdCount != 0; }
+
+  //! @brief Called by the serializer before a command is added to the batch.
+  FOG_INLINE void ensureBatch(MemZoneAllocator& cmdAllocator)
+  {
+    if (cmdCount == 0)
+    {
+      cmdRecord = cmdAllocator.record();
+      cmdStart = cmdAllocator._pos;
+      serializedValid = false;
+    }
+  }
+
+  //! @brief Render and destroy all commands in the current batch.
+  err_t flush();
+
+  //! @brief Destroy all commands in the current batch without rendering.
+  void discard();
+
+  //! @brief Bin all commands of the current batch into tiles.
+  err_t bin();
+
+  // --------------------------------------------------------------------------
+  // [Members - Engine]
+  // --------------------------------------------------------------------------
+
+  //! @brief The master paint-engine.
+  RasterPaintEngine* engine;
+
+  // --------------------------------------------------------------------------
+  // [Members - Synchronization]
+  // --------------------------------------------------------------------------
+
+  //! @brief Lock.
+  Lock lock;
+  //! @brief Condition signaled when the last worker finished.
+  ThreadCondition finishedCondition;
+  //! @brief Count of workers which finished the current batch.
+  uint finished;
+
+  // --------------------------------------------------------------------------
+  // [Members - Workers]
+  // --------------------------------------------------------------------------
+
+  //! @brief Count of workers (including the master thread).
+  uint count;
+
+  //! @brief Threads acquired from @c ThreadPool (count - 1).
+  Thread* threads[RASTER_MAX_THREADS_LIMIT];
+  //! @brief Workers.
+  RasterPaintWorker* workers[RASTER_MAX_THREADS_LIMIT];
+
+  // --------------------------------------------------------------------------
+  // [Members - Batch]
+  // --------------------------------------------------------------------------
+
+  //! @brief Command allocator record (reverted after the batch is done).
+  MemZoneRecord* cmdRecord;
+  //! @brief The first command in the batch.
+  uint8_t* cmdStart;
+  //! @brief The end of the batch (valid only during @c flush()).
+  uint8_t* cmdEnd;
+  //! @brief Count of commands in the batch.
+  uint cmdCount;
+
+  // --------------------------------------------------------------------------
+  // [Members - Tiles]
+  // --------------------------------------------------------------------------
+
+  //! @brief Work mode used by the current flush, see @c RASTER_WORK_MODE.
+  uint32_t mode;
+
+  //! @brief Count of tiles in horizontal direction.
+  uint tilesX;
+  //! @brief Count of tiles in vertical direction.
+  uint tilesY;
+  //! @brief Count of tiles (tilesX * tilesY).
+  size_t tileCount;
+  //! @brief Index of the next tile to process (shared by all workers).
+  Atomic<size_t> tileNext;
+
+  //! @brief Tiles.
+  RasterPaintTile* tiles;
+  //! @brief Capacity of @c tiles.
+  size_t tilesCapacity;
+
+  //! @brief Binned commands, each tile refers to a range of this array.
+  uint8_t** tileCmds;
+  //! @brief Capacity of @c tileCmds.
+  size_t tileCmdsCapacity;
+
+  // --------------------------------------------------------------------------
+  // [Members - Serialized State]
+  // --------------------------------------------------------------------------
+
+  //! @brief Whether the serialized-state is valid (the first command in the
+  //! batch always serializes the complete state).
+  bool serializedValid;
+
+  //! @brief The last serialized opacity.
+  uint32_t serializedOpacity;
+  //! @brief The last serialized paint hints.
+  uint32_t serializedPaintHints;
+  //! @brief The last serialized solid color (if serializedPc is solid).
+  uint32_t serializedPrgb32;
+  //! @brief The last serialized solid color (if serializedPc is solid and
+  //! the precision is @c IMAGE_PRECISION_WORD).
+  uint64_t serializedPrgb64;
+  //! @brief The last serialized pattern context.
+  RasterPattern* serializedPc;
+
+  //! @brief The last serialized clip type.
+  uint32_t serializedClipType;
+  //! @brief The last serialized clip box.
+  BoxI serializedClipBox;
+  //! @brief The last serialized clip region.
+  Region serializedClipRegion;
+  //! @brief The last serialized clip mask (not referenced).
+  RasterClipMask* serializedClipMask;
+
+private:
+  FOG_NO_COPY(RasterPaintWorkMgr)
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERPAINTWORKER_P_H
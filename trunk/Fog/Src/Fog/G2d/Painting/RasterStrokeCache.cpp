@@ -0,0 +1,516 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Precompiled Headers]
+#if defined(FOG_PRECOMP)
+#include FOG_PRECOMP
+#endif // FOG_PRECOMP
+
+// [Dependencies]
+#include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Global/Private.h>
+#include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Threading/Lock.h>
+#include <Fog/Core/Tools/HashUtil.h>
+#include <Fog/G2d/Geometry/Transform.h>
+#include <Fog/G2d/Painting/RasterConstants_p.h>
+#include <Fog/G2d/Painting/RasterStrokeCache_p.h>
+
+namespace Fog {
+
+// ============================================================================
+// [Fog::RasterStrokeCache - Structs]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Stroke-cache key.
+template<typename NumT>
+struct FOG_NO_EXPORT RasterStrokeCache_KeyT
+{
+  enum { VALUE_COUNT = 8 };
+
+  FOG_INLINE void init(const NumT_(Path)& path, const NumT_(PathStroker)& stroker)
+  {
+    const NumT_(PathStrokerParams)& params = stroker.getParams();
+    const NumT_(Transform)& tr = stroker.getTransform();
+
+    pathData = path._d;
+
+    values[0] = params.getLineWidth();
+    values[1] = params.getMiterLimit();
+    values[2] = params.getDashOffset();
+    values[3] = stroker.getFlatness();
+    values[4] = tr._00;
+    values[5] = tr._01;
+    values[6] = tr._10;
+    values[7] = tr._11;
+
+    hints = params.getHints();
+    flattenType = stroker.getFlattenType();
+    dashList = params.getDashList();
+  }
+
+  FOG_INLINE uint32_t getHashCode() const
+  {
+    uint32_t h = HashUtil::hashPtr(pathData);
+
+    h = h * 31 + HashUtil::hashBinary(values, sizeof(values));
+    h = h * 31 + hints;
+    h = h * 31 + flattenType;
+    h = h * 31 + (uint32_t)dashList.getLength();
+
+    return h ^ (h >> 16);
+  }
+
+  FOG_INLINE bool eq(const RasterStrokeCache_KeyT<NumT>& other) const
+  {
+    if (pathData != other.pathData || hints != other.hints || flattenType != other.flattenType)
+      return false;
+
+    for (uint32_t i = 0; i < VALUE_COUNT; i++)
+    {
+      if (values[i] != other.values[i])
+        return false;
+    }
+
+    return dashList.eq(other.dashList);
+  }
+
+  //! @brief Path data (referenced if the key is stored in the cache).
+  NumT_(PathData)* pathData;
+  //! @brief Line width, miter limit, dash offset, flatness and the 2x2
+  //! transform matrix.
+  NumT values[VALUE_COUNT];
+  //! @brief Stroke hints (caps and join).
+  uint32_t hints;
+  //! @brief Flatten type.
+  uint32_t flattenType;
+  //! @brief Dash list.
+  List<NumT> dashList;
+};
+
+//! @internal
+//!
+//! @brief Stroke-cache entry (precision independent part).
+struct FOG_NO_EXPORT RasterStrokeCache_Entry
+{
+  //! @brief Next entry in the hash bucket.
+  RasterStrokeCache_Entry* hashNext;
+  //! @brief Previous entry in LRU list (more recently used).
+  RasterStrokeCache_Entry* prev;
+  //! @brief Next entry in LRU list (less recently used).
+  RasterStrokeCache_Entry* next;
+
+  //! @brief Hash code of the key.
+  uint32_t hashCode;
+  //! @brief Precision, see @c RASTER_PRECISION.
+  uint32_t precision;
+  //! @brief Memory accounted for this entry.
+  size_t memorySize;
+};
+
+//! @internal
+//!
+//! @brief Stroke-cache entry.
+template<typename NumT>
+struct FOG_NO_EXPORT RasterStrokeCache_EntryT : public RasterStrokeCache_Entry
+{
+  RasterStrokeCache_KeyT<NumT> key;
+  NumT_(Path) outline;
+};
+
+template<typename NumT>
+struct RasterStrokeCache_PrecisionT {};
+
+template<>
+struct RasterStrokeCache_PrecisionT<float> { enum { VALUE = RASTER_PRECISION_F }; };
+
+template<>
+struct RasterStrokeCache_PrecisionT<double> { enum { VALUE = RASTER_PRECISION_D }; };
+
+// ============================================================================
+// [Fog::RasterStrokeCache - Global]
+// ============================================================================
+
+struct FOG_NO_EXPORT RasterStrokeCache_Global
+{
+  FOG_INLINE RasterStrokeCache_Global()
+  {
+    buckets = NULL;
+    bucketCount = 0;
+
+    first = NULL;
+    last = NULL;
+
+    stats.reset();
+    stats.memoryLimit = RASTER_STROKE_CACHE_DEFAULT_LIMIT;
+  }
+
+  // Critical section for accessing members.
+  Lock lock;
+
+  // Hash table (bucketCount is power of 2).
+  RasterStrokeCache_Entry** buckets;
+  uint32_t bucketCount;
+
+  // Entries sorted by the last use (most recently used first).
+  RasterStrokeCache_Entry* first;
+  RasterStrokeCache_Entry* last;
+
+  // Statistics.
+  PaintCacheStats stats;
+};
+
+static Static<RasterStrokeCache_Global> RasterStrokeCache_global;
+
+// ============================================================================
+// [Fog::RasterStrokeCache - Helpers]
+// ============================================================================
+
+template<typename NumT>
+static FOG_INLINE size_t RasterStrokeCache_getPathMemory(const NumT_(Path)& path)
+{
+  return sizeof(NumT_(PathData)) + path._d->capacity * (sizeof(NumT_(Point)) + sizeof(uint8_t));
+}
+
+static FOG_INLINE void RasterStrokeCache_touchEntry(RasterStrokeCache_Global* g, RasterStrokeCache_Entry* entry)
+{
+  if (g->first == entry)
+    return;
+
+  // Unlink.
+  entry->prev->next = entry->next;
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  // Link as first.
+  entry->prev = NULL;
+  entry->next = g->first;
+  g->first->prev = entry;
+  g->first = entry;
+}
+
+template<typename NumT>
+static void RasterStrokeCache_deleteEntryT(RasterStrokeCache_Entry* entry)
+{
+  RasterStrokeCache_EntryT<NumT>* e = static_cast<RasterStrokeCache_EntryT<NumT>*>(entry);
+
+  e->key.pathData->release();
+  fog_delete(e);
+}
+
+//! @internal
+//!
+//! @brief Remove @a entry from the hash table and LRU list and delete it.
+static void RasterStrokeCache_removeEntry(RasterStrokeCache_Global* g, RasterStrokeCache_Entry* entry)
+{
+  RasterStrokeCache_Entry** pPrev = &g->buckets[entry->hashCode & (g->bucketCount - 1)];
+
+  while (*pPrev != entry)
+    pPrev = &(*pPrev)->hashNext;
+  *pPrev = entry->hashNext;
+
+  if (entry->prev != NULL)
+    entry->prev->next = entry->next;
+  else
+    g->first = entry->next;
+
+  if (entry->next != NULL)
+    entry->next->prev = entry->prev;
+  else
+    g->last = entry->prev;
+
+  g->stats.entryCount--;
+  g->stats.memoryUsed -= entry->memorySize;
+
+  if (entry->precision == RASTER_PRECISION_F)
+    RasterStrokeCache_deleteEntryT<float>(entry);
+  else
+    RasterStrokeCache_deleteEntryT<double>(entry);
+}
+
+//! @internal
+//!
+//! @brief Get whether the path data of @a entry is referenced only by the
+//! cache, so the entry can never be hit again.
+static FOG_INLINE bool RasterStrokeCache_isOrphan(const RasterStrokeCache_Entry* entry)
+{
+  if (entry->precision == RASTER_PRECISION_F)
+    return static_cast<const RasterStrokeCache_EntryT<float>*>(entry)->key.pathData->reference.get() == 1;
+  else
+    return static_cast<const RasterStrokeCache_EntryT<double>*>(entry)->key.pathData->reference.get() == 1;
+}
+
+static err_t RasterStrokeCache_rehash(RasterStrokeCache_Global* g, uint32_t bucketCount)
+{
+  RasterStrokeCache_Entry** buckets = static_cast<RasterStrokeCache_Entry**>(
+    MemMgr::calloc(bucketCount * sizeof(RasterStrokeCache_Entry*)));
+
+  if (FOG_IS_NULL(buckets))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  for (uint32_t i = 0; i < g->bucketCount; i++)
+  {
+    RasterStrokeCache_Entry* entry = g->buckets[i];
+
+    while (entry != NULL)
+    {
+      RasterStrokeCache_Entry* next = entry->hashNext;
+      uint32_t index = entry->hashCode & (bucketCount - 1);
+
+      entry->hashNext = buckets[index];
+      buckets[index] = entry;
+
+      entry = next;
+    }
+  }
+
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  g->buckets = buckets;
+  g->bucketCount = bucketCount;
+  return ERR_OK;
+}
+
+//! @internal
+//!
+//! @brief Free entries which exceed the memory limit.
+//!
+//! Orphaned entries (the path was destroyed or modified by the user) are
+//! evicted first, then the least recently used ones.
+static void RasterStrokeCache_trim(RasterStrokeCache_Global* g)
+{
+  if (g->stats.memoryUsed <= g->stats.memoryLimit)
+    return;
+
+  RasterStrokeCache_Entry* entry = g->last;
+  while (entry != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterStrokeCache_Entry* prev = entry->prev;
+
+    if (RasterStrokeCache_isOrphan(entry))
+    {
+      RasterStrokeCache_removeEntry(g, entry);
+      g->stats.evictionCount++;
+    }
+
+    entry = prev;
+  }
+
+  while (g->last != NULL && g->stats.memoryUsed > g->stats.memoryLimit)
+  {
+    RasterStrokeCache_removeEntry(g, g->last);
+    g->stats.evictionCount++;
+  }
+}
+
+template<typename NumT>
+static RasterStrokeCache_EntryT<NumT>* RasterStrokeCache_findT(RasterStrokeCache_Global* g,
+  const RasterStrokeCache_KeyT<NumT>& key, uint32_t hashCode)
+{
+  if (g->bucketCount == 0)
+    return NULL;
+
+  RasterStrokeCache_Entry* entry = g->buckets[hashCode & (g->bucketCount - 1)];
+
+  while (entry != NULL)
+  {
+    if (entry->hashCode == hashCode &&
+        entry->precision == RasterStrokeCache_PrecisionT<NumT>::VALUE &&
+        static_cast<RasterStrokeCache_EntryT<NumT>*>(entry)->key.eq(key))
+    {
+      return static_cast<RasterStrokeCache_EntryT<NumT>*>(entry);
+    }
+
+    entry = entry->hashNext;
+  }
+
+  return NULL;
+}
+
+// ============================================================================
+// [Fog::RasterStrokeCache - GetOutline]
+// ============================================================================
+
+template<typename NumT>
+static err_t RasterStrokeCache_getOutlineT(NumT_(Path)& dst, NumT_(Point)& offset,
+  const NumT_(Path)& path, const NumT_(PathStroker)& stroker)
+{
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  const NumT_(Transform)& tr = stroker.getTransform();
+
+  FOG_ASSERT(tr.getType() < TRANSFORM_TYPE_PROJECTION);
+  offset.set(tr._20, tr._21);
+
+  RasterStrokeCache_KeyT<NumT> key;
+  key.init(path, stroker);
+
+  uint32_t hashCode = key.getHashCode();
+
+  // --------------------------------------------------------------------------
+  // [Lookup]
+  // --------------------------------------------------------------------------
+
+  {
+    AutoLock locked(g->lock);
+    RasterStrokeCache_EntryT<NumT>* entry = RasterStrokeCache_findT<NumT>(g, key, hashCode);
+
+    if (entry != NULL)
+    {
+      g->stats.hitCount++;
+      RasterStrokeCache_touchEntry(g, entry);
+
+      dst = entry->outline;
+      return ERR_OK;
+    }
+
+    g->stats.missCount++;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Stroke]
+  // --------------------------------------------------------------------------
+
+  // Stroking is done without holding the lock, other threads can use the
+  // cache meanwhile.
+  NumT_(Transform) strokerTransform(tr._00, tr._01, tr._10, tr._11, NumT(0.0), NumT(0.0));
+  NumT_(PathStroker) localStroker(stroker.getParams(), strokerTransform);
+
+  localStroker.setFlatness(stroker.getFlatness());
+  localStroker.setFlattenType(stroker.getFlattenType());
+
+  NumT_(Path) outline;
+  FOG_RETURN_ON_ERROR(localStroker.strokePath(outline, path));
+
+  outline.squeeze();
+  dst = outline;
+
+  size_t memorySize = sizeof(RasterStrokeCache_EntryT<NumT>) +
+    RasterStrokeCache_getPathMemory<NumT>(outline) +
+    RasterStrokeCache_getPathMemory<NumT>(path);
+
+  // --------------------------------------------------------------------------
+  // [Insert]
+  // --------------------------------------------------------------------------
+
+  AutoLock locked(g->lock);
+
+  if (memorySize > g->stats.memoryLimit / RASTER_STROKE_CACHE_ENTRY_RATIO)
+    return ERR_OK;
+
+  // The same outline could be inserted by another thread meanwhile.
+  if (RasterStrokeCache_findT<NumT>(g, key, hashCode) != NULL)
+    return ERR_OK;
+
+  if (g->stats.entryCount >= g->bucketCount)
+    FOG_RETURN_ON_ERROR(RasterStrokeCache_rehash(g, g->bucketCount != 0 ? g->bucketCount * 2 : 256));
+
+  RasterStrokeCache_EntryT<NumT>* entry = fog_new RasterStrokeCache_EntryT<NumT>;
+  if (FOG_IS_NULL(entry))
+    return ERR_RT_OUT_OF_MEMORY;
+
+  entry->hashCode = hashCode;
+  entry->precision = RasterStrokeCache_PrecisionT<NumT>::VALUE;
+  entry->memorySize = memorySize;
+
+  entry->key = key;
+  entry->key.pathData->addRef();
+  entry->outline = outline;
+
+  uint32_t index = hashCode & (g->bucketCount - 1);
+  entry->hashNext = g->buckets[index];
+  g->buckets[index] = entry;
+
+  entry->prev = NULL;
+  entry->next = g->first;
+
+  if (g->first != NULL)
+    g->first->prev = entry;
+  else
+    g->last = entry;
+  g->first = entry;
+
+  g->stats.entryCount++;
+  g->stats.memoryUsed += memorySize;
+
+  RasterStrokeCache_trim(g);
+  return ERR_OK;
+}
+
+// ============================================================================
+// [Fog::RasterStrokeCache - Interface]
+// ============================================================================
+
+err_t RasterStrokeCache::getOutline(PathF& dst, PointF& offset, const PathF& path, const PathStrokerF& stroker)
+{
+  return RasterStrokeCache_getOutlineT<float>(dst, offset, path, stroker);
+}
+
+err_t RasterStrokeCache::getOutline(PathD& dst, PointD& offset, const PathD& path, const PathStrokerD& stroker)
+{
+  return RasterStrokeCache_getOutlineT<double>(dst, offset, path, stroker);
+}
+
+void RasterStrokeCache::getStats(PaintCacheStats& stats)
+{
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  AutoLock locked(g->lock);
+
+  stats = g->stats;
+}
+
+void RasterStrokeCache::resetStats()
+{
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.hitCount = 0;
+  g->stats.missCount = 0;
+  g->stats.evictionCount = 0;
+}
+
+void RasterStrokeCache::setMemoryLimit(size_t memoryLimit)
+{
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  AutoLock locked(g->lock);
+
+  g->stats.memoryLimit = memoryLimit;
+  RasterStrokeCache_trim(g);
+}
+
+void RasterStrokeCache::reset()
+{
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  AutoLock locked(g->lock);
+
+  while (g->last != NULL)
+    RasterStrokeCache_removeEntry(g, g->last);
+}
+
+// ============================================================================
+// [Init / Fini]
+// ============================================================================
+
+FOG_NO_EXPORT void RasterStrokeCache_init(void)
+{
+  RasterStrokeCache_global.init();
+}
+
+FOG_NO_EXPORT void RasterStrokeCache_fini(void)
+{
+  RasterStrokeCache::reset();
+
+  RasterStrokeCache_Global* g = &RasterStrokeCache_global;
+  if (g->buckets != NULL)
+    MemMgr::free(g->buckets);
+
+  RasterStrokeCache_global.destroy();
+}
+
+} // Fog namespace
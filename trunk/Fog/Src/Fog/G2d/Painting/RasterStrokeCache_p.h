@@ -0,0 +1,88 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_RASTERSTROKECACHE_P_H
+#define _FOG_G2D_PAINTING_RASTERSTROKECACHE_P_H
+
+// [Dependencies]
+#include <Fog/Core/Global/Global.h>
+#include <Fog/G2d/Geometry/Path.h>
+#include <Fog/G2d/Geometry/PathStroker.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Painting/PaintParams.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::RASTER_STROKE_CACHE]
+// ============================================================================
+
+enum RASTER_STROKE_CACHE
+{
+  //! @brief Default memory limit (in bytes), 4MB.
+  RASTER_STROKE_CACHE_DEFAULT_LIMIT = 4 * 1024 * 1024,
+
+  //! @brief The maximum size of a single outline, relative to the memory
+  //! limit (outline must be smaller than memoryLimit / N to be cached).
+  RASTER_STROKE_CACHE_ENTRY_RATIO = 8
+};
+
+// ============================================================================
+// [Fog::RasterStrokeCache]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Process-wide cache of stroked outlines.
+//!
+//! The outline is identified by the path data, stroke parameters, flatness
+//! and the 2x2 part of the stroker transform. The cache keeps a reference to
+//! the path data, so the data can't be modified in-place anymore (any change
+//! of the path detaches it and the new data pointer is never found in the
+//! cache). This makes the data pointer a reliable path identity without
+//! comparing the path vertices.
+//!
+//! The outline is stroked without clipping and without the translation part
+//! of the stroker transform, the translation is returned separately so the
+//! outline can be reused when the path is only moved (scrolling). The caller
+//! is responsible to clip the outline.
+//!
+//! The cache is limited by the memory used by outlines. When the limit is
+//! reached the least recently used outlines are evicted (outlines of paths
+//! which were already destroyed by the user first). All methods are
+//! thread-safe.
+struct FOG_NO_EXPORT RasterStrokeCache
+{
+  //! @brief Get the outline of @a path stroked by @a stroker.
+  //!
+  //! The stroker transform must be affine, clipping set to @a stroker is
+  //! ignored. The outline is translated by @a offset in device space.
+  static err_t getOutline(PathF& dst, PointF& offset, const PathF& path, const PathStrokerF& stroker);
+  //! @overload
+  static err_t getOutline(PathD& dst, PointD& offset, const PathD& path, const PathStrokerD& stroker);
+
+  //! @brief Get stroke-cache statistics.
+  static void getStats(PaintCacheStats& stats);
+
+  //! @brief Clear the hit, miss and eviction counters.
+  static void resetStats();
+
+  //! @brief Set the memory limit (in bytes).
+  static void setMemoryLimit(size_t memoryLimit);
+
+  //! @brief Remove all outlines from the cache.
+  static void reset();
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_RASTERSTROKECACHE_P_H
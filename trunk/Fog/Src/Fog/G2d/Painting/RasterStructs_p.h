@@ -9,6 +9,7 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Global.h>
+#include <Fog/Core/Memory/MemMgr.h>
 #include <Fog/Core/Threading/Atomic.h>
 #include <Fog/G2d/Geometry/Transform.h>
 #include <Fog/G2d/Imaging/Image.h>
@@ -16,6 +17,7 @@
 #include <Fog/G2d/Imaging/ImageConverter.h>
 #include <Fog/G2d/Imaging/ImagePalette.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterJit_p.h>
 #include <Fog/G2d/Source/Color.h>
 #include <Fog/G2d/Source/ColorStop.h>
 #include <Fog/G2d/Source/Gradient.h>
@@ -221,6 +223,33 @@ struct FOG_NO_EXPORT RasterPattern
 
   FOG_INLINE uint16_t isOpaque() const { return _isOpaque; }
 
+  //! @brief Get the fused fetch-and-composite function for the compositing
+  //! operator @a op (already modified by @c getCompositeModifiedOperator()),
+  //! or @c NULL if the pattern must be fetched and composited separately.
+  FOG_INLINE RasterPatternFusedFunc getFusedFunc(uint32_t op) const
+  {
+    if (op > COMPOSITE_SRC_OVER)
+      return NULL;
+
+    uint32_t base = (_dstFormat == IMAGE_FORMAT_XRGB32)
+      ? (uint32_t)RASTER_FUSED_XRGB32_SRC
+      : (uint32_t)RASTER_FUSED_PRGB32_SRC;
+
+#if defined(FOG_RASTER_JIT)
+    if (_jitSource != RASTER_JIT_SOURCE_NONE)
+    {
+      RasterPatternFusedFunc func = RasterJit::getFusedFunc(_jitSource, base + op);
+      if (func != NULL)
+        return func;
+    }
+#endif // FOG_RASTER_JIT
+
+    if (_fused == NULL)
+      return NULL;
+
+    return _fused[base + op];
+  }
+
   template<typename T>
   FOG_INLINE T* getRaw() const { return (T*)(_d.raw); }
 
@@ -232,6 +261,8 @@ struct FOG_NO_EXPORT RasterPattern
   {
     _dstFormat = format;
     _dstBPP = ImageFormatDescription::getByFormat(format).getBytesPerPixel();
+    _fused = NULL;
+    _jitSource = RASTER_JIT_SOURCE_NONE;
   }
 
   FOG_INLINE void _initSrc(uint32_t format)
@@ -305,6 +336,12 @@ struct FOG_NO_EXPORT RasterPattern
   RasterPatternSkipFunc _skip;
   //! @brief Destroy function.
   RasterPatternDestroyFunc _destroy;
+  //! @brief Fused fetch-and-composite functions, indexed by @c RASTER_FUSED
+  //! (can be @c NULL).
+  const RasterPatternFusedFunc* _fused;
+  //! @brief Pattern source compiled by @ref RasterJit, see
+  //! @c RASTER_JIT_SOURCE.
+  uint32_t _jitSource;
 
   //! @brief Destination format.
   uint32_t _dstFormat;
@@ -319,6 +356,10 @@ struct FOG_NO_EXPORT RasterPattern
   //! @brief Whether the source is fully-opaque.
   uint16_t _isOpaque;
 
+  //! @brief Whether the context is @ref RasterSharedPattern (allocated by
+  //! @c MemMgr), otherwise it's owned by the paint engine context-pool.
+  uint32_t _isShared;
+
   //! @brief Bounding box.
   BoxI _boundingBox;
 
@@ -563,6 +604,85 @@ struct FOG_NO_EXPORT RasterPattern
   } _d;
 };
 
+// ============================================================================
+// [Fog::RasterSharedPattern]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Pattern context attached to @ref PatternData.
+//!
+//! The context is created by the paint engine when the @ref Pattern is set as
+//! a source, and reused by all paint engines which set the same pattern data
+//! using the same final transform, target format and quality. The context is
+//! reference counted, one reference is held by the pattern data, which
+//! releases it when it's destroyed or modified.
+//!
+//! The bounding-box is not part of the key, it's not used to fetch pixels.
+struct FOG_NO_EXPORT RasterSharedPattern : public RasterPattern
+{
+  enum { VALUE_COUNT = 9 };
+
+  // --------------------------------------------------------------------------
+  // [Key]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void initKey(uint32_t dstFormat, uint32_t quality, const TransformD& tr)
+  {
+    _keyDstFormat = dstFormat;
+    _keyQuality = quality;
+
+    _keyValues[0] = tr._00;
+    _keyValues[1] = tr._01;
+    _keyValues[2] = tr._02;
+    _keyValues[3] = tr._10;
+    _keyValues[4] = tr._11;
+    _keyValues[5] = tr._12;
+    _keyValues[6] = tr._20;
+    _keyValues[7] = tr._21;
+    _keyValues[8] = tr._22;
+  }
+
+  FOG_INLINE bool eqKey(uint32_t dstFormat, uint32_t quality, const TransformD& tr) const
+  {
+    return _keyDstFormat == dstFormat &&
+           _keyQuality == quality &&
+           _keyValues[0] == tr._00 &&
+           _keyValues[1] == tr._01 &&
+           _keyValues[2] == tr._02 &&
+           _keyValues[3] == tr._10 &&
+           _keyValues[4] == tr._11 &&
+           _keyValues[5] == tr._12 &&
+           _keyValues[6] == tr._20 &&
+           _keyValues[7] == tr._21 &&
+           _keyValues[8] == tr._22;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Release]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void release()
+  {
+    if (_reference.deref())
+    {
+      destroy();
+      MemMgr::free(this);
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Final transform of the pattern (key).
+  double _keyValues[VALUE_COUNT];
+  //! @brief Target format (key).
+  uint32_t _keyDstFormat;
+  //! @brief Image or gradient quality (key).
+  uint32_t _keyQuality;
+};
+
 // ============================================================================
 // [Fog::RasterPatternFetcher]
 // ============================================================================
@@ -12,6 +12,7 @@
 #include <Fog/Core/Math/Math.h>
 #include <Fog/G2d/Geometry/Box.h>
 #include <Fog/G2d/Geometry/Rect.h>
+#include <Fog/G2d/Imaging/Image.h>
 #include <Fog/G2d/Imaging/ImageFormatDescription.h>
 #include <Fog/G2d/Painting/RasterConstants_p.h>
 
@@ -98,6 +99,20 @@ static FOG_INLINE uint32_t getCompositeModifiedOperator(uint32_t dstFormat, uint
   return _raster_modifiedOperator[dstFormat][compositingOperator][isOpaque];
 }
 
+// ============================================================================
+// [Fog::RasterUtil - Image]
+// ============================================================================
+
+//! @brief Get whether the premultiplied image @a d is known to be opaque.
+//!
+//! Only the alpha distribution cached by @ref ImageData is checked, the image
+//! is never analyzed here.
+static FOG_INLINE uint32_t isOpaqueImage(const ImageData* d)
+{
+  return (d->format == IMAGE_FORMAT_PRGB32 || d->format == IMAGE_FORMAT_PRGB64) &&
+         d->alphaDistribution == ALPHA_DISTRIBUTION_FULL;
+}
+
 // ============================================================================
 // [Fog::RasterUtil - Debug]
 // ============================================================================
@@ -14,9 +14,12 @@
 #include <Fog/Core/Global/Private.h>
 #include <Fog/Core/Math/Math.h>
 #include <Fog/Core/Memory/MemMgr.h>
+#include <Fog/Core/Memory/MemOps.h>
 #include <Fog/Core/Threading/Lock.h>
 #include <Fog/Core/Tools/Swap.h>
+#include <Fog/G2d/Geometry/PathTmp_p.h>
 #include <Fog/G2d/Painting/RasterApi_p.h>
+#include <Fog/G2d/Painting/RasterCoverageCache_p.h>
 #include <Fog/G2d/Painting/RasterScanline_p.h>
 #include <Fog/G2d/Painting/RasterSpan_p.h>
 #include <Fog/G2d/Painting/RasterStructs_p.h>
@@ -171,7 +174,10 @@ enum A8_ENUM
   A8_I32_COORD_LIMIT = 16384 << A8_SHIFT,
 
   A8_ALLOCATOR_SIZE = 16384 - 84,
-  A8_MAX_CHUNK_LENGTH = A8_ALLOCATOR_SIZE / (sizeof(PathRasterizer8::Cell) * 8)
+  A8_MAX_CHUNK_LENGTH = A8_ALLOCATOR_SIZE / (sizeof(PathRasterizer8::Cell) * 8),
+
+  // Maximum width/height of the dense buffer (in pixels).
+  A8_DENSE_SIZE = 256
 };
 
 enum CELL_OP
@@ -214,6 +220,229 @@ static FOG_INLINE int upscale24x8(double v) { return Math::ifloor(v * (double)25
 
 FOG_NO_EXPORT RasterizerApi Rasterizer_api;
 
+// ============================================================================
+// [Fog::Rasterizer8 - Clip-Mask]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Filler which intersects spans with the clip-mask before they are
+//! passed to the target filler.
+//!
+//! Used by all clip-mask render functions, they setup the proxy and call the
+//! clip-box variant. The intersected spans are stored in the clip-mask
+//! scanline, because the spans passed to process() are owned by the scanline
+//! used by the rasterizer.
+struct FOG_NO_EXPORT RasterClipMaskFiller8 : public RasterFiller
+{
+  //! @brief The target filler.
+  RasterFiller* target;
+  //! @brief Scanline used to store the intersected spans.
+  RasterScanline8* scanline;
+  //! @brief Clip-mask scanlines (adjusted, indexed by y).
+  const RasterSpan8* const* spans;
+
+  //! @brief Clip-mask start scanline.
+  int y0;
+  //! @brief Clip-mask end scanline.
+  int y1;
+  //! @brief The current scanline.
+  int y;
+  //! @brief Count of scanlines to skip before the next process() call.
+  int skipped;
+};
+
+static FOG_INLINE uint32_t Rasterizer8_getCoverage(uint32_t type, const uint8_t* mask, int i)
+{
+  if (type == RASTER_SPAN_AX_EXTRA)
+    return reinterpret_cast<const uint16_t*>(mask)[i];
+
+  uint32_t m = mask[i];
+  return m + (m >> 7);
+}
+
+static RasterSpan8* Rasterizer8_intersectClipMask(RasterScanline8* scanline,
+  const RasterSpan8* a, const RasterSpan8* b)
+{
+  RasterSpan8* span = scanline->begin();
+  uint8_t* maskPtr = scanline->getMask();
+
+  while (a != NULL && b != NULL)
+  {
+    int ax1 = a->getX1();
+    int bx1 = b->getX1();
+
+    int x0 = Math::max(a->getX0(), b->getX0());
+    int x1 = Math::min(ax1, bx1);
+
+    if (x0 < x1)
+    {
+      uint32_t ta = a->getType();
+      uint32_t tb = b->getType();
+
+      // The clip-mask contains only const and AX_EXTRA spans.
+      FOG_ASSERT(tb == RASTER_SPAN_C || tb == RASTER_SPAN_AX_EXTRA);
+
+      if (ta == RASTER_SPAN_C && tb == RASTER_SPAN_C)
+      {
+        uint32_t m = (a->getConstMask() * b->getConstMask()) >> 8;
+        if (m != 0)
+        {
+          NEW_SPAN(span, return NULL);
+          span->setPositionAndType(x0, x1, RASTER_SPAN_C);
+          span->setConstMask(m);
+        }
+      }
+      else if (tb == RASTER_SPAN_C && b->isConstMaskOpaque())
+      {
+        // Opaque clip, only clip the shape span.
+        NEW_SPAN(span, return NULL);
+        span->setPositionAndType(x0, x1, ta);
+        span->setGenericMask(a->getGenericMask());
+
+        if (ta != RASTER_SPAN_C)
+          span->setVariantMask(span->getVariantMask() + RasterSpan8::getMaskAdvance(ta, x0 - a->getX0()));
+      }
+      else if (ta == RASTER_SPAN_C && a->isConstMaskOpaque())
+      {
+        // Opaque shape, use the clip-mask directly.
+        NEW_SPAN(span, return NULL);
+        span->setPositionAndType(x0, x1, RASTER_SPAN_AX_EXTRA);
+        span->setA8Extra(b->getVariantMask() + (x0 - b->getX0()) * 2);
+      }
+      else
+      {
+        int i, w = x1 - x0;
+        const uint8_t* bMask = tb != RASTER_SPAN_C ? b->getVariantMask() + (x0 - b->getX0()) * 2 : NULL;
+
+        NEW_SPAN(span, return NULL);
+
+        if (ta >= RASTER_SPAN_ARGB32_GLYPH)
+        {
+          // LCD glyph, multiply each component.
+          const uint8_t* aMask = a->getVariantMask() + RasterSpan8::getMaskAdvance(ta, x0 - a->getX0());
+
+          span->setPositionAndType(x0, x1, ta);
+          span->setARGB32Glyph(maskPtr);
+
+          for (i = 0; i < w; i++, aMask += 4, maskPtr += 4)
+          {
+            uint32_t m = (tb == RASTER_SPAN_C) ? b->getConstMask()
+                                               : Rasterizer8_getCoverage(RASTER_SPAN_AX_EXTRA, bMask, i);
+            maskPtr[0] = (uint8_t)((aMask[0] * m) >> 8);
+            maskPtr[1] = (uint8_t)((aMask[1] * m) >> 8);
+            maskPtr[2] = (uint8_t)((aMask[2] * m) >> 8);
+            maskPtr[3] = (uint8_t)((aMask[3] * m) >> 8);
+          }
+        }
+        else
+        {
+          uint16_t* dMask = reinterpret_cast<uint16_t*>(maskPtr);
+
+          span->setPositionAndType(x0, x1, RASTER_SPAN_AX_EXTRA);
+          span->setA8Extra(maskPtr);
+
+          if (ta == RASTER_SPAN_C)
+          {
+            uint32_t m = a->getConstMask();
+            for (i = 0; i < w; i++)
+              dMask[i] = (uint16_t)((Rasterizer8_getCoverage(RASTER_SPAN_AX_EXTRA, bMask, i) * m) >> 8);
+          }
+          else
+          {
+            const uint8_t* aMask = a->getVariantMask() + RasterSpan8::getMaskAdvance(ta, x0 - a->getX0());
+
+            if (tb == RASTER_SPAN_C)
+            {
+              uint32_t m = b->getConstMask();
+              for (i = 0; i < w; i++)
+                dMask[i] = (uint16_t)((Rasterizer8_getCoverage(ta, aMask, i) * m) >> 8);
+            }
+            else
+            {
+              for (i = 0; i < w; i++)
+                dMask[i] = (uint16_t)((Rasterizer8_getCoverage(ta, aMask, i) *
+                                       Rasterizer8_getCoverage(RASTER_SPAN_AX_EXTRA, bMask, i)) >> 8);
+            }
+          }
+
+          maskPtr += w * 2;
+        }
+      }
+    }
+
+    if (ax1 <= bx1) a = a->getNext();
+    if (bx1 <= ax1) b = b->getNext();
+  }
+
+  return scanline->end(span);
+}
+
+static void FOG_FASTCALL RasterClipMaskFiller8_prepare(RasterFiller* _self, int y)
+{
+  RasterClipMaskFiller8* self = static_cast<RasterClipMaskFiller8*>(_self);
+
+  self->y = y;
+  self->skipped = 0;
+  self->target->prepare(y);
+}
+
+static void FOG_FASTCALL RasterClipMaskFiller8_process(RasterFiller* _self, RasterSpan* spans)
+{
+  RasterClipMaskFiller8* self = static_cast<RasterClipMaskFiller8*>(_self);
+  int y = self->y++;
+
+  if (y >= self->y0 && y < self->y1 && self->spans[y] != NULL)
+  {
+    RasterSpan8* result = Rasterizer8_intersectClipMask(self->scanline,
+      static_cast<RasterSpan8*>(spans), self->spans[y]);
+
+    if (result != NULL)
+    {
+      if (self->skipped)
+      {
+        self->target->skip(self->skipped);
+        self->skipped = 0;
+      }
+
+      self->target->process(result);
+      return;
+    }
+  }
+
+  self->skipped++;
+}
+
+static void FOG_FASTCALL RasterClipMaskFiller8_skip(RasterFiller* _self, int step)
+{
+  RasterClipMaskFiller8* self = static_cast<RasterClipMaskFiller8*>(_self);
+
+  self->y += step;
+  self->skipped += step;
+}
+
+static bool Rasterizer8_initClipMaskFiller(Rasterizer8* self, RasterClipMaskFiller8* proxy, RasterFiller* target)
+{
+  RasterScanline8* scanline = self->_clip.mask.scanline;
+
+  // LCD glyphs need 4 bytes per pixel.
+  if (FOG_IS_ERROR(scanline->prepare((size_t)self->_sceneBox.getWidth() * 4)))
+    return false;
+
+  proxy->_prepare = RasterClipMaskFiller8_prepare;
+  proxy->_process = RasterClipMaskFiller8_process;
+  proxy->_skip = RasterClipMaskFiller8_skip;
+
+  proxy->target = target;
+  proxy->scanline = scanline;
+  proxy->spans = self->_clip.mask.spans;
+  proxy->y0 = self->_clip.mask.y0;
+  proxy->y1 = self->_clip.mask.y1;
+  proxy->y = 0;
+  proxy->skipped = 0;
+  return true;
+}
+
 // ============================================================================
 // [Fog::BoxRasterizer8 - Init - 32x0]
 // ============================================================================
@@ -475,8 +704,11 @@ _Start:
 static void FOG_CDECL BoxRasterizer8_render_32x0_st_clip_mask(
   Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
-  // TODO: BoxRasterizer8 - render 32x0 - clip-mask.
-  BoxRasterizer8* self = static_cast<BoxRasterizer8*>(_self);
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
+
+  BoxRasterizer8_render_32x0_st_clip_box(_self, &proxy, scanline);
 }
 
 // ============================================================================
@@ -761,973 +993,1752 @@ _Repeat:
 static void FOG_CDECL BoxRasterizer8_render_24x8_st_clip_mask(
   Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
-  // TODO: BoxRasterizer8 - render 24x8 - clip-mask.
-  BoxRasterizer8* self = static_cast<BoxRasterizer8*>(_self);
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
+
+  BoxRasterizer8_render_24x8_st_clip_box(_self, &proxy, scanline);
 }
 
 // ============================================================================
-// [Fog::PathRasterizer8 - Construction / Destruction]
+// [Fog::MaskRasterizer8 - Init]
 // ============================================================================
 
-PathRasterizer8::PathRasterizer8() :
-  _allocator(A8_ALLOCATOR_SIZE)
+static void FOG_CDECL MaskRasterizer8_init(MaskRasterizer8* self, const BoxI* box, const uint8_t* maskPixels, ssize_t maskStride, uint32_t maskFormat)
 {
-  // Default is no multithreading.
-  _scope.reset();
+  // The box should be already clipped to the scene-box.
+  FOG_ASSERT(self->_sceneBox.subsumes(*box));
+  FOG_ASSERT(self->_clipType < RASTER_CLIP_COUNT);
 
-  // Clear rows.
-  _rowsCapacity = 0;
-  _rowsStorage = NULL;
-  _rowsAdjusted = NULL;
+  uint32_t bpp = 0;
 
-  reset();
-}
+  switch (maskFormat)
+  {
+    case IMAGE_FORMAT_PRGB32:
+      maskPixels += PIXEL_ARGB32_POS_A;
+      bpp = 4;
+      break;
 
-PathRasterizer8::~PathRasterizer8()
-{
-  if (_rowsStorage != NULL)
-    MemMgr::free(_rowsStorage);
-}
+    case IMAGE_FORMAT_A8:
+      bpp = 1;
+      break;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - Helpers]
-// ============================================================================
+    // Only the high byte of 16-bit alpha is used by the 8-bit rasterizer.
+    case IMAGE_FORMAT_PRGB64:
+      maskPixels += PIXEL_ARGB64_BYTE_A_HI;
+      bpp = 8;
+      break;
 
-template<typename FixedT>
-static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1);
+    case IMAGE_FORMAT_A16:
+#if FOG_BYTE_ORDER == FOG_LITTLE_ENDIAN
+      maskPixels += 1;
+#endif // FOG_BYTE_ORDER
+      bpp = 2;
+      break;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - Reset]
-// ============================================================================
+    // Formats without alpha channel are rasterized as a box.
+    default:
+      break;
+  }
 
-void PathRasterizer8::reset()
-{
-  // Reset scene-box.
-  _sceneBox.reset();
-  _boundingBox.setBox(-1, -1, -1, -1);
+  self->_initialized = true;
+  self->_boxBounds = *box;
 
-  // Reset error.
-  _error = ERR_OK;
-  // Reset opacity.
-  _opacity = 0x100;
+  self->_maskPixels = maskPixels;
+  self->_maskStride = maskStride;
+  self->_maskBpp = bpp;
 
-  // Reset fill-rule.
-  _fillRule = FILL_RULE_DEFAULT;
-  // Not valid neither finalized.
-  _isValid = false;
-  _isFinalized = false;
+  self->_render = Rasterizer_api.mask8.render[self->_clipType];
 }
 
 // ============================================================================
-// [Fog::PathRasterizer8 - Init]
+// [Fog::MaskRasterizer8 - Helpers]
 // ============================================================================
 
-err_t PathRasterizer8::init()
+//! @internal
+//!
+//! @brief Get the span type used by the mask rasterizer.
+static FOG_INLINE uint32_t MaskRasterizer8_getSpanType(const MaskRasterizer8* self)
 {
-  _allocator.clear();
-  _boundingBox.setBox(-1, -1, -1, -1);
-
-  _error = ERR_OK;
-  _isValid = false;
-  _isFinalized = false;
-
-  _sceneBox24x8.setBox(_sceneBox.x0 << 8, _sceneBox.y0 << 8, _sceneBox.x1 << 8, _sceneBox.y1 << 8);
+  if (self->_maskBpp == 0)
+    return RASTER_SPAN_C;
+  else if (self->_opacity == 0x100)
+    return RASTER_SPAN_A8_GLYPH;
+  else
+    return RASTER_SPAN_AX_EXTRA;
+}
 
-  _offsetF.reset();
-  _offsetD.reset();
-  uint i = (uint)_sceneBox.getHeight() + 1;
+//! @internal
+//!
+//! @brief Get the mask of the current row.
+//!
+//! If the mask is A8 and opacity is not used then the returned pointer points
+//! to the mask pixels, otherwise the alpha values are converted (and scaled by
+//! opacity) into @a buffer.
+static FOG_INLINE uint8_t* MaskRasterizer8_fetchRow(const MaskRasterizer8* self,
+  uint8_t* buffer, const uint8_t* mask, int w)
+{
+  uint32_t bpp = self->_maskBpp;
+  uint32_t opacity = self->_opacity;
+  int i;
 
-  if (_rowsCapacity < i)
+  if (opacity == 0x100)
   {
-    if (_rowsStorage != NULL)
-      MemMgr::free(_rowsStorage);
+    // A8 mask is used directly (the mask is never modified by the fillers).
+    if (bpp == 1)
+      return const_cast<uint8_t*>(mask);
 
-    // Align...
-    _rowsCapacity = (i + 255U) & ~255U;
-    _rowsStorage = reinterpret_cast<Row*>(MemMgr::alloc(_rowsCapacity * sizeof(Row)));
-    _rowsAdjusted = NULL;
+    for (i = 0; i < w; i++, mask += bpp)
+      buffer[i] = mask[0];
+  }
+  else
+  {
+    uint16_t* dst = reinterpret_cast<uint16_t*>(buffer);
 
-    if (_rowsStorage == NULL)
+    for (i = 0; i < w; i++, mask += bpp)
     {
-      _rowsCapacity = 0;
-      setError(ERR_RT_OUT_OF_MEMORY);
-      return _error;
+      uint32_t m = mask[0];
+      dst[i] = (uint16_t)(((m + (m >> 7)) * opacity) >> 8);
     }
   }
 
-  _rowsAdjusted = _rowsStorage - _sceneBox.y0;
-  return _error;
+  return buffer;
 }
 
 // ============================================================================
-// [Fog::PathRasterizer8 - AddPath]
+// [Fog::MaskRasterizer8 - Render - Clip-Box]
 // ============================================================================
 
-template<typename SrcT>
-static void PathRasterizer8_addPathData(PathRasterizer8* self,
-  const SrcT_(Point)* srcPts, const uint8_t* srcCmd, size_t count, const SrcT_(Point)& offset)
+static void FOG_CDECL MaskRasterizer8_render_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
-  if (count == 0)
-    return;
+  MaskRasterizer8* self = static_cast<MaskRasterizer8*>(_self);
+  const BoxI& box = self->_boxBounds;
 
-  const uint8_t* srcEnd = srcCmd + count;
+  int w = box.getWidth();
+  int i = box.getHeight();
 
-  // Current/Start moveTo x position.
-  Fixed24x8 x0, startX0;
-  // Current/Start moveTo y position.
-  Fixed24x8 y0, startY0;
+  const uint8_t* mask = self->_maskPixels;
+  ssize_t maskStride = self->_maskStride;
 
-  // Current command.
-  uint8_t c;
+  uint32_t type = MaskRasterizer8_getSpanType(self);
+  uint8_t* buffer = NULL;
 
-  // Stack.
-  PointI curveStack[32 * 3 + 1];
-  int levelStack[32];
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
 
-_Start:
-  // Find: 'move-to' command and then go to the second loop.
-  for (;;)
+  if (type != RASTER_SPAN_C && (type != RASTER_SPAN_A8_GLYPH || self->_maskBpp != 1))
   {
-    c = srcCmd[0];
-    srcPts++;
-    srcCmd++;
-
-    // This can happen only when 'move-to' is the last command. In this case
-    // there is nothing to rasterize.
-    if (srcCmd == srcEnd)
+    if (FOG_IS_ERROR(scanline->prepare((size_t)w * 2)))
       return;
-
-    // ------------------------------------------------------------------------
-    // [MoveTo]
-    // ------------------------------------------------------------------------
-
-    if (PathCmd::isMoveTo(c))
-    {
-_MoveTo:
-      x0 = startX0 = Math::bound<Fixed24x8>(upscale24x8(srcPts[-1].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
-      y0 = startY0 = Math::bound<Fixed24x8>(upscale24x8(srcPts[-1].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
-      break;
-    }
+    buffer = scanline->getMask();
   }
 
-  // Process: 'line-to', 'quad-to' and 'cubic-to'.
-  // Stop at: 'move-to', 'close'.
-  for (;;)
-  {
-    c = srcCmd[0];
+  filler->prepare(box.y0);
+  RasterFiller::ProcessFunc process = filler->_process;
 
-    // ------------------------------------------------------------------------
-    // [LineTo]
-    // ------------------------------------------------------------------------
+  RasterSpan8 span[1];
+  span[0].setPositionAndType(box.x0, box.x1, type);
+  span[0].setNext(NULL);
 
-    if (PathCmd::isLineTo(c))
-    {
-      Fixed24x8 x1 = Math::bound<Fixed24x8>(upscale24x8(srcPts[0].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
-      Fixed24x8 y1 = Math::bound<Fixed24x8>(upscale24x8(srcPts[0].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
 
-      if ((x0 != x1) | (y0 != y1) && !PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
-        return;
+  if (type == RASTER_SPAN_C)
+  {
+    span[0].setConstMask(self->_opacity);
 
-      x0 = x1;
-      y0 = y1;
+    do {
+      process(filler, span);
+    } while (--i);
+  }
+  else
+  {
+    do {
+      span[0].setVariantMask(MaskRasterizer8_fetchRow(self, buffer, mask, w));
+      process(filler, span);
 
-      srcPts++;
-      srcCmd++;
+      mask += maskStride;
+    } while (--i);
+  }
+}
 
-      if (srcCmd == srcEnd)
-        goto _ClosePath;
-    }
-
-    // ------------------------------------------------------------------------
-    // [QuadTo]
-    // ------------------------------------------------------------------------
-
-    else if (PathCmd::isQuadTo(c))
-    {
-      PointI* curve = curveStack;
+// ============================================================================
+// [Fog::MaskRasterizer8 - Render - Clip-Region]
+// ============================================================================
 
-      curve[0].x = upscale24x8(srcPts[ 1].x + offset.x);
-      curve[0].y = upscale24x8(srcPts[ 1].y + offset.y);
-      curve[1].x = upscale24x8(srcPts[ 0].x + offset.x);
-      curve[1].y = upscale24x8(srcPts[ 0].y + offset.y);
-      curve[2].x = x0;
-      curve[2].y = y0;
+static void FOG_CDECL MaskRasterizer8_render_st_clip_region(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  MaskRasterizer8* self = static_cast<MaskRasterizer8*>(_self);
+  const BoxI& box = self->_boxBounds;
 
-      int d = Math::max(Math::abs( curve[2].x + curve[0].x - 2 * curve[1].x),
-                        Math::abs( curve[2].y + curve[0].y - 2 * curve[1].y));
+  int x0 = box.x0;
+  int x1 = box.x1;
+  int w = x1 - x0;
 
-      int level = 0;
-      int top = 0;
+  const BoxI* cPtr = self->_clip.region.data;
+  const BoxI* cEnd = cPtr + self->_clip.region.length;
 
-      while (d > (A8_SCALE / 6))
-      {
-        d >>= 2;
-        level++;
-      }
+  uint32_t type = MaskRasterizer8_getSpanType(self);
+  uint32_t opacity = self->_opacity;
+  uint32_t advance = RasterSpan8::getMaskAdvance(type, 1);
 
-      levelStack[0] = level;
-      top = 0;
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
 
-      do {
-        level = levelStack[top];
-        if (level > 1)
-        {
-          int a, b;
+  // Skip boxes which do not intersect in vertical direction.
+  while (cPtr->y1 <= box.y0)
+  {
+    if (++cPtr == cEnd)
+      return;
+  }
 
-          curve[4].x = curve[2].x;
-          b = curve[1].x;
-          a = curve[3].x = (curve[2].x + b) / 2;
-          b = curve[1].x = (curve[0].x + b) / 2;
-          curve[2].x = (a + b) / 2;
+  if (cPtr->y0 >= box.y1)
+    return;
 
-          curve[4].y = curve[2].y;
-          b = curve[1].y;
-          a = curve[3].y = (curve[2].y + b) / 2;
-          b = curve[1].y = (curve[0].y + b) / 2;
-          curve[2].y = (a + b) / 2;
+  if (type != RASTER_SPAN_C && FOG_IS_ERROR(scanline->prepare((size_t)w * 2)))
+    return;
 
-          curve += 2;
-          top++;
-          levelStack[top] = levelStack[top - 1] = level - 1;
-          continue;
-        }
+  // The mask buffer is not touched by begin(), it's safe to fetch the row and
+  // build the spans after that.
+  uint8_t* buffer = scanline->getMask();
 
-        // LineTo.
-        Fixed24x8 x1 = Math::bound<Fixed24x8>(curve[0].x, self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
-        Fixed24x8 y1 = Math::bound<Fixed24x8>(curve[0].y, self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+  int yPos = Math::max<int>(cPtr->y0, box.y0);
+  filler->prepare(yPos);
+  RasterFiller::ProcessFunc process = filler->_process;
 
-        if (!PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
-          return;
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
 
-        x0 = x1;
-        y0 = y1;
+  do {
+    // Find the end of the current band.
+    const BoxI* bandPtr = cPtr;
+    int y0 = cPtr->y0;
+    int y1 = cPtr->y1;
 
-        top--;
-        curve -= 2;
-      } while (top >= 0);
+    if (y0 >= box.y1)
+      return;
 
-      srcPts += 2;
-      srcCmd += 2;
+    while (++cPtr != cEnd && cPtr->y0 == y0)
+      continue;
 
-      if (srcCmd == srcEnd)
-        goto _ClosePath;
-    }
+    if (y0 < box.y0) y0 = box.y0;
+    if (y1 > box.y1) y1 = box.y1;
 
-    // ------------------------------------------------------------------------
-    // [CubicTo]
-    // ------------------------------------------------------------------------
+    const uint8_t* mask = self->_maskPixels + (ssize_t)(y0 - box.y0) * self->_maskStride;
 
-    else if (PathCmd::isCubicTo(c))
+    for (int y = y0; y < y1; y++, mask += self->_maskStride)
     {
-      PointI* curve = curveStack;
-      PointI* curveEnd = curve + 31 * 3;
+      uint8_t* rowMask = NULL;
+      if (type != RASTER_SPAN_C)
+        rowMask = MaskRasterizer8_fetchRow(self, buffer, mask, w);
 
-      curve[0].x = upscale24x8(srcPts[ 2].x + offset.x);
-      curve[0].y = upscale24x8(srcPts[ 2].y + offset.y);
-      curve[1].x = upscale24x8(srcPts[ 1].x + offset.x);
-      curve[1].y = upscale24x8(srcPts[ 1].y + offset.y);
-      curve[2].x = upscale24x8(srcPts[ 0].x + offset.x);
-      curve[2].y = upscale24x8(srcPts[ 0].y + offset.y);
-      curve[3].x = x0;
-      curve[3].y = y0;
+      RasterSpan8* span = scanline->begin();
 
-      for (;;)
+      for (const BoxI* b = bandPtr; b != cPtr; b++)
       {
-        // Decide whether to split or draw. See `Rapid Termination. Evaluation
-        // for Recursive Subdivision of Bezier Curves' by Thomas F. Hain, at:
-        // http://www.cis.southalabama.edu/~hain/general/Publications/Bezier/Camera-ready%20CISST02%202.pdf
-        if (curve != curveEnd)
-        {
-          int dx, dy;
-          int dx_, dy_;
-          int dx1, dy1;
-          int dx2, dy2;
-          int L, s, limit;
-
-          // dx and dy are x and y components of the P0-P3 chord vector.
-          dx = curve[3].x - curve[0].x;
-          dy = curve[3].y - curve[0].y;
+        int sx0 = Math::max<int>(x0, b->x0);
+        int sx1 = Math::min<int>(x1, b->x1);
 
-          // L is an (under)estimate of the Euclidean distance P0-P3.
-          //
-          // If dx >= dy, then r = sqrt(dx^2 + dy^2) can be overestimated
-          // with least maximum error by
-          //
-          //   r_upperbound = dx + (sqrt(2) - 1) * dy,
-          //
-          // where sqrt(2) - 1 can be (over)estimated by 107/256, giving an
-          // error of no more than 8.4%.
-          //
-          // Similarly, some elementary calculus shows that r can be
-          // underestimated with least maximum error by
-          //
-          //   r_lowerbound = sqrt(2 + sqrt(2)) / 2 * dx
-          //                + sqrt(2 - sqrt(2)) / 2 * dy .
-          //
-          // 236/256 and 97/256 are (under)estimates of the two algebraic
-          // numbers, giving an error of no more than 8.1%.
-          dx_ = Math::abs(dx);
-          dy_ = Math::abs(dy);
+        if (sx0 >= sx1)
+          continue;
 
-          // This is the same as:
-          //
-          //   L = (236 * max( dx_, dy_ ) + 97 * min( dx_, dy_ )) >> 8;
-          L = ((dx_ > dy_) ? (236 * dx_ +  97 * dy_)
-                           : ( 97 * dx_ + 236 * dy_)) >> 8;
+        NEW_SPAN(span, return);
+        span->setPositionAndType(sx0, sx1, type);
 
-          // Avoid possible arithmetic overflow below by splitting.
-          if (L > 32767)
-            goto _CBezierSplit;
+        if (type == RASTER_SPAN_C)
+          span->setConstMask(opacity);
+        else
+          span->setVariantMask(rowMask + (uint)(sx0 - x0) * advance);
+      }
 
-          // Max deviation may be as much as (s/L) * 3/4 (if Hain's v = 1).
-          limit = L * (int)(A8_SCALE / 6);
+      span = scanline->end(span);
 
-          // s is L * the perpendicular distance from P1 to the line P0-P3.
-          dx1 = curve[1].x - curve[0].x;
-          dy1 = curve[1].y - curve[0].y;
-          s = Math::abs(dy * dx1 - dx * dy1);
+      // The band doesn't intersect the box horizontally.
+      if (span == NULL)
+        break;
 
-          if (s > limit)
-            goto _CBezierSplit;
+      if (yPos != y)
+        filler->_skip(filler, y - yPos);
 
-          // s is L * the perpendicular distance from P2 to the line P0-P3.
-          dx2 = curve[2].x - curve[0].x;
-          dy2 = curve[2].y - curve[0].y;
-          s = Math::abs(dy * dx2 - dx * dy2);
+      process(filler, span);
+      yPos = y + 1;
+    }
+  } while (cPtr != cEnd);
+}
 
-          if (s > limit)
-            goto _CBezierSplit;
+// ============================================================================
+// [Fog::MaskRasterizer8 - Render - Clip-Mask]
+// ============================================================================
 
-          // If P1 or P2 is outside P0-P3, split the curve.
-          if ((dy * dy1 + dx * dx1 < 0) ||
-              (dy * dy2 + dx * dx2 < 0) ||
-              (dy * (curve[3].y - curve[1].y) + dx * (curve[3].x - curve[1].x) < 0) ||
-              (dy * (curve[3].y - curve[2].y) + dx * (curve[3].x - curve[2].x) < 0))
-            goto _CBezierSplit;
-        }
+static void FOG_CDECL MaskRasterizer8_render_st_clip_mask(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
 
-        {
-          Fixed24x8 x1 = Math::bound<Fixed24x8>(curve[0].x, self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
-          Fixed24x8 y1 = Math::bound<Fixed24x8>(curve[0].y, self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+  MaskRasterizer8_render_st_clip_box(_self, &proxy, scanline);
+}
 
-          if (!PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
-            return;
+// ============================================================================
+// [Fog::PathRasterizer8 - Construction / Destruction]
+// ============================================================================
 
-          x0 = x1;
-          y0 = y1;
+PathRasterizer8::PathRasterizer8() :
+  _allocator(A8_ALLOCATOR_SIZE)
+{
+  // Default is no multithreading.
+  _scope.reset();
 
-          if (curve == curveStack)
-            break;
+  // Clear rows.
+  _rowsCapacity = 0;
+  _rowsStorage = NULL;
+  _rowsAdjusted = NULL;
 
-          curve -= 3;
-          continue;
-        }
+  // Clear dense buffer.
+  _denseBox.reset();
+  _denseStride = 0;
+  _denseCapacity = 0;
+  _denseStorage = NULL;
+  _denseCover = NULL;
+  _denseArea = NULL;
 
-_CBezierSplit:
-        {
-          int a, b, c, d;
+  reset();
+}
 
-          curve[6].x = curve[3].x;
-          c = curve[1].x;
-          d = curve[2].x;
-          curve[1].x = a = ( curve[0].x + c ) / 2;
-          curve[5].x = b = ( curve[3].x + d ) / 2;
-          c = ( c + d ) / 2;
-          curve[2].x = a = ( a + c ) / 2;
-          curve[4].x = b = ( b + c ) / 2;
-          curve[3].x = ( a + b ) / 2;
+PathRasterizer8::~PathRasterizer8()
+{
+  if (_rowsStorage != NULL)
+    MemMgr::free(_rowsStorage);
 
-          curve[6].y = curve[3].y;
-          c = curve[1].y;
-          d = curve[2].y;
-          curve[1].y = a = ( curve[0].y + c ) / 2;
-          curve[5].y = b = ( curve[3].y + d ) / 2;
-          c = ( c + d ) / 2;
-          curve[2].y = a = ( a + c ) / 2;
-          curve[4].y = b = ( b + c ) / 2;
-          curve[3].y = ( a + b ) / 2;
-        }
+  if (_denseStorage != NULL)
+    MemMgr::free(_denseStorage);
+}
 
-        curve += 3;
-        continue;
-      }
+// ============================================================================
+// [Fog::PathRasterizer8 - Helpers]
+// ============================================================================
 
-      srcPts += 3;
-      srcCmd += 3;
+template<typename FixedT>
+static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1);
 
-      if (srcCmd == srcEnd)
-        goto _ClosePath;
-    }
+static bool PathRasterizer8_renderLineDense(PathRasterizer8* self, int x0, int y0, int x1, int y1);
 
-    // ------------------------------------------------------------------------
-    // [MoveTo / Close]
-    // ------------------------------------------------------------------------
+// ============================================================================
+// [Fog::PathRasterizer8 - Reset]
+// ============================================================================
 
-    else
-    {
-      FOG_ASSERT(PathCmd::isMoveTo(c) || PathCmd::isClose(c));
+void PathRasterizer8::reset()
+{
+  // Reset scene-box.
+  _sceneBox.reset();
+  _boundingBox.setBox(-1, -1, -1, -1);
 
-_ClosePath:
-      // Close the current polygon.
-      if ((x0 != startX0) | (y0 != startY0) && !PathRasterizer8_renderLine<int>(self, x0, y0, startX0, startY0))
-        return;
+  // Reset error.
+  _error = ERR_OK;
+  // Reset opacity.
+  _opacity = 0x100;
 
-      if (srcCmd == srcEnd)
-        return;
-      
-      srcPts++;
-      srcCmd++;
+  // Reset fill-rule.
+  _fillRule = FILL_RULE_DEFAULT;
+  // Not valid neither finalized.
+  _isValid = false;
+  _isFinalized = false;
+  _isDense = false;
+}
 
-      if (srcCmd == srcEnd)
-        return;
+// ============================================================================
+// [Fog::PathRasterizer8 - Init]
+// ============================================================================
 
-      if (PathCmd::isMoveTo(c))
-        goto _MoveTo;
-      else
-        goto _Start;
+err_t PathRasterizer8::init()
+{
+  _allocator.clear();
+  _boundingBox.setBox(-1, -1, -1, -1);
+
+  _error = ERR_OK;
+  _isValid = false;
+  _isFinalized = false;
+  _isDense = false;
+
+  _sceneBox24x8.setBox(_sceneBox.x0 << 8, _sceneBox.y0 << 8, _sceneBox.x1 << 8, _sceneBox.y1 << 8);
+
+  _offsetF.reset();
+  _offsetD.reset();
+  uint i = (uint)_sceneBox.getHeight() + 1;
+
+  if (_rowsCapacity < i)
+  {
+    if (_rowsStorage != NULL)
+      MemMgr::free(_rowsStorage);
+
+    // Align...
+    _rowsCapacity = (i + 255U) & ~255U;
+    _rowsStorage = reinterpret_cast<Row*>(MemMgr::alloc(_rowsCapacity * sizeof(Row)));
+    _rowsAdjusted = NULL;
+
+    if (_rowsStorage == NULL)
+    {
+      _rowsCapacity = 0;
+      setError(ERR_RT_OUT_OF_MEMORY);
+      return _error;
     }
   }
+
+  _rowsAdjusted = _rowsStorage - _sceneBox.y0;
+  return _error;
 }
 
-void PathRasterizer8::addPath(const PathF& path)
+// ============================================================================
+// [Fog::PathRasterizer8 - Dense]
+// ============================================================================
+
+bool PathRasterizer8::initDense(const BoxI& box24x8)
 {
-  FOG_ASSERT(_isFinalized == false);
-  if (_error != ERR_OK) return;
+  FOG_ASSERT(_isDense == false);
+  FOG_ASSERT(_boundingBox.y0 == -1);
 
-  PathRasterizer8_addPathData<float>(this, path.getVertices(), path.getCommands(), path.getLength(), _offsetF);
-}
+  // The box is inclusive, vertices at x1/y1 can generate cells there.
+  int x0 = box24x8.x0 >> A8_SHIFT;
+  int y0 = box24x8.y0 >> A8_SHIFT;
+  int w = (box24x8.x1 >> A8_SHIFT) - x0 + 1;
+  int h = (box24x8.y1 >> A8_SHIFT) - y0 + 1;
 
-void PathRasterizer8::addPath(const PathF& path, const PointF& _offset)
-{
-  FOG_ASSERT(_isFinalized == false);
-  if (_error != ERR_OK) return;
+  if (w > A8_DENSE_SIZE || h > A8_DENSE_SIZE)
+    return false;
 
-  PointF offset = _offset + _offsetF;
-  PathRasterizer8_addPathData<float>(this, path.getVertices(), path.getCommands(), path.getLength(), offset);
+  uint32_t size = (uint32_t)w * (uint32_t)h;
+
+  if (_denseCapacity < size)
+  {
+    if (_denseStorage != NULL)
+      MemMgr::free(_denseStorage);
+
+    // Align...
+    _denseCapacity = (size + 1023U) & ~1023U;
+    _denseStorage = reinterpret_cast<int*>(MemMgr::alloc(_denseCapacity * 2 * sizeof(int)));
+
+    if (_denseStorage == NULL)
+    {
+      // Not fatal, the chunk-based rasterization will be used instead.
+      _denseCapacity = 0;
+      return false;
+    }
+  }
+
+  _denseBox.setBox(x0, y0, x0 + w, y0 + h);
+  _denseStride = w;
+  _denseCover = _denseStorage;
+  _denseArea = _denseStorage + size;
+
+  MemOps::zero(_denseStorage, size * 2 * sizeof(int));
+  _isDense = true;
+
+  return true;
 }
 
-void PathRasterizer8::addPath(const PathD& path)
+err_t PathRasterizer8::denseToChunks()
 {
+  FOG_ASSERT(_isDense);
   FOG_ASSERT(_isFinalized == false);
-  if (_error != ERR_OK) return;
 
-  PathRasterizer8_addPathData<double>(this, path.getVertices(), path.getCommands(), path.getLength(), _offsetD);
+  _isDense = false;
+
+  // Nothing has been rasterized, the rows will be initialized by renderLine().
+  if (_boundingBox.y0 == -1)
+    return ERR_OK;
+
+  // The bounding-box is inclusive here (not finalized).
+  int bx0 = _boundingBox.x0 - _denseBox.x0;
+  int bx1 = _boundingBox.x1 - _denseBox.x0 + 1;
+
+  int y = _boundingBox.y0;
+  int yEnd = _boundingBox.y1;
+
+  for (;;)
+  {
+    size_t offset = (size_t)(y - _denseBox.y0) * (size_t)_denseStride;
+
+    const int* cover = _denseCover + offset;
+    const int* area = _denseArea + offset;
+
+    int x0 = bx0;
+    int x1 = bx1;
+
+    // Skip cells which have no effect.
+    while (x0 < x1 && (cover[x0    ] | area[x0    ]) == 0) x0++;
+    while (x0 < x1 && (cover[x1 - 1] | area[x1 - 1]) == 0) x1--;
+
+    Chunk* first = NULL;
+    Chunk* last = NULL;
+
+    while (x0 < x1)
+    {
+      int length = Math::min<int>(x1 - x0, A8_MAX_CHUNK_LENGTH);
+      Chunk* chunk = static_cast<Chunk*>(_allocator.alloc(Chunk::getSizeOf(length)));
+
+      if (FOG_IS_NULL(chunk))
+      {
+        setError(ERR_RT_OUT_OF_MEMORY);
+        return _error;
+      }
+
+      chunk->x0 = _denseBox.x0 + x0;
+      chunk->x1 = _denseBox.x0 + x0 + length;
+
+      // Merged cells can be out of the Cell::set() assertion range.
+      for (int i = 0; i < length; i++)
+      {
+        chunk->cells[i].cover = cover[x0 + i];
+        chunk->cells[i].area = area[x0 + i];
+      }
+
+      if (first == NULL)
+      {
+        first = chunk;
+      }
+      else
+      {
+        last->next = chunk;
+        chunk->prev = last;
+      }
+
+      last = chunk;
+      x0 += length;
+    }
+
+    if (first != NULL)
+    {
+      first->prev = last;
+      last->next = first;
+    }
+
+    _rowsAdjusted[y].first = first;
+
+    if (y == yEnd)
+      break;
+    y++;
+  }
+
+  return ERR_OK;
 }
 
-void PathRasterizer8::addPath(const PathD& path, const PointD& _offset)
+template<typename SrcT>
+static bool PathRasterizer8_measurePathData(PathRasterizer8* self, BoxI& box24x8,
+  const SrcT_(Point)* srcPts, const uint8_t* srcCmd, size_t count, const SrcT_(Point)& offset)
 {
-  FOG_ASSERT(_isFinalized == false);
-  if (_error != ERR_OK) return;
+  int limit = A8_DENSE_SIZE << A8_SHIFT;
 
-  PointD offset = _offset + _offsetD;
-  PathRasterizer8_addPathData<double>(this, path.getVertices(), path.getCommands(), path.getLength(), offset);
-}
+  int x0 = self->_sceneBox24x8.x1;
+  int y0 = self->_sceneBox24x8.y1;
+  int x1 = self->_sceneBox24x8.x0;
+  int y1 = self->_sceneBox24x8.y0;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - AddBox]
-// ============================================================================
+  for (size_t i = 0; i < count; i++)
+  {
+    // The vertex of the 'close' command is not used.
+    if (PathCmd::isClose(srcCmd[i]))
+      continue;
 
-static const uint8_t Rasterizer_boxCommands[8] =
-{
-  PATH_CMD_MOVE_TO,
-  PATH_CMD_LINE_TO,
-  PATH_CMD_LINE_TO,
-  PATH_CMD_LINE_TO,
-  PATH_CMD_CLOSE,
-  0xFF,
-  0xFF,
-  0xFF
-};
+    int x = Math::bound<int>(upscale24x8(srcPts[i].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+    int y = Math::bound<int>(upscale24x8(srcPts[i].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
 
-void PathRasterizer8::addBox(const BoxF& box)
+    if (x < x0) x0 = x;
+    if (y < y0) y0 = y;
+    if (x > x1) x1 = x;
+    if (y > y1) y1 = y;
+
+    if (x1 - x0 >= limit || y1 - y0 >= limit)
+      return false;
+  }
+
+  box24x8.setBox(x0, y0, x1, y1);
+  return x0 <= x1;
+}
+
+//! @internal
+//!
+//! @brief Select the dense mode for small shapes or leave it if the path
+//! doesn't fit into the dense buffer. Returns false on error.
+template<typename SrcT>
+static bool PathRasterizer8_prepareDense(PathRasterizer8* self,
+  const SrcT_(Point)* srcPts, const uint8_t* srcCmd, size_t count, const SrcT_(Point)& offset)
 {
-  if (_error != ERR_OK) return;
-  FOG_ASSERT(_isFinalized == false);
+  BoxI box24x8(UNINITIALIZED);
 
-  PointF pts[5];
-  pts[0].set(box.x0, box.y0);
-  pts[1].set(box.x1, box.y0);
-  pts[2].set(box.x1, box.y1);
-  pts[3].set(box.x0, box.y1);
-  pts[4].set(0.0f, 0.0f);
+  if (self->_isDense)
+  {
+    if (PathRasterizer8_measurePathData<SrcT>(self, box24x8, srcPts, srcCmd, count, offset) &&
+        (box24x8.x0 >> A8_SHIFT) >= self->_denseBox.x0 && (box24x8.x1 >> A8_SHIFT) < self->_denseBox.x1 &&
+        (box24x8.y0 >> A8_SHIFT) >= self->_denseBox.y0 && (box24x8.y1 >> A8_SHIFT) < self->_denseBox.y1)
+    {
+      return true;
+    }
 
-  PathRasterizer8_addPathData<float>(this, pts, Rasterizer_boxCommands, 5, _offsetF);
+    return self->denseToChunks() == ERR_OK;
+  }
+
+  // The dense mode can be only selected by the first shape. The region clip
+  // is not supported, because the dense sweep generates spans per row.
+  if (self->_boundingBox.y0 == -1 && self->_clipType != RASTER_CLIP_REGION)
+  {
+    if (PathRasterizer8_measurePathData<SrcT>(self, box24x8, srcPts, srcCmd, count, offset))
+      self->initDense(box24x8);
+  }
+
+  return true;
 }
 
-void PathRasterizer8::addBox(const BoxD& box)
+//! @internal
+//!
+//! @brief Render a line in the dense buffer, the line must be in one row,
+//! @a cover and @a area point to that row.
+static FOG_INLINE void PathRasterizer8_renderHLineDense(int* cover, int* area, int x0, int fy0, int x1, int fy1)
 {
-  if (_error != ERR_OK) return;
-  FOG_ASSERT(_isFinalized == false);
+  // Horizontal line doesn't generate cover.
+  if (fy0 == fy1)
+    return;
 
-  PointD pts[5];
-  pts[0].set(box.x0, box.y0);
-  pts[1].set(box.x1, box.y0);
-  pts[2].set(box.x1, box.y1);
-  pts[3].set(box.x0, box.y1);
-  pts[4].set(0.0, 0.0);
+  int ex0 = x0 >> A8_SHIFT;
+  int ex1 = x1 >> A8_SHIFT;
+  int fx0 = x0 & A8_MASK;
+  int fx1 = x1 & A8_MASK;
 
-  PathRasterizer8_addPathData<double>(this, pts, Rasterizer_boxCommands, 5, _offsetD);
+  int delta;
+
+  // Everything is located in a single cell.
+  if (ex0 == ex1)
+  {
+    delta = fy1 - fy0;
+    cover[ex0] += delta;
+    area[ex0] += (fx0 + fx1) * delta;
+    return;
+  }
+
+  // Render a run of adjacent cells on the same row.
+  int p = (A8_SCALE - fx0) * (fy1 - fy0);
+  int first = A8_SCALE;
+  int inc = 1;
+  int dx = x1 - x0;
+
+  if (dx < 0)
+  {
+    p = fx0 * (fy1 - fy0);
+    first = 0;
+    inc = -1;
+    dx = -dx;
+  }
+
+  delta = p / dx;
+  int mod = p % dx;
+
+  if (mod < 0)
+  {
+    delta--;
+    mod += dx;
+  }
+
+  cover[ex0] += delta;
+  area[ex0] += (fx0 + first) * delta;
+
+  ex0 += inc;
+  fy0 += delta;
+
+  if (ex0 != ex1)
+  {
+    p = A8_SCALE * (fy1 - fy0 + delta);
+
+    int lift = p / dx;
+    int rem = p % dx;
+
+    if (rem < 0)
+    {
+      lift--;
+      rem += dx;
+    }
+
+    mod -= dx;
+
+    do {
+      delta = lift;
+      mod += rem;
+
+      if (mod >= 0)
+      {
+        mod -= dx;
+        delta++;
+      }
+
+      cover[ex0] += delta;
+      area[ex0] += A8_SCALE * delta;
+
+      fy0 += delta;
+      ex0 += inc;
+    } while (ex0 != ex1);
+  }
+
+  delta = fy1 - fy0;
+  cover[ex1] += delta;
+  area[ex1] += (fx1 + A8_SCALE - first) * delta;
 }
 
-// ============================================================================
-// [Fog::PathRasterizer8 - ROW_NEW_CHUNK]
-// ============================================================================
+static bool PathRasterizer8_renderLineDense(PathRasterizer8* self, int x0, int y0, int x1, int y1)
+{
+  int dx = x1 - x0;
+  int dy = y1 - y0;
 
-#define ROW_NEW_CHUNK(_Chunk_, _X_, _Length_) \
-  FOG_MACRO_BEGIN \
-    _Chunk_ = static_cast<PathRasterizer8::Chunk*>(self->_allocator.alloc(PathRasterizer8::Chunk::getSizeOf(_Length_))); \
-    if (FOG_IS_NULL(_Chunk_)) goto _Bail; \
-    \
-    _Chunk_->x0 = (_X_); \
-    _Chunk_->x1 = (_X_) + _Length_; \
-  FOG_MACRO_END
+  // The rasterizer does nothing in such case.
+  if (dy == 0)
+    return true;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_ONE]
-// ============================================================================
+  // --------------------------------------------------------------------------
+  // [Bounding-Box]
+  // --------------------------------------------------------------------------
 
-#define ROW_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_) \
-  FOG_MACRO_BEGIN \
-    PathRasterizer8::Chunk* _chunk = _Row_->first; \
-    PathRasterizer8::Chunk* _cNew; \
-    PathRasterizer8::Chunk* _cLast; \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [First]                                                             */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_chunk == NULL) \
-    { \
-      ROW_NEW_CHUNK(_cNew, _X_, 1); \
-      _cNew->prev = _cNew; \
-      _cNew->next = _cNew; \
-      \
-      _Row_->first = _cNew; \
-      goto _Name_##_Add_One_Set; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Prepend]                                                           */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    _cLast = _chunk->prev; \
-    \
-    if (_X_ < _chunk->x0) \
-    { \
-      ROW_NEW_CHUNK(_cNew, _X_, 1); \
-      _cNew->prev = _cLast; \
-      _cNew->next = _chunk; \
-      \
-      _cLast->next = _cNew; \
-      _chunk->prev = _cNew; \
-      \
-      _Row_->first = _cNew; \
-      goto _Name_##_Add_One_Set; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Insert / Append]                                                   */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_X_ < _cLast->x1) \
-    { \
-      if ((_X_ - _chunk->x0) <= (_cLast->x1 - _X_)) \
-      { \
-        for (;;) \
-        { \
-          if (_X_ < _chunk->x0) \
-            break; \
-          \
-          if (_X_ < _chunk->x1) \
-            goto _Name_##_Add_One_Merge; \
-          \
-          FOG_ASSERT(_chunk != _cLast); \
-          _chunk = _chunk->next; \
-        } \
-      } \
-      else \
-      { \
-        _chunk = _cLast; \
-        for (;;) \
-        { \
-          if (_X_ >= _chunk->x0) \
-          { \
-_Name_##_Add_One_Merge: \
-            LOG_CELL("Add_One", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-            _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
-            goto _Name_##_Add_One_End; \
-          } \
-          \
-          _chunk = _chunk->prev; \
-          FOG_ASSERT(_chunk != _cLast); \
-          \
-          if (_X_ >= _chunk->x1) \
-            break; \
-        } \
-        _chunk = _chunk->next; \
-      } \
-      FOG_ASSERT(_X_ <= _chunk->x0); \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Create]                                                            */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    _cLast = _chunk->prev; \
-    \
-    ROW_NEW_CHUNK(_cNew, _X_, 1); \
-    _cNew->prev = _cLast; \
-    _cNew->next = _chunk; \
-    \
-    _cLast->next = _cNew; \
-    _chunk->prev = _cNew; \
-    \
-_Name_##_Add_One_Set: \
-    LOG_CELL("Add_One", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-    _cNew->cells[0].set(_Cover_, _Area_); \
-    \
-_Name_##_Add_One_End: \
-    ; \
-  FOG_MACRO_END \
+  {
+    int bx0 = Math::min(x0, x1) >> A8_SHIFT;
+    int bx1 = Math::max(x0, x1) >> A8_SHIFT;
+    int by0 = Math::min(y0, y1) >> A8_SHIFT;
+    int by1 = (Math::max(y0, y1) - 1) >> A8_SHIFT;
+
+    if (FOG_UNLIKELY(self->_boundingBox.y0 == -1))
+    {
+      self->_boundingBox.setBox(bx0, by0, bx1, by1);
+    }
+    else
+    {
+      if (bx0 < self->_boundingBox.x0) self->_boundingBox.x0 = bx0;
+      if (by0 < self->_boundingBox.y0) self->_boundingBox.y0 = by0;
+      if (bx1 > self->_boundingBox.x1) self->_boundingBox.x1 = bx1;
+      if (by1 > self->_boundingBox.y1) self->_boundingBox.y1 = by1;
+    }
+  }
+
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
+
+  // Translate the line so the cell indices are relative to the dense buffer,
+  // the fractional parts are not changed.
+  {
+    int ox = self->_denseBox.x0 << A8_SHIFT;
+    int oy = self->_denseBox.y0 << A8_SHIFT;
+
+    x0 -= ox;
+    y0 -= oy;
+    x1 -= ox;
+    y1 -= oy;
+  }
+
+  int* cover = self->_denseCover;
+  int* area = self->_denseArea;
+
+  int ey0 = y0 >> A8_SHIFT;
+  int ey1 = y1 >> A8_SHIFT;
+  int fy0 = y0 & A8_MASK;
+  int fy1 = y1 & A8_MASK;
+
+  ssize_t offset = (ssize_t)ey0 * self->_denseStride;
+  ssize_t step = self->_denseStride;
+
+  // --------------------------------------------------------------------------
+  // [Single Row]
+  // --------------------------------------------------------------------------
+
+  if (ey0 == ey1)
+  {
+    PathRasterizer8_renderHLineDense(cover + offset, area + offset, x0, fy0, x1, fy1);
+    return true;
+  }
+
+  int first = A8_SCALE;
+  int delta;
+
+  // --------------------------------------------------------------------------
+  // [Vertical Only]
+  // --------------------------------------------------------------------------
+
+  if (dx == 0)
+  {
+    int ex = x0 >> A8_SHIFT;
+    int twoFx = (x0 & A8_MASK) << 1;
+    int n = Math::abs(ey1 - ey0) - 1;
+
+    if (dy < 0)
+    {
+      first = 0;
+      step = -step;
+    }
+
+    offset += ex;
+
+    delta = first - fy0;
+    cover[offset] += delta;
+    area[offset] += twoFx * delta;
+    offset += step;
+
+    delta = first + first - A8_SCALE;
+    while (n > 0)
+    {
+      cover[offset] += delta;
+      area[offset] += twoFx * delta;
+      offset += step;
+      n--;
+    }
+
+    delta = fy1 - A8_SCALE + first;
+    cover[offset] += delta;
+    area[offset] += twoFx * delta;
+    return true;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Generic]
+  // --------------------------------------------------------------------------
+
+  int p = (A8_SCALE - fy0) * dx;
+  int inc = 1;
+
+  if (dy < 0)
+  {
+    p = fy0 * dx;
+    first = 0;
+    inc = -1;
+    dy = -dy;
+    step = -step;
+  }
+
+  delta = p / dy;
+  int mod = p % dy;
+
+  if (mod < 0)
+  {
+    delta--;
+    mod += dy;
+  }
+
+  int xFrom = x0 + delta;
+  PathRasterizer8_renderHLineDense(cover + offset, area + offset, x0, fy0, xFrom, first);
+
+  ey0 += inc;
+  offset += step;
+
+  if (ey0 != ey1)
+  {
+    p = A8_SCALE * dx;
+
+    int lift = p / dy;
+    int rem = p % dy;
+
+    if (rem < 0)
+    {
+      lift--;
+      rem += dy;
+    }
+
+    mod -= dy;
+
+    do {
+      delta = lift;
+      mod += rem;
+
+      if (mod >= 0)
+      {
+        mod -= dy;
+        delta++;
+      }
+
+      int xTo = xFrom + delta;
+      PathRasterizer8_renderHLineDense(cover + offset, area + offset, xFrom, A8_SCALE - first, xTo, first);
+      xFrom = xTo;
+
+      ey0 += inc;
+      offset += step;
+    } while (ey0 != ey1);
+  }
+
+  PathRasterizer8_renderHLineDense(cover + offset, area + offset, xFrom, A8_SCALE - first, x1, fy1);
+  return true;
+}
 
 // ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_TWO]
+// [Fog::PathRasterizer8 - AddPath]
 // ============================================================================
 
-#define ROW_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_) \
-  FOG_MACRO_BEGIN \
-    PathRasterizer8::Chunk* _chunk = _Row_->first; \
-    PathRasterizer8::Chunk* _cNew; \
-    PathRasterizer8::Chunk* _cLast; \
-    \
-    int _count; \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [First]                                                             */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_chunk == NULL) \
-    { \
-      ROW_NEW_CHUNK(_chunk, _X_, 2); \
-      _chunk->prev = _chunk; \
-      _chunk->next = _chunk; \
-      \
-      _Row_->first = _chunk; \
-      \
-      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-      _chunk->cells[0].set(_Cover_, _Area_); \
-      \
-      _Advance_ \
-      \
-      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-      _chunk->cells[1].set(_Cover_, _Area_); \
-      \
-      goto _Name_##_Add_Two_End; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Prepend]                                                           */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    _cLast = _chunk->prev; \
-    \
-    if (_X_ < _chunk->x0) \
-    { \
-      _count = Math::min(_chunk->x0 - _X_, 2); \
-      FOG_ASSERT(_count > 0); \
-      \
-      ROW_NEW_CHUNK(_cNew, _X_, _count); \
-      _cNew->prev = _cLast; \
-      _cNew->next = _chunk; \
-      \
-      _cLast->next = _cNew; \
-      _chunk->prev = _cNew; \
-      \
-      _Row_->first = _cNew; \
-      FOG_ASSERT(_cNew->x1 <= _chunk->x0); \
-      \
-      goto _Name_##_Add_Two_Set; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Insert / Append]                                                   */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_X_ < _cLast->x1) \
-    { \
-      if ((_X_ - _chunk->x0) <= (_cLast->x1 - _X_)) \
-      { \
-        for (;;) \
-        { \
-          if (_X_ < _chunk->x0) \
-            break; \
-          \
-          if (_X_ < _chunk->x1) \
-            goto _Name_##_Add_Two_Merge; \
-          \
-          FOG_ASSERT(_chunk != _cLast); \
-          _chunk = _chunk->next; \
-        } \
-      } \
-      else \
-      { \
-        _chunk = _cLast; \
-        for (;;) \
-        { \
-          if (_X_ >= _chunk->x0) \
-          { \
-_Name_##_Add_Two_Merge: \
-            LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-            _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
-            \
-            _Advance_ \
-            \
-            if (_X_ < _chunk->x1) \
-            { \
-_Name_##_Add_Two_Merge_Second: \
-              LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-              _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
-              goto _Name_##_Add_Two_End; \
-            } \
-            \
-            _cLast = _chunk; \
-            _chunk = _chunk->next; \
-            \
-            if (_X_ >= _chunk->x0 && _X_ < _chunk->x1) \
-              goto _Name_##_Add_Two_Merge_Second; \
-            \
-            ROW_NEW_CHUNK(_cNew, _X_, 1); \
-            _cNew->prev = _cLast; \
-            _cNew->next = _chunk; \
-            \
-            _cLast->next = _cNew; \
-            _chunk->prev = _cNew; \
-            \
-            LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-            _cNew->cells[0].set(_Cover_, _Area_); \
-            goto _Name_##_Add_Two_End; \
-          } \
-          \
-          _chunk = _chunk->prev; \
-          FOG_ASSERT(_chunk != _cLast); \
-          \
-          if (_X_ >= _chunk->x1) \
-            break; \
-        } \
-        _chunk = _chunk->next; \
-      } \
-      FOG_ASSERT(_X_ <= _chunk->x0); \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Create]                                                            */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    _cLast = _chunk->prev; \
-    _count = _chunk->x0 - _X_; \
-    \
-    if ((uint)_count >= 2) _count = 2; \
-    \
-    ROW_NEW_CHUNK(_cNew, _X_, _count); \
-    _cNew->prev = _cLast; \
-    _cNew->next = _chunk; \
-    \
-    _cLast->next = _cNew; \
-    _chunk->prev = _cNew; \
-    \
-_Name_##_Add_Two_Set: \
-    LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-    _cNew->cells[0].set(_Cover_, _Area_); \
-    \
-    _Advance_ \
-    \
-    if (_count > 1) \
-    { \
-      FOG_ASSERT(_cNew->x1 - _cNew->x0 == 2); \
-      \
-      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-      _cNew->cells[1].set(_Cover_, _Area_); \
-    } \
-    else \
-    { \
-      FOG_ASSERT(_cNew->next == _chunk); \
-      FOG_ASSERT(_cNew->x1 <= _chunk->x0); \
-      \
-      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
-      _chunk->cells[0].add(_Cover_, _Area_); \
-    } \
-    \
-_Name_##_Add_Two_End: \
-    ; \
-  FOG_MACRO_END
+template<typename SrcT>
+static void PathRasterizer8_addPathData(PathRasterizer8* self,
+  const SrcT_(Point)* srcPts, const uint8_t* srcCmd, size_t count, const SrcT_(Point)& offset)
+{
+  if (count == 0)
+    return;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - ROW_ADD_N]
-// ============================================================================
+  if (!PathRasterizer8_prepareDense<SrcT>(self, srcPts, srcCmd, count, offset))
+    return;
 
-#define ROW_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
-  FOG_MACRO_BEGIN \
-    PathRasterizer8::Chunk* _cFirst = _Row_->first; \
-    PathRasterizer8::Chunk* _cLast = NULL; \
-    \
-    PathRasterizer8::Chunk* _chunk = _cFirst; \
-    PathRasterizer8::Cell* _cell; \
-    \
-    int _stop; \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [First]                                                             */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_chunk == NULL) \
-    { \
-      int _length = _X1_ - _X0_; \
-      \
-      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
-        _length = A8_MAX_CHUNK_LENGTH; \
-      \
-      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
-      _chunk->prev = _chunk; \
-      _chunk->next = _chunk; \
-      \
-      _cFirst = _chunk; \
-      _cLast = _chunk; \
-      \
-      _Row_->first = _chunk; \
-      \
-      _cell = _chunk->cells; \
-      _stop = _X0_ + _length; \
-      \
-      goto _Name_##_Add_N_Fill; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Prepend]                                                           */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    _cLast = _chunk->prev; \
-    \
-    if (_X0_ < _chunk->x0) \
-    { \
-      int _length = Math::min(_chunk->x0, _X1_) - _X0_; \
-      \
-      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
-        _length = A8_MAX_CHUNK_LENGTH; \
-      \
-      PathRasterizer8::Chunk* _cNext = _chunk; \
-      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
-      \
-      _chunk->prev = _cLast; \
-      _chunk->next = _cNext; \
-      \
-      _cLast->next = _chunk; \
-      _cNext->prev = _chunk; \
-      \
-      _cFirst = _chunk; \
-      _Row_->first = _chunk; \
-      \
-      _cell = _chunk->cells; \
-      _stop = _X0_ + _length; \
-      \
-      goto _Name_##_Add_N_Fill; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Append]                                                            */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if (_X0_ >= _cLast->x1) \
-    { \
-      _chunk = _cLast; \
-      \
-      goto _Name_##_Add_N_Append; \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Insert]                                                            */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-    if ((_X0_ - _chunk->x0) <= (_cLast->x1 - _X0_)) \
-    { \
-      for (;;) \
-      { \
-        if (_X0_ < _chunk->x1) \
-          goto _Name_##_Add_N_Merge; \
-        \
-        _chunk = _chunk->next; \
-        \
-        /* The list is circular, but we know that the [x0, x1] intersects  */ \
-        /* with the bounding-box of the chunk-list. This means that we     */ \
-        /* can't skip into the first chunk in this loop.                   */ \
-        FOG_ASSERT(_chunk != _cFirst); \
-      } \
-    } \
-    else \
-    { \
-      _chunk = _cLast; \
-      \
-      for (;;) \
-      { \
-        if (_X0_ >= _chunk->x0) \
-        { \
-          if (_X0_ >= _chunk->x1) \
-            _chunk = _chunk->next; \
-          \
-          goto _Name_##_Add_N_Merge; \
-        } \
-        \
-        /* Again, we can't iterate forever. */ \
-        FOG_ASSERT(_chunk != _cFirst); \
-        _chunk = _chunk->prev; \
-      } \
-    } \
-    \
-    /* ------------------------------------------------------------------- */ \
-    /* [Advance]                                                           */ \
-    /* ------------------------------------------------------------------- */ \
-    \
-_Name_##_Add_N_Advance: \
-    if (_chunk == _cLast) \
-    { \
-_Name_##_Add_N_Append: \
-      int _length = _X1_ - _X0_; \
-      \
-      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
-        _length = A8_MAX_CHUNK_LENGTH; \
-      \
-      PathRasterizer8::Chunk* _cPrev = _chunk; \
-      \
-      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
-      _chunk->prev = _cPrev; \
-      _chunk->next = _cFirst; \
-      \
-      _cFirst->prev = _chunk; \
-      _cPrev->next = _chunk; \
-      \
-      _cLast = _chunk; \
-      _cell = _chunk->cells; \
-      \
-      _stop = _X0_ + _length; \
-    } \
-    else \
-    { \
-      _chunk = _chunk->next; \
-      \
-_Name_##_Add_N_Merge: \
-      if (_X0_ < _chunk->x0) \
-      { \
-        int _length = Math::min(_X1_, _chunk->x0) - _X0_; \
-        \
-        if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
-          _length = A8_MAX_CHUNK_LENGTH; \
-        \
-        PathRasterizer8::Chunk* _cPrev = _chunk->prev; \
-        PathRasterizer8::Chunk* _cNext = _chunk; \
-        \
-        ROW_NEW_CHUNK(_chunk, _X0_, _length); \
-        _chunk->prev = _cPrev; \
-        _chunk->next = _cNext; \
-        \
+  const uint8_t* srcEnd = srcCmd + count;
+
+  // Current/Start moveTo x position.
+  Fixed24x8 x0, startX0;
+  // Current/Start moveTo y position.
+  Fixed24x8 y0, startY0;
+
+  // Current command.
+  uint8_t c;
+
+  // Stack.
+  PointI curveStack[32 * 3 + 1];
+  int levelStack[32];
+
+_Start:
+  // Find: 'move-to' command and then go to the second loop.
+  for (;;)
+  {
+    c = srcCmd[0];
+    srcPts++;
+    srcCmd++;
+
+    // This can happen only when 'move-to' is the last command. In this case
+    // there is nothing to rasterize.
+    if (srcCmd == srcEnd)
+      return;
+
+    // ------------------------------------------------------------------------
+    // [MoveTo]
+    // ------------------------------------------------------------------------
+
+    if (PathCmd::isMoveTo(c))
+    {
+_MoveTo:
+      x0 = startX0 = Math::bound<Fixed24x8>(upscale24x8(srcPts[-1].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+      y0 = startY0 = Math::bound<Fixed24x8>(upscale24x8(srcPts[-1].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+      break;
+    }
+  }
+
+  // Process: 'line-to', 'quad-to' and 'cubic-to'.
+  // Stop at: 'move-to', 'close'.
+  for (;;)
+  {
+    c = srcCmd[0];
+
+    // ------------------------------------------------------------------------
+    // [LineTo]
+    // ------------------------------------------------------------------------
+
+    if (PathCmd::isLineTo(c))
+    {
+      Fixed24x8 x1 = Math::bound<Fixed24x8>(upscale24x8(srcPts[0].x + offset.x), self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+      Fixed24x8 y1 = Math::bound<Fixed24x8>(upscale24x8(srcPts[0].y + offset.y), self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+
+      if ((x0 != x1) | (y0 != y1) && !PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
+        return;
+
+      x0 = x1;
+      y0 = y1;
+
+      srcPts++;
+      srcCmd++;
+
+      if (srcCmd == srcEnd)
+        goto _ClosePath;
+    }
+
+    // ------------------------------------------------------------------------
+    // [QuadTo]
+    // ------------------------------------------------------------------------
+
+    else if (PathCmd::isQuadTo(c))
+    {
+      PointI* curve = curveStack;
+
+      curve[0].x = upscale24x8(srcPts[ 1].x + offset.x);
+      curve[0].y = upscale24x8(srcPts[ 1].y + offset.y);
+      curve[1].x = upscale24x8(srcPts[ 0].x + offset.x);
+      curve[1].y = upscale24x8(srcPts[ 0].y + offset.y);
+      curve[2].x = x0;
+      curve[2].y = y0;
+
+      int d = Math::max(Math::abs( curve[2].x + curve[0].x - 2 * curve[1].x),
+                        Math::abs( curve[2].y + curve[0].y - 2 * curve[1].y));
+
+      int level = 0;
+      int top = 0;
+
+      while (d > (A8_SCALE / 6))
+      {
+        d >>= 2;
+        level++;
+      }
+
+      levelStack[0] = level;
+      top = 0;
+
+      do {
+        level = levelStack[top];
+        if (level > 1)
+        {
+          int a, b;
+
+          curve[4].x = curve[2].x;
+          b = curve[1].x;
+          a = curve[3].x = (curve[2].x + b) / 2;
+          b = curve[1].x = (curve[0].x + b) / 2;
+          curve[2].x = (a + b) / 2;
+
+          curve[4].y = curve[2].y;
+          b = curve[1].y;
+          a = curve[3].y = (curve[2].y + b) / 2;
+          b = curve[1].y = (curve[0].y + b) / 2;
+          curve[2].y = (a + b) / 2;
+
+          curve += 2;
+          top++;
+          levelStack[top] = levelStack[top - 1] = level - 1;
+          continue;
+        }
+
+        // LineTo.
+        Fixed24x8 x1 = Math::bound<Fixed24x8>(curve[0].x, self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+        Fixed24x8 y1 = Math::bound<Fixed24x8>(curve[0].y, self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+
+        if (!PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
+          return;
+
+        x0 = x1;
+        y0 = y1;
+
+        top--;
+        curve -= 2;
+      } while (top >= 0);
+
+      srcPts += 2;
+      srcCmd += 2;
+
+      if (srcCmd == srcEnd)
+        goto _ClosePath;
+    }
+
+    // ------------------------------------------------------------------------
+    // [CubicTo]
+    // ------------------------------------------------------------------------
+
+    else if (PathCmd::isCubicTo(c))
+    {
+      PointI* curve = curveStack;
+      PointI* curveEnd = curve + 31 * 3;
+
+      curve[0].x = upscale24x8(srcPts[ 2].x + offset.x);
+      curve[0].y = upscale24x8(srcPts[ 2].y + offset.y);
+      curve[1].x = upscale24x8(srcPts[ 1].x + offset.x);
+      curve[1].y = upscale24x8(srcPts[ 1].y + offset.y);
+      curve[2].x = upscale24x8(srcPts[ 0].x + offset.x);
+      curve[2].y = upscale24x8(srcPts[ 0].y + offset.y);
+      curve[3].x = x0;
+      curve[3].y = y0;
+
+      for (;;)
+      {
+        // Decide whether to split or draw. See `Rapid Termination. Evaluation
+        // for Recursive Subdivision of Bezier Curves' by Thomas F. Hain, at:
+        // http://www.cis.southalabama.edu/~hain/general/Publications/Bezier/Camera-ready%20CISST02%202.pdf
+        if (curve != curveEnd)
+        {
+          int dx, dy;
+          int dx_, dy_;
+          int dx1, dy1;
+          int dx2, dy2;
+          int L, s, limit;
+
+          // dx and dy are x and y components of the P0-P3 chord vector.
+          dx = curve[3].x - curve[0].x;
+          dy = curve[3].y - curve[0].y;
+
+          // L is an (under)estimate of the Euclidean distance P0-P3.
+          //
+          // If dx >= dy, then r = sqrt(dx^2 + dy^2) can be overestimated
+          // with least maximum error by
+          //
+          //   r_upperbound = dx + (sqrt(2) - 1) * dy,
+          //
+          // where sqrt(2) - 1 can be (over)estimated by 107/256, giving an
+          // error of no more than 8.4%.
+          //
+          // Similarly, some elementary calculus shows that r can be
+          // underestimated with least maximum error by
+          //
+          //   r_lowerbound = sqrt(2 + sqrt(2)) / 2 * dx
+          //                + sqrt(2 - sqrt(2)) / 2 * dy .
+          //
+          // 236/256 and 97/256 are (under)estimates of the two algebraic
+          // numbers, giving an error of no more than 8.1%.
+          dx_ = Math::abs(dx);
+          dy_ = Math::abs(dy);
+
+          // This is the same as:
+          //
+          //   L = (236 * max( dx_, dy_ ) + 97 * min( dx_, dy_ )) >> 8;
+          L = ((dx_ > dy_) ? (236 * dx_ +  97 * dy_)
+                           : ( 97 * dx_ + 236 * dy_)) >> 8;
+
+          // Avoid possible arithmetic overflow below by splitting.
+          if (L > 32767)
+            goto _CBezierSplit;
+
+          // Max deviation may be as much as (s/L) * 3/4 (if Hain's v = 1).
+          limit = L * (int)(A8_SCALE / 6);
+
+          // s is L * the perpendicular distance from P1 to the line P0-P3.
+          dx1 = curve[1].x - curve[0].x;
+          dy1 = curve[1].y - curve[0].y;
+          s = Math::abs(dy * dx1 - dx * dy1);
+
+          if (s > limit)
+            goto _CBezierSplit;
+
+          // s is L * the perpendicular distance from P2 to the line P0-P3.
+          dx2 = curve[2].x - curve[0].x;
+          dy2 = curve[2].y - curve[0].y;
+          s = Math::abs(dy * dx2 - dx * dy2);
+
+          if (s > limit)
+            goto _CBezierSplit;
+
+          // If P1 or P2 is outside P0-P3, split the curve.
+          if ((dy * dy1 + dx * dx1 < 0) ||
+              (dy * dy2 + dx * dx2 < 0) ||
+              (dy * (curve[3].y - curve[1].y) + dx * (curve[3].x - curve[1].x) < 0) ||
+              (dy * (curve[3].y - curve[2].y) + dx * (curve[3].x - curve[2].x) < 0))
+            goto _CBezierSplit;
+        }
+
+        {
+          Fixed24x8 x1 = Math::bound<Fixed24x8>(curve[0].x, self->_sceneBox24x8.x0, self->_sceneBox24x8.x1);
+          Fixed24x8 y1 = Math::bound<Fixed24x8>(curve[0].y, self->_sceneBox24x8.y0, self->_sceneBox24x8.y1);
+
+          if (!PathRasterizer8_renderLine<int>(self, x0, y0, x1, y1))
+            return;
+
+          x0 = x1;
+          y0 = y1;
+
+          if (curve == curveStack)
+            break;
+
+          curve -= 3;
+          continue;
+        }
+
+_CBezierSplit:
+        {
+          int a, b, c, d;
+
+          curve[6].x = curve[3].x;
+          c = curve[1].x;
+          d = curve[2].x;
+          curve[1].x = a = ( curve[0].x + c ) / 2;
+          curve[5].x = b = ( curve[3].x + d ) / 2;
+          c = ( c + d ) / 2;
+          curve[2].x = a = ( a + c ) / 2;
+          curve[4].x = b = ( b + c ) / 2;
+          curve[3].x = ( a + b ) / 2;
+
+          curve[6].y = curve[3].y;
+          c = curve[1].y;
+          d = curve[2].y;
+          curve[1].y = a = ( curve[0].y + c ) / 2;
+          curve[5].y = b = ( curve[3].y + d ) / 2;
+          c = ( c + d ) / 2;
+          curve[2].y = a = ( a + c ) / 2;
+          curve[4].y = b = ( b + c ) / 2;
+          curve[3].y = ( a + b ) / 2;
+        }
+
+        curve += 3;
+        continue;
+      }
+
+      srcPts += 3;
+      srcCmd += 3;
+
+      if (srcCmd == srcEnd)
+        goto _ClosePath;
+    }
+
+    // ------------------------------------------------------------------------
+    // [MoveTo / Close]
+    // ------------------------------------------------------------------------
+
+    else
+    {
+      FOG_ASSERT(PathCmd::isMoveTo(c) || PathCmd::isClose(c));
+
+_ClosePath:
+      // Close the current polygon.
+      if ((x0 != startX0) | (y0 != startY0) && !PathRasterizer8_renderLine<int>(self, x0, y0, startX0, startY0))
+        return;
+
+      if (srcCmd == srcEnd)
+        return;
+      
+      srcPts++;
+      srcCmd++;
+
+      if (srcCmd == srcEnd)
+        return;
+
+      if (PathCmd::isMoveTo(c))
+        goto _MoveTo;
+      else
+        goto _Start;
+    }
+  }
+}
+
+void PathRasterizer8::addPath(const PathF& path)
+{
+  FOG_ASSERT(_isFinalized == false);
+  if (_error != ERR_OK) return;
+
+  PathRasterizer8_addPathData<float>(this, path.getVertices(), path.getCommands(), path.getLength(), _offsetF);
+}
+
+void PathRasterizer8::addPath(const PathF& path, const PointF& _offset)
+{
+  FOG_ASSERT(_isFinalized == false);
+  if (_error != ERR_OK) return;
+
+  PointF offset = _offset + _offsetF;
+  PathRasterizer8_addPathData<float>(this, path.getVertices(), path.getCommands(), path.getLength(), offset);
+}
+
+void PathRasterizer8::addPath(const PathD& path)
+{
+  FOG_ASSERT(_isFinalized == false);
+  if (_error != ERR_OK) return;
+
+  PathRasterizer8_addPathData<double>(this, path.getVertices(), path.getCommands(), path.getLength(), _offsetD);
+}
+
+void PathRasterizer8::addPath(const PathD& path, const PointD& _offset)
+{
+  FOG_ASSERT(_isFinalized == false);
+  if (_error != ERR_OK) return;
+
+  PointD offset = _offset + _offsetD;
+  PathRasterizer8_addPathData<double>(this, path.getVertices(), path.getCommands(), path.getLength(), offset);
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - AddBox]
+// ============================================================================
+
+static const uint8_t Rasterizer_boxCommands[8] =
+{
+  PATH_CMD_MOVE_TO,
+  PATH_CMD_LINE_TO,
+  PATH_CMD_LINE_TO,
+  PATH_CMD_LINE_TO,
+  PATH_CMD_CLOSE,
+  0xFF,
+  0xFF,
+  0xFF
+};
+
+void PathRasterizer8::addBox(const BoxF& box)
+{
+  if (_error != ERR_OK) return;
+  FOG_ASSERT(_isFinalized == false);
+
+  PointF pts[5];
+  pts[0].set(box.x0, box.y0);
+  pts[1].set(box.x1, box.y0);
+  pts[2].set(box.x1, box.y1);
+  pts[3].set(box.x0, box.y1);
+  pts[4].set(0.0f, 0.0f);
+
+  PathRasterizer8_addPathData<float>(this, pts, Rasterizer_boxCommands, 5, _offsetF);
+}
+
+void PathRasterizer8::addBox(const BoxD& box)
+{
+  if (_error != ERR_OK) return;
+  FOG_ASSERT(_isFinalized == false);
+
+  PointD pts[5];
+  pts[0].set(box.x0, box.y0);
+  pts[1].set(box.x1, box.y0);
+  pts[2].set(box.x1, box.y1);
+  pts[3].set(box.x0, box.y1);
+  pts[4].set(0.0, 0.0);
+
+  PathRasterizer8_addPathData<double>(this, pts, Rasterizer_boxCommands, 5, _offsetD);
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - ROW_NEW_CHUNK]
+// ============================================================================
+
+#define ROW_NEW_CHUNK(_Chunk_, _X_, _Length_) \
+  FOG_MACRO_BEGIN \
+    _Chunk_ = static_cast<PathRasterizer8::Chunk*>(self->_allocator.alloc(PathRasterizer8::Chunk::getSizeOf(_Length_))); \
+    if (FOG_IS_NULL(_Chunk_)) goto _Bail; \
+    \
+    _Chunk_->x0 = (_X_); \
+    _Chunk_->x1 = (_X_) + _Length_; \
+  FOG_MACRO_END
+
+// ============================================================================
+// [Fog::PathRasterizer8 - ROW_ADD_ONE]
+// ============================================================================
+
+#define ROW_ADD_ONE(_Name_, _Row_, _X_, _Cover_, _Area_) \
+  FOG_MACRO_BEGIN \
+    PathRasterizer8::Chunk* _chunk = _Row_->first; \
+    PathRasterizer8::Chunk* _cNew; \
+    PathRasterizer8::Chunk* _cLast; \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [First]                                                             */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_chunk == NULL) \
+    { \
+      ROW_NEW_CHUNK(_cNew, _X_, 1); \
+      _cNew->prev = _cNew; \
+      _cNew->next = _cNew; \
+      \
+      _Row_->first = _cNew; \
+      goto _Name_##_Add_One_Set; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Prepend]                                                           */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    _cLast = _chunk->prev; \
+    \
+    if (_X_ < _chunk->x0) \
+    { \
+      ROW_NEW_CHUNK(_cNew, _X_, 1); \
+      _cNew->prev = _cLast; \
+      _cNew->next = _chunk; \
+      \
+      _cLast->next = _cNew; \
+      _chunk->prev = _cNew; \
+      \
+      _Row_->first = _cNew; \
+      goto _Name_##_Add_One_Set; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Insert / Append]                                                   */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_X_ < _cLast->x1) \
+    { \
+      if ((_X_ - _chunk->x0) <= (_cLast->x1 - _X_)) \
+      { \
+        for (;;) \
+        { \
+          if (_X_ < _chunk->x0) \
+            break; \
+          \
+          if (_X_ < _chunk->x1) \
+            goto _Name_##_Add_One_Merge; \
+          \
+          FOG_ASSERT(_chunk != _cLast); \
+          _chunk = _chunk->next; \
+        } \
+      } \
+      else \
+      { \
+        _chunk = _cLast; \
+        for (;;) \
+        { \
+          if (_X_ >= _chunk->x0) \
+          { \
+_Name_##_Add_One_Merge: \
+            LOG_CELL("Add_One", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+            _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
+            goto _Name_##_Add_One_End; \
+          } \
+          \
+          _chunk = _chunk->prev; \
+          FOG_ASSERT(_chunk != _cLast); \
+          \
+          if (_X_ >= _chunk->x1) \
+            break; \
+        } \
+        _chunk = _chunk->next; \
+      } \
+      FOG_ASSERT(_X_ <= _chunk->x0); \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Create]                                                            */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    _cLast = _chunk->prev; \
+    \
+    ROW_NEW_CHUNK(_cNew, _X_, 1); \
+    _cNew->prev = _cLast; \
+    _cNew->next = _chunk; \
+    \
+    _cLast->next = _cNew; \
+    _chunk->prev = _cNew; \
+    \
+_Name_##_Add_One_Set: \
+    LOG_CELL("Add_One", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+    _cNew->cells[0].set(_Cover_, _Area_); \
+    \
+_Name_##_Add_One_End: \
+    ; \
+  FOG_MACRO_END \
+
+// ============================================================================
+// [Fog::PathRasterizer8 - ROW_ADD_TWO]
+// ============================================================================
+
+#define ROW_ADD_TWO(_Name_, _Row_, _X_, _Cover_, _Area_, _Advance_) \
+  FOG_MACRO_BEGIN \
+    PathRasterizer8::Chunk* _chunk = _Row_->first; \
+    PathRasterizer8::Chunk* _cNew; \
+    PathRasterizer8::Chunk* _cLast; \
+    \
+    int _count; \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [First]                                                             */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_chunk == NULL) \
+    { \
+      ROW_NEW_CHUNK(_chunk, _X_, 2); \
+      _chunk->prev = _chunk; \
+      _chunk->next = _chunk; \
+      \
+      _Row_->first = _chunk; \
+      \
+      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+      _chunk->cells[0].set(_Cover_, _Area_); \
+      \
+      _Advance_ \
+      \
+      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+      _chunk->cells[1].set(_Cover_, _Area_); \
+      \
+      goto _Name_##_Add_Two_End; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Prepend]                                                           */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    _cLast = _chunk->prev; \
+    \
+    if (_X_ < _chunk->x0) \
+    { \
+      _count = Math::min(_chunk->x0 - _X_, 2); \
+      FOG_ASSERT(_count > 0); \
+      \
+      ROW_NEW_CHUNK(_cNew, _X_, _count); \
+      _cNew->prev = _cLast; \
+      _cNew->next = _chunk; \
+      \
+      _cLast->next = _cNew; \
+      _chunk->prev = _cNew; \
+      \
+      _Row_->first = _cNew; \
+      FOG_ASSERT(_cNew->x1 <= _chunk->x0); \
+      \
+      goto _Name_##_Add_Two_Set; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Insert / Append]                                                   */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_X_ < _cLast->x1) \
+    { \
+      if ((_X_ - _chunk->x0) <= (_cLast->x1 - _X_)) \
+      { \
+        for (;;) \
+        { \
+          if (_X_ < _chunk->x0) \
+            break; \
+          \
+          if (_X_ < _chunk->x1) \
+            goto _Name_##_Add_Two_Merge; \
+          \
+          FOG_ASSERT(_chunk != _cLast); \
+          _chunk = _chunk->next; \
+        } \
+      } \
+      else \
+      { \
+        _chunk = _cLast; \
+        for (;;) \
+        { \
+          if (_X_ >= _chunk->x0) \
+          { \
+_Name_##_Add_Two_Merge: \
+            LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+            _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
+            \
+            _Advance_ \
+            \
+            if (_X_ < _chunk->x1) \
+            { \
+_Name_##_Add_Two_Merge_Second: \
+              LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+              _chunk->cells[_X_ - _chunk->x0].add(_Cover_, _Area_); \
+              goto _Name_##_Add_Two_End; \
+            } \
+            \
+            _cLast = _chunk; \
+            _chunk = _chunk->next; \
+            \
+            if (_X_ >= _chunk->x0 && _X_ < _chunk->x1) \
+              goto _Name_##_Add_Two_Merge_Second; \
+            \
+            ROW_NEW_CHUNK(_cNew, _X_, 1); \
+            _cNew->prev = _cLast; \
+            _cNew->next = _chunk; \
+            \
+            _cLast->next = _cNew; \
+            _chunk->prev = _cNew; \
+            \
+            LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+            _cNew->cells[0].set(_Cover_, _Area_); \
+            goto _Name_##_Add_Two_End; \
+          } \
+          \
+          _chunk = _chunk->prev; \
+          FOG_ASSERT(_chunk != _cLast); \
+          \
+          if (_X_ >= _chunk->x1) \
+            break; \
+        } \
+        _chunk = _chunk->next; \
+      } \
+      FOG_ASSERT(_X_ <= _chunk->x0); \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Create]                                                            */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    _cLast = _chunk->prev; \
+    _count = _chunk->x0 - _X_; \
+    \
+    if ((uint)_count >= 2) _count = 2; \
+    \
+    ROW_NEW_CHUNK(_cNew, _X_, _count); \
+    _cNew->prev = _cLast; \
+    _cNew->next = _chunk; \
+    \
+    _cLast->next = _cNew; \
+    _chunk->prev = _cNew; \
+    \
+_Name_##_Add_Two_Set: \
+    LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+    _cNew->cells[0].set(_Cover_, _Area_); \
+    \
+    _Advance_ \
+    \
+    if (_count > 1) \
+    { \
+      FOG_ASSERT(_cNew->x1 - _cNew->x0 == 2); \
+      \
+      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+      _cNew->cells[1].set(_Cover_, _Area_); \
+    } \
+    else \
+    { \
+      FOG_ASSERT(_cNew->next == _chunk); \
+      FOG_ASSERT(_cNew->x1 <= _chunk->x0); \
+      \
+      LOG_CELL("Add_Two", _X_, (int)(_Row_ - self->_rowsAdjusted), _Cover_, _Area_); \
+      _chunk->cells[0].add(_Cover_, _Area_); \
+    } \
+    \
+_Name_##_Add_Two_End: \
+    ; \
+  FOG_MACRO_END
+
+// ============================================================================
+// [Fog::PathRasterizer8 - ROW_ADD_N]
+// ============================================================================
+
+#define ROW_ADD_N(_Name_, _Row_, _X0_, _X1_, _Cover_, _Area_, _Advance_, _Last_) \
+  FOG_MACRO_BEGIN \
+    PathRasterizer8::Chunk* _cFirst = _Row_->first; \
+    PathRasterizer8::Chunk* _cLast = NULL; \
+    \
+    PathRasterizer8::Chunk* _chunk = _cFirst; \
+    PathRasterizer8::Cell* _cell; \
+    \
+    int _stop; \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [First]                                                             */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_chunk == NULL) \
+    { \
+      int _length = _X1_ - _X0_; \
+      \
+      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
+        _length = A8_MAX_CHUNK_LENGTH; \
+      \
+      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
+      _chunk->prev = _chunk; \
+      _chunk->next = _chunk; \
+      \
+      _cFirst = _chunk; \
+      _cLast = _chunk; \
+      \
+      _Row_->first = _chunk; \
+      \
+      _cell = _chunk->cells; \
+      _stop = _X0_ + _length; \
+      \
+      goto _Name_##_Add_N_Fill; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Prepend]                                                           */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    _cLast = _chunk->prev; \
+    \
+    if (_X0_ < _chunk->x0) \
+    { \
+      int _length = Math::min(_chunk->x0, _X1_) - _X0_; \
+      \
+      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
+        _length = A8_MAX_CHUNK_LENGTH; \
+      \
+      PathRasterizer8::Chunk* _cNext = _chunk; \
+      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
+      \
+      _chunk->prev = _cLast; \
+      _chunk->next = _cNext; \
+      \
+      _cLast->next = _chunk; \
+      _cNext->prev = _chunk; \
+      \
+      _cFirst = _chunk; \
+      _Row_->first = _chunk; \
+      \
+      _cell = _chunk->cells; \
+      _stop = _X0_ + _length; \
+      \
+      goto _Name_##_Add_N_Fill; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Append]                                                            */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if (_X0_ >= _cLast->x1) \
+    { \
+      _chunk = _cLast; \
+      \
+      goto _Name_##_Add_N_Append; \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Insert]                                                            */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+    if ((_X0_ - _chunk->x0) <= (_cLast->x1 - _X0_)) \
+    { \
+      for (;;) \
+      { \
+        if (_X0_ < _chunk->x1) \
+          goto _Name_##_Add_N_Merge; \
+        \
+        _chunk = _chunk->next; \
+        \
+        /* The list is circular, but we know that the [x0, x1] intersects  */ \
+        /* with the bounding-box of the chunk-list. This means that we     */ \
+        /* can't skip into the first chunk in this loop.                   */ \
+        FOG_ASSERT(_chunk != _cFirst); \
+      } \
+    } \
+    else \
+    { \
+      _chunk = _cLast; \
+      \
+      for (;;) \
+      { \
+        if (_X0_ >= _chunk->x0) \
+        { \
+          if (_X0_ >= _chunk->x1) \
+            _chunk = _chunk->next; \
+          \
+          goto _Name_##_Add_N_Merge; \
+        } \
+        \
+        /* Again, we can't iterate forever. */ \
+        FOG_ASSERT(_chunk != _cFirst); \
+        _chunk = _chunk->prev; \
+      } \
+    } \
+    \
+    /* ------------------------------------------------------------------- */ \
+    /* [Advance]                                                           */ \
+    /* ------------------------------------------------------------------- */ \
+    \
+_Name_##_Add_N_Advance: \
+    if (_chunk == _cLast) \
+    { \
+_Name_##_Add_N_Append: \
+      int _length = _X1_ - _X0_; \
+      \
+      if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
+        _length = A8_MAX_CHUNK_LENGTH; \
+      \
+      PathRasterizer8::Chunk* _cPrev = _chunk; \
+      \
+      ROW_NEW_CHUNK(_chunk, _X0_, _length); \
+      _chunk->prev = _cPrev; \
+      _chunk->next = _cFirst; \
+      \
+      _cFirst->prev = _chunk; \
+      _cPrev->next = _chunk; \
+      \
+      _cLast = _chunk; \
+      _cell = _chunk->cells; \
+      \
+      _stop = _X0_ + _length; \
+    } \
+    else \
+    { \
+      _chunk = _chunk->next; \
+      \
+_Name_##_Add_N_Merge: \
+      if (_X0_ < _chunk->x0) \
+      { \
+        int _length = Math::min(_X1_, _chunk->x0) - _X0_; \
+        \
+        if (FOG_UNLIKELY(_length > A8_MAX_CHUNK_LENGTH)) \
+          _length = A8_MAX_CHUNK_LENGTH; \
+        \
+        PathRasterizer8::Chunk* _cPrev = _chunk->prev; \
+        PathRasterizer8::Chunk* _cNext = _chunk; \
+        \
+        ROW_NEW_CHUNK(_chunk, _X0_, _length); \
+        _chunk->prev = _cPrev; \
+        _chunk->next = _cNext; \
+        \
         _cPrev->next = _chunk; \
         _cNext->prev = _chunk; \
         \
@@ -1869,785 +2880,2128 @@ _Name_##_Add_N_Fill: \
     } \
   FOG_MACRO_END
 
-template<typename FixedT>
-static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1)
+template<typename FixedT>
+static bool PathRasterizer8_renderLine(PathRasterizer8* self, FixedT x0, FixedT y0, FixedT x1, FixedT y1)
+{
+  if (self->_isDense)
+    return PathRasterizer8_renderLineDense(self, int(x0), int(y0), int(x1), int(y1));
+
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
+
+  FixedT dx = x1 - x0;
+  FixedT dy = y1 - y0;
+  
+  // The rasterizer does nothing in such case.
+  if (dy == FixedT(0))
+    return true;
+
+  int cover = int(dy);
+  int area;
+
+  if (dx < 0)
+    dx = -dx;
+
+  if (dy < 0)
+    dy = -dy;
+
+  // Instead of subdividing a line to fit into A8_I32_COORD_LIMIT, we use 64-bit
+  // integer version of renderLine() to do the job. This situation can happen
+  // only when drawing to a screen where one or both dimensions is larger than
+  // 16384 pixels.
+  if (sizeof(FixedT) < sizeof(int64_t) && (dx >= FixedT(A8_I32_COORD_LIMIT) || dy >= FixedT(A8_I32_COORD_LIMIT)))
+    return PathRasterizer8_renderLine<int64_t>(self, int64_t(x0), int64_t(y0), int64_t(x1), int64_t(y1));
+
+  int rInc = 1;
+  int coverSign = 1;
+
+  // The new rasterizer algorithm is based on traversing the line from the left
+  // to the right. The start and end coordinates can be swapped, but it's needed
+  // to change the coverSign in such case.
+  if (x0 > x1)
+  {
+    swap(x0, x1);
+    swap(y0, y1);
+
+    coverSign = -1;
+  }
+
+  // If we are going from bottom to top then we need to invert the fractional
+  // parts of y0/y1. In case that the inversion overflow it's needed to subtract
+  // A8_SCALE*2 to normalize the position into the opposite pixel.
+  if (y0 > y1)
+  {
+    static const int norm[2] = { 1, 1 - A8_SCALE * 2};
+
+    y0 ^= A8_MASK;
+    y0 += norm[(int(y0) & A8_MASK) == A8_MASK];
+    y1  = y0 + dy;
+
+    rInc = -1;
+    coverSign = -coverSign;
+  }
+
+  // Extract the raster and fractional coordinates.
+  int ex0 = int(x0 >> A8_SHIFT);
+  int fx0 = int(x0) & A8_MASK;
+
+  int ey0 = int(y0 >> A8_SHIFT);
+  int fy0 = int(y0) & A8_MASK;
+
+  int ex1 = int(x1 >> A8_SHIFT);
+  int fy1 = int(y1) & A8_MASK;
+
+  // How many Y iterations to do.
+  int i = 1;
+  // How many Y iterations to do next.
+  int j = int(y1 >> A8_SHIFT) - ey0;
+
+  // NOTE: Variable 'i' is just loop counter. Because we need to make sure to
+  // handle the start and end points of the line (start point is always based
+  // on the y0 coordinate and end point is always based on the y1 coordinate),
+  // we need two variables:
+  //
+  //  - 'i' - Used for current loop.
+  //  - 'j' - Used for next loop.
+
+  // Prepare the current and end row pointers.
+  PathRasterizer8::Row* rPtr = self->_rowsAdjusted;
+  PathRasterizer8::Row* rEnd = self->_rowsAdjusted;
+
+  // --------------------------------------------------------------------------
+  // [Bounding-Box]
+  // --------------------------------------------------------------------------
+
+  {
+    int by0 = ey0;
+    int by1 = ey0 + (j - (fy1 == 0)) * rInc;
+
+    if (by0 > by1)
+      swap(by0, by1);
+    
+    if (FOG_UNLIKELY(self->_boundingBox.y0 == -1))
+    {
+      // Initialize the bounding-box.
+      self->_boundingBox.x0 = ex0;
+      self->_boundingBox.y0 = by0;
+      self->_boundingBox.x1 = ex1;
+      self->_boundingBox.y1 = by1;
+
+      // Initialize the rows.
+      for (;;)
+      {
+        rPtr[by0].first = NULL;
+        if (by0 == by1)
+          break;
+        by0++;
+      }
+    }
+    else
+    {
+      int bEnd;
+
+      // Merge the bounding-box with the line.
+      if (ex0 < self->_boundingBox.x0) self->_boundingBox.x0 = ex0;
+      if (ex1 > self->_boundingBox.x1) self->_boundingBox.x1 = ex1;
+
+      // Clear the rows (clear).
+      bEnd = self->_boundingBox.y0;
+      if (by0 < bEnd)
+      {
+        self->_boundingBox.y0 = by0;
+        do {
+          rPtr[by0++].first = NULL;
+        } while (by0 != bEnd);
+      }
+
+      bEnd = self->_boundingBox.y1;
+      if (by1 > bEnd)
+      {
+        self->_boundingBox.y1 = by1;
+        do {
+          rPtr[++bEnd].first = NULL;
+        } while (by1 != bEnd);
+      }
+    }
+  }
+
+  rPtr += ey0;
+  rEnd += ey0 + (j + (fy1 != 0)) * rInc;
+
+  // --------------------------------------------------------------------------
+  // [Point]
+  // --------------------------------------------------------------------------
+
+  // If the line is so small that it covers only one cell in one scanline, we
+  // can use this fast-path to return as early as possible from renderLine().
+  //
+  // This can happen when approximating very small circular arcs (for example
+  // small radius when painting rounded rectangle) or when painting an object
+  // which is heavily down-scaled.
+  if ((j | ((fx0 + int(dx)) > 256)) == 0)
+  {
+    fx0 = fx0 * 2 + int(dx);
+    goto _One;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Vertical Only]
+  // --------------------------------------------------------------------------
+
+  if (dx == 0)
+  {
+    // We have to calculate start and end cells, and then - the common values
+    // of the area and coverage for all cells of the line. We know exactly 
+    // there's only one cell per scanline, thus, we don't have to use
+    // complicated scanline rasterization.
+    if (j > 0)
+      cover = (A8_SCALE - fy0) * coverSign;
+
+    fx0 *= 2;
+    fy0 = A8_SCALE;
+
+    // Instead of making two versions of this function (one for positive covers
+    // and one for negative covers) we just negate the important variables if
+    // needed.
+    if (coverSign < 0)
+    {
+      fy0 = -fy0;
+      fy1 = -fy1;
+    }
+
+    for (;;)
+    {
+_One:
+      area = fx0 * cover;
+      do {
+        ROW_ADD_ONE(_Vert_Only, rPtr, ex0, cover, area);
+        rPtr += rInc;
+      } while (--i);
+
+      if (rPtr == rEnd)
+        break;
+
+      i = j;
+      j = 1;
+      cover = fy1;
+
+      if (i > 1)
+      {
+        cover = fy0;
+        i--;
+      }
+    }
+    return true;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Vertical / Horizontal Orientation]
+  // --------------------------------------------------------------------------
+
+  else
+  {
+    // Only one or two cells are generated per scanline.
+    FixedT xErr = -dy / 2, xBase, xLift, xRem, xDlt = dx;
+    FixedT yErr = -dx / 2, yBase, yLift, yRem, yDlt = dy;
+
+    xBase = dx * A8_SCALE;
+    xLift = xBase / dy;
+    xRem  = xBase % dy;
+
+    yBase = dy * A8_SCALE;
+    yLift = yBase / dx;
+    yRem  = yBase % dx;
+
+    if (j != 0)
+    {
+      FixedT p = FixedT(A8_SCALE - fy0) * dx;
+
+      xDlt  = p / dy;
+      xErr += p % dy;
+
+      fy1 = A8_SCALE;
+    }
+
+    if (ex0 != ex1)
+    {
+      FixedT p = FixedT(A8_SCALE - fx0) * dy;
+
+      yDlt = p / dx;
+      yErr += p % dx;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Vertical Orientation]
+    // ------------------------------------------------------------------------
+
+    if (dy >= dx)
+    {
+      int yAcc = int(y0) + int(yDlt);
+
+      if (coverSign > 0)
+      {
+        goto _Vert_P_Skip;
+
+        for (;;)
+        {
+          do {
+            xDlt = xLift;
+            xErr += xRem;
+            if (xErr >= 0) { xErr -= dy; xDlt++; }
+
+_Vert_P_Skip:
+            area = fx0;
+            fx0 += int(xDlt);
+
+            if (fx0 <= 256)
+            {
+              cover = fy1 - fy0; // Positive.
+              area += fx0;
+
+_Vert_P_Single:
+              area *= cover;
+              ROW_ADD_ONE(_Vert_P, rPtr, ex0, cover, area);
+
+              if (fx0 == 256)
+              {
+                ex0++;
+                fx0 = 0;
+                goto _Vert_P_Advance;
+              }
+            }
+            else
+            {
+              yAcc &= 0xFF;
+              FOG_ASSERT(yAcc >= fy0 && yAcc <= fy1);
+              
+              cover = yAcc - fy0; // Positive.
+              fx0  &= A8_MASK;
+
+              // Improve the count of generated cells in case that the resulting
+              // cover is zero using the 'ROW_ADD_ONE'. The 'goto' ensures that
+              // the ROW_ADD_ONE() macro will be expanded only once.
+              if (cover == 0)
+              {
+                cover = fy1 - yAcc; // Positive.
+                area  = fx0;
+                ex0++;
+                goto _Vert_P_Single;
+              }
+              else
+              {
+                area = (area + A8_SCALE) * cover;
+                ROW_ADD_TWO(_Vert_P, rPtr, ex0, cover, area,
+                {
+                  cover = fy1 - yAcc; // Positive.
+                  area  = fx0 * cover;
+                  ex0++;
+                });
+              }
+
+_Vert_P_Advance:
+              yAcc += int(yLift);
+              yErr += yRem;
+              if (yErr >= 0) { yErr -= dx; yAcc++; }
+            }
+
+            rPtr += rInc;
+          } while (--i);
+
+          if (rPtr == rEnd)
+            break;
+
+          i = j;
+          j = 1;
+
+          if (i > 1)
+          {
+            fy0 = 0;
+            fy1 = A8_SCALE;
+            i--;
+          }
+          else
+          {
+            fy0 = 0;
+            fy1 = int(y1) & A8_MASK;
+
+            xDlt = x1 - (ex0 << 8) - fx0;
+            goto _Vert_P_Skip;
+          }
+        }
+      }
+      else
+      {
+        goto _Vert_N_Skip;
+
+        for (;;)
+        {
+          do {
+            xDlt = xLift;
+            xErr += xRem;
+            if (xErr >= 0) { xErr -= dy; xDlt++; }
+
+_Vert_N_Skip:
+            area = fx0;
+            fx0 += int(xDlt);
+
+            if (fx0 <= 256)
+            {
+              cover = fy0 - fy1; // Negative.
+              area += fx0;
+
+_Vert_N_Single:
+              area *= cover;
+              ROW_ADD_ONE(_Vert_N, rPtr, ex0, cover, area);
+
+              if (fx0 == 256)
+              {
+                ex0++;
+                fx0 = 0;
+                goto _Vert_N_Advance;
+              }
+            }
+            else
+            {
+              yAcc &= 0xFF;
+              FOG_ASSERT(yAcc >= fy0 && yAcc <= fy1);
+
+              cover = fy0 - yAcc; // Negative.
+              fx0  &= A8_MASK;
+
+              // Improve the count of generated cells in case that the resulting
+              // cover is zero using the 'ROW_ADD_ONE'. The 'goto' ensures that
+              // the ROW_ADD_ONE() macro will be expanded only once.
+              if (cover == 0)
+              {
+                cover = yAcc - fy1; // Negative.
+                area  = fx0;
+                ex0++;
+                goto _Vert_N_Single;
+              }
+              else
+              {
+                area = (area + A8_SCALE) * cover;
+                ROW_ADD_TWO(_Vert_N, rPtr, ex0, cover, area,
+                {
+                  cover = yAcc - fy1; // Negative.
+                  area  = fx0 * cover;
+                  ex0++;
+                });
+              }
+
+_Vert_N_Advance:
+              yAcc += int(yLift);
+              yErr += yRem;
+              if (yErr >= 0) { yErr -= dx; yAcc++; }
+            }
+
+            rPtr += rInc;
+          } while (--i);
+
+          if (rPtr == rEnd)
+            break;
+
+          i = j;
+          j = 1;
+
+          if (i > 1)
+          {
+            fy0 = 0;
+            fy1 = A8_SCALE;
+            i--;
+          }
+          else
+          {
+            fy0 = 0;
+            fy1 = int(y1) & A8_MASK;
+            xDlt = x1 - (ex0 << 8) - fx0;
+            goto _Vert_N_Skip;
+          }
+        }
+      }
+
+      return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Horizontal Orientation]
+    // ------------------------------------------------------------------------
+
+    else
+    {
+      // Cell operator, directly used/modified by ROW_ADD_N() macro.
+      int _cellOp = coverSign > 0 ? CELL_OP_POSITIVE : CELL_OP_NEGATIVE;
+
+      int fx1;
+      int coverAcc = fy0;
+
+      cover = int(yDlt);
+      coverAcc += cover;
+
+      if (j != 0)
+        fy1 = A8_SCALE;
+
+      if (fx0 + int(xDlt) > 256)
+        goto _Horz_Inside;
+
+      x0 += xDlt;
+
+      cover = (fy1 - fy0) * coverSign;
+      area = (fx0 * 2 + int(xDlt)) * cover;
+
+_Horz_Single:
+      ROW_ADD_ONE(_Horz, rPtr, ex0, cover, area);
+      
+      rPtr += rInc;
+      if (rPtr == rEnd)
+        return true;
+      
+      if (fx0 + int(xDlt) == 256)
+      {
+        coverAcc += int(yLift);
+        yErr += yRem;
+        if (yErr >= 0) { yErr -= dx; coverAcc++; }
+      }
+
+      if (--i == 0)
+        goto _Horz_After;
+
+      for (;;)
+      {
+        do {
+          xDlt = xLift;
+          xErr += xRem;
+          if (xErr >= 0) { xErr -= dy; xDlt++; }
+
+          ex0 = int(x0 >> A8_SHIFT);
+          fx0 = int(x0) & A8_MASK;
+
+_Horz_Skip:
+          coverAcc -= 256;
+          cover = coverAcc;
+          FOG_ASSERT(cover >= 0 && cover <= 256);
+
+_Horz_Inside:
+          x0 += xDlt;
+
+          ex1 = int(x0 >> A8_SHIFT);
+          fx1 = int(x0) & A8_MASK;
+
+          FOG_ASSERT(ex0 != ex1);
+
+          if (fx1 == 0)
+            fx1 = A8_SCALE;
+          else
+            ex1++;
+
+          // Calculate the first cover/area pair. All cells inside the line
+          // will be calculated inside ROW_ADD_N() loop.
+          area = (fx0 + A8_SCALE) * cover;
+
+          ROW_ADD_N(_Horz, rPtr, ex0, ex1, cover, area,
+          { /* Advance: */
+            cover = int(yLift);
+            yErr += yRem;
+            if (yErr >= 0) { yErr -= dx; cover++; }
+
+            coverAcc += cover;
+            area = A8_SCALE * cover;
+          },
+          { /* Last: */
+            cover += fy1 - coverAcc;
+            area = fx1 * cover;
+
+            if (fx1 == A8_SCALE)
+            {
+              coverAcc += int(yLift);
+              yErr += yRem;
+              if (yErr >= 0) { yErr -= dx; coverAcc++; }
+            }
+          });
+
+          rPtr += rInc;
+        } while (--i);
+
+        if (rPtr == rEnd)
+          break;
+
+_Horz_After:
+        i = j;
+        j = 1;
+
+        if (i > 1)
+        {
+          fy1 = A8_SCALE;
+          i--;
+        }
+        else
+        {
+          fy1 = int(y1) & A8_MASK;
+          xDlt = x1 - x0;
+
+          ex0 = int(x0 >> A8_SHIFT);
+          fx0 = int(x0) & A8_MASK;
+
+          if (fx0 + int(xDlt) <= 256)
+          {
+            cover = fy1 * coverSign;
+            area = (fx0 * 2 + int(xDlt)) * cover;
+            goto _Horz_Single;
+          }
+          else
+          {
+            goto _Horz_Skip;
+          }
+        }
+      }
+
+      return true;
+    }
+  }
+
+_Bail:
+  return false;
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Helpers]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static FOG_INLINE uint32_t PathRasterizer8_calculateAlpha(const PathRasterizer8* self, int cover)
+{
+  if (cover < 0) cover = -cover;
+
+  if (_RULE == FILL_RULE_NON_ZERO)
+  {
+    if (cover > A8_SCALE)
+      cover = A8_SCALE;
+  }
+  else
+  {
+    cover &= A8_MASK_2;
+    if (cover > A8_SCALE)
+      cover = A8_SCALE_2 - cover;
+  }
+
+  if (_USE_ALPHA)
+    cover = (cover * self->_opacity) >> 8;
+
+  return cover;
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Clip-Box]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
+  FOG_ASSERT(self->_isFinalized);
+
+  int y0 = self->_boundingBox.y0;
+  int y1 = self->_boundingBox.y1;
+  int xEnd = self->_sceneBox.x1;
+
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
+
+  if (FOG_IS_ERROR(scanline->prepare(self->_boundingBox.getWidth() * 2)))
+    return;
+
+  PathRasterizer8::Row* rows = self->_rowsAdjusted + y0;
+  filler->prepare(y0);
+  
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
+
+  for (;;)
+  {
+    // ------------------------------------------------------------------------
+    // [Merge / Skip]
+    // ------------------------------------------------------------------------
+
+    PathRasterizer8::Chunk* first = rows->first;
+    rows++;
+
+    if (FOG_IS_NULL(first))
+    {
+      int mark = y0;
+      do {
+        if (++y0 >= y1) return;
+
+        first = rows->first;
+        rows++;
+      } while (first == NULL);
+
+      filler->skip(y0 - mark);
+    }
+
+    VERIFY_CHUNKS_8(first);
+
+    // ------------------------------------------------------------------------
+    // [Fetch]
+    // ------------------------------------------------------------------------
+
+    RasterSpan8* span = scanline->begin();
+    uint8_t* mask = scanline->getMask();
+
+    PathRasterizer8::Chunk* chunk = first;
+    PathRasterizer8::Cell* cell = chunk->cells;
+
+    uint i = static_cast<uint>(chunk->getLength());
+
+    int x;
+    int xNext = chunk->x0;
+    int cover = 0;
+    uint32_t alpha;
+
+    for (;;)
+    {
+      if (xNext == xEnd)
+        break;
+
+      x = xNext;
+
+      // Link to the existing span if possible. In such case we don't need to
+      // worry about span allocation, because we have preallocated two spans,
+      // one for v-mask and one for possible c-mask.
+      if (span->getX1() != x || span->getType() != RASTER_SPAN_AX_EXTRA)
+      {
+        NEW_SPANS(span, 2, return);
+        span->setX0AndType(x, RASTER_SPAN_AX_EXTRA);
+        span->setVariantMask(mask);
+      }
+
+_Continue:
+      x += i;
+      if (x > xEnd && --i == 0)
+      {
+        FOG_ASSERT(x - 1 == xEnd);
+        break;
+      }
+
+      // Terminate span for now.
+      span->setX1(x);
+
+      do {
+        cover += cell->cover;
+        alpha  = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover - (cell->area >> A8_SHIFT_2));
+
+        Acc::p32Store2a(mask, alpha);
+        mask += 2;
+
+        cell++;
+      } while (--i);
+
+      chunk = chunk->next;
+      if (chunk == first)
+        break;
+
+      cell = chunk->cells;
+      xNext = chunk->x0;
+      i = (uint)chunk->getLength();
+
+      if (x == xNext)
+        goto _Continue;
+
+      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
+      if (alpha != 0)
+      {
+        uint len = static_cast<uint>(xNext - x);
+
+        if (len <= RASTER_SPAN_C_THRESHOLD)
+        {
+          // If CPU supports unaligned read/write then we can optimize filling
+          // of small spans by extending the alpha to 32-bit or 64-bit integer
+          // and storing it directly to the current array. Span allocator always
+          // reserves some bytes for these optimizations.
+          //
+          // This optimization increased performance of FogBench for about 1-2%,
+          // depending on rasterized shape and size. It's very cheap, and gives
+          // good results.
+          FOG_ASSERT(RASTER_SPAN_C_THRESHOLD <= 4);
+
+#if FOG_ARCH_BITS >= 64 && defined(FOG_ARCH_UNALIGNED_ACCESS_64)
+          Acc::p64Store8u(mask,
+            (uint64_t)alpha * FOG_UINT64_C(0x0001000100010001));
+          mask += len * 2;
+#elif FOG_ARCH_BITS >= 32 && defined(FOG_ARCH_UNALIGNED_ACCESS_32)
+          alpha *= 0x00010001;
+          Acc::p32Store4u(mask + 0, alpha);
+          Acc::p32Store4u(mask + 4, alpha);
+          mask += len * 2;
+#else
+          // Unoptimized case.
+          do {
+            Acc::p32Store2a(mask, alpha);
+            mask += 2;
+          } while (--len);
+#endif
+          span->setX1(xNext);
+        }
+        else
+        {
+          span->setNext(span + 1);
+          span++;
+          
+          span->setPositionAndType(x, xNext, RASTER_SPAN_C);
+          span->setConstMask(alpha);
+        }
+      }
+    }
+
+    span = scanline->end(span);
+
+    // ------------------------------------------------------------------------
+    // [Fill / Skip]
+    // ------------------------------------------------------------------------
+
+    if (FOG_IS_NULL(span))
+    {
+      filler->skip(1);
+    }
+    else
+    {
+#if defined(FOG_DEBUG_RASTERIZER)
+      Rasterizer_dumpSpans(y0, scanline->getSpans());
+#endif // FOG_DEBUG_RASTERIZER
+      filler->process(span);
+    }
+
+    if (++y0 >= y1)
+      return;
+  }
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Clip-Region]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_st_clip_region(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
+  FOG_ASSERT(self->_isFinalized);
+
+  int xMin = self->_boundingBox.x0;
+  int xEnd = self->_boundingBox.x1;
+
+  int yMin = self->_boundingBox.y0;
+  int yEnd = self->_boundingBox.y1;
+
+  int y0 = yMin;
+  int y1;
+  int yPos = y0;
+
+  const BoxI* cPtr = self->_clip.region.data;
+  const BoxI* cEnd = cPtr + self->_clip.region.length;
+
+  const BoxI* cBandStart;
+  const BoxI* cBandEnd;
+
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
+
+  if (FOG_IS_ERROR(scanline->prepare(self->_boundingBox.getWidth() * 2)))
+    return;
+
+  PathRasterizer8::Row* rows = self->_rowsAdjusted;
+  filler->prepare(yPos);
+
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
+  
+_NextBand:
+  if (cPtr == cEnd)
+    return;
+
+  for (;;)
+  {
+    PathRasterizer8::Chunk* first;
+
+    // ------------------------------------------------------------------------
+    // [Advance Clip-Box]
+    // ------------------------------------------------------------------------
+
+    // Skip boxes which do not intersect in vertical direction.
+    while (cPtr->y1 <= y0)
+    {
+      if (++cPtr == cEnd)
+        return;
+    }
+
+    // Skip boxes which do not intersect in horizontal direction.
+    while (cPtr->x1 <= xMin)
+    {
+      if (++cPtr == cEnd)
+        return;
+    }
+
+    if (cPtr->x0 >= xEnd)
+    {
+      do {
+        if (++cPtr == cEnd)
+          return;
+      } while (cPtr->x0 >= xEnd);
+      continue;
+    }
+
+    y0 = cPtr->y0;
+    if (y0 >= yEnd)
+      return;
+
+    // Save start of the current band and find the end. We limit the end to the
+    // last band which can be processed. If some clip rectangle is completely
+    // outside of the shape bounding box, then the band won't be included in
+    // cBandStart...cBandEnd list.
+    //
+    // NOTE: Like all other pointers, cBandEnd contains the first band which is
+    // invalid.
+    cBandStart = cPtr;
+    cBandEnd = cPtr;
+
+    while (++cBandEnd != cEnd && cBandEnd->y0 == y0 && cBandEnd->x0 < xEnd)
+      continue;
+
+    if (y0 < yMin)
+      y0 = yMin;
+
+    y1 = cPtr->y1;
+    if (y1 > yEnd)
+      y1 = yEnd;
+
+    FOG_ASSERT(y0 != y1);
+    goto _LoopRow;
+
+    // ------------------------------------------------------------------------
+    // [Merge / Skip]
+    // ------------------------------------------------------------------------
+
+_NextRow:
+    if (++y0 == y1)
+    {
+      cPtr = cBandEnd;
+      goto _NextBand;
+    }
+    cPtr = cBandStart;
+
+_LoopRow:
+    for (;;)
+    {
+      first = rows[y0].first;
+      if (first != NULL)
+        break;
+
+      if (++y0 == y1)
+      {
+        cPtr = cBandEnd;
+        goto _NextBand;
+      }
+    }
+
+    VERIFY_CHUNKS_8(first);
+
+    // ------------------------------------------------------------------------
+    // [Fetch]
+    // ------------------------------------------------------------------------
+
+    RasterSpan8* span = scanline->begin();
+    uint8_t* mask = scanline->getMask();
+
+    PathRasterizer8::Chunk* chunk = first;
+    PathRasterizer8::Cell* cell = chunk->cells;
+
+    int x0 = chunk->x0;
+    int x1 = chunk->x1;
+  
+    int cover = 0;
+    uint32_t alpha = 0;
+
+    int xc;
+    int xLocalEnd;
+
+    // Skip clip rectangles which do not intersect with the current chunk.
+    while (x0 >= cPtr->x1)
+    {
+_AdvanceClip:
+      if (++cPtr == cBandEnd)
+        goto _Fill;
+    }
+
+    // Skip cells which do not intersect with the current clip rectangle.
+    xc = cPtr->x0;
+    if (x0 < xc)
+    {
+_SkipCells:
+      xLocalEnd = Math::min<int>(xc, x1);
+      FOG_ASSERT(xLocalEnd != 0);
+
+      do {
+        cover += cell->cover;
+        cell++;
+      } while (++x0 != xLocalEnd);
+
+      if (x0 == x1)
+      {
+        chunk = chunk->next;
+        if (chunk == first)
+          goto _Fill;
+
+        cell = chunk->cells;
+        x0 = chunk->x0;
+        x1 = chunk->x1;
+
+        if (x0 < xc)
+          goto _SkipCells;
+      }
+      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
+    }
+    FOG_ASSERT(x0 >= xc);
+
+    if (alpha == 0)
+    {
+      // Skip clip rectangles which do not intersect with the current chunk.
+      if (x0 >= cPtr->x1)
+        goto _AdvanceClip;
+
+      if (xc < x0)
+        xc = x0;
+    }
+    else
+    {
+      // Skip part of rectangle which do not intersect with the current chunk,
+      // filling it with const mask.
+      if (xc < x0)
+      {
+        for (;;)
+        {
+_ConstSpan:
+          NEW_SPAN(span, return);
+          span->setX0AndType(xc, RASTER_SPAN_C);
+
+          xc = Math::min<int>(x0, cPtr->x1);
+          FOG_ASSERT(span->getX0() < xc);
+
+          span->setX1(xc);
+          span->setConstMask(alpha);
+
+          if (xc == cPtr->x1)
+          {
+            if (++cPtr == cBandEnd)
+              goto _Fill;
+            xc = cPtr->x0;
+            if (xc < x0)
+              continue;
+          }
+          break;
+        }
+      }
+    }
+
+    if (x0 < xc)
+      goto _SkipCells;
+
+    FOG_ASSERT(x0 == xc);
+_NewSpan:
+    x0 = Math::min<int>(x1, cPtr->x1);
+
+_NewSpan1:
+    NEW_SPAN(span, return);
+    span->setX0AndType(xc, RASTER_SPAN_AX_EXTRA); 
+    span->setVariantMask(mask);
+
+_ContinueSpan:
+    do {
+      cover += cell->cover;
+      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover - (cell->area >> A8_SHIFT_2));
+      
+      Acc::p16Store2a(mask, static_cast<uint16_t>(alpha));
+      mask += 2;
+
+      cell++;
+    } while (++xc != x0);
+    span->setX1(xc);
+
+    if (xc == x1)
+    {
+      chunk = chunk->next;
+      if (chunk == first)
+        goto _Fill;
+
+      cell = chunk->cells;
+      x0 = chunk->x0;
+      x1 = chunk->x1;
+
+      if (xc == cPtr->x1)
+      {
+        // If alpha is zero, we can jump into _AdvanceClip loop, which efficiently
+        // discards all clipped rectangles. Otherwise we need to create const-mask
+        // spans, because of non-zero alpha.
+        alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
+        if (alpha == 0)
+          goto _AdvanceClip;
+
+_AdvanceClipAlphaNonZero:
+        if (++cPtr == cBandEnd)
+          goto _Fill;
+
+        xc = cPtr->x0;
+        if (xc < x0)
+          goto _ConstSpan;
+
+        if (xc > x0)
+          goto _SkipCells;
+      }
+
+      if (xc == x0)
+      {
+        x0 = Math::min<int>(x1, cPtr->x1);
+        if (span->getX1() != x0 || span->getType() != RASTER_SPAN_AX_EXTRA)
+          goto _NewSpan1;
+        else
+          goto _ContinueSpan;
+      }
+      else
+      {
+        uint len = Math::min<int>(x0, cPtr->x1) - xc;
+        alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
+
+        if (alpha == 0)
+        {
+          xc += len;
+          if (xc == cPtr->x1)
+            goto _AdvanceClip;
+          else
+            goto _NewSpan;
+        }
+  
+        if (len <= RASTER_SPAN_C_THRESHOLD)
+        {
+          // The same optimization as in render_st_clip_box(), see comment there.
+          FOG_ASSERT(RASTER_SPAN_C_THRESHOLD <= 4);
+
+          xc += len;
+          span->setX1(xc);
+
+#if FOG_ARCH_BITS >= 64 && defined(FOG_ARCH_UNALIGNED_ACCESS_64)
+          Acc::p64Store8u(mask,
+            (uint64_t)alpha * FOG_UINT64_C(0x0001000100010001));
+          mask += len * 2;
+#elif FOG_ARCH_BITS >= 32 && defined(FOG_ARCH_UNALIGNED_ACCESS_32)
+          alpha *= 0x00010001;
+          Acc::p32Store4u(mask + 0, alpha);
+          Acc::p32Store4u(mask + 4, alpha);
+          mask += len * 2;
+#else
+          // Unoptimized case.
+          do {
+            Acc::p32Store2a(mask, alpha);
+            mask += 2;
+          } while (--len);
+#endif
+
+          if (xc == cPtr->x1)
+            goto _AdvanceClipAlphaNonZero;
+
+          FOG_ASSERT(xc < cPtr->x1);
+          FOG_ASSERT(xc == x0);
+
+          x0 = Math::min<int>(x1, cPtr->x1);
+          goto _ContinueSpan;
+        }
+        else
+        {
+          NEW_SPAN(span, return);
+          span->setX0AndType(xc, RASTER_SPAN_C);
+          xc += len;
+          span->setX1(xc);
+          span->setConstMask(alpha);
+
+          if (xc != cPtr->x1)
+          {
+            FOG_ASSERT(xc < cPtr->x1);
+            FOG_ASSERT(xc == x0);
+            goto _NewSpan;
+          }
+
+          goto _AdvanceClipAlphaNonZero;
+        }
+      }
+    }
+    else
+    {
+      if (alpha == 0)
+        goto _AdvanceClip;
+      else
+        goto _AdvanceClipAlphaNonZero;
+    }
+
+    // ------------------------------------------------------------------------
+    // [Fill / Skip]
+    // ------------------------------------------------------------------------
+
+_Fill:
+    span = scanline->end(span);
+    if (span != NULL)
+    {
+#if defined(FOG_DEBUG_RASTERIZER)
+      Rasterizer_dumpSpans(y0, scanline->getSpans());
+#endif // FOG_DEBUG_RASTERIZER
+
+      if (yPos != y0)
+        filler->skip(y0 - yPos);
+      yPos = y0 + 1;
+
+      filler->process(span);
+    }
+    goto _NextRow;
+  }
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Clip-Mask]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_st_clip_mask(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
+
+  PathRasterizer8_render_st_clip_box<_RULE, _USE_ALPHA>(_self, &proxy, scanline);
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Dense - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Convert one row of the dense buffer into the 16-bit coverage by
+//! using prefix-sum of covers.
+template<int _RULE, int _USE_ALPHA>
+static FOG_INLINE void PathRasterizer8_accumulateDense(const PathRasterizer8* self,
+  uint16_t* dst, const int* cover, const int* area, int w)
+{
+  int acc = 0;
+
+#if defined(FOG_HARDCODE_SSE2)
+  if (w >= 8)
+  {
+    __m128i xAcc = _mm_setzero_si128();
+    __m128i xLimit = _mm_set1_epi16(_RULE == FILL_RULE_NON_ZERO ? A8_SCALE : A8_SCALE_2);
+    __m128i xMask = _mm_set1_epi32(A8_MASK_2);
+    __m128i xOpacity = _mm_set1_epi16((short)self->_opacity);
+
+    do {
+      __m128i c0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cover + 0));
+      __m128i c1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cover + 4));
+      __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(area + 0));
+      __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(area + 4));
+
+      // Inclusive prefix-sum of covers (4 lanes) + carry from previous lanes.
+      c0 = _mm_add_epi32(c0, _mm_slli_si128(c0, 4));
+      c1 = _mm_add_epi32(c1, _mm_slli_si128(c1, 4));
+      c0 = _mm_add_epi32(c0, _mm_slli_si128(c0, 8));
+      c1 = _mm_add_epi32(c1, _mm_slli_si128(c1, 8));
+
+      c0 = _mm_add_epi32(c0, xAcc);
+      xAcc = _mm_shuffle_epi32(c0, _MM_SHUFFLE(3, 3, 3, 3));
+      c1 = _mm_add_epi32(c1, xAcc);
+      xAcc = _mm_shuffle_epi32(c1, _MM_SHUFFLE(3, 3, 3, 3));
+
+      // Cover - (Area >> 9).
+      c0 = _mm_sub_epi32(c0, _mm_srai_epi32(a0, A8_SHIFT_2));
+      c1 = _mm_sub_epi32(c1, _mm_srai_epi32(a1, A8_SHIFT_2));
+
+      // Absolute value.
+      a0 = _mm_srai_epi32(c0, 31);
+      a1 = _mm_srai_epi32(c1, 31);
+      c0 = _mm_sub_epi32(_mm_xor_si128(c0, a0), a0);
+      c1 = _mm_sub_epi32(_mm_xor_si128(c1, a1), a1);
+
+      if (_RULE == FILL_RULE_NON_ZERO)
+      {
+        // Min(Cover, 256), packing saturates values which don't fit to 16-bit.
+        c0 = _mm_packs_epi32(c0, c1);
+        c0 = _mm_min_epi16(c0, xLimit);
+      }
+      else
+      {
+        // Cover & 511, then Min(Cover, 512 - Cover).
+        c0 = _mm_and_si128(c0, xMask);
+        c1 = _mm_and_si128(c1, xMask);
+        c0 = _mm_packs_epi32(c0, c1);
+        c0 = _mm_min_epi16(c0, _mm_sub_epi16(xLimit, c0));
+      }
+
+      if (_USE_ALPHA)
+      {
+        c0 = _mm_mullo_epi16(c0, xOpacity);
+        c0 = _mm_srli_epi16(c0, 8);
+      }
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), c0);
+
+      dst += 8;
+      cover += 8;
+      area += 8;
+      w -= 8;
+    } while (w >= 8);
+
+    acc = _mm_cvtsi128_si32(xAcc);
+  }
+#endif // FOG_HARDCODE_SSE2
+
+  while (w > 0)
+  {
+    acc += cover[0];
+    dst[0] = (uint16_t)PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, acc - (area[0] >> A8_SHIFT_2));
+
+    dst++;
+    cover++;
+    area++;
+    w--;
+  }
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Dense - Clip-Box]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_dense_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
+  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
+
+  FOG_ASSERT(self->_isFinalized);
+  FOG_ASSERT(self->_isDense);
+
+  int x0 = self->_boundingBox.x0;
+  int y0 = self->_boundingBox.y0;
+  int y1 = self->_boundingBox.y1;
+  int w = self->_boundingBox.getWidth();
+
   // --------------------------------------------------------------------------
   // [Prepare]
   // --------------------------------------------------------------------------
 
-  FixedT dx = x1 - x0;
-  FixedT dy = y1 - y0;
-  
-  // The rasterizer does nothing in such case.
-  if (dy == FixedT(0))
-    return true;
-
-  int cover = int(dy);
-  int area;
+  if (FOG_IS_ERROR(scanline->prepare(w * 2)))
+    return;
 
-  if (dx < 0)
-    dx = -dx;
+  size_t stride = (size_t)self->_denseStride;
+  size_t offset = (size_t)(y0 - self->_denseBox.y0) * stride + (size_t)(x0 - self->_denseBox.x0);
 
-  if (dy < 0)
-    dy = -dy;
+  const int* cover = self->_denseCover + offset;
+  const int* area = self->_denseArea + offset;
 
-  // Instead of subdividing a line to fit into A8_I32_COORD_LIMIT, we use 64-bit
-  // integer version of renderLine() to do the job. This situation can happen
-  // only when drawing to a screen where one or both dimensions is larger than
-  // 16384 pixels.
-  if (sizeof(FixedT) < sizeof(int64_t) && (dx >= FixedT(A8_I32_COORD_LIMIT) || dy >= FixedT(A8_I32_COORD_LIMIT)))
-    return PathRasterizer8_renderLine<int64_t>(self, int64_t(x0), int64_t(y0), int64_t(x1), int64_t(y1));
+  filler->prepare(y0);
 
-  int rInc = 1;
-  int coverSign = 1;
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
 
-  // The new rasterizer algorithm is based on traversing the line from the left
-  // to the right. The start and end coordinates can be swapped, but it's needed
-  // to change the coverSign in such case.
-  if (x0 > x1)
+  for (;;)
   {
-    swap(x0, x1);
-    swap(y0, y1);
+    uint16_t* mask = reinterpret_cast<uint16_t*>(scanline->getMask());
+    PathRasterizer8_accumulateDense<_RULE, _USE_ALPHA>(self, mask, cover, area, w);
+
+    // ------------------------------------------------------------------------
+    // [Spans]
+    // ------------------------------------------------------------------------
+
+    RasterSpan8* span = scanline->begin();
+
+    int i = 0;
+    bool isVariant = false;
+
+    while (i < w)
+    {
+      uint32_t alpha = mask[i];
+      int j = i + 1;
+
+      while (j < w && mask[j] == alpha)
+        j++;
+
+      // Long runs of the same coverage are converted to const-mask spans, the
+      // transparent runs are skipped. Everything else is the variant-mask
+      // which points directly to the accumulated row.
+      if (j - i > RASTER_SPAN_C_THRESHOLD || (alpha == 0 && (!isVariant || j == w)))
+      {
+        if (isVariant)
+        {
+          span->setX1(x0 + i);
+          isVariant = false;
+        }
+
+        if (alpha != 0)
+        {
+          NEW_SPAN(span, return);
+          span->setPositionAndType(x0 + i, x0 + j, RASTER_SPAN_C);
+          span->setConstMask(alpha);
+        }
+      }
+      else if (!isVariant)
+      {
+        NEW_SPAN(span, return);
+        span->setX0AndType(x0 + i, RASTER_SPAN_AX_EXTRA);
+        span->setVariantMask(reinterpret_cast<uint8_t*>(mask + i));
+        isVariant = true;
+      }
+
+      i = j;
+    }
+
+    if (isVariant)
+      span->setX1(x0 + w);
+
+    span = scanline->end(span);
+
+    // ------------------------------------------------------------------------
+    // [Fill / Skip]
+    // ------------------------------------------------------------------------
+
+    if (FOG_IS_NULL(span))
+    {
+      filler->skip(1);
+    }
+    else
+    {
+#if defined(FOG_DEBUG_RASTERIZER)
+      Rasterizer_dumpSpans(y0, scanline->getSpans());
+#endif // FOG_DEBUG_RASTERIZER
+      filler->process(span);
+    }
+
+    if (++y0 >= y1)
+      return;
+
+    cover += stride;
+    area += stride;
+  }
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Render - Dense - Clip-Mask]
+// ============================================================================
+
+template<int _RULE, int _USE_ALPHA>
+static void FOG_CDECL PathRasterizer8_render_dense_st_clip_mask(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
+
+  PathRasterizer8_render_dense_st_clip_box<_RULE, _USE_ALPHA>(_self, &proxy, scanline);
+}
+
+// ============================================================================
+// [Fog::PathRasterizer8 - Finalize]
+// ============================================================================
+
+err_t PathRasterizer8::finalize()
+{
+  PathRasterizer8* self = this;
+
+  // If already finalized this is the NOP.
+  if (_error != ERR_OK || _isFinalized)
+    return _error;
+
+  // If no shape has been added, then the output is not valid.
+  if (_boundingBox.y0 == -1)
+    goto _NotValid;
+
+  // The dense sweep doesn't support region clipping.
+  if (_isDense && _clipType == RASTER_CLIP_REGION && denseToChunks() != ERR_OK)
+    return _error;
+
+  // Normalize bounding box to our standard, x1/y1 coordinates are outside.
+  _boundingBox.x1++;
+  _boundingBox.y1++;
+
+  // Small tolerance here due to the floating point arithmetic. Sweep scanline
+  // never return anything beyond the bounding box.
+  FOG_ASSERT(_boundingBox.x1 <= _sceneBox.x1 + 1);
+  FOG_ASSERT(_boundingBox.y1 <= _sceneBox.y1 + 1);
+
+  if (_boundingBox.x1 > _sceneBox.x1) _boundingBox.x1 = _sceneBox.x1;
+  if (_boundingBox.y1 > _sceneBox.y1) _boundingBox.y1 = _sceneBox.y1;
+
+  // We added small tolerance to the rasterizer because of floating point based
+  // clipping, but if there is no bounding box (due to correction above) then
+  // there is no shape.
+  _isValid = (_boundingBox.x0 != _boundingBox.x1 &&
+              _boundingBox.y0 != _boundingBox.y1);
+  _isFinalized = true;
+
+  // Setup render method.
+  if (self->_isDense)
+  {
+    uint isClipMask = self->_clipType == RASTER_CLIP_MASK;
 
-    coverSign = -1;
+    if (self->_fillRule == FILL_RULE_NON_ZERO)
+      self->_render = Rasterizer_api.path8.render_dense_nonzero[self->_opacity != 0x100][isClipMask];
+    else
+      self->_render = Rasterizer_api.path8.render_dense_evenodd[self->_opacity != 0x100][isClipMask];
   }
-
-  // If we are going from bottom to top then we need to invert the fractional
-  // parts of y0/y1. In case that the inversion overflow it's needed to subtract
-  // A8_SCALE*2 to normalize the position into the opposite pixel.
-  if (y0 > y1)
+  else
   {
-    static const int norm[2] = { 1, 1 - A8_SCALE * 2};
+    if (self->_fillRule == FILL_RULE_NON_ZERO)
+      self->_render = Rasterizer_api.path8.render_nonzero[self->_opacity != 0x100][self->_clipType];
+    else
+      self->_render = Rasterizer_api.path8.render_evenodd[self->_opacity != 0x100][self->_clipType];
+  }
+  return ERR_OK;
 
-    y0 ^= A8_MASK;
-    y0 += norm[(int(y0) & A8_MASK) == A8_MASK];
-    y1  = y0 + dy;
+_NotValid:
+  _isValid = false;
+  _isFinalized = true;
+  return ERR_OK;
 
-    rInc = -1;
-    coverSign = -coverSign;
-  }
+#undef SETUP_FUNCS
+}
 
-  // Extract the raster and fractional coordinates.
-  int ex0 = int(x0 >> A8_SHIFT);
-  int fx0 = int(x0) & A8_MASK;
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Construction / Destruction]
+// ============================================================================
 
-  int ey0 = int(y0 >> A8_SHIFT);
-  int fy0 = int(y0) & A8_MASK;
+HairlineRasterizer8::HairlineRasterizer8()
+{
+  // Default is no multithreading.
+  _scope.reset();
 
-  int ex1 = int(x1 >> A8_SHIFT);
-  int fy1 = int(y1) & A8_MASK;
+  // Clear cells.
+  _cellsBox.reset();
+  _cellsStride = 0;
+  _cellsCapacity = 0;
+  _rowsCapacity = 0;
+  _cellsStorage = NULL;
+  _rowsStorage = NULL;
 
-  // How many Y iterations to do.
-  int i = 1;
-  // How many Y iterations to do next.
-  int j = int(y1 >> A8_SHIFT) - ey0;
+  reset();
+}
 
-  // NOTE: Variable 'i' is just loop counter. Because we need to make sure to
-  // handle the start and end points of the line (start point is always based
-  // on the y0 coordinate and end point is always based on the y1 coordinate),
-  // we need two variables:
-  //
-  //  - 'i' - Used for current loop.
-  //  - 'j' - Used for next loop.
+HairlineRasterizer8::~HairlineRasterizer8()
+{
+  if (_cellsStorage != NULL)
+    MemMgr::free(_cellsStorage);
 
-  // Prepare the current and end row pointers.
-  PathRasterizer8::Row* rPtr = self->_rowsAdjusted;
-  PathRasterizer8::Row* rEnd = self->_rowsAdjusted;
+  if (_rowsStorage != NULL)
+    MemMgr::free(_rowsStorage);
+}
 
-  // --------------------------------------------------------------------------
-  // [Bounding-Box]
-  // --------------------------------------------------------------------------
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Reset]
+// ============================================================================
 
-  {
-    int by0 = ey0;
-    int by1 = ey0 + (j - (fy1 == 0)) * rInc;
+void HairlineRasterizer8::reset()
+{
+  clearCells();
 
-    if (by0 > by1)
-      swap(by0, by1);
-    
-    if (FOG_UNLIKELY(self->_boundingBox.y0 == -1))
-    {
-      // Initialize the bounding-box.
-      self->_boundingBox.x0 = ex0;
-      self->_boundingBox.y0 = by0;
-      self->_boundingBox.x1 = ex1;
-      self->_boundingBox.y1 = by1;
+  // Reset scene-box.
+  _sceneBox.reset();
+  _boundingBox.setBox(-1, -1, -1, -1);
 
-      // Initialize the rows.
-      for (;;)
-      {
-        rPtr[by0].first = NULL;
-        if (by0 == by1)
-          break;
-        by0++;
-      }
-    }
-    else
-    {
-      int bEnd;
+  // Reset error.
+  _error = ERR_OK;
+  // Reset opacity.
+  _opacity = 0x100;
 
-      // Merge the bounding-box with the line.
-      if (ex0 < self->_boundingBox.x0) self->_boundingBox.x0 = ex0;
-      if (ex1 > self->_boundingBox.x1) self->_boundingBox.x1 = ex1;
+  // Reset line params.
+  _lineWidth = 1.0;
+  _startCap = LINE_CAP_DEFAULT;
+  _endCap = LINE_CAP_DEFAULT;
 
-      // Clear the rows (clear).
-      bEnd = self->_boundingBox.y0;
-      if (by0 < bEnd)
-      {
-        self->_boundingBox.y0 = by0;
-        do {
-          rPtr[by0++].first = NULL;
-        } while (by0 != bEnd);
-      }
+  // Not valid neither finalized.
+  _isValid = false;
+  _isFinalized = false;
+}
 
-      bEnd = self->_boundingBox.y1;
-      if (by1 > bEnd)
-      {
-        self->_boundingBox.y1 = by1;
-        do {
-          rPtr[++bEnd].first = NULL;
-        } while (by1 != bEnd);
-      }
-    }
-  }
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Init]
+// ============================================================================
 
-  rPtr += ey0;
-  rEnd += ey0 + (j + (fy1 != 0)) * rInc;
+err_t HairlineRasterizer8::init()
+{
+  // Cells can be still dirty if the previous shape wasn't rendered.
+  clearCells();
+  _boundingBox.setBox(-1, -1, -1, -1);
 
-  // --------------------------------------------------------------------------
-  // [Point]
-  // --------------------------------------------------------------------------
+  _error = ERR_OK;
+  _isValid = false;
+  _isFinalized = false;
 
-  // If the line is so small that it covers only one cell in one scanline, we
-  // can use this fast-path to return as early as possible from renderLine().
-  //
-  // This can happen when approximating very small circular arcs (for example
-  // small radius when painting rounded rectangle) or when painting an object
-  // which is heavily down-scaled.
-  if ((j | ((fx0 + int(dx)) > 256)) == 0)
-  {
-    fx0 = fx0 * 2 + int(dx);
-    goto _One;
-  }
+  return _error;
+}
 
-  // --------------------------------------------------------------------------
-  // [Vertical Only]
-  // --------------------------------------------------------------------------
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Cells]
+// ============================================================================
 
-  if (dx == 0)
-  {
-    // We have to calculate start and end cells, and then - the common values
-    // of the area and coverage for all cells of the line. We know exactly 
-    // there's only one cell per scanline, thus, we don't have to use
-    // complicated scanline rasterization.
-    if (j > 0)
-      cover = (A8_SCALE - fy0) * coverSign;
+bool HairlineRasterizer8::initCells(const BoxI& box)
+{
+  FOG_ASSERT(_cellsBox.getHeight() == 0);
+  FOG_ASSERT(_sceneBox.subsumes(box));
 
-    fx0 *= 2;
-    fy0 = A8_SCALE;
+  int w = box.getWidth();
+  int h = box.getHeight();
 
-    // Instead of making two versions of this function (one for positive covers
-    // and one for negative covers) we just negate the important variables if
-    // needed.
-    if (coverSign < 0)
-    {
-      fy0 = -fy0;
-      fy1 = -fy1;
-    }
+  if (w <= 0 || h <= 0)
+    return false;
 
-    for (;;)
-    {
-_One:
-      area = fx0 * cover;
-      do {
-        ROW_ADD_ONE(_Vert_Only, rPtr, ex0, cover, area);
-        rPtr += rInc;
-      } while (--i);
+  size_t size = (size_t)(uint)w * (size_t)(uint)h;
 
-      if (rPtr == rEnd)
-        break;
+  if (_cellsCapacity < size)
+  {
+    if (_cellsStorage != NULL)
+      MemMgr::free(_cellsStorage);
 
-      i = j;
-      j = 1;
-      cover = fy1;
+    // Align... The storage is kept zeroed, only dirty rows are cleared later.
+    _cellsCapacity = (size + 4095U) & ~(size_t)4095U;
+    _cellsStorage = reinterpret_cast<uint16_t*>(MemMgr::calloc(_cellsCapacity * sizeof(uint16_t)));
 
-      if (i > 1)
-      {
-        cover = fy0;
-        i--;
-      }
+    if (_cellsStorage == NULL)
+    {
+      _cellsCapacity = 0;
+      setError(ERR_RT_OUT_OF_MEMORY);
+      return false;
     }
-    return true;
   }
 
-  // --------------------------------------------------------------------------
-  // [Vertical / Horizontal Orientation]
-  // --------------------------------------------------------------------------
-
-  else
+  if (_rowsCapacity < (uint)h)
   {
-    // Only one or two cells are generated per scanline.
-    FixedT xErr = -dy / 2, xBase, xLift, xRem, xDlt = dx;
-    FixedT yErr = -dx / 2, yBase, yLift, yRem, yDlt = dy;
-
-    xBase = dx * A8_SCALE;
-    xLift = xBase / dy;
-    xRem  = xBase % dy;
+    if (_rowsStorage != NULL)
+      MemMgr::free(_rowsStorage);
 
-    yBase = dy * A8_SCALE;
-    yLift = yBase / dx;
-    yRem  = yBase % dx;
+    // Align...
+    _rowsCapacity = ((uint)h + 255U) & ~255U;
+    _rowsStorage = reinterpret_cast<Row*>(MemMgr::alloc(_rowsCapacity * sizeof(Row)));
 
-    if (j != 0)
+    if (_rowsStorage == NULL)
     {
-      FixedT p = FixedT(A8_SCALE - fy0) * dx;
+      _rowsCapacity = 0;
+      setError(ERR_RT_OUT_OF_MEMORY);
+      return false;
+    }
+  }
 
-      xDlt  = p / dy;
-      xErr += p % dy;
+  for (int i = 0; i < h; i++)
+  {
+    _rowsStorage[i].x0 = w;
+    _rowsStorage[i].x1 = 0;
+  }
 
-      fy1 = A8_SCALE;
-    }
+  _cellsBox = box;
+  _cellsStride = w;
+  return true;
+}
 
-    if (ex0 != ex1)
-    {
-      FixedT p = FixedT(A8_SCALE - fx0) * dy;
+void HairlineRasterizer8::clearCells()
+{
+  int h = _cellsBox.getHeight();
+  uint16_t* cells = _cellsStorage;
 
-      yDlt = p / dx;
-      yErr += p % dx;
-    }
+  for (int i = 0; i < h; i++, cells += _cellsStride)
+  {
+    int x0 = _rowsStorage[i].x0;
+    int x1 = _rowsStorage[i].x1;
 
-    // ------------------------------------------------------------------------
-    // [Vertical Orientation]
-    // ------------------------------------------------------------------------
+    if (x0 < x1)
+      MemOps::zero(cells + x0, (size_t)(uint)(x1 - x0) * sizeof(uint16_t));
+  }
 
-    if (dy >= dx)
-    {
-      int yAcc = int(y0) + int(yDlt);
+  _cellsBox.reset();
+}
 
-      if (coverSign > 0)
-      {
-        goto _Vert_P_Skip;
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Helpers]
+// ============================================================================
 
-        for (;;)
-        {
-          do {
-            xDlt = xLift;
-            xErr += xRem;
-            if (xErr >= 0) { xErr -= dy; xDlt++; }
+//! @internal
+//!
+//! @brief Hairline segment end-point.
+struct FOG_NO_EXPORT HairlineRasterizer8_End
+{
+  //! @brief Whether the end is round (round cap or join).
+  bool isRound;
+  //! @brief Extension of the segment (used if the end is not round).
+  double extension;
+};
 
-_Vert_P_Skip:
-            area = fx0;
-            fx0 += int(xDlt);
+//! @internal
+//!
+//! @brief Get the end-point description of @a cap.
+//!
+//! Caps except the round one are approximated by a butt cap extended by the
+//! average length of the cap geometry (it's negative for reversed caps).
+static FOG_INLINE void HairlineRasterizer8_initEnd(HairlineRasterizer8_End& end, uint32_t cap, double hw)
+{
+  end.isRound = false;
+  end.extension = 0.0;
 
-            if (fx0 <= 256)
-            {
-              cover = fy1 - fy0; // Positive.
-              area += fx0;
+  switch (cap)
+  {
+    case LINE_CAP_SQUARE:
+      end.extension = hw;
+      break;
 
-_Vert_P_Single:
-              area *= cover;
-              ROW_ADD_ONE(_Vert_P, rPtr, ex0, cover, area);
+    case LINE_CAP_ROUND:
+      end.isRound = true;
+      break;
 
-              if (fx0 == 256)
-              {
-                ex0++;
-                fx0 = 0;
-                goto _Vert_P_Advance;
-              }
-            }
-            else
-            {
-              yAcc &= 0xFF;
-              FOG_ASSERT(yAcc >= fy0 && yAcc <= fy1);
-              
-              cover = yAcc - fy0; // Positive.
-              fx0  &= A8_MASK;
+    case LINE_CAP_ROUND_REVERSE:
+      end.extension = -hw * (MATH_PI * 0.25);
+      break;
 
-              // Improve the count of generated cells in case that the resulting
-              // cover is zero using the 'ROW_ADD_ONE'. The 'goto' ensures that
-              // the ROW_ADD_ONE() macro will be expanded only once.
-              if (cover == 0)
-              {
-                cover = fy1 - yAcc; // Positive.
-                area  = fx0;
-                ex0++;
-                goto _Vert_P_Single;
-              }
-              else
-              {
-                area = (area + A8_SCALE) * cover;
-                ROW_ADD_TWO(_Vert_P, rPtr, ex0, cover, area,
-                {
-                  cover = fy1 - yAcc; // Positive.
-                  area  = fx0 * cover;
-                  ex0++;
-                });
-              }
+    case LINE_CAP_TRIANGLE:
+      end.extension = hw * 0.5;
+      break;
 
-_Vert_P_Advance:
-              yAcc += int(yLift);
-              yErr += yRem;
-              if (yErr >= 0) { yErr -= dx; yAcc++; }
-            }
+    case LINE_CAP_TRIANGLE_REVERSE:
+      end.extension = -hw * 0.5;
+      break;
 
-            rPtr += rInc;
-          } while (--i);
+    default:
+      break;
+  }
+}
 
-          if (rPtr == rEnd)
-            break;
+//! @internal
+//!
+//! @brief Accumulate the coverage of one segment into the cell buffer.
+static void HairlineRasterizer8_renderSegment(HairlineRasterizer8* self,
+  double x0, double y0, double x1, double y1,
+  const HairlineRasterizer8_End& start, const HairlineRasterizer8_End& end)
+{
+  double dx = x1 - x0;
+  double dy = y1 - y0;
+  double len = Math::sqrt(dx * dx + dy * dy);
 
-          i = j;
-          j = 1;
+  if (len <= MathConstant<double>::getDistanceEpsilon())
+    return;
 
-          if (i > 1)
-          {
-            fy0 = 0;
-            fy1 = A8_SCALE;
-            i--;
-          }
-          else
-          {
-            fy0 = 0;
-            fy1 = int(y1) & A8_MASK;
+  double ux = dx / len;
+  double uy = dy / len;
 
-            xDlt = x1 - (ex0 << 8) - fx0;
-            goto _Vert_P_Skip;
-          }
-        }
-      }
-      else
-      {
-        goto _Vert_N_Skip;
+  double hw = self->_lineWidth * 0.5;
+  double lo = -start.extension;
+  double hi = len + end.extension;
+  double opacity = double(self->_opacity);
 
-        for (;;)
-        {
-          do {
-            xDlt = xLift;
-            xErr += xRem;
-            if (xErr >= 0) { xErr -= dy; xDlt++; }
+  // Pixels which are farther than 'reach' from the segment end-points can't
+  // be covered by the segment or its ends.
+  double reach = hw + 1.0;
 
-_Vert_N_Skip:
-            area = fx0;
-            fx0 += int(xDlt);
+  const BoxI& box = self->_cellsBox;
+  int stride = self->_cellsStride;
 
-            if (fx0 <= 256)
-            {
-              cover = fy0 - fy1; // Negative.
-              area += fx0;
+  double yMin = Math::min(y0, y1) - reach;
+  double yMax = Math::max(y0, y1) + reach;
+  double xMin = Math::min(x0, x1) - reach;
+  double xMax = Math::max(x0, x1) + reach;
 
-_Vert_N_Single:
-              area *= cover;
-              ROW_ADD_ONE(_Vert_N, rPtr, ex0, cover, area);
+  if (yMax <= double(box.y0) || yMin >= double(box.y1) ||
+      xMax <= double(box.x0) || xMin >= double(box.x1))
+  {
+    return;
+  }
 
-              if (fx0 == 256)
-              {
-                ex0++;
-                fx0 = 0;
-                goto _Vert_N_Advance;
-              }
-            }
-            else
-            {
-              yAcc &= 0xFF;
-              FOG_ASSERT(yAcc >= fy0 && yAcc <= fy1);
+  if (xMin < double(box.x0)) xMin = double(box.x0);
+  if (xMax > double(box.x1)) xMax = double(box.x1);
 
-              cover = fy0 - yAcc; // Negative.
-              fx0  &= A8_MASK;
+  if (yMin < double(box.y0)) yMin = double(box.y0);
+  if (yMax > double(box.y1)) yMax = double(box.y1);
 
-              // Improve the count of generated cells in case that the resulting
-              // cover is zero using the 'ROW_ADD_ONE'. The 'goto' ensures that
-              // the ROW_ADD_ONE() macro will be expanded only once.
-              if (cover == 0)
-              {
-                cover = yAcc - fy1; // Negative.
-                area  = fx0;
-                ex0++;
-                goto _Vert_N_Single;
-              }
-              else
-              {
-                area = (area + A8_SCALE) * cover;
-                ROW_ADD_TWO(_Vert_N, rPtr, ex0, cover, area,
-                {
-                  cover = yAcc - fy1; // Negative.
-                  area  = fx0 * cover;
-                  ex0++;
-                });
-              }
+  int yStart = Math::ifloor(yMin);
+  int yEnd = Math::iceil(yMax);
 
-_Vert_N_Advance:
-              yAcc += int(yLift);
-              yErr += yRem;
-              if (yErr >= 0) { yErr -= dx; yAcc++; }
-            }
+  // Half of the band in horizontal direction, the pixel can be covered only
+  // if its center is closer than (hw + 0.5) to the centerline.
+  bool isHorizontal = Math::abs(uy) <= MathConstant<double>::getDistanceEpsilon();
+  double bandX = isHorizontal ? 0.0 : (hw + 0.5) / Math::abs(uy);
 
-            rPtr += rInc;
-          } while (--i);
+  for (int y = yStart; y < yEnd; y++)
+  {
+    double cy = double(y) + 0.5;
+    double py = cy - y0;
 
-          if (rPtr == rEnd)
-            break;
+    double xa = xMin;
+    double xb = xMax;
 
-          i = j;
-          j = 1;
+    if (!isHorizontal)
+    {
+      double xc = x0 + py * (dx / dy);
 
-          if (i > 1)
-          {
-            fy0 = 0;
-            fy1 = A8_SCALE;
-            i--;
-          }
-          else
-          {
-            fy0 = 0;
-            fy1 = int(y1) & A8_MASK;
-            xDlt = x1 - (ex0 << 8) - fx0;
-            goto _Vert_N_Skip;
-          }
-        }
-      }
+      xa = Math::max(xa, xc - bandX);
+      xb = Math::min(xb, xc + bandX);
 
-      return true;
+      if (xa >= xb)
+        continue;
     }
 
-    // ------------------------------------------------------------------------
-    // [Horizontal Orientation]
-    // ------------------------------------------------------------------------
+    int xStart = Math::ifloor(xa);
+    int xEnd = Math::iceil(xb);
 
-    else
+    int rowIndex = y - box.y0;
+    uint16_t* cells = self->_cellsStorage + (size_t)(uint)rowIndex * (uint)stride - box.x0;
+
+    int dirty0 = xEnd;
+    int dirty1 = xStart;
+
+    for (int x = xStart; x < xEnd; x++)
     {
-      // Cell operator, directly used/modified by ROW_ADD_N() macro.
-      int _cellOp = coverSign > 0 ? CELL_OP_POSITIVE : CELL_OP_NEGATIVE;
+      double px = double(x) + 0.5 - x0;
 
-      int fx1;
-      int coverAcc = fy0;
+      // Position along the segment and distance from the centerline.
+      double s = px * ux + py * uy;
+      double d = Math::abs(px * uy - py * ux);
 
-      cover = int(yDlt);
-      coverAcc += cover;
+      if (s < 0.0 && start.isRound)
+        d = Math::sqrt(px * px + py * py);
+      else if (s > len && end.isRound)
+        d = Math::sqrt((px - dx) * (px - dx) + (py - dy) * (py - dy));
 
-      if (j != 0)
-        fy1 = A8_SCALE;
+      // Overlap of the pixel with the band of the line (perpendicular).
+      double c = Math::min(d + hw, 0.5) - Math::max(d - hw, -0.5);
+      if (c <= 0.0)
+        continue;
 
-      if (fx0 + int(xDlt) > 256)
-        goto _Horz_Inside;
+      // Overlap of the pixel with the segment (along the segment), only used
+      // by non-round ends.
+      double a = 1.0;
+      if (!start.isRound && s - 0.5 < lo) a -= lo - (s - 0.5);
+      if (!end.isRound && s + 0.5 > hi) a -= (s + 0.5) - hi;
 
-      x0 += xDlt;
+      if (a <= 0.0)
+        continue;
 
-      cover = (fy1 - fy0) * coverSign;
-      area = (fx0 * 2 + int(xDlt)) * cover;
+      uint32_t cover = (uint32_t)Math::iround(c * a * opacity);
+      if (cover == 0)
+        continue;
 
-_Horz_Single:
-      ROW_ADD_ONE(_Horz, rPtr, ex0, cover, area);
-      
-      rPtr += rInc;
-      if (rPtr == rEnd)
-        return true;
-      
-      if (fx0 + int(xDlt) == 256)
-      {
-        coverAcc += int(yLift);
-        yErr += yRem;
-        if (yErr >= 0) { yErr -= dx; coverAcc++; }
-      }
+      if (cells[x] < cover)
+        cells[x] = (uint16_t)cover;
 
-      if (--i == 0)
-        goto _Horz_After;
+      if (dirty0 > x) dirty0 = x;
+      dirty1 = x + 1;
+    }
 
-      for (;;)
-      {
-        do {
-          xDlt = xLift;
-          xErr += xRem;
-          if (xErr >= 0) { xErr -= dy; xDlt++; }
+    if (dirty0 >= dirty1)
+      continue;
 
-          ex0 = int(x0 >> A8_SHIFT);
-          fx0 = int(x0) & A8_MASK;
+    HairlineRasterizer8::Row& row = self->_rowsStorage[rowIndex];
+    if (row.x0 > dirty0 - box.x0) row.x0 = dirty0 - box.x0;
+    if (row.x1 < dirty1 - box.x0) row.x1 = dirty1 - box.x0;
 
-_Horz_Skip:
-          coverAcc -= 256;
-          cover = coverAcc;
-          FOG_ASSERT(cover >= 0 && cover <= 256);
+    if (self->_boundingBox.y0 == -1)
+    {
+      self->_boundingBox.setBox(dirty0, y, dirty1 - 1, y);
+    }
+    else
+    {
+      if (self->_boundingBox.x0 > dirty0) self->_boundingBox.x0 = dirty0;
+      if (self->_boundingBox.x1 < dirty1 - 1) self->_boundingBox.x1 = dirty1 - 1;
+      if (self->_boundingBox.y0 > y) self->_boundingBox.y0 = y;
+      if (self->_boundingBox.y1 < y) self->_boundingBox.y1 = y;
+    }
+  }
+}
 
-_Horz_Inside:
-          x0 += xDlt;
+//! @internal
+//!
+//! @brief Accumulate the coverage of one figure (polyline or polygon).
+template<typename NumT>
+static void HairlineRasterizer8_renderFigure(HairlineRasterizer8* self,
+  const NumT_(Point)* pts, size_t count, bool isClosed, const NumT_(Point)& offset)
+{
+  double hw = self->_lineWidth * 0.5;
+  double eps = MathConstant<double>::getDistanceEpsilon();
 
-          ex1 = int(x0 >> A8_SHIFT);
-          fx1 = int(x0) & A8_MASK;
+  HairlineRasterizer8_End join;
+  join.isRound = true;
+  join.extension = 0.0;
 
-          FOG_ASSERT(ex0 != ex1);
+  if (count < 2)
+    return;
 
-          if (fx1 == 0)
-            fx1 = A8_SCALE;
-          else
-            ex1++;
+  // To stroke a polygon we need at least three vertices (the same rule as
+  // used by the PathStroker), otherwise the figure is stroked as polyline.
+  if (isClosed && count > 2)
+  {
+    double fx = double(pts[0].x) + double(offset.x);
+    double fy = double(pts[0].y) + double(offset.y);
 
-          // Calculate the first cover/area pair. All cells inside the line
-          // will be calculated inside ROW_ADD_N() loop.
-          area = (fx0 + A8_SCALE) * cover;
+    double x0 = fx;
+    double y0 = fy;
 
-          ROW_ADD_N(_Horz, rPtr, ex0, ex1, cover, area,
-          { /* Advance: */
-            cover = int(yLift);
-            yErr += yRem;
-            if (yErr >= 0) { yErr -= dx; cover++; }
+    for (size_t i = 1; i <= count; i++)
+    {
+      double x1 = fx;
+      double y1 = fy;
 
-            coverAcc += cover;
-            area = A8_SCALE * cover;
-          },
-          { /* Last: */
-            cover += fy1 - coverAcc;
-            area = fx1 * cover;
+      if (i < count)
+      {
+        x1 = double(pts[i].x) + double(offset.x);
+        y1 = double(pts[i].y) + double(offset.y);
+      }
+
+      if (Math::abs(x1 - x0) <= eps && Math::abs(y1 - y0) <= eps)
+        continue;
 
-            if (fx1 == A8_SCALE)
-            {
-              coverAcc += int(yLift);
-              yErr += yRem;
-              if (yErr >= 0) { yErr -= dx; coverAcc++; }
-            }
-          });
+      HairlineRasterizer8_renderSegment(self, x0, y0, x1, y1, join, join);
+      x0 = x1;
+      y0 = y1;
+    }
+  }
+  else
+  {
+    HairlineRasterizer8_End startCap;
+    HairlineRasterizer8_End endCap;
 
-          rPtr += rInc;
-        } while (--i);
+    HairlineRasterizer8_initEnd(startCap, self->_startCap, hw);
+    HairlineRasterizer8_initEnd(endCap, self->_endCap, hw);
 
-        if (rPtr == rEnd)
-          break;
+    // The segment is rendered when the next distinct vertex is known, so the
+    // last segment gets the end cap.
+    double x0 = double(pts[0].x) + double(offset.x);
+    double y0 = double(pts[0].y) + double(offset.y);
 
-_Horz_After:
-        i = j;
-        j = 1;
+    double x1 = 0.0;
+    double y1 = 0.0;
 
-        if (i > 1)
-        {
-          fy1 = A8_SCALE;
-          i--;
-        }
-        else
-        {
-          fy1 = int(y1) & A8_MASK;
-          xDlt = x1 - x0;
+    bool hasSegment = false;
+    bool isFirst = true;
 
-          ex0 = int(x0 >> A8_SHIFT);
-          fx0 = int(x0) & A8_MASK;
+    for (size_t i = 1; i < count; i++)
+    {
+      double x2 = double(pts[i].x) + double(offset.x);
+      double y2 = double(pts[i].y) + double(offset.y);
 
-          if (fx0 + int(xDlt) <= 256)
-          {
-            cover = fy1 * coverSign;
-            area = (fx0 * 2 + int(xDlt)) * cover;
-            goto _Horz_Single;
-          }
-          else
-          {
-            goto _Horz_Skip;
-          }
-        }
+      if (!hasSegment)
+      {
+        if (Math::abs(x2 - x0) <= eps && Math::abs(y2 - y0) <= eps)
+          continue;
+
+        x1 = x2;
+        y1 = y2;
+        hasSegment = true;
+        continue;
       }
 
-      return true;
+      if (Math::abs(x2 - x1) <= eps && Math::abs(y2 - y1) <= eps)
+        continue;
+
+      HairlineRasterizer8_renderSegment(self, x0, y0, x1, y1, isFirst ? startCap : join, join);
+      isFirst = false;
+
+      x0 = x1;
+      y0 = y1;
+      x1 = x2;
+      y1 = y2;
     }
-  }
 
-_Bail:
-  return false;
+    if (hasSegment)
+      HairlineRasterizer8_renderSegment(self, x0, y0, x1, y1, isFirst ? startCap : join, endCap);
+  }
 }
 
-// ============================================================================
-// [Fog::PathRasterizer8 - Render - Helpers]
-// ============================================================================
-
-template<int _RULE, int _USE_ALPHA>
-static FOG_INLINE uint32_t PathRasterizer8_calculateAlpha(const PathRasterizer8* self, int cover)
+template<typename NumT>
+static void HairlineRasterizer8_addPath(HairlineRasterizer8* self,
+  const NumT_(Path)& path, const NumT_(Point)& offset)
 {
-  if (cover < 0) cover = -cover;
-
-  if (_RULE == FILL_RULE_NON_ZERO)
-  {
-    if (cover > A8_SCALE)
-      cover = A8_SCALE;
-  }
-  else
+  // The rasterizer works only with flattened paths, curves are normally
+  // flattened by the caller (together with the transformation).
+  if (path.hasBeziers())
   {
-    cover &= A8_MASK_2;
-    if (cover > A8_SCALE)
-      cover = A8_SCALE_2 - cover;
+    NumT_T1(PathTmp, 200) tmp;
+
+    if (FOG_IS_ERROR(self->_error = NumI_(Path)::flatten(tmp, path, NumT_(PathFlattenParams)())))
+      return;
+
+    HairlineRasterizer8_addPath<NumT>(self, tmp, offset);
+    return;
   }
 
-  if (_USE_ALPHA)
-    cover = (cover * self->_opacity) >> 8;
+  NumT_(Box) pathBox(UNINITIALIZED);
+  if (path.getBoundingBox(pathBox) != ERR_OK)
+    return;
 
-  return cover;
-}
+  // Setup the cell buffer, it's clipped to the scene-box.
+  double reach = self->_lineWidth * 0.5 + 2.0;
 
-// ============================================================================
-// [Fog::PathRasterizer8 - Render - Clip-Box]
-// ============================================================================
+  double bx0 = double(pathBox.x0) + double(offset.x) - reach;
+  double by0 = double(pathBox.y0) + double(offset.y) - reach;
+  double bx1 = double(pathBox.x1) + double(offset.x) + reach;
+  double by1 = double(pathBox.y1) + double(offset.y) + reach;
 
-template<int _RULE, int _USE_ALPHA>
-static void FOG_CDECL PathRasterizer8_render_st_clip_box(
-  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
-{
-  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
-  FOG_ASSERT(self->_isFinalized);
+  const BoxI& sceneBox = self->_sceneBox;
 
-  int y0 = self->_boundingBox.y0;
-  int y1 = self->_boundingBox.y1;
-  int xEnd = self->_sceneBox.x1;
+  if (bx1 <= double(sceneBox.x0) || by1 <= double(sceneBox.y0) ||
+      bx0 >= double(sceneBox.x1) || by0 >= double(sceneBox.y1))
+  {
+    return;
+  }
 
-  // --------------------------------------------------------------------------
-  // [Prepare]
-  // --------------------------------------------------------------------------
+  BoxI cellsBox(
+    Math::ifloor(Math::max(bx0, double(sceneBox.x0))),
+    Math::ifloor(Math::max(by0, double(sceneBox.y0))),
+    Math::iceil(Math::min(bx1, double(sceneBox.x1))),
+    Math::iceil(Math::min(by1, double(sceneBox.y1))));
 
-  if (FOG_IS_ERROR(scanline->prepare(self->_boundingBox.getWidth() * 2)))
+  if (!self->initCells(cellsBox))
     return;
 
-  PathRasterizer8::Row* rows = self->_rowsAdjusted + y0;
-  filler->prepare(y0);
-  
-  // --------------------------------------------------------------------------
-  // [Process]
-  // --------------------------------------------------------------------------
+  // Traverse the path and render all figures.
+  const uint8_t* cmd = path.getCommands();
+  const NumT_(Point)* pts = path.getVertices();
 
-  for (;;)
+  size_t length = path.getLength();
+  size_t i = 0;
+
+  while (i < length)
   {
-    // ------------------------------------------------------------------------
-    // [Merge / Skip]
-    // ------------------------------------------------------------------------
+    // Skip 'close' commands which don't close anything.
+    if (!PathCmd::isVertex(cmd[i]))
+    {
+      i++;
+      continue;
+    }
 
-    PathRasterizer8::Chunk* first = rows->first;
-    rows++;
+    size_t start = i;
+    while (++i < length && PathCmd::isLineTo(cmd[i]))
+      continue;
 
-    if (FOG_IS_NULL(first))
-    {
-      int mark = y0;
-      do {
-        if (++y0 >= y1) return;
+    bool isClosed = (i < length && PathCmd::isClose(cmd[i]));
+    HairlineRasterizer8_renderFigure<NumT>(self, pts + start, i - start, isClosed, offset);
 
-        first = rows->first;
-        rows++;
-      } while (first == NULL);
+    if (isClosed)
+      i++;
+  }
+}
 
-      filler->skip(y0 - mark);
-    }
+// ============================================================================
+// [Fog::HairlineRasterizer8 - AddPath]
+// ============================================================================
 
-    VERIFY_CHUNKS_8(first);
+void HairlineRasterizer8::addPath(const PathF& path, const PointF& offset)
+{
+  FOG_ASSERT(_isFinalized == false);
+  FOG_ASSERT(_boundingBox.y0 == -1);
 
-    // ------------------------------------------------------------------------
-    // [Fetch]
-    // ------------------------------------------------------------------------
+  if (_error != ERR_OK) return;
+  HairlineRasterizer8_addPath<float>(this, path, offset);
+}
 
-    RasterSpan8* span = scanline->begin();
-    uint8_t* mask = scanline->getMask();
+void HairlineRasterizer8::addPath(const PathD& path, const PointD& offset)
+{
+  FOG_ASSERT(_isFinalized == false);
+  FOG_ASSERT(_boundingBox.y0 == -1);
 
-    PathRasterizer8::Chunk* chunk = first;
-    PathRasterizer8::Cell* cell = chunk->cells;
+  if (_error != ERR_OK) return;
+  HairlineRasterizer8_addPath<double>(this, path, offset);
+}
 
-    uint i = static_cast<uint>(chunk->getLength());
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Render - Helpers]
+// ============================================================================
 
-    int x;
-    int xNext = chunk->x0;
-    int cover = 0;
-    uint32_t alpha;
+//! @internal
+//!
+//! @brief Build spans from the cells in range [i, iEnd) of one row.
+//!
+//! Long runs of the same coverage are converted to const-mask spans and the
+//! transparent runs are skipped, everything else is the variant-mask which
+//! points directly to the cells.
+static FOG_INLINE RasterSpan8* HairlineRasterizer8_buildSpans(RasterScanline8* scanline,
+  RasterSpan8* span, const uint16_t* cells, int xBase, int i, int iEnd)
+{
+  bool isVariant = false;
 
-    for (;;)
-    {
-      if (xNext == xEnd)
-        break;
+  while (i < iEnd)
+  {
+    uint32_t alpha = cells[i];
+    int j = i + 1;
 
-      x = xNext;
+    while (j < iEnd && cells[j] == alpha)
+      j++;
 
-      // Link to the existing span if possible. In such case we don't need to
-      // worry about span allocation, because we have preallocated two spans,
-      // one for v-mask and one for possible c-mask.
-      if (span->getX1() != x || span->getType() != RASTER_SPAN_AX_EXTRA)
+    if (j - i > RASTER_SPAN_C_THRESHOLD || (alpha == 0 && (!isVariant || j == iEnd)))
+    {
+      if (isVariant)
       {
-        NEW_SPANS(span, 2, return);
-        span->setX0AndType(x, RASTER_SPAN_AX_EXTRA);
-        span->setVariantMask(mask);
+        span->setX1(xBase + i);
+        isVariant = false;
       }
 
-_Continue:
-      x += i;
-      if (x > xEnd && --i == 0)
+      if (alpha != 0)
       {
-        FOG_ASSERT(x - 1 == xEnd);
-        break;
+        NEW_SPAN(span, return NULL);
+        span->setPositionAndType(xBase + i, xBase + j, RASTER_SPAN_C);
+        span->setConstMask(alpha);
       }
+    }
+    else if (!isVariant)
+    {
+      NEW_SPAN(span, return NULL);
+      span->setX0AndType(xBase + i, RASTER_SPAN_AX_EXTRA);
+      span->setVariantMask(reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(cells + i)));
+      isVariant = true;
+    }
 
-      // Terminate span for now.
-      span->setX1(x);
+    i = j;
+  }
 
-      do {
-        cover += cell->cover;
-        alpha  = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover - (cell->area >> A8_SHIFT_2));
+  if (isVariant)
+    span->setX1(xBase + iEnd);
 
-        Acc::p32Store2a(mask, alpha);
-        mask += 2;
+  return span;
+}
 
-        cell++;
-      } while (--i);
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Render - Clip-Box]
+// ============================================================================
 
-      chunk = chunk->next;
-      if (chunk == first)
-        break;
+static void FOG_CDECL HairlineRasterizer8_render_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  HairlineRasterizer8* self = static_cast<HairlineRasterizer8*>(_self);
+  FOG_ASSERT(self->_isFinalized);
 
-      cell = chunk->cells;
-      xNext = chunk->x0;
-      i = (uint)chunk->getLength();
+  int y0 = self->_boundingBox.y0;
+  int y1 = self->_boundingBox.y1;
 
-      if (x == xNext)
-        goto _Continue;
+  int xBase = self->_cellsBox.x0;
+  size_t stride = (size_t)(uint)self->_cellsStride;
+  size_t rowIndex = (size_t)(uint)(y0 - self->_cellsBox.y0);
 
-      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
-      if (alpha != 0)
-      {
-        uint len = static_cast<uint>(xNext - x);
+  const uint16_t* cells = self->_cellsStorage + rowIndex * stride;
+  const HairlineRasterizer8::Row* row = self->_rowsStorage + rowIndex;
 
-        if (len <= RASTER_SPAN_C_THRESHOLD)
-        {
-          // If CPU supports unaligned read/write then we can optimize filling
-          // of small spans by extending the alpha to 32-bit or 64-bit integer
-          // and storing it directly to the current array. Span allocator always
-          // reserves some bytes for these optimizations.
-          //
-          // This optimization increased performance of FogBench for about 1-2%,
-          // depending on rasterized shape and size. It's very cheap, and gives
-          // good results.
-          FOG_ASSERT(RASTER_SPAN_C_THRESHOLD <= 4);
+  filler->prepare(y0);
 
-#if FOG_ARCH_BITS >= 64 && defined(FOG_ARCH_UNALIGNED_ACCESS_64)
-          Acc::p64Store8u(mask,
-            (uint64_t)alpha * FOG_UINT64_C(0x0001000100010001));
-          mask += len * 2;
-#elif FOG_ARCH_BITS >= 32 && defined(FOG_ARCH_UNALIGNED_ACCESS_32)
-          alpha *= 0x00010001;
-          Acc::p32Store4u(mask + 0, alpha);
-          Acc::p32Store4u(mask + 4, alpha);
-          mask += len * 2;
-#else
-          // Unoptimized case.
-          do {
-            Acc::p32Store2a(mask, alpha);
-            mask += 2;
-          } while (--len);
-#endif
-          span->setX1(xNext);
-        }
-        else
-        {
-          span->setNext(span + 1);
-          span++;
-          
-          span->setPositionAndType(x, xNext, RASTER_SPAN_C);
-          span->setConstMask(alpha);
-        }
-      }
-    }
+  for (;;)
+  {
+    RasterSpan8* span = scanline->begin();
+
+    span = HairlineRasterizer8_buildSpans(scanline, span, cells, xBase, row->x0, row->x1);
+    if (FOG_IS_NULL(span))
+      return;
 
     span = scanline->end(span);
 
-    // ------------------------------------------------------------------------
-    // [Fill / Skip]
-    // ------------------------------------------------------------------------
-
     if (FOG_IS_NULL(span))
     {
       filler->skip(1);
@@ -2662,457 +5016,412 @@ _Continue:
 
     if (++y0 >= y1)
       return;
+
+    cells += stride;
+    row++;
   }
 }
 
 // ============================================================================
-// [Fog::PathRasterizer8 - Render - Clip-Region]
+// [Fog::HairlineRasterizer8 - Render - Clip-Region]
 // ============================================================================
 
-template<int _RULE, int _USE_ALPHA>
-static void FOG_CDECL PathRasterizer8_render_st_clip_region(
+static void FOG_CDECL HairlineRasterizer8_render_st_clip_region(
   Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
-  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
+  HairlineRasterizer8* self = static_cast<HairlineRasterizer8*>(_self);
   FOG_ASSERT(self->_isFinalized);
 
-  int xMin = self->_boundingBox.x0;
-  int xEnd = self->_boundingBox.x1;
-
-  int yMin = self->_boundingBox.y0;
-  int yEnd = self->_boundingBox.y1;
-
-  int y0 = yMin;
-  int y1;
-  int yPos = y0;
+  const BoxI& box = self->_boundingBox;
 
   const BoxI* cPtr = self->_clip.region.data;
   const BoxI* cEnd = cPtr + self->_clip.region.length;
 
-  const BoxI* cBandStart;
-  const BoxI* cBandEnd;
+  int xBase = self->_cellsBox.x0;
+  int yBase = self->_cellsBox.y0;
+  size_t stride = (size_t)(uint)self->_cellsStride;
 
   // --------------------------------------------------------------------------
   // [Prepare]
   // --------------------------------------------------------------------------
 
-  if (FOG_IS_ERROR(scanline->prepare(self->_boundingBox.getWidth() * 2)))
+  // Skip boxes which do not intersect in vertical direction.
+  while (cPtr->y1 <= box.y0)
+  {
+    if (++cPtr == cEnd)
+      return;
+  }
+
+  if (cPtr->y0 >= box.y1)
     return;
 
-  PathRasterizer8::Row* rows = self->_rowsAdjusted;
+  int yPos = Math::max<int>(cPtr->y0, box.y0);
   filler->prepare(yPos);
 
   // --------------------------------------------------------------------------
   // [Process]
   // --------------------------------------------------------------------------
-  
-_NextBand:
-  if (cPtr == cEnd)
-    return;
 
-  for (;;)
-  {
-    PathRasterizer8::Chunk* first;
-
-    // ------------------------------------------------------------------------
-    // [Advance Clip-Box]
-    // ------------------------------------------------------------------------
-
-    // Skip boxes which do not intersect in vertical direction.
-    while (cPtr->y1 <= y0)
-    {
-      if (++cPtr == cEnd)
-        return;
-    }
-
-    // Skip boxes which do not intersect in horizontal direction.
-    while (cPtr->x1 <= xMin)
-    {
-      if (++cPtr == cEnd)
-        return;
-    }
-
-    if (cPtr->x0 >= xEnd)
-    {
-      do {
-        if (++cPtr == cEnd)
-          return;
-      } while (cPtr->x0 >= xEnd);
-      continue;
-    }
+  do {
+    // Find the end of the current band.
+    const BoxI* bandPtr = cPtr;
+    int y0 = cPtr->y0;
+    int y1 = cPtr->y1;
 
-    y0 = cPtr->y0;
-    if (y0 >= yEnd)
+    if (y0 >= box.y1)
       return;
 
-    // Save start of the current band and find the end. We limit the end to the
-    // last band which can be processed. If some clip rectangle is completely
-    // outside of the shape bounding box, then the band won't be included in
-    // cBandStart...cBandEnd list.
-    //
-    // NOTE: Like all other pointers, cBandEnd contains the first band which is
-    // invalid.
-    cBandStart = cPtr;
-    cBandEnd = cPtr;
-
-    while (++cBandEnd != cEnd && cBandEnd->y0 == y0 && cBandEnd->x0 < xEnd)
+    while (++cPtr != cEnd && cPtr->y0 == y0)
       continue;
 
-    if (y0 < yMin)
-      y0 = yMin;
-
-    y1 = cPtr->y1;
-    if (y1 > yEnd)
-      y1 = yEnd;
-
-    FOG_ASSERT(y0 != y1);
-    goto _LoopRow;
-
-    // ------------------------------------------------------------------------
-    // [Merge / Skip]
-    // ------------------------------------------------------------------------
-
-_NextRow:
-    if (++y0 == y1)
-    {
-      cPtr = cBandEnd;
-      goto _NextBand;
-    }
-    cPtr = cBandStart;
+    if (y0 < box.y0) y0 = box.y0;
+    if (y1 > box.y1) y1 = box.y1;
 
-_LoopRow:
-    for (;;)
+    for (int y = y0; y < y1; y++)
     {
-      first = rows[y0].first;
-      if (first != NULL)
-        break;
+      size_t rowIndex = (size_t)(uint)(y - yBase);
+      const HairlineRasterizer8::Row& row = self->_rowsStorage[rowIndex];
 
-      if (++y0 == y1)
-      {
-        cPtr = cBandEnd;
-        goto _NextBand;
-      }
-    }
+      if (row.x0 >= row.x1)
+        continue;
 
-    VERIFY_CHUNKS_8(first);
+      const uint16_t* cells = self->_cellsStorage + rowIndex * stride;
+      RasterSpan8* span = scanline->begin();
 
-    // ------------------------------------------------------------------------
-    // [Fetch]
-    // ------------------------------------------------------------------------
+      for (const BoxI* b = bandPtr; b != cPtr; b++)
+      {
+        int i0 = Math::max<int>(row.x0, b->x0 - xBase);
+        int i1 = Math::min<int>(row.x1, b->x1 - xBase);
 
-    RasterSpan8* span = scanline->begin();
-    uint8_t* mask = scanline->getMask();
+        if (i0 >= i1)
+          continue;
 
-    PathRasterizer8::Chunk* chunk = first;
-    PathRasterizer8::Cell* cell = chunk->cells;
+        span = HairlineRasterizer8_buildSpans(scanline, span, cells, xBase, i0, i1);
+        if (FOG_IS_NULL(span))
+          return;
+      }
 
-    int x0 = chunk->x0;
-    int x1 = chunk->x1;
-  
-    int cover = 0;
-    uint32_t alpha = 0;
+      span = scanline->end(span);
+      if (span == NULL)
+        continue;
 
-    int xc;
-    int xLocalEnd;
+      if (yPos != y)
+        filler->_skip(filler, y - yPos);
 
-    // Skip clip rectangles which do not intersect with the current chunk.
-    while (x0 >= cPtr->x1)
-    {
-_AdvanceClip:
-      if (++cPtr == cBandEnd)
-        goto _Fill;
+      filler->_process(filler, span);
+      yPos = y + 1;
     }
+  } while (cPtr != cEnd);
+}
 
-    // Skip cells which do not intersect with the current clip rectangle.
-    xc = cPtr->x0;
-    if (x0 < xc)
-    {
-_SkipCells:
-      xLocalEnd = Math::min<int>(xc, x1);
-      FOG_ASSERT(xLocalEnd != 0);
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Render - Clip-Mask]
+// ============================================================================
 
-      do {
-        cover += cell->cover;
-        cell++;
-      } while (++x0 != xLocalEnd);
+static void FOG_CDECL HairlineRasterizer8_render_st_clip_mask(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
 
-      if (x0 == x1)
-      {
-        chunk = chunk->next;
-        if (chunk == first)
-          goto _Fill;
+  HairlineRasterizer8_render_st_clip_box(_self, &proxy, scanline);
+}
 
-        cell = chunk->cells;
-        x0 = chunk->x0;
-        x1 = chunk->x1;
+// ============================================================================
+// [Fog::HairlineRasterizer8 - Finalize]
+// ============================================================================
 
-        if (x0 < xc)
-          goto _SkipCells;
-      }
-      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
-    }
-    FOG_ASSERT(x0 >= xc);
+err_t HairlineRasterizer8::finalize()
+{
+  // If already finalized this is the NOP.
+  if (_error != ERR_OK || _isFinalized)
+    return _error;
 
-    if (alpha == 0)
-    {
-      // Skip clip rectangles which do not intersect with the current chunk.
-      if (x0 >= cPtr->x1)
-        goto _AdvanceClip;
+  // If no shape has been added, then the output is not valid.
+  if (_boundingBox.y0 == -1)
+  {
+    _isValid = false;
+    _isFinalized = true;
+    return ERR_OK;
+  }
 
-      if (xc < x0)
-        xc = x0;
-    }
-    else
-    {
-      // Skip part of rectangle which do not intersect with the current chunk,
-      // filling it with const mask.
-      if (xc < x0)
-      {
-        for (;;)
-        {
-_ConstSpan:
-          NEW_SPAN(span, return);
-          span->setX0AndType(xc, RASTER_SPAN_C);
+  // Normalize bounding box to our standard, x1/y1 coordinates are outside.
+  _boundingBox.x1++;
+  _boundingBox.y1++;
 
-          xc = Math::min<int>(x0, cPtr->x1);
-          FOG_ASSERT(span->getX0() < xc);
+  _isValid = true;
+  _isFinalized = true;
 
-          span->setX1(xc);
-          span->setConstMask(alpha);
+  _render = Rasterizer_api.hairline8.render[_clipType];
+  return ERR_OK;
+}
 
-          if (xc == cPtr->x1)
-          {
-            if (++cPtr == cBandEnd)
-              goto _Fill;
-            xc = cPtr->x0;
-            if (xc < x0)
-              continue;
-          }
-          break;
-        }
-      }
-    }
+// ============================================================================
+// [Fog::CoverageRasterizer8 - Init]
+// ============================================================================
 
-    if (x0 < xc)
-      goto _SkipCells;
+static bool FOG_CDECL CoverageRasterizer8_init(CoverageRasterizer8* self, const RasterCoverage* coverage)
+{
+  FOG_ASSERT(self->_clipType < RASTER_CLIP_COUNT);
 
-    FOG_ASSERT(x0 == xc);
-_NewSpan:
-    x0 = Math::min<int>(x1, cPtr->x1);
+  if (!BoxI::intersect(self->_boxBounds, coverage->boundingBox, self->_sceneBox))
+  {
+    self->_initialized = false;
+    return false;
+  }
 
-_NewSpan1:
-    NEW_SPAN(span, return);
-    span->setX0AndType(xc, RASTER_SPAN_AX_EXTRA); 
-    span->setVariantMask(mask);
+  self->_initialized = true;
+  self->_coverage = coverage;
 
-_ContinueSpan:
-    do {
-      cover += cell->cover;
-      alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover - (cell->area >> A8_SHIFT_2));
-      
-      Acc::p16Store2a(mask, static_cast<uint16_t>(alpha));
-      mask += 2;
+  self->_render = Rasterizer_api.coverage8.render[self->_clipType];
+  return true;
+}
 
-      cell++;
-    } while (++xc != x0);
-    span->setX1(xc);
+// ============================================================================
+// [Fog::CoverageRasterizer8 - Render - Helpers]
+// ============================================================================
 
-    if (xc == x1)
-    {
-      chunk = chunk->next;
-      if (chunk == first)
-        goto _Fill;
+//! @internal
+//!
+//! @brief Build spans from the runs [p, pEnd) of one row clipped to the
+//! [cx0, cx1) range.
+//!
+//! If opacity is used the variant runs are multiplied into the @a mask buffer,
+//! which is advanced, otherwise the spans point directly to the coverage.
+static FOG_INLINE RasterSpan8* CoverageRasterizer8_buildSpans(RasterScanline8* scanline,
+  RasterSpan8* span, uint16_t*& mask, const uint16_t* p, const uint16_t* pEnd,
+  int xBase, int cx0, int cx1, uint32_t opacity)
+{
+  while (p < pEnd)
+  {
+    int x0 = xBase + p[0];
+    uint32_t w = p[1];
+    const uint16_t* v = p + 2;
+
+    bool isConst = (w & RASTER_COVERAGE_RUN_CONST) != 0;
+    w &= RASTER_COVERAGE_RUN_WIDTH;
 
-      cell = chunk->cells;
-      x0 = chunk->x0;
-      x1 = chunk->x1;
+    p = v + (isConst ? 1 : w);
+    int x1 = x0 + (int)w;
 
-      if (xc == cPtr->x1)
-      {
-        // If alpha is zero, we can jump into _AdvanceClip loop, which efficiently
-        // discards all clipped rectangles. Otherwise we need to create const-mask
-        // spans, because of non-zero alpha.
-        alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
-        if (alpha == 0)
-          goto _AdvanceClip;
+    if (x1 <= cx0)
+      continue;
+    if (x0 >= cx1)
+      break;
 
-_AdvanceClipAlphaNonZero:
-        if (++cPtr == cBandEnd)
-          goto _Fill;
+    int sx0 = Math::max<int>(x0, cx0);
+    int sx1 = Math::min<int>(x1, cx1);
 
-        xc = cPtr->x0;
-        if (xc < x0)
-          goto _ConstSpan;
+    if (isConst)
+    {
+      uint32_t alpha = v[0];
+      if (opacity != 0x100)
+        alpha = (alpha * opacity) >> 8;
 
-        if (xc > x0)
-          goto _SkipCells;
-      }
+      if (alpha == 0)
+        continue;
 
-      if (xc == x0)
+      NEW_SPAN(span, return NULL);
+      span->setPositionAndType(sx0, sx1, RASTER_SPAN_C);
+      span->setConstMask(alpha);
+    }
+    else
+    {
+      v += (uint)(sx0 - x0);
+
+      NEW_SPAN(span, return NULL);
+      span->setPositionAndType(sx0, sx1, RASTER_SPAN_AX_EXTRA);
+
+      if (opacity == 0x100)
       {
-        x0 = Math::min<int>(x1, cPtr->x1);
-        if (span->getX1() != x0 || span->getType() != RASTER_SPAN_AX_EXTRA)
-          goto _NewSpan1;
-        else
-          goto _ContinueSpan;
+        span->setVariantMask(reinterpret_cast<uint8_t*>(const_cast<uint16_t*>(v)));
       }
       else
       {
-        uint len = Math::min<int>(x0, cPtr->x1) - xc;
-        alpha = PathRasterizer8_calculateAlpha<_RULE, _USE_ALPHA>(self, cover);
+        uint i = (uint)(sx1 - sx0);
+        span->setVariantMask(reinterpret_cast<uint8_t*>(mask));
 
-        if (alpha == 0)
-        {
-          xc += len;
-          if (xc == cPtr->x1)
-            goto _AdvanceClip;
-          else
-            goto _NewSpan;
-        }
-  
-        if (len <= RASTER_SPAN_C_THRESHOLD)
-        {
-          // The same optimization as in render_st_clip_box(), see comment there.
-          FOG_ASSERT(RASTER_SPAN_C_THRESHOLD <= 4);
+        do {
+          mask[0] = (uint16_t)((uint32_t(v[0]) * opacity) >> 8);
+          mask++;
+          v++;
+        } while (--i);
+      }
+    }
+  }
 
-          xc += len;
-          span->setX1(xc);
+  return span;
+}
 
-#if FOG_ARCH_BITS >= 64 && defined(FOG_ARCH_UNALIGNED_ACCESS_64)
-          Acc::p64Store8u(mask,
-            (uint64_t)alpha * FOG_UINT64_C(0x0001000100010001));
-          mask += len * 2;
-#elif FOG_ARCH_BITS >= 32 && defined(FOG_ARCH_UNALIGNED_ACCESS_32)
-          alpha *= 0x00010001;
-          Acc::p32Store4u(mask + 0, alpha);
-          Acc::p32Store4u(mask + 4, alpha);
-          mask += len * 2;
-#else
-          // Unoptimized case.
-          do {
-            Acc::p32Store2a(mask, alpha);
-            mask += 2;
-          } while (--len);
-#endif
+// ============================================================================
+// [Fog::CoverageRasterizer8 - Render - Clip-Box]
+// ============================================================================
 
-          if (xc == cPtr->x1)
-            goto _AdvanceClipAlphaNonZero;
+static void FOG_CDECL CoverageRasterizer8_render_st_clip_box(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  CoverageRasterizer8* self = static_cast<CoverageRasterizer8*>(_self);
+  FOG_ASSERT(self->_initialized);
 
-          FOG_ASSERT(xc < cPtr->x1);
-          FOG_ASSERT(xc == x0);
+  const RasterCoverage* coverage = self->_coverage;
+  const BoxI& box = self->_boxBounds;
 
-          x0 = Math::min<int>(x1, cPtr->x1);
-          goto _ContinueSpan;
-        }
-        else
-        {
-          NEW_SPAN(span, return);
-          span->setX0AndType(xc, RASTER_SPAN_C);
-          xc += len;
-          span->setX1(xc);
-          span->setConstMask(alpha);
+  int y0 = box.y0;
+  int y1 = box.y1;
+  int xBase = coverage->xBase;
+  uint32_t opacity = self->_opacity;
 
-          if (xc != cPtr->x1)
-          {
-            FOG_ASSERT(xc < cPtr->x1);
-            FOG_ASSERT(xc == x0);
-            goto _NewSpan;
-          }
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
 
-          goto _AdvanceClipAlphaNonZero;
-        }
-      }
-    }
-    else
-    {
-      if (alpha == 0)
-        goto _AdvanceClip;
-      else
-        goto _AdvanceClipAlphaNonZero;
-    }
+  if (opacity != 0x100 && FOG_IS_ERROR(scanline->prepare((size_t)box.getWidth() * 2)))
+    return;
 
-    // ------------------------------------------------------------------------
-    // [Fill / Skip]
-    // ------------------------------------------------------------------------
+  filler->prepare(y0);
+
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
+
+  for (;;)
+  {
+    uint16_t* mask = reinterpret_cast<uint16_t*>(scanline->getMask());
+    RasterSpan8* span = scanline->begin();
+
+    span = CoverageRasterizer8_buildSpans(scanline, span, mask,
+      coverage->getRow(y0), coverage->getRowEnd(y0), xBase, box.x0, box.x1, opacity);
+    if (FOG_IS_NULL(span))
+      return;
 
-_Fill:
     span = scanline->end(span);
-    if (span != NULL)
+
+    if (FOG_IS_NULL(span))
+    {
+      filler->skip(1);
+    }
+    else
     {
 #if defined(FOG_DEBUG_RASTERIZER)
       Rasterizer_dumpSpans(y0, scanline->getSpans());
 #endif // FOG_DEBUG_RASTERIZER
-
-      if (yPos != y0)
-        filler->skip(y0 - yPos);
-      yPos = y0 + 1;
-
       filler->process(span);
     }
-    goto _NextRow;
+
+    if (++y0 >= y1)
+      return;
   }
 }
 
 // ============================================================================
-// [Fog::PathRasterizer8 - Render - Clip-Mask]
+// [Fog::CoverageRasterizer8 - Render - Clip-Region]
 // ============================================================================
 
-template<int _RULE, int _USE_ALPHA>
-static void FOG_CDECL PathRasterizer8_render_st_clip_mask(
+static void FOG_CDECL CoverageRasterizer8_render_st_clip_region(
   Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
 {
-  // TODO: Rasterizer - clip-mask
-  PathRasterizer8* self = static_cast<PathRasterizer8*>(_self);
-}
+  CoverageRasterizer8* self = static_cast<CoverageRasterizer8*>(_self);
+  FOG_ASSERT(self->_initialized);
 
-// ============================================================================
-// [Fog::PathRasterizer8 - Finalize]
-// ============================================================================
+  const RasterCoverage* coverage = self->_coverage;
+  const BoxI& box = self->_boxBounds;
 
-err_t PathRasterizer8::finalize()
-{
-  PathRasterizer8* self = this;
+  const BoxI* cPtr = self->_clip.region.data;
+  const BoxI* cEnd = cPtr + self->_clip.region.length;
 
-  // If already finalized this is the NOP.
-  if (_error != ERR_OK || _isFinalized)
-    return _error;
+  int xBase = coverage->xBase;
+  uint32_t opacity = self->_opacity;
 
-  // If no shape has been added, then the output is not valid.
-  if (_boundingBox.y0 == -1)
-    goto _NotValid;
+  // --------------------------------------------------------------------------
+  // [Prepare]
+  // --------------------------------------------------------------------------
 
-  // Normalize bounding box to our standard, x1/y1 coordinates are outside.
-  _boundingBox.x1++;
-  _boundingBox.y1++;
+  // Skip boxes which do not intersect in vertical direction.
+  while (cPtr->y1 <= box.y0)
+  {
+    if (++cPtr == cEnd)
+      return;
+  }
 
-  // Small tolerance here due to the floating point arithmetic. Sweep scanline
-  // never return anything beyond the bounding box.
-  FOG_ASSERT(_boundingBox.x1 <= _sceneBox.x1 + 1);
-  FOG_ASSERT(_boundingBox.y1 <= _sceneBox.y1 + 1);
+  if (cPtr->y0 >= box.y1)
+    return;
 
-  if (_boundingBox.x1 > _sceneBox.x1) _boundingBox.x1 = _sceneBox.x1;
-  if (_boundingBox.y1 > _sceneBox.y1) _boundingBox.y1 = _sceneBox.y1;
+  if (opacity != 0x100 && FOG_IS_ERROR(scanline->prepare((size_t)box.getWidth() * 2)))
+    return;
 
-  // We added small tolerance to the rasterizer because of floating point based
-  // clipping, but if there is no bounding box (due to correction above) then
-  // there is no shape.
-  _isValid = (_boundingBox.x0 != _boundingBox.x1 &&
-              _boundingBox.y0 != _boundingBox.y1);
-  _isFinalized = true;
+  int yPos = Math::max<int>(cPtr->y0, box.y0);
+  filler->prepare(yPos);
 
-  // Setup render method.
-  if (self->_fillRule == FILL_RULE_NON_ZERO)
-    self->_render = Rasterizer_api.path8.render_nonzero[self->_opacity != 0x100][self->_clipType];
-  else
-    self->_render = Rasterizer_api.path8.render_evenodd[self->_opacity != 0x100][self->_clipType];
-  return ERR_OK;
+  // --------------------------------------------------------------------------
+  // [Process]
+  // --------------------------------------------------------------------------
 
-_NotValid:
-  _isValid = false;
-  _isFinalized = true;
-  return ERR_OK;
+  do {
+    // Find the end of the current band.
+    const BoxI* bandPtr = cPtr;
+    int y0 = cPtr->y0;
+    int y1 = cPtr->y1;
 
-#undef SETUP_FUNCS
+    if (y0 >= box.y1)
+      return;
+
+    while (++cPtr != cEnd && cPtr->y0 == y0)
+      continue;
+
+    if (y0 < box.y0) y0 = box.y0;
+    if (y1 > box.y1) y1 = box.y1;
+
+    for (int y = y0; y < y1; y++)
+    {
+      const uint16_t* pRow = coverage->getRow(y);
+      const uint16_t* pEnd = coverage->getRowEnd(y);
+
+      if (pRow == pEnd)
+        continue;
+
+      uint16_t* mask = reinterpret_cast<uint16_t*>(scanline->getMask());
+      RasterSpan8* span = scanline->begin();
+
+      for (const BoxI* b = bandPtr; b != cPtr; b++)
+      {
+        int cx0 = Math::max<int>(box.x0, b->x0);
+        int cx1 = Math::min<int>(box.x1, b->x1);
+
+        if (cx0 >= cx1)
+          continue;
+
+        span = CoverageRasterizer8_buildSpans(scanline, span, mask,
+          pRow, pEnd, xBase, cx0, cx1, opacity);
+        if (FOG_IS_NULL(span))
+          return;
+      }
+
+      span = scanline->end(span);
+      if (span == NULL)
+        continue;
+
+      if (yPos != y)
+        filler->_skip(filler, y - yPos);
+
+      filler->_process(filler, span);
+      yPos = y + 1;
+    }
+  } while (cPtr != cEnd);
+}
+
+// ============================================================================
+// [Fog::CoverageRasterizer8 - Render - Clip-Mask]
+// ============================================================================
+
+static void FOG_CDECL CoverageRasterizer8_render_st_clip_mask(
+  Rasterizer8* _self, RasterFiller* filler, RasterScanline8* scanline)
+{
+  RasterClipMaskFiller8 proxy;
+  if (!Rasterizer8_initClipMaskFiller(_self, &proxy, filler))
+    return;
+
+  CoverageRasterizer8_render_st_clip_box(_self, &proxy, scanline);
 }
 
 FOG_NO_EXPORT void Rasterizer_init(void)
@@ -3151,6 +5460,44 @@ FOG_NO_EXPORT void Rasterizer_init(void)
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_BOX   ] = PathRasterizer8_render_st_clip_box   <FILL_RULE_EVEN_ODD, 1>;
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_REGION] = PathRasterizer8_render_st_clip_region<FILL_RULE_EVEN_ODD, 1>;
   Rasterizer_api.path8.render_evenodd[1][RASTER_CLIP_MASK  ] = PathRasterizer8_render_st_clip_mask  <FILL_RULE_EVEN_ODD, 1>;
+
+  Rasterizer_api.path8.render_dense_nonzero[0][0] = PathRasterizer8_render_dense_st_clip_box <FILL_RULE_NON_ZERO, 0>;
+  Rasterizer_api.path8.render_dense_nonzero[0][1] = PathRasterizer8_render_dense_st_clip_mask<FILL_RULE_NON_ZERO, 0>;
+  Rasterizer_api.path8.render_dense_nonzero[1][0] = PathRasterizer8_render_dense_st_clip_box <FILL_RULE_NON_ZERO, 1>;
+  Rasterizer_api.path8.render_dense_nonzero[1][1] = PathRasterizer8_render_dense_st_clip_mask<FILL_RULE_NON_ZERO, 1>;
+
+  Rasterizer_api.path8.render_dense_evenodd[0][0] = PathRasterizer8_render_dense_st_clip_box <FILL_RULE_EVEN_ODD, 0>;
+  Rasterizer_api.path8.render_dense_evenodd[0][1] = PathRasterizer8_render_dense_st_clip_mask<FILL_RULE_EVEN_ODD, 0>;
+  Rasterizer_api.path8.render_dense_evenodd[1][0] = PathRasterizer8_render_dense_st_clip_box <FILL_RULE_EVEN_ODD, 1>;
+  Rasterizer_api.path8.render_dense_evenodd[1][1] = PathRasterizer8_render_dense_st_clip_mask<FILL_RULE_EVEN_ODD, 1>;
+
+  // --------------------------------------------------------------------------
+  // [Fog::MaskRasterizer8]
+  // --------------------------------------------------------------------------
+
+  Rasterizer_api.mask8.init = MaskRasterizer8_init;
+
+  Rasterizer_api.mask8.render[RASTER_CLIP_BOX   ] = MaskRasterizer8_render_st_clip_box;
+  Rasterizer_api.mask8.render[RASTER_CLIP_REGION] = MaskRasterizer8_render_st_clip_region;
+  Rasterizer_api.mask8.render[RASTER_CLIP_MASK  ] = MaskRasterizer8_render_st_clip_mask;
+
+  // --------------------------------------------------------------------------
+  // [Fog::HairlineRasterizer8]
+  // --------------------------------------------------------------------------
+
+  Rasterizer_api.hairline8.render[RASTER_CLIP_BOX   ] = HairlineRasterizer8_render_st_clip_box;
+  Rasterizer_api.hairline8.render[RASTER_CLIP_REGION] = HairlineRasterizer8_render_st_clip_region;
+  Rasterizer_api.hairline8.render[RASTER_CLIP_MASK  ] = HairlineRasterizer8_render_st_clip_mask;
+
+  // --------------------------------------------------------------------------
+  // [Fog::CoverageRasterizer8]
+  // --------------------------------------------------------------------------
+
+  Rasterizer_api.coverage8.init = CoverageRasterizer8_init;
+
+  Rasterizer_api.coverage8.render[RASTER_CLIP_BOX   ] = CoverageRasterizer8_render_st_clip_box;
+  Rasterizer_api.coverage8.render[RASTER_CLIP_REGION] = CoverageRasterizer8_render_st_clip_region;
+  Rasterizer_api.coverage8.render[RASTER_CLIP_MASK  ] = CoverageRasterizer8_render_st_clip_mask;
 }
 
 } // Fog namespace
@@ -58,7 +58,44 @@ struct FOG_NO_EXPORT RasterizerApi
   {
     Render8Func render_nonzero[2][RASTER_CLIP_COUNT];
     Render8Func render_evenodd[2][RASTER_CLIP_COUNT];
+
+    //! @brief Dense accumulation renderers, indexed by [useAlpha][isClipMask].
+    Render8Func render_dense_nonzero[2][2];
+    Render8Func render_dense_evenodd[2][2];
   } path8;
+
+  // --------------------------------------------------------------------------
+  // [Mask]
+  // --------------------------------------------------------------------------
+
+  typedef void (FOG_CDECL *MaskRasterizer8_Init)(MaskRasterizer8* self, const BoxI* box, const uint8_t* maskPixels, ssize_t maskStride, uint32_t maskFormat);
+
+  struct _Api_MaskRasterizer8
+  {
+    MaskRasterizer8_Init init;
+    Render8Func render[RASTER_CLIP_COUNT];
+  } mask8;
+
+  // --------------------------------------------------------------------------
+  // [Hairline]
+  // --------------------------------------------------------------------------
+
+  struct _Api_HairlineRasterizer8
+  {
+    Render8Func render[RASTER_CLIP_COUNT];
+  } hairline8;
+
+  // --------------------------------------------------------------------------
+  // [Coverage]
+  // --------------------------------------------------------------------------
+
+  typedef bool (FOG_CDECL *CoverageRasterizer8_Init)(CoverageRasterizer8* self, const RasterCoverage* coverage);
+
+  struct _Api_CoverageRasterizer8
+  {
+    CoverageRasterizer8_Init init;
+    Render8Func render[RASTER_CLIP_COUNT];
+  } coverage8;
 };
 
 extern FOG_NO_EXPORT RasterizerApi Rasterizer_api;
@@ -121,12 +158,18 @@ struct FOG_NO_EXPORT Rasterizer8
     _clip.region.length = length;
   }
 
-  FOG_INLINE void setClipMask(int y0, int y1, const RasterSpan8** spans)
+  //! @brief Set clip-mask.
+  //!
+  //! The @a spans are clip-mask scanlines adjusted so the index is an absolute
+  //! y coordinate, the @a scanline is used to build the spans intersected with
+  //! the clip-mask (it must be different to the scanline passed to render()).
+  FOG_INLINE void setClipMask(int y0, int y1, const RasterSpan8* const* spans, RasterScanline8* scanline)
   {
     _clipType = RASTER_CLIP_MASK;
     _clip.mask.y0 = y0;
     _clip.mask.y1 = y1;
     _clip.mask.spans = spans;
+    _clip.mask.scanline = scanline;
   }
 
   // --------------------------------------------------------------------------
@@ -190,7 +233,8 @@ struct FOG_NO_EXPORT Rasterizer8
 
   struct FOG_NO_EXPORT _ClipMask : public _ClipBase
   {
-    const RasterSpan8** spans;
+    const RasterSpan8* const* spans;
+    RasterScanline8* scanline;
   };
 
   union
@@ -274,6 +318,73 @@ struct FOG_NO_EXPORT BoxRasterizer8 : public Rasterizer8
   };
 };
 
+// ============================================================================
+// [Fog::MaskRasterizer8]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Scanline rasterizer, which converts rows of the mask image into
+//! spans.
+//!
+//! The alpha channel of the mask is used as a coverage. Rows of the A8 mask
+//! are passed to the filler as @c RASTER_SPAN_A8_GLYPH spans pointing directly
+//! to the mask pixels (if opacity is not used), other formats are converted
+//! row by row into the scanline mask buffer. Formats without alpha channel
+//! are rasterized as a box.
+struct FOG_NO_EXPORT MaskRasterizer8 : public Rasterizer8
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE MaskRasterizer8()
+  {
+  }
+
+  FOG_INLINE ~MaskRasterizer8()
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Setup]
+  // --------------------------------------------------------------------------
+
+  //! @brief Initialize the rasterizer.
+  //!
+  //! The @a box must be already clipped to the scene-box and @a maskPixels
+  //! must point to the first pixel of the mask which is mapped to the top-left
+  //! corner of the @a box.
+  FOG_INLINE void init(const BoxI& box, const uint8_t* maskPixels, ssize_t maskStride, uint32_t maskFormat)
+  {
+    Rasterizer_api.mask8.init(this, &box, maskPixels, maskStride, maskFormat);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    _initialized = false;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Box to fill.
+  BoxI _boxBounds;
+
+  //! @brief Mask pixels (alpha channel of the pixel at the _boxBounds x0/y0).
+  const uint8_t* _maskPixels;
+  //! @brief Mask stride.
+  ssize_t _maskStride;
+  //! @brief Distance between two alpha values in the mask row, zero if the
+  //! mask has no alpha channel.
+  uint32_t _maskBpp;
+};
+
 // ============================================================================
 // [Fog::PathRasterizer8]
 // ============================================================================
@@ -405,6 +516,15 @@ struct FOG_NO_EXPORT BoxRasterizer8 : public Rasterizer8
 //! the new coverage and area is merged to the existing cell (that is, there
 //! are no overlapping cells in the final result).
 //!
+//! Small shapes (glyphs, icons, markers) are rasterized into a dense buffer
+//! of cover/area values instead of chunk lists. The mode is selected by the
+//! rasterizer when the first path is added and its control-points bounding
+//! box fits into 256x256 pixels (region clipping is not supported in dense
+//! mode). If a path added later doesn't fit, the dense buffer is converted
+//! to chunks and the rasterization continues in the default mode. The dense
+//! buffer is swept by a prefix-sum of covers which doesn't need any chunk
+//! management.
+//!
 //! The analytic rasterizer idea and first implementation was based on the AGG,
 //! which was based on the freetype2 library. Although there is motivation the
 //! rasterizer was rewritten to use different algorithm to render-line/hline
@@ -570,6 +690,8 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   FOG_INLINE uint8_t isValid() const { return _isValid; }
   //! @brief Get whether the rasterizer is finalized.
   FOG_INLINE uint8_t isFinalized() const { return _isFinalized; }
+  //! @brief Get whether the rasterizer uses the dense accumulation buffer.
+  FOG_INLINE uint8_t isDense() const { return _isDense; }
 
   // --------------------------------------------------------------------------
   // [Reset]
@@ -617,6 +739,23 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   //! @internal
   bool getNextChunkStorage(size_t chunkSize);
 
+  // --------------------------------------------------------------------------
+  // [Dense]
+  // --------------------------------------------------------------------------
+
+  //! @internal
+  //!
+  //! @brief Switch to the dense mode, @a box24x8 is the bounding box of all
+  //! vertices which will be rasterized.
+  //!
+  //! Returns @c false if the box is too large or the buffer can't be allocated.
+  bool initDense(const BoxI& box24x8);
+
+  //! @internal
+  //!
+  //! @brief Convert the dense buffer into cell chunks and leave dense mode.
+  err_t denseToChunks();
+
   // --------------------------------------------------------------------------
   // [Finalize]
   // --------------------------------------------------------------------------
@@ -652,6 +791,8 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   uint8_t _isValid;
   //! @brief Whether the rasterizer was finalized.
   uint8_t _isFinalized;
+  //! @brief Whether the dense accumulation buffer is used instead of chunks.
+  uint8_t _isDense;
 
   //! @brief Rows array capacity.
   //!
@@ -673,10 +814,276 @@ struct FOG_NO_EXPORT PathRasterizer8 : public Rasterizer8
   //! subtracting @c _sceneBox.y0 from @c _rowsStorage.
   Row* _rowsAdjusted;
 
+  //! @brief Dense buffer box (x1/y1 coordinates are outside).
+  BoxI _denseBox;
+  //! @brief Dense buffer stride (in cells), equal to the _denseBox width.
+  int _denseStride;
+  //! @brief Dense buffer capacity (in cells).
+  uint32_t _denseCapacity;
+
+  //! @brief Dense buffer storage (covers followed by areas).
+  int* _denseStorage;
+  //! @brief Dense covers (points to _denseStorage).
+  int* _denseCover;
+  //! @brief Dense areas (points after all covers in _denseStorage).
+  int* _denseArea;
+
 private:
   FOG_NO_COPY(PathRasterizer8)
 };
 
+// ============================================================================
+// [Fog::HairlineRasterizer8]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Anti-aliased hairline rasterizer (8-bit).
+//!
+//! The hairline rasterizer is used to stroke thin lines (up to about 1.5
+//! pixels in device space). Instead of stroking the path into an outline and
+//! rasterizing both of its edges by @ref PathRasterizer8, the coverage is
+//! computed directly from the flattened centerline. The coverage of each
+//! pixel is the overlap of the pixel with the line of a given width measured
+//! perpendicularly to the segment; overlapping segments are combined by
+//! max() so joins and self-intersections are not accumulated twice.
+//!
+//! Joins are always round, round caps are computed by the distance to the
+//! end-point and other caps are approximated by a butt cap extended by the
+//! average length of the cap (square caps by half of the line width, etc).
+//!
+//! The coverage is accumulated into a buffer of 16-bit cells covering the
+//! bounding box of the path (clipped to the scene-box), each row of the
+//! buffer remembers its dirty range so only the touched cells are rendered
+//! and cleared.
+struct FOG_NO_EXPORT HairlineRasterizer8 : public Rasterizer8
+{
+  // --------------------------------------------------------------------------
+  // [Row]
+  // --------------------------------------------------------------------------
+
+  struct FOG_NO_EXPORT Row
+  {
+    //! @brief First dirty cell.
+    int x0;
+    //! @brief Last dirty cell + 1 (if x0 >= x1 then the row is empty).
+    int x1;
+  };
+
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  //! @brief Create a @ref HairlineRasterizer8 instance.
+  HairlineRasterizer8();
+  //! @brief Destroy the @ref HairlineRasterizer8 instance.
+  ~HairlineRasterizer8();
+
+  // --------------------------------------------------------------------------
+  // [Bounding Box]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get rasterized object bounding box.
+  //!
+  //! @note This method is only valid after @c finalize() call.
+  FOG_INLINE const BoxI& getBoundingBox() const { return _boundingBox; }
+
+  // --------------------------------------------------------------------------
+  // [Error]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the rasterizer error.
+  FOG_INLINE err_t getError() const { return _error; }
+  //! @brief Set the rasterizer error.
+  FOG_INLINE void setError(err_t error) { _error = error; }
+
+  // --------------------------------------------------------------------------
+  // [Line Params]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get the line width (in device units).
+  FOG_INLINE double getLineWidth() const { return _lineWidth; }
+  //! @brief Set the line width (in device units).
+  FOG_INLINE void setLineWidth(double lineWidth) { _lineWidth = lineWidth; }
+
+  //! @brief Get the start cap, see @ref LINE_CAP.
+  FOG_INLINE uint32_t getStartCap() const { return _startCap; }
+  //! @brief Get the end cap, see @ref LINE_CAP.
+  FOG_INLINE uint32_t getEndCap() const { return _endCap; }
+
+  //! @brief Set the start and end cap, see @ref LINE_CAP.
+  FOG_INLINE void setLineCaps(uint32_t startCap, uint32_t endCap)
+  {
+    _startCap = (uint8_t)startCap;
+    _endCap = (uint8_t)endCap;
+  }
+
+  // --------------------------------------------------------------------------
+  // [State]
+  // --------------------------------------------------------------------------
+
+  //! @brief Get whether the rasterizer is valid.
+  FOG_INLINE uint8_t isValid() const { return _isValid; }
+  //! @brief Get whether the rasterizer is finalized.
+  FOG_INLINE uint8_t isFinalized() const { return _isFinalized; }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  //! @brief Reset.
+  void reset();
+
+  // --------------------------------------------------------------------------
+  // [Init]
+  // --------------------------------------------------------------------------
+
+  //! @brief Initialize the rasterizer, called after setup methods (scene-box,
+  //! clip, opacity and line params) and before adding the path.
+  err_t init();
+
+  // --------------------------------------------------------------------------
+  // [Add]
+  // --------------------------------------------------------------------------
+
+  //! @brief Add a flattened path (in device space) to the rasterizer (float).
+  //!
+  //! @note The cell buffer is sized by the bounding box of the path, so only
+  //! one path can be added after @c init().
+  void addPath(const PathF& path, const PointF& offset);
+  //! @brief Add a flattened path (in device space) to the rasterizer (double).
+  //!
+  //! @note The cell buffer is sized by the bounding box of the path, so only
+  //! one path can be added after @c init().
+  void addPath(const PathD& path, const PointD& offset);
+
+  // --------------------------------------------------------------------------
+  // [Cells]
+  // --------------------------------------------------------------------------
+
+  //! @internal
+  //!
+  //! @brief Prepare the cell buffer for the @a box (clipped to the scene-box).
+  bool initCells(const BoxI& box);
+
+  //! @internal
+  //!
+  //! @brief Clear all dirty cells.
+  void clearCells();
+
+  // --------------------------------------------------------------------------
+  // [Finalize]
+  // --------------------------------------------------------------------------
+
+  //! @brief Finalize, called after @c addPath().
+  err_t finalize();
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief bounding box of the rasterized shape.
+  BoxI _boundingBox;
+
+  //! @brief Line width (in device units).
+  double _lineWidth;
+
+  //! @brief Rasterizer error.
+  err_t _error;
+
+  //! @brief Start cap.
+  uint8_t _startCap;
+  //! @brief End cap.
+  uint8_t _endCap;
+  //! @brief Whether the rasterizer is valid.
+  uint8_t _isValid;
+  //! @brief Whether the rasterizer was finalized.
+  uint8_t _isFinalized;
+
+  //! @brief Cell buffer box (x1/y1 coordinates are outside).
+  BoxI _cellsBox;
+  //! @brief Cell buffer stride (in cells), equal to the _cellsBox width.
+  int _cellsStride;
+  //! @brief Cell buffer capacity (in cells).
+  size_t _cellsCapacity;
+  //! @brief Rows array capacity.
+  uint32_t _rowsCapacity;
+
+  //! @brief Cell buffer storage (coverage including opacity, 0 to 0x100).
+  //!
+  //! Cells outside of the dirty ranges are always zero.
+  uint16_t* _cellsStorage;
+  //! @brief Dirty ranges of the cell buffer rows.
+  Row* _rowsStorage;
+
+private:
+  FOG_NO_COPY(HairlineRasterizer8)
+};
+
+// ============================================================================
+// [Fog::CoverageRasterizer8]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Scanline rasterizer, which replays the coverage cached by
+//! @ref RasterCoverageCache.
+//!
+//! The runs of the coverage are converted to spans without touching the cell
+//! accumulator. Const runs are passed as const-mask spans and variant runs as
+//! @c RASTER_SPAN_AX_EXTRA spans pointing directly to the coverage data (if
+//! opacity is not used), otherwise the coverage is multiplied by the opacity
+//! into the scanline mask buffer.
+struct FOG_NO_EXPORT CoverageRasterizer8 : public Rasterizer8
+{
+  // --------------------------------------------------------------------------
+  // [Construction / Destruction]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE CoverageRasterizer8()
+  {
+  }
+
+  FOG_INLINE ~CoverageRasterizer8()
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Setup]
+  // --------------------------------------------------------------------------
+
+  //! @brief Initialize the rasterizer, called after setup methods (scene-box,
+  //! clip and opacity).
+  //!
+  //! Returns @c false if the coverage doesn't intersect the scene-box (there
+  //! is nothing to render).
+  FOG_INLINE bool init(const RasterCoverage* coverage)
+  {
+    return Rasterizer_api.coverage8.init(this, coverage);
+  }
+
+  // --------------------------------------------------------------------------
+  // [Reset]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE void reset()
+  {
+    _initialized = false;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Box to fill (the coverage bounding box clipped to the scene-box).
+  BoxI _boxBounds;
+  //! @brief The coverage (not referenced).
+  const RasterCoverage* _coverage;
+
+private:
+  FOG_NO_COPY(CoverageRasterizer8)
+};
+
 //! @}
 
 } // Fog namespace
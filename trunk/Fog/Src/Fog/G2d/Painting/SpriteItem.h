@@ -0,0 +1,178 @@
+// [Fog-G2d]
+//
+// [License]
+// MIT, See COPYING file in package
+
+// [Guard]
+#ifndef _FOG_G2D_PAINTING_SPRITEITEM_H
+#define _FOG_G2D_PAINTING_SPRITEITEM_H
+
+// [Dependencies]
+#include <Fog/Core/Memory/MemOps.h>
+#include <Fog/G2d/Geometry/Point.h>
+#include <Fog/G2d/Geometry/Rect.h>
+
+namespace Fog {
+
+//! @addtogroup Fog_G2d_Painting
+//! @{
+
+// ============================================================================
+// [Fog::SpriteItemI]
+// ============================================================================
+
+//! @brief Sprite item (32-bit integer coordinates), used by
+//! @ref Painter::blitImages().
+//!
+//! The sprite item describes a fragment of the source image (atlas), the
+//! destination rectangle and the opacity the fragment is blitted with. If
+//! the size of the destination rectangle is not the same as the size of the
+//! fragment, the fragment is scaled.
+struct FOG_NO_EXPORT SpriteItemI
+{
+  FOG_INLINE SpriteItemI() :
+    _rect(0, 0, 0, 0),
+    _fragment(0, 0, 0, 0),
+    _opacity(1.0f)
+  {
+  }
+
+  FOG_INLINE SpriteItemI(const PointI& pt, const RectI& fragment, float opacity = 1.0f) :
+    _rect(pt.x, pt.y, fragment.w, fragment.h),
+    _fragment(fragment),
+    _opacity(opacity)
+  {
+  }
+
+  FOG_INLINE SpriteItemI(const RectI& rect, const RectI& fragment, float opacity = 1.0f) :
+    _rect(rect),
+    _fragment(fragment),
+    _opacity(opacity)
+  {
+  }
+
+  explicit FOG_INLINE SpriteItemI(_Uninitialized) :
+    _rect(UNINITIALIZED),
+    _fragment(UNINITIALIZED)
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const RectI& getRect() const { return _rect; }
+  FOG_INLINE const RectI& getFragment() const { return _fragment; }
+  FOG_INLINE float getOpacity() const { return _opacity; }
+
+  FOG_INLINE void setPoint(const PointI& pt) { _rect.setRect(pt.x, pt.y, _fragment.w, _fragment.h); }
+  FOG_INLINE void setRect(const RectI& rect) { _rect = rect; }
+  FOG_INLINE void setFragment(const RectI& fragment) { _fragment = fragment; }
+  FOG_INLINE void setOpacity(float opacity) { _opacity = opacity; }
+
+  //! @brief Get whether the sprite is blitted unscaled.
+  FOG_INLINE bool isUnscaled() const { return _rect.w == _fragment.w && _rect.h == _fragment.h; }
+
+  // --------------------------------------------------------------------------
+  // [Operator Overload]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE SpriteItemI& operator=(const SpriteItemI& other)
+  {
+    MemOps::copy_t<SpriteItemI>(this, &other);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Destination rectangle.
+  RectI _rect;
+  //! @brief Source fragment (in atlas).
+  RectI _fragment;
+  //! @brief Opacity (multiplied by the painter opacity).
+  float _opacity;
+};
+
+// ============================================================================
+// [Fog::SpriteItemF]
+// ============================================================================
+
+//! @brief Sprite item (32-bit float coordinates), used by
+//! @ref Painter::blitImages().
+//!
+//! See @ref SpriteItemI.
+struct FOG_NO_EXPORT SpriteItemF
+{
+  FOG_INLINE SpriteItemF() :
+    _rect(0.0f, 0.0f, 0.0f, 0.0f),
+    _fragment(0, 0, 0, 0),
+    _opacity(1.0f)
+  {
+  }
+
+  FOG_INLINE SpriteItemF(const PointF& pt, const RectI& fragment, float opacity = 1.0f) :
+    _rect(pt.x, pt.y, float(fragment.w), float(fragment.h)),
+    _fragment(fragment),
+    _opacity(opacity)
+  {
+  }
+
+  FOG_INLINE SpriteItemF(const RectF& rect, const RectI& fragment, float opacity = 1.0f) :
+    _rect(rect),
+    _fragment(fragment),
+    _opacity(opacity)
+  {
+  }
+
+  explicit FOG_INLINE SpriteItemF(_Uninitialized) :
+    _rect(UNINITIALIZED),
+    _fragment(UNINITIALIZED)
+  {
+  }
+
+  // --------------------------------------------------------------------------
+  // [Accessors]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE const RectF& getRect() const { return _rect; }
+  FOG_INLINE const RectI& getFragment() const { return _fragment; }
+  FOG_INLINE float getOpacity() const { return _opacity; }
+
+  FOG_INLINE void setPoint(const PointF& pt) { _rect.setRect(pt.x, pt.y, float(_fragment.w), float(_fragment.h)); }
+  FOG_INLINE void setRect(const RectF& rect) { _rect = rect; }
+  FOG_INLINE void setFragment(const RectI& fragment) { _fragment = fragment; }
+  FOG_INLINE void setOpacity(float opacity) { _opacity = opacity; }
+
+  //! @brief Get whether the sprite is blitted unscaled.
+  FOG_INLINE bool isUnscaled() const { return _rect.w == float(_fragment.w) && _rect.h == float(_fragment.h); }
+
+  // --------------------------------------------------------------------------
+  // [Operator Overload]
+  // --------------------------------------------------------------------------
+
+  FOG_INLINE SpriteItemF& operator=(const SpriteItemF& other)
+  {
+    MemOps::copy_t<SpriteItemF>(this, &other);
+    return *this;
+  }
+
+  // --------------------------------------------------------------------------
+  // [Members]
+  // --------------------------------------------------------------------------
+
+  //! @brief Destination rectangle.
+  RectF _rect;
+  //! @brief Source fragment (in atlas).
+  RectI _fragment;
+  //! @brief Opacity (multiplied by the painter opacity).
+  float _opacity;
+};
+
+//! @}
+
+} // Fog namespace
+
+// [Guard]
+#endif // _FOG_G2D_PAINTING_SPRITEITEM_H
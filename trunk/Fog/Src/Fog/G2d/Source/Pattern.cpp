@@ -10,11 +10,33 @@
 
 // [Dependencies]
 #include <Fog/Core/Global/Init_p.h>
+#include <Fog/Core/Threading/Atomic.h>
 #include <Fog/Core/Tools/Var.h>
 #include <Fog/G2d/Source/Pattern.h>
 
 namespace Fog {
 
+// ============================================================================
+// [Fog::Pattern - Helpers]
+// ============================================================================
+
+//! @internal
+//!
+//! @brief Release the cache attached by the paint engine, called when the
+//! pattern data is going to be modified or destroyed.
+//!
+//! The cache can be attached only by a paint engine which registered
+//! @c fog_api.pattern_releaseEngineCache.
+static FOG_INLINE void Pattern_dResetCache(PatternData* d)
+{
+  if (d->engineCache != NULL)
+  {
+    void* cache = atomicPtrXchg<void>(&d->engineCache, NULL);
+    if (cache != NULL)
+      fog_api.pattern_releaseEngineCache(cache);
+  }
+}
+
 // ============================================================================
 // [Fog::Pattern - Construction / Destruction]
 // ============================================================================
@@ -497,6 +519,7 @@ static err_t FOG_CDECL Pattern_createTextureF(Pattern* self, const Texture* text
       pType == (PATTERN_TYPE_TEXTURE | PATTERN_PRECISION_F) &&
       d->reference.get() == 1)
   {
+    Pattern_dResetCache(d);
     d->texture() = *texture;
     d->transform() = tr != NULL ? *tr : TransformF::getIdentityInstance();
     return ERR_OK;
@@ -530,6 +553,7 @@ static err_t FOG_CDECL Pattern_createTextureD(Pattern* self, const Texture* text
       pType == (PATTERN_TYPE_TEXTURE | PATTERN_PRECISION_D) &&
       d->reference.get() == 1)
   {
+    Pattern_dResetCache(d);
     d->texture() = *texture;
     d->transform() = tr != NULL ? *tr : TransformD::getIdentityInstance();
     return ERR_OK;
@@ -571,6 +595,7 @@ static err_t FOG_CDECL Pattern_createGradientF(Pattern* self, const GradientF* g
       pType == (PATTERN_TYPE_GRADIENT | PATTERN_PRECISION_F) &&
       d->reference.get() == 1)
   {
+    Pattern_dResetCache(d);
     d->transform() = tr != NULL ? *tr : TransformF::getIdentityInstance();
     d->gradient().setGradient(*gradient);
     return ERR_OK;
@@ -612,6 +637,7 @@ static err_t FOG_CDECL Pattern_createGradientD(Pattern* self, const GradientD* g
       pType == (PATTERN_TYPE_GRADIENT | PATTERN_PRECISION_D) &&
       d->reference.get() == 1)
   {
+    Pattern_dResetCache(d);
     d->transform() = tr != NULL ? *tr : TransformD::getIdentityInstance();
     d->gradient().setGradient(*gradient);
     return ERR_OK;
@@ -650,6 +676,7 @@ static err_t FOG_CDECL Pattern_setTransformF(Pattern* self, const TransformF* tr
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
     
     static_cast<PatternBaseDataF*>(d)->transform() = *tr;
     return ERR_OK;
@@ -662,6 +689,7 @@ static err_t FOG_CDECL Pattern_setTransformF(Pattern* self, const TransformF* tr
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
 
     static_cast<PatternBaseDataD*>(d)->transform() = *tr;
     return ERR_OK;
@@ -681,6 +709,7 @@ static err_t FOG_CDECL Pattern_setTransformD(Pattern* self, const TransformD* tr
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
     
     static_cast<PatternBaseDataF*>(d)->transform() = *tr;
     return ERR_OK;
@@ -693,6 +722,7 @@ static err_t FOG_CDECL Pattern_setTransformD(Pattern* self, const TransformD* tr
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
 
     static_cast<PatternBaseDataD*>(d)->transform() = *tr;
     return ERR_OK;
@@ -712,6 +742,7 @@ static err_t FOG_CDECL Pattern_applyTransform(Pattern* self, uint32_t transformO
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
     
     return static_cast<PatternBaseDataF*>(d)->transform()._transform(transformOp, params);
   }
@@ -723,6 +754,7 @@ static err_t FOG_CDECL Pattern_applyTransform(Pattern* self, uint32_t transformO
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
 
     return static_cast<PatternBaseDataD*>(d)->transform()._transform(transformOp, params);
   }
@@ -743,6 +775,7 @@ static err_t FOG_CDECL Pattern_resetTransform(Pattern* self)
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
     
     static_cast<PatternBaseDataF*>(d)->transform().reset();
     return ERR_OK;
@@ -757,6 +790,7 @@ static err_t FOG_CDECL Pattern_resetTransform(Pattern* self)
       FOG_RETURN_ON_ERROR(self->detach());
       d = self->_d;
     }
+    Pattern_dResetCache(d);
 
     static_cast<PatternBaseDataD*>(d)->transform().reset();
     return ERR_OK;
@@ -876,11 +910,14 @@ static PatternData* FOG_CDECL Pattern_dCreate(size_t size)
     return NULL;
 
   newd->reference.init(1);
+  newd->engineCache = NULL;
   return newd;
 }
 
 static void FOG_CDECL Pattern_dFree(PatternData* d)
 {
+  Pattern_dResetCache(d);
+
   switch (d->pType)
   {
     case PATTERN_TYPE_TEXTURE | PATTERN_PRECISION_F:
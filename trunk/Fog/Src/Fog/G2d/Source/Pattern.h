@@ -82,6 +82,11 @@ struct FOG_NO_EXPORT PatternData
   //! @brief Pattern type and precision, see @ref PATTERN_TYPE and @ref
   //! PATTERN_PRECISION.
   uint32_t pType;
+
+  //! @brief Opaque cache attached by the paint engine (can be @c NULL),
+  //! released by @c fog_api.pattern_releaseEngineCache when the pattern
+  //! data is destroyed or modified.
+  void* engineCache;
 };
 
 // ============================================================================
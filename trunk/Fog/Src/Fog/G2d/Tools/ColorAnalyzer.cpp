@@ -32,7 +32,7 @@ uint32_t ColorAnalyzer::analyzeAlpha32(const uint8_t* data, ssize_t stride, int
   if (w <= 0 || h <= 0) return ALPHA_DISTRIBUTION_ZERO;
 
   data += aPos;
-  stride += w * inc;
+  stride -= (ssize_t)w * inc;
 
   for (int y = 0; y < h; y++, data += stride)
   {
@@ -60,7 +60,7 @@ uint32_t ColorAnalyzer::analyzeAlpha64(const uint8_t* data, ssize_t stride, int
   if (w <= 0 || h <= 0) return ALPHA_DISTRIBUTION_ZERO;
 
   data += aPos;
-  stride += w * inc;
+  stride -= (ssize_t)w * inc;
 
   for (int y = 0; y < h; y++, data += stride)
   {